@@ -28,6 +28,14 @@
 # define EFI_GUI_BUILD_OPTIONS
 #endif
 
+// EFI_GUI_BENCHMARK_COUNT
+/// The default count of calls for each benchmark measurement
+#define EFI_GUI_BENCHMARK_COUNT 10000
+
+// EFI_GUI_BENCHMARK_SIZE
+/// The default size in bytes of the benchmark buffers
+#define EFI_GUI_BENCHMARK_SIZE 0x1000000
+
 // LOG_CPU_FEATURE
 /// Log a cpu feature
 /// @param CpuFeatures The CPU_FEATURES structure
@@ -58,6 +66,7 @@ GuiServerRun (
 // GuiServerFinish
 /// GUI server finish execution
 /// @retval EFI_INVALID_PARAMETER If This is NULL
+/// @retval EFI_TIMEOUT           The draw thread did not finish and may still be running
 /// @retval EFI_SUCCESS           The GUI finished successfully
 EXTERN
 EFI_STATUS
@@ -394,6 +403,10 @@ GuiSetupLog (
   if (!EFI_ERROR(EfiConOutQueryMode(EfiConOutCurrentMode(), &Width, &Height))) {
     LOG(L"Console mode: %u x %u\n", Width, Height);
   }
+  // Bound the log memory, record the log in binary, and buffer the log file output as configured
+  EfiLogSetDefaultCapacity();
+  EfiLogSetDefaultBinary();
+  EfiLogSetDefaultFileBuffering();
   // Get the default outputs
   Outputs = EfiIsDebug() ? EFI_LOG_OUTPUT_ALL : EfiLogGetDefaultOutputs();
   // Set the new log outputs and flush
@@ -427,6 +440,42 @@ GuiSetupLog (
 #endif
 }
 
+// GuiBenchmark
+/// Log the kernel benchmarks if the configuration enables them
+STATIC
+VOID
+EFIAPI
+GuiBenchmark (
+  VOID
+) {
+  EFI_STATUS Status;
+  UINTN      Count;
+  UINTN      Size;
+  // Only run the benchmarks if the user wants that since they take a while
+  if (!EfiConfigurationGetBoolean(L"/Benchmark/Enabled", FALSE)) {
+    return;
+  }
+  Count = (UINTN)EfiConfigurationGetUnsigned(L"/Benchmark/Count", EFI_GUI_BENCHMARK_COUNT);
+  Size = (UINTN)EfiConfigurationGetUnsigned(L"/Benchmark/Size", EFI_GUI_BENCHMARK_SIZE);
+  LOGDIV();
+  Status = EfiDispatchStringBenchmark(Count);
+  if (EFI_ERROR(Status)) {
+    LOG(L"String benchmark: %r\n", Status);
+  }
+  Status = EfiDispatchCrc32Benchmark(Size);
+  if (EFI_ERROR(Status)) {
+    LOG(L"CRC benchmark: %r\n", Status);
+  }
+  Status = EfiParallelBenchmark(Size);
+  if (EFI_ERROR(Status)) {
+    LOG(L"Parallel benchmark: %r\n", Status);
+  }
+  Status = EfiLocalePrintBenchmark(Count);
+  if (EFI_ERROR(Status)) {
+    LOG(L"Locale print benchmark: %r\n", Status);
+  }
+}
+
 // EfiEntryPoint
 /// The GUI entry point
 EFI_STATUS
@@ -459,6 +508,16 @@ EfiEntryPoint (
   GuiImportConfiguration();
   // Setup log
   GuiSetupLog();
+  // Select the CPU feature kernels
+  LOGDIV();
+  EfiDispatchInitialize();
+  // Find the processors for parallel helpers
+  LOGDIV();
+  EfiParallelInitialize();
+  // Create the per processor allocation caches
+  EfiCpuPoolInitialize();
+  // Benchmark the kernels if configured
+  GuiBenchmark();
   // Get the GUI arrival time
   LOGDIV();
   EfiGetTime(&Time, NULL);
@@ -471,7 +530,10 @@ EfiEntryPoint (
   Status = GuiServerRun();
   // Finish using GUI
   LOGDIV();
-  GuiServerFinish();
+  // Free the per processor allocation caches only if no other processor still uses them
+  if (GuiServerFinish() != EFI_TIMEOUT) {
+    EfiCpuPoolUninitialize();
+  }
   // Get the finished time
   EfiGetTime(&Time, NULL);
   LOG(L"Finished: %T\n", &Time);
@@ -6,6 +6,26 @@
 
 #include <Gui/Client.h>
 
+// GUI_SERVER_WORK_INPUT
+/// The draw thread has input to process
+#define GUI_SERVER_WORK_INPUT 0x00000001
+// GUI_SERVER_WORK_REDRAW
+/// The draw thread has a frame to redraw
+#define GUI_SERVER_WORK_REDRAW 0x00000002
+// GUI_SERVER_WORK_QUIT
+/// The draw thread should finish
+#define GUI_SERVER_WORK_QUIT 0x80000000
+
+// GUI_SERVER_BACKOFF_LIMIT
+/// The maximum count of pauses between mailbox checks for the draw thread backoff
+#define GUI_SERVER_BACKOFF_LIMIT 4096
+// GUI_SERVER_FRAME_RATE
+/// The default count of frames per second
+#define GUI_SERVER_FRAME_RATE 60
+// GUI_SERVER_FINISH_TIMEOUT
+/// The time in 100ns units to wait for the draw thread to finish
+#define GUI_SERVER_FINISH_TIMEOUT 10000000
+
 // GUI_SERVER
 /// The GUI server protocol implemention
 typedef struct GUI_SERVER GUI_SERVER;
@@ -13,13 +33,37 @@ struct GUI_SERVER {
 
   // Lock
   /// The server GUI lock
-  EFI_LOCK        Lock;
+  EFI_LOCK          Lock;
+  // Mailbox
+  /// The work posted to the draw thread, modified only atomically
+  VOLATILE UINT32   Mailbox;
+  // Graphics
+  /// The graphics engine or NULL if graphics could not be started
+  GUI_GRAPHICS     *Graphics;
   // ConOutOutputString
   /// The previous console output method
-  EFI_TEXT_STRING ConOutOutputString;
+  EFI_TEXT_STRING   ConOutOutputString;
+  // ThreadEvent
+  /// The event signaled when the draw thread finishes
+  EFI_EVENT         ThreadEvent;
+  // FrameEvent
+  /// The frame timer event, which is only armed while the GUI needs redrawn
+  EFI_EVENT         FrameEvent;
+  // FramePeriod
+  /// The frame timer period in 100ns units
+  UINT64            FramePeriod;
   // Running
   /// Whether the server is running
-  BOOLEAN         Running;
+  BOOLEAN           Running;
+  // Monitor
+  /// Whether the draw thread waits for work with monitor and mwait instead of backoff
+  BOOLEAN           Monitor;
+  // Dirty
+  /// Whether the GUI needs redrawn on the next frame
+  BOOLEAN           Dirty;
+  // FrameArmed
+  /// Whether the frame timer is armed
+  BOOLEAN           FrameArmed;
 
 };
 
@@ -27,6 +71,102 @@ struct GUI_SERVER {
 /// The GUI server
 STATIC GUI_SERVER *mGuiServer;
 
+// GuiServerPost
+/// Post work to the draw thread mailbox, the store wakes the draw thread
+/// @param Server The GUI server
+/// @param Work   The work to post
+STATIC
+VOID
+EFIAPI
+GuiServerPost (
+  IN GUI_SERVER *Server,
+  IN UINT32      Work
+) {
+  UINT32 Mailbox;
+  // Merge the work into the mailbox atomically
+  do {
+    Mailbox = Server->Mailbox;
+  } while (EfiCompareAndExchange32((UINT32 *)&(Server->Mailbox), Mailbox, Mailbox | Work) != Mailbox);
+}
+// GuiServerTake
+/// Take all the work from the draw thread mailbox
+/// @param Server The GUI server
+/// @return The work taken from the mailbox or zero if there was none
+STATIC
+UINT32
+EFIAPI
+GuiServerTake (
+  IN GUI_SERVER *Server
+) {
+  UINT32 Mailbox;
+  // Empty the mailbox atomically
+  do {
+    Mailbox = Server->Mailbox;
+  } while ((Mailbox != 0) && (EfiCompareAndExchange32((UINT32 *)&(Server->Mailbox), Mailbox, 0) != Mailbox));
+  return Mailbox;
+}
+// GuiServerWait
+/// Wait for work to be posted to the draw thread mailbox
+/// @param Server The GUI server
+/// @return The work taken from the mailbox
+STATIC
+UINT32
+EFIAPI
+GuiServerWait (
+  IN GUI_SERVER *Server
+) {
+  UINT32 Work;
+  UINTN  Backoff = 1;
+  UINTN  Index;
+  // Wait until there is work
+  Work = GuiServerTake(Server);
+  while (Work == 0) {
+#if defined(EFI_ARCH_IA32) || defined(EFI_ARCH_X64)
+    if (Server->Monitor) {
+      // Arm the monitor then check again so a post before the wait is not missed
+      EfiCpuMonitor((CONST VOID *)&(Server->Mailbox));
+      if (Server->Mailbox == 0) {
+        EfiCpuMwait(0);
+      }
+      Work = GuiServerTake(Server);
+      continue;
+    }
+#endif
+    // Exponentially back off to reduce the memory traffic of checking the mailbox
+    for (Index = 0; Index < Backoff; ++Index) {
+      EfiCpuPause();
+    }
+    if (Backoff < GUI_SERVER_BACKOFF_LIMIT) {
+      Backoff <<= 1;
+    }
+    Work = GuiServerTake(Server);
+  }
+  return Work;
+}
+// GuiServerCanMonitor
+/// Check whether the draw thread can wait with monitor and mwait
+/// @return Whether the draw thread can wait with monitor and mwait
+STATIC
+BOOLEAN
+EFIAPI
+GuiServerCanMonitor (
+  VOID
+) {
+#if defined(EFI_ARCH_IA32) || defined(EFI_ARCH_X64)
+  UINT32 MaxFunction = 0;
+  UINT32 Ecx = 0;
+  // Check for MONITOR and MWAIT support
+  EfiCpuid(0, &MaxFunction, NULL, NULL, NULL);
+  if (MaxFunction >= 1) {
+    EfiCpuid(1, NULL, NULL, &Ecx, NULL);
+    if (EFI_BIT_IS_SET(Ecx, 3)) {
+      return EfiConfigurationGetBoolean(L"/Gui/Monitor", TRUE);
+    }
+  }
+#endif
+  return FALSE;
+}
+
 // GuiServerThread
 /// Thread for no boot services tasks for multithreaded GUI
 STATIC
@@ -35,24 +175,24 @@ EFIAPI
 GuiServerThread (
   IN GUI_SERVER *Server
 ) {
-  // Running needs to set to true due to optimization and out of order
-  BOOLEAN Running = TRUE;
+  UINT32 Work = 0;
   if (Server != NULL) {
     // The draw run loop
     do {
-      // Lock the server
-      EfiLock(&(Server->Lock));
-      // Check if the server is still running
-      Running = Server->Running;
-      if (Running) {
-        // TODO: Draw the GUI
-        
+      // Wait for work to be posted
+      Work = GuiServerWait(Server);
+      if (EFI_BITS_ANY_SET(Work, GUI_SERVER_WORK_INPUT | GUI_SERVER_WORK_REDRAW)) {
+        // Lock the server
+        EfiLock(&(Server->Lock));
+        // Check if the server is still running
+        if (Server->Running) {
+          // TODO: Process input and draw the GUI
+
+        }
+        // Unlock the server
+        EfiUnlock(&(Server->Lock));
       }
-      // Unlock the server
-      EfiUnlock(&(Server->Lock));
-      // Pause the loop momentarily if needed
-      EfiCpuPause();
-    } while (Running);
+    } while (EFI_BITS_ARE_UNSET(Work, GUI_SERVER_WORK_QUIT));
   }
 }
 // ServerNullOutputString
@@ -153,6 +293,14 @@ GuiServerStart (
       return EFI_OUT_OF_RESOURCES;
     }
     mGuiServer->Running = FALSE;
+    mGuiServer->Monitor = FALSE;
+    mGuiServer->Dirty = FALSE;
+    mGuiServer->FrameArmed = FALSE;
+    mGuiServer->Mailbox = 0;
+    mGuiServer->FramePeriod = 0;
+    mGuiServer->FrameEvent = NULL;
+    mGuiServer->ThreadEvent = NULL;
+    mGuiServer->Graphics = NULL;
     mGuiServer->ConOutOutputString = NULL;
     // Initialize the server lock
     EfiLockInitialize(&(mGuiServer->Lock));
@@ -162,6 +310,14 @@ GuiServerStart (
     LOG(L"GUI starting in console only mode ...\n");
     return EFI_SUCCESS;
   }
+  // Initialize the graphics, the GUI still runs on the console if there are no graphics
+  if (mGuiServer->Graphics == NULL) {
+    Status = GuiGraphicsStart(&(mGuiServer->Graphics));
+    LOG(L"GUI graphics start ... %r\n", Status);
+    if (EFI_ERROR(Status)) {
+      mGuiServer->Graphics = NULL;
+    }
+  }
   if (!GuiIsMultithreaded()) {
     LOG(L"GUI starting in singlethreaded mode ...\n");
     return EFI_SUCCESS;
@@ -170,10 +326,10 @@ GuiServerStart (
   LOG(L"GUI starting in multithreaded mode ...\n");
   // Lock the server
   EfiLock(&(mGuiServer->Lock));
-  // TODO: Initialize the graphics
-
   // Server is running
   mGuiServer->Running = TRUE;
+  // The draw thread can not use boot services so check how it should wait for work now
+  mGuiServer->Monitor = GuiServerCanMonitor();
   // Find a processor that can start a thread
   for (Index = 0; Index < NumberOfProcessors; ++Index) {
     EfiZero(EFI_PROCESSOR_INFORMATION, &ProcessorInfo);
@@ -193,8 +349,13 @@ GuiServerStart (
         VERBOSE(L"%r\n", Status);
         if (EFI_ERROR(Status)) {
           // Try next processor
+          if (Event != NULL) {
+            EfiCloseEvent(Event);
+          }
           continue;
         }
+        // The event is signaled when the thread finishes
+        mGuiServer->ThreadEvent = Event;
         break;
       }
     }
@@ -212,46 +373,146 @@ GuiServerStart (
   }
   return Status;
 }
+// GuiServerInvalidate
+/// Mark the GUI as needing redrawn and arm the frame timer, the server must be locked
+STATIC
+VOID
+EFIAPI
+GuiServerInvalidate (
+  VOID
+) {
+  mGuiServer->Dirty = TRUE;
+  if (!mGuiServer->FrameArmed && (mGuiServer->FrameEvent != NULL)) {
+    if (!EFI_ERROR(EfiSetTimer(mGuiServer->FrameEvent, TimerPeriodic, mGuiServer->FramePeriod))) {
+      mGuiServer->FrameArmed = TRUE;
+    }
+  }
+}
+// GuiServerStartFrames
+/// Create the frame timer and request the first frame, the server must be locked
+/// @return Whether the frame timer was created or not
+STATIC
+EFI_STATUS
+EFIAPI
+GuiServerStartFrames (
+  VOID
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  UINT64     FrameRate;
+  // Get the frame period from the frame rate
+  FrameRate = EfiConfigurationGetUnsigned(L"/Gui/FrameRate", GUI_SERVER_FRAME_RATE);
+  if (FrameRate == 0) {
+    FrameRate = GUI_SERVER_FRAME_RATE;
+  }
+  mGuiServer->FramePeriod = 10000000 / FrameRate;
+  // Create the frame timer
+  if (mGuiServer->FrameEvent == NULL) {
+    Status = EfiCreateEvent(EVT_TIMER, TPL_CALLBACK, NULL, NULL, &(mGuiServer->FrameEvent));
+    if (EFI_ERROR(Status)) {
+      mGuiServer->FrameEvent = NULL;
+    }
+  }
+  // Request the first frame
+  mGuiServer->FrameArmed = FALSE;
+  GuiServerInvalidate();
+  return Status;
+}
+// GuiServerStopFrames
+/// Cancel and close the frame timer, the server must be locked
+STATIC
+VOID
+EFIAPI
+GuiServerStopFrames (
+  VOID
+) {
+  if (mGuiServer->FrameEvent != NULL) {
+    EfiSetTimer(mGuiServer->FrameEvent, TimerCancel, 0);
+    EfiCloseEvent(mGuiServer->FrameEvent);
+    mGuiServer->FrameEvent = NULL;
+  }
+  mGuiServer->FrameArmed = FALSE;
+}
 // GuiServerRunLoopStep
-/// TODO: Run loop for GUI
+/// Wait for input or the next frame and perform the work for the event
+/// @param Multithreaded Whether the work should be posted to the draw thread or performed on this processor
 /// @return Whether the GUI is still running or not
 STATIC
 BOOLEAN
 EFIAPI
 GuiServerRunLoopStep (
-  VOID
+  IN BOOLEAN Multithreaded
 ) {
+  EFI_EVENT     Events[2] = { NULL, NULL };
+  EFI_INPUT_KEY Key;
+  UINTN         Count = 0;
+  UINTN         Index = 0;
+  UINT32        Work = 0;
   // Running needs to set to true due to optimization and out of order
-  BOOLEAN Running = TRUE;
+  BOOLEAN       Running = TRUE;
+  // Sleep until there is input or the next frame is due, the frame timer is only armed while the GUI needs redrawn
+  if ((gEfiConIn != NULL) && (gEfiConIn->WaitForKey != NULL)) {
+    Events[Count++] = gEfiConIn->WaitForKey;
+  }
+  if (mGuiServer->FrameArmed) {
+    Events[Count++] = mGuiServer->FrameEvent;
+  }
+  if ((Count == 0) || EFI_ERROR(EfiWaitForEvent(Count, Events, &Index))) {
+    // Nothing can wake the loop so stop running
+    Index = Count;
+  }
   // Lock the server
   EfiLock(&(mGuiServer->Lock));
+  if (Index >= Count) {
+    mGuiServer->Running = FALSE;
+  }
   // Check if the server is still running
   Running = mGuiServer->Running;
   if (Running) {
-    // TODO: Server run step
-
+    if (Events[Index] == mGuiServer->FrameEvent) {
+      if (mGuiServer->Dirty) {
+        // Redraw the frame
+        mGuiServer->Dirty = FALSE;
+        Work = GUI_SERVER_WORK_REDRAW;
+      } else {
+        // Nothing changed since the last frame so stop the frame timer until something does
+        EfiSetTimer(mGuiServer->FrameEvent, TimerCancel, 0);
+        mGuiServer->FrameArmed = FALSE;
+      }
+    } else if (!EFI_ERROR(gEfiConIn->ReadKeyStroke(gEfiConIn, &Key))) {
+      // Process the input and redraw on the next frame
+      Work = GUI_SERVER_WORK_INPUT;
+      GuiServerInvalidate();
+      // TODO: Temporarily just quit on any key
+      mGuiServer->Running = FALSE;
+      Running = FALSE;
+    }
   }
   // Unlock the server
   EfiUnlock(&(mGuiServer->Lock));
+  if (Multithreaded) {
+    // Refill the allocation caches the draw thread has emptied and output the messages it logged
+    EfiCpuPoolRefill();
+    EfiLogDrain();
+    // Wake the draw thread with the work
+    if (!Running) {
+      Work |= GUI_SERVER_WORK_QUIT;
+    }
+    if (Work != 0) {
+      GuiServerPost(mGuiServer, Work);
+    }
+  } else if (Work != 0) {
+    // Lock the server
+    EfiLock(&(mGuiServer->Lock));
+    // TODO: Process input and draw the GUI
 
-  // TODO: Temporarily stall here for a second
-  EfiCpuPause();
-  // Lock the server
-  EfiLock(&(mGuiServer->Lock));
-  // TODO: Temporarily just quit
-  mGuiServer->Running = FALSE;
-  // Unlock the server
-  EfiUnlock(&(mGuiServer->Lock));
-  // Pause the CPU if needed
-  EfiCpuPause();
+    // Unlock the server
+    EfiUnlock(&(mGuiServer->Lock));
+  }
   return Running;
 }
 // ServerMultithreadRunLoop
-/// TODO: Run loop for multithreaded GUI
-/// @param This        The GUI server protocol
-/// @retval EFI_INVALID_PARAMETER If Server is NULL or not valid
-/// @retvel EFI_UNSUPPORTED       If not multiprocessing capable or the draw thread failed
-/// @retval EFI_SUCCESS           The run loop finished successfully
+/// Run loop for multithreaded GUI, the draw thread performs the work
+/// @retval EFI_SUCCESS The run loop finished successfully
 STATIC
 EFI_STATUS
 EFIAPI
@@ -261,18 +522,16 @@ ServerMultithreadRunLoop (
   // Running needs to set to true due to optimization and out of order
   EFI_STATUS Status = EFI_SUCCESS;
   BOOLEAN    Running = TRUE;
-  // TODO: The main run loop
+  // The main run loop
   do {
     // Perform the steps needed in all GUI loops
-    Running = GuiServerRunLoopStep();
+    Running = GuiServerRunLoopStep(TRUE);
   } while (Running);
   return Status;
 }
 // ServerSinglethreadRunLoop
-/// TODO: Run loop for single-threaded GUI
-/// @param This        The GUI server protocol
-/// @retval EFI_INVALID_PARAMETER If Server is NULL or not valid
-/// @retval EFI_SUCCESS           The run loop finished successfully
+/// Run loop for single-threaded GUI
+/// @retval EFI_SUCCESS The run loop finished successfully
 STATIC
 EFI_STATUS
 EFIAPI
@@ -282,18 +541,16 @@ ServerSinglethreadRunLoop (
   // Running needs to set to true due to optimization and out of order
   EFI_STATUS Status = EFI_SUCCESS;
   BOOLEAN    Running = TRUE;
-  // TODO: The main run loop
+  // The main run loop
   do {
     // Perform the steps needed in all GUI loops
-    Running = GuiServerRunLoopStep();
+    Running = GuiServerRunLoopStep(FALSE);
   } while (Running);
   return Status;
 }
 // ServerConsoleRunLoop
-/// TODO: Run loop for single-threaded GUI
-/// @param This        The GUI server protocol
-/// @retval EFI_INVALID_PARAMETER If Server is NULL or not valid
-/// @retval EFI_SUCCESS           The run loop finished successfully
+/// Run loop for console only GUI
+/// @retval EFI_SUCCESS The run loop finished successfully
 STATIC
 EFI_STATUS
 EFIAPI
@@ -303,10 +560,10 @@ ServerConsoleRunLoop (
   // Running needs to set to true due to optimization and out of order
   EFI_STATUS Status = EFI_SUCCESS;
   BOOLEAN    Running = TRUE;
-  // TODO: The main run loop
+  // The main run loop
   do {
     // Perform the steps needed in all GUI loops
-    Running = GuiServerRunLoopStep();
+    Running = GuiServerRunLoopStep(FALSE);
   } while (Running);
   return Status;
 }
@@ -333,6 +590,7 @@ GuiServerRun (
     EfiLock(&(mGuiServer->Lock));
     // Start running the server
     mGuiServer->Running = TRUE;
+    GuiServerStartFrames();
     // Unlock the server
     EfiUnlock(&(mGuiServer->Lock));
     // Console only GUI
@@ -347,6 +605,11 @@ GuiServerRun (
     // Unlock the server
     EfiUnlock(&(mGuiServer->Lock));
     if (GuiIsMultithreaded() && Running) {
+      // Lock the server
+      EfiLock(&(mGuiServer->Lock));
+      GuiServerStartFrames();
+      // Unlock the server
+      EfiUnlock(&(mGuiServer->Lock));
       // Multithreaded GUI if already running
       Status = ServerMultithreadRunLoop();
     } else {
@@ -354,6 +617,7 @@ GuiServerRun (
       EfiLock(&(mGuiServer->Lock));
       // Start running the server
       mGuiServer->Running = TRUE;
+      GuiServerStartFrames();
       // Unlock the server
       EfiUnlock(&(mGuiServer->Lock));
       // Singlethreaded GUI
@@ -366,28 +630,65 @@ GuiServerRun (
     // Unlock the server
     EfiUnlock(&(mGuiServer->Lock));
   }
+  // Lock the server
+  EfiLock(&(mGuiServer->Lock));
+  // Stop the frame timer
+  GuiServerStopFrames();
+  // Unlock the server
+  EfiUnlock(&(mGuiServer->Lock));
   return Status;
 }
 // GuiServerFinish
 /// GUI server finish execution
 /// @retval EFI_INVALID_PARAMETER If This is NULL
+/// @retval EFI_TIMEOUT           The draw thread did not finish and may still be running
 /// @retval EFI_SUCCESS           The GUI finished successfully
 EFI_STATUS
 EFIAPI
 GuiServerFinish (
   VOID
 ) {
+  EFI_STATUS Status;
+  EFI_EVENT  Events[2];
+  UINTN      Index = 0;
   if (mGuiServer != NULL) {
     // Lock the server
     EfiLock(&(mGuiServer->Lock));
     // Stop running the server
     mGuiServer->Running = FALSE;
+    GuiServerStopFrames();
     // Unlock the server
     EfiUnlock(&(mGuiServer->Lock));
-    // Pause the CPU to synchronize
-    EfiCpuPause();
+    // Wake the draw thread so it finishes
+    GuiServerPost(mGuiServer, GUI_SERVER_WORK_QUIT);
+    if (mGuiServer->ThreadEvent != NULL) {
+      // Wait for the draw thread to finish, but not forever
+      Events[0] = mGuiServer->ThreadEvent;
+      Events[1] = NULL;
+      Status = EfiCreateEvent(EVT_TIMER, TPL_CALLBACK, NULL, NULL, &(Events[1]));
+      if (!EFI_ERROR(Status)) {
+        Status = EfiSetTimer(Events[1], TimerRelative, GUI_SERVER_FINISH_TIMEOUT);
+        if (!EFI_ERROR(Status)) {
+          Status = EfiWaitForEvent(2, Events, &Index);
+        }
+        EfiCloseEvent(Events[1]);
+      }
+      EfiCloseEvent(mGuiServer->ThreadEvent);
+      mGuiServer->ThreadEvent = NULL;
+      if (EFI_ERROR(Status) || (Index != 0)) {
+        // The draw thread may still be using the server so it can not be freed
+        LOG(L"GUI draw thread did not finish\n");
+        mGuiServer = NULL;
+        return EFI_TIMEOUT;
+      }
+    }
     // Lock the server
     EfiLock(&(mGuiServer->Lock));
+    // Finish the graphics
+    if (mGuiServer->Graphics != NULL) {
+      GuiGraphicsFinish(mGuiServer->Graphics);
+      mGuiServer->Graphics = NULL;
+    }
     // Free the server
     EfiFreePool(mGuiServer);
     mGuiServer = NULL;
@@ -1,12 +1,12 @@
-//
-/// @file Include/Serialize/Parser.h
 ///
-/// GUI language parser implementation
+/// @file Include/Serialize/Base64.h
+///
+/// Base64 encoding and decoding
 ///
 
 #pragma once
-#ifndef __GUI_PARSER_HEADER__
-#define __GUI_PARSER_HEADER__
+#ifndef __BASE64_HEADER__
+#define __BASE64_HEADER__
 
 #include <Uefi.h>
 
@@ -14,6 +14,133 @@
 extern "C" {
 #endif // __cplusplus
 
+// BASE64_CONTEXT
+/// A base64 codec context for incremental encoding or decoding, which carries the partial block between chunks
+typedef struct BASE64_CONTEXT BASE64_CONTEXT;
+struct BASE64_CONTEXT {
+
+  // Block
+  /// The bits of the partial block
+  UINT32     Block;
+  // Count
+  /// The count of characters, when decoding, or bytes, when encoding, in the partial block
+  UINTN      Count;
+  // Status
+  /// EFI_WARN_UNKNOWN_GLYPH if any characters were skipped while decoding because they were not base64, otherwise EFI_SUCCESS
+  EFI_STATUS Status;
+  // Finished
+  /// Whether padding or a null terminator ended the decoded data, any later characters are ignored
+  BOOLEAN    Finished;
+
+};
+
+// Base64DecodeInit
+/// Initialize a base64 codec context for incremental decoding
+/// @param Context The base64 codec context
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           The context was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64DecodeInit (
+  OUT BASE64_CONTEXT *Context
+);
+// Base64DecodeUpdate
+/// Decode the next chunk of encoded characters, a partial block is carried in the context to the next chunk
+/// @param Context    The base64 codec context
+/// @param Encoding   The input encoding protocol interface
+/// @param Input      The input encoded characters, which must be whole characters
+/// @param InputSize  The size in bytes of the input encoded characters
+/// @param Output     The data output buffer, which needs three bytes for every four characters including the partial block, and may overlap the input at or before the start of the input to decode in place
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the decoded data
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL or Input is NULL and InputSize is not zero
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer may not be large enough to hold the decoded data, nothing was decoded and *OutputSize is updated with the required size
+/// @retval EFI_WARN_UNKNOWN_GLYPH The characters were decoded but some characters were not base64 and were skipped
+/// @retval EFI_SUCCESS            The characters were decoded successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64DecodeUpdate (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN     CONST VOID            *Input OPTIONAL,
+  IN     UINTN                  InputSize,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
+);
+// Base64DecodeFinal
+/// Finish incremental decoding by decoding the partial last block
+/// @param Context    The base64 codec context
+/// @param Output     The data output buffer, which needs at most two bytes
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the decoded data
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the decoded data, *OutputSize is updated with the required size
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The data was decoded but some characters were not base64 and were skipped
+/// @retval EFI_SUCCESS            The data was decoded successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64DecodeFinal (
+  IN OUT BASE64_CONTEXT *Context,
+  OUT    VOID           *Output OPTIONAL,
+  IN OUT UINTN          *OutputSize
+);
+
+// Base64EncodeInit
+/// Initialize a base64 codec context for incremental encoding
+/// @param Context The base64 codec context
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           The context was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64EncodeInit (
+  OUT BASE64_CONTEXT *Context
+);
+// Base64EncodeUpdate
+/// Encode the next chunk of data, a partial block is carried in the context to the next chunk
+/// @param Context    The base64 codec context
+/// @param Encoding   The output encoding protocol interface
+/// @param Input      The input data
+/// @param InputSize  The size in bytes of the input data
+/// @param Output     The base 64 encoded output buffer, which needs four units for every three bytes including the partial block and is not null terminated
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL or Input is NULL and InputSize is not zero
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the encoded characters, nothing was encoded and *OutputSize is updated with the required size
+/// @retval EFI_UNSUPPORTED        If the encoding does not encode base64 characters as single units
+/// @retval EFI_SUCCESS            The data was encoded successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64EncodeUpdate (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN     CONST VOID            *Input OPTIONAL,
+  IN     UINTN                  InputSize,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
+);
+// Base64EncodeFinal
+/// Finish incremental encoding by encoding the partial last block with padding
+/// @param Context    The base64 codec context
+/// @param Encoding   The output encoding protocol interface
+/// @param Output     The base 64 encoded output buffer, which needs at most four units and is not null terminated
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the encoded characters, *OutputSize is updated with the required size
+/// @retval EFI_UNSUPPORTED        If the encoding does not encode base64 characters as single units
+/// @retval EFI_SUCCESS            The data was encoded successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+Base64EncodeFinal (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
+);
+
 // Base64Decode
 /// Convert an encoded character string to a data buffer or a data buffer to an encoded character string
 /// @param Encoding   The input encoding protocol interface
@@ -24,6 +151,8 @@ extern "C" {
 /// @retval EFI_INVALID_PARAMETER  If Input or OutputSize is NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
 /// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The buffer was converted but some characters were not base64 and were skipped
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EXTERN
 EFI_STATUS
@@ -66,7 +195,9 @@ Base64Encode (
 /// @param OutputSize On output, the size in bytes of the converted output buffer
 /// @retval EFI_INVALID_PARAMETER  If Input or Output is NULL or *Output is not NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
-/// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_OUT_OF_RESOURCES   If memory could not be allocated for the output buffer
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The buffer was converted but some characters were not base64 and were skipped
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EXTERN
 EFI_STATUS
@@ -87,7 +218,7 @@ Base64DecodeBuffer (
 /// @param OutputSize On output, the size in bytes of the converted output buffer
 /// @retval EFI_INVALID_PARAMETER  If Input or Output is NULL or *Output is not NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
-/// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_OUT_OF_RESOURCES   If memory could not be allocated for the output buffer
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EXTERN
 EFI_STATUS
@@ -187,4 +318,4 @@ Base64AsciiToAsciiString (
 }
 #endif // __cplusplus
 
-#endif // __GUI_PARSER_HEADER__
+#endif // __BASE64_HEADER__
@@ -98,7 +98,7 @@ struct PLIST_KEY {
   /// PLIST next key
   PLIST_KEY   *Next;
   // Name
-  /// PLIST key name
+  /// PLIST key name, which is interned and must not be freed
   CHAR16      *Name;
   // Size
   /// PLIST key value size in bytes
@@ -106,6 +106,9 @@ struct PLIST_KEY {
   // Value
   /// PLIST key value
   PLIST_VALUE  Value;
+  // Raw
+  /// PLIST key value text that has not been decoded yet or NULL if the value is decoded, see PlistKeyDecode
+  CHAR16      *Raw;
   // Type
   /// PLIST key value type
   PLIST_TYPE   Type;
@@ -161,6 +164,19 @@ EFIAPI
 PlistDictionaryFree (
   IN PLIST_KEY *Dictionary
 );
+// PlistKeyDecode
+/// Decode the value of a PLIST key, date, data, real and integer values are kept as text when parsed and decoded on first access
+/// @param Key The PLIST key of which to decode the value, the value and size are valid after this returns successfully
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the value
+/// @retval EFI_SUCCESS           If the value was decoded or was already decoded
+/// @return Any other status returned while decoding the value text, data text is decoded in place so a data key that fails is left without a value
+EXTERN
+EFI_STATUS
+EFIAPI
+PlistKeyDecode (
+  IN OUT PLIST_KEY *Key
+);
 
 // XmlParserFromPlistParser
 /// Get the XML parser from a PLIST parser
@@ -252,6 +268,23 @@ PlistToXmlBuffer (
   OUT VOID                  **Buffer,
   OUT UINTN                  *Size OPTIONAL
 );
+// PlistToWriter
+/// Write a PLIST dictionary as an XML document
+/// @param Dictionary The PLIST dictionary
+/// @param Writer     The writer of the XML document, the XML is in the encoding of the writer
+/// @param Compact    Whether to write compact XML without indentation and line breaks or to pretty print the XML
+/// @retval EFI_SUCCESS           The PLIST dictionary was written as XML, the writer may still have buffered output
+/// @retval EFI_INVALID_PARAMETER If Dictionary or Writer is NULL or Writer is not initialized
+/// @retval EFI_UNSUPPORTED       The format encoding could not be found
+/// @return Any other status returned by the writer output
+EXTERN
+EFI_STATUS
+EFIAPI
+PlistToWriter (
+  IN     PLIST_KEY  *Dictionary,
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Compact
+);
 
 // PlistImportConfiguration
 /// Import a PLIST dictionary into the configuration
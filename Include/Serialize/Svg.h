@@ -174,6 +174,23 @@ SvgToXmlBuffer (
   OUT VOID                  **Buffer,
   OUT UINTN                  *Size OPTIONAL
 );
+// SvgToWriter
+/// Write a SVG image as an XML document
+/// @param Image   The SVG image
+/// @param Writer  The writer of the XML document, the XML is in the encoding of the writer
+/// @param Compact Whether to write compact XML without indentation and line breaks or to pretty print the XML
+/// @retval EFI_SUCCESS           The SVG image was written as XML, the writer may still have buffered output
+/// @retval EFI_INVALID_PARAMETER If Image or Writer is NULL or Writer is not initialized
+/// @retval EFI_UNSUPPORTED       The SVG image elements can not be converted yet
+/// @return Any other status returned by the writer output
+EXTERN
+EFI_STATUS
+EFIAPI
+SvgToWriter (
+  IN     SVG_IMAGE  *Image,
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Compact
+);
 
 // SvgLoad
 /// Load a SVG image from file
@@ -20,7 +20,7 @@ typedef struct XML_ATTRIBUTE XML_ATTRIBUTE;
 struct XML_ATTRIBUTE {
 
   // Name
-  /// XML document tree node attribute name
+  /// XML document tree node attribute name, which is interned and shared so it must not be freed or modified
   CHAR16 *Name;
   // Value
   /// XML document tree node attribute value
@@ -362,7 +362,7 @@ XmlDocumentGetTree (
 // XmlTreeGetTag
 /// Get XML document tree node tag name
 /// @param Tree An XML document tree
-/// @param Tag  On output, the XML document tree tag name
+/// @param Tag  On output, the XML document tree tag name, which is interned and shared so it must not be freed or modified
 /// @return Whether the XML document tree tag name was retrieved or not
 /// @retval EFI_INVALID_PARAMETER If Tree or Tag is NULL
 /// @retval EFI_SUCCESS           If the XML document tree tag name was retrieved successfully
@@ -379,6 +379,7 @@ XmlTreeGetTag (
 /// @param Tag  The XML document tree tag name to set
 /// @return Whether the XML document tree tag name was set or not
 /// @retval EFI_INVALID_PARAMETER If Tree or Tag is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the XML document tree tag name could not be interned
 /// @retval EFI_SUCCESS           If the XML document tree tag name was set successfully
 EXTERN
 EFI_STATUS
@@ -415,6 +416,20 @@ XmlTreeSetValue (
   IN OUT XML_TREE *Tree,
   IN     CHAR16   *Value
 );
+// XmlTreeTakeValue
+/// Take the XML document tree node value, leaving the tree node without a value
+/// @param Tree  An XML document tree
+/// @param Value On output, the XML document tree node value, which must be freed, or NULL if there is no value
+/// @return Whether the XML document tree node value was taken or not
+/// @retval EFI_INVALID_PARAMETER If Tree or Value is NULL
+/// @retval EFI_SUCCESS           If the XML document tree node value was taken successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+XmlTreeTakeValue (
+  IN OUT XML_TREE  *Tree,
+  OUT    CHAR16   **Value
+);
 // XmlTreeHasChildren
 /// Check if XML document tree node has child nodes
 /// @param Tree An XML document tree node
@@ -484,7 +499,8 @@ XmlTreeGetAttribute (
 /// @param Name      The XML document tree node attribute name
 /// @param Attribute The XML document tree attribute to set
 /// @return Whether the XML document tree attribute was set or not
-/// @retval EFI_INVALID_PARAMETER If Tree, Name, or Attribute is NULL
+/// @retval EFI_INVALID_PARAMETER If Tree, Name, Attribute, or Attribute->Name is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the XML document tree attribute could not be allocated or its name could not be interned
 /// @retval EFI_SUCCESS           If the XML document tree attribute was set successfully
 EXTERN
 EFI_STATUS
@@ -522,6 +538,23 @@ XmlIsValidName (
   IN OUT CHAR16 **Token
 );
 
+// XmlWriteEscaped
+/// Write a string as XML character data or an attribute value, markup characters are escaped and characters that can not be encoded are written as character references
+/// @param Writer    The writer
+/// @param Value     The string to write
+/// @param Attribute Whether the string is an attribute value so quotes are also escaped
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the writer output
+EXTERN
+EFI_STATUS
+EFIAPI
+XmlWriteEscaped (
+  IN OUT EFI_WRITER   *Writer,
+  IN     CONST CHAR16 *Value OPTIONAL,
+  IN     BOOLEAN       Attribute
+);
+
 #if defined(__cplusplus)
 }
 #endif // __cplusplus
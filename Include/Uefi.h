@@ -27,6 +27,14 @@
 #include <Uefi/Protocol/Log.h>
 #include <Uefi/Protocol/Configuration.h>
 #include <Uefi/Protocol/Translation.h>
+#include <Uefi/Dispatch.h>
+#include <Uefi/Parallel.h>
+#include <Uefi/CpuPool.h>
+#include <Uefi/StringBuilder.h>
+#include <Uefi/Writer.h>
+#include <Uefi/Hash.h>
+#include <Uefi/HashMap.h>
+#include <Uefi/Intern.h>
 
 #if defined(__cplusplus)
 extern "C" {
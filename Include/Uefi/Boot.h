@@ -1723,6 +1723,23 @@ EfiByteSwapMemoryDescriptor (
   IN EFI_MEMORY_DESCRIPTOR *Descriptor1,
   IN EFI_MEMORY_DESCRIPTOR *Descriptor2
 );
+// EfiSortMemoryMap
+/// Sort memory descriptors by physical address, large memory maps are sorted in parallel
+/// @param MemoryMap      The memory map descriptors
+/// @param MemoryMapSize  The size in bytes of the memory map descriptors
+/// @param DescriptorSize The size in bytes of an individual memory map descriptor
+/// @retval EFI_INVALID_PARAMETER If MemoryMap is NULL
+/// @retval EFI_INVALID_PARAMETER If MemoryMapSize or DescriptorSize is zero
+/// @retval EFI_INVALID_PARAMETER If MemoryMapSize < DescriptorSize
+/// @retval EFI_SUCCESS           The descriptors were sorted, descriptors with equal addresses remain in the same order
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiSortMemoryMap (
+  IN EFI_MEMORY_DESCRIPTOR *MemoryMap,
+  IN UINTN                  MemoryMapSize,
+  IN UINTN                  DescriptorSize
+);
 // EfiPrintMemoryMap
 /// Print the memory map descriptor information to the log
 /// @param MemoryMap      The memory map descriptors
@@ -2361,6 +2378,19 @@ EfiExitBootServicesCallback (
   IN EFI_IMAGE_CALLBACK  Callback,
   IN VOID               *CallbackData OPTIONAL
 );
+// EfiExitBootServicesRemoveCallback
+/// Remove an exit boot services callback
+/// @param Callback     The callback function that was registered
+/// @param CallbackData The data that was registered with the callback function
+/// @retval EFI_NOT_FOUND The callback was not registered with the callback data
+/// @retval EFI_SUCCESS   The callback was removed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiExitBootServicesRemoveCallback (
+  IN EFI_IMAGE_CALLBACK  Callback,
+  IN VOID               *CallbackData OPTIONAL
+);
 
 // EfiGetNextMonotonicCount
 /// Returns a monotonically increasing count for the platform.
@@ -2384,6 +2414,34 @@ EFIAPI
 EfiStall (
   IN UINTN Microseconds
 );
+// EfiGetTimeStamp
+/// Get the current processor time stamp
+/// @return The current time stamp or zero if there is no time stamp counter
+EXTERN
+UINT64
+EFIAPI
+EfiGetTimeStamp (
+  VOID
+);
+// EfiGetTimeStampFrequency
+/// Get the frequency of the processor time stamp, calibrated once against EfiStall
+/// @return The number of time stamp ticks per second or zero if the frequency could not be determined
+EXTERN
+UINT64
+EFIAPI
+EfiGetTimeStampFrequency (
+  VOID
+);
+// EfiTimeStampToNanoseconds
+/// Convert a time stamp difference to nanoseconds
+/// @param TimeStamp The time stamp difference to convert
+/// @return The number of nanoseconds or zero if the frequency could not be determined
+EXTERN
+UINT64
+EFIAPI
+EfiTimeStampToNanoseconds (
+  IN UINT64 TimeStamp
+);
 // EfiSetWatchdogTimer
 /// Sets the systems watchdog timer
 /// @param Timeout      The number of seconds to set the watchdog timer, zero disables the timer
@@ -2596,6 +2654,20 @@ EfiLocateProtocol (
   OUT VOID     **Interface
 );
 
+// EFI_CRC32_CONTEXT
+/// A context to compute a 32-bit CRC incrementally
+typedef struct EFI_CRC32_CONTEXT EFI_CRC32_CONTEXT;
+struct EFI_CRC32_CONTEXT {
+
+  // Crc32
+  /// The 32-bit CRC of the data so far
+  UINT32 Crc32;
+  // Size
+  /// The size in bytes of the data so far
+  UINT64 Size;
+
+};
+
 // EfiCalculateCrc32
 /// Computes and returns a 32-bit CRC for a data buffer.
 /// @param Data     The buffer on which the 32-bit CRC is to be computed
@@ -2613,6 +2685,45 @@ EfiCalculateCrc32 (
   IN  UINTN   DataSize,
   OUT UINT32 *Crc32
 );
+// EfiCrc32Init
+/// Initialize a context to compute a 32-bit CRC incrementally
+/// @param Context The CRC context to initialize
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           If the context was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCrc32Init (
+  OUT EFI_CRC32_CONTEXT *Context
+);
+// EfiCrc32Update
+/// Update a 32-bit CRC context with the next part of the data
+/// @param Context The CRC context
+/// @param Data    The next part of the data
+/// @param Size    The size in bytes of the next part of the data
+/// @retval EFI_INVALID_PARAMETER If Context is NULL or Data is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the context was updated
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCrc32Update (
+  IN OUT EFI_CRC32_CONTEXT *Context,
+  IN     CONST VOID        *Data,
+  IN     UINTN              Size
+);
+// EfiCrc32Final
+/// Get the 32-bit CRC of all the data a context was updated with
+/// @param Context The CRC context
+/// @param Crc32   On output, the 32-bit CRC
+/// @retval EFI_INVALID_PARAMETER If Context or Crc32 is NULL
+/// @retval EFI_SUCCESS           If the 32-bit CRC was returned
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCrc32Final (
+  IN  EFI_CRC32_CONTEXT *Context,
+  OUT UINT32            *Crc32
+);
 
 // EfiCopy
 /// Copy the contents of one array to another
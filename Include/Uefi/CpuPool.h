@@ -0,0 +1,80 @@
+///
+/// @file Include/Uefi/CpuPool.h
+///
+/// UEFI per processor small object allocation caches
+///
+
+#pragma once
+#ifndef __UEFI_CPU_POOL_HEADER__
+#define __UEFI_CPU_POOL_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_CPU_POOL_MAXIMUM_SIZE
+/// The maximum size in bytes of an allocation from the per processor caches
+#define EFI_CPU_POOL_MAXIMUM_SIZE 2048
+
+// EfiCpuPoolInitialize
+/// Initialize the per processor allocation caches and fill a magazine for every processor, must be called from the boot strap processor
+/// @retval EFI_UNSUPPORTED      Boot services were exited
+/// @retval EFI_OUT_OF_RESOURCES The caches could not be allocated
+/// @retval EFI_SUCCESS          The caches were initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCpuPoolInitialize (
+  VOID
+);
+// EfiCpuPoolUninitialize
+/// Free the per processor allocation caches and all the pages backing them, must be called from the boot strap processor when no other processor uses the caches
+/// @retval EFI_SUCCESS The caches were freed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCpuPoolUninitialize (
+  VOID
+);
+// EfiCpuPoolRefill
+/// Fill a magazine for every processor cache that has taken its last magazine, must be called from the boot strap processor
+/// @retval EFI_NOT_READY        The caches are not initialized or boot services were exited
+/// @retval EFI_OUT_OF_RESOURCES Not every cache could be refilled
+/// @retval EFI_SUCCESS          Every cache has a magazine
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCpuPoolRefill (
+  VOID
+);
+
+// EfiCpuPoolAllocate
+/// Allocate a small object from the cache of the calling processor, may be called from any processor
+/// @param Size The size in bytes to allocate, which must not be more than EFI_CPU_POOL_MAXIMUM_SIZE
+/// @return The allocated object or NULL if the cache is empty until the boot strap processor refills it or boot services were exited, the caller then allocates another way
+EXTERN
+VOID *
+EFIAPI
+EfiCpuPoolAllocate (
+  IN UINTN Size
+);
+// EfiCpuPoolFree
+/// Free a small object to the cache of the processor that allocated it, may be called from any processor
+/// @param Buffer The object to free
+/// @retval EFI_INVALID_PARAMETER If Buffer is NULL or was not allocated with EfiCpuPoolAllocate
+/// @retval EFI_NOT_READY         The caches are not initialized
+/// @retval EFI_SUCCESS           The object was freed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiCpuPoolFree (
+  IN VOID *Buffer
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_CPU_POOL_HEADER__
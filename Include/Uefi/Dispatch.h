@@ -0,0 +1,585 @@
+///
+/// @file Include/Uefi/Dispatch.h
+///
+/// UEFI CPU feature kernel dispatch
+///
+
+#pragma once
+#ifndef __UEFI_DISPATCH_HEADER__
+#define __UEFI_DISPATCH_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_DISPATCH_LEVEL
+/// The instruction set level of a dispatched kernel
+typedef enum EFI_DISPATCH_LEVEL EFI_DISPATCH_LEVEL;
+enum EFI_DISPATCH_LEVEL {
+
+  // EfiDispatchLevelScalar
+  /// Portable implementation that requires no instruction set extensions
+  EfiDispatchLevelScalar = 0,
+  // EfiDispatchLevelSse2
+  /// SSE2 implementation
+  EfiDispatchLevelSse2,
+  // EfiDispatchLevelSse4_2
+  /// SSE4.2 implementation (also requires SSSE3, SSE4.1, and PCLMULQDQ)
+  EfiDispatchLevelSse4_2,
+  // EfiDispatchLevelAvx2
+  /// AVX2 implementation
+  EfiDispatchLevelAvx2,
+  // EfiDispatchLevelAvx512
+  /// AVX-512 implementation (F, BW, and VL), which has no kernels yet so the AVX2 kernels are selected
+  EfiDispatchLevelAvx512,
+  // EfiDispatchLevelNeon
+  /// ARM advanced SIMD implementation, slots without an advanced SIMD kernel select the scalar kernels
+  EfiDispatchLevelNeon,
+  // EfiDispatchLevelCount
+  /// The count of dispatch levels
+  EfiDispatchLevelCount
+
+};
+
+// EFI_DISPATCH_STR_LEN
+/// Get the length of a character string
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_STR_LEN) (
+  IN CONST CHAR16 *Str
+);
+// EFI_DISPATCH_STR_CMP
+/// Performs a comparison of two strings
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+typedef
+INTN
+(EFIAPI
+*EFI_DISPATCH_STR_CMP) (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+);
+// EFI_DISPATCH_STRN_CMP
+/// Performs a comparison of at most a count of characters of two strings
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+typedef
+INTN
+(EFIAPI
+*EFI_DISPATCH_STRN_CMP) (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2,
+  IN UINTN         Count
+);
+// EFI_DISPATCH_STR_STR
+/// Returns the first occurrence of a sub-string in a string
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+typedef
+CHAR16 *
+(EFIAPI
+*EFI_DISPATCH_STR_STR) (
+  IN CONST CHAR16 *String,
+  IN CONST CHAR16 *SearchString
+);
+// EFI_DISPATCH_STRI_PREFIX
+/// Get the count of leading characters of two strings that are ASCII, not null and equal ignoring case
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @return The count of leading characters that are ASCII, not null and equal ignoring case
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_STRI_PREFIX) (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+);
+// EFI_DISPATCH_ASCII_STR_LEN
+/// Get the length of a character string
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_ASCII_STR_LEN) (
+  IN CONST CHAR8 *Str
+);
+// EFI_DISPATCH_ASCII_STR_CMP
+/// Performs a comparison of two strings
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+typedef
+INTN
+(EFIAPI
+*EFI_DISPATCH_ASCII_STR_CMP) (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2
+);
+// EFI_DISPATCH_ASCII_STRN_CMP
+/// Performs a comparison of at most a count of characters of two strings
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+typedef
+INTN
+(EFIAPI
+*EFI_DISPATCH_ASCII_STRN_CMP) (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2,
+  IN UINTN        Count
+);
+// EFI_DISPATCH_ASCII_STR_STR
+/// Returns the first occurrence of a sub-string in a string
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+typedef
+CHAR8 *
+(EFIAPI
+*EFI_DISPATCH_ASCII_STR_STR) (
+  IN CONST CHAR8 *String,
+  IN CONST CHAR8 *SearchString
+);
+// EFI_DISPATCH_COPY_MEM
+/// Copy the contents of one buffer to another buffer, the buffers may overlap
+/// @param Destination The destination buffer of the memory copy
+/// @param Source      The source buffer of the memory copy
+/// @param Length      The size in bytes to copy from Source to Destination
+typedef
+VOID
+(EFIAPI
+*EFI_DISPATCH_COPY_MEM) (
+  OUT VOID       *Destination,
+  IN  CONST VOID *Source,
+  IN  UINTN       Length
+);
+// EFI_DISPATCH_SET_MEM
+/// Fill a buffer with a specified value
+/// @param Buffer The buffer to fill
+/// @param Size   The size in bytes of the Buffer to fill
+/// @param Value  The value with which to fill Buffer
+typedef
+VOID
+(EFIAPI
+*EFI_DISPATCH_SET_MEM) (
+  OUT VOID  *Buffer,
+  IN  UINTN  Size,
+  IN  UINT8  Value
+);
+// EFI_DISPATCH_ASCII_TO_UTF16
+/// Widen the leading run of ASCII characters from a UTF-8 buffer to UTF-16
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The UTF-8 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the first byte that is not ASCII or is the null terminator
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_ASCII_TO_UTF16) (
+  OUT CHAR16      *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// EFI_DISPATCH_UTF16_TO_ASCII
+/// Narrow the leading run of ASCII characters from a UTF-16 buffer to UTF-8
+/// @param Output The UTF-8 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that is not ASCII or is the null terminator
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_UTF16_TO_ASCII) (
+  OUT CHAR8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// EFI_DISPATCH_LATIN1_TO_UTF16
+/// Widen the leading run of characters from a Latin-1 buffer to UTF-16
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The Latin-1 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the null terminator
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_LATIN1_TO_UTF16) (
+  OUT CHAR16      *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Count
+);
+// EFI_DISPATCH_UTF16_TO_LATIN1
+/// Narrow the leading run of Latin-1 characters from a UTF-16 buffer to Latin-1
+/// @param Output The Latin-1 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character above U+00FF or the null terminator
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_UTF16_TO_LATIN1) (
+  OUT UINT8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// EFI_DISPATCH_UTF16_SWAP
+/// Swap the byte order of the leading run of UTF-16 characters that need no validation, which are U+0001 to U+0377 since every code point in that range is a valid character
+/// @param Output The output buffer, which must have room for Count characters
+/// @param Input  The input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that needs validation or is the null terminator
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_UTF16_SWAP) (
+  OUT CHAR16       *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// EFI_DISPATCH_UTF8_VALIDATE
+/// Validate the leading run of well formed UTF-8 characters and count them
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_UTF8_VALIDATE) (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+);
+// EFI_DISPATCH_BASE64_ENCODE
+/// Encode complete three byte blocks of data to base64 characters
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is always a multiple of three
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_BASE64_ENCODE) (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+);
+// EFI_DISPATCH_BASE64_DECODE
+/// Decode complete four character blocks of base64 characters to data
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is always a multiple of four, decoding stops before the first block
+///          that contains padding, white space or any other character that is not in the base64 alphabet
+typedef
+UINTN
+(EFIAPI
+*EFI_DISPATCH_BASE64_DECODE) (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// EFI_DISPATCH_CRC32
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer
+/// @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer
+/// @return The updated 32-bit CRC
+typedef
+UINT32
+(EFIAPI
+*EFI_DISPATCH_CRC32) (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+);
+// EFI_DISPATCH_HASH_ACCUMULATE
+/// Accumulate sixty four byte stripes of data into the eight 64-bit hash accumulators, each stripe is keyed by the secret eight bytes further on
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Data         The data buffer
+/// @param Stripes      The count of sixty four byte stripes of the data buffer
+/// @param Secret       The secret of the first stripe, which must have (Stripes * 8) + 56 bytes
+typedef
+VOID
+(EFIAPI
+*EFI_DISPATCH_HASH_ACCUMULATE) (
+  IN OUT UINT64     *Accumulators,
+  IN     CONST VOID *Data,
+  IN     UINTN       Stripes,
+  IN     CONST VOID *Secret
+);
+// EFI_DISPATCH_BLIT
+/// Copy a rectangle of pixels
+/// @param Destination       The destination pixels
+/// @param DestinationStride The count of pixels in each row of the destination
+/// @param Source            The source pixels
+/// @param SourceStride      The count of pixels in each row of the source
+/// @param Width             The width in pixels of the rectangle
+/// @param Height            The height in pixels of the rectangle
+typedef
+VOID
+(EFIAPI
+*EFI_DISPATCH_BLIT) (
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL       *Destination,
+  IN  UINTN                                DestinationStride,
+  IN  CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Source,
+  IN  UINTN                                SourceStride,
+  IN  UINTN                                Width,
+  IN  UINTN                                Height
+);
+// EFI_DISPATCH_ALPHA_BLEND
+/// Blend a rectangle of pixels over another using the reserved member of the source pixels as alpha
+/// @param Destination       The destination pixels
+/// @param DestinationStride The count of pixels in each row of the destination
+/// @param Source            The source pixels
+/// @param SourceStride      The count of pixels in each row of the source
+/// @param Width             The width in pixels of the rectangle
+/// @param Height            The height in pixels of the rectangle
+typedef
+VOID
+(EFIAPI
+*EFI_DISPATCH_ALPHA_BLEND) (
+  IN OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL       *Destination,
+  IN     UINTN                                DestinationStride,
+  IN     CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Source,
+  IN     UINTN                                SourceStride,
+  IN     UINTN                                Width,
+  IN     UINTN                                Height
+);
+
+// EFI_DISPATCH_TABLE
+/// The selected kernel implementations
+typedef struct EFI_DISPATCH_TABLE EFI_DISPATCH_TABLE;
+struct EFI_DISPATCH_TABLE {
+
+  // StrLen
+  /// Get the length of a character string
+  EFI_DISPATCH_STR_LEN         StrLen;
+  // StrCmp
+  /// Performs a comparison of two strings
+  EFI_DISPATCH_STR_CMP         StrCmp;
+  // StrnCmp
+  /// Performs a comparison of at most a count of characters of two strings
+  EFI_DISPATCH_STRN_CMP        StrnCmp;
+  // StrStr
+  /// Returns the first occurrence of a sub-string in a string
+  EFI_DISPATCH_STR_STR         StrStr;
+  // StriPrefix
+  /// Get the count of leading characters of two strings that are ASCII, not null and equal ignoring case
+  EFI_DISPATCH_STRI_PREFIX     StriPrefix;
+  // AsciiStrLen
+  /// Get the length of a character string
+  EFI_DISPATCH_ASCII_STR_LEN   AsciiStrLen;
+  // AsciiStrCmp
+  /// Performs a comparison of two strings
+  EFI_DISPATCH_ASCII_STR_CMP   AsciiStrCmp;
+  // AsciiStrnCmp
+  /// Performs a comparison of at most a count of characters of two strings
+  EFI_DISPATCH_ASCII_STRN_CMP  AsciiStrnCmp;
+  // AsciiStrStr
+  /// Returns the first occurrence of a sub-string in a string
+  EFI_DISPATCH_ASCII_STR_STR   AsciiStrStr;
+  // CopyMem
+  /// Copy the contents of one buffer to another buffer
+  EFI_DISPATCH_COPY_MEM        CopyMem;
+  // SetMem
+  /// Fill a buffer with a specified value
+  EFI_DISPATCH_SET_MEM         SetMem;
+  // AsciiToUtf16
+  /// Widen the leading run of ASCII characters from a UTF-8 buffer to UTF-16
+  EFI_DISPATCH_ASCII_TO_UTF16  AsciiToUtf16;
+  // Utf16ToAscii
+  /// Narrow the leading run of ASCII characters from a UTF-16 buffer to UTF-8
+  EFI_DISPATCH_UTF16_TO_ASCII  Utf16ToAscii;
+  // Latin1ToUtf16
+  /// Widen the leading run of characters from a Latin-1 buffer to UTF-16
+  EFI_DISPATCH_LATIN1_TO_UTF16 Latin1ToUtf16;
+  // Utf16ToLatin1
+  /// Narrow the leading run of Latin-1 characters from a UTF-16 buffer to Latin-1
+  EFI_DISPATCH_UTF16_TO_LATIN1 Utf16ToLatin1;
+  // Utf16ToSwapped
+  /// Swap the byte order of the leading run of UTF-16 characters that need no validation, checking the characters before they are swapped
+  EFI_DISPATCH_UTF16_SWAP      Utf16ToSwapped;
+  // SwappedToUtf16
+  /// Swap the byte order of the leading run of UTF-16 characters that need no validation, checking the characters after they are swapped
+  EFI_DISPATCH_UTF16_SWAP      SwappedToUtf16;
+  // Utf8Validate
+  /// Validate the leading run of well formed UTF-8 characters and count them
+  EFI_DISPATCH_UTF8_VALIDATE   Utf8Validate;
+  // Base64Encode
+  /// Encode complete three byte blocks of data to base64 characters
+  EFI_DISPATCH_BASE64_ENCODE   Base64Encode;
+  // Base64Decode
+  /// Decode complete four character blocks of base64 characters to data
+  EFI_DISPATCH_BASE64_DECODE   Base64Decode;
+  // Crc32
+  /// Update a 32-bit CRC with a data buffer
+  EFI_DISPATCH_CRC32           Crc32;
+  // HashAccumulate
+  /// Accumulate sixty four byte stripes of data into the 64-bit hash accumulators
+  EFI_DISPATCH_HASH_ACCUMULATE HashAccumulate;
+  // Blit
+  /// Copy a rectangle of pixels
+  EFI_DISPATCH_BLIT            Blit;
+  // AlphaBlend
+  /// Blend a rectangle of pixels over another
+  EFI_DISPATCH_ALPHA_BLEND     AlphaBlend;
+
+};
+
+// EFI_BASE64_PAD
+/// The base64 decoding table value of the padding character, which ends the data
+#define EFI_BASE64_PAD 0x40
+// EFI_BASE64_SPACE
+/// The base64 decoding table value of white space characters, which are skipped
+#define EFI_BASE64_SPACE 0x41
+// EFI_BASE64_END
+/// The base64 decoding table value of the null terminator, which ends the data
+#define EFI_BASE64_END 0x42
+// EFI_BASE64_INVALID
+/// The base64 decoding table value of characters that are not base64
+#define EFI_BASE64_INVALID 0xFF
+
+// gEfiBase64Dictionary
+/// The base64 encoding dictionary
+EXTERN CONST CHAR8 gEfiBase64Dictionary[65];
+// gEfiBase64DecodeTable
+/// The six bit value of each base64 character or the kind of the other characters
+EXTERN CONST UINT8 gEfiBase64DecodeTable[256];
+
+// EfiDispatch
+/// Get the dispatch table, the first use selects the best kernels supported by the CPU
+/// @return The dispatch table of selected kernels
+EXTERN
+CONST EFI_DISPATCH_TABLE *
+EFIAPI
+EfiDispatch (
+  VOID
+);
+// EfiDispatchInitialize
+/// Select the dispatch table kernels using the configured maximum level from /Dispatch/Level and log the selected kernels
+/// @retval EFI_UNSUPPORTED The configured level is not supported by the CPU so the best supported level was selected
+/// @retval EFI_SUCCESS     The dispatch table kernels were selected
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiDispatchInitialize (
+  VOID
+);
+
+// EfiDispatchGetLevel
+/// Get the maximum level used to select the dispatch table kernels
+/// @return The maximum dispatch level
+EXTERN
+EFI_DISPATCH_LEVEL
+EFIAPI
+EfiDispatchGetLevel (
+  VOID
+);
+// EfiDispatchSetLevel
+/// Select the dispatch table kernels with a maximum level
+/// @param Level The maximum dispatch level of the selected kernels
+/// @retval EFI_INVALID_PARAMETER If Level is not a valid dispatch level
+/// @retval EFI_UNSUPPORTED       If Level is not supported by the CPU
+/// @retval EFI_SUCCESS           The dispatch table kernels were selected
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiDispatchSetLevel (
+  IN EFI_DISPATCH_LEVEL Level
+);
+// EfiDispatchGetBestLevel
+/// Get the best dispatch level supported by the CPU
+/// @return The best supported dispatch level
+EXTERN
+EFI_DISPATCH_LEVEL
+EFIAPI
+EfiDispatchGetBestLevel (
+  VOID
+);
+// EfiDispatchIsLevelSupported
+/// Check whether a dispatch level is supported by the CPU
+/// @param Level The dispatch level to check
+/// @return Whether the dispatch level is supported or not
+EXTERN
+BOOLEAN
+EFIAPI
+EfiDispatchIsLevelSupported (
+  IN EFI_DISPATCH_LEVEL Level
+);
+// EfiDispatchLevelToString
+/// Get the name of a dispatch level
+/// @param Level The dispatch level
+/// @return The name of the dispatch level or NULL if the level is invalid
+EXTERN
+CONST CHAR16 *
+EFIAPI
+EfiDispatchLevelToString (
+  IN EFI_DISPATCH_LEVEL Level
+);
+// EfiDispatchLevelFromString
+/// Get a dispatch level from the name of the dispatch level
+/// @param Name  The case insensitive name of the dispatch level
+/// @param Level On output, the dispatch level
+/// @retval EFI_INVALID_PARAMETER If Name or Level is NULL
+/// @retval EFI_NOT_FOUND         If Name is not the name of a dispatch level
+/// @retval EFI_SUCCESS           The dispatch level was returned successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiDispatchLevelFromString (
+  IN  CONST CHAR16       *Name,
+  OUT EFI_DISPATCH_LEVEL *Level
+);
+
+// EfiDispatchStringBenchmark
+/// Log the time of the string kernels at each supported dispatch level for a sweep of string lengths
+/// @param Count The count of calls to each kernel for each measurement
+/// @retval EFI_INVALID_PARAMETER If Count is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The strings could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiDispatchStringBenchmark (
+  IN UINTN Count
+);
+// EfiDispatchCrc32Benchmark
+/// Log the time of the CRC kernel at each supported dispatch level and of the firmware boot service for a buffer
+/// @param Size The size in bytes of the buffer to use
+/// @retval EFI_INVALID_PARAMETER If Size is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiDispatchCrc32Benchmark (
+  IN UINTN Size
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_DISPATCH_HEADER__
@@ -0,0 +1,179 @@
+///
+/// @file Include/Uefi/Hash.h
+///
+/// UEFI fast non-cryptographic hashing
+///
+
+#pragma once
+#ifndef __UEFI_HASH_HEADER__
+#define __UEFI_HASH_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_HASH_SECRET_SIZE
+/// The size in bytes of the secret that keys the hash of long data
+#define EFI_HASH_SECRET_SIZE 192
+// EFI_HASH_BUFFER_SIZE
+/// The size in bytes of the data buffered by an incremental hash context
+#define EFI_HASH_BUFFER_SIZE 256
+
+// EFI_HASH_CONTEXT
+/// A context to compute a 64-bit hash incrementally
+typedef struct EFI_HASH_CONTEXT EFI_HASH_CONTEXT;
+struct EFI_HASH_CONTEXT {
+
+  // Accumulators
+  /// The accumulators of the stripes consumed so far
+  UINT64 Accumulators[8];
+  // Secret
+  /// The secret derived from the seed
+  UINT8  Secret[EFI_HASH_SECRET_SIZE];
+  // Buffer
+  /// The data that has not been consumed, the end also keeps the last consumed stripe
+  UINT8  Buffer[EFI_HASH_BUFFER_SIZE];
+  // Size
+  /// The size in bytes of the data so far
+  UINT64 Size;
+  // Seed
+  /// The seed of the hash
+  UINT64 Seed;
+  // Buffered
+  /// The size in bytes of the data in the buffer that has not been consumed
+  UINTN  Buffered;
+  // Stripes
+  /// The count of stripes consumed in the current block
+  UINTN  Stripes;
+
+};
+
+// EfiHash64
+/// Compute the 64-bit hash of a data buffer, the hash is the XXH3 64-bit hash
+/// @param Data The data buffer, which may be NULL if Size is zero
+/// @param Size The size in bytes of the data buffer
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the data buffer
+EXTERN
+UINT64
+EFIAPI
+EfiHash64 (
+  IN CONST VOID *Data OPTIONAL,
+  IN UINTN       Size,
+  IN UINT64      Seed
+);
+
+// EfiHash64Init
+/// Initialize a context to compute a 64-bit hash incrementally
+/// @param Context The hash context to initialize
+/// @param Seed    The seed of the hash
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           If the context was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiHash64Init (
+  OUT EFI_HASH_CONTEXT *Context,
+  IN  UINT64            Seed
+);
+// EfiHash64Update
+/// Update a 64-bit hash context with the next part of the data
+/// @param Context The hash context
+/// @param Data    The next part of the data, which may be NULL if Size is zero
+/// @param Size    The size in bytes of the next part of the data
+/// @retval EFI_INVALID_PARAMETER If Context is NULL or Data is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the context was updated
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiHash64Update (
+  IN OUT EFI_HASH_CONTEXT *Context,
+  IN     CONST VOID       *Data OPTIONAL,
+  IN     UINTN             Size
+);
+// EfiHash64Final
+/// Get the 64-bit hash of all the data a context was updated with, the context is unchanged and may be updated further
+/// @param Context The hash context
+/// @param Hash    On output, the 64-bit hash, which is the same as the hash of all the data at once
+/// @retval EFI_INVALID_PARAMETER If Context or Hash is NULL
+/// @retval EFI_SUCCESS           If the 64-bit hash was returned
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiHash64Final (
+  IN  CONST EFI_HASH_CONTEXT *Context,
+  OUT UINT64                 *Hash
+);
+
+// StrHash64
+/// Compute the 64-bit hash of the characters of a string, which is the hash of the characters as UTF-16 data
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+EXTERN
+UINT64
+EFIAPI
+StrHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINT64        Seed
+);
+// StrnHash64
+/// Compute the 64-bit hash of at most a count of characters of a string, which is the hash of the characters as UTF-16 data
+/// @param Str    The string, which may be NULL to hash no characters
+/// @param Length The maximum count of characters to hash, the string is hashed up to the null terminator if it is shorter
+/// @param Seed   The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+EXTERN
+UINT64
+EFIAPI
+StrnHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINTN         Length,
+  IN UINT64        Seed
+);
+// StriHash64
+/// Compute the case insensitive 64-bit hash of the characters of a string, which is the hash of the upper case characters as UTF-16 data
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the upper case characters of the string
+EXTERN
+UINT64
+EFIAPI
+StriHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINT64        Seed
+);
+// StrniHash64
+/// Compute the case insensitive 64-bit hash of at most a count of characters of a string, which is the hash of the upper case characters as UTF-16 data
+/// @param Str    The string, which may be NULL to hash no characters
+/// @param Length The maximum count of characters to hash, the string is hashed up to the null terminator if it is shorter
+/// @param Seed   The seed of the hash
+/// @return The 64-bit hash of the upper case characters of the string
+EXTERN
+UINT64
+EFIAPI
+StrniHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINTN         Length,
+  IN UINT64        Seed
+);
+// AsciiStrHash64
+/// Compute the 64-bit hash of the characters of a string
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+EXTERN
+UINT64
+EFIAPI
+AsciiStrHash64 (
+  IN CONST CHAR8 *Str OPTIONAL,
+  IN UINT64       Seed
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_HASH_HEADER__
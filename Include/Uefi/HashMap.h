@@ -0,0 +1,287 @@
+///
+/// @file Include/Uefi/HashMap.h
+///
+/// UEFI open addressing hash map template
+///
+
+#pragma once
+#ifndef __UEFI_HASH_MAP_HEADER__
+#define __UEFI_HASH_MAP_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_HASH_MAP_MINIMUM_CAPACITY
+/// The least count of slots in a hash map, must be a power of two
+#define EFI_HASH_MAP_MINIMUM_CAPACITY 16
+
+// EFI_HASH_MAP_DECLARE
+/// Declare an open addressing hash map type, its entry type and its functions, place in a header or before the first use
+///  TYPE##_ENTRY is the entry type with the Hash, Key and Value members and TYPE is the map type with the Entries, Count and Capacity members
+///  Prefix##Initialize(Map) initializes an empty map and Prefix##Free(Map) frees the slots but not the keys or values
+///  Prefix##Find(Map, Key) returns the value of a key or NULL
+///  Prefix##Insert(Map, Key, &Value) returns EFI_SUCCESS with a zeroed value for a new key or EFI_ALREADY_STARTED with the value of an existing key
+///  Prefix##Remove(Map, Key, &Removed) removes a key and returns its entry so the key and value may be freed
+///  Prefix##Next(Map, &Index) returns the next entry from an index that starts at zero or NULL after the last entry
+/// @param TYPE       The hash map type name
+/// @param Prefix     The prefix of the hash map function names
+/// @param KEY_TYPE   The type of the keys, which are stored by value
+/// @param VALUE_TYPE The type of the values, which are stored by value
+#define EFI_HASH_MAP_DECLARE(TYPE, Prefix, KEY_TYPE, VALUE_TYPE) \
+  typedef struct TYPE##_ENTRY TYPE##_ENTRY; \
+  struct TYPE##_ENTRY { \
+    UINT64     Hash; \
+    KEY_TYPE   Key; \
+    VALUE_TYPE Value; \
+  }; \
+  typedef struct TYPE TYPE; \
+  struct TYPE { \
+    TYPE##_ENTRY *Entries; \
+    UINTN         Count; \
+    UINTN         Capacity; \
+  }; \
+  EXTERN VOID EFIAPI Prefix##Initialize (OUT TYPE *Map); \
+  EXTERN VOID EFIAPI Prefix##Free (IN OUT TYPE *Map); \
+  EXTERN VALUE_TYPE * EFIAPI Prefix##Find (IN CONST TYPE *Map, IN KEY_TYPE Key); \
+  EXTERN EFI_STATUS EFIAPI Prefix##Insert (IN OUT TYPE *Map, IN KEY_TYPE Key, OUT VALUE_TYPE **Value); \
+  EXTERN EFI_STATUS EFIAPI Prefix##Remove (IN OUT TYPE *Map, IN KEY_TYPE Key, OUT TYPE##_ENTRY *Removed OPTIONAL); \
+  EXTERN TYPE##_ENTRY * EFIAPI Prefix##Next (IN CONST TYPE *Map, IN OUT UINTN *Index)
+
+// EFI_HASH_MAP_DEFINE
+/// Define the functions of a declared open addressing hash map once in a source file, the slots are linearly probed and removal shifts
+///  the following entries back so there are no tombstones
+/// @param TYPE       The hash map type name
+/// @param Prefix     The prefix of the hash map function names
+/// @param KEY_TYPE   The type of the keys
+/// @param VALUE_TYPE The type of the values
+/// @param KeyHash    The function that returns the UINT64 hash of a key
+/// @param KeysEqual  The function that returns whether two keys are equal as a BOOLEAN
+#define EFI_HASH_MAP_DEFINE(TYPE, Prefix, KEY_TYPE, VALUE_TYPE, KeyHash, KeysEqual) \
+  STATIC UINT64 EFIAPI Prefix##Hash (IN KEY_TYPE Key) { \
+    UINT64 Hash = KeyHash(Key); \
+    return (Hash == 0) ? 1 : Hash; \
+  } \
+  STATIC TYPE##_ENTRY * EFIAPI Prefix##Slot (IN CONST TYPE *Map, IN KEY_TYPE Key, IN UINT64 Hash) { \
+    UINTN Mask = Map->Capacity - 1; \
+    UINTN Index = (UINTN)Hash & Mask; \
+    while ((Map->Entries[Index].Hash != 0) && ((Map->Entries[Index].Hash != Hash) || !KeysEqual(Map->Entries[Index].Key, Key))) { \
+      Index = (Index + 1) & Mask; \
+    } \
+    return Map->Entries + Index; \
+  } \
+  STATIC EFI_STATUS EFIAPI Prefix##Grow (IN OUT TYPE *Map) { \
+    TYPE##_ENTRY *Entries; \
+    UINTN         Capacity; \
+    UINTN         Index; \
+    UINTN         Slot; \
+    if (((Map->Count + 1) * 4) <= (Map->Capacity * 3)) { \
+      return EFI_SUCCESS; \
+    } \
+    Capacity = (Map->Capacity == 0) ? EFI_HASH_MAP_MINIMUM_CAPACITY : (Map->Capacity * 2); \
+    Entries = EfiAllocateArray(TYPE##_ENTRY, Capacity); \
+    if (Entries == NULL) { \
+      return EFI_OUT_OF_RESOURCES; \
+    } \
+    for (Index = 0; Index < Map->Capacity; ++Index) { \
+      if (Map->Entries[Index].Hash != 0) { \
+        for (Slot = (UINTN)Map->Entries[Index].Hash & (Capacity - 1); Entries[Slot].Hash != 0; Slot = (Slot + 1) & (Capacity - 1)); \
+        Entries[Slot] = Map->Entries[Index]; \
+      } \
+    } \
+    if (Map->Entries != NULL) { \
+      EfiFreePool(Map->Entries); \
+    } \
+    Map->Entries = Entries; \
+    Map->Capacity = Capacity; \
+    return EFI_SUCCESS; \
+  } \
+  VOID EFIAPI Prefix##Initialize (OUT TYPE *Map) { \
+    if (Map != NULL) { \
+      Map->Entries = NULL; \
+      Map->Count = 0; \
+      Map->Capacity = 0; \
+    } \
+  } \
+  VOID EFIAPI Prefix##Free (IN OUT TYPE *Map) { \
+    if (Map != NULL) { \
+      if (Map->Entries != NULL) { \
+        EfiFreePool(Map->Entries); \
+      } \
+      Map->Entries = NULL; \
+      Map->Count = 0; \
+      Map->Capacity = 0; \
+    } \
+  } \
+  VALUE_TYPE * EFIAPI Prefix##Find (IN CONST TYPE *Map, IN KEY_TYPE Key) { \
+    TYPE##_ENTRY *Entry; \
+    if ((Map == NULL) || (Map->Count == 0)) { \
+      return NULL; \
+    } \
+    Entry = Prefix##Slot(Map, Key, Prefix##Hash(Key)); \
+    return (Entry->Hash != 0) ? &(Entry->Value) : NULL; \
+  } \
+  EFI_STATUS EFIAPI Prefix##Insert (IN OUT TYPE *Map, IN KEY_TYPE Key, OUT VALUE_TYPE **Value) { \
+    TYPE##_ENTRY *Entry; \
+    EFI_STATUS    Status; \
+    UINT64        Hash; \
+    if ((Map == NULL) || (Value == NULL)) { \
+      return EFI_INVALID_PARAMETER; \
+    } \
+    Hash = Prefix##Hash(Key); \
+    if (Map->Count != 0) { \
+      Entry = Prefix##Slot(Map, Key, Hash); \
+      if (Entry->Hash != 0) { \
+        *Value = &(Entry->Value); \
+        return EFI_ALREADY_STARTED; \
+      } \
+    } \
+    Status = Prefix##Grow(Map); \
+    if (EFI_ERROR(Status)) { \
+      return Status; \
+    } \
+    Entry = Prefix##Slot(Map, Key, Hash); \
+    Entry->Hash = Hash; \
+    Entry->Key = Key; \
+    ++(Map->Count); \
+    *Value = &(Entry->Value); \
+    return EFI_SUCCESS; \
+  } \
+  EFI_STATUS EFIAPI Prefix##Remove (IN OUT TYPE *Map, IN KEY_TYPE Key, OUT TYPE##_ENTRY *Removed OPTIONAL) { \
+    TYPE##_ENTRY *Entry; \
+    UINTN         Mask; \
+    UINTN         Index; \
+    UINTN         Next; \
+    if (Map == NULL) { \
+      return EFI_INVALID_PARAMETER; \
+    } \
+    if (Map->Count == 0) { \
+      return EFI_NOT_FOUND; \
+    } \
+    Entry = Prefix##Slot(Map, Key, Prefix##Hash(Key)); \
+    if (Entry->Hash == 0) { \
+      return EFI_NOT_FOUND; \
+    } \
+    if (Removed != NULL) { \
+      *Removed = *Entry; \
+    } \
+    Mask = Map->Capacity - 1; \
+    Index = (UINTN)(Entry - Map->Entries); \
+    for (Next = (Index + 1) & Mask; Map->Entries[Next].Hash != 0; Next = (Next + 1) & Mask) { \
+      if (((Next - (UINTN)Map->Entries[Next].Hash) & Mask) >= ((Next - Index) & Mask)) { \
+        Map->Entries[Index] = Map->Entries[Next]; \
+        Index = Next; \
+      } \
+    } \
+    EfiZeroMem(Map->Entries + Index, sizeof(TYPE##_ENTRY)); \
+    --(Map->Count); \
+    return EFI_SUCCESS; \
+  } \
+  TYPE##_ENTRY * EFIAPI Prefix##Next (IN CONST TYPE *Map, IN OUT UINTN *Index) { \
+    if ((Map == NULL) || (Index == NULL)) { \
+      return NULL; \
+    } \
+    for (; *Index < Map->Capacity; ++(*Index)) { \
+      if (Map->Entries[*Index].Hash != 0) { \
+        return Map->Entries + (*Index)++; \
+      } \
+    } \
+    return NULL; \
+  }
+
+// EfiHashMapStrHash
+/// Hash a string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the string key
+EXTERN
+UINT64
+EFIAPI
+EfiHashMapStrHash (
+  IN CONST CHAR16 *Key
+);
+// EfiHashMapStrEqual
+/// Check if two string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal or not
+EXTERN
+BOOLEAN
+EFIAPI
+EfiHashMapStrEqual (
+  IN CONST CHAR16 *Key1,
+  IN CONST CHAR16 *Key2
+);
+// EfiHashMapStriHash
+/// Hash a case insensitive string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the upper case string key
+EXTERN
+UINT64
+EFIAPI
+EfiHashMapStriHash (
+  IN CONST CHAR16 *Key
+);
+// EfiHashMapStriEqual
+/// Check if two case insensitive string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal ignoring case or not
+EXTERN
+BOOLEAN
+EFIAPI
+EfiHashMapStriEqual (
+  IN CONST CHAR16 *Key1,
+  IN CONST CHAR16 *Key2
+);
+// EfiHashMapAsciiStrHash
+/// Hash a string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the string key
+EXTERN
+UINT64
+EFIAPI
+EfiHashMapAsciiStrHash (
+  IN CONST CHAR8 *Key
+);
+// EfiHashMapAsciiStrEqual
+/// Check if two string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal or not
+EXTERN
+BOOLEAN
+EFIAPI
+EfiHashMapAsciiStrEqual (
+  IN CONST CHAR8 *Key1,
+  IN CONST CHAR8 *Key2
+);
+// EfiHashMapPointerHash
+/// Hash a pointer or integer key of a hash map
+/// @param Key The pointer or integer key
+/// @return The 64-bit hash of the key
+EXTERN
+UINT64
+EFIAPI
+EfiHashMapPointerHash (
+  IN CONST VOID *Key
+);
+// EfiHashMapPointerEqual
+/// Check if two pointer or integer keys of a hash map are equal
+/// @param Key1 The first key
+/// @param Key2 The second key
+/// @return Whether the keys are equal or not
+EXTERN
+BOOLEAN
+EFIAPI
+EfiHashMapPointerEqual (
+  IN CONST VOID *Key1,
+  IN CONST VOID *Key2
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_HASH_MAP_HEADER__
@@ -0,0 +1,66 @@
+///
+/// @file Include/Uefi/Intern.h
+///
+/// UEFI string interning
+///
+
+#pragma once
+#ifndef __UEFI_INTERN_HEADER__
+#define __UEFI_INTERN_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// STR_INTERN_CASE_INSENSITIVE
+/// Intern strings case insensitively, strings that differ only by case share the spelling that was interned first
+#define STR_INTERN_CASE_INSENSITIVE EFI_BIT(0)
+// STR_INTERN_FIND_ONLY
+/// Only find an already interned string, never add the string
+#define STR_INTERN_FIND_ONLY EFI_BIT(1)
+
+// StrIntern
+/// Intern a string so that equal strings have the same stable pointer and compare with pointer equality
+/// @param Str   The string to intern
+/// @param Flags The interning flags
+/// @return The interned string, which must not be modified or freed, or NULL if Str is NULL, memory could not be allocated, or STR_INTERN_FIND_ONLY was used and the string was not interned
+EXTERN
+CONST CHAR16 *
+EFIAPI
+StrIntern (
+  IN CONST CHAR16 *Str,
+  IN UINTN         Flags
+);
+// StrnIntern
+/// Intern at most a count of characters of a string so that equal strings have the same stable pointer and compare with pointer equality
+/// @param Str    The string to intern
+/// @param Length The maximum count of characters to intern, the string is interned up to the null terminator if it is shorter
+/// @param Flags  The interning flags
+/// @return The null terminated interned string, which must not be modified or freed, or NULL if Str is NULL, memory could not be allocated, or STR_INTERN_FIND_ONLY was used and the string was not interned
+EXTERN
+CONST CHAR16 *
+EFIAPI
+StrnIntern (
+  IN CONST CHAR16 *Str,
+  IN UINTN         Length,
+  IN UINTN         Flags
+);
+
+// EfiInternFree
+/// Free every interned string, any interned string pointer is invalid afterwards
+/// @return Whether the interned strings were freed or not
+/// @retval EFI_SUCCESS If the interned strings were freed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiInternFree (
+  VOID
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_INTERN_HEADER__
@@ -92,6 +92,15 @@ WriteMsr (
   IN UINT32 Msr,
   IN UINT64 Value
 );
+// EfiReadTimeStampCounter
+/// Read the processor time stamp counter
+/// @return The current value of the time stamp counter
+EXTERN
+UINT64
+EFIAPI
+EfiReadTimeStampCounter (
+  VOID
+);
 // EfiCpuid
 /// Call CPUID instruction
 /// @param Function The function to execute
@@ -128,6 +137,17 @@ EfiCpuidEx (
   OUT UINT32 *Ecx OPTIONAL,
   OUT UINT32 *Edx OPTIONAL
 );
+// EfiGetExtendedControlRegister
+/// Read an extended control register, the CPU must support XGETBV and the firmware must have enabled it
+/// @param Index The index of the extended control register to read
+/// @return The value of the extended control register
+EXTERN
+UINT64
+EFIAPI
+EfiGetExtendedControlRegister (
+  IN UINT32 Index
+);
+
 // EfiGetTaskRegister
 /// Store local descriptor table
 /// @param Descriptor On output, the task register
@@ -165,6 +185,25 @@ EfiGetGlobalDescriptorTable (
   OUT UINT8 DescriptorAndAddress[sizeof(UINT16) + sizeof(UINT32)]
 );
 
+// EfiCpuMonitor
+/// Arm the address monitor hardware to watch a range of memory for stores, the CPU must support MONITOR
+/// @param Address The address of the memory to watch
+EXTERN
+VOID
+EFIAPI
+EfiCpuMonitor (
+  IN CONST VOID *Address
+);
+// EfiCpuMwait
+/// Wait for a store to the range of memory armed with EfiCpuMonitor or an interrupt, the CPU must support MWAIT
+/// @param Hints The target C-state and sub C-state hints
+EXTERN
+VOID
+EFIAPI
+EfiCpuMwait (
+  IN UINT32 Hints
+);
+
 #endif // EFI_ARCH_IA32 || EFI_ARCH_X64
 
 // EfiCpuPause
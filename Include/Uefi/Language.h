@@ -86,7 +86,8 @@ EfiGetLanguages (
 );
 
 // EfiGetLanguageCollationProtocol
-/// Get a collation protocol by language
+/// Get a collation protocol by language, the current language collation protocol is cached until the language is
+///  changed with EfiSetLanguage or a collation protocol is installed
 /// @param Language The language of the collation protocol or NULL for the current language collation prtocol
 /// @return The collation protocol for the specified language or NULL if not found
 EXTERN
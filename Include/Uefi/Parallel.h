@@ -0,0 +1,205 @@
+///
+/// @file Include/Uefi/Parallel.h
+///
+/// UEFI data parallel helpers
+///
+
+#pragma once
+#ifndef __UEFI_PARALLEL_HEADER__
+#define __UEFI_PARALLEL_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_PARALLEL_CACHE_LINE_SIZE
+/// The size of a cache line, per processor result slots are aligned and padded to this size
+#define EFI_PARALLEL_CACHE_LINE_SIZE 64
+
+// EFI_PARALLEL_CRC32_MINIMUM
+/// The minimum size in bytes of a buffer to compute a CRC in parallel
+#define EFI_PARALLEL_CRC32_MINIMUM 0x100000
+
+// EFI_PARALLEL_GRAIN_STATIC
+/// Split the range into one contiguous chunk for each processor
+#define EFI_PARALLEL_GRAIN_STATIC 0
+
+// EFI_PARALLEL_BODY
+/// Parallel loop body, called for each chunk of the range from any processor, so it must not use boot services
+/// @param Begin   The first index of the chunk
+/// @param End     The index after the last index of the chunk
+/// @param Context The context passed to EfiParallelFor
+typedef
+VOID
+(EFIAPI
+*EFI_PARALLEL_BODY) (
+  IN UINTN  Begin,
+  IN UINTN  End,
+  IN VOID  *Context OPTIONAL
+);
+// EFI_PARALLEL_MAP
+/// Parallel map, called for each chunk of the range from any processor, so it must not use boot services
+/// @param Begin   The first index of the chunk
+/// @param End     The index after the last index of the chunk
+/// @param Context The context passed to EfiParallelMapReduce
+/// @param Result  On input, the partial result of the processor slot which is zero before the first chunk, on output, the partial result combined with the chunk result
+typedef
+VOID
+(EFIAPI
+*EFI_PARALLEL_MAP) (
+  IN     UINTN  Begin,
+  IN     UINTN  End,
+  IN     VOID  *Context OPTIONAL,
+  IN OUT VOID  *Result
+);
+// EFI_PARALLEL_REDUCE
+/// Parallel reduce, called on the boot strap processor for each used slot in order
+/// @param Result  On input, the combined result so far, on output, the result combined with the partial result
+/// @param Partial The partial result of a processor slot
+/// @param Context The context passed to EfiParallelMapReduce
+typedef
+VOID
+(EFIAPI
+*EFI_PARALLEL_REDUCE) (
+  IN OUT VOID       *Result,
+  IN     CONST VOID *Partial,
+  IN     VOID       *Context OPTIONAL
+);
+
+// EfiParallelInitialize
+/// Initialize the parallel helpers, must be called from the boot strap processor before any parallel execution is possible
+/// @retval EFI_UNSUPPORTED There are no application processors so parallel helpers will run on the boot strap processor only
+/// @retval EFI_SUCCESS     The parallel helpers were initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiParallelInitialize (
+  VOID
+);
+
+// EfiParallelIsAvailable
+/// Check whether the application processors can be used, which is only from the boot strap processor while boot services are available
+/// @return Whether the application processors can be used
+EXTERN
+BOOLEAN
+EFIAPI
+EfiParallelIsAvailable (
+  VOID
+);
+// EfiParallelGetProcessorCount
+/// Get the number of processors used for parallel execution
+/// @return The number of processors, including the boot strap processor, used for parallel execution
+EXTERN
+UINTN
+EFIAPI
+EfiParallelGetProcessorCount (
+  VOID
+);
+// EfiParallelSetProcessorLimit
+/// Set the maximum number of processors used for parallel execution
+/// @param Limit The maximum number of processors, including the boot strap processor, or zero for all enabled processors
+/// @return The number of processors that will be used for parallel execution
+EXTERN
+UINTN
+EFIAPI
+EfiParallelSetProcessorLimit (
+  IN UINTN Limit
+);
+
+// EfiParallelFor
+/// Execute a loop body over a range on the boot strap processor and all enabled application processors
+/// @param Begin   The first index of the range
+/// @param End     The index after the last index of the range
+/// @param Grain   The number of indices in each dynamically scheduled chunk or EFI_PARALLEL_GRAIN_STATIC for one chunk per processor
+/// @param Body    The loop body to call for each chunk
+/// @param Context The context to pass to the loop body
+/// @retval EFI_INVALID_PARAMETER If Body is NULL or End is less than Begin
+/// @retval EFI_SUCCESS           The loop body was called for every chunk of the range
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiParallelFor (
+  IN UINTN              Begin,
+  IN UINTN              End,
+  IN UINTN              Grain,
+  IN EFI_PARALLEL_BODY  Body,
+  IN VOID              *Context OPTIONAL
+);
+// EfiParallelMapReduce
+/// Map chunks of a range into per processor cache line aligned result slots then reduce the slots into a result
+/// @param Begin      The first index of the range
+/// @param End        The index after the last index of the range
+/// @param Grain      The number of indices in each dynamically scheduled chunk or EFI_PARALLEL_GRAIN_STATIC for one chunk per processor,
+///                    with static scheduling the slots are reduced in range order so the reduction may be order dependent
+/// @param Map        The map to call for each chunk
+/// @param Reduce     The reduce to call for each used slot
+/// @param ResultSize The size in bytes of a result
+/// @param Result     On input, the initial result, on output, the initial result combined with every partial result
+/// @param Context    The context to pass to the map and reduce
+/// @retval EFI_INVALID_PARAMETER If Map, Reduce, or Result is NULL, ResultSize is zero, or End is less than Begin
+/// @retval EFI_OUT_OF_RESOURCES  The result slots could not be allocated
+/// @retval EFI_SUCCESS           The result was reduced from every chunk of the range
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiParallelMapReduce (
+  IN     UINTN                Begin,
+  IN     UINTN                End,
+  IN     UINTN                Grain,
+  IN     EFI_PARALLEL_MAP     Map,
+  IN     EFI_PARALLEL_REDUCE  Reduce,
+  IN     UINTN                ResultSize,
+  IN OUT VOID                *Result,
+  IN     VOID                *Context OPTIONAL
+);
+
+// EfiParallelCrc32
+/// Compute a 32-bit CRC of a buffer by splitting it across processors and combining the partial CRCs
+/// @param Crc32 The CRC of the preceding data or zero to start a new CRC
+/// @param Data  The buffer on which the CRC is to be computed
+/// @param Size  The size in bytes of the buffer
+/// @return The CRC of the preceding data and the buffer
+EXTERN
+UINT32
+EFIAPI
+EfiParallelCrc32 (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+);
+// EfiCrc32Combine
+/// Combine two 32-bit CRCs as if the data were contiguous
+/// @param Crc1  The CRC of the first data
+/// @param Crc2  The CRC of the second data
+/// @param Size2 The size in bytes of the second data
+/// @return The CRC of the first data followed by the second data
+EXTERN
+UINT32
+EFIAPI
+EfiCrc32Combine (
+  IN UINT32 Crc1,
+  IN UINT32 Crc2,
+  IN UINTN  Size2
+);
+
+// EfiParallelBenchmark
+/// Log the time to compute a parallel CRC of a buffer with each number of processors from one to all enabled processors
+/// @param Size The size in bytes of the buffer to use
+/// @retval EFI_INVALID_PARAMETER If Size is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiParallelBenchmark (
+  IN UINTN Size
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_PARALLEL_HEADER__
@@ -82,6 +82,24 @@ BOOLEAN
   IN VOID                   *Context
 );
 
+// EFI_CONFIGURATION_DECODE
+/// Decode the text of a configuration key value when the value is first accessed
+/// @param Type  The type of the key value
+/// @param Text  The text of the key value, which may be decoded in place so the text buffer becomes the key value
+/// @param Value On output, the decoded key value, which is allocated or is the text buffer
+/// @param Size  On output, the size in bytes of the decoded key value
+/// @retval EFI_SUCCESS The text was decoded
+/// @return Any other status if the text could not be decoded
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_CONFIGURATION_DECODE) (
+  IN  EFI_CONFIGURATION_TYPE   Type,
+  IN  CHAR16                  *Text,
+  OUT VOID                   **Value,
+  OUT UINTN                   *Size
+);
+
 // EFI_CONFIGURATION_EXISTS
 /// Check key exists
 /// @param This The configuration protocol interface
@@ -154,6 +172,25 @@ EFI_STATUS
   IN UINTN                       Size,
   IN EFI_CONFIGURATION_TYPE      Type
 );
+// EFI_CONFIGURATION_SET_ENCODED
+/// Set a configuration value by key as text that is decoded when the value is first accessed
+/// @param This   The configuration protocol interface
+/// @param Key    The key path identifier
+/// @param Text   The text of the value
+/// @param Type   The configuration key value type, which must not be a list or array type
+/// @param Decode The function that decodes the text to the value
+/// @retval EFI_INVALID_PARAMETER If This, Key, Text, or Decode is NULL or Type is a list or array type
+/// @retval EFI_SUCCESS           The text and type of the key were set successfully
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_CONFIGURATION_SET_ENCODED) (
+  IN EFI_CONFIGURATION_PROTOCOL *This,
+  IN CONST CHAR16               *Key,
+  IN CONST CHAR16               *Text,
+  IN EFI_CONFIGURATION_TYPE      Type,
+  IN EFI_CONFIGURATION_DECODE    Decode
+);
 // EFI_CONFIGURATION_REMOVE
 /// Remove key by path identifier
 /// @param This The configuration protocol interface
@@ -213,6 +250,9 @@ struct EFI_CONFIGURATION_PROTOCOL {
   // Enumerate
   /// Enumerate keys
   EFI_CONFIGURATION_ENUMERATE    Enumerate;
+  // SetEncoded
+  /// Set a configuration value by key as text that is decoded when first accessed
+  EFI_CONFIGURATION_SET_ENCODED  SetEncoded;
 
 };
 
@@ -469,6 +509,23 @@ EfiConfigurationSetFloat (
   IN CONST CHAR16 *Key,
   IN FLOAT64       Float
 );
+// EfiConfigurationSetEncoded
+/// Set a configuration value by key as text that is decoded when the value is first accessed
+/// @param Key    The key path identifier
+/// @param Text   The text of the value
+/// @param Type   The configuration key value type, which must not be a list or array type
+/// @param Decode The function that decodes the text to the value
+/// @retval EFI_INVALID_PARAMETER If Key, Text, or Decode is NULL or Type is a list or array type
+/// @retval EFI_SUCCESS           The text and type of the key were set successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiConfigurationSetEncoded (
+  IN CONST CHAR16             *Key,
+  IN CONST CHAR16             *Text,
+  IN EFI_CONFIGURATION_TYPE    Type,
+  IN EFI_CONFIGURATION_DECODE  Decode
+);
 
 // EfiConfigurationRemove
 /// Remove key by path identifier
@@ -48,6 +48,19 @@ EXTERN EFI_GUID gEfiUtf16EncodingProtocolGuid;
 /// The UTF-16 byte swapped character string encoding protocol unique identifier
 EXTERN EFI_GUID gEfiUtf16SwappedEncodingProtocolGuid;
 
+// EFI_ENCODING_CONFIDENCE_LOW
+/// The detected encoding is a guess that decodes the content but should only be used if there is no better choice
+#define EFI_ENCODING_CONFIDENCE_LOW 25
+// EFI_ENCODING_CONFIDENCE_MEDIUM
+/// The detected encoding decodes the content and matches its patterns
+#define EFI_ENCODING_CONFIDENCE_MEDIUM 50
+// EFI_ENCODING_CONFIDENCE_HIGH
+/// The detected encoding was declared by the content or strongly matches its patterns
+#define EFI_ENCODING_CONFIDENCE_HIGH 75
+// EFI_ENCODING_CONFIDENCE_CERTAIN
+/// The detected encoding was marked by a byte order mark
+#define EFI_ENCODING_CONFIDENCE_CERTAIN 100
+
 // EFI_ENCODING_PROTOCOL
 /// Character string encoding protocol
 typedef struct EFI_ENCODING_PROTOCOL EFI_ENCODING_PROTOCOL;
@@ -92,6 +105,24 @@ EFI_STATUS
   IN OUT UINTN                 *Size,
   IN     UINT32                 Character
 );
+// EFI_ENCODING_VALIDATE
+/// Validate and count the leading run of well formed characters of an encoded character string
+/// @param This   The encoding protocol interface
+/// @param Buffer The encoded character string buffer to validate
+/// @param Size   On input, the size in bytes of the encoded character string buffer or zero if the string is null terminated, on output, the size in bytes of the well formed characters before the null terminator or the first invalid character
+/// @param Count  On output, the count of well formed characters
+/// @retval EFI_INVALID_PARAMETER If This, Buffer, or Size is NULL
+/// @retval EFI_NO_MAPPING        If validation stopped before an invalid or truncated character
+/// @retval EFI_SUCCESS           If every character before the null terminator or the end of the buffer is well formed
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_ENCODING_VALIDATE) (
+  IN     EFI_ENCODING_PROTOCOL *This,
+  IN     CONST VOID            *Buffer,
+  IN OUT UINTN                 *Size,
+  OUT    UINTN                 *Count OPTIONAL
+);
 
 // EFI_ENCODING_PROTOCOL
 /// Character string encoding protocol
@@ -113,6 +144,12 @@ struct EFI_ENCODING_PROTOCOL {
   // EncodeCharacter
   /// Encode a character into an encoded character string
   EFI_ENCODING_ENCODE_CHAR    EncodeCharacter;
+  // Validate
+  /// Validate and count the well formed characters of an encoded character string or NULL if the encoding has no fast validation
+  EFI_ENCODING_VALIDATE       Validate;
+  // DecodeValidated
+  /// Decode a character from an encoded character string that was validated without checking the character units or NULL if the encoding has no unchecked decoding
+  EFI_ENCODING_DECODE_CHAR    DecodeValidated;
 
 };
 
@@ -349,6 +386,24 @@ EfiEncodingStringSize (
   IN  CONST VOID            *Buffer,
   OUT UINTN                 *Size
 );
+// EfiEncodingDetect
+/// Detect the encoding of an encoded character string buffer by sampling its content
+/// @param Buffer     The encoded character string buffer
+/// @param Size       The size in bytes of the encoded character string buffer
+/// @param Encoding   On output, the detected encoding protocol interface
+/// @param Confidence On output, the confidence in the detected encoding from EFI_ENCODING_CONFIDENCE_LOW to EFI_ENCODING_CONFIDENCE_CERTAIN
+/// @retval EFI_INVALID_PARAMETER If Buffer or Encoding is NULL or Size is zero
+/// @retval EFI_NOT_FOUND         If the detected encoding is not installed
+/// @retval EFI_SUCCESS           If the encoding was detected
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiEncodingDetect (
+  IN  CONST VOID             *Buffer,
+  IN  UINTN                   Size,
+  OUT EFI_ENCODING_PROTOCOL **Encoding,
+  OUT UINTN                  *Confidence OPTIONAL
+);
 
 // EfiEncodingConvert
 /// Convert an encoded string to another encoding
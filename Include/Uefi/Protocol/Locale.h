@@ -51,6 +51,9 @@ typedef struct EFI_LOCALE_PROTOCOL EFI_LOCALE_PROTOCOL;
 // EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION
 /// The default print precision for floating point values
 #define EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION 6
+// EFI_LOCALE_PRINT_FLOAT_SHORTEST_PRECISION
+/// The default maximum print precision for floating point values printed with the fewest digits, which is unlimited so the digits always convert back
+#define EFI_LOCALE_PRINT_FLOAT_SHORTEST_PRECISION MAX_UINTN
 
 // EFI_LOCALE_PRINT_FLAG_UPPERCASE
 /// Print uppercase characters instead of lowercase if possible
@@ -64,6 +67,9 @@ typedef struct EFI_LOCALE_PROTOCOL EFI_LOCALE_PROTOCOL;
 // EFI_LOCALE_PRINT_FLAG_PREFIX_SIGN
 /// Prefix the positive or negative sign if possible
 #define EFI_LOCALE_PRINT_FLAG_PREFIX_SIGN EFI_BIT(3)
+// EFI_LOCALE_PRINT_FLAG_SHORTEST
+/// Print the fewest fractional digits that convert back to the same floating point, if more are needed than the precision then round to the precision and remove the trailing zeroes
+#define EFI_LOCALE_PRINT_FLAG_SHORTEST EFI_BIT(4)
 
 // EFI_LOCALE_COMPARE
 /// Compare two encoded character strings
@@ -1137,6 +1143,19 @@ EfiDefaultLocale (
   VOID
 );
 
+// EfiLocalePrintBenchmark
+/// Log the time to print integers and floating points with the current locale in the UTF-16, UTF-8 and UTF-16 byte swapped encodings
+/// @param Count The count of values to print for each measurement
+/// @retval EFI_INVALID_PARAMETER If Count is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined or there is no current locale
+/// @retval EFI_SUCCESS           The benchmark was logged
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLocalePrintBenchmark (
+  IN UINTN Count
+);
+
 #if defined(__cplusplus)
 }
 #endif // __cplusplus
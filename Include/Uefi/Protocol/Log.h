@@ -38,6 +38,110 @@ extern "C" {
 # define EFI_LOG_OUTPUT_ALL (EFI_LOG_OUTPUT_CONSOLE | EFI_LOG_OUTPUT_FILE | EFI_LOG_OUTPUT_SERIAL)
 #endif
 
+// EFI_LOG_FLUSH_FULL
+/// Only flush the log file write behind buffer when it is full, the log file is closed, or boot services are exited
+#define EFI_LOG_FLUSH_FULL 0
+// EFI_LOG_FLUSH_TIMER
+/// Also flush the log file write behind buffer periodically
+#define EFI_LOG_FLUSH_TIMER EFI_BIT(0)
+// EFI_LOG_FLUSH_ERROR
+/// Also flush the log file write behind buffer after a message with an error status code argument
+#define EFI_LOG_FLUSH_ERROR EFI_BIT(1)
+
+// EFI_LOG_BINARY_SIGNATURE
+/// The binary log session signature, "CLBINLOG"
+#define EFI_LOG_BINARY_SIGNATURE 0x474F4C4E49424C43
+// EFI_LOG_BINARY_VERSION
+/// The binary log format version
+#define EFI_LOG_BINARY_VERSION 1
+// EFI_LOG_BINARY_TYPE_SESSION
+/// A binary log record that starts a session, format identifiers are only valid within a session
+#define EFI_LOG_BINARY_TYPE_SESSION 1
+// EFI_LOG_BINARY_TYPE_FORMAT
+/// A binary log record that defines a format specifier string before the first message that uses it
+#define EFI_LOG_BINARY_TYPE_FORMAT 2
+// EFI_LOG_BINARY_TYPE_MESSAGE
+/// A binary log record of a message with its raw arguments
+#define EFI_LOG_BINARY_TYPE_MESSAGE 3
+
+// EFI_LOG_BINARY_HEADER
+/// The header of every binary log record, records are little endian and their sizes are aligned to eight bytes
+typedef struct EFI_LOG_BINARY_HEADER EFI_LOG_BINARY_HEADER;
+struct EFI_LOG_BINARY_HEADER {
+
+  // Size
+  /// The aligned size in bytes of the record including the header
+  UINT32 Size;
+  // Type
+  /// The type of the record
+  UINT32 Type;
+
+};
+// EFI_LOG_BINARY_SESSION
+/// A binary log session record
+typedef struct EFI_LOG_BINARY_SESSION EFI_LOG_BINARY_SESSION;
+struct EFI_LOG_BINARY_SESSION {
+
+  // Header
+  /// The record header
+  EFI_LOG_BINARY_HEADER Header;
+  // Signature
+  /// The binary log signature, EFI_LOG_BINARY_SIGNATURE
+  UINT64                Signature;
+  // Version
+  /// The binary log format version, EFI_LOG_BINARY_VERSION
+  UINT32                Version;
+  // PointerSize
+  /// The size in bytes of pointer and native integer arguments
+  UINT32                PointerSize;
+  // Frequency
+  /// The count of time stamp ticks per second or zero if unknown
+  UINT64                Frequency;
+
+};
+// EFI_LOG_BINARY_FORMAT
+/// A binary log format record, followed by the null terminated UTF-16 format specifier string
+typedef struct EFI_LOG_BINARY_FORMAT EFI_LOG_BINARY_FORMAT;
+struct EFI_LOG_BINARY_FORMAT {
+
+  // Header
+  /// The record header
+  EFI_LOG_BINARY_HEADER Header;
+  // Id
+  /// The identifier of the format specifier string within the session
+  UINT32                Id;
+  // Length
+  /// The count of characters of the format specifier string including the null terminator
+  UINT32                Length;
+
+};
+// EFI_LOG_BINARY_MESSAGE
+/// A binary log message record, followed by the aligned raw arguments then the copied argument data,
+///  pointer arguments to strings, GUIDs and times are replaced by the offset in bytes of the copied data from the start of the record or zero for NULL
+typedef struct EFI_LOG_BINARY_MESSAGE EFI_LOG_BINARY_MESSAGE;
+struct EFI_LOG_BINARY_MESSAGE {
+
+  // Header
+  /// The record header
+  EFI_LOG_BINARY_HEADER Header;
+  // TimeStamp
+  /// The time stamp of when the message was logged
+  UINT64                TimeStamp;
+  // Processor
+  /// The number of the processor that logged the message
+  UINT32                Processor;
+  // Format
+  /// The identifier of the format specifier string
+  UINT32                Format;
+  // ArgumentSize
+  /// The size in bytes of the raw arguments
+  UINT32                ArgumentSize;
+  // Reserved
+  /// Reserved, zero
+  UINT32                Reserved;
+
+};
+
 // EFI_LOG_VERBOSITY_NONE
 /// Normal logging
 #define EFI_LOG_VERBOSITY_NONE 0
@@ -193,6 +297,85 @@ BOOLEAN
   IN EFI_LOG_PROTOCOL *This,
   IN UINT32            Verbosity
 );
+// EFI_LOG_DRAIN
+/// Output the messages staged by application processors or interrupted log writes, must be called from the boot strap processor
+/// @param This The logging protocol interface
+/// @retval EFI_NOT_READY The log is already being written by an interrupted caller
+/// @retval EFI_SUCCESS   The staged messages were output
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_LOG_DRAIN) (
+  IN EFI_LOG_PROTOCOL *This
+);
+// EFI_LOG_SET_FILE_BUFFERING
+/// Set the log file write behind buffer size and flush policy, must be called from the boot strap processor
+/// @param This        The logging protocol interface
+/// @param Size        The size in bytes of the write behind buffer or zero to write and flush the log file for every message
+/// @param Policy      The flush policy
+/// @param FlushPeriod The period in milliseconds of the flush timer if the policy includes EFI_LOG_FLUSH_TIMER
+/// @retval EFI_INVALID_PARAMETER The policy includes EFI_LOG_FLUSH_TIMER and FlushPeriod is zero
+/// @retval EFI_NOT_READY         The log is being written by an interrupted caller
+/// @retval EFI_UNSUPPORTED       The buffer can not be persisted before exiting boot services so the log file is written for every message
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated so the log file is written for every message
+/// @retval EFI_SUCCESS           The log file buffering was set
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_LOG_SET_FILE_BUFFERING) (
+  IN EFI_LOG_PROTOCOL *This,
+  IN UINTN             Size,
+  IN UINT32            Policy,
+  IN UINTN             FlushPeriod
+);
+// EFI_LOG_GET_SPANS
+/// Get the log contents as up to two spans without copying or rearranging the log, the spans are not null terminated
+/// @param This         The logging protocol interface
+/// @param First        On output, the oldest part of the log contents, not including the byte order mark
+/// @param FirstLength  On output, the count of characters of the first span
+/// @param Second       On output, the newest part of the log contents if the log ring wrapped, otherwise NULL
+/// @param SecondLength On output, the count of characters of the second span
+/// @retval EFI_INVALID_PARAMETER If First, FirstLength, Second, or SecondLength is NULL
+/// @retval EFI_NOT_FOUND         The log is empty
+/// @retval EFI_SUCCESS           The log spans were returned
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_LOG_GET_SPANS) (
+  IN  EFI_LOG_PROTOCOL  *This,
+  OUT CONST CHAR16     **First,
+  OUT UINTN             *FirstLength,
+  OUT CONST CHAR16     **Second,
+  OUT UINTN             *SecondLength
+);
+// EFI_LOG_SET_CAPACITY
+/// Set the capacity of the log, keeping the newest contents that fit, must be called from the boot strap processor
+/// @param This     The logging protocol interface
+/// @param Capacity The capacity in bytes of the log ring, the oldest contents are overwritten when it is full, or zero for the log to grow without bound
+/// @retval EFI_NOT_READY        The log is being written by an interrupted caller
+/// @retval EFI_OUT_OF_RESOURCES The log could not be reallocated so the capacity was not changed
+/// @retval EFI_SUCCESS          The log capacity was set
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_LOG_SET_CAPACITY) (
+  IN EFI_LOG_PROTOCOL *This,
+  IN UINTN             Capacity
+);
+
+// EFI_LOG_SET_BINARY
+/// Set whether messages are recorded in the binary log format and formatted only when read or output to a text output, must be called from the boot strap processor
+/// @param This   The logging protocol interface
+/// @param Binary Whether to record messages in the binary log format, the log file is written in the binary log format while enabled
+/// @retval EFI_NOT_READY The log is being written by an interrupted caller
+/// @retval EFI_SUCCESS   The binary log format was enabled or disabled
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_LOG_SET_BINARY) (
+  IN EFI_LOG_PROTOCOL *This,
+  IN BOOLEAN           Binary
+);
 
 // EFI_LOG_PROTOCOL
 /// Logging protocol
@@ -228,6 +411,21 @@ struct EFI_LOG_PROTOCOL {
   // SetVerbosity
   /// Set the log verbosity level
   EFI_LOG_SET_VERBOSITY SetVerbosity;
+  // Drain
+  /// Output the messages staged by application processors or interrupted log writes
+  EFI_LOG_DRAIN         Drain;
+  // SetFileBuffering
+  /// Set the log file write behind buffer size and flush policy
+  EFI_LOG_SET_FILE_BUFFERING SetFileBuffering;
+  // GetSpans
+  /// Get the log contents as up to two spans
+  EFI_LOG_GET_SPANS     GetSpans;
+  // SetCapacity
+  /// Set the capacity of the log
+  EFI_LOG_SET_CAPACITY  SetCapacity;
+  // SetBinary
+  /// Set whether messages are recorded in the binary log format
+  EFI_LOG_SET_BINARY    SetBinary;
 
 };
 
@@ -285,6 +483,18 @@ EfiVVerbose (
   VA_LIST       Marker
 );
 
+// EfiLogDrain
+/// Output the messages staged by application processors or interrupted log writes, must be called from the boot strap processor
+/// @retval EFI_NOT_FOUND The logging protocol was not found
+/// @retval EFI_NOT_READY The log is already being written by an interrupted caller
+/// @retval EFI_SUCCESS   The staged messages were output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogDrain (
+  VOID
+);
+
 // EfiLogGetContents
 /// Get the log contents
 /// @return The log contents
@@ -294,6 +504,24 @@ EFIAPI
 EfiLogGetContents (
   VOID
 );
+// EfiLogGetSpans
+/// Get the log contents as up to two spans without copying or rearranging the log, the spans are not null terminated
+/// @param First        On output, the oldest part of the log contents, not including the byte order mark
+/// @param FirstLength  On output, the count of characters of the first span
+/// @param Second       On output, the newest part of the log contents if the log ring wrapped, otherwise NULL
+/// @param SecondLength On output, the count of characters of the second span
+/// @retval EFI_INVALID_PARAMETER If First, FirstLength, Second, or SecondLength is NULL
+/// @retval EFI_NOT_FOUND         The logging protocol was not found or the log is empty
+/// @retval EFI_SUCCESS           The log spans were returned
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogGetSpans (
+  OUT CONST CHAR16 **First,
+  OUT UINTN         *FirstLength,
+  OUT CONST CHAR16 **Second,
+  OUT UINTN         *SecondLength
+);
 
 // EfiLogClear
 /// Clear the log contents
@@ -352,6 +580,76 @@ EFIAPI
 EfiLogSetFile (
   CONST CHAR16 *LogPath
 );
+// EfiLogSetFileBuffering
+/// Set the log file write behind buffer size and flush policy
+/// @param Size        The size in bytes of the write behind buffer or zero to write and flush the log file for every message
+/// @param Policy      The flush policy
+/// @param FlushPeriod The period in milliseconds of the flush timer if the policy includes EFI_LOG_FLUSH_TIMER
+/// @retval EFI_NOT_FOUND         The logging protocol was not found
+/// @retval EFI_INVALID_PARAMETER The policy includes EFI_LOG_FLUSH_TIMER and FlushPeriod is zero
+/// @retval EFI_UNSUPPORTED       The buffer can not be persisted before exiting boot services so the log file is written for every message
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated so the log file is written for every message
+/// @retval EFI_SUCCESS           The log file buffering was set
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetFileBuffering (
+  IN UINTN  Size,
+  IN UINT32 Policy,
+  IN UINTN  FlushPeriod
+);
+// EfiLogSetDefaultFileBuffering
+/// Set the log file write behind buffer size and flush policy from the configuration
+/// @return The status of setting the log file buffering
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultFileBuffering (
+  VOID
+);
+// EfiLogSetCapacity
+/// Set the capacity of the log, keeping the newest contents that fit
+/// @param Capacity The capacity in bytes of the log ring, the oldest contents are overwritten when it is full, or zero for the log to grow without bound
+/// @retval EFI_NOT_FOUND        The logging protocol was not found
+/// @retval EFI_NOT_READY        The log is being written by an interrupted caller
+/// @retval EFI_OUT_OF_RESOURCES The log could not be reallocated so the capacity was not changed
+/// @retval EFI_SUCCESS          The log capacity was set
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetCapacity (
+  IN UINTN Capacity
+);
+// EfiLogSetDefaultCapacity
+/// Set the capacity of the log from the configuration
+/// @return The status of setting the log capacity
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultCapacity (
+  VOID
+);
+// EfiLogSetBinary
+/// Set whether messages are recorded in the binary log format and formatted only when read or output to a text output
+/// @param Binary Whether to record messages in the binary log format, the log file is written in the binary log format while enabled
+/// @retval EFI_NOT_FOUND The logging protocol was not found
+/// @retval EFI_NOT_READY The log is being written by an interrupted caller
+/// @retval EFI_SUCCESS   The binary log format was enabled or disabled
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetBinary (
+  IN BOOLEAN Binary
+);
+// EfiLogSetDefaultBinary
+/// Set whether messages are recorded in the binary log format from the configuration
+/// @return The status of setting the binary log format
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultBinary (
+  VOID
+);
 
 // EfiLogGetVerbosity
 /// Get the current log verbosity level
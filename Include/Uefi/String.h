@@ -30,6 +30,10 @@ extern "C" {
 /// Compare strings case insensitively when searching for strings
 #define STR_SEARCH_CASE_INSENSITIVE EFI_BIT(4)
 
+// EFI_GLOB
+/// A compiled case-insensitive glob pattern
+typedef struct EFI_GLOB EFI_GLOB;
+
 // IsUnicodeCharacter
 /// Check if character is valid unicode code point
 /// @param Character The character to check is valid
@@ -185,6 +189,52 @@ MetaiMatch (
   IN CONST CHAR16 *String,
   IN CONST CHAR16 *Pattern
 );
+// StrGlobCompile
+/// Compile a case-insensitive glob pattern for repeated matching
+/// @param Pattern The glob pattern, which may contain * to match zero or more characters, ? to match any one character
+///                 and [...] to match one character from a set of characters and ranges of characters
+/// @param Glob    On output, the compiled glob pattern, which must be freed with EfiGlobFree
+/// @retval EFI_INVALID_PARAMETER If Pattern or Glob is NULL or *Glob is not NULL
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the compiled pattern
+/// @retval EFI_SUCCESS           If the pattern was compiled
+EXTERN
+EFI_STATUS
+EFIAPI
+StrGlobCompile (
+  IN  CONST CHAR16  *Pattern,
+  OUT EFI_GLOB     **Glob
+);
+// StrGlobMatch
+/// Performs a case-insensitive comparison of a compiled glob pattern and a string
+/// @param Glob   The compiled glob pattern
+/// @param String The string to match
+/// @retval TRUE  String matches the pattern
+/// @retval FALSE String does not match the pattern or Glob or String is NULL
+EXTERN
+BOOLEAN
+EFIAPI
+StrGlobMatch (
+  IN CONST EFI_GLOB *Glob,
+  IN CONST CHAR16   *String
+);
+// EfiGlobFree
+/// Free a compiled glob pattern
+/// @param Glob The compiled glob pattern to free
+EXTERN
+VOID
+EFIAPI
+EfiGlobFree (
+  IN EFI_GLOB *Glob
+);
+// EfiGlobCacheFree
+/// Free the compiled glob patterns cached by MetaiMatch and AsciiMetaiMatch
+EXTERN
+VOID
+EFIAPI
+EfiGlobCacheFree (
+  VOID
+);
 
 // StrLwr
 /// Converts all the characters in a string to lower case characters
@@ -225,6 +275,26 @@ EFIAPI
 StrToUpper (
   IN CONST CHAR16 *Str
 );
+// CharToLower
+/// Converts a character to a lower case character with the basic multilingual plane case mapping, which does not depend on the language
+/// @param Character The character to convert
+/// @return The lower case character
+EXTERN
+CHAR16
+EFIAPI
+CharToLower (
+  IN CHAR16 Character
+);
+// CharToUpper
+/// Converts a character to an upper case character with the basic multilingual plane case mapping, which does not depend on the language
+/// @param Character The character to convert
+/// @return The upper case character
+EXTERN
+CHAR16
+EFIAPI
+CharToUpper (
+  IN CHAR16 Character
+);
 
 // StrStr
 /// Returns the first occurrence of a sub-string in a string
@@ -602,6 +672,35 @@ AsciiMetaiMatch (
   IN CONST CHAR8 *String,
   IN CONST CHAR8 *Pattern
 );
+// AsciiGlobCompile
+/// Compile a case-insensitive glob pattern for repeated matching
+/// @param Pattern The glob pattern, which may contain * to match zero or more characters, ? to match any one character
+///                 and [...] to match one character from a set of characters and ranges of characters
+/// @param Glob    On output, the compiled glob pattern, which must be freed with EfiGlobFree
+/// @retval EFI_INVALID_PARAMETER If Pattern or Glob is NULL or *Glob is not NULL
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the compiled pattern
+/// @retval EFI_SUCCESS           If the pattern was compiled
+EXTERN
+EFI_STATUS
+EFIAPI
+AsciiGlobCompile (
+  IN  CONST CHAR8  *Pattern,
+  OUT EFI_GLOB    **Glob
+);
+// AsciiGlobMatch
+/// Performs a case-insensitive comparison of a compiled glob pattern and a string
+/// @param Glob   The compiled glob pattern
+/// @param String The string to match
+/// @retval TRUE  String matches the pattern
+/// @retval FALSE String does not match the pattern or Glob or String is NULL
+EXTERN
+BOOLEAN
+EFIAPI
+AsciiGlobMatch (
+  IN CONST EFI_GLOB *Glob,
+  IN CONST CHAR8    *String
+);
 
 // AsciiLwr
 /// Converts all the characters in a string to lower case characters
@@ -0,0 +1,240 @@
+///
+/// @file Include/Uefi/StringBuilder.h
+///
+/// UEFI growable encoded character string builder
+///
+
+#pragma once
+#ifndef __UEFI_STRING_BUILDER_HEADER__
+#define __UEFI_STRING_BUILDER_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_STRING_BUILDER_DEFAULT_CAPACITY
+/// The default capacity in bytes of a string builder when no capacity is given
+#define EFI_STRING_BUILDER_DEFAULT_CAPACITY 256
+// EFI_STRING_ARENA_DEFAULT_CHUNK_SIZE
+/// The default size in bytes of a string arena chunk when no chunk size is given
+#define EFI_STRING_ARENA_DEFAULT_CHUNK_SIZE 4096
+
+// EFI_STRING_ARENA
+/// A string arena that hands out buffers from large chunks and frees them all at once
+typedef struct EFI_STRING_ARENA EFI_STRING_ARENA;
+
+// EFI_STRING_BUILDER
+/// A growable encoded character string, the string is always null terminated
+typedef struct EFI_STRING_BUILDER EFI_STRING_BUILDER;
+struct EFI_STRING_BUILDER {
+
+  // Encoding
+  /// The encoding of the string
+  EFI_ENCODING_PROTOCOL *Encoding;
+  // Arena
+  /// The arena that backs the string buffer or NULL if the buffer is allocated from pool
+  EFI_STRING_ARENA      *Arena;
+  // Buffer
+  /// The string buffer or NULL if nothing has been appended
+  VOID                  *Buffer;
+  // Size
+  /// The size in bytes of the string, not including the null terminator
+  UINTN                  Size;
+  // Capacity
+  /// The allocated size in bytes of the string buffer
+  UINTN                  Capacity;
+
+};
+
+// EfiStringArenaCreate
+/// Create a string arena
+/// @param Arena     On output, the created string arena, which must be freed with EfiStringArenaFree
+/// @param ChunkSize The size in bytes of each chunk allocated by the arena or zero for the default size
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL or *Arena is not NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the arena
+/// @retval EFI_SUCCESS           If the arena was created successfully
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringArenaCreate (
+  OUT EFI_STRING_ARENA **Arena,
+  IN  UINTN              ChunkSize
+);
+// EfiStringArenaAllocate
+/// Allocate a buffer from a string arena
+/// @param Arena The string arena
+/// @param Size  The size in bytes to allocate
+/// @return The allocated buffer, which is freed with the arena, or NULL if memory could not be allocated
+EXTERN
+VOID *
+EFIAPI
+EfiStringArenaAllocate (
+  IN EFI_STRING_ARENA *Arena,
+  IN UINTN             Size
+);
+// EfiStringArenaReset
+/// Release every buffer allocated from a string arena but keep the first chunk for reuse
+/// @param Arena The string arena
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL
+/// @retval EFI_SUCCESS           If the arena was reset
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringArenaReset (
+  IN EFI_STRING_ARENA *Arena
+);
+// EfiStringArenaFree
+/// Free a string arena and every buffer allocated from it
+/// @param Arena The string arena
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL
+/// @retval EFI_SUCCESS           If the arena was freed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringArenaFree (
+  IN EFI_STRING_ARENA *Arena
+);
+
+// EfiStringBuilderInitialize
+/// Initialize a string builder
+/// @param Builder  The string builder to initialize
+/// @param Encoding The encoding of the string or NULL for UTF-16
+/// @param Arena    The arena from which to allocate the string buffer or NULL to allocate from pool
+/// @param Capacity The initial capacity in bytes of the string buffer or zero to allocate on first append
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the string builder was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderInitialize (
+  OUT EFI_STRING_BUILDER    *Builder,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_STRING_ARENA      *Arena OPTIONAL,
+  IN  UINTN                  Capacity
+);
+// EfiStringBuilderReserve
+/// Make sure a string builder can append bytes without growing again
+/// @param Builder The string builder
+/// @param Size    The size in bytes that must be able to be appended, not including the null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the string buffer has room for the bytes
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderReserve (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     UINTN               Size
+);
+// EfiStringBuilderAppendSpan
+/// Append already encoded characters to a string builder
+/// @param Builder The string builder
+/// @param Span    The encoded characters to append, which must be in the encoding of the string builder
+/// @param Size    The size in bytes of the encoded characters, not including any null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Span is NULL and Size is not zero
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the characters were appended
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendSpan (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     CONST VOID         *Span OPTIONAL,
+  IN     UINTN               Size
+);
+// EfiStringBuilderAppendCharacter
+/// Append a character to a string builder
+/// @param Builder   The string builder
+/// @param Character The Unicode character to append
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the string builder
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the character was appended
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendCharacter (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     UINT32              Character
+);
+// EfiStringBuilderAppendFormatted
+/// Append a formatted character string to a string builder
+/// @param Builder        The string builder
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param ...            The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the formatted character string was appended
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendFormatted (
+  IN OUT EFI_STRING_BUILDER    *Builder,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  ...
+);
+// EfiStringBuilderVAppendFormatted
+/// Append a formatted character string to a string builder
+/// @param Builder        The string builder
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param Marker         The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the formatted character string was appended
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderVAppendFormatted (
+  IN OUT EFI_STRING_BUILDER    *Builder,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  IN     VA_LIST                Marker
+);
+// EfiStringBuilderSteal
+/// Take the string buffer from a string builder, shrinking it to fit the string, the string builder is left empty but still initialized
+/// @param Builder The string builder
+/// @param Buffer  On output, the null terminated string, which must be freed with EfiFreePool unless the string builder has an arena
+/// @param Size    On output, the size in bytes of the string, including the null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder or Buffer is NULL or Builder is not initialized
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for an empty string
+/// @retval EFI_SUCCESS           If the string buffer was returned
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderSteal (
+  IN OUT EFI_STRING_BUILDER  *Builder,
+  OUT    VOID               **Buffer,
+  OUT    UINTN               *Size OPTIONAL
+);
+// EfiStringBuilderFree
+/// Free the string buffer of a string builder, the string builder is left empty but still initialized
+/// @param Builder The string builder
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL
+/// @retval EFI_SUCCESS           If the string buffer was freed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiStringBuilderFree (
+  IN OUT EFI_STRING_BUILDER *Builder
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_STRING_BUILDER_HEADER__
@@ -0,0 +1,280 @@
+///
+/// @file Include/Uefi/Writer.h
+///
+/// UEFI buffered encoded character stream writer
+///
+
+#pragma once
+#ifndef __UEFI_WRITER_HEADER__
+#define __UEFI_WRITER_HEADER__
+
+#include <Uefi.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // __cplusplus
+
+// EFI_WRITER_BUFFER_SIZE
+/// The size in bytes of the buffer of a writer, which is all the memory a writer uses no matter how much is written
+#define EFI_WRITER_BUFFER_SIZE 4096
+
+// EFI_WRITER_OUTPUT
+/// Output the buffered bytes of a writer
+/// @param Context The context passed when the writer was initialized
+/// @param Buffer  The encoded bytes to output
+/// @param Size    The size in bytes of the encoded bytes
+/// @retval EFI_SUCCESS If the bytes were output, any other status stops the writer
+typedef
+EFI_STATUS
+(EFIAPI
+*EFI_WRITER_OUTPUT) (
+  IN VOID       *Context,
+  IN CONST VOID *Buffer,
+  IN UINTN       Size
+);
+
+// EFI_WRITER
+/// A writer that encodes characters into a fixed buffer and outputs the buffer each time it fills
+typedef struct EFI_WRITER EFI_WRITER;
+struct EFI_WRITER {
+
+  // Encoding
+  /// The encoding of the output
+  EFI_ENCODING_PROTOCOL *Encoding;
+  // Output
+  /// The output callback
+  EFI_WRITER_OUTPUT      Output;
+  // Context
+  /// The context of the output callback
+  VOID                  *Context;
+  // Root
+  /// The root file protocol interface of a file writer or NULL
+  EFI_FILE_PROTOCOL     *Root;
+  // Path
+  /// The path of the file of a file writer relative to the root or NULL if the root is the file
+  CONST CHAR16          *Path;
+  // File
+  /// The temporary file opened by a file writer or NULL if nothing has been output yet
+  EFI_FILE_PROTOCOL     *File;
+  // Temporary
+  /// The path of the temporary file of a file writer relative to the root, which replaces the file when the writer is closed, or NULL
+  CHAR16                *Temporary;
+  // Total
+  /// The size in bytes that has been output
+  UINT64                 Total;
+  // Size
+  /// The size in bytes of the buffered bytes that have not been output
+  UINTN                  Size;
+  // Buffer
+  /// The buffered bytes that have not been output
+  UINT8                  Buffer[EFI_WRITER_BUFFER_SIZE];
+
+};
+
+// EfiWriterInitialize
+/// Initialize a writer with an output callback
+/// @param Writer   The writer to initialize
+/// @param Encoding The encoding of the output or NULL for UTF-16
+/// @param Output   The output callback
+/// @param Context  The context of the output callback
+/// @retval EFI_INVALID_PARAMETER If Writer or Output is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_SUCCESS           If the writer was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterInitialize (
+  OUT EFI_WRITER            *Writer,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_WRITER_OUTPUT      Output,
+  IN  VOID                  *Context OPTIONAL
+);
+// EfiWriterInitializeBuilder
+/// Initialize a writer that appends its output to a string builder
+/// @param Writer  The writer to initialize
+/// @param Builder The initialized string builder, the output is in the encoding of the string builder
+/// @retval EFI_INVALID_PARAMETER If Writer or Builder is NULL or Builder is not initialized
+/// @retval EFI_SUCCESS           If the writer was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterInitializeBuilder (
+  OUT EFI_WRITER         *Writer,
+  IN  EFI_STRING_BUILDER *Builder
+);
+// EfiWriterInitializeFile
+/// Initialize a writer that writes its output to a temporary file next to a file, which replaces the file only when the writer is closed without error so a failed write never changes the file
+/// @param Writer   The writer to initialize, which must be closed with EfiWriterClose
+/// @param Encoding The encoding of the output or NULL for UTF-16
+/// @param Root     The root file protocol interface
+/// @param Path     The path of the file relative to the root, which must remain valid until the writer is closed, or NULL if Root is already the file
+/// @retval EFI_INVALID_PARAMETER If Writer or Root is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_SUCCESS           If the writer was initialized
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterInitializeFile (
+  OUT EFI_WRITER            *Writer,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_FILE_PROTOCOL     *Root,
+  IN  CONST CHAR16          *Path OPTIONAL
+);
+
+// EfiWriterWriteSpan
+/// Write already encoded characters
+/// @param Writer The writer
+/// @param Span   The encoded characters to write, which must be in the encoding of the writer
+/// @param Size   The size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Span is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the characters were written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteSpan (
+  IN OUT EFI_WRITER *Writer,
+  IN     CONST VOID *Span OPTIONAL,
+  IN     UINTN       Size
+);
+// EfiWriterWriteCharacter
+/// Write a character
+/// @param Writer    The writer
+/// @param Character The Unicode character to write
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the writer, nothing was written
+/// @retval EFI_SUCCESS           If the character was written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteCharacter (
+  IN OUT EFI_WRITER *Writer,
+  IN     UINT32      Character
+);
+// EfiWriterWriteFill
+/// Write a character repeatedly
+/// @param Writer    The writer
+/// @param Character The Unicode character to write
+/// @param Count     The count of times to write the character
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the writer, nothing was written
+/// @retval EFI_SUCCESS           If the characters were written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteFill (
+  IN OUT EFI_WRITER *Writer,
+  IN     UINT32      Character,
+  IN     UINTN       Count
+);
+// EfiWriterWriteString
+/// Write a string transcoded to the encoding of the writer
+/// @param Writer The writer
+/// @param String The string to write, unpaired surrogates are written as the replacement character
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_NO_MAPPING        If a character can not be encoded with the encoding of the writer, the characters before it were written
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteString (
+  IN OUT EFI_WRITER   *Writer,
+  IN     CONST CHAR16 *String OPTIONAL
+);
+// EfiWriterWriteAscii
+/// Write a string transcoded to the encoding of the writer
+/// @param Writer The writer
+/// @param String The string to write
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_NO_MAPPING        If a character can not be encoded with the encoding of the writer, the characters before it were written
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteAscii (
+  IN OUT EFI_WRITER  *Writer,
+  IN     CONST CHAR8 *String OPTIONAL
+);
+// EfiWriterWriteFormatted
+/// Write a formatted character string
+/// @param Writer         The writer
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param ...            The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or FormatEncoding or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the formatted string was larger than the buffer and memory could not be allocated for it
+/// @retval EFI_SUCCESS           If the formatted character string was written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterWriteFormatted (
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  ...
+);
+// EfiWriterVWriteFormatted
+/// Write a formatted character string
+/// @param Writer         The writer
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param Marker         The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or FormatEncoding or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the formatted string was larger than the buffer and memory could not be allocated for it
+/// @retval EFI_SUCCESS           If the formatted character string was written
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterVWriteFormatted (
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  IN     VA_LIST                Marker
+);
+
+// EfiWriterFlush
+/// Output the buffered bytes of a writer
+/// @param Writer The writer
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the buffered bytes were output
+/// @return Any other status returned by the output
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterFlush (
+  IN OUT EFI_WRITER *Writer
+);
+// EfiWriterClose
+/// Output the buffered bytes of a writer and close the file of a file writer, the writer must be initialized again before reuse
+/// @param Writer  The writer
+/// @param Discard Whether to discard the output, such as after an error, the temporary file of a file writer is deleted and the file is left unchanged
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the buffered bytes were output and the writer was closed
+/// @return Any other status returned by the output, the writer is still closed
+EXTERN
+EFI_STATUS
+EFIAPI
+EfiWriterClose (
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Discard
+);
+
+#if defined(__cplusplus)
+}
+#endif // __cplusplus
+
+#endif // __UEFI_WRITER_HEADER__
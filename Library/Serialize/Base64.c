@@ -4,51 +4,511 @@
 /// UEFI implementation Base64
 ///
 
-#include <Uefi.h>
+#include <Serialize/Base64.h>
 
-// mBase64Dictionaryionary
-/// Base 64 dictionary
-STATIC CHAR8 mBase64Dictionary[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// BASE64_CHUNK_SIZE
+/// The count of characters converted at a time through a stack buffer for encodings other than ASCII compatible ones
+#define BASE64_CHUNK_SIZE 256
 
-// IsBase64Character
-/// Check if character is Base64 character
-/// @param Character The character to check is Base64
-/// @retval TRUE  The character is Base64
-/// @retval FALSE The character is not Base64
+// BASE64_DECODER
+/// The base64 decoding output state
+typedef struct BASE64_DECODER BASE64_DECODER;
+struct BASE64_DECODER {
+
+  // Context
+  /// The base64 codec context that holds the partial block
+  BASE64_CONTEXT *Context;
+  // Output
+  /// The next byte of the output buffer or NULL if the decoded data is only counted
+  UINT8          *Output;
+  // Remaining
+  /// The size in bytes remaining in the output buffer
+  UINTN           Remaining;
+  // Size
+  /// The size in bytes of the decoded data, including any that did not fit in the output buffer
+  UINTN           Size;
+
+};
+
+// Base64DecoderPut
+/// Output the bytes of a decoded block
+/// @param Decoder The base64 decoding output state
+/// @param Block   The decoded block with the first byte in bits sixteen to twenty three
+/// @param Count   The count of bytes of the block to output
 STATIC
-BOOLEAN
+VOID
 EFIAPI
-IsBase64Character (
-  IN UINT32 Character
+Base64DecoderPut (
+  IN OUT BASE64_DECODER *Decoder,
+  IN     UINT32          Block,
+  IN     UINTN           Count
 ) {
-  return (((Character >= 'A') && (Character <= 'Z')) ||
-          ((Character >= 'a') && (Character <= 'z')) ||
-          ((Character >= '0') && (Character <= '9')) ||
-          (Character == '+') || (Character == '/') || (Character == '='));
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    // Only count the rest of the bytes once the output buffer is full
+    if (Decoder->Remaining == 0) {
+      Decoder->Output = NULL;
+    }
+    if (Decoder->Output != NULL) {
+      *(Decoder->Output)++ = (UINT8)(Block >> (16 - (8 * Index)));
+      --(Decoder->Remaining);
+    }
+    ++(Decoder->Size);
+  }
 }
-// FromBase64Character
-/// Get 6bit value from 8bit encoded character
+// Base64DecoderCharacter
+/// Decode a character
+/// @param Decoder   The base64 decoding output state
 /// @param Character The character to decode
-/// @return The decoded 6bit value
 STATIC
-UINT32
+VOID
+EFIAPI
+Base64DecoderCharacter (
+  IN OUT BASE64_DECODER *Decoder,
+  IN     UINT32          Character
+) {
+  BASE64_CONTEXT *Context = Decoder->Context;
+  UINT8           Value = (Character < ARRAY_COUNT(gEfiBase64DecodeTable)) ? gEfiBase64DecodeTable[Character] : EFI_BASE64_INVALID;
+  if (Context->Finished) {
+    return;
+  }
+  if (Value < 64) {
+    // Add the value to the block and output the block once complete
+    Context->Block = (Context->Block << 6) | Value;
+    if (++(Context->Count) == 4) {
+      Base64DecoderPut(Decoder, Context->Block, 3);
+      Context->Block = 0;
+      Context->Count = 0;
+    }
+  } else if ((Value == EFI_BASE64_PAD) || (Value == EFI_BASE64_END)) {
+    Context->Finished = TRUE;
+  } else if (Value != EFI_BASE64_SPACE) {
+    LOG(L"Unknown base64 character `%c` (0x%x)\n", Character, Character);
+    Context->Status = EFI_WARN_UNKNOWN_GLYPH;
+  }
+}
+// Base64DecoderAscii
+/// Decode ASCII characters, complete blocks are decoded in bulk
+/// @param Decoder The base64 decoding output state
+/// @param Input   The ASCII characters to decode
+/// @param Count   The count of characters
+STATIC
+VOID
+EFIAPI
+Base64DecoderAscii (
+  IN OUT BASE64_DECODER *Decoder,
+  IN     CONST CHAR8    *Input,
+  IN     UINTN           Count
+) {
+  BASE64_CONTEXT *Context = Decoder->Context;
+  UINTN           Index = 0;
+  UINTN           Run;
+  UINTN           Decoded;
+  while ((Index < Count) && !Context->Finished) {
+    // Decode the run of complete blocks that fit in the output buffer when not within a block
+    if ((Context->Count == 0) && (Decoder->Output != NULL)) {
+      Run = Count - Index;
+      if (Run > ((Decoder->Remaining / 3) * 4)) {
+        Run = (Decoder->Remaining / 3) * 4;
+      }
+      Decoded = EfiDispatch()->Base64Decode(Decoder->Output, Input + Index, Run);
+      Decoder->Output += (Decoded / 4) * 3;
+      Decoder->Remaining -= (Decoded / 4) * 3;
+      Decoder->Size += (Decoded / 4) * 3;
+      Index += Decoded;
+      if (Index >= Count) {
+        break;
+      }
+    }
+    // Decode the character that stopped the run, which may be white space, padding, or the start of a block that did not fit
+    Base64DecoderCharacter(Decoder, (UINT8)Input[Index++]);
+  }
+}
+// Base64DecoderInput
+/// Decode encoded characters
+/// @param Decoder   The base64 decoding output state
+/// @param Encoding  The input encoding protocol interface
+/// @param Input     The input encoded characters
+/// @param InputSize The size in bytes of the input encoded characters
+STATIC
+VOID
+EFIAPI
+Base64DecoderInput (
+  IN OUT BASE64_DECODER        *Decoder,
+  IN     EFI_ENCODING_PROTOCOL *Encoding,
+  IN     CONST VOID            *Input,
+  IN     UINTN                  InputSize
+) {
+  CHAR8         Chunk[BASE64_CHUNK_SIZE];
+  CONST CHAR16 *Utf16;
+  UINTN         Count;
+  UINTN         Index;
+  UINTN         ThisSize;
+  UINT32        Character;
+  if ((Encoding == EfiUtf8Encoding()) || (Encoding == EfiLatin1Encoding())) {
+    // Decode ASCII compatible characters directly
+    Base64DecoderAscii(Decoder, (CONST CHAR8 *)Input, InputSize);
+  } else if (Encoding == EfiUtf16Encoding()) {
+    // Narrow runs of UTF-16 ASCII characters into chunks to decode
+    Utf16 = (CONST CHAR16 *)Input;
+    Count = InputSize / sizeof(CHAR16);
+    Index = 0;
+    while ((Index < Count) && !Decoder->Context->Finished) {
+      ThisSize = ((Count - Index) < BASE64_CHUNK_SIZE) ? (Count - Index) : BASE64_CHUNK_SIZE;
+      ThisSize = EfiDispatch()->Utf16ToAscii(Chunk, Utf16 + Index, ThisSize);
+      Base64DecoderAscii(Decoder, Chunk, ThisSize);
+      Index += ThisSize;
+      // Decode the null terminator or character that is not ASCII that stopped narrowing
+      if ((ThisSize < BASE64_CHUNK_SIZE) && (Index < Count)) {
+        Base64DecoderCharacter(Decoder, Utf16[Index++]);
+      }
+    }
+  } else {
+    // Decode each character of other encodings
+    while (!Decoder->Context->Finished && (InputSize >= Encoding->UnitSize)) {
+      ThisSize = InputSize;
+      if (EFI_ERROR(EfiDecodeCharacter(Encoding, Input, &ThisSize, &Character))) {
+        break;
+      }
+      Input = ADDRESS_OFFSET(VOID, Input, ThisSize);
+      InputSize = (InputSize > ThisSize) ? (InputSize - ThisSize) : 0;
+      Base64DecoderCharacter(Decoder, Character);
+    }
+  }
+}
+// Base64DecoderFinish
+/// Output the partial last block
+/// @param Decoder The base64 decoding output state
+/// @retval EFI_ABORTED If the partial last block has too few characters to form a byte
+/// @retval EFI_SUCCESS If the partial last block was output
+STATIC
+EFI_STATUS
+EFIAPI
+Base64DecoderFinish (
+  IN OUT BASE64_DECODER *Decoder
+) {
+  BASE64_CONTEXT *Context = Decoder->Context;
+  if (Context->Count == 1) {
+    return EFI_ABORTED;
+  }
+  if (Context->Count == 2) {
+    Base64DecoderPut(Decoder, Context->Block << 12, 1);
+  } else if (Context->Count == 3) {
+    Base64DecoderPut(Decoder, Context->Block << 6, 2);
+  }
+  Context->Block = 0;
+  Context->Count = 0;
+  Context->Finished = TRUE;
+  return EFI_SUCCESS;
+}
+
+// Base64EncoderSpan
+/// Write base64 characters to the output buffer in an encoding, each base64 character is encoded as a single unit
+/// @param Encoding The output encoding protocol interface
+/// @param Output   On input, the output buffer, which must have room for every character, on output, the advanced output buffer
+/// @param Span     The base64 characters
+/// @param Count    The count of base64 characters
+/// @retval EFI_UNSUPPORTED If the encoding does not encode base64 characters as single units
+/// @retval EFI_SUCCESS     If the characters were written
+STATIC
+EFI_STATUS
+EFIAPI
+Base64EncoderSpan (
+  IN     EFI_ENCODING_PROTOCOL  *Encoding,
+  IN OUT UINT8                 **Output,
+  IN     CONST CHAR8            *Span,
+  IN     UINTN                   Count
+) {
+  UINTN Index;
+  UINTN ThisSize;
+  if ((Encoding == EfiUtf8Encoding()) || (Encoding == EfiLatin1Encoding())) {
+    EfiCopyMem(*Output, Span, Count);
+  } else if (Encoding == EfiUtf16Encoding()) {
+    EfiDispatch()->AsciiToUtf16((CHAR16 *)*Output, Span, Count);
+  } else {
+    for (Index = 0; Index < Count; ++Index) {
+      ThisSize = Encoding->UnitSize;
+      if (EFI_ERROR(EfiEncodeCharacter(Encoding, *Output + (Index * Encoding->UnitSize), &ThisSize, (UINT8)Span[Index])) ||
+          (ThisSize != Encoding->UnitSize)) {
+        return EFI_UNSUPPORTED;
+      }
+    }
+  }
+  *Output += Count * Encoding->UnitSize;
+  return EFI_SUCCESS;
+}
+// Base64EncoderBlock
+/// Encode a block of data to base64 characters with padding
+/// @param Span  On output, the four base64 characters
+/// @param Block The block with the first byte in bits sixteen to twenty three
+/// @param Count The count of bytes in the block
+STATIC
+VOID
+EFIAPI
+Base64EncoderBlock (
+  OUT CHAR8  *Span,
+  IN  UINT32  Block,
+  IN  UINTN   Count
+) {
+  Span[0] = gEfiBase64Dictionary[(Block >> 18) & 0x3F];
+  Span[1] = gEfiBase64Dictionary[(Block >> 12) & 0x3F];
+  Span[2] = (Count > 1) ? gEfiBase64Dictionary[(Block >> 6) & 0x3F] : '=';
+  Span[3] = (Count > 2) ? gEfiBase64Dictionary[Block & 0x3F] : '=';
+}
+
+// Base64DecodeInit
+/// Initialize a base64 codec context for incremental decoding
+/// @param Context The base64 codec context
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           The context was initialized
+EFI_STATUS
+EFIAPI
+Base64DecodeInit (
+  OUT BASE64_CONTEXT *Context
+) {
+  if (Context == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  EfiZeroMem(Context, sizeof(BASE64_CONTEXT));
+  Context->Status = EFI_SUCCESS;
+  return EFI_SUCCESS;
+}
+// Base64DecodeUpdate
+/// Decode the next chunk of encoded characters, a partial block is carried in the context to the next chunk
+/// @param Context    The base64 codec context
+/// @param Encoding   The input encoding protocol interface
+/// @param Input      The input encoded characters, which must be whole characters
+/// @param InputSize  The size in bytes of the input encoded characters
+/// @param Output     The data output buffer, which needs three bytes for every four characters including the partial block, and may overlap the input at or before the start of the input to decode in place
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the decoded data
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL or Input is NULL and InputSize is not zero
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer may not be large enough to hold the decoded data, nothing was decoded and *OutputSize is updated with the required size
+/// @retval EFI_WARN_UNKNOWN_GLYPH The characters were decoded but some characters were not base64 and were skipped
+/// @retval EFI_SUCCESS            The characters were decoded successfully
+EFI_STATUS
+EFIAPI
+Base64DecodeUpdate (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN     CONST VOID            *Input OPTIONAL,
+  IN     UINTN                  InputSize,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
+) {
+  BASE64_DECODER Decoder;
+  UINTN          Required;
+  // Set default encoding if needed
+  if (Encoding == NULL) {
+    Encoding = EfiDefaultEncoding();
+  }
+  // Check parameters
+  if ((Context == NULL) || (Encoding == NULL) || ((Input == NULL) && (InputSize != 0)) || (OutputSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Every character is at least one unit so the decoded size of the complete blocks is bounded up front
+  Required = Context->Finished ? 0 : (((Context->Count + (InputSize / Encoding->UnitSize)) / 4) * 3);
+  if (((Output == NULL) && (Required != 0)) || (*OutputSize < Required)) {
+    *OutputSize = Required;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  // Decode the characters
+  Decoder.Context = Context;
+  Decoder.Output = (UINT8 *)Output;
+  Decoder.Remaining = Required;
+  Decoder.Size = 0;
+  if (InputSize != 0) {
+    Base64DecoderInput(&Decoder, Encoding, Input, InputSize);
+  }
+  *OutputSize = Decoder.Size;
+  return Context->Status;
+}
+// Base64DecodeFinal
+/// Finish incremental decoding by decoding the partial last block
+/// @param Context    The base64 codec context
+/// @param Output     The data output buffer, which needs at most two bytes
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the decoded data
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the decoded data, *OutputSize is updated with the required size
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The data was decoded but some characters were not base64 and were skipped
+/// @retval EFI_SUCCESS            The data was decoded successfully
+EFI_STATUS
+EFIAPI
+Base64DecodeFinal (
+  IN OUT BASE64_CONTEXT *Context,
+  OUT    VOID           *Output OPTIONAL,
+  IN OUT UINTN          *OutputSize
+) {
+  EFI_STATUS     Status;
+  BASE64_DECODER Decoder;
+  UINTN          Required;
+  // Check parameters
+  if ((Context == NULL) || (OutputSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Two or three characters decode to one or two bytes
+  Required = (Context->Count > 1) ? (Context->Count - 1) : 0;
+  if (((Output == NULL) && (Required != 0)) || (*OutputSize < Required)) {
+    *OutputSize = Required;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  Decoder.Context = Context;
+  Decoder.Output = (UINT8 *)Output;
+  Decoder.Remaining = Required;
+  Decoder.Size = 0;
+  Status = Base64DecoderFinish(&Decoder);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  *OutputSize = Decoder.Size;
+  return Context->Status;
+}
+
+// Base64EncodeInit
+/// Initialize a base64 codec context for incremental encoding
+/// @param Context The base64 codec context
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           The context was initialized
+EFI_STATUS
+EFIAPI
+Base64EncodeInit (
+  OUT BASE64_CONTEXT *Context
+) {
+  return Base64DecodeInit(Context);
+}
+// Base64EncodeUpdate
+/// Encode the next chunk of data, a partial block is carried in the context to the next chunk
+/// @param Context    The base64 codec context
+/// @param Encoding   The output encoding protocol interface
+/// @param Input      The input data
+/// @param InputSize  The size in bytes of the input data
+/// @param Output     The base 64 encoded output buffer, which needs four units for every three bytes including the partial block and is not null terminated
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL or Input is NULL and InputSize is not zero
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the encoded characters, nothing was encoded and *OutputSize is updated with the required size
+/// @retval EFI_UNSUPPORTED        If the encoding does not encode base64 characters as single units
+/// @retval EFI_SUCCESS            The data was encoded successfully
+EFI_STATUS
+EFIAPI
+Base64EncodeUpdate (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN     CONST VOID            *Input OPTIONAL,
+  IN     UINTN                  InputSize,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
+) {
+  EFI_STATUS   Status;
+  CHAR8        Chunk[BASE64_CHUNK_SIZE];
+  CONST UINT8 *Buffer = (CONST UINT8 *)Input;
+  UINT8       *Next = (UINT8 *)Output;
+  UINTN        Required;
+  UINTN        Index = 0;
+  UINTN        ThisSize;
+  // Set default encoding if needed
+  if (Encoding == NULL) {
+    Encoding = EfiDefaultEncoding();
+  }
+  // Check parameters
+  if ((Context == NULL) || (Encoding == NULL) || ((Input == NULL) && (InputSize != 0)) || (OutputSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Only complete blocks are encoded and every base64 character is one unit
+  Required = ((Context->Count + InputSize) / 3) * 4 * Encoding->UnitSize;
+  if (((Output == NULL) && (Required != 0)) || (*OutputSize < Required)) {
+    *OutputSize = Required;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  // Complete the partial block from the previous chunk
+  if (Context->Count != 0) {
+    while ((Context->Count < 3) && (Index < InputSize)) {
+      Context->Block = (Context->Block << 8) | Buffer[Index++];
+      ++(Context->Count);
+    }
+    if (Context->Count == 3) {
+      Base64EncoderBlock(Chunk, Context->Block, 3);
+      Status = Base64EncoderSpan(Encoding, &Next, Chunk, 4);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      Context->Block = 0;
+      Context->Count = 0;
+    }
+  }
+  // Encode complete blocks directly into ASCII compatible output or through chunks for other encodings
+  if ((Encoding == EfiUtf8Encoding()) || (Encoding == EfiLatin1Encoding())) {
+    ThisSize = EfiDispatch()->Base64Encode((CHAR8 *)Next, Buffer + Index, InputSize - Index);
+    Next += (ThisSize / 3) * 4;
+    Index += ThisSize;
+  } else {
+    while ((InputSize - Index) >= 3) {
+      ThisSize = InputSize - Index;
+      if (ThisSize > ((BASE64_CHUNK_SIZE / 4) * 3)) {
+        ThisSize = (BASE64_CHUNK_SIZE / 4) * 3;
+      }
+      ThisSize = EfiDispatch()->Base64Encode(Chunk, Buffer + Index, ThisSize);
+      Status = Base64EncoderSpan(Encoding, &Next, Chunk, (ThisSize / 3) * 4);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      Index += ThisSize;
+    }
+  }
+  // Carry the partial last block to the next chunk
+  while (Index < InputSize) {
+    Context->Block = (Context->Block << 8) | Buffer[Index++];
+    ++(Context->Count);
+  }
+  *OutputSize = (UINTN)(Next - (UINT8 *)Output);
+  return EFI_SUCCESS;
+}
+// Base64EncodeFinal
+/// Finish incremental encoding by encoding the partial last block with padding
+/// @param Context    The base64 codec context
+/// @param Encoding   The output encoding protocol interface
+/// @param Output     The base 64 encoded output buffer, which needs at most four units and is not null terminated
+/// @param OutputSize On input, the size in bytes of the output buffer, on output, the size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER  If Context or OutputSize is NULL
+/// @retval EFI_BUFFER_TOO_SMALL   The output buffer is not large enough to hold the encoded characters, *OutputSize is updated with the required size
+/// @retval EFI_UNSUPPORTED        If the encoding does not encode base64 characters as single units
+/// @retval EFI_SUCCESS            The data was encoded successfully
+EFI_STATUS
 EFIAPI
-FromBase64Character (
-  IN UINT32 Character
+Base64EncodeFinal (
+  IN OUT BASE64_CONTEXT        *Context,
+  IN     EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  OUT    VOID                  *Output OPTIONAL,
+  IN OUT UINTN                 *OutputSize
 ) {
-  UINT32 Result = 0;
-  if ((Character >= 'A') && (Character <= 'Z')) {
-    Result = (Character - 'A');
-  } else if ((Character >= 'a') && (Character <= 'z')) {
-    Result = ((Character - 'a') + 26);
-  } else if ((Character >= '0') && (Character <= '9')) {
-    Result = ((Character - '0') + 52);
-  } else if (Character == '+') {
-    Result = 62;
-  } else if (Character == '/') {
-    Result = 63;
-  }
-  return Result;
+  EFI_STATUS  Status;
+  CHAR8       Span[4];
+  UINT8      *Next = (UINT8 *)Output;
+  UINTN       Required;
+  // Set default encoding if needed
+  if (Encoding == NULL) {
+    Encoding = EfiDefaultEncoding();
+  }
+  // Check parameters
+  if ((Context == NULL) || (Encoding == NULL) || (OutputSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // A partial block is four padded characters
+  Required = (Context->Count != 0) ? (4 * Encoding->UnitSize) : 0;
+  if (((Output == NULL) && (Required != 0)) || (*OutputSize < Required)) {
+    *OutputSize = Required;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  if (Context->Count != 0) {
+    Base64EncoderBlock(Span, Context->Block << (8 * (3 - Context->Count)), Context->Count);
+    Status = Base64EncoderSpan(Encoding, &Next, Span, 4);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+    Context->Block = 0;
+    Context->Count = 0;
+  }
+  *OutputSize = Required;
+  return EFI_SUCCESS;
 }
 
 // Base64Decode
@@ -61,6 +521,8 @@ FromBase64Character (
 /// @retval EFI_INVALID_PARAMETER  If Input or OutputSize is NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
 /// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The buffer was converted but some characters were not base64 and were skipped
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EFI_STATUS
 EFIAPI
@@ -71,14 +533,9 @@ Base64Decode (
   OUT    VOID                  *Output OPTIONAL,
   IN OUT UINTN                 *OutputSize
 ) {
-  EFI_STATUS Result = EFI_SUCCESS;
-  EFI_STATUS Status = EFI_SUCCESS;
-  UINTN      RemainingSize;
-  UINTN      BufferSize;
-  UINTN      ThisSize;
-  UINTN      Count;
-  UINT8     *Buffer = (UINT8 *)Output;
-  UINT32     Units[4];
+  EFI_STATUS     Status;
+  BASE64_CONTEXT Context;
+  BASE64_DECODER Decoder;
   // Set default encoding if needed
   if (Encoding == NULL) {
     Encoding = EfiDefaultEncoding();
@@ -87,119 +544,25 @@ Base64Decode (
   if ((Encoding == NULL) || (Input == NULL) || (InputSize == 0) || (OutputSize == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the size of the buffer
-  Count = 0;
-  BufferSize = 0;
-  Buffer = (UINT8 *)Input;
-  RemainingSize = InputSize;
-  // Count the length of the string
-  while (RemainingSize >= Encoding->UnitSize) {
-    ThisSize = RemainingSize;
-    Status = EfiDecodeCharacter(Encoding, Buffer, &ThisSize, Units);
-    if (EFI_ERROR(Status)) {
-      break;
-    }
-    // Advance the input buffer and increase output buffer size
-    Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-    BufferSize += ThisSize;
-    if (RemainingSize > ThisSize) {
-      RemainingSize -= ThisSize;
-    } else {
-      RemainingSize = 0;
-    }
-    // Stop on null terminator
-    if ((Units[Count] == 0) && (RemainingSize < Encoding->UnitSize)) {
-      break;
-    }
-    // Check this is a valid base 64 character or skip
-    if (!IsBase64Character(*Units)) {
-      LOG(L"Unknown base64 character `%c` (0x%x)\n", *Units, *Units);
-      Result = EFI_WARN_UNKNOWN_GLYPH;
-      continue;
-    }
-    // Increment the base 64 count
-    ++Count;
-  }
-  // Adjust the length of the base 64 to the count of bytes
-  BufferSize = ((Count * 3) >> 2);
-  // Get buffer size
-  if ((Output == NULL) || (*OutputSize < (BufferSize * sizeof(UINT8)))) {
-    *OutputSize = (BufferSize * sizeof(UINT8));
-    return EFI_BUFFER_TOO_SMALL;
-  }
-  // Decode the base 64 in blocks, one block is four characters and three bytes when decoded
-  Count = 0;
-  Buffer = (UINT8 *)Output;
-  RemainingSize = InputSize;
-  while (RemainingSize >= Encoding->UnitSize) {
-    EfiZeroMem(Units, sizeof(Units));
-    // Decode the each unit character of this block
-    Count = 0;
-    while ((Count < 4) && (RemainingSize >= Encoding->UnitSize)) {
-      ThisSize = RemainingSize;
-      Status = EfiDecodeCharacter(Encoding, Input, &ThisSize, Units + Count);
-      if (EFI_ERROR(Status)) {
-        break;
-      }
-      // Advance the input buffer and increase output buffer size
-      Input = ADDRESS_OFFSET(VOID, Input, ThisSize);
-      BufferSize += ThisSize;
-      if (RemainingSize > ThisSize) {
-        RemainingSize -= ThisSize;
-      } else {
-        RemainingSize = 0;
-      }
-      // Stop on null terminator
-      if ((Units[Count] == 0) && (RemainingSize < Encoding->UnitSize)) {
-        break;
-      }
-      // Check this is a valid base 64 character or skip
-      if (!IsBase64Character(Units[Count])) {
-        LOG(L"Unknown base64 character `%c` (0x%x)\n", Units[Count], Units[Count]);
-        Result = EFI_WARN_UNKNOWN_GLYPH;
-        continue;
-      }
-      // Continue to next unit in block after valid character
-      ++Count;
-    }
-    if (EFI_ERROR(Status) || (Count != 4)) {
-      break;
-    }
-    // Decode the block into the unit buffer
-    if (Output != NULL) {
-      *Buffer = (UINT8)EFI_BITFIELDSHIFTLEFT(FromBase64Character(Units[0]), 2, 0, 5);
-      Units[1] = FromBase64Character(Units[1]);
-      *Buffer++ |= (UINT8)EFI_BITFIELD(Units[1], 4, 5);
-      *Buffer = (UINT8)EFI_BITFIELDSHIFTLEFT(Units[1], 4, 0, 3);
-      Units[2] = FromBase64Character(Units[2]);
-      *Buffer++ |= (UINT8)EFI_BITFIELD(Units[2], 2, 5);
-      *Buffer = (UINT8)EFI_BITFIELDSHIFTLEFT(Units[2], 6, 0, 1);
-      *Buffer++ |= (UINT8)EFI_BITFIELD(FromBase64Character(Units[3]), 0, 5);
-    }
-    Count = 0;
-  }
-  // If there are any characters left over then the input is malformed base 64
-  if (!EFI_ERROR(Status) && (Count != 0)) {
-    if ((Count == 2) || (Count == 3)) {
-      // Output the last bytes
-      *Buffer = (UINT8)EFI_BITFIELDSHIFTLEFT(Units[0], 2, 0, 5);
-      *Buffer++ |= (UINT8)EFI_BITFIELD(Units[1], 4, 5);
-      if (Count == 3) {
-        *Buffer = (UINT8)EFI_BITFIELDSHIFTLEFT(Units[1], 4, 0, 3);
-        *Buffer++ |= (UINT8)EFI_BITFIELD(Units[2], 2, 5);
-      }
-    } else {
-      Status = EFI_ABORTED;
-    }
+  // Decode in a single pass, counting the size of any decoded data that does not fit
+  Base64DecodeInit(&Context);
+  Decoder.Context = &Context;
+  Decoder.Output = (UINT8 *)Output;
+  Decoder.Remaining = (Output != NULL) ? *OutputSize : 0;
+  Decoder.Size = 0;
+  Base64DecoderInput(&Decoder, Encoding, Input, InputSize);
+  // Decode the partial last block
+  Status = Base64DecoderFinish(&Decoder);
+  if (EFI_ERROR(Status)) {
+    return Status;
   }
   // Return the output size
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    Result = Status;
-  } else if (EFI_ERROR(Status)) {
-    return Status;
+  if ((Output == NULL) || (Decoder.Size > *OutputSize)) {
+    *OutputSize = Decoder.Size;
+    return EFI_BUFFER_TOO_SMALL;
   }
-  *OutputSize = (BufferSize * sizeof(UINT8));
-  return Result;
+  *OutputSize = Decoder.Size;
+  return Context.Status;
 }
 
 // Base64Encode
@@ -222,13 +585,11 @@ Base64Encode (
   OUT    VOID                  *Output OPTIONAL,
   IN OUT UINTN                 *OutputSize
 ) {
-  EFI_STATUS Status = EFI_SUCCESS;
-  UINTN      RemainingSize;
-  UINTN      BufferSize;
-  UINTN      ThisSize;
-  UINTN      Index;
-  UINT8     *Buffer = (UINT8 *)Input;
-  UINT8      Units[4];
+  EFI_STATUS     Status;
+  BASE64_CONTEXT Context;
+  UINTN          Required;
+  UINTN          Size;
+  UINTN          ThisSize;
   // Set default encoding if needed
   if (Encoding == NULL) {
     Encoding = EfiDefaultEncoding();
@@ -237,136 +598,28 @@ Base64Encode (
   if ((Encoding == NULL) || (Input == NULL) || (OutputSize == NULL) || (InputSize == 0)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the size of the buffer
-  BufferSize = 0;
-  RemainingSize = *OutputSize;
-  // Encode buffer by getting the individual units from the bytes
-  while (InputSize >= (3 * sizeof(UINT8))) {
-    EfiZeroMem(Units, sizeof(Units));
-    // Set the first unit in this block
-    Units[0] = (UINT32)EFI_BITFIELD(*Buffer, 2, 7);
-    // The second unit is spread across the high part of the byte and the low part of the next
-    Units[1] = (UINT32)EFI_BITFIELDSHIFTLEFT(*Buffer, 4, 0, 1);
-    // Advance the input buffer and decrease the remaining input size
-    ++Buffer;
-    --InputSize;
-    Units[1] |= (UINT32)EFI_BITFIELD(*Buffer, 4, 7);
-    // The third unit in this character block is spread across two bytes like the second unit
-    Units[2] = (UINT32)EFI_BITFIELDSHIFTLEFT(*Buffer, 2, 0, 3);
-    // Advance the input buffer and decrease the remaining input size
-    ++Buffer;
-    --InputSize;
-    Units[2] |= (UINT32)EFI_BITFIELD(*Buffer, 6, 7);
-    // Set the last unit in this block
-    Units[3] = (UINT32)EFI_BITFIELD(*Buffer, 0, 5);
-    // Advance the input buffer and decrease the remaining input size
-    ++Buffer;
-    --InputSize;
-    // Encode the units
-    for (Index = 0; Index < ARRAY_COUNT(Units); ++Index) {
-      ThisSize = RemainingSize;
-      Units[Index] = mBase64Dictionary[Units[Index]];
-      Status = EfiEncodeCharacter(Encoding, Output, &ThisSize, Units[Index]);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        break;
-      }
-      if (ThisSize == 0) {
-        Status = EFI_ABORTED;
-        break;
-      }
-      // Advance the output buffer and increase output buffer size
-      if (Output != NULL) {
-        Output = ADDRESS_OFFSET(VOID, Output, ThisSize);
-      }
-      BufferSize += ThisSize;
-      if (RemainingSize > ThisSize) {
-        RemainingSize -= ThisSize;
-      } else {
-        RemainingSize = 0;
-      }
-    }
-    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-      break;
-    }
-  }
-  // Encode any remaining bytes that do not fit into a block
-  if ((InputSize != 0) && (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL))) {
-    EfiZeroMem(Units, sizeof(Units));
-    if (InputSize == sizeof(UINT8)) {
-      // Set the first unit in this block
-      Units[0] = (UINT32)EFI_BITFIELD(*Buffer, 2, 7);
-      // The second unit is spread across the high part of the byte and the low part of the next
-      Units[1] = (UINT32)EFI_BITFIELDSHIFTLEFT(*Buffer, 4, 0, 1);
-      // Advance the input buffer and decrease the remaining input size
-      ++Buffer;
-      --InputSize;
-      // The last two units will be padding characters
-      Units[2] = '=';
-      Units[3] = '=';
-    } else if (InputSize == (2 * sizeof(UINT8))) {
-      // Set the first unit in this block
-      Units[0] = mBase64Dictionary[(UINT32)EFI_BITFIELD(*Buffer, 2, 7)];
-      // The second unit is spread across the high part of the byte and the low part of the next
-      Units[1] = (UINT32)EFI_BITFIELDSHIFTLEFT(*Buffer, 4, 0, 1);
-      // Advance the input buffer and decrease the remaining input size
-      ++Buffer;
-      --InputSize;
-      Units[1] = mBase64Dictionary[Units[1] | (UINT32)EFI_BITFIELD(*Buffer, 4, 7)];
-      // The third unit in this character block is spread across two bytes like the second unit
-      Units[2] = mBase64Dictionary[(UINT32)EFI_BITFIELDSHIFTLEFT(*Buffer, 2, 0, 3)];
-      // Advance the input buffer and decrease the remaining input size
-      ++Buffer;
-      --InputSize;
-      // The last unit will be padding character
-      Units[3] = '=';
-    }
-    // Copy the units into the output
-    for (Index = 0; Index < ARRAY_COUNT(Units); ++Index) {
-      ThisSize = RemainingSize;
-      Status = EfiEncodeCharacter(Encoding, Output, &ThisSize, Units[Index]);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        break;
-      }
-      if (ThisSize == 0) {
-        Status = EFI_ABORTED;
-        break;
-      }
-      // Advance the output buffer and increase output buffer size
-      if (Output != NULL) {
-        Output = ADDRESS_OFFSET(VOID, Output, ThisSize);
-      }
-      BufferSize += ThisSize;
-      if (RemainingSize > ThisSize) {
-        RemainingSize -= ThisSize;
-      } else {
-        RemainingSize = 0;
-      }
-    }
+  // Every base64 character and the null terminator is one unit so the size is known up front
+  Required = ((((InputSize + 2) / 3) * 4) + 1) * Encoding->UnitSize;
+  if ((Output == NULL) || (*OutputSize < Required)) {
+    *OutputSize = Required;
+    return EFI_BUFFER_TOO_SMALL;
   }
-  // Check to see if there was a problem encoding
-  if (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
-    ThisSize = RemainingSize;
-    // Encode the null terminator
-    Status = EfiEncodeCharacter(Encoding, Output, &ThisSize, 0);
-    if (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
-      // Increase output buffer size
-      BufferSize += ThisSize;
-      if (RemainingSize > ThisSize) {
-        RemainingSize -= ThisSize;
-      } else {
-        RemainingSize = 0;
-      }
-    } else if (ThisSize == 0) {
-      Status = EFI_ABORTED;
-    }
+  // Encode the data in a single update
+  Base64EncodeInit(&Context);
+  Size = Required;
+  Status = Base64EncodeUpdate(&Context, Encoding, Input, InputSize, Output, &Size);
+  if (EFI_ERROR(Status)) {
+    return Status;
   }
-  // Set output buffer size
-  if (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
-    if (OutputSize != NULL) {
-      *OutputSize = BufferSize;
-    }
+  ThisSize = Required - Size;
+  Status = Base64EncodeFinal(&Context, Encoding, ADDRESS_OFFSET(VOID, Output, Size), &ThisSize);
+  if (EFI_ERROR(Status)) {
+    return Status;
   }
-  return Status;
+  // Null terminate the output
+  EfiZeroMem(ADDRESS_OFFSET(VOID, Output, Size + ThisSize), Encoding->UnitSize);
+  *OutputSize = Required;
+  return EFI_SUCCESS;
 }
 
 // Base64DecodeBuffer
@@ -378,7 +631,9 @@ Base64Encode (
 /// @param OutputSize On output, the size in bytes of the converted output buffer
 /// @retval EFI_INVALID_PARAMETER  If Input or Output is NULL or *Output is not NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
-/// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_OUT_OF_RESOURCES   If memory could not be allocated for the output buffer
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The buffer was converted but some characters were not base64 and were skipped
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EFI_STATUS
 EFIAPI
@@ -389,38 +644,42 @@ Base64DecodeBuffer (
   OUT VOID                  **Output,
   OUT UINTN                  *OutputSize OPTIONAL
 ) {
-  EFI_STATUS Status;
-  UINTN      Size = 0;
+  EFI_STATUS  Status;
+  VOID       *Buffer = NULL;
+  UINTN       Size;
+  // Set default encoding if needed
+  if (Encoding == NULL) {
+    Encoding = EfiDefaultEncoding();
+  }
   // Check parameters
-  if ((Input == NULL) || (InputSize == 0) || (Output == NULL) || (*Output != NULL)) {
+  if ((Encoding == NULL) || (Input == NULL) || (InputSize == 0) || (Output == NULL) || (*Output != NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get size of output buffer size
-  Status = Base64Decode(Encoding, Input, InputSize, NULL, &Size);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    return Status;
-  }
+  // Allocate for the largest decoded size, every character is at least one unit and every four characters decode to at most three bytes
+  Size = (((InputSize / Encoding->UnitSize) + 3) / 4) * 3;
   if (Size != 0) {
-    // Allocate buffer
-    VOID *Buffer = EfiAllocate(Size);
+    Buffer = EfiAllocate(Size);
     if (Buffer == NULL) {
-      return EFI_INVALID_PARAMETER;
+      return EFI_OUT_OF_RESOURCES;
     }
-    // Decode buffer
+    // Decode buffer in a single pass
     Status = Base64Decode(Encoding, Input, InputSize, Buffer, &Size);
-    // Set buffer
-    if (!EFI_ERROR(Status)) {
-      *Output = Buffer;
+    if (EFI_ERROR(Status)) {
+      EfiFreePool(Buffer);
+      return Status;
     }
-  } else if (!EFI_ERROR(Status)) {
-    // No output buffer
-    *Output = NULL;
+  } else {
+    Status = EFI_SUCCESS;
+  }
+  // Set buffer or no output buffer if nothing was decoded
+  if (Size != 0) {
+    *Output = Buffer;
+  } else if (Buffer != NULL) {
+    EfiFreePool(Buffer);
   }
   // Return the output size
-  if (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
-    if (OutputSize != NULL) {
-      *OutputSize = Size;
-    }
+  if (OutputSize != NULL) {
+    *OutputSize = Size;
   }
   return Status;
 }
@@ -433,7 +692,7 @@ Base64DecodeBuffer (
 /// @param OutputSize On output, the size in bytes of the converted output buffer
 /// @retval EFI_INVALID_PARAMETER  If Input or Output is NULL or *Output is not NULL
 /// @retval EFI_INVALID_PARAMETER  If InputSize is zero
-/// @retval EFI_BUFFER_TOO_SMALL   The specified output buffer size is not large enough to hold the converted buffer, *OutputSize is updated with the required size
+/// @retval EFI_OUT_OF_RESOURCES   If memory could not be allocated for the output buffer
 /// @retval EFI_SUCCESS            The buffer was converted successfully
 EFI_STATUS
 EFIAPI
@@ -459,7 +718,7 @@ Base64EncodeBuffer (
     // Allocate buffer
     VOID *Buffer = EfiAllocate(Size);
     if (Buffer == NULL) {
-      return EFI_INVALID_PARAMETER;
+      return EFI_OUT_OF_RESOURCES;
     }
     // Encode buffer
     Status = Base64Encode(Encoding, Input, InputSize, Buffer, &Size);
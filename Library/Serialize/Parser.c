@@ -9,6 +9,9 @@
 // LANG_PREVIOUS_STATE_STACK_SIZE
 /// The default size for the previous state stack
 #define LANG_PREVIOUS_STATE_STACK_SIZE 8
+// LANG_TOKEN_DEFAULT_SIZE
+/// The default size in characters of a parsed token, tokens double in size when they grow
+#define LANG_TOKEN_DEFAULT_SIZE 32
 
 // LANG_MESSAGE_FORMAT
 /// The default language message format specifier
@@ -996,6 +999,52 @@ ParseCheckRules (
   return SetNextParseState(Parser, MatchRule->NextState, MatchRule->PushState, EFI_BITS_UNSET(RuleOptions, LANG_RULE_POP_BEFORE | LANG_RULE_POP_AFTER));
 }
 
+// ParseAppendToken
+/// Append a character to the current parsed token
+/// @param Parser    The language parser
+/// @param Character The character to append or zero to only null terminate the token
+/// @retval EFI_INVALID_PARAMETER If Character is invalid
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the token
+/// @retval EFI_SUCCESS           If the character was appended to the token
+STATIC
+EFI_STATUS
+EFIAPI
+ParseAppendToken (
+  IN OUT LANG_PARSER *Parser,
+  IN     UINT32       Character
+) {
+  UINTN Count = Parser->TokenCount;
+  // Check parameters
+  if (!IsUnicodeCharacter(Character)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Grow the token geometrically when a surrogate pair and the null terminator no longer fit
+  if ((Parser->Token == NULL) || (Parser->TokenSize < (Count + 3))) {
+    UINTN   NewSize = (Parser->TokenSize < LANG_TOKEN_DEFAULT_SIZE) ? LANG_TOKEN_DEFAULT_SIZE : (Parser->TokenSize * 2);
+    CHAR16 *Token;
+    while (NewSize < (Count + 3)) {
+      NewSize *= 2;
+    }
+    Token = EfiReallocateArray(CHAR16, NewSize, (Parser->Token != NULL) ? Parser->TokenSize : 0, Parser->Token);
+    if (Token == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Parser->Token = Token;
+    Parser->TokenSize = NewSize;
+  }
+  // Encode the character as UTF-16 directly rather than through the encoding protocol for every character
+  if (Character >= 0x10000) {
+    Character -= 0x10000;
+    Parser->Token[Count++] = (CHAR16)(0xD800 + (Character >> 10));
+    Parser->Token[Count++] = (CHAR16)(0xDC00 + (Character & 0x3FF));
+  } else if (Character != 0) {
+    Parser->Token[Count++] = (CHAR16)Character;
+  }
+  Parser->Token[Count] = L'\0';
+  Parser->TokenCount = Count;
+  return EFI_SUCCESS;
+}
+
 // ParseCharacter
 /// Parse a character
 /// @param Parser    The language parser to use in parsing
@@ -1029,7 +1078,7 @@ ParseCharacter (
     return EFI_NOT_FOUND;
   }
   // Append the character to the token
-  Status = StrAppend(&(Parser->Token), &(Parser->TokenCount), &(Parser->TokenSize), Character);
+  Status = ParseAppendToken(Parser, Character);
   if (EFI_ERROR(Status)) {
     return Status;
   }
@@ -1201,42 +1250,23 @@ Parse (
   IN     UINTN                  Options,
   IN     VOID                  *Context OPTIONAL
 ) {
-  EFI_STATUS Status;
-  UINT32     Character;
-  UINTN      OriginalOptions = Options;
+  EFI_STATUS               Status;
+  EFI_ENCODING_DECODE_CHAR Decode = NULL;
+  UINT32                   Character;
+  UINTN                    OriginalOptions = Options;
+  UINTN                    ValidSize;
   // Check parameters
   if ((Parser == NULL) || (Buffer == NULL) || (Size == 0)) {
     return EFI_INVALID_PARAMETER;
   }
   // Try to detect encoding
   if (Encoding == NULL) {
-    // Detect UTF-16 byte order mark
-    if (Size >= (2 * sizeof(CHAR16))) {
-      CHAR16 *Detect = (CHAR16 *)Buffer;
-      if (*Detect == 0xFEFF) {
-        // UTF-16 byte order mark
-        Encoding = EfiUtf16Encoding();
-      } else if (*Detect == 0xFFFE) {
-        // UTF-16 byte swapped byte order mark
-        Encoding = EfiUtf16SwappedEncoding();
-      }
+    // Detect the encoding from byte order marks or the content, only trusting detection that matched the content
+    EFI_ENCODING_PROTOCOL *Detected = NULL;
+    UINTN                  Confidence = 0;
+    if (!EFI_ERROR(EfiEncodingDetect(Buffer, Size, &Detected, &Confidence)) && (Confidence >= EFI_ENCODING_CONFIDENCE_MEDIUM)) {
+      Encoding = Detected;
     }
-    // Detect UTF-8 byte order mark
-    if (Encoding == NULL) {
-      if (Size >= (3 * sizeof(CHAR8))) {
-        CHAR8 *Detect = (CHAR8 *)Buffer;
-        if (*Detect++ == 0xEF) {
-          if (*Detect++ == 0xBB) {
-            if (*Detect++ == 0xBF) {
-              // UTF-8 byte order mark
-              Encoding = EfiUtf8Encoding();
-            }
-          }
-        }
-      }
-    }
-    // TODO: Attempt to detect encoding through pattern recognition
-
     // Fallback to default as last resort
     if (Encoding == NULL) {
       Encoding = EfiDefaultEncoding();
@@ -1245,6 +1275,13 @@ Parse (
       }
     }
   }
+  // Validate the whole buffer once so the characters can be decoded without checking each one
+  if ((Encoding->Validate != NULL) && (Encoding->DecodeValidated != NULL)) {
+    ValidSize = Size;
+    if (Encoding->Validate(Encoding, Buffer, &ValidSize, NULL) == EFI_SUCCESS) {
+      Decode = Encoding->DecodeValidated;
+    }
+  }
   // Make sure options are suitable for parsing the entire character buffer
   Options &= ~LANG_PARSE_FINISH;
   // Parse the buffer
@@ -1252,7 +1289,11 @@ Parse (
     UINTN ThisSize = Size;
     // Decode each character from the buffer
     Character = 0;
-    Status = EfiDecodeCharacter(Encoding, Buffer, &ThisSize, &Character);
+    if (Decode != NULL) {
+      Status = Decode(Encoding, Buffer, &ThisSize, &Character);
+    } else {
+      Status = EfiDecodeCharacter(Encoding, Buffer, &ThisSize, &Character);
+    }
     if (EFI_ERROR(Status) || (Character == 0)) {
       break;
     }
@@ -9,6 +9,10 @@
 
 #include "Serialize/Type/plist.dtd.h"
 
+// PLIST_DATA_CHUNK_SIZE
+/// The size in bytes of the stack buffer through which data is encoded to base64 when converting to XML
+#define PLIST_DATA_CHUNK_SIZE 512
+
 // PLIST_LIST
 /// PLIST key list
 typedef struct PLIST_LIST PLIST_LIST;
@@ -21,6 +25,49 @@ struct PLIST_LIST {
   /// The PLIST key
   PLIST_KEY  *Key;
 
+};
+// PLIST_TAG
+/// PLIST XML tag
+typedef enum PLIST_TAG PLIST_TAG;
+enum PLIST_TAG {
+
+  // PlistTagPlist
+  /// PLIST document tag
+  PlistTagPlist = 0,
+  // PlistTagKey
+  /// PLIST key name tag
+  PlistTagKey,
+  // PlistTagDict
+  /// PLIST dictionary tag
+  PlistTagDict,
+  // PlistTagArray
+  /// PLIST array tag
+  PlistTagArray,
+  // PlistTagString
+  /// PLIST string tag
+  PlistTagString,
+  // PlistTagDate
+  /// PLIST date tag
+  PlistTagDate,
+  // PlistTagData
+  /// PLIST data tag
+  PlistTagData,
+  // PlistTagReal
+  /// PLIST real tag
+  PlistTagReal,
+  // PlistTagInteger
+  /// PLIST integer tag
+  PlistTagInteger,
+  // PlistTagTrue
+  /// PLIST true tag
+  PlistTagTrue,
+  // PlistTagFalse
+  /// PLIST false tag
+  PlistTagFalse,
+  // PlistTagCount
+  /// The count of PLIST tags
+  PlistTagCount
+
 };
 // PLIST_PARSER
 /// PLIST parser
@@ -28,19 +75,38 @@ struct PLIST_PARSER {
 
   // Parser
   /// The XML parser
-  XML_PARSER *Parser;
+  XML_PARSER   *Parser;
   // Key
-  /// The current key name
-  CHAR16     *Key;
+  /// The current interned key name
+  CHAR16       *Key;
   // Dictionary
   /// The dictionary
-  PLIST_KEY  *Dictionary;
+  PLIST_KEY    *Dictionary;
   // Stack
   /// The key stack
-  PLIST_LIST *Stack;
+  PLIST_LIST   *Stack;
+  // Tags
+  /// The case insensitive interned PLIST tag names so tag names are compared by pointer
+  CONST CHAR16 *Tags[PlistTagCount];
 
 };
 
+// mPlistTagNames
+/// The PLIST tag names
+STATIC CONST CHAR16 *mPlistTagNames[PlistTagCount] = {
+  L"plist",
+  L"key",
+  L"dict",
+  L"array",
+  L"string",
+  L"date",
+  L"data",
+  L"real",
+  L"integer",
+  L"true",
+  L"false"
+};
+
 // PlistCreate
 /// Create a PLIST dictionary parser
 /// @param Parser On output, the created PLIST parser
@@ -56,6 +122,7 @@ PlistCreate (
 ) {
   EFI_STATUS    Status;
   PLIST_PARSER *Plist;
+  UINTN         Index;
   // Check parameters
   if ((Parser == NULL) || (*Parser != NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -65,6 +132,14 @@ PlistCreate (
   if (Plist == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
+  // Intern the tag names
+  for (Index = 0; Index < PlistTagCount; ++Index) {
+    Plist->Tags[Index] = StrIntern(mPlistTagNames[Index], STR_INTERN_CASE_INSENSITIVE);
+    if (Plist->Tags[Index] == NULL) {
+      PlistFree(Plist);
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
   // Create the XML parser
   Status = XmlCreate(&(Plist->Parser), L"plist.dtd");
   if (!EFI_ERROR(Status)) {
@@ -105,11 +180,8 @@ PlistReset (
     PlistDictionaryFree(Parser->Dictionary);
     Parser->Dictionary = NULL;
   }
-  // Free the key
-  if (Parser->Key != NULL) {
-    EfiFreePool(Parser->Key);
-    Parser->Key = NULL;
-  }
+  // Clear the key, interned names are never freed
+  Parser->Key = NULL;
   // Reset the XML parser
   return XmlReset(Parser->Parser, Source);
 }
@@ -131,10 +203,7 @@ PlistFree (
     PlistDictionaryFree(Parser->Dictionary);
     Parser->Dictionary = NULL;
   }
-  if (Parser->Key != NULL) {
-    EfiFreePool(Parser->Key);
-    Parser->Key = NULL;
-  }
+  Parser->Key = NULL;
   while (Parser->Stack != NULL) {
     PLIST_LIST *Stack = Parser->Stack;
     Parser->Stack = Stack->Next;
@@ -221,16 +290,175 @@ PlistDictionaryFree (
     PlistDictionaryFree(Dictionary->Next);
     Dictionary->Next = NULL;
   }
-  // Free key name
-  if (Dictionary->Name != NULL) {
-    EfiFreePool(Dictionary->Name);
-    Dictionary->Name = NULL;
-  }
+  // Clear key name, interned names are never freed
+  Dictionary->Name = NULL;
   // Free the key value
   PlistFreeValue(Dictionary->Type, &(Dictionary->Value));
+  // Free the key value text if never decoded
+  if (Dictionary->Raw != NULL) {
+    EfiFreePool(Dictionary->Raw);
+    Dictionary->Raw = NULL;
+  }
   // Free key
   return EfiFreePool((VOID *)Dictionary);
 }
+// PlistDecodeData
+/// Decode base64 text to binary data in place, the text is fed to the decoder in chunks and the data is written over the text already decoded
+/// @param Text The base64 text, which is no longer valid text after decoding, even if decoding fails
+/// @param Data On output, the text buffer which now holds the decoded data or NULL if there was no data
+/// @param Size On output, the size in bytes of the decoded data
+/// @retval EFI_ABORTED            If the last block of characters was too short to decode a byte
+/// @retval EFI_WARN_UNKNOWN_GLYPH The data was decoded but some characters were not base64 and were skipped
+/// @retval EFI_SUCCESS            The data was decoded successfully
+/// @return Any other status returned by the base64 decoder
+STATIC
+EFI_STATUS
+EFIAPI
+PlistDecodeData (
+  IN OUT CHAR16  *Text,
+  OUT    VOID   **Data,
+  OUT    UINTN   *Size
+) {
+  EFI_STATUS      Status = EFI_SUCCESS;
+  BASE64_CONTEXT  Context;
+  UINT8          *Output = (UINT8 *)Text;
+  UINTN           Length = StrLen(Text);
+  UINTN           Index;
+  UINTN           ThisSize;
+  UINTN           OutputSize;
+  *Data = NULL;
+  *Size = 0;
+  Base64DecodeInit(&Context);
+  // Four characters of two bytes decode to three bytes so the data never overtakes the text that is still to be decoded
+  for (Index = 0; !EFI_ERROR(Status) && (Index < Length); Index += ThisSize) {
+    ThisSize = ((Length - Index) < PLIST_DATA_CHUNK_SIZE) ? (Length - Index) : PLIST_DATA_CHUNK_SIZE;
+    OutputSize = ((Length + 1) * sizeof(CHAR16)) - *Size;
+    Status = Base64DecodeUpdate(&Context, EfiUtf16Encoding(), Text + Index, ThisSize * sizeof(CHAR16), Output + *Size, &OutputSize);
+    if (!EFI_ERROR(Status)) {
+      *Size += OutputSize;
+    }
+  }
+  // Decode the partial last block
+  if (!EFI_ERROR(Status)) {
+    OutputSize = ((Length + 1) * sizeof(CHAR16)) - *Size;
+    Status = Base64DecodeFinal(&Context, Output + *Size, &OutputSize);
+    if (!EFI_ERROR(Status)) {
+      *Size += OutputSize;
+    }
+  }
+  if (EFI_ERROR(Status)) {
+    *Size = 0;
+  } else if (*Size != 0) {
+    *Data = Text;
+  }
+  return Status;
+}
+// PlistDecodeValue
+/// Decode the text of a PLIST date, data, real or integer value
+/// @param Type  The type of the value
+/// @param Text  The text of the value, data text is decoded in place so the text becomes the data value and is no longer valid text afterwards
+/// @param Value On output, the decoded value, a date or data value is allocated and must be freed
+/// @param Size  On output, the size in bytes of the decoded value
+/// @retval EFI_INVALID_PARAMETER If the text is not valid for the type
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the value
+/// @retval EFI_UNSUPPORTED       If the type is never kept as text
+/// @retval EFI_SUCCESS           If the value was decoded
+/// @return Any other status returned while decoding the value text
+STATIC
+EFI_STATUS
+EFIAPI
+PlistDecodeValue (
+  IN  PLIST_TYPE    Type,
+  IN  CHAR16       *Text,
+  OUT PLIST_VALUE  *Value,
+  OUT UINTN        *Size
+) {
+  EFI_STATUS    Status;
+  CONST CHAR16 *Ptr = Text;
+  // Determine type of value
+  switch (Type) {
+    case PlistTypeDate:
+      // Parse date time as YYYY '-' MM '-' DD 'T' HH ':' MM ':' SS 'Z'
+      *Size = sizeof(EFI_TIME);
+      Value->Date = EfiAllocateByType(EFI_TIME);
+      if (Value->Date == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      Status = StrToDateTime(&Ptr, Value->Date);
+      if (!EFI_ERROR(Status)) {
+        // Only white space may follow the date and time
+        while ((*Ptr == L' ') || (*Ptr == L'\t') || (*Ptr == L'\r') || (*Ptr == L'\n')) {
+          ++Ptr;
+        }
+        if (*Ptr != 0) {
+          Status = EFI_INVALID_PARAMETER;
+        }
+      }
+      if (EFI_ERROR(Status)) {
+        EfiFreePool(Value->Date);
+        Value->Date = NULL;
+      }
+      return Status;
+
+    case PlistTypeData:
+      // Decode the base64 string to binary data in place
+      return PlistDecodeData(Text, &(Value->Data), Size);
+
+    case PlistTypeReal:
+      // Floating point real number
+      *Size = sizeof(FLOAT64);
+      return StrToFloat(&Ptr, &(Value->Real));
+
+    case PlistTypeInteger:
+      // Integer
+      *Size = sizeof(INT64);
+      return StrToInteger(&Ptr, &(Value->Integer), 10);
+
+    default:
+      // The rest of the value types are never kept as text
+      break;
+  }
+  return EFI_UNSUPPORTED;
+}
+// PlistKeyDecode
+/// Decode the value of a PLIST key, date, data, real and integer values are kept as text when parsed and decoded on first access
+/// @param Key The PLIST key of which to decode the value, the value and size are valid after this returns successfully
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the value
+/// @retval EFI_SUCCESS           If the value was decoded or was already decoded
+/// @return Any other status returned while decoding the value text, data text is decoded in place so a data key that fails is left without a value
+EFI_STATUS
+EFIAPI
+PlistKeyDecode (
+  IN OUT PLIST_KEY *Key
+) {
+  EFI_STATUS  Status;
+  PLIST_VALUE Value;
+  UINTN       Size = 0;
+  // Check parameters
+  if (Key == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Check if the value was already decoded
+  if (Key->Raw == NULL) {
+    return EFI_SUCCESS;
+  }
+  // Decode the text, the text is kept on failure so the error is returned again, except data text which is decoded in place
+  EfiZeroMem(&Value, sizeof(PLIST_VALUE));
+  Status = PlistDecodeValue(Key->Type, Key->Raw, &Value, &Size);
+  if (EFI_ERROR(Status) && (Key->Type != PlistTypeData)) {
+    return Status;
+  }
+  // Keep the decoded value and free the text unless it became the data
+  PlistFreeValue(Key->Type, &(Key->Value));
+  Key->Value = Value;
+  Key->Size = Size;
+  if ((Key->Type != PlistTypeData) || (Value.Data != Key->Raw)) {
+    EfiFreePool(Key->Raw);
+  }
+  Key->Raw = NULL;
+  return Status;
+}
 
 // XmlParserFromPlistParser
 /// Get the XML parser from a PLIST parser
@@ -261,11 +489,76 @@ ParserFromPlistParser (
   return ParserFromXmlParser(Parser->Parser);
 }
 
+// PlistDecodeConfiguration
+/// Decode the text of a PLIST value imported into the configuration when the value is first accessed
+/// @param Type  The configuration type of the value
+/// @param Text  The text of the value, data text is decoded in place so the text becomes the data value
+/// @param Value On output, the decoded value, which is allocated
+/// @param Size  On output, the size in bytes of the decoded value
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated for the value
+/// @retval EFI_UNSUPPORTED      If the type is never kept as text
+/// @retval EFI_SUCCESS          If the value was decoded
+/// @return Any other status returned while decoding the value text
+STATIC
+EFI_STATUS
+EFIAPI
+PlistDecodeConfiguration (
+  IN  EFI_CONFIGURATION_TYPE   Type,
+  IN  CHAR16                  *Text,
+  OUT VOID                   **Value,
+  OUT UINTN                   *Size
+) {
+  EFI_STATUS  Status;
+  PLIST_VALUE Decoded;
+  EfiZeroMem(&Decoded, sizeof(PLIST_VALUE));
+  // Determine the type of the value
+  switch (Type) {
+    case EfiConfigurationTypeDate:
+      // Date key type, the allocated date is the value
+      Status = PlistDecodeValue(PlistTypeDate, Text, &Decoded, Size);
+      if (!EFI_ERROR(Status)) {
+        *Value = Decoded.Date;
+      }
+      return Status;
+
+    case EfiConfigurationTypeData:
+      // Data key type, the text decoded in place is the value
+      Status = PlistDecodeValue(PlistTypeData, Text, &Decoded, Size);
+      if (!EFI_ERROR(Status)) {
+        *Value = Decoded.Data;
+      }
+      return Status;
+
+    case EfiConfigurationTypeFloat:
+      // Real key type
+      Status = PlistDecodeValue(PlistTypeReal, Text, &Decoded, Size);
+      break;
+
+    case EfiConfigurationTypeInteger:
+      // Integer key type
+      Status = PlistDecodeValue(PlistTypeInteger, Text, &Decoded, Size);
+      break;
+
+    default:
+      // The rest of the value types are never kept as text
+      return EFI_UNSUPPORTED;
+  }
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Duplicate the number as the value
+  *Value = EfiDuplicate(*Size, &Decoded);
+  if (*Value == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  return EFI_SUCCESS;
+}
 // PlistImportValue
 /// Import a PLIST value into the dictionary
 /// @param Type  The PLIST value type
 /// @param Value The PLIST value to import
 /// @param Size  The size in bytes of the PLIST value
+/// @param Raw   The PLIST value text that has not been decoded or NULL, which is imported to be decoded when first accessed
 /// @param Path  The current configuration path while walking and importing the PLIST dictionary
 STATIC
 EFI_STATUS
@@ -274,6 +567,7 @@ PlistImportValue (
   IN PLIST_TYPE    Type,
   IN PLIST_VALUE  *Value,
   IN UINTN         Size,
+  IN CONST CHAR16 *Raw OPTIONAL,
   IN CONST CHAR16 *Path
 ) {
   EFI_STATUS Status = EFI_SUCCESS;
@@ -303,12 +597,20 @@ PlistImportValue (
 
     case PlistTypeDate:
       // Date key type
-      EfiConfigurationSetDate(Path, Value->Date);
+      if (Raw != NULL) {
+        EfiConfigurationSetEncoded(Path, Raw, EfiConfigurationTypeDate, PlistDecodeConfiguration);
+      } else {
+        EfiConfigurationSetDate(Path, Value->Date);
+      }
       break;
 
     case PlistTypeData:
       // Data key type
-      EfiConfigurationSetData(Path, Value->Data, Size);
+      if (Raw != NULL) {
+        EfiConfigurationSetEncoded(Path, Raw, EfiConfigurationTypeData, PlistDecodeConfiguration);
+      } else {
+        EfiConfigurationSetData(Path, Value->Data, Size);
+      }
       break;
 
     case PlistTypeUnsigned:
@@ -318,7 +620,11 @@ PlistImportValue (
 
     case PlistTypeInteger:
       // Integer key type
-      EfiConfigurationSetInteger(Path, Value->Integer);
+      if (Raw != NULL) {
+        EfiConfigurationSetEncoded(Path, Raw, EfiConfigurationTypeInteger, PlistDecodeConfiguration);
+      } else {
+        EfiConfigurationSetInteger(Path, Value->Integer);
+      }
       break;
 
     case PlistTypeBoolean:
@@ -328,7 +634,11 @@ PlistImportValue (
 
     case PlistTypeReal:
       // Real key type
-      EfiConfigurationSetFloat(Path, Value->Real);
+      if (Raw != NULL) {
+        EfiConfigurationSetEncoded(Path, Raw, EfiConfigurationTypeFloat, PlistDecodeConfiguration);
+      } else {
+        EfiConfigurationSetFloat(Path, Value->Real);
+      }
       break;
 
     default:
@@ -362,7 +672,7 @@ PlistImportConfiguration (
     return EFI_INVALID_PARAMETER;
   }
   // Set value in configuration
-  Status = PlistImportValue(Dictionary->Type, &(Dictionary->Value), Dictionary->Size, Path);
+  Status = PlistImportValue(Dictionary->Type, &(Dictionary->Value), Dictionary->Size, Dictionary->Raw, Path);
   // Free full key path and return status
   EfiFreePool(Path);
   return Status;
@@ -497,7 +807,7 @@ PlistExportCallback (
   // Only set a key name for dictionary or leaf key types and not for an array
   if ((Parser->Stack != NULL) && (Parser->Stack->Key != NULL) && (StrLen(Name) != 0) &&
       (Parser->Stack->Key->Type != EfiConfigurationTypeArray)) {
-    Parser->Key = StrDup(Name);
+    Parser->Key = (CHAR16 *)StrIntern(Name, 0);
     if (Parser->Key == NULL) {
       return FALSE;
     }
@@ -620,9 +930,6 @@ PlistExportConfiguration (
     Parser.Stack = Stack->Next;
     EfiFreePool(Stack);
   }
-  if (Parser.Key != NULL) {
-    EfiFreePool(Parser.Key);
-  }
   // Set dictionary and return status
   if (!EFI_ERROR(Status)) {
     *Dictionary = Parser.Dictionary;
@@ -662,8 +969,8 @@ PlistXmlInspector (
   PLIST_PARSER *Parser;
   PLIST_LIST   *Stack;
   PLIST_KEY    *Key;
+  CONST CHAR16 *Tag;
   UINTN         Index;
-  UNUSED_PARAMETER(Tree);
   UNUSED_PARAMETER(Attributes);
   UNUSED_PARAMETER(AttributeCount);
   // Get the parser
@@ -671,10 +978,12 @@ PlistXmlInspector (
   if (Parser == NULL) {
     return FALSE;
   }
+  // Find the case insensitive interned tag name, a tag name that was never interned is not a PLIST tag
+  Tag = StrIntern(TagName, STR_INTERN_CASE_INSENSITIVE | STR_INTERN_FIND_ONLY);
   // Only the PLIST tag can exist at the root
   if (Level == 0) {
     // Check this is PLIST document, must be only element at this level and have PLIST tag name
-    if ((LevelIndex != 0) || (StriCmp(TagName, L"plist") != 0) || (ChildCount != 1) ||
+    if ((LevelIndex != 0) || (Tag != Parser->Tags[PlistTagPlist]) || (ChildCount != 1) ||
         EFI_ERROR(XmlTreeInspect(Children[0], Level + 1, 0, PlistXmlInspector, Context, FALSE))) {
       return FALSE;
     }
@@ -688,18 +997,18 @@ PlistXmlInspector (
     }
   } else if ((LevelIndex % 2) == 0) {
     // Key name
-    if ((StriCmp(TagName, L"key") != 0) || (Value == NULL) || (*Value == 0) || (Parser->Key != NULL)) {
+    if ((Tag != Parser->Tags[PlistTagKey]) || (Value == NULL) || (*Value == 0) || (Parser->Key != NULL)) {
       return FALSE;
     }
     // Set the key name
-    Parser->Key = StrDup(Value);
+    Parser->Key = (CHAR16 *)StrIntern(Value, 0);
     if (Parser->Key == NULL) {
       return FALSE;
     }
     return TRUE;
   }
   // Create the key
-  if (StriCmp(TagName, L"dict") == 0) {
+  if (Tag == Parser->Tags[PlistTagDict]) {
     // Dictionary
     Key = PlistXmlAddKey(Parser, PlistTypeDictionary);
     if (Key == NULL) {
@@ -731,7 +1040,7 @@ PlistXmlInspector (
     Stack = Parser->Stack;
     Parser->Stack = Parser->Stack->Next;
     EfiFreePool(Stack);
-  } else if (StriCmp(TagName, L"array") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagArray]) {
     // Array
     Key = PlistXmlAddKey(Parser, PlistTypeArray);
     if (Key == NULL) {
@@ -763,7 +1072,7 @@ PlistXmlInspector (
     Stack = Parser->Stack;
     Parser->Stack = Parser->Stack->Next;
     EfiFreePool(Stack);
-  } else if (StriCmp(TagName, L"string") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagString]) {
     // String
     Key = PlistXmlAddKey(Parser, PlistTypeString);
     if (Key == NULL) {
@@ -776,61 +1085,65 @@ PlistXmlInspector (
         return FALSE;
       }
     }
-  } else if (StriCmp(TagName, L"date") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagDate]) {
     // Date and/or time
     Key = PlistXmlAddKey(Parser, PlistTypeDate);
     if (Key == NULL) {
       return FALSE;
     }
     Key->Size = sizeof(EFI_TIME);
-    // Parse dare time as YYYY '-' MM '-' DD 'T' HH ':' MM ':' SS 'Z'
     if ((Value != NULL) && (*Value != 0)) {
-      if (EFI_ERROR(StrToDateTime(&Value, Key->Value.Date))) {
+      // Take the date time text from the tree to parse on first access
+      if (EFI_ERROR(XmlTreeTakeValue(Tree, &(Key->Raw)))) {
+        return FALSE;
+      }
+    } else {
+      Key->Value.Date = EfiAllocateByType(EFI_TIME);
+      if (Key->Value.Date == NULL) {
         return FALSE;
       }
     }
-  } else if (StriCmp(TagName, L"data") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagData]) {
     // Binary data encoded in base64
     Key = PlistXmlAddKey(Parser, PlistTypeData);
     if (Key == NULL) {
       return FALSE;
     }
-    // Decode the base64 string to binary data
+    // Take the base64 string from the tree to decode to binary data on first access
     Key->Size = 0;
     Key->Value.Data = NULL;
     if ((Value != NULL) && (*Value != 0)) {
-      UINTN Size = StrSize(Value);
-      if (Size != 0) {
-        if (EFI_ERROR(Base64DecodeBuffer(EfiUtf16Encoding(), Value, Size, &(Key->Value.Data), &(Key->Size)))) {
-          return FALSE;
-        }
+      if (EFI_ERROR(XmlTreeTakeValue(Tree, &(Key->Raw)))) {
+        return FALSE;
       }
     }
-  } else if (StriCmp(TagName, L"real") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagReal]) {
     // Floating point real number
     Key = PlistXmlAddKey(Parser, PlistTypeReal);
     if (Key == NULL) {
       return FALSE;
     }
     Key->Size = sizeof(FLOAT64);
+    // Take the number text from the tree to convert on first access
     if ((Value != NULL) && (*Value != 0)) {
-      if (EFI_ERROR(StrToFloat(&Value, ADDRESS_OF(PLIST_KEY, Key, FLOAT64, Value.Real)))) {
+      if (EFI_ERROR(XmlTreeTakeValue(Tree, &(Key->Raw)))) {
         return FALSE;
       }
     }
-  } else if (StriCmp(TagName, L"integer") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagInteger]) {
     // Integer
     Key = PlistXmlAddKey(Parser, PlistTypeInteger);
     if (Key == NULL) {
       return FALSE;
     }
     Key->Size = sizeof(INT64);
+    // Take the number text from the tree to convert on first access
     if ((Value != NULL) && (*Value != 0)) {
-      if (EFI_ERROR(StrToInteger(&Value, ADDRESS_OF(PLIST_KEY, Key, INT64, Value.Integer), 10))) {
+      if (EFI_ERROR(XmlTreeTakeValue(Tree, &(Key->Raw)))) {
         return FALSE;
       }
     }
-  } else if (StriCmp(TagName, L"true") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagTrue]) {
     // Boolean true
     Key = PlistXmlAddKey(Parser, PlistTypeBoolean);
     if (Key == NULL) {
@@ -838,7 +1151,7 @@ PlistXmlInspector (
     }
     Key->Size = sizeof(BOOLEAN);
     Key->Value.Boolean = TRUE;
-  } else if (StriCmp(TagName, L"false") == 0) {
+  } else if (Tag == Parser->Tags[PlistTagFalse]) {
     // Boolean false
     Key = PlistXmlAddKey(Parser, PlistTypeBoolean);
     if (Key == NULL) {
@@ -911,424 +1224,424 @@ PlistParseFinish (
   return Status;
 }
 
-// PlistKeyToXml - forward declaration
-/// Convert a PLIST dictionary key to an XML string
-/// @param Key      The PLIST dictionary key
-/// @param Encoding The encoding for the XML string buffer
-/// @param Buffer   On output, the XML string buffer
-/// @param Size     On input, the available size in bytes of the data buffer, on output, the size in bytes of the XML string buffer
-/// @param Level    The level of indentation for the key
-/// @retval EFI_SUCCESS           The PLIST dictionary was converted to XML
-/// @retval EFI_BUFFER_TOO_SMALL  The buffer size was not enough and *Size has been updated with the needed size
-/// @retval EFI_INVALID_PARAMETER If Dictionary, Buffer, or Size is NULL
+// PlistWriteIndent
+/// Write the indentation of a PLIST element unless writing compact XML
+/// @param Writer  The writer of the XML document
+/// @param Level   The level of indentation of the element
+/// @param Compact Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The indentation was written
+/// @return Any other status returned by the writer output
+STATIC
+EFI_STATUS
+EFIAPI
+PlistWriteIndent (
+  IN OUT EFI_WRITER *Writer,
+  IN     UINTN       Level,
+  IN     BOOLEAN     Compact
+) {
+  return Compact ? EFI_SUCCESS : EfiWriterWriteFill(Writer, L' ', Level * 2);
+}
+// PlistWriteLineBreak
+/// Write the line break after a PLIST element unless writing compact XML
+/// @param Writer  The writer of the XML document
+/// @param Compact Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The line break was written
+/// @return Any other status returned by the writer output
 STATIC
 EFI_STATUS
 EFIAPI
-PlistKeyToXml (
+PlistWriteLineBreak (
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Compact
+) {
+  return Compact ? EFI_SUCCESS : EfiWriterWriteCharacter(Writer, L'\n');
+}
+// PlistWriteTag
+/// Write a PLIST element tag on its own line
+/// @param Writer  The writer of the XML document
+/// @param Tag     The element tag markup
+/// @param Level   The level of indentation of the element
+/// @param Compact Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The element tag was written
+/// @return Any other status returned by the writer output
+STATIC
+EFI_STATUS
+EFIAPI
+PlistWriteTag (
+  IN OUT EFI_WRITER  *Writer,
+  IN     CONST CHAR8 *Tag,
+  IN     UINTN        Level,
+  IN     BOOLEAN      Compact
+) {
+  EFI_STATUS Status = PlistWriteIndent(Writer, Level, Compact);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterWriteAscii(Writer, Tag);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = PlistWriteLineBreak(Writer, Compact);
+  }
+  return Status;
+}
+// PlistWriteText
+/// Write a PLIST element with escaped text content on its own line
+/// @param Writer  The writer of the XML document
+/// @param Start   The element start tag markup
+/// @param Text    The element text content to escape
+/// @param End     The element end tag markup
+/// @param Level   The level of indentation of the element
+/// @param Compact Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The element was written
+/// @return Any other status returned by the writer output
+STATIC
+EFI_STATUS
+EFIAPI
+PlistWriteText (
+  IN OUT EFI_WRITER   *Writer,
+  IN     CONST CHAR8  *Start,
+  IN     CONST CHAR16 *Text,
+  IN     CONST CHAR8  *End,
+  IN     UINTN         Level,
+  IN     BOOLEAN       Compact
+) {
+  EFI_STATUS Status = PlistWriteIndent(Writer, Level, Compact);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterWriteAscii(Writer, Start);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = XmlWriteEscaped(Writer, Text, FALSE);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterWriteAscii(Writer, End);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = PlistWriteLineBreak(Writer, Compact);
+  }
+  return Status;
+}
+
+// PlistKeyToWriter - forward declaration
+/// Write PLIST dictionary keys as XML
+/// @param Key            The first PLIST dictionary key
+/// @param Writer         The writer of the XML document
+/// @param FormatEncoding The encoding of the XML format specifier strings
+/// @param Level          The level of indentation for the keys
+/// @param Compact        Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The PLIST dictionary keys were written as XML
+/// @return Any other status returned by the writer output
+STATIC
+EFI_STATUS
+EFIAPI
+PlistKeyToWriter (
   IN     PLIST_KEY             *Key,
-  IN     EFI_ENCODING_PROTOCOL *Encoding,
-  OUT    VOID                  *Buffer,
-  IN OUT UINTN                 *Size,
-  IN     UINTN                  Level
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     UINTN                  Level,
+  IN     BOOLEAN                Compact
 );
 
-// PlistValueToXml
-/// Convert a PLIST dictionary value to an XML string
-/// @param Type      The PLIST dictionary key value type
-/// @param Value     The PLIST dictionary key value
-/// @param ValueSize The size in bytes of the PLIST dictionary key value
-/// @param Encoding  The encoding for the XML string buffer
-/// @param Buffer    On output, the XML string buffer
-/// @param Size      On input, the available size in bytes of the data buffer, on output, the size in bytes of the XML string buffer
-/// @param Level     The level of indentation for the key
-/// @retval EFI_SUCCESS           The PLIST dictionary was converted to XML
-/// @retval EFI_BUFFER_TOO_SMALL  The buffer size was not enough and *Size has been updated with the needed size
-/// @retval EFI_INVALID_PARAMETER If Dictionary, Buffer, or Size is NULL
+// PlistValueToWriter
+/// Write a PLIST dictionary value as XML
+/// @param Type           The PLIST dictionary key value type
+/// @param Value          The PLIST dictionary key value
+/// @param ValueSize      The size in bytes of the PLIST dictionary key value
+/// @param Raw            The PLIST dictionary key value text that has not been decoded or NULL, which is written unchanged
+/// @param Writer         The writer of the XML document
+/// @param FormatEncoding The encoding of the XML format specifier strings
+/// @param Level          The level of indentation for the value
+/// @param Compact        Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS           The PLIST dictionary value was written as XML
+/// @retval EFI_INVALID_PARAMETER If Value is NULL
+/// @return Any other status returned by the writer output
 STATIC
 EFI_STATUS
 EFIAPI
-PlistValueToXml (
+PlistValueToWriter (
   IN     PLIST_TYPE             Type,
   IN     PLIST_VALUE           *Value,
   IN     UINTN                  ValueSize,
-  IN     EFI_ENCODING_PROTOCOL *Encoding,
-  OUT    VOID                  *Buffer,
-  IN OUT UINTN                 *Size,
-  IN     UINTN                  Level
+  IN     CONST CHAR16          *Raw OPTIONAL,
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     UINTN                  Level,
+  IN     BOOLEAN                Compact
 ) {
-  STATIC CONST CHAR8 *DictHeaderFormat = "% *a<dict>\n";
-  STATIC CONST CHAR8 *DictFooterFormat = "% *a</dict>\n";
-  STATIC CONST CHAR8 *DictEmptyFormat = "% *a<dict />\n";
-  STATIC CONST CHAR8 *ArrayHeaderFormat = "% *a<array>\n";
-  STATIC CONST CHAR8 *ArrayFooterFormat = "% *a</array>\n";
-  STATIC CONST CHAR8 *ArrayEmptyFormat = "% *a<array />\n";
-  STATIC CONST CHAR8 *StringFormat = "% *a<string>%s</string>\n";
-  STATIC CONST CHAR8 *DataFormat = "% *a<data>%a</data>\n";
-  STATIC CONST CHAR8 *DateFormat = "% *a<date>%04.4u-%02.2u-%02.2uT%02.2u:%02.2u:%02.2uZ</date>\n";
-  STATIC CONST CHAR8 *DateEmptyFormat = "% *a<date>0000-00-00T00:00:00Z</date>\n";
-  STATIC CONST CHAR8 *RealFormat = "% *a<real>&f</real>\n";
-  STATIC CONST CHAR8 *UnsignedFormat = "% *a<integer>%u</integer>\n";
-  STATIC CONST CHAR8 *IntegerFormat = "% *a<integer>%d</integer>\n";
-  STATIC CONST CHAR8 *TrueFormat = "% *a<true />\n";
-  STATIC CONST CHAR8 *FalseFormat = "% *a<false />\n";
-  EFI_STATUS             Status = EFI_INVALID_PARAMETER;
-  EFI_ENCODING_PROTOCOL *FormatEncoding;
-  UINTN                  BufferSize = 0;
-  UINTN                  ThisSize;
+  STATIC CONST CHAR8 *DateFormat = "<date>%04.4u-%02.2u-%02.2uT%02.2u:%02.2u:%02.2uZ</date>";
+  STATIC CONST CHAR8 *RealFormat = "<real>%f</real>";
+  STATIC CONST CHAR8 *UnsignedFormat = "<integer>%u</integer>";
+  STATIC CONST CHAR8 *IntegerFormat = "<integer>%d</integer>";
+  EFI_STATUS Status = EFI_SUCCESS;
   // Check parameters
-  if ((Value == NULL) || (Size == NULL)) {
+  if (Value == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get ASCII encoding
-  FormatEncoding = EfiLatin1Encoding();
-  if (FormatEncoding == NULL) {
-    return EFI_UNSUPPORTED;
-  }
   // Determine type of value
-  ThisSize = *Size;
   switch (Type) {
     case PlistTypeDictionary:
       // Dictionary key type
       if (Value->Dictionary == NULL) {
         // Empty dictionary
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DictEmptyFormat, AsciiStrSize(DictEmptyFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        BufferSize += ThisSize;
-      } else {
-        // Dictionary has keys
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DictHeaderFormat, AsciiStrSize(DictHeaderFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        ThisSize -= Encoding->UnitSize;
-        BufferSize += ThisSize;
-        // Advance the buffer
-        if (Buffer != NULL) {
-          Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-        }
-        // Output the dictionary
-        if (BufferSize < *Size) {
-          ThisSize = *Size - BufferSize;
-        } else {
-          ThisSize = 0;
-        }
-        Status = PlistKeyToXml(Value->Dictionary, Encoding, Buffer, &ThisSize, Level + 1);
-        // Increase the buffer size
-        BufferSize += ThisSize;
-        // Advance the buffer
-        if (Buffer != NULL) {
-          Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-        }
-        // Close the dictionary
-        if (BufferSize < *Size) {
-          ThisSize = *Size - BufferSize;
-        } else {
-          ThisSize = 0;
-        }
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DictFooterFormat, AsciiStrSize(DictFooterFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        BufferSize += ThisSize;
+        return PlistWriteTag(Writer, "<dict />", Level, Compact);
       }
-      break;
+      // Dictionary has keys
+      Status = PlistWriteTag(Writer, "<dict>", Level, Compact);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      // Output the dictionary
+      Status = PlistKeyToWriter(Value->Dictionary, Writer, FormatEncoding, Level + 1, Compact);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      // Close the dictionary
+      return PlistWriteTag(Writer, "</dict>", Level, Compact);
 
-    case PlistTypeArray:
+    case PlistTypeArray: {
       // Array key type
+      PLIST_KEY *Array;
       if (Value->Dictionary == NULL) {
         // Empty array
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, ArrayEmptyFormat, AsciiStrSize(ArrayEmptyFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        BufferSize += ThisSize;
-      } else {
-        PLIST_KEY *Array;
-        // Array has values
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, ArrayHeaderFormat, AsciiStrSize(ArrayHeaderFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        ThisSize -= Encoding->UnitSize;
-        BufferSize += ThisSize;
-        // Advance the buffer
-        if (Buffer != NULL) {
-          Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-        }
-        // Increase the level indentation before the array values
-        ++Level;
-        // Output the array
-        for (Array = Value->Dictionary; Array != NULL; Array = Array->Next) {
-          if (BufferSize < *Size) {
-            ThisSize = *Size - BufferSize;
-          } else {
-            ThisSize = 0;
-          }
-          // Import each array value
-          Status = PlistValueToXml(Array->Type, &(Array->Value), Array->Size, Encoding, Buffer, &ThisSize, Level);
-          if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-            break;
-          }
-          // Increase the buffer size
-          BufferSize += ThisSize;
-          // Advance the buffer
-          if (Buffer != NULL) {
-            Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-          }
-        }
-        // Decrease the level indentation after the array values
-        --Level;
-        // Close the dictionary
-        if (BufferSize < *Size) {
-          ThisSize = *Size - BufferSize;
-        } else {
-          ThisSize = 0;
-        }
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, ArrayFooterFormat, AsciiStrSize(ArrayFooterFormat), Level * 2, "");
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+        return PlistWriteTag(Writer, "<array />", Level, Compact);
+      }
+      // Array has values
+      Status = PlistWriteTag(Writer, "<array>", Level, Compact);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      // Output the array values with increased indentation
+      for (Array = Value->Dictionary; Array != NULL; Array = Array->Next) {
+        Status = PlistValueToWriter(Array->Type, &(Array->Value), Array->Size, Array->Raw, Writer, FormatEncoding, Level + 1, Compact);
+        if (EFI_ERROR(Status)) {
           return Status;
         }
-        // Increase the buffer size
-        if (ThisSize < Encoding->UnitSize) {
-          return EFI_INVALID_PARAMETER;
-        }
-        BufferSize += ThisSize;
       }
-      break;
+      // Close the array
+      return PlistWriteTag(Writer, "</array>", Level, Compact);
+    }
 
     case PlistTypeString:
       // String key type
-      Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, StringFormat, AsciiStrSize(StringFormat), Level * 2, "", Value->String);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        return Status;
-      }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
-      }
-      BufferSize += ThisSize;
-      break;
+      return PlistWriteText(Writer, "<string>", Value->String, "</string>", Level, Compact);
+
+    case PlistTypeBoolean:
+      // Boolean key type
+      return PlistWriteTag(Writer, Value->Boolean ? "<true />" : "<false />", Level, Compact);
 
     case PlistTypeDate:
       // Date key type
-      // Print the date and time according to ISO 8601
-      if (Value->Date != NULL) {
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DateFormat, AsciiStrSize(DateFormat), Level * 2, "",
-                                 Value->Date->Year, Value->Date->Month, Value->Date->Day, Value->Date->Hour, Value->Date->Minute, Value->Date->Second);
-      } else {
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DateEmptyFormat, AsciiStrSize(DateEmptyFormat), Level * 2, "");
+      if (Raw != NULL) {
+        return PlistWriteText(Writer, "<date>", Raw, "</date>", Level, Compact);
       }
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      // Print the date and time according to ISO 8601
+      Status = PlistWriteIndent(Writer, Level, Compact);
+      if (EFI_ERROR(Status)) {
         return Status;
       }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
+      if (Value->Date != NULL) {
+        Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, DateFormat, AsciiStrSize(DateFormat),
+                                         Value->Date->Year, Value->Date->Month, Value->Date->Day, Value->Date->Hour, Value->Date->Minute, Value->Date->Second);
+      } else {
+        Status = EfiWriterWriteAscii(Writer, "<date>0000-00-00T00:00:00Z</date>");
       }
-      BufferSize += ThisSize;
       break;
 
     case PlistTypeData: {
       // Data key type
-      CHAR8 *Data = NULL;
-      // Convert the data to base 64 encoded string
-      BufferSize = 0;
-      Base64EncodeBuffer(EfiLatin1Encoding(), Value->Data, ValueSize, &Data, &BufferSize);
-      // Print the base 64 encoded data string
-      ThisSize = *Size;
-      Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, DataFormat, AsciiStrSize(DataFormat), Level * 2, "", (Data != NULL) ? Data : "");
-      if (Data != NULL) {
-        EfiFreePool(Data);
-        Data = NULL;
+      BASE64_CONTEXT Context;
+      UINT8          Chunk[PLIST_DATA_CHUNK_SIZE];
+      UINTN          Offset;
+      UINTN          ThisSize;
+      UINTN          ChunkSize;
+      if (Raw != NULL) {
+        return PlistWriteText(Writer, "<data>", Raw, "</data>", Level, Compact);
+      }
+      Status = PlistWriteIndent(Writer, Level, Compact);
+      if (!EFI_ERROR(Status)) {
+        Status = EfiWriterWriteAscii(Writer, "<data>");
       }
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      if (EFI_ERROR(Status)) {
         return Status;
       }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
+      // Encode the data to base 64 in chunks through the writer
+      Base64EncodeInit(&Context);
+      for (Offset = 0; (Value->Data != NULL) && (Offset < ValueSize); Offset += ThisSize) {
+        ThisSize = ValueSize - Offset;
+        if (ThisSize > ((sizeof(Chunk) / (4 * Writer->Encoding->UnitSize)) * 3)) {
+          ThisSize = (sizeof(Chunk) / (4 * Writer->Encoding->UnitSize)) * 3;
+        }
+        ChunkSize = sizeof(Chunk);
+        Status = Base64EncodeUpdate(&Context, Writer->Encoding, ADDRESS_OFFSET(UINT8, Value->Data, Offset), ThisSize, Chunk, &ChunkSize);
+        if (!EFI_ERROR(Status)) {
+          Status = EfiWriterWriteSpan(Writer, Chunk, ChunkSize);
+        }
+        if (EFI_ERROR(Status)) {
+          return Status;
+        }
       }
-      BufferSize += ThisSize;
+      ChunkSize = sizeof(Chunk);
+      Status = Base64EncodeFinal(&Context, Writer->Encoding, Chunk, &ChunkSize);
+      if (!EFI_ERROR(Status)) {
+        Status = EfiWriterWriteSpan(Writer, Chunk, ChunkSize);
+      }
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      // Close the data
+      Status = EfiWriterWriteAscii(Writer, "</data>");
       break;
     }
 
     case PlistTypeReal:
       // Real key type
-      Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, RealFormat, AsciiStrSize(RealFormat), Level * 2, "", Value->Real);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        return Status;
+      if (Raw != NULL) {
+        return PlistWriteText(Writer, "<real>", Raw, "</real>", Level, Compact);
       }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
+      Status = PlistWriteIndent(Writer, Level, Compact);
+      if (!EFI_ERROR(Status)) {
+        Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, RealFormat, AsciiStrSize(RealFormat), Value->Real);
       }
-      BufferSize += ThisSize;
       break;
 
     case PlistTypeUnsigned:
       // Unsigned key type
-      Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, UnsignedFormat, AsciiStrSize(UnsignedFormat), Level * 2, "", Value->Unsigned);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        return Status;
-      }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
+      Status = PlistWriteIndent(Writer, Level, Compact);
+      if (!EFI_ERROR(Status)) {
+        Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, UnsignedFormat, AsciiStrSize(UnsignedFormat), Value->Unsigned);
       }
-      BufferSize += ThisSize;
       break;
 
     case PlistTypeInteger:
       // Integer key type
-      Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, IntegerFormat, AsciiStrSize(IntegerFormat), Level * 2, "", Value->Integer);
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        return Status;
-      }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
-      }
-      BufferSize += ThisSize;
-      break;
-
-    case PlistTypeBoolean:
-      // Boolean key type
-      if (Value->Boolean) {
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, TrueFormat, AsciiStrSize(TrueFormat), Level * 2, "");
-      } else {
-        Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, FalseFormat, AsciiStrSize(FalseFormat), Level * 2, "");
+      if (Raw != NULL) {
+        return PlistWriteText(Writer, "<integer>", Raw, "</integer>", Level, Compact);
       }
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-        return Status;
-      }
-      // Increase the buffer size
-      if (ThisSize < Encoding->UnitSize) {
-        return EFI_INVALID_PARAMETER;
+      Status = PlistWriteIndent(Writer, Level, Compact);
+      if (!EFI_ERROR(Status)) {
+        Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, IntegerFormat, AsciiStrSize(IntegerFormat), Value->Integer);
       }
-      BufferSize += ThisSize;
       break;
 
     default:
       // Unusable or unknown type so just skip
-      break;
+      return EFI_SUCCESS;
   }
-  // Set and return size
-  BufferSize -= Encoding->UnitSize;
-  *Size = BufferSize;
-  return Status;
+  // End the line of a formatted value
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  return PlistWriteLineBreak(Writer, Compact);
 }
-// PlistKeyToXml
-/// Convert a PLIST dictionary key to an XML string
-/// @param Key      The PLIST dictionary key
-/// @param Encoding The encoding for the XML string buffer
-/// @param Buffer   On output, the XML string buffer
-/// @param Size     On input, the available size in bytes of the data buffer, on output, the size in bytes of the XML string buffer
-/// @param Level    The level of indentation for the key
-/// @retval EFI_SUCCESS           The PLIST dictionary was converted to XML
-/// @retval EFI_BUFFER_TOO_SMALL  The buffer size was not enough and *Size has been updated with the needed size
-/// @retval EFI_INVALID_PARAMETER If Key or Size is NULL
+// PlistKeyToWriter
+/// Write PLIST dictionary keys as XML
+/// @param Key            The first PLIST dictionary key
+/// @param Writer         The writer of the XML document
+/// @param FormatEncoding The encoding of the XML format specifier strings
+/// @param Level          The level of indentation for the keys
+/// @param Compact        Whether the XML is compact without indentation and line breaks
+/// @retval EFI_SUCCESS The PLIST dictionary keys were written as XML
+/// @return Any other status returned by the writer output
 STATIC
 EFI_STATUS
 EFIAPI
-PlistKeyToXml (
+PlistKeyToWriter (
   IN     PLIST_KEY             *Key,
-  IN     EFI_ENCODING_PROTOCOL *Encoding,
-  OUT    VOID                  *Buffer OPTIONAL,
-  IN OUT UINTN                 *Size,
-  IN     UINTN                  Level
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     UINTN                  Level,
+  IN     BOOLEAN                Compact
 ) {
-  STATIC CONST CHAR8 *NameFormat = "% *a<key>%s<key>\n";
-  EFI_STATUS Status = EFI_SUCCESS;
-  UINTN      BufferSize = 0;
-  UINTN      RemainingSize;
-  UINTN      ThisSize;
+  EFI_STATUS Status;
+  // Write each key of the dictionary in order
+  for (; Key != NULL; Key = Key->Next) {
+    // Write the key name element
+    if (Key->Name != NULL) {
+      Status = PlistWriteText(Writer, "<key>", Key->Name, "</key>", Level, Compact);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+    }
+    // Write the key value
+    Status = PlistValueToWriter(Key->Type, &(Key->Value), Key->Size, Key->Raw, Writer, FormatEncoding, Level, Compact);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// PlistToWriter
+/// Write a PLIST dictionary as an XML document
+/// @param Dictionary The PLIST dictionary
+/// @param Writer     The writer of the XML document, the XML is in the encoding of the writer
+/// @param Compact    Whether to write compact XML without indentation and line breaks or to pretty print the XML
+/// @retval EFI_SUCCESS           The PLIST dictionary was written as XML, the writer may still have buffered output
+/// @retval EFI_INVALID_PARAMETER If Dictionary or Writer is NULL or Writer is not initialized
+/// @retval EFI_UNSUPPORTED       The format encoding could not be found
+/// @return Any other status returned by the writer output
+EFI_STATUS
+EFIAPI
+PlistToWriter (
+  IN     PLIST_KEY  *Dictionary,
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Compact
+) {
+  STATIC CONST CHAR8 *HeaderFormat = "<?xml version=\"1.0\" encoding=\"%a\" ?>";
+  EFI_STATUS             Status;
+  EFI_ENCODING_PROTOCOL *FormatEncoding;
   // Check parameters
-  if ((Key == NULL) || (Size == NULL)) {
+  if ((Dictionary == NULL) || (Writer == NULL) || (Writer->Encoding == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the size of the buffer
-  RemainingSize = *Size;
-  ThisSize = RemainingSize;
-  // Print the key name element to the XML buffer
-  if (Key->Name != NULL) {
-    ThisSize = RemainingSize;
-    Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, EfiLatin1Encoding(), NameFormat, AsciiStrSize(NameFormat), Level * 2, "", Key->Name);
-    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-      return Status;
-    }
-    // Increase the buffer size
-    if (ThisSize < Encoding->UnitSize) {
-      return EFI_INVALID_PARAMETER;
-    }
-    ThisSize -= Encoding->UnitSize;
-    if (ThisSize < RemainingSize) {
-      RemainingSize -= ThisSize;
-    } else {
-      RemainingSize = 0;
-    }
-    BufferSize += ThisSize;
-    // Advance the buffer
-    if (Buffer != NULL) {
-      Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-    }
-    ThisSize = RemainingSize;
+  // Get the format encoding
+  FormatEncoding = EfiLatin1Encoding();
+  if (FormatEncoding == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  // Create the XML document tag
+  Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, HeaderFormat, AsciiStrSize(HeaderFormat), Writer->Encoding->Name);
+  if (!EFI_ERROR(Status)) {
+    Status = PlistWriteLineBreak(Writer, Compact);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = PlistWriteTag(Writer, "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">", 0, Compact);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = PlistWriteTag(Writer, "<plist version=\"1.0\">", 0, Compact);
   }
-  // Convert the PLIST key value to XML string
-  Status = PlistValueToXml(Key->Type, &(Key->Value), Key->Size, Encoding, Buffer, &ThisSize, Level);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (ThisSize < Encoding->UnitSize) {
-    return EFI_INVALID_PARAMETER;
+  // Convert the PLIST keys to XML
+  Status = PlistKeyToWriter(Dictionary, Writer, FormatEncoding, 0, Compact);
+  if (EFI_ERROR(Status)) {
+    return Status;
   }
-  // Convert the next PLIST key
-  if (Key->Next != NULL) {
-    // Increase the buffer size
-    BufferSize += ThisSize;
-    if (ThisSize < RemainingSize) {
-      RemainingSize -= ThisSize;
-    } else {
-      RemainingSize = 0;
-    }
-    // Advance the buffer
-    if (Buffer != NULL) {
-      Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-    }
-    // Convert the next PLIST key to XML string
-    ThisSize = RemainingSize;
-    Status = PlistKeyToXml(Key->Next, Encoding, Buffer, &ThisSize, Level);
-    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-      return Status;
-    }
-    if (ThisSize < Encoding->UnitSize) {
-      return EFI_INVALID_PARAMETER;
-    }
+  // Close the document
+  return PlistWriteTag(Writer, "</plist>", 0, Compact);
+}
+// PlistToBuilder
+/// Append a PLIST dictionary as a pretty printed XML document to a string builder
+/// @param Dictionary The PLIST dictionary
+/// @param Builder    The string builder for the XML string
+/// @retval EFI_SUCCESS           The PLIST dictionary was appended as XML
+/// @retval EFI_UNSUPPORTED       The format encoding could not be found
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the XML string
+STATIC
+EFI_STATUS
+EFIAPI
+PlistToBuilder (
+  IN     PLIST_KEY          *Dictionary,
+  IN OUT EFI_STRING_BUILDER *Builder
+) {
+  EFI_STATUS Status;
+  EFI_WRITER Writer;
+  // Write the XML through a writer that appends to the string builder
+  Status = EfiWriterInitializeBuilder(&Writer, Builder);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = PlistToWriter(Dictionary, &Writer, FALSE);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterFlush(&Writer);
   }
-  BufferSize += ThisSize;
-  // Return buffer size and status
-  *Size = BufferSize;
   return Status;
 }
 // PlistToXml
@@ -1348,77 +1661,30 @@ PlistToXml (
   IN OUT VOID                  *Buffer OPTIONAL,
   IN OUT UINTN                 *Size
 ) {
-  STATIC CONST CHAR8 *HeaderFormat = "<?xml version=\"1.0\" encoding=\"%a\" ?>\n"
-                                     "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
-                                     "<plist version=\"1.0\">\n";
-  STATIC CONST CHAR8 *FooterFormat = "</plist>\n";
-  EFI_STATUS             Status;
-  EFI_ENCODING_PROTOCOL *FormatEncoding;
-  UINTN                  BufferSize = 0;
-  UINTN                  RemainingSize;
-  UINTN                  ThisSize;
+  EFI_STATUS         Status;
+  EFI_STRING_BUILDER Builder;
+  UINTN              XmlSize;
   // Check parameters
   if ((Dictionary == NULL) || (Size == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Encoding == NULL) {
-    Encoding = EfiUtf16Encoding();
-    if (Encoding == NULL) {
-      return EFI_UNSUPPORTED;
-    }
-  }
-  // Get the format encoding
-  FormatEncoding = EfiLatin1Encoding();
-  // Create the XML document tag
-  RemainingSize = *Size;
-  ThisSize = RemainingSize;
-  Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, HeaderFormat, AsciiStrSize(HeaderFormat), Encoding->Name);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-    return Status;
-  }
-  // Increase the buffer size
-  if (ThisSize < Encoding->UnitSize) {
-    return EFI_INVALID_PARAMETER;
-  }
-  ThisSize -= Encoding->UnitSize;
-  if (ThisSize < RemainingSize) {
-    RemainingSize -= ThisSize;
-  } else {
-    RemainingSize = 0;
-  }
-  BufferSize += ThisSize;
-  // Advance the buffer
-  if (Buffer != NULL) {
-    Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-  }
-  // Convert the PLIST keys to XML
-  ThisSize = RemainingSize;
-  Status = PlistKeyToXml(Dictionary, Encoding, Buffer, &ThisSize, 0);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-    return Status;
-  }
-  if (ThisSize < RemainingSize) {
-    RemainingSize -= ThisSize;
-  } else {
-    RemainingSize = 0;
-  }
-  BufferSize += ThisSize;
-  // Advance the buffer
-  if (Buffer != NULL) {
-    Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-  }
-  // Close the document
-  ThisSize = RemainingSize;
-  Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, FooterFormat, AsciiStrSize(FooterFormat));
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  // Build the XML string once and copy it if it fits
+  Status = EfiStringBuilderInitialize(&Builder, Encoding, NULL, 0);
+  if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (ThisSize < Encoding->UnitSize) {
-    return EFI_INVALID_PARAMETER;
+  Status = PlistToBuilder(Dictionary, &Builder);
+  if (!EFI_ERROR(Status)) {
+    XmlSize = Builder.Size + Builder.Encoding->UnitSize;
+    if ((Buffer == NULL) || (*Size < XmlSize)) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    } else {
+      EfiCopyMem(Buffer, Builder.Buffer, XmlSize);
+    }
+    // Return the size
+    *Size = XmlSize;
   }
-  BufferSize += ThisSize;
-  // Return the size and status
-  *Size = BufferSize;
+  EfiStringBuilderFree(&Builder);
   return Status;
 }
 // PlistToXmlBuffer
@@ -1437,42 +1703,22 @@ PlistToXmlBuffer (
   OUT VOID                  **Buffer,
   OUT UINTN                  *Size OPTIONAL
 ) {
-  EFI_STATUS  Status;
-  UINTN       XmlSize = 0;
-  VOID       *Xml = NULL;
+  EFI_STATUS         Status;
+  EFI_STRING_BUILDER Builder;
   // Check parameters
   if ((Dictionary == NULL) || (Buffer == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Encoding == NULL) {
-    Encoding = EfiUtf16Encoding();
-    if (Encoding == NULL) {
-      return EFI_UNSUPPORTED;
-    }
-  }
-  // Get the size needed for the XML string buffer
-  Status = PlistToXml(Dictionary, Encoding, NULL, &XmlSize);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  // Build the XML string in a single pass and take its buffer
+  Status = EfiStringBuilderInitialize(&Builder, Encoding, NULL, 0);
+  if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (XmlSize == 0) {
-    return EFI_NOT_FOUND;
-  }
-  // Allocate the XML string buffer
-  Xml = EfiAllocate(XmlSize);
-  if (Xml == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  // Convert the PLIST dictionary to XML string
-  Status = PlistToXml(Dictionary, Encoding, Xml, &XmlSize);
-  if (EFI_ERROR(Status)) {
-    EfiFreePool(Xml);
-  } else {
-    *Buffer = Xml;
-    if (Size != NULL) {
-      *Size = XmlSize;
-    }
+  Status = PlistToBuilder(Dictionary, &Builder);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiStringBuilderSteal(&Builder, Buffer, Size);
   }
+  EfiStringBuilderFree(&Builder);
   return Status;
 }
 
@@ -1635,29 +1881,24 @@ PlistSave (
   IN EFI_FILE_PROTOCOL     *Root,
   IN CONST CHAR16          *Path OPTIONAL
 ) {
-  EFI_STATUS         Status;
-  VOID              *Buffer = NULL;
-  UINTN              Size = 0;
+  EFI_STATUS Status;
+  EFI_STATUS CloseStatus;
+  EFI_WRITER Writer;
   // Check parameters
   if ((Dictionary == NULL) || (Root == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Convert the PLIST dictionary to XML buffer
-  Status = PlistToXmlBuffer(Dictionary, Encoding, &Buffer, &Size);
+  // Stream the PLIST dictionary as XML to the file through the fixed writer buffer
+  Status = EfiWriterInitializeFile(&Writer, Encoding, Root, Path);
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (Buffer == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  if (Size == 0) {
-    EfiFreePool(Buffer);
-    return EFI_OUT_OF_RESOURCES;
+  Status = PlistToWriter(Dictionary, &Writer, FALSE);
+  // Write the rest of the XML unless there was an error and close the file
+  CloseStatus = EfiWriterClose(&Writer, EFI_ERROR(Status));
+  if (!EFI_ERROR(Status)) {
+    Status = CloseStatus;
   }
-  // Save the PLIST dictionary to file
-  Status = EfiFileSave(Root, Path, Size, Buffer);
-  // Free the buffer and return the result
-  EfiFreePool(Buffer);
   return Status;
 }
 // PlistSavePath
@@ -460,6 +460,79 @@ SvgParseXml (
   return Status;
 }
 
+// SvgToWriter
+/// Write a SVG image as an XML document
+/// @param Image   The SVG image
+/// @param Writer  The writer of the XML document, the XML is in the encoding of the writer
+/// @param Compact Whether to write compact XML without indentation and line breaks or to pretty print the XML
+/// @retval EFI_SUCCESS           The SVG image was written as XML, the writer may still have buffered output
+/// @retval EFI_INVALID_PARAMETER If Image or Writer is NULL or Writer is not initialized
+/// @retval EFI_UNSUPPORTED       The SVG image elements can not be converted yet
+/// @return Any other status returned by the writer output
+EFI_STATUS
+EFIAPI
+SvgToWriter (
+  IN     SVG_IMAGE  *Image,
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Compact
+) {
+  STATIC CONST CHAR8 *HeaderFormat = "<?xml version=\"1.0\" encoding=\"%a\" ?>";
+  STATIC CONST CHAR8 *DocType = "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">";
+  EFI_STATUS             Status;
+  EFI_ENCODING_PROTOCOL *FormatEncoding;
+  // Check parameters
+  if ((Image == NULL) || (Writer == NULL) || (Writer->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the format encoding
+  FormatEncoding = EfiLatin1Encoding();
+  if (FormatEncoding == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  // Create the XML document tag
+  Status = EfiWriterWriteFormatted(Writer, NULL, FormatEncoding, HeaderFormat, AsciiStrSize(HeaderFormat), Writer->Encoding->Name);
+  if (!EFI_ERROR(Status) && !Compact) {
+    Status = EfiWriterWriteCharacter(Writer, L'\n');
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterWriteAscii(Writer, DocType);
+  }
+  if (!EFI_ERROR(Status) && !Compact) {
+    Status = EfiWriterWriteCharacter(Writer, L'\n');
+  }
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Convert the SVG image elements to XML
+  return EFI_UNSUPPORTED; // TODO: Write the SVG image elements
+}
+// SvgToBuilder
+/// Append a SVG image as a pretty printed XML document to a string builder
+/// @param Image   The SVG image
+/// @param Builder The string builder for the XML string
+/// @retval EFI_SUCCESS           The SVG image was appended as XML
+/// @retval EFI_UNSUPPORTED       The SVG image elements can not be converted yet
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the XML string
+STATIC
+EFI_STATUS
+EFIAPI
+SvgToBuilder (
+  IN     SVG_IMAGE          *Image,
+  IN OUT EFI_STRING_BUILDER *Builder
+) {
+  EFI_STATUS Status;
+  EFI_WRITER Writer;
+  // Write the XML through a writer that appends to the string builder
+  Status = EfiWriterInitializeBuilder(&Writer, Builder);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = SvgToWriter(Image, &Writer, FALSE);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiWriterFlush(&Writer);
+  }
+  return Status;
+}
 // SvgToXml
 /// Convert a SVG image to an XML string
 /// @param Image The SVG image
@@ -477,61 +550,30 @@ SvgToXml (
   IN OUT VOID                  *Buffer OPTIONAL,
   IN OUT UINTN                 *Size
 ) {
-  STATIC CONST CHAR8 *HeaderFormat = "<?xml version=\"1.0\" encoding=\"%a\" ?>\n"
-                                     "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
-  EFI_STATUS             Status;
-  EFI_ENCODING_PROTOCOL *FormatEncoding;
-  UINTN                  BufferSize = 0;
-  UINTN                  RemainingSize;
-  UINTN                  ThisSize;
+  EFI_STATUS         Status;
+  EFI_STRING_BUILDER Builder;
+  UINTN              XmlSize;
   // Check parameters
   if ((Image == NULL) || (Size == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Encoding == NULL) {
-    Encoding = EfiUtf16Encoding();
-    if (Encoding == NULL) {
-      return EFI_UNSUPPORTED;
-    }
-  }
-  // Get the format encoding
-  FormatEncoding = EfiLatin1Encoding();
-  // Create the XML document tag
-  RemainingSize = *Size;
-  ThisSize = RemainingSize;
-  Status = EfiLocaleSPrint(NULL, Encoding, Buffer, &ThisSize, FormatEncoding, HeaderFormat, AsciiStrSize(HeaderFormat), Encoding->Name);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-    return Status;
-  }
-  // Increase the buffer size
-  if (ThisSize < Encoding->UnitSize) {
-    return EFI_INVALID_PARAMETER;
-  }
-  ThisSize -= Encoding->UnitSize;
-  if (ThisSize < RemainingSize) {
-    RemainingSize -= ThisSize;
-  } else {
-    RemainingSize = 0;
-  }
-  BufferSize += ThisSize;
-  // Advance the buffer
-  if (Buffer != NULL) {
-    Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-  }
-  // Convert the SVG images to XML
-  ThisSize = RemainingSize;
-  Status = EFI_UNSUPPORTED; // TODO: SvgToXml(Image, Encoding, Buffer, &ThisSize, 0);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  // Build the XML string once and copy it if it fits
+  Status = EfiStringBuilderInitialize(&Builder, Encoding, NULL, 0);
+  if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (ThisSize < RemainingSize) {
-    RemainingSize -= ThisSize;
-  } else {
-    RemainingSize = 0;
+  Status = SvgToBuilder(Image, &Builder);
+  if (!EFI_ERROR(Status)) {
+    XmlSize = Builder.Size + Builder.Encoding->UnitSize;
+    if ((Buffer == NULL) || (*Size < XmlSize)) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    } else {
+      EfiCopyMem(Buffer, Builder.Buffer, XmlSize);
+    }
+    // Return the size
+    *Size = XmlSize;
   }
-  BufferSize += ThisSize;
-  // Return the size and status
-  *Size = BufferSize;
+  EfiStringBuilderFree(&Builder);
   return Status;
 }
 // SvgToXmlBuffer
@@ -550,42 +592,22 @@ SvgToXmlBuffer (
   OUT VOID                  **Buffer,
   OUT UINTN                  *Size OPTIONAL
 ) {
-  EFI_STATUS  Status;
-  UINTN       XmlSize = 0;
-  VOID       *Xml = NULL;
+  EFI_STATUS         Status;
+  EFI_STRING_BUILDER Builder;
   // Check parameters
   if ((Image == NULL) || (Buffer == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Encoding == NULL) {
-    Encoding = EfiUtf16Encoding();
-    if (Encoding == NULL) {
-      return EFI_UNSUPPORTED;
-    }
-  }
-  // Get the size needed for the XML string buffer
-  Status = SvgToXml(Image, Encoding, NULL, &XmlSize);
-  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  // Build the XML string in a single pass and take its buffer
+  Status = EfiStringBuilderInitialize(&Builder, Encoding, NULL, 0);
+  if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (XmlSize == 0) {
-    return EFI_NOT_FOUND;
-  }
-  // Allocate the XML string buffer
-  Xml = EfiAllocate(XmlSize);
-  if (Xml == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  // Convert the SVG image to XML string
-  Status = SvgToXml(Image, Encoding, Xml, &XmlSize);
-  if (EFI_ERROR(Status)) {
-    EfiFreePool(Xml);
-  } else {
-    *Buffer = Xml;
-    if (Size != NULL) {
-      *Size = XmlSize;
-    }
+  Status = SvgToBuilder(Image, &Builder);
+  if (!EFI_ERROR(Status)) {
+    Status = EfiStringBuilderSteal(&Builder, Buffer, Size);
   }
+  EfiStringBuilderFree(&Builder);
   return Status;
 }
 
@@ -884,29 +906,24 @@ SvgSave (
   IN EFI_FILE_PROTOCOL     *Root,
   IN CONST CHAR16          *Path OPTIONAL
 ) {
-  EFI_STATUS         Status;
-  VOID              *Buffer = NULL;
-  UINTN              Size = 0;
+  EFI_STATUS Status;
+  EFI_STATUS CloseStatus;
+  EFI_WRITER Writer;
   // Check parameters
   if ((Image == NULL) || (Root == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Convert the SVG image to XML buffer
-  Status = SvgToXmlBuffer(Image, Encoding, &Buffer, &Size);
+  // Stream the SVG image as XML to the file through the fixed writer buffer
+  Status = EfiWriterInitializeFile(&Writer, Encoding, Root, Path);
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  if (Buffer == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  if (Size == 0) {
-    EfiFreePool(Buffer);
-    return EFI_OUT_OF_RESOURCES;
+  Status = SvgToWriter(Image, &Writer, FALSE);
+  // Write the rest of the XML unless there was an error and close the file
+  CloseStatus = EfiWriterClose(&Writer, EFI_ERROR(Status));
+  if (!EFI_ERROR(Status)) {
+    Status = CloseStatus;
   }
-  // Save the SVG image to file
-  Status = EfiFileSave(Root, Path, Size, Buffer);
-  // Free the buffer and return the result
-  EfiFreePool(Buffer);
   return Status;
 }
 // SvgSavePath
@@ -7,29 +7,45 @@
 #include "XmlStates.h"
 
 // XmlAttributeDuplicateMembers
+/// Duplicate XML document tree node attribute members, the destination is left unchanged on failure
 /// @param Destination The destination XML document tree node attribute
-/// @param Source      The source XML document tree node attribute
+/// @param Source      The source XML document tree node attribute or NULL to clear the destination
+/// @return Whether the XML document tree node attribute members were duplicated or not
+/// @retval EFI_INVALID_PARAMETER If Destination is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the name could not be interned or the value could not be duplicated
+/// @retval EFI_SUCCESS           If the XML document tree node attribute members were duplicated successfully
 STATIC
-VOID
+EFI_STATUS
 EFIAPI
 XmlAttributeDuplicateMembers (
   IN XML_ATTRIBUTE *Destination,
   IN XML_ATTRIBUTE *Source
 ) {
-  if (Destination != NULL) {
-    if (Destination->Name != NULL) {
-      EfiFreePool(Destination->Name);
-      Destination->Name = NULL;
-    }
-    if (Destination->Value != NULL) {
-      EfiFreePool(Destination->Value);
-      Destination->Value = NULL;
+  CONST CHAR16 *Name = NULL;
+  CHAR16       *Value = NULL;
+  // Check parameters
+  if (Destination == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Intern the name and duplicate the value before replacing the members
+  if (Source != NULL) {
+    Name = StrIntern(Source->Name, 0);
+    if (Name == NULL) {
+      return EFI_OUT_OF_RESOURCES;
     }
-    if (Source != NULL) {
-      Destination->Name = StrDup(Source->Name);
-      Destination->Value = StrDup(Source->Value);
+    if (Source->Value != NULL) {
+      Value = StrDup(Source->Value);
+      if (Value == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
     }
   }
+  if (Destination->Value != NULL) {
+    EfiFreePool(Destination->Value);
+  }
+  Destination->Name = (CHAR16 *)Name;
+  Destination->Value = Value;
+  return EFI_SUCCESS;
 }
 // XmlAttributeFreeMembers
 /// Free XML document tree node attribute
@@ -41,10 +57,7 @@ XmlAttributeFreeMembers (
   IN XML_ATTRIBUTE *Attribute
 ) {
   if (Attribute != NULL) {
-    if (Attribute->Name != NULL) {
-      EfiFreePool(Attribute->Name);
-      Attribute->Name = NULL;
-    }
+    Attribute->Name = NULL;
     if (Attribute->Value != NULL) {
       EfiFreePool(Attribute->Value);
       Attribute->Value = NULL;
@@ -90,10 +103,7 @@ XmlTreeFree (
   IN XML_TREE *Tree
 ) {
   if (Tree != NULL) {
-    if (Tree->Name != NULL) {
-      EfiFreePool(Tree->Name);
-      Tree->Name = NULL;
-    }
+    Tree->Name = NULL;
     if (Tree->Value != NULL) {
       EfiFreePool(Tree->Value);
       Tree->Value = NULL;
@@ -495,6 +505,8 @@ XmlDetectEncoding (
   IN     VOID        *Buffer,
   IN     UINTN        Size
 ) {
+  EFI_ENCODING_PROTOCOL *Encoding = NULL;
+  UINTN                  Confidence = 0;
   // Check parameters
   if ((Parser == NULL) || (Buffer == NULL) || (Size <= sizeof(UINT32))) {
     return EFI_INVALID_PARAMETER;
@@ -587,8 +599,11 @@ XmlDetectEncoding (
       break;
 
     default:
-      // Unknown so assume UTF-8 unless the document specifies otherwise
-      Parser->Encoding = EfiUtf8Encoding();
+      // Unknown so detect the encoding from the content or the declaration, otherwise assume UTF-8
+      if (EFI_ERROR(EfiEncodingDetect(Buffer, Size, &Encoding, &Confidence)) || (Confidence < EFI_ENCODING_CONFIDENCE_MEDIUM)) {
+        Encoding = EfiUtf8Encoding();
+      }
+      Parser->Encoding = Encoding;
       break;
   }
   return (Parser->Encoding == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
@@ -998,7 +1013,7 @@ XmlDocumentGetTree (
 // XmlTreeGetTag
 /// Get XML document tree node tag name
 /// @param Tree An XML document tree
-/// @param Tag  On output, the XML document tree tag name
+/// @param Tag  On output, the XML document tree tag name, which is interned and shared so it must not be freed or modified
 /// @return Whether the XML document tree tag name was retrieved or not
 /// @retval EFI_INVALID_PARAMETER If Tree or Tag is NULL
 /// @retval EFI_SUCCESS           If the XML document tree tag name was retrieved successfully
@@ -1021,6 +1036,7 @@ XmlTreeGetTag (
 /// @param Tag  The XML document tree tag name to set
 /// @return Whether the XML document tree tag name was set or not
 /// @retval EFI_INVALID_PARAMETER If Tree or Tag is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the XML document tree tag name could not be interned
 /// @retval EFI_SUCCESS           If the XML document tree tag name was set successfully
 EFI_STATUS
 EFIAPI
@@ -1032,11 +1048,8 @@ XmlTreeSetTag (
   if ((Tree == NULL) || (Tag == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Tree->Name != NULL) {
-    EfiFreePool(Tree->Name);
-  }
-  Tree->Name = StrDup(Tag);
-  return EFI_SUCCESS;
+  Tree->Name = (CHAR16 *)StrIntern(Tag, 0);
+  return (Tree->Name == NULL) ? EFI_OUT_OF_RESOURCES : EFI_SUCCESS;
 }
 // XmlTreeGetValue
 /// Get XML document tree node value
@@ -1081,6 +1094,27 @@ XmlTreeSetValue (
   Tree->Value = StrDup(Value);
   return EFI_SUCCESS;
 }
+// XmlTreeTakeValue
+/// Take the XML document tree node value, leaving the tree node without a value
+/// @param Tree  An XML document tree
+/// @param Value On output, the XML document tree node value, which must be freed, or NULL if there is no value
+/// @return Whether the XML document tree node value was taken or not
+/// @retval EFI_INVALID_PARAMETER If Tree or Value is NULL
+/// @retval EFI_SUCCESS           If the XML document tree node value was taken successfully
+EFI_STATUS
+EFIAPI
+XmlTreeTakeValue (
+  IN OUT XML_TREE  *Tree,
+  OUT    CHAR16   **Value
+) {
+  // Check parameters
+  if ((Tree == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  *Value = Tree->Value;
+  Tree->Value = NULL;
+  return EFI_SUCCESS;
+}
 // XmlTreeHasChildren
 /// Check if XML document tree node has child nodes
 /// @param Tree An XML document tree node
@@ -1210,14 +1244,20 @@ XmlTreeGetAttribute (
   IN  CHAR16         *Name,
   OUT XML_ATTRIBUTE **Attribute
 ) {
-  XML_LIST *List;
+  CONST CHAR16 *Interned;
+  XML_LIST     *List;
   // Check parameters
   if ((Tree == NULL) || (Name == NULL) || (Attribute == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
+  // Attribute names are interned so a name that was never interned can not match
+  Interned = StrIntern(Name, STR_INTERN_FIND_ONLY);
+  if (Interned == NULL) {
+    return EFI_NOT_FOUND;
+  }
   // Search for attribute
   for (List = Tree->Attributes; List != NULL; List = List->Next) {
-    if ((List->Attribute.Name != NULL) && (StrCmp(Name, List->Attribute.Name) == 0)) {
+    if (List->Attribute.Name == Interned) {
       *Attribute = &(List->Attribute);
       return EFI_SUCCESS;
     }
@@ -1232,6 +1272,7 @@ XmlTreeGetAttribute (
 /// @param Attribute The XML document tree attribute to set
 /// @return Whether the XML document tree attribute was set or not
 /// @retval EFI_INVALID_PARAMETER If Tree, Name, Attribute, or Attribute->Name is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the XML document tree attribute could not be allocated or its name could not be interned
 /// @retval EFI_SUCCESS           If the XML document tree attribute was set successfully
 EFI_STATUS
 EFIAPI
@@ -1240,34 +1281,41 @@ XmlTreeSetAttribute (
   IN     CHAR16        *Name,
   IN     XML_ATTRIBUTE *Attribute
 ) {
-  XML_LIST *List = NULL;
+  EFI_STATUS    Status;
+  CONST CHAR16 *Interned;
+  XML_LIST     *List = NULL;
+  XML_LIST     *Last;
   // Check parameters
   if ((Tree == NULL) || (Name == NULL) || (Attribute == NULL) || (Attribute->Name == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Search for attribute
-  for (List = Tree->Attributes; List != NULL; List = List->Next) {
-    if ((List->Attribute.Name != NULL) && (StrCmp(Name, List->Attribute.Name) == 0)) {
-      XmlAttributeDuplicateMembers(&(List->Attribute), Attribute);
-      return EFI_SUCCESS;
+  // Search for attribute, attribute names are interned so a name that was never interned can not match
+  Interned = StrIntern(Name, STR_INTERN_FIND_ONLY);
+  for (List = (Interned != NULL) ? Tree->Attributes : NULL; List != NULL; List = List->Next) {
+    if (List->Attribute.Name == Interned) {
+      return XmlAttributeDuplicateMembers(&(List->Attribute), Attribute);
     }
   }
   // Allocate a new attribute
+  List = EfiAllocateByType(XML_LIST);
   if (List == NULL) {
-    if (Tree->Attributes == NULL) {
-      List = Tree->Attributes = EfiAllocateByType(XML_LIST);
-    } else {
-      for (List = Tree->Attributes; List->Next != NULL; List = List->Next);
-      List = List->Next = EfiAllocateByType(XML_LIST);
-    }
-  }
-  // Check the attribute was allocate
-  if (List == NULL) {
-    return EFI_INVALID_PARAMETER;
+    return EFI_OUT_OF_RESOURCES;
   }
-  // Return the new attribute
   List->Next = NULL;
-  XmlAttributeDuplicateMembers(&(List->Attribute), Attribute);
+  List->Attribute.Name = NULL;
+  List->Attribute.Value = NULL;
+  Status = XmlAttributeDuplicateMembers(&(List->Attribute), Attribute);
+  if (EFI_ERROR(Status)) {
+    EfiFreePool(List);
+    return Status;
+  }
+  // Append the new attribute
+  if (Tree->Attributes == NULL) {
+    Tree->Attributes = List;
+  } else {
+    for (Last = Tree->Attributes; Last->Next != NULL; Last = Last->Next);
+    Last->Next = List;
+  }
   return EFI_SUCCESS;
 }
 // XmlTreeRemoveAttribute
@@ -1283,14 +1331,17 @@ XmlTreeRemoveAttribute (
   IN OUT XML_TREE *Tree,
   IN     CHAR16   *Name
 ) {
-  XML_LIST *Attribute;
+  CONST CHAR16 *Interned;
+  XML_LIST     *Attribute;
   // Check parameters
   if ((Tree == NULL) || (Name == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Tree->Attributes != NULL) {
+  // Attribute names are interned so a name that was never interned can not match
+  Interned = StrIntern(Name, STR_INTERN_FIND_ONLY);
+  if ((Interned != NULL) && (Tree->Attributes != NULL)) {
     // Check if first attribute
-    if (StrCmp(Name, Tree->Attributes->Attribute.Name) == 0) {
+    if (Tree->Attributes->Attribute.Name == Interned) {
       Attribute = Tree->Attributes;
       Tree->Attributes = Attribute->Next;
       XmlAttributeListFree(Attribute);
@@ -1298,7 +1349,10 @@ XmlTreeRemoveAttribute (
     } else {
       // Check rest of attributes
       for (Attribute = Tree->Attributes; Attribute->Next != NULL; Attribute = Attribute->Next) {
-        if ((Attribute->Next->Attribute.Name!= NULL) && (StrCmp(Name, Attribute->Next->Attribute.Name) == 0)) {
+        if (Attribute->Next->Attribute.Name == Interned) {
+          XML_LIST *Next = Attribute->Next;
+          Attribute->Next = Next->Next;
+          XmlAttributeListFree(Next);
           return EFI_SUCCESS;
         }
       }
@@ -1355,6 +1409,93 @@ XmlIsValidName (
   return EFI_SUCCESS;
 }
 
+// XmlWriteEscaped
+/// Write a string as XML character data or an attribute value, markup characters are escaped and characters that can not be encoded are written as character references
+/// @param Writer    The writer
+/// @param Value     The string to write
+/// @param Attribute Whether the string is an attribute value so quotes are also escaped
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the writer output
+EFI_STATUS
+EFIAPI
+XmlWriteEscaped (
+  IN OUT EFI_WRITER   *Writer,
+  IN     CONST CHAR16 *Value OPTIONAL,
+  IN     BOOLEAN       Attribute
+) {
+  STATIC CONST CHAR8 *Digits = "0123456789ABCDEF";
+  EFI_STATUS   Status;
+  CONST CHAR8 *Entity;
+  CHAR8        Reference[12];
+  UINTN        Index;
+  UINT32       Character;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Value == NULL) {
+    return EFI_SUCCESS;
+  }
+  // Write each character, escaping the characters that are markup
+  while (*Value != L'\0') {
+    Character = *Value++;
+    if ((Character >= 0xD800) && (Character <= 0xDBFF) && (*Value >= 0xDC00) && (*Value <= 0xDFFF)) {
+      Character = 0x10000 + ((Character - 0xD800) << 10) + (*Value++ - 0xDC00);
+    } else if ((Character >= 0xD800) && (Character <= 0xDFFF)) {
+      Character = 0xFFFD;
+    }
+    switch (Character) {
+      case L'&':
+        Entity = "&amp;";
+        break;
+
+      case L'<':
+        Entity = "&lt;";
+        break;
+
+      case L'>':
+        Entity = "&gt;";
+        break;
+
+      case L'\"':
+        Entity = Attribute ? "&quot;" : NULL;
+        break;
+
+      case L'\'':
+        Entity = Attribute ? "&apos;" : NULL;
+        break;
+
+      default:
+        Entity = NULL;
+        break;
+    }
+    if (Entity != NULL) {
+      Status = EfiWriterWriteAscii(Writer, Entity);
+    } else {
+      Status = EfiWriterWriteCharacter(Writer, Character);
+      if (Status == EFI_NO_MAPPING) {
+        // Write a hexadecimal character reference for a character the encoding does not have
+        Index = sizeof(Reference) - 1;
+        Reference[Index] = '\0';
+        Reference[--Index] = ';';
+        do {
+          Reference[--Index] = Digits[Character & 0xF];
+          Character >>= 4;
+        } while (Character != 0);
+        Reference[--Index] = 'x';
+        Reference[--Index] = '#';
+        Reference[--Index] = '&';
+        Status = EfiWriterWriteAscii(Writer, Reference + Index);
+      }
+    }
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+
 // XmlLibInitialize
 /// XML library initialize use
 /// @return Whether the XML library initialized successfully or not
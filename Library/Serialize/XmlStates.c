@@ -654,8 +654,8 @@ XmlTreeCreate (
   if (Ptr == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Set name
-  Ptr->Name = StrDup(Name);
+  // Set interned name
+  Ptr->Name = (CHAR16 *)StrIntern(Name, 0);
   if (Ptr->Name == NULL) {
     EfiFreePool(Ptr);
     return EFI_OUT_OF_RESOURCES;
@@ -694,8 +694,8 @@ XmlAttributeCreate (
   if (Ptr == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Set name
-  Ptr->Attribute.Name = StrDup(Name);
+  // Set interned name
+  Ptr->Attribute.Name = (CHAR16 *)StrIntern(Name, 0);
   if (Ptr->Attribute.Name == NULL) {
     EfiFreePool(Ptr);
     return EFI_OUT_OF_RESOURCES;
@@ -723,10 +723,7 @@ XmlAttributeFree (
   if (Attribute == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Attribute->Attribute.Name != NULL) {
-    EfiFreePool(Attribute->Attribute.Name);
-    Attribute->Attribute.Name = NULL;
-  }
+  Attribute->Attribute.Name = NULL;
   if (Attribute->Attribute.Value != NULL) {
     EfiFreePool(Attribute->Attribute.Value);
     Attribute->Attribute.Value = NULL;
@@ -750,10 +747,7 @@ XmlTreeFree (
   if (Tree == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  if (Tree->Name != NULL) {
-    EfiFreePool(Tree->Name);
-    Tree->Name = NULL;
-  }
+  Tree->Name = NULL;
   if (Tree->Value != NULL) {
     EfiFreePool(Tree->Value);
     Tree->Value = NULL;
@@ -1113,9 +1107,9 @@ XmlCallback (
       if ((Stack != NULL) && (Stack->Tree != NULL) && (Stack->Tree->Name != NULL)) {
         Value = Stack->Tree->Name;
       }
-      // Check there is a valid tag name to close
+      // Check there is a valid tag name to close, tag names are interned so a tag name that was never interned can not match
       if (Value != NULL) {
-        if (StrCmp(Value, Token) != 0) {
+        if (StrIntern(Token, STR_INTERN_FIND_ONLY) != Value) {
           // Error: expected a different tag closed first
           Status = ParseError(Parser, L"Expected </%s> before </%s>", Value, Token);
           return EFI_NOT_FOUND;
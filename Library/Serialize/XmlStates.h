@@ -235,7 +235,7 @@ struct XML_TREE {
   /// The child nodes
   XML_TREE *Children;
   // Name
-  /// The tag name
+  /// The tag name, which is interned and shared so it must not be freed or modified
   CHAR16   *Name;
   // Attributes
   /// List of attributes
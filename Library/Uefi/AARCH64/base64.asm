@@ -0,0 +1,140 @@
+;
+; @file Library/Uefi/AARCH64/base64.asm
+;
+; UEFI implementation ARM64 advanced SIMD base64 kernels
+;
+
+  area |.text|, CODE
+
+  export Base64EncodeBlocksNeon
+  export Base64DecodeBlocksNeon
+
+  align
+
+; Base64EncodeBlocksNeon
+; Encode forty eight byte blocks of data to base64 characters with advanced SIMD, the interleaved load splits the bytes by position in each three byte block
+; @param Output The output buffer, which must have room for four characters for every three input bytes
+; @param Input  The input data buffer
+; @param Size   The size in bytes of the input data buffer
+; @return The size in bytes of input data encoded, which is a multiple of forty eight
+Base64EncodeBlocksNeon  proc
+
+  adr       x9, Base64Dictionary
+  ld1       {v16.16b, v17.16b, v18.16b, v19.16b}, [x9]
+  movi      v20.16b, #0x3F
+  mov       x3, #0
+  subs      x4, x2, #48
+  b.lo      %f2
+
+1
+
+  ld3       {v0.16b, v1.16b, v2.16b}, [x1], #48
+  ushr      v4.16b, v0.16b, #2
+  ushr      v5.16b, v1.16b, #4
+  sli       v5.16b, v0.16b, #4
+  and       v5.16b, v5.16b, v20.16b
+  ushr      v6.16b, v2.16b, #6
+  sli       v6.16b, v1.16b, #2
+  and       v6.16b, v6.16b, v20.16b
+  and       v7.16b, v2.16b, v20.16b
+  tbl       v4.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v4.16b
+  tbl       v5.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v5.16b
+  tbl       v6.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v6.16b
+  tbl       v7.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v7.16b
+  st4       {v4.16b, v5.16b, v6.16b, v7.16b}, [x0], #64
+  add       x3, x3, #48
+  subs      x4, x4, #48
+  b.hs      %b1
+
+2
+
+  mov       x0, x3
+  ret
+
+Base64EncodeBlocksNeon  endp
+
+  align
+
+; Base64DecodeBlocksNeon
+; Decode sixty four character blocks of base64 characters to data with advanced SIMD, the interleaved load splits the characters by position in each four character block
+; @param Output The output buffer, which must have room for three bytes for every four input characters
+; @param Input  The input base64 characters
+; @param Count  The count of input characters
+; @return The count of input characters decoded, which is a multiple of sixty four, decoding stops before the first block that contains any character that is not in the base64 alphabet
+Base64DecodeBlocksNeon  proc
+
+  adr       x9, Base64DecodeValues
+  ld1       {v16.16b, v17.16b, v18.16b, v19.16b}, [x9], #64
+  ld1       {v20.16b, v21.16b, v22.16b, v23.16b}, [x9]
+  movi      v24.16b, #0x40
+  mov       x3, #0
+  subs      x4, x2, #64
+  b.lo      %f2
+
+1
+
+  ld4       {v0.16b, v1.16b, v2.16b, v3.16b}, [x1]
+  tbl       v4.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v0.16b
+  sub       v28.16b, v0.16b, v24.16b
+  tbx       v4.16b, {v20.16b, v21.16b, v22.16b, v23.16b}, v28.16b
+  cmlt      v29.16b, v0.16b, #0
+  orr       v4.16b, v4.16b, v29.16b
+  tbl       v5.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v1.16b
+  sub       v28.16b, v1.16b, v24.16b
+  tbx       v5.16b, {v20.16b, v21.16b, v22.16b, v23.16b}, v28.16b
+  cmlt      v29.16b, v1.16b, #0
+  orr       v5.16b, v5.16b, v29.16b
+  tbl       v6.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v2.16b
+  sub       v28.16b, v2.16b, v24.16b
+  tbx       v6.16b, {v20.16b, v21.16b, v22.16b, v23.16b}, v28.16b
+  cmlt      v29.16b, v2.16b, #0
+  orr       v6.16b, v6.16b, v29.16b
+  tbl       v7.16b, {v16.16b, v17.16b, v18.16b, v19.16b}, v3.16b
+  sub       v28.16b, v3.16b, v24.16b
+  tbx       v7.16b, {v20.16b, v21.16b, v22.16b, v23.16b}, v28.16b
+  cmlt      v29.16b, v3.16b, #0
+  orr       v7.16b, v7.16b, v29.16b
+  orr       v28.16b, v4.16b, v5.16b
+  orr       v29.16b, v6.16b, v7.16b
+  orr       v28.16b, v28.16b, v29.16b
+  umaxv     b28, v28.16b
+  fmov      w5, s28
+  cmp       w5, #0x3F
+  b.hi      %f2
+  ushr      v25.16b, v5.16b, #4
+  sli       v25.16b, v4.16b, #2
+  ushr      v26.16b, v6.16b, #2
+  sli       v26.16b, v5.16b, #4
+  mov       v27.16b, v7.16b
+  sli       v27.16b, v6.16b, #6
+  st3       {v25.16b, v26.16b, v27.16b}, [x0], #48
+  add       x1, x1, #64
+  add       x3, x3, #64
+  subs      x4, x4, #64
+  b.hs      %b1
+
+2
+
+  mov       x0, x3
+  ret
+
+Base64DecodeBlocksNeon  endp
+
+; The base64 encoding dictionary
+  align 16
+Base64Dictionary
+  dcb       "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+
+; The six bit value of each ASCII base64 character or 0xFF for any other character
+  align 16
+Base64DecodeValues
+  dcb       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  dcb       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  dcb       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F
+  dcb       0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  dcb       0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E
+  dcb       0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  dcb       0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28
+  dcb       0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+
+  end
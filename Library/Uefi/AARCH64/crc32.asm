@@ -0,0 +1,69 @@
+;
+; @file Library/Uefi/AARCH64/crc32.asm
+;
+; UEFI implementation ARM64 CRC32 instruction kernel
+;
+
+  area |.text|, CODE
+
+  export Crc32IsSupportedNeon
+  export Crc32BlocksNeon
+
+  align
+
+; Crc32IsSupportedNeon
+; Check whether the CRC32 instructions are implemented, which are optional before ARMv8.1
+; @return The CRC32 field of the instruction set attribute register, which is zero if the CRC32 instructions are not implemented
+Crc32IsSupportedNeon  proc
+
+  mrs       x0, ID_AA64ISAR0_EL1
+  ubfx      x0, x0, #16, #4
+  ret
+
+Crc32IsSupportedNeon  endp
+
+  align
+
+; Crc32BlocksNeon
+; Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer with the CRC32 instructions
+; @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+; @param Data  The data buffer
+; @param Size  The size in bytes of the data buffer
+; @return The updated 32-bit CRC
+Crc32BlocksNeon  proc
+
+  mvn       w0, w0
+  subs      x2, x2, #32
+  b.lo      %f2
+
+1
+
+  ldp       x3, x4, [x1], #16
+  ldp       x5, x6, [x1], #16
+  crc32x    w0, w0, x3
+  crc32x    w0, w0, x4
+  crc32x    w0, w0, x5
+  crc32x    w0, w0, x6
+  subs      x2, x2, #32
+  b.hs      %b1
+
+2
+
+  adds      x2, x2, #32
+  b.eq      %f4
+
+3
+
+  ldrb      w3, [x1], #1
+  crc32b    w0, w0, w3
+  subs      x2, x2, #1
+  b.ne      %b3
+
+4
+
+  mvn       w0, w0
+  ret
+
+Crc32BlocksNeon  endp
+
+  end
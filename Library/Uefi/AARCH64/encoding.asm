@@ -0,0 +1,88 @@
+;
+; @file Library/Uefi/AARCH64/encoding.asm
+;
+; UEFI implementation ARM64 advanced SIMD encoding kernels
+;
+
+  area |.text|, CODE
+
+  export Utf8ValidateBlocksNeon
+
+  align
+
+; Utf8ValidateBlocksNeon
+; Validate the leading blocks of a UTF-8 buffer with advanced SIMD using nibble lookup tables
+; @param Input The UTF-8 input buffer
+; @param Size  The size in bytes of the input buffer
+; @param Count On output, the count of bytes that start a character in the validated blocks
+; @return The size in bytes of the validated blocks, which may end within a character, validation stops before the last partial block or a block with the null terminator or an invalid sequence
+Utf8ValidateBlocksNeon  proc
+
+  adr       x9, Utf8ByteOneHigh
+  ld1       {v16.16b, v17.16b, v18.16b}, [x9]
+  movi      v19.16b, #0x0F
+  movi      v20.16b, #0x60
+  movi      v21.16b, #0x70
+  movi      v22.16b, #0x80
+  movi      v23.16b, #0xC0
+  movi      v1.16b, #0
+  mov       x3, #0
+  mov       x4, #0
+  and       x5, x1, #-16
+
+1
+
+  cmp       x3, x5
+  b.hs      %f2
+  ldr       q3, [x0, x3]
+  ext       v4.16b, v1.16b, v3.16b, #15
+  ushr      v5.16b, v4.16b, #4
+  tbl       v0.16b, {v16.16b}, v5.16b
+  and       v4.16b, v4.16b, v19.16b
+  tbl       v5.16b, {v17.16b}, v4.16b
+  and       v0.16b, v0.16b, v5.16b
+  ushr      v4.16b, v3.16b, #4
+  tbl       v5.16b, {v18.16b}, v4.16b
+  and       v0.16b, v0.16b, v5.16b
+  ext       v4.16b, v1.16b, v3.16b, #14
+  uqsub     v4.16b, v4.16b, v20.16b
+  ext       v5.16b, v1.16b, v3.16b, #13
+  uqsub     v5.16b, v5.16b, v21.16b
+  orr       v4.16b, v4.16b, v5.16b
+  and       v4.16b, v4.16b, v22.16b
+  eor       v0.16b, v0.16b, v4.16b
+  cmeq      v5.16b, v3.16b, #0
+  orr       v0.16b, v0.16b, v5.16b
+  umaxv     b5, v0.16b
+  fmov      w6, s5
+  cbnz      w6, %f2
+  cmgt      v4.16b, v23.16b, v3.16b
+  ushr      v4.16b, v4.16b, #7
+  addv      b4, v4.16b
+  fmov      w6, s4
+  add       x4, x4, x6
+  mov       v1.16b, v3.16b
+  add       x3, x3, #16
+  b         %b1
+
+2
+
+  sub       x4, x3, x4
+  str       x4, [x2]
+  mov       x0, x3
+  ret
+
+Utf8ValidateBlocksNeon  endp
+
+; The UTF-8 validation tables
+; The error bits are too short 0x01, too long 0x02, overlong three 0x04, too large 0x08, surrogate 0x10,
+;  overlong two 0x20, too large 1000 and overlong four 0x40, and two continuations 0x80
+  align 16
+Utf8ByteOneHigh
+  dcb       0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49
+Utf8ByteOneLow
+  dcb       0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB
+Utf8ByteTwoHigh
+  dcb       0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01
+
+  end
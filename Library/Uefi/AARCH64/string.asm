@@ -0,0 +1,99 @@
+;
+; @file Library/Uefi/AARCH64/string.asm
+;
+; UEFI implementation ARM64 advanced SIMD string kernels
+;
+
+  area |.text|, CODE
+
+  export StrLenNeon
+  export AsciiStrLenNeon
+
+  align
+
+; StrLenNeon
+; Get the length of a character string with advanced SIMD, aligned blocks are read so the read never crosses a page
+; @param Str The character string, which must not be NULL
+; @return The count of characters in the character string
+StrLenNeon  proc
+
+  tbnz      x0, #0, %f3
+  and       x1, x0, #-16
+  ldr       q0, [x1]
+  cmeq      v0.8h, v0.8h, #0
+  shrn      v0.8b, v0.8h, #4
+  fmov      x2, d0
+  lsl       x3, x0, #2
+  lsr       x2, x2, x3
+  cbz       x2, %f1
+  rbit      x2, x2
+  clz       x2, x2
+  lsr       x0, x2, #3
+  ret
+
+1
+
+  ldr       q0, [x1, #16]!
+  cmeq      v0.8h, v0.8h, #0
+  shrn      v0.8b, v0.8h, #4
+  fmov      x2, d0
+  cbz       x2, %b1
+  rbit      x2, x2
+  clz       x2, x2
+  sub       x0, x1, x0
+  add       x0, x0, x2, lsr #2
+  lsr       x0, x0, #1
+  ret
+
+3
+
+  mov       x1, x0
+
+4
+
+  ldrh      w2, [x1], #2
+  cbnz      w2, %b4
+  sub       x0, x1, x0
+  sub       x0, x0, #2
+  lsr       x0, x0, #1
+  ret
+
+StrLenNeon  endp
+
+  align
+
+; AsciiStrLenNeon
+; Get the length of a character string with advanced SIMD, aligned blocks are read so the read never crosses a page
+; @param Str The character string, which must not be NULL
+; @return The count of characters in the character string
+AsciiStrLenNeon  proc
+
+  and       x1, x0, #-16
+  ldr       q0, [x1]
+  cmeq      v0.16b, v0.16b, #0
+  shrn      v0.8b, v0.8h, #4
+  fmov      x2, d0
+  lsl       x3, x0, #2
+  lsr       x2, x2, x3
+  cbz       x2, %f1
+  rbit      x2, x2
+  clz       x2, x2
+  lsr       x0, x2, #2
+  ret
+
+1
+
+  ldr       q0, [x1, #16]!
+  cmeq      v0.16b, v0.16b, #0
+  shrn      v0.8b, v0.8h, #4
+  fmov      x2, d0
+  cbz       x2, %b1
+  rbit      x2, x2
+  clz       x2, x2
+  sub       x0, x1, x0
+  add       x0, x0, x2, lsr #2
+  ret
+
+AsciiStrLenNeon  endp
+
+  end
@@ -624,6 +624,65 @@ EfiStall (
   }
   return gEfiBootServices->Stall(Microseconds);
 }
+
+// EFI_TIME_STAMP_CALIBRATION
+/// The number of microseconds to stall when calibrating the time stamp frequency
+#define EFI_TIME_STAMP_CALIBRATION 10000
+
+// mTimeStampFrequency
+/// The calibrated time stamp frequency
+STATIC UINT64 mTimeStampFrequency = 0;
+
+// EfiGetTimeStamp
+/// Get the current processor time stamp
+/// @return The current time stamp or zero if there is no time stamp counter
+UINT64
+EFIAPI
+EfiGetTimeStamp (
+  VOID
+) {
+#if defined(EFI_ARCH_IA32) || defined(EFI_ARCH_X64)
+  return EfiReadTimeStampCounter();
+#else
+  return 0;
+#endif
+}
+// EfiGetTimeStampFrequency
+/// Get the frequency of the processor time stamp, calibrated once against EfiStall
+/// @return The number of time stamp ticks per second or zero if the frequency could not be determined
+UINT64
+EFIAPI
+EfiGetTimeStampFrequency (
+  VOID
+) {
+  if (mTimeStampFrequency == 0) {
+    // Measure the time stamp across a known stall
+    UINT64 Start = EfiGetTimeStamp();
+    if ((Start != 0) && !EFI_ERROR(EfiStall(EFI_TIME_STAMP_CALIBRATION))) {
+      UINT64 Finish = EfiGetTimeStamp();
+      if (Finish > Start) {
+        mTimeStampFrequency = (Finish - Start) * (1000000 / EFI_TIME_STAMP_CALIBRATION);
+      }
+    }
+  }
+  return mTimeStampFrequency;
+}
+// EfiTimeStampToNanoseconds
+/// Convert a time stamp difference to nanoseconds
+/// @param TimeStamp The time stamp difference to convert
+/// @return The number of nanoseconds or zero if the frequency could not be determined
+UINT64
+EFIAPI
+EfiTimeStampToNanoseconds (
+  IN UINT64 TimeStamp
+) {
+  UINT64 Frequency = EfiGetTimeStampFrequency();
+  if (Frequency == 0) {
+    return 0;
+  }
+  // Split the conversion so the intermediate value does not overflow
+  return ((TimeStamp / Frequency) * 1000000000ULL) + (((TimeStamp % Frequency) * 1000000000ULL) / Frequency);
+}
 // EfiSetWatchdogTimer
 /// Sets the systems watchdog timer
 /// @param Timeout      The number of seconds to set the watchdog timer, zero disables the timer
@@ -943,12 +1002,75 @@ EfiCalculateCrc32 (
   IN  UINTN   DataSize,
   OUT UINT32 *Crc32
 ) {
-  if ((gEfiBootServices == NULL) ||
-      (gEfiBootServices->Hdr.Revision < EFI_1_10_SYSTEM_TABLE_REVISION) ||
-      (gEfiBootServices->CalculateCrc32 == NULL)) {
-    return EFI_UNSUPPORTED;
+  // Compute the CRC without the firmware so it is also available after exiting boot services and on application processors
+  if ((Data == NULL) || (DataSize == 0) || (Crc32 == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Large buffers are only split across processors from the boot strap processor while boot services are available
+  if ((DataSize >= EFI_PARALLEL_CRC32_MINIMUM) && EfiParallelIsAvailable()) {
+    *Crc32 = EfiParallelCrc32(0, Data, DataSize);
+  } else {
+    *Crc32 = EfiDispatch()->Crc32(0, Data, DataSize);
+  }
+  return EFI_SUCCESS;
+}
+// EfiCrc32Init
+/// Initialize a context to compute a 32-bit CRC incrementally
+/// @param Context The CRC context to initialize
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           If the context was initialized
+EFI_STATUS
+EFIAPI
+EfiCrc32Init (
+  OUT EFI_CRC32_CONTEXT *Context
+) {
+  if (Context == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Context->Crc32 = 0;
+  Context->Size = 0;
+  return EFI_SUCCESS;
+}
+// EfiCrc32Update
+/// Update a 32-bit CRC context with the next part of the data
+/// @param Context The CRC context
+/// @param Data    The next part of the data
+/// @param Size    The size in bytes of the next part of the data
+/// @retval EFI_INVALID_PARAMETER If Context is NULL or Data is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the context was updated
+EFI_STATUS
+EFIAPI
+EfiCrc32Update (
+  IN OUT EFI_CRC32_CONTEXT *Context,
+  IN     CONST VOID        *Data,
+  IN     UINTN              Size
+) {
+  if ((Context == NULL) || ((Data == NULL) && (Size != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Size != 0) {
+    Context->Crc32 = ((Size >= EFI_PARALLEL_CRC32_MINIMUM) && EfiParallelIsAvailable()) ? EfiParallelCrc32(Context->Crc32, Data, Size) : EfiDispatch()->Crc32(Context->Crc32, Data, Size);
+    Context->Size += Size;
+  }
+  return EFI_SUCCESS;
+}
+// EfiCrc32Final
+/// Get the 32-bit CRC of all the data a context was updated with
+/// @param Context The CRC context
+/// @param Crc32   On output, the 32-bit CRC
+/// @retval EFI_INVALID_PARAMETER If Context or Crc32 is NULL
+/// @retval EFI_SUCCESS           If the 32-bit CRC was returned
+EFI_STATUS
+EFIAPI
+EfiCrc32Final (
+  IN  EFI_CRC32_CONTEXT *Context,
+  OUT UINT32            *Crc32
+) {
+  if ((Context == NULL) || (Crc32 == NULL)) {
+    return EFI_INVALID_PARAMETER;
   }
-  return gEfiBootServices->CalculateCrc32(Data, DataSize, Crc32);
+  *Crc32 = Context->Crc32;
+  return EFI_SUCCESS;
 }
 
 // EfiCreateEventEx
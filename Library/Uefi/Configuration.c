@@ -37,19 +37,22 @@ struct EFI_CONFIGURATION_KEY {
 
   // Next
   /// The next key
-  EFI_CONFIGURATION_KEY  *Next;
+  EFI_CONFIGURATION_KEY   *Next;
   // Name
-  /// The key name
-  CHAR16                 *Name;
+  /// The case insensitive interned key name, which is compared by pointer
+  CONST CHAR16            *Name;
   // Type
   /// The key type
-  EFI_CONFIGURATION_TYPE  Type;
+  EFI_CONFIGURATION_TYPE   Type;
   // Size
   /// The size in bytes of the key value or the count of keys in a list or array type
-  UINTN                   Size;
+  UINTN                    Size;
   // Value
-  /// The key value
-  VOID                   *Value;
+  /// The key value, or the text of the key value until it is decoded
+  VOID                    *Value;
+  // Decode
+  /// The function that decodes the text of the key value when it is first accessed, or NULL if the key value is decoded
+  EFI_CONFIGURATION_DECODE Decode;
 
 };
 // EFI_CONFIGURATION_PROTOCOL_IMPL
@@ -73,7 +76,7 @@ struct EFI_CONFIGURATION_PROTOCOL_IMPL {
 // ConfigurationFinishKey
 /// Finish using a configuration key by freeing all child resources
 /// @param Key      The configuration key to finish
-/// @param KeepName Whether to keep the name allocated or free the name
+/// @param KeepName Whether to keep the name or clear the name
 STATIC
 VOID
 EFIAPI
@@ -82,9 +85,8 @@ ConfigurationFinishKey (
   IN BOOLEAN                KeepName
 ) {
   if (Key != NULL) {
-    // Free the key name
-    if (!KeepName && (Key->Name != NULL)) {
-      EfiFreePool(Key->Name);
+    // Clear the key name, interned names are never freed
+    if (!KeepName) {
       Key->Name = NULL;
     }
     // Free the value
@@ -111,6 +113,7 @@ ConfigurationFinishKey (
       }
       Key->Value = NULL;
     }
+    Key->Decode = NULL;
   }
 }
 // ConfigurationFind
@@ -132,6 +135,7 @@ ConfigurationFind (
   EFI_CONFIGURATION_KEY *This;
   EFI_CONFIGURATION_KEY *List;
   CONST CHAR16          *Name;
+  CONST CHAR16          *Interned;
   UINTN                  Length;
   // Check if root is valid and key is not null
   if (Root == NULL) {
@@ -187,9 +191,11 @@ ConfigurationFind (
     }
     // Get the length of the key name
     Length = (Key - Name);
-    // Get the array index
-    Ptr = Name;
-    if (EFI_ERROR(StrToUnsigned(&Ptr, &Index, 10)) || (Ptr != Key)) {
+    // Get the array index from the decimal digits of the key name only, without converting the rest of the key path
+    for (Ptr = Name; (Ptr < Key) && (*Ptr >= L'0') && (*Ptr <= L'9'); ++Ptr) {
+      Index = (Index * 10) + (UINT64)(*Ptr - L'0');
+    }
+    if (Ptr != Key) {
       // Failed to get an unsigned because the key was not an unsigned so default to zero
       Index = 0;
     }
@@ -199,11 +205,12 @@ ConfigurationFind (
     }
     // Check the key type to make sure this is a list or an array
     if (This->Type == EfiConfigurationTypeList) {
-      // Get the list of child keys
+      // Get the list of child keys, a name that was never interned can not be the name of a key
       List = (EFI_CONFIGURATION_KEY *)(This->Value);
-      if (List != NULL) {
+      Interned = StrnIntern(Name, Length, STR_INTERN_CASE_INSENSITIVE | STR_INTERN_FIND_ONLY);
+      if ((List != NULL) && (Interned != NULL)) {
         // Traverse the keys to find the key with the name
-        if ((List->Name != NULL) && (StrniCmp(List->Name, Name, Length) == 0)) {
+        if (List->Name == Interned) {
           // Check if removing the key
           if (*Key == 0) {
             if (Action == ConfigurationActionRemove) {
@@ -228,7 +235,7 @@ ConfigurationFind (
         }
         // Traverse the rest of the keys to find the key with the name
         while (List->Next != NULL) {
-          if ((List->Next->Name != NULL) && (StrniCmp(List->Next->Name, Name, Length) == 0)) {
+          if (List->Next->Name == Interned) {
             // Check if removing the key
             if (*Key == 0) {
               if (Action == ConfigurationActionRemove) {
@@ -323,6 +330,7 @@ ConfigurationFind (
         EfiFreePool(This->Value);
         This->Value = NULL;
       }
+      This->Decode = NULL;
       // Choose array type if only an index was the name
       This->Type = ((Index != 0) || (Ptr == Key)) ? EfiConfigurationTypeArray : EfiConfigurationTypeList;
     }
@@ -340,8 +348,17 @@ ConfigurationFind (
     // Set no value
     List->Size = 0;
     List->Value = NULL;
-    // Duplicate key name
-    List->Name = StrnDup(Name, Length);
+    List->Decode = NULL;
+    // Intern key name
+    if (Name != NULL) {
+      List->Name = StrnIntern(Name, Length, STR_INTERN_CASE_INSENSITIVE);
+      if (List->Name == NULL) {
+        EfiFreePool(List);
+        return EFI_OUT_OF_RESOURCES;
+      }
+    } else {
+      List->Name = NULL;
+    }
     // Choose array type if only an index was the name
     List->Type = ((Index != 0) || (Ptr == Key)) ? EfiConfigurationTypeArray : EfiConfigurationTypeList;
     // Add the child to the list
@@ -514,6 +531,46 @@ ConfigurationGetChildren (
   }
   return EFI_SUCCESS;
 }
+// ConfigurationDecodeKey
+/// Decode the text of a configuration key value, the decoded value replaces the text so it is only decoded once
+/// @param Key The configuration key to decode
+/// @retval EFI_SUCCESS The key value was decoded or was already decoded
+/// @return Any other status if the text could not be decoded, the key is left without a value as the text may have been decoded in place
+STATIC
+EFI_STATUS
+EFIAPI
+ConfigurationDecodeKey (
+  IN EFI_CONFIGURATION_KEY *Key
+) {
+  EFI_STATUS  Status;
+  VOID       *Value = NULL;
+  UINTN       Size = 0;
+  // Check if the value was already decoded
+  if (Key->Decode == NULL) {
+    return EFI_SUCCESS;
+  }
+  // Decode the text
+  Status = Key->Decode(Key->Type, (CHAR16 *)(Key->Value), &Value, &Size);
+  if (!EFI_ERROR(Status) && ((Value == NULL) || (Size == 0))) {
+    Status = EFI_NOT_FOUND;
+  }
+  if (EFI_ERROR(Status)) {
+    if ((Value != NULL) && (Value != Key->Value)) {
+      EfiFreePool(Value);
+    }
+    ConfigurationFinishKey(Key, TRUE);
+    Key->Size = 0;
+    return Status;
+  }
+  // Replace the text with the decoded value, unless the text was decoded in place
+  if ((Key->Value != NULL) && (Key->Value != Value)) {
+    EfiFreePool(Key->Value);
+  }
+  Key->Value = Value;
+  Key->Size = Size;
+  Key->Decode = NULL;
+  return EFI_SUCCESS;
+}
 // ConfigurationGet
 /// Get a configuration value by key
 /// @param This  The configuration protocol interface
@@ -523,6 +580,7 @@ ConfigurationGetChildren (
 /// @param Type  On output, the type of the value
 /// @retval EFI_INVALID_PARAMETER If Key or Value is NULL
 /// @retval EFI_SUCCESS           The value, size, and type of the key were returned successfully
+/// @return Any other status if the text of the value could not be decoded
 STATIC
 EFI_STATUS
 EFIAPI
@@ -546,6 +604,11 @@ ConfigurationGet (
   if (EFI_ERROR(Status)) {
     return Status;
   }
+  // Decode the value if this is the first access
+  Status = ConfigurationDecodeKey(Root);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
   // Return the value
   *Value = Root->Value;
   // Return the type if needed
@@ -643,6 +706,63 @@ ConfigurationSet (
   Root->Type = Type;
   Root->Size = Size;
   Root->Value = EfiDuplicate(Size, Value);
+  Root->Decode = NULL;
+  return EFI_SUCCESS;
+}
+// ConfigurationSetEncoded
+/// Set a configuration value by key as text that is decoded when the value is first accessed
+/// @param This   The configuration protocol interface
+/// @param Key    The key path identifier
+/// @param Text   The text of the value
+/// @param Type   The configuration key value type, which must not be a list or array type
+/// @param Decode The function that decodes the text to the value
+/// @retval EFI_INVALID_PARAMETER If This, Key, Text, or Decode is NULL or Type is a list or array type
+/// @retval EFI_OUT_OF_RESOURCES  The text could not be copied
+/// @retval EFI_SUCCESS           The text and type of the key were set successfully
+STATIC
+EFI_STATUS
+EFIAPI
+ConfigurationSetEncoded (
+  IN EFI_CONFIGURATION_PROTOCOL_IMPL *This,
+  IN CONST CHAR16                    *Key,
+  IN CONST CHAR16                    *Text,
+  IN EFI_CONFIGURATION_TYPE           Type,
+  IN EFI_CONFIGURATION_DECODE         Decode
+) {
+  EFI_STATUS             Status;
+  EFI_CONFIGURATION_KEY *Root;
+  CHAR16                *Copy;
+  // Check this is correct protocol implementation
+  if ((This == NULL) || (This->Signature != EFI_CONFIGURATION_PROTOCOL_IMPL_SIGNATURE)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Check parameters
+  if ((Text == NULL) || (Decode == NULL) || (Type == EfiConfigurationTypeList) || (Type == EfiConfigurationTypeArray)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Copy the text
+  Copy = StrDup(Text);
+  if (Copy == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Create the root key if needed
+  Status = ConfigurationFind(&(This->Root), NULL, ConfigurationActionCreate);
+  if (!EFI_ERROR(Status)) {
+    // Protect the root key
+    Root = This->Root;
+    // Find or create the key
+    Status = ConfigurationFind(&Root, Key, ConfigurationActionCreate);
+  }
+  if (EFI_ERROR(Status)) {
+    EfiFreePool(Copy);
+    return Status;
+  }
+  // Replace any previous value with the text
+  ConfigurationFinishKey(Root, TRUE);
+  Root->Type = Type;
+  Root->Size = StrSize(Copy);
+  Root->Value = Copy;
+  Root->Decode = Decode;
   return EFI_SUCCESS;
 }
 // ConfigurationRemove
@@ -695,6 +815,8 @@ ConfigurationEnumerateKey (
   if ((This == NULL) || (Key == NULL) || (Callback == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
+  // Decode the value since the callback gets the value, a key whose text can not be decoded is enumerated without a value
+  ConfigurationDecodeKey(This);
   // Callback if this key is empty
   if ((This->Name != NULL) || ((This->Size != 0) && (This->Value != NULL))) {
     // Callback for each key
@@ -837,6 +959,7 @@ EfiConfigurationInstall (
   Impl->Protocol.Set = (EFI_CONFIGURATION_SET)ConfigurationSet;
   Impl->Protocol.Remove = (EFI_CONFIGURATION_REMOVE)ConfigurationRemove;
   Impl->Protocol.Enumerate = (EFI_CONFIGURATION_ENUMERATE)ConfigurationEnumerate;
+  Impl->Protocol.SetEncoded = (EFI_CONFIGURATION_SET_ENCODED)ConfigurationSetEncoded;
   // Setup the configuration protocol implementation interface
   Impl->Signature = EFI_CONFIGURATION_PROTOCOL_IMPL_SIGNATURE;
   Impl->Root = NULL;
@@ -1265,6 +1388,28 @@ EfiConfigurationSetFloat (
 ) {
   return EfiConfigurationSet(Key, &Float, sizeof(FLOAT64), EfiConfigurationTypeFloat);
 }
+// EfiConfigurationSetEncoded
+/// Set a configuration value by key as text that is decoded when the value is first accessed
+/// @param Key    The key path identifier
+/// @param Text   The text of the value
+/// @param Type   The configuration key value type, which must not be a list or array type
+/// @param Decode The function that decodes the text to the value
+/// @retval EFI_INVALID_PARAMETER If Key, Text, or Decode is NULL or Type is a list or array type
+/// @retval EFI_SUCCESS           The text and type of the key were set successfully
+EFI_STATUS
+EFIAPI
+EfiConfigurationSetEncoded (
+  IN CONST CHAR16             *Key,
+  IN CONST CHAR16             *Text,
+  IN EFI_CONFIGURATION_TYPE    Type,
+  IN EFI_CONFIGURATION_DECODE  Decode
+) {
+  EFI_CONFIGURATION_PROTOCOL *Configuration = ConfigurationGetProtocol();
+  if ((Configuration == NULL) || (Configuration->SetEncoded == NULL)) {
+    return EFI_UNSUPPORTED;
+  }
+  return Configuration->SetEncoded(Configuration, Key, Text, Type, Decode);
+}
 
 // EfiConfigurationRemove
 /// Remove key by path identifier
@@ -254,6 +254,7 @@ EfiConInWaitForKey (
   OUT EFI_INPUT_KEY *Key
 ) {
   EFI_STATUS Status;
+  UINTN      Index = 0;
   if (Key == NULL) {
     return EFI_INVALID_PARAMETER;
   }
@@ -262,6 +263,10 @@ EfiConInWaitForKey (
   }
   do {
     Status = gEfiConIn->ReadKeyStroke(gEfiConIn, Key);
+    if ((Status == EFI_NOT_READY) && (gEfiConIn->WaitForKey != NULL)) {
+      // Sleep until a key is available instead of polling
+      EfiWaitForEvent(1, &(gEfiConIn->WaitForKey), &Index);
+    }
   } while (Status == EFI_NOT_READY);
   return Status;
 }
@@ -0,0 +1,417 @@
+///
+/// @file Library/Uefi/CpuPool.c
+///
+/// UEFI per processor small object allocation caches
+///
+
+#include <Uefi.h>
+
+#include <Uefi/Protocol/MpService.h>
+
+// EFI_CPU_POOL_SIGNATURE
+/// The signature of an object allocated from the per processor caches
+#define EFI_CPU_POOL_SIGNATURE 0x4C4F4F50
+// EFI_CPU_POOL_HEADER_SIZE
+/// The size in bytes of an object header or page chunk header, objects follow their header
+#define EFI_CPU_POOL_HEADER_SIZE 16
+// EFI_CPU_POOL_MAGAZINE_MINIMUM
+/// The minimum number of objects in a magazine, more objects are added to fill the pages of the magazine
+#define EFI_CPU_POOL_MAGAZINE_MINIMUM 8
+
+// EFI_CPU_POOL_OBJECT
+/// An object header
+typedef struct EFI_CPU_POOL_OBJECT EFI_CPU_POOL_OBJECT;
+struct EFI_CPU_POOL_OBJECT {
+
+  // Next
+  /// The next free object while the object is in a list
+  EFI_CPU_POOL_OBJECT *Next;
+  // Signature
+  /// The object signature
+  UINT32               Signature;
+  // Class
+  /// The size class of the object
+  UINT16               Class;
+  // Processor
+  /// The processor that owns the object
+  UINT16               Processor;
+
+};
+
+// EFI_CPU_POOL_CHUNK
+/// The header of the pages backing a magazine
+typedef struct EFI_CPU_POOL_CHUNK EFI_CPU_POOL_CHUNK;
+struct EFI_CPU_POOL_CHUNK {
+
+  // Next
+  /// The next chunk
+  EFI_CPU_POOL_CHUNK *Next;
+  // Pages
+  /// The number of pages in the chunk
+  UINTN               Pages;
+
+};
+
+// EFI_CPU_POOL_CACHE
+/// The cache of one size class for one processor, each cache is on its own cache line
+typedef struct EFI_CPU_POOL_CACHE EFI_CPU_POOL_CACHE;
+struct EFI_CPU_POOL_CACHE {
+
+  // Free
+  /// The free objects, only used by the owning processor
+  EFI_CPU_POOL_OBJECT           *Free;
+  // Return
+  /// The objects freed by other processors, any processor may push and the owning processor takes the whole list
+  EFI_CPU_POOL_OBJECT * VOLATILE Return;
+  // Magazine
+  /// The reserve magazine, the boot strap processor fills it and the owning processor takes it
+  EFI_CPU_POOL_OBJECT * VOLATILE Magazine;
+
+};
+
+// mCpuPoolSizes
+/// The object sizes of each size class
+STATIC CONST UINTN mCpuPoolSizes[] = { 16, 32, 64, 128, 256, 512, 1024, EFI_CPU_POOL_MAXIMUM_SIZE };
+// mCpuPoolMpServices
+/// The multiprocessor services protocol or NULL if there is only the boot strap processor
+STATIC EFI_MP_SERVICES_PROTOCOL *mCpuPoolMpServices = NULL;
+// mCpuPoolBuffer
+/// The allocation containing the caches
+STATIC VOID *mCpuPoolBuffer = NULL;
+// mCpuPoolCaches
+/// The cache line aligned caches of every size class for every processor
+STATIC UINT8 *mCpuPoolCaches = NULL;
+// mCpuPoolProcessors
+/// The number of processors that have caches
+STATIC UINTN mCpuPoolProcessors = 0;
+// mCpuPoolBsp
+/// The processor number of the boot strap processor
+STATIC UINTN mCpuPoolBsp = 0;
+// mCpuPoolChunks
+/// The chunks of pages backing the magazines, only used by the boot strap processor
+STATIC EFI_CPU_POOL_CHUNK *mCpuPoolChunks = NULL;
+// mCpuPoolExited
+/// Whether boot services were exited so neither the multiprocessor services nor the page allocator can be used
+STATIC VOLATILE BOOLEAN mCpuPoolExited = FALSE;
+// mCpuPoolExitRegistered
+/// Whether the exit boot services callback was registered
+STATIC BOOLEAN mCpuPoolExitRegistered = FALSE;
+
+// CpuPoolGetCache
+/// Get the cache of a size class for a processor
+/// @param Processor The processor number
+/// @param Class     The size class
+/// @return The cache
+#define CpuPoolGetCache(Processor, Class) ((EFI_CPU_POOL_CACHE *)(mCpuPoolCaches + ((((Processor) * ARRAY_COUNT(mCpuPoolSizes)) + (Class)) * EFI_PARALLEL_CACHE_LINE_SIZE)))
+
+// CpuPoolWhoAmI
+/// Get the processor number of the calling processor
+/// @param Processor On output, the processor number
+/// @retval EFI_NOT_FOUND The processor number could not be determined
+/// @retval EFI_SUCCESS   The processor number was returned
+STATIC
+EFI_STATUS
+EFIAPI
+CpuPoolWhoAmI (
+  OUT UINTN *Processor
+) {
+  if (mCpuPoolExited) {
+    return EFI_NOT_FOUND;
+  }
+  if (mCpuPoolMpServices == NULL) {
+    *Processor = mCpuPoolBsp;
+    return EFI_SUCCESS;
+  }
+  if (EFI_ERROR(mCpuPoolMpServices->WhoAmI(mCpuPoolMpServices, Processor)) || (*Processor >= mCpuPoolProcessors)) {
+    return EFI_NOT_FOUND;
+  }
+  return EFI_SUCCESS;
+}
+// CpuPoolTake
+/// Atomically take every object from a list
+/// @param List The list
+/// @return The objects that were in the list or NULL if the list was empty
+STATIC
+EFI_CPU_POOL_OBJECT *
+EFIAPI
+CpuPoolTake (
+  IN OUT EFI_CPU_POOL_OBJECT * VOLATILE *List
+) {
+  EFI_CPU_POOL_OBJECT *Current;
+  do {
+    Current = *List;
+    if (Current == NULL) {
+      break;
+    }
+  } while ((UINTN)EfiCompareAndExchange((UINTN *)List, (UINTN)Current, 0) != (UINTN)Current);
+  return Current;
+}
+// CpuPoolPush
+/// Atomically push an object onto a list
+/// @param List   The list
+/// @param Object The object to push
+STATIC
+VOID
+EFIAPI
+CpuPoolPush (
+  IN OUT EFI_CPU_POOL_OBJECT * VOLATILE *List,
+  IN     EFI_CPU_POOL_OBJECT            *Object
+) {
+  EFI_CPU_POOL_OBJECT *Current;
+  do {
+    Current = *List;
+    Object->Next = Current;
+  } while ((UINTN)EfiCompareAndExchange((UINTN *)List, (UINTN)Current, (UINTN)Object) != (UINTN)Current);
+}
+// CpuPoolFillMagazine
+/// Allocate pages and carve them into a magazine of objects, must be called from the boot strap processor
+/// @param Processor The processor that will own the objects
+/// @param Class     The size class of the objects
+/// @param Magazine  On output, the list of objects
+/// @retval EFI_OUT_OF_RESOURCES The pages could not be allocated
+/// @retval EFI_SUCCESS          The magazine was filled
+STATIC
+EFI_STATUS
+EFIAPI
+CpuPoolFillMagazine (
+  IN  UINTN                 Processor,
+  IN  UINTN                 Class,
+  OUT EFI_CPU_POOL_OBJECT **Magazine
+) {
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Address = 0;
+  EFI_CPU_POOL_CHUNK   *Chunk;
+  EFI_CPU_POOL_OBJECT  *Object;
+  UINT8                *Memory;
+  UINTN                 Stride;
+  UINTN                 Pages;
+  UINTN                 Count;
+  // Allocate whole pages for at least the minimum number of objects
+  Stride = EFI_CPU_POOL_HEADER_SIZE + mCpuPoolSizes[Class];
+  Pages = EFI_SIZE_TO_PAGES(EFI_CPU_POOL_HEADER_SIZE + (Stride * EFI_CPU_POOL_MAGAZINE_MINIMUM));
+  Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Pages, &Address);
+  if (EFI_ERROR(Status) || (Address == 0)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Track the chunk so the pages can be freed
+  Chunk = (EFI_CPU_POOL_CHUNK *)(UINTN)Address;
+  Chunk->Pages = Pages;
+  Chunk->Next = mCpuPoolChunks;
+  mCpuPoolChunks = Chunk;
+  // Carve the rest of the pages into a list of objects
+  Memory = ((UINT8 *)Chunk) + EFI_CPU_POOL_HEADER_SIZE;
+  Count = (EFI_PAGES_TO_SIZE(Pages) - EFI_CPU_POOL_HEADER_SIZE) / Stride;
+  *Magazine = (EFI_CPU_POOL_OBJECT *)Memory;
+  while (Count-- != 0) {
+    Object = (EFI_CPU_POOL_OBJECT *)Memory;
+    Memory += Stride;
+    Object->Next = (Count != 0) ? (EFI_CPU_POOL_OBJECT *)Memory : NULL;
+    Object->Signature = EFI_CPU_POOL_SIGNATURE;
+    Object->Class = (UINT16)Class;
+    Object->Processor = (UINT16)Processor;
+  }
+  return EFI_SUCCESS;
+}
+// CpuPoolExitBootServices
+/// Stop using the multiprocessor services and the page allocator when exiting boot services so every allocation falls back to the caller
+/// @param ImageHandle The image handle
+/// @param Data        Unused
+/// @return EFI_SUCCESS so exiting boot services is never aborted
+STATIC
+EFI_STATUS
+EFIAPI
+CpuPoolExitBootServices (
+  IN EFI_HANDLE  ImageHandle,
+  IN VOID       *Data OPTIONAL
+) {
+  UNUSED_PARAMETER(ImageHandle);
+  UNUSED_PARAMETER(Data);
+  mCpuPoolExited = TRUE;
+  mCpuPoolMpServices = NULL;
+  return EFI_SUCCESS;
+}
+
+// EfiCpuPoolInitialize
+/// Initialize the per processor allocation caches and fill a magazine for every processor, must be called from the boot strap processor
+/// @retval EFI_UNSUPPORTED      Boot services were exited
+/// @retval EFI_OUT_OF_RESOURCES The caches could not be allocated
+/// @retval EFI_SUCCESS          The caches were initialized
+EFI_STATUS
+EFIAPI
+EfiCpuPoolInitialize (
+  VOID
+) {
+  EFI_MP_SERVICES_PROTOCOL *MpServices = NULL;
+  UINTN                     NumberOfProcessors = 1;
+  UINTN                     NumberOfEnabledProcessors = 1;
+  UINTN                     Bsp = 0;
+  UINTN                     Size;
+  if (mCpuPoolCaches != NULL) {
+    return EFI_SUCCESS;
+  }
+  if (mCpuPoolExited) {
+    return EFI_UNSUPPORTED;
+  }
+  // Locate the multiprocessor services protocol to identify the processors
+  if (EFI_ERROR(EfiLocateProtocol(&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices)) || (MpServices == NULL) ||
+      (MpServices->GetNumberOfProcessors == NULL) || (MpServices->WhoAmI == NULL) ||
+      EFI_ERROR(MpServices->GetNumberOfProcessors(MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors)) ||
+      EFI_ERROR(MpServices->WhoAmI(MpServices, &Bsp)) || (NumberOfProcessors <= 1) || (NumberOfProcessors > MAX_UINT16) || (Bsp >= NumberOfProcessors)) {
+    MpServices = NULL;
+    NumberOfProcessors = 1;
+    Bsp = 0;
+  }
+  // Allocate a cache line for each size class of each processor
+  Size = NumberOfProcessors * ARRAY_COUNT(mCpuPoolSizes) * EFI_PARALLEL_CACHE_LINE_SIZE;
+  mCpuPoolBuffer = EfiAllocate(Size + EFI_PARALLEL_CACHE_LINE_SIZE);
+  if (mCpuPoolBuffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  EfiZeroMem(mCpuPoolBuffer, Size + EFI_PARALLEL_CACHE_LINE_SIZE);
+  mCpuPoolCaches = (UINT8 *)((((UINTN)mCpuPoolBuffer) + (EFI_PARALLEL_CACHE_LINE_SIZE - 1)) & ~((UINTN)(EFI_PARALLEL_CACHE_LINE_SIZE - 1)));
+  mCpuPoolMpServices = MpServices;
+  mCpuPoolProcessors = NumberOfProcessors;
+  mCpuPoolBsp = Bsp;
+  // Stop using boot services once they are exited, the callback is registered once since it can not be removed
+  if (!mCpuPoolExitRegistered) {
+    mCpuPoolExitRegistered = !EFI_ERROR(EfiExitBootServicesCallback(CpuPoolExitBootServices, NULL));
+  }
+  LOG(L"CPU pool: %u processors, %u size classes up to %u bytes\n", mCpuPoolProcessors, ARRAY_COUNT(mCpuPoolSizes), EFI_CPU_POOL_MAXIMUM_SIZE);
+  // Fill a magazine for every cache
+  return EfiCpuPoolRefill();
+}
+// EfiCpuPoolUninitialize
+/// Free the per processor allocation caches and all the pages backing them, must be called from the boot strap processor when no other processor uses the caches
+/// @retval EFI_SUCCESS The caches were freed
+EFI_STATUS
+EFIAPI
+EfiCpuPoolUninitialize (
+  VOID
+) {
+  EFI_CPU_POOL_CHUNK *Chunk;
+  // Free the pages backing the magazines, which is not possible once boot services are exited
+  while ((mCpuPoolChunks != NULL) && !mCpuPoolExited) {
+    Chunk = mCpuPoolChunks;
+    mCpuPoolChunks = Chunk->Next;
+    EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)Chunk, Chunk->Pages);
+  }
+  mCpuPoolChunks = NULL;
+  // Free the caches
+  if ((mCpuPoolBuffer != NULL) && !mCpuPoolExited) {
+    EfiFreePool(mCpuPoolBuffer);
+  }
+  mCpuPoolBuffer = NULL;
+  mCpuPoolCaches = NULL;
+  mCpuPoolMpServices = NULL;
+  mCpuPoolProcessors = 0;
+  mCpuPoolBsp = 0;
+  return EFI_SUCCESS;
+}
+// EfiCpuPoolRefill
+/// Fill a magazine for every processor cache that has taken its last magazine, must be called from the boot strap processor
+/// @retval EFI_NOT_READY        The caches are not initialized or boot services were exited
+/// @retval EFI_OUT_OF_RESOURCES Not every cache could be refilled
+/// @retval EFI_SUCCESS          Every cache has a magazine
+EFI_STATUS
+EFIAPI
+EfiCpuPoolRefill (
+  VOID
+) {
+  EFI_STATUS           Status = EFI_SUCCESS;
+  EFI_CPU_POOL_CACHE  *Cache;
+  EFI_CPU_POOL_OBJECT *Magazine;
+  UINTN                Processor;
+  UINTN                Class;
+  if ((mCpuPoolCaches == NULL) || mCpuPoolExited) {
+    return EFI_NOT_READY;
+  }
+  for (Processor = 0; Processor < mCpuPoolProcessors; ++Processor) {
+    for (Class = 0; Class < ARRAY_COUNT(mCpuPoolSizes); ++Class) {
+      Cache = CpuPoolGetCache(Processor, Class);
+      // Only the boot strap processor fills magazines so an empty magazine stays empty until it is published
+      if (Cache->Magazine == NULL) {
+        if (EFI_ERROR(CpuPoolFillMagazine(Processor, Class, &Magazine))) {
+          Status = EFI_OUT_OF_RESOURCES;
+        } else {
+          EfiCompareAndExchange((UINTN *)&(Cache->Magazine), 0, (UINTN)Magazine);
+        }
+      }
+    }
+  }
+  return Status;
+}
+
+// EfiCpuPoolAllocate
+/// Allocate a small object from the cache of the calling processor, may be called from any processor
+/// @param Size The size in bytes to allocate, which must not be more than EFI_CPU_POOL_MAXIMUM_SIZE
+/// @return The allocated object or NULL if the cache is empty until the boot strap processor refills it or boot services were exited, the caller then allocates another way
+VOID *
+EFIAPI
+EfiCpuPoolAllocate (
+  IN UINTN Size
+) {
+  EFI_CPU_POOL_CACHE  *Cache;
+  EFI_CPU_POOL_OBJECT *Object;
+  UINTN                Processor = 0;
+  UINTN                Class = 0;
+  if ((mCpuPoolCaches == NULL) || (Size > EFI_CPU_POOL_MAXIMUM_SIZE) || EFI_ERROR(CpuPoolWhoAmI(&Processor))) {
+    return NULL;
+  }
+  // Find the smallest size class for the size
+  while (mCpuPoolSizes[Class] < Size) {
+    ++Class;
+  }
+  Cache = CpuPoolGetCache(Processor, Class);
+  Object = Cache->Free;
+  if (Object == NULL) {
+    // Take the objects freed by other processors then the reserve magazine
+    Object = CpuPoolTake(&(Cache->Return));
+    if (Object == NULL) {
+      Object = CpuPoolTake(&(Cache->Magazine));
+      if ((Object == NULL) && ((Processor != mCpuPoolBsp) || EFI_ERROR(CpuPoolFillMagazine(Processor, Class, &Object)))) {
+        // Application processors wait for the boot strap processor to refill the magazine
+        return NULL;
+      }
+    }
+  }
+  // Remove the object from the free list
+  Cache->Free = Object->Next;
+  Object->Next = NULL;
+  return (VOID *)(((UINT8 *)Object) + EFI_CPU_POOL_HEADER_SIZE);
+}
+// EfiCpuPoolFree
+/// Free a small object to the cache of the processor that allocated it, may be called from any processor
+/// @param Buffer The object to free
+/// @retval EFI_INVALID_PARAMETER If Buffer is NULL or was not allocated with EfiCpuPoolAllocate
+/// @retval EFI_NOT_READY         The caches are not initialized
+/// @retval EFI_SUCCESS           The object was freed
+EFI_STATUS
+EFIAPI
+EfiCpuPoolFree (
+  IN VOID *Buffer
+) {
+  EFI_CPU_POOL_CACHE  *Cache;
+  EFI_CPU_POOL_OBJECT *Object;
+  UINTN                Processor = 0;
+  if (Buffer == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (mCpuPoolCaches == NULL) {
+    return EFI_NOT_READY;
+  }
+  // Check the object header
+  Object = (EFI_CPU_POOL_OBJECT *)(((UINT8 *)Buffer) - EFI_CPU_POOL_HEADER_SIZE);
+  if ((Object->Signature != EFI_CPU_POOL_SIGNATURE) || (Object->Class >= ARRAY_COUNT(mCpuPoolSizes)) || (Object->Processor >= mCpuPoolProcessors)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Cache = CpuPoolGetCache(Object->Processor, Object->Class);
+  if (!EFI_ERROR(CpuPoolWhoAmI(&Processor)) && (Processor == Object->Processor)) {
+    // Free to the cache of this processor
+    Object->Next = Cache->Free;
+    Cache->Free = Object;
+  } else {
+    // Return the object to the owning processor
+    CpuPoolPush(&(Cache->Return), Object);
+  }
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,2269 @@
+///
+/// @file Library/Uefi/Dispatch.c
+///
+/// UEFI CPU feature kernel dispatch
+///
+
+#include <Uefi.h>
+
+#include <Cpu/Cpu.h>
+
+// EFI_DISPATCH_KERNEL
+/// A generic dispatch table kernel used for selection
+typedef VOID (EFIAPI *EFI_DISPATCH_KERNEL) (VOID);
+
+// EFI_DISPATCH_SLOT
+/// A dispatch table slot description
+typedef struct EFI_DISPATCH_SLOT EFI_DISPATCH_SLOT;
+struct EFI_DISPATCH_SLOT {
+
+  // Name
+  /// The name of the slot
+  CONST CHAR16 *Name;
+  // Offset
+  /// The offset in bytes of the slot in the dispatch table
+  UINTN         Offset;
+
+};
+
+// StrLenScalar
+/// Get the length of a character string
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+STATIC
+UINTN
+EFIAPI
+StrLenScalar (
+  IN CONST CHAR16 *Str
+) {
+  CONST CHAR16 *Ptr = Str;
+  while (*Ptr != 0) {
+    ++Ptr;
+  }
+  return Ptr - Str;
+}
+// StrCmpScalar
+/// Performs a comparison of two strings
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+STATIC
+INTN
+EFIAPI
+StrCmpScalar (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+) {
+  while (*Str1 != 0) {
+    if (*Str1 != *Str2) {
+      break;
+    }
+    ++Str1;
+    ++Str2;
+  }
+  return *Str1 - *Str2;
+}
+// StrnCmpScalar
+/// Performs a comparison of at most a count of characters of two strings
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+STATIC
+INTN
+EFIAPI
+StrnCmpScalar (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2,
+  IN UINTN         Count
+) {
+  if (Count == 0) {
+    return 0;
+  }
+  while ((*Str1 != 0) && (*Str1 == *Str2) && (Count-- > 1)) {
+    ++Str1;
+    ++Str2;
+  }
+  return *Str1 - *Str2;
+}
+// StrStrScalar
+/// Returns the first occurrence of a sub-string in a string
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+STATIC
+CHAR16 *
+EFIAPI
+StrStrScalar (
+  IN CONST CHAR16 *String,
+  IN CONST CHAR16 *SearchString
+) {
+  CONST CHAR16 *Ptr;
+  CONST CHAR16 *Search;
+  // Check each position for a match of the sub-string
+  for (; *String != 0; ++String) {
+    if (*String != *SearchString) {
+      continue;
+    }
+    Ptr = String;
+    Search = SearchString;
+    while ((*Search != 0) && (*Ptr == *Search)) {
+      ++Ptr;
+      ++Search;
+    }
+    if (*Search == 0) {
+      return (CHAR16 *)String;
+    }
+    if (*Ptr == 0) {
+      break;
+    }
+  }
+  return NULL;
+}
+// StriPrefixScalar
+/// Get the count of leading characters of two strings that are ASCII, not null and equal ignoring case
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @return The count of leading characters that are ASCII, not null and equal ignoring case
+STATIC
+UINTN
+EFIAPI
+StriPrefixScalar (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+) {
+  UINTN  Count = 0;
+  CHAR16 Char1;
+  CHAR16 Char2;
+  while (((Char1 = Str1[Count]) != 0) && (Char1 < 0x80)) {
+    Char2 = Str2[Count];
+    if (Char1 != Char2) {
+      // Only letters that differ by the case bit may still match
+      if (((Char1 ^ Char2) != 0x20) || (((UINTN)(Char1 | 0x20) - 'a') >= 26)) {
+        break;
+      }
+    }
+    ++Count;
+  }
+  return Count;
+}
+// AsciiStrLenScalar
+/// Get the length of a character string
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+STATIC
+UINTN
+EFIAPI
+AsciiStrLenScalar (
+  IN CONST CHAR8 *Str
+) {
+  CONST CHAR8 *Ptr = Str;
+  while (*Ptr != 0) {
+    ++Ptr;
+  }
+  return Ptr - Str;
+}
+// AsciiStrCmpScalar
+/// Performs a comparison of two strings
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+STATIC
+INTN
+EFIAPI
+AsciiStrCmpScalar (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2
+) {
+  while (*Str1 != 0) {
+    if (*Str1 != *Str2) {
+      break;
+    }
+    ++Str1;
+    ++Str2;
+  }
+  return *Str1 - *Str2;
+}
+// AsciiStrnCmpScalar
+/// Performs a comparison of at most a count of characters of two strings
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+STATIC
+INTN
+EFIAPI
+AsciiStrnCmpScalar (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2,
+  IN UINTN        Count
+) {
+  if (Count == 0) {
+    return 0;
+  }
+  while ((*Str1 != 0) && (*Str1 == *Str2) && (Count-- > 1)) {
+    ++Str1;
+    ++Str2;
+  }
+  return *Str1 - *Str2;
+}
+// AsciiStrStrScalar
+/// Returns the first occurrence of a sub-string in a string
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+STATIC
+CHAR8 *
+EFIAPI
+AsciiStrStrScalar (
+  IN CONST CHAR8 *String,
+  IN CONST CHAR8 *SearchString
+) {
+  CONST CHAR8 *Ptr;
+  CONST CHAR8 *Search;
+  // Check each position for a match of the sub-string
+  for (; *String != 0; ++String) {
+    if (*String != *SearchString) {
+      continue;
+    }
+    Ptr = String;
+    Search = SearchString;
+    while ((*Search != 0) && (*Ptr == *Search)) {
+      ++Ptr;
+      ++Search;
+    }
+    if (*Search == 0) {
+      return (CHAR8 *)String;
+    }
+    if (*Ptr == 0) {
+      break;
+    }
+  }
+  return NULL;
+}
+// CopyMemScalar
+/// Copy the contents of one buffer to another buffer, the buffers may overlap
+/// @param Destination The destination buffer of the memory copy
+/// @param Source      The source buffer of the memory copy
+/// @param Length      The size in bytes to copy from Source to Destination
+STATIC
+VOID
+EFIAPI
+CopyMemScalar (
+  OUT VOID       *Destination,
+  IN  CONST VOID *Source,
+  IN  UINTN       Length
+) {
+  UINT8       *Dst = (UINT8 *)Destination;
+  CONST UINT8 *Src = (CONST UINT8 *)Source;
+  BOOLEAN      Aligned;
+  // Copy in words when the buffers have the same alignment, boot services are not used since this may run on application processors or after exiting boot services
+  Aligned = ((((UINTN)Dst ^ (UINTN)Src) & (sizeof(UINTN) - 1)) == 0) ? TRUE : FALSE;
+  if ((Dst > Src) && (Dst < (Src + Length))) {
+    // Copy backward when the destination overlaps the end of the source
+    Dst += Length;
+    Src += Length;
+    if (Aligned) {
+      while ((Length != 0) && ((((UINTN)Dst) & (sizeof(UINTN) - 1)) != 0)) {
+        *--Dst = *--Src;
+        --Length;
+      }
+      while (Length >= sizeof(UINTN)) {
+        Dst -= sizeof(UINTN);
+        Src -= sizeof(UINTN);
+        *(UINTN *)Dst = *(CONST UINTN *)Src;
+        Length -= sizeof(UINTN);
+      }
+    }
+    while (Length-- != 0) {
+      *--Dst = *--Src;
+    }
+  } else {
+    // Copy forward
+    if (Aligned) {
+      while ((Length != 0) && ((((UINTN)Dst) & (sizeof(UINTN) - 1)) != 0)) {
+        *Dst++ = *Src++;
+        --Length;
+      }
+      while (Length >= sizeof(UINTN)) {
+        *(UINTN *)Dst = *(CONST UINTN *)Src;
+        Dst += sizeof(UINTN);
+        Src += sizeof(UINTN);
+        Length -= sizeof(UINTN);
+      }
+    }
+    while (Length-- != 0) {
+      *Dst++ = *Src++;
+    }
+  }
+}
+// SetMemScalar
+/// Fill a buffer with a specified value
+/// @param Buffer The buffer to fill
+/// @param Size   The size in bytes of the Buffer to fill
+/// @param Value  The value with which to fill Buffer
+STATIC
+VOID
+EFIAPI
+SetMemScalar (
+  OUT VOID  *Buffer,
+  IN  UINTN  Size,
+  IN  UINT8  Value
+) {
+  UINT8 *Ptr = (UINT8 *)Buffer;
+  UINTN  Pattern;
+  // Fill in words once aligned, boot services are not used since this may run on application processors or after exiting boot services
+  while ((Size != 0) && ((((UINTN)Ptr) & (sizeof(UINTN) - 1)) != 0)) {
+    *Ptr++ = Value;
+    --Size;
+  }
+  Pattern = (MAX_UINTN / 0xFF) * Value;
+  while (Size >= sizeof(UINTN)) {
+    *(UINTN *)Ptr = Pattern;
+    Ptr += sizeof(UINTN);
+    Size -= sizeof(UINTN);
+  }
+  while (Size-- != 0) {
+    *Ptr++ = Value;
+  }
+}
+// AsciiToUtf16Scalar
+/// Widen the leading run of ASCII characters from a UTF-8 buffer to UTF-16
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The UTF-8 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the first byte that is not ASCII or is the null terminator
+STATIC
+UINTN
+EFIAPI
+AsciiToUtf16Scalar (
+  OUT CHAR16      *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Input[Index] == 0) || ((Input[Index] & 0x80) != 0)) {
+      break;
+    }
+    Output[Index] = (CHAR16)Input[Index];
+  }
+  return Index;
+}
+// Utf16ToAsciiScalar
+/// Narrow the leading run of ASCII characters from a UTF-16 buffer to UTF-8
+/// @param Output The UTF-8 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that is not ASCII or is the null terminator
+STATIC
+UINTN
+EFIAPI
+Utf16ToAsciiScalar (
+  OUT CHAR8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+) {
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Input[Index] == 0) || (Input[Index] >= 0x80)) {
+      break;
+    }
+    Output[Index] = (CHAR8)Input[Index];
+  }
+  return Index;
+}
+// Latin1ToUtf16Scalar
+/// Widen the leading run of characters from a Latin-1 buffer to UTF-16
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The Latin-1 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the null terminator
+STATIC
+UINTN
+EFIAPI
+Latin1ToUtf16Scalar (
+  OUT CHAR16      *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    if (Input[Index] == 0) {
+      break;
+    }
+    Output[Index] = (CHAR16)Input[Index];
+  }
+  return Index;
+}
+// Utf16ToLatin1Scalar
+/// Narrow the leading run of Latin-1 characters from a UTF-16 buffer to Latin-1
+/// @param Output The Latin-1 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character above U+00FF or the null terminator
+STATIC
+UINTN
+EFIAPI
+Utf16ToLatin1Scalar (
+  OUT UINT8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+) {
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Input[Index] == 0) || (Input[Index] > 0xFF)) {
+      break;
+    }
+    Output[Index] = (UINT8)Input[Index];
+  }
+  return Index;
+}
+// Utf16ToSwappedScalar
+/// Swap the byte order of the leading run of UTF-16 characters that need no validation, checking the characters before they are swapped
+/// @param Output The output buffer, which must have room for Count characters
+/// @param Input  The input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that needs validation or is the null terminator
+STATIC
+UINTN
+EFIAPI
+Utf16ToSwappedScalar (
+  OUT CHAR16       *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+) {
+  UINTN Index;
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Input[Index] == 0) || (Input[Index] > 0x377)) {
+      break;
+    }
+    Output[Index] = (CHAR16)((Input[Index] << 8) | (Input[Index] >> 8));
+  }
+  return Index;
+}
+// SwappedToUtf16Scalar
+/// Swap the byte order of the leading run of UTF-16 characters that need no validation, checking the characters after they are swapped
+/// @param Output The output buffer, which must have room for Count characters
+/// @param Input  The input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that needs validation or is the null terminator
+STATIC
+UINTN
+EFIAPI
+SwappedToUtf16Scalar (
+  OUT CHAR16       *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+) {
+  UINTN  Index;
+  CHAR16 Character;
+  for (Index = 0; Index < Count; ++Index) {
+    Character = (CHAR16)((Input[Index] << 8) | (Input[Index] >> 8));
+    if ((Character == 0) || (Character > 0x377)) {
+      break;
+    }
+    Output[Index] = Character;
+  }
+  return Index;
+}
+// Utf8ValidateRun
+/// Validate the run of well formed UTF-8 characters that starts at an offset and count them
+/// @param Input  The UTF-8 input buffer
+/// @param Size   The size in bytes of the input buffer
+/// @param Offset The offset in bytes of the start of a character in the input buffer at which to start validating
+/// @param Count  On input, the count of characters before the offset, on output, the count of characters in the whole run
+/// @return The size in bytes of the whole run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateRun (
+  IN     CONST UINT8 *Input,
+  IN     UINTN        Size,
+  IN     UINTN        Offset,
+  IN OUT UINTN       *Count
+) {
+  UINTN Length;
+  UINTN Index;
+  UINT8 Lower;
+  UINT8 Upper;
+  while (Offset < Size) {
+    // Get the length of the sequence and the range of the first trailing unit that excludes overlong, surrogate, and out of range sequences
+    Lower = 0x80;
+    Upper = 0xBF;
+    if (Input[Offset] == 0) {
+      break;
+    } else if (Input[Offset] < 0x80) {
+      Length = 1;
+    } else if ((Input[Offset] >= 0xC2) && (Input[Offset] <= 0xDF)) {
+      Length = 2;
+    } else if ((Input[Offset] >= 0xE0) && (Input[Offset] <= 0xEF)) {
+      Length = 3;
+      if (Input[Offset] == 0xE0) {
+        Lower = 0xA0;
+      } else if (Input[Offset] == 0xED) {
+        Upper = 0x9F;
+      }
+    } else if ((Input[Offset] >= 0xF0) && (Input[Offset] <= 0xF4)) {
+      Length = 4;
+      if (Input[Offset] == 0xF0) {
+        Lower = 0x90;
+      } else if (Input[Offset] == 0xF4) {
+        Upper = 0x8F;
+      }
+    } else {
+      break;
+    }
+    if ((Size - Offset) < Length) {
+      break;
+    }
+    // Check the trailing units
+    for (Index = 1; Index < Length; ++Index) {
+      if ((Input[Offset + Index] < Lower) || (Input[Offset + Index] > Upper)) {
+        break;
+      }
+      Lower = 0x80;
+      Upper = 0xBF;
+    }
+    if (Index < Length) {
+      break;
+    }
+    Offset += Length;
+    ++(*Count);
+  }
+  return Offset;
+}
+// Utf8ValidateScalar
+/// Validate the leading run of well formed UTF-8 characters and count them
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateScalar (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+) {
+  *Count = 0;
+  return Utf8ValidateRun(Input, Size, 0, Count);
+}
+// Utf8ValidateFinish
+/// Finish validating a UTF-8 buffer after validating leading blocks
+/// @param Input     The UTF-8 input buffer
+/// @param Size      The size in bytes of the input buffer
+/// @param Validated The size in bytes of the validated leading blocks, which may end within a character
+/// @param Count     On input, the count of bytes that start a character in the validated blocks, on output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateFinish (
+  IN     CONST UINT8 *Input,
+  IN     UINTN        Size,
+  IN     UINTN        Validated,
+  IN OUT UINTN       *Count
+) {
+  UINTN Index;
+  UINTN Length;
+  // Back up to the start of a character that the validated blocks ended within
+  for (Index = Validated; (Index > 0) && ((Validated - Index) < 4); --Index) {
+    if (Input[Index - 1] < 0x80) {
+      break;
+    }
+    if (Input[Index - 1] >= 0xC0) {
+      Length = (Input[Index - 1] >= 0xF0) ? 4 : ((Input[Index - 1] >= 0xE0) ? 3 : 2);
+      if (((Index - 1) + Length) > Validated) {
+        Validated = Index - 1;
+        --(*Count);
+      }
+      break;
+    }
+  }
+  // Validate the rest of the characters
+  return Utf8ValidateRun(Input, Size, Validated, Count);
+}
+
+// gEfiBase64Dictionary
+/// The base64 encoding dictionary
+CONST CHAR8 gEfiBase64Dictionary[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// gEfiBase64DecodeTable
+/// The six bit value of each base64 character or the kind of the other characters
+CONST UINT8 gEfiBase64DecodeTable[256] = {
+  EFI_BASE64_END, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_SPACE, EFI_BASE64_SPACE, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_SPACE, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_SPACE, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, 62, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, 63,
+  52, 53, 54, 55, 56, 57, 58, 59, 60, 61, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_PAD, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+  41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID,
+  EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID, EFI_BASE64_INVALID
+};
+
+// Base64EncodeScalar
+/// Encode complete three byte blocks of data to base64 characters
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is always a multiple of three
+STATIC
+UINTN
+EFIAPI
+Base64EncodeScalar (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+) {
+  UINTN  Index;
+  UINT32 Block;
+  Size -= (Size % 3);
+  for (Index = 0; Index < Size; Index += 3) {
+    Block = ((UINT32)Input[Index] << 16) | ((UINT32)Input[Index + 1] << 8) | (UINT32)Input[Index + 2];
+    *Output++ = gEfiBase64Dictionary[(Block >> 18) & 0x3F];
+    *Output++ = gEfiBase64Dictionary[(Block >> 12) & 0x3F];
+    *Output++ = gEfiBase64Dictionary[(Block >> 6) & 0x3F];
+    *Output++ = gEfiBase64Dictionary[Block & 0x3F];
+  }
+  return Size;
+}
+// Base64DecodeScalar
+/// Decode complete four character blocks of base64 characters to data
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is always a multiple of four
+STATIC
+UINTN
+EFIAPI
+Base64DecodeScalar (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN  Index;
+  UINTN  Offset;
+  UINT32 Block;
+  UINT8  Value;
+  // Decode each complete block, stopping at any character that is not a six bit value
+  Count -= (Count % 4);
+  for (Index = 0; Index < Count; Index += 4) {
+    Block = 0;
+    for (Offset = 0; Offset < 4; ++Offset) {
+      Value = gEfiBase64DecodeTable[(UINT8)Input[Index + Offset]];
+      if (Value > 0x3F) {
+        return Index;
+      }
+      Block = (Block << 6) | Value;
+    }
+    *Output++ = (UINT8)(Block >> 16);
+    *Output++ = (UINT8)(Block >> 8);
+    *Output++ = (UINT8)Block;
+  }
+  return Count;
+}
+// Crc32Scalar
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer eight bytes at a time with slicing tables
+/// @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer
+/// @return The updated 32-bit CRC
+STATIC
+UINT32
+EFIAPI
+Crc32Scalar (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+) {
+  STATIC BOOLEAN  NotBuilt = TRUE;
+  STATIC UINT32   Table[8][256];
+  CONST UINT8    *Ptr = (CONST UINT8 *)Data;
+  UINT32          Index;
+  UINT32          Bit;
+  UINT32          Value;
+  UINT32          Low;
+  UINT32          High;
+  // Build the reflected polynomial table and the tables for each byte further from the end of a slice once
+  if (NotBuilt) {
+    for (Index = 0; Index < ARRAY_COUNT(Table[0]); ++Index) {
+      Value = Index;
+      for (Bit = 0; Bit < 8; ++Bit) {
+        Value = (Value >> 1) ^ (((Value & 1) != 0) ? 0xEDB88320 : 0);
+      }
+      Table[0][Index] = Value;
+    }
+    for (Bit = 1; Bit < ARRAY_COUNT(Table); ++Bit) {
+      for (Index = 0; Index < ARRAY_COUNT(Table[0]); ++Index) {
+        Table[Bit][Index] = (Table[Bit - 1][Index] >> 8) ^ Table[0][Table[Bit - 1][Index] & 0xFF];
+      }
+    }
+    NotBuilt = FALSE;
+  }
+  // Update the CRC with each eight byte slice
+  Crc32 = ~Crc32;
+  while (Size >= 8) {
+    Low = Crc32 ^ ((UINT32)Ptr[0] | ((UINT32)Ptr[1] << 8) | ((UINT32)Ptr[2] << 16) | ((UINT32)Ptr[3] << 24));
+    High = (UINT32)Ptr[4] | ((UINT32)Ptr[5] << 8) | ((UINT32)Ptr[6] << 16) | ((UINT32)Ptr[7] << 24);
+    Crc32 = Table[7][Low & 0xFF] ^ Table[6][(Low >> 8) & 0xFF] ^ Table[5][(Low >> 16) & 0xFF] ^ Table[4][Low >> 24] ^
+            Table[3][High & 0xFF] ^ Table[2][(High >> 8) & 0xFF] ^ Table[1][(High >> 16) & 0xFF] ^ Table[0][High >> 24];
+    Ptr += 8;
+    Size -= 8;
+  }
+  // Update the CRC with each remaining byte
+  while (Size-- != 0) {
+    Crc32 = (Crc32 >> 8) ^ Table[0][(Crc32 ^ *Ptr++) & 0xFF];
+  }
+  return ~Crc32;
+}
+// HashAccumulateScalar
+/// Accumulate sixty four byte stripes of data into the eight 64-bit hash accumulators, each stripe is keyed by the secret eight bytes further on
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Data         The data buffer
+/// @param Stripes      The count of sixty four byte stripes of the data buffer
+/// @param Secret       The secret of the first stripe, which must have (Stripes * 8) + 56 bytes
+STATIC
+VOID
+EFIAPI
+HashAccumulateScalar (
+  IN OUT UINT64     *Accumulators,
+  IN     CONST VOID *Data,
+  IN     UINTN       Stripes,
+  IN     CONST VOID *Secret
+) {
+  CONST UINT8 *Ptr = (CONST UINT8 *)Data;
+  CONST UINT8 *Key = (CONST UINT8 *)Secret;
+  UINTN        Index;
+  UINTN        Byte;
+  UINT64       Value;
+  UINT64       Keyed;
+  for (; Stripes != 0; --Stripes) {
+    // Each lane adds the product of the halves of the keyed data and the data of the neighbouring lane
+    for (Index = 0; Index < 8; ++Index) {
+      Value = 0;
+      Keyed = 0;
+      for (Byte = 8; Byte-- != 0;) {
+        Value = (Value << 8) | Ptr[(Index * 8) + Byte];
+        Keyed = (Keyed << 8) | Key[(Index * 8) + Byte];
+      }
+      Keyed ^= Value;
+      Accumulators[Index ^ 1] += Value;
+      Accumulators[Index] += (Keyed & 0xFFFFFFFF) * (Keyed >> 32);
+    }
+    Ptr += 64;
+    Key += 8;
+  }
+}
+
+// EFI_DISPATCH_DIVIDE_255
+/// Divide a blended color product by 255 with rounding
+#define EFI_DISPATCH_DIVIDE_255(Value) ((((Value) + 128) + (((Value) + 128) >> 8)) >> 8)
+
+// BlitScalar
+/// Copy a rectangle of pixels
+/// @param Destination       The destination pixels
+/// @param DestinationStride The count of pixels in each row of the destination
+/// @param Source            The source pixels
+/// @param SourceStride      The count of pixels in each row of the source
+/// @param Width             The width in pixels of the rectangle
+/// @param Height            The height in pixels of the rectangle
+STATIC
+VOID
+EFIAPI
+BlitScalar (
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL       *Destination,
+  IN  UINTN                                DestinationStride,
+  IN  CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Source,
+  IN  UINTN                                SourceStride,
+  IN  UINTN                                Width,
+  IN  UINTN                                Height
+) {
+  UINTN Row;
+  for (Row = 0; Row < Height; ++Row) {
+    EfiDispatch()->CopyMem(Destination, Source, Width * sizeof(EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+    Destination += DestinationStride;
+    Source += SourceStride;
+  }
+}
+// AlphaBlendScalar
+/// Blend a rectangle of pixels over another using the reserved member of the source pixels as alpha
+/// @param Destination       The destination pixels
+/// @param DestinationStride The count of pixels in each row of the destination
+/// @param Source            The source pixels
+/// @param SourceStride      The count of pixels in each row of the source
+/// @param Width             The width in pixels of the rectangle
+/// @param Height            The height in pixels of the rectangle
+STATIC
+VOID
+EFIAPI
+AlphaBlendScalar (
+  IN OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL       *Destination,
+  IN     UINTN                                DestinationStride,
+  IN     CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Source,
+  IN     UINTN                                SourceStride,
+  IN     UINTN                                Width,
+  IN     UINTN                                Height
+) {
+  UINTN  Row;
+  UINTN  Column;
+  UINT32 Alpha;
+  UINT32 Inverse;
+  for (Row = 0; Row < Height; ++Row) {
+    for (Column = 0; Column < Width; ++Column) {
+      Alpha = Source[Column].Reserved;
+      if (Alpha == 0xFF) {
+        // Opaque source replaces the destination
+        Destination[Column] = Source[Column];
+      } else if (Alpha != 0) {
+        // Blend the source over the destination
+        Inverse = 0xFF - Alpha;
+        Destination[Column].Blue = (UINT8)EFI_DISPATCH_DIVIDE_255((Source[Column].Blue * Alpha) + (Destination[Column].Blue * Inverse));
+        Destination[Column].Green = (UINT8)EFI_DISPATCH_DIVIDE_255((Source[Column].Green * Alpha) + (Destination[Column].Green * Inverse));
+        Destination[Column].Red = (UINT8)EFI_DISPATCH_DIVIDE_255((Source[Column].Red * Alpha) + (Destination[Column].Red * Inverse));
+        Destination[Column].Reserved = (UINT8)(Alpha + EFI_DISPATCH_DIVIDE_255(Destination[Column].Reserved * Inverse));
+      }
+    }
+    Destination += DestinationStride;
+    Source += SourceStride;
+  }
+}
+
+#if defined(EFI_ARCH_X64)
+
+// StrLenSse2
+/// Get the length of a character string with SSE2
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+StrLenSse2 (
+  IN CONST CHAR16 *Str
+);
+// StrLenAvx2
+/// Get the length of a character string with AVX2
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+StrLenAvx2 (
+  IN CONST CHAR16 *Str
+);
+// AsciiStrLenSse2
+/// Get the length of a character string with SSE2
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+AsciiStrLenSse2 (
+  IN CONST CHAR8 *Str
+);
+// AsciiStrLenAvx2
+/// Get the length of a character string with AVX2
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+AsciiStrLenAvx2 (
+  IN CONST CHAR8 *Str
+);
+// StrCmpSse2
+/// Performs a comparison of two strings with SSE2
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+StrCmpSse2 (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+);
+// StrCmpAvx2
+/// Performs a comparison of two strings with AVX2
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+StrCmpAvx2 (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+);
+// StrnCmpSse2
+/// Performs a comparison of at most a count of characters of two strings with SSE2
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+StrnCmpSse2 (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2,
+  IN UINTN         Count
+);
+// StrStrSse4_2
+/// Returns the first occurrence of a sub-string in a string with SSE4.2
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+EXTERN
+CHAR16 *
+EFIAPI
+StrStrSse4_2 (
+  IN CONST CHAR16 *String,
+  IN CONST CHAR16 *SearchString
+);
+// StriPrefixSse2
+/// Get the count of leading characters of two strings that are ASCII, not null and equal ignoring case with SSE2
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @return The count of leading characters that are ASCII, not null and equal ignoring case
+EXTERN
+UINTN
+EFIAPI
+StriPrefixSse2 (
+  IN CONST CHAR16 *Str1,
+  IN CONST CHAR16 *Str2
+);
+// AsciiStrCmpSse2
+/// Performs a comparison of two strings with SSE2
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+AsciiStrCmpSse2 (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2
+);
+// AsciiStrCmpAvx2
+/// Performs a comparison of two strings with AVX2
+/// @param Str1 The first string to compare, which must not be NULL
+/// @param Str2 The second string to compare, which must not be NULL
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+AsciiStrCmpAvx2 (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2
+);
+// AsciiStrnCmpSse2
+/// Performs a comparison of at most a count of characters of two strings with SSE2
+/// @param Str1  The first string to compare, which must not be NULL
+/// @param Str2  The second string to compare, which must not be NULL
+/// @param Count The maximum count of characters to compare
+/// @retval 0  Str1 is equivalent to Str2
+/// @retval >0 Str1 is lexically greater than Str2
+/// @retval <0 Str1 is lexically less than Str2
+EXTERN
+INTN
+EFIAPI
+AsciiStrnCmpSse2 (
+  IN CONST CHAR8 *Str1,
+  IN CONST CHAR8 *Str2,
+  IN UINTN        Count
+);
+// AsciiStrStrSse4_2
+/// Returns the first occurrence of a sub-string in a string with SSE4.2
+/// @param String       The string to search, which must not be NULL
+/// @param SearchString The sub-string for which to search, which must not be NULL or empty
+/// @return A pointer to the matched sub-string in String or NULL if SearchString was not found
+EXTERN
+CHAR8 *
+EFIAPI
+AsciiStrStrSse4_2 (
+  IN CONST CHAR8 *String,
+  IN CONST CHAR8 *SearchString
+);
+// CopyMemSse2
+/// Copy the contents of one buffer to another buffer with SSE2, the buffers may overlap
+/// @param Destination The destination buffer of the memory copy
+/// @param Source      The source buffer of the memory copy
+/// @param Length      The size in bytes to copy from Source to Destination
+EXTERN
+VOID
+EFIAPI
+CopyMemSse2 (
+  OUT VOID       *Destination,
+  IN  CONST VOID *Source,
+  IN  UINTN       Length
+);
+// SetMemSse2
+/// Fill a buffer with a specified value with SSE2
+/// @param Buffer The buffer to fill
+/// @param Size   The size in bytes of the Buffer to fill
+/// @param Value  The value with which to fill Buffer
+EXTERN
+VOID
+EFIAPI
+SetMemSse2 (
+  OUT VOID  *Buffer,
+  IN  UINTN  Size,
+  IN  UINT8  Value
+);
+// AsciiToUtf16Sse2
+/// Widen the leading run of ASCII characters from a UTF-8 buffer to UTF-16 with SSE2
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The UTF-8 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the first byte that is not ASCII or is the null terminator
+EXTERN
+UINTN
+EFIAPI
+AsciiToUtf16Sse2 (
+  OUT CHAR16      *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// Utf16ToAsciiSse2
+/// Narrow the leading run of ASCII characters from a UTF-16 buffer to UTF-8 with SSE2
+/// @param Output The UTF-8 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that is not ASCII or is the null terminator
+EXTERN
+UINTN
+EFIAPI
+Utf16ToAsciiSse2 (
+  OUT CHAR8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// Latin1ToUtf16Sse2
+/// Widen the leading run of characters from a Latin-1 buffer to UTF-16 with SSE2
+/// @param Output The UTF-16 output buffer, which must have room for Count characters
+/// @param Input  The Latin-1 input buffer
+/// @param Count  The count of bytes in the input buffer
+/// @return The count of characters converted, conversion stops before the null terminator
+EXTERN
+UINTN
+EFIAPI
+Latin1ToUtf16Sse2 (
+  OUT CHAR16      *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Count
+);
+// Utf16ToLatin1Sse2
+/// Narrow the leading run of Latin-1 characters from a UTF-16 buffer to Latin-1 with SSE2
+/// @param Output The Latin-1 output buffer, which must have room for Count bytes
+/// @param Input  The UTF-16 input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character above U+00FF or the null terminator
+EXTERN
+UINTN
+EFIAPI
+Utf16ToLatin1Sse2 (
+  OUT UINT8        *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// Utf16ToSwappedSse2
+/// Swap the byte order of the leading run of UTF-16 characters that need no validation with SSE2, checking the characters before they are swapped
+/// @param Output The output buffer, which must have room for Count characters
+/// @param Input  The input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that needs validation or is the null terminator
+EXTERN
+UINTN
+EFIAPI
+Utf16ToSwappedSse2 (
+  OUT CHAR16       *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// SwappedToUtf16Sse2
+/// Swap the byte order of the leading run of UTF-16 characters that need no validation with SSE2, checking the characters after they are swapped
+/// @param Output The output buffer, which must have room for Count characters
+/// @param Input  The input buffer
+/// @param Count  The count of characters in the input buffer
+/// @return The count of characters converted, conversion stops before the first character that needs validation or is the null terminator
+EXTERN
+UINTN
+EFIAPI
+SwappedToUtf16Sse2 (
+  OUT CHAR16       *Output,
+  IN  CONST CHAR16 *Input,
+  IN  UINTN         Count
+);
+// Utf8ValidateBlocksSse4_2
+/// Validate the leading blocks of a UTF-8 buffer with SSE4.2 using nibble lookup tables
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of bytes that start a character in the validated blocks
+/// @return The size in bytes of the validated blocks, which may end within a character, validation stops before the last partial block or a block with the null terminator or an invalid sequence
+EXTERN
+UINTN
+EFIAPI
+Utf8ValidateBlocksSse4_2 (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+);
+// Utf8ValidateBlocksAvx2
+/// Validate the leading blocks of a UTF-8 buffer with AVX2 using nibble lookup tables
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of bytes that start a character in the validated blocks
+/// @return The size in bytes of the validated blocks, which may end within a character, validation stops before the last partial block or a block with the null terminator or an invalid sequence
+EXTERN
+UINTN
+EFIAPI
+Utf8ValidateBlocksAvx2 (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+);
+// Utf8ValidateSse4_2
+/// Validate the leading run of well formed UTF-8 characters and count them with SSE4.2
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateSse4_2 (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+) {
+  UINTN Validated = Utf8ValidateBlocksSse4_2(Input, Size, Count);
+  return Utf8ValidateFinish(Input, Size, Validated, Count);
+}
+// Utf8ValidateAvx2
+/// Validate the leading run of well formed UTF-8 characters and count them with AVX2
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateAvx2 (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+) {
+  UINTN Validated = Utf8ValidateBlocksAvx2(Input, Size, Count);
+  return Utf8ValidateFinish(Input, Size, Validated, Count);
+}
+// Base64EncodeBlocksSse4_2
+/// Encode twelve byte blocks of data to base64 characters with SSSE3 shuffles
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is a multiple of twelve, the last block is only encoded if four more bytes can be read
+EXTERN
+UINTN
+EFIAPI
+Base64EncodeBlocksSse4_2 (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+);
+// Base64EncodeBlocksAvx2
+/// Encode twenty four byte blocks of data to base64 characters with AVX2 shuffles
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is a multiple of twenty four, the last block is only encoded if four more bytes can be read
+EXTERN
+UINTN
+EFIAPI
+Base64EncodeBlocksAvx2 (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+);
+// Base64DecodeBlocksSse4_2
+/// Decode sixteen character blocks of base64 characters to data with SSSE3 shuffles
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is a multiple of sixteen, decoding stops before the first block that
+///          contains a character that is not in the base64 alphabet or that leaves too few characters for the wider store
+EXTERN
+UINTN
+EFIAPI
+Base64DecodeBlocksSse4_2 (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// Base64DecodeBlocksAvx2
+/// Decode thirty two character blocks of base64 characters to data with AVX2 shuffles
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is a multiple of thirty two, decoding stops before the first block that
+///          contains a character that is not in the base64 alphabet or that leaves too few characters for the wider store
+EXTERN
+UINTN
+EFIAPI
+Base64DecodeBlocksAvx2 (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// Base64EncodeSse4_2
+/// Encode complete three byte blocks of data to base64 characters with SSSE3
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is always a multiple of three
+STATIC
+UINTN
+EFIAPI
+Base64EncodeSse4_2 (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+) {
+  UINTN Encoded = Base64EncodeBlocksSse4_2(Output, Input, Size);
+  return Encoded + Base64EncodeScalar(Output + ((Encoded / 3) * 4), Input + Encoded, Size - Encoded);
+}
+// Base64EncodeAvx2
+/// Encode complete three byte blocks of data to base64 characters with AVX2
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is always a multiple of three
+STATIC
+UINTN
+EFIAPI
+Base64EncodeAvx2 (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+) {
+  UINTN Encoded = Base64EncodeBlocksAvx2(Output, Input, Size);
+  return Encoded + Base64EncodeScalar(Output + ((Encoded / 3) * 4), Input + Encoded, Size - Encoded);
+}
+// Base64DecodeSse4_2
+/// Decode complete four character blocks of base64 characters to data with SSSE3
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is always a multiple of four
+STATIC
+UINTN
+EFIAPI
+Base64DecodeSse4_2 (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN Decoded = Base64DecodeBlocksSse4_2(Output, Input, Count);
+  return Decoded + Base64DecodeScalar(Output + ((Decoded / 4) * 3), Input + Decoded, Count - Decoded);
+}
+// Base64DecodeAvx2
+/// Decode complete four character blocks of base64 characters to data with AVX2
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is always a multiple of four
+STATIC
+UINTN
+EFIAPI
+Base64DecodeAvx2 (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN Decoded = Base64DecodeBlocksAvx2(Output, Input, Count);
+  return Decoded + Base64DecodeScalar(Output + ((Decoded / 4) * 3), Input + Decoded, Count - Decoded);
+}
+// Crc32BlocksSse4_2
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with sixteen byte blocks by folding with PCLMULQDQ
+/// @param Crc32 The inverted 32-bit CRC state
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer, which must be at least sixty four and a multiple of sixteen
+/// @return The updated inverted 32-bit CRC state
+EXTERN
+UINT32
+EFIAPI
+Crc32BlocksSse4_2 (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+);
+// Crc32Sse4_2
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer by folding with PCLMULQDQ
+/// @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer
+/// @return The updated 32-bit CRC
+STATIC
+UINT32
+EFIAPI
+Crc32Sse4_2 (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+) {
+  UINTN Blocks = Size & ~((UINTN)0xF);
+  if (Blocks < 64) {
+    return Crc32Scalar(Crc32, Data, Size);
+  }
+  Crc32 = ~Crc32BlocksSse4_2(~Crc32, Data, Blocks);
+  return Crc32Scalar(Crc32, ADDRESS_OFFSET(CONST UINT8, Data, Blocks), Size - Blocks);
+}
+
+// HashAccumulateSse2
+/// Accumulate sixty four byte stripes of data into the eight 64-bit hash accumulators with SSE2
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Data         The data buffer
+/// @param Stripes      The count of sixty four byte stripes of the data buffer
+/// @param Secret       The secret of the first stripe, which must have (Stripes * 8) + 56 bytes
+EXTERN
+VOID
+EFIAPI
+HashAccumulateSse2 (
+  IN OUT UINT64     *Accumulators,
+  IN     CONST VOID *Data,
+  IN     UINTN       Stripes,
+  IN     CONST VOID *Secret
+);
+// HashAccumulateAvx2
+/// Accumulate sixty four byte stripes of data into the eight 64-bit hash accumulators with AVX2
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Data         The data buffer
+/// @param Stripes      The count of sixty four byte stripes of the data buffer
+/// @param Secret       The secret of the first stripe, which must have (Stripes * 8) + 56 bytes
+EXTERN
+VOID
+EFIAPI
+HashAccumulateAvx2 (
+  IN OUT UINT64     *Accumulators,
+  IN     CONST VOID *Data,
+  IN     UINTN       Stripes,
+  IN     CONST VOID *Secret
+);
+#elif defined(EFI_ARCH_AA64)
+
+// StrLenNeon
+/// Get the length of a character string with advanced SIMD
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+StrLenNeon (
+  IN CONST CHAR16 *Str
+);
+// AsciiStrLenNeon
+/// Get the length of a character string with advanced SIMD
+/// @param Str The character string, which must not be NULL
+/// @return The count of characters in the character string
+EXTERN
+UINTN
+EFIAPI
+AsciiStrLenNeon (
+  IN CONST CHAR8 *Str
+);
+// Utf8ValidateBlocksNeon
+/// Validate the leading blocks of a UTF-8 buffer with advanced SIMD using nibble lookup tables
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of bytes that start a character in the validated blocks
+/// @return The size in bytes of the validated blocks, which may end within a character, validation stops before the last partial block or a block with the null terminator or an invalid sequence
+EXTERN
+UINTN
+EFIAPI
+Utf8ValidateBlocksNeon (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+);
+// Utf8ValidateNeon
+/// Validate the leading run of well formed UTF-8 characters and count them with advanced SIMD
+/// @param Input The UTF-8 input buffer
+/// @param Size  The size in bytes of the input buffer
+/// @param Count On output, the count of characters in the run
+/// @return The size in bytes of the run, validation stops before the null terminator, the first malformed, overlong, surrogate, or out of range sequence, or a sequence truncated by the end of the buffer
+STATIC
+UINTN
+EFIAPI
+Utf8ValidateNeon (
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size,
+  OUT UINTN       *Count
+) {
+  UINTN Validated = Utf8ValidateBlocksNeon(Input, Size, Count);
+  return Utf8ValidateFinish(Input, Size, Validated, Count);
+}
+// Base64EncodeBlocksNeon
+/// Encode forty eight byte blocks of data to base64 characters with advanced SIMD
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is a multiple of forty eight
+EXTERN
+UINTN
+EFIAPI
+Base64EncodeBlocksNeon (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+);
+// Base64DecodeBlocksNeon
+/// Decode sixty four character blocks of base64 characters to data with advanced SIMD
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is a multiple of sixty four, decoding stops before the first block that contains any character that is not in the base64 alphabet
+EXTERN
+UINTN
+EFIAPI
+Base64DecodeBlocksNeon (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+);
+// Base64EncodeNeon
+/// Encode complete three byte blocks of data to base64 characters with advanced SIMD
+/// @param Output The output buffer, which must have room for four characters for every three input bytes
+/// @param Input  The input data buffer
+/// @param Size   The size in bytes of the input data buffer
+/// @return The size in bytes of input data encoded, which is always a multiple of three
+STATIC
+UINTN
+EFIAPI
+Base64EncodeNeon (
+  OUT CHAR8       *Output,
+  IN  CONST UINT8 *Input,
+  IN  UINTN        Size
+) {
+  UINTN Encoded = Base64EncodeBlocksNeon(Output, Input, Size);
+  return Encoded + Base64EncodeScalar(Output + ((Encoded / 3) * 4), Input + Encoded, Size - Encoded);
+}
+// Base64DecodeNeon
+/// Decode complete four character blocks of base64 characters to data with advanced SIMD
+/// @param Output The output buffer, which must have room for three bytes for every four input characters
+/// @param Input  The input base64 characters
+/// @param Count  The count of input characters
+/// @return The count of input characters decoded, which is always a multiple of four
+STATIC
+UINTN
+EFIAPI
+Base64DecodeNeon (
+  OUT UINT8       *Output,
+  IN  CONST CHAR8 *Input,
+  IN  UINTN        Count
+) {
+  UINTN Decoded = Base64DecodeBlocksNeon(Output, Input, Count);
+  return Decoded + Base64DecodeScalar(Output + ((Decoded / 4) * 3), Input + Decoded, Count - Decoded);
+}
+// Crc32IsSupportedNeon
+/// Check whether the CRC32 instructions are implemented, which are optional before ARMv8.1
+/// @return The CRC32 field of the instruction set attribute register, which is zero if the CRC32 instructions are not implemented
+EXTERN
+UINTN
+EFIAPI
+Crc32IsSupportedNeon (
+  VOID
+);
+// Crc32BlocksNeon
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer with the CRC32 instructions
+/// @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer
+/// @return The updated 32-bit CRC
+EXTERN
+UINT32
+EFIAPI
+Crc32BlocksNeon (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+);
+// Crc32Neon
+/// Update a 32-bit CRC (IEEE 802.3 polynomial) with a data buffer with the CRC32 instructions if implemented
+/// @param Crc32 The 32-bit CRC of the previous data or zero to start a new CRC
+/// @param Data  The data buffer
+/// @param Size  The size in bytes of the data buffer
+/// @return The updated 32-bit CRC
+STATIC
+UINT32
+EFIAPI
+Crc32Neon (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+) {
+  STATIC BOOLEAN NotDetected = TRUE;
+  STATIC BOOLEAN Supported = FALSE;
+  if (NotDetected) {
+    Supported = (Crc32IsSupportedNeon() != 0);
+    NotDetected = FALSE;
+  }
+  if (!Supported) {
+    return Crc32Scalar(Crc32, Data, Size);
+  }
+  return Crc32BlocksNeon(Crc32, Data, Size);
+}
+
+#endif
+
+// mDispatchTable
+/// The selected kernels, which start as the scalar kernels so the table is usable before selection
+STATIC EFI_DISPATCH_TABLE mDispatchTable = {
+  StrLenScalar,
+  StrCmpScalar,
+  StrnCmpScalar,
+  StrStrScalar,
+  StriPrefixScalar,
+  AsciiStrLenScalar,
+  AsciiStrCmpScalar,
+  AsciiStrnCmpScalar,
+  AsciiStrStrScalar,
+  CopyMemScalar,
+  SetMemScalar,
+  AsciiToUtf16Scalar,
+  Utf16ToAsciiScalar,
+  Latin1ToUtf16Scalar,
+  Utf16ToLatin1Scalar,
+  Utf16ToSwappedScalar,
+  SwappedToUtf16Scalar,
+  Utf8ValidateScalar,
+  Base64EncodeScalar,
+  Base64DecodeScalar,
+  Crc32Scalar,
+  HashAccumulateScalar,
+  BlitScalar,
+  AlphaBlendScalar
+};
+// mDispatchKernels
+/// The available kernels for each dispatch level, NULL if there is no kernel for the level
+STATIC CONST EFI_DISPATCH_TABLE mDispatchKernels[EfiDispatchLevelCount] = {
+  // EfiDispatchLevelScalar
+  {
+    StrLenScalar,
+    StrCmpScalar,
+    StrnCmpScalar,
+    StrStrScalar,
+    StriPrefixScalar,
+    AsciiStrLenScalar,
+    AsciiStrCmpScalar,
+    AsciiStrnCmpScalar,
+    AsciiStrStrScalar,
+    CopyMemScalar,
+    SetMemScalar,
+    AsciiToUtf16Scalar,
+    Utf16ToAsciiScalar,
+    Latin1ToUtf16Scalar,
+    Utf16ToLatin1Scalar,
+    Utf16ToSwappedScalar,
+    SwappedToUtf16Scalar,
+    Utf8ValidateScalar,
+    Base64EncodeScalar,
+    Base64DecodeScalar,
+    Crc32Scalar,
+    HashAccumulateScalar,
+    BlitScalar,
+    AlphaBlendScalar
+  },
+#if defined(EFI_ARCH_X64)
+  // EfiDispatchLevelSse2
+  {
+    StrLenSse2,
+    StrCmpSse2,
+    StrnCmpSse2,
+    NULL,
+    StriPrefixSse2,
+    AsciiStrLenSse2,
+    AsciiStrCmpSse2,
+    AsciiStrnCmpSse2,
+    NULL,
+    CopyMemSse2,
+    SetMemSse2,
+    AsciiToUtf16Sse2,
+    Utf16ToAsciiSse2,
+    Latin1ToUtf16Sse2,
+    Utf16ToLatin1Sse2,
+    Utf16ToSwappedSse2,
+    SwappedToUtf16Sse2,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    HashAccumulateSse2,
+    NULL,
+    NULL
+  },
+  // EfiDispatchLevelSse4_2
+  {
+    NULL,
+    NULL,
+    NULL,
+    StrStrSse4_2,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    AsciiStrStrSse4_2,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    Utf8ValidateSse4_2,
+    Base64EncodeSse4_2,
+    Base64DecodeSse4_2,
+    Crc32Sse4_2,
+    NULL,
+    NULL,
+    NULL
+  },
+  // EfiDispatchLevelAvx2
+  {
+    StrLenAvx2,
+    StrCmpAvx2,
+    NULL,
+    NULL,
+    NULL,
+    AsciiStrLenAvx2,
+    AsciiStrCmpAvx2,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    Utf8ValidateAvx2,
+    Base64EncodeAvx2,
+    Base64DecodeAvx2,
+    NULL,
+    HashAccumulateAvx2,
+    NULL,
+    NULL
+  },
+#else
+  // EfiDispatchLevelSse2
+  { NULL },
+  // EfiDispatchLevelSse4_2
+  { NULL },
+  // EfiDispatchLevelAvx2
+  { NULL },
+#endif
+  // EfiDispatchLevelAvx512
+  { NULL },
+#if defined(EFI_ARCH_AA64)
+  // EfiDispatchLevelNeon
+  {
+    StrLenNeon,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    AsciiStrLenNeon,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    Utf8ValidateNeon,
+    Base64EncodeNeon,
+    Base64DecodeNeon,
+    Crc32Neon,
+    NULL,
+    NULL,
+    NULL
+  }
+#else
+  // EfiDispatchLevelNeon
+  { NULL }
+#endif
+};
+// mDispatchSlots
+/// The dispatch table slots
+STATIC CONST EFI_DISPATCH_SLOT mDispatchSlots[] = {
+  { L"StrLen",         OFFSET_OF(EFI_DISPATCH_TABLE, StrLen) },
+  { L"StrCmp",         OFFSET_OF(EFI_DISPATCH_TABLE, StrCmp) },
+  { L"StrnCmp",        OFFSET_OF(EFI_DISPATCH_TABLE, StrnCmp) },
+  { L"StrStr",         OFFSET_OF(EFI_DISPATCH_TABLE, StrStr) },
+  { L"StriPrefix",     OFFSET_OF(EFI_DISPATCH_TABLE, StriPrefix) },
+  { L"AsciiStrLen",    OFFSET_OF(EFI_DISPATCH_TABLE, AsciiStrLen) },
+  { L"AsciiStrCmp",    OFFSET_OF(EFI_DISPATCH_TABLE, AsciiStrCmp) },
+  { L"AsciiStrnCmp",   OFFSET_OF(EFI_DISPATCH_TABLE, AsciiStrnCmp) },
+  { L"AsciiStrStr",    OFFSET_OF(EFI_DISPATCH_TABLE, AsciiStrStr) },
+  { L"CopyMem",        OFFSET_OF(EFI_DISPATCH_TABLE, CopyMem) },
+  { L"SetMem",         OFFSET_OF(EFI_DISPATCH_TABLE, SetMem) },
+  { L"AsciiToUtf16",   OFFSET_OF(EFI_DISPATCH_TABLE, AsciiToUtf16) },
+  { L"Utf16ToAscii",   OFFSET_OF(EFI_DISPATCH_TABLE, Utf16ToAscii) },
+  { L"Latin1ToUtf16",  OFFSET_OF(EFI_DISPATCH_TABLE, Latin1ToUtf16) },
+  { L"Utf16ToLatin1",  OFFSET_OF(EFI_DISPATCH_TABLE, Utf16ToLatin1) },
+  { L"Utf16ToSwapped", OFFSET_OF(EFI_DISPATCH_TABLE, Utf16ToSwapped) },
+  { L"SwappedToUtf16", OFFSET_OF(EFI_DISPATCH_TABLE, SwappedToUtf16) },
+  { L"Utf8Validate",   OFFSET_OF(EFI_DISPATCH_TABLE, Utf8Validate) },
+  { L"Base64Encode",   OFFSET_OF(EFI_DISPATCH_TABLE, Base64Encode) },
+  { L"Base64Decode",   OFFSET_OF(EFI_DISPATCH_TABLE, Base64Decode) },
+  { L"Crc32",          OFFSET_OF(EFI_DISPATCH_TABLE, Crc32) },
+  { L"HashAccumulate", OFFSET_OF(EFI_DISPATCH_TABLE, HashAccumulate) },
+  { L"Blit",           OFFSET_OF(EFI_DISPATCH_TABLE, Blit) },
+  { L"AlphaBlend",     OFFSET_OF(EFI_DISPATCH_TABLE, AlphaBlend) }
+};
+// mDispatchSlotLevels
+/// The level of the kernel selected for each dispatch table slot
+STATIC EFI_DISPATCH_LEVEL mDispatchSlotLevels[ARRAY_COUNT(mDispatchSlots)] = { EfiDispatchLevelScalar };
+// mDispatchLevelNames
+/// The dispatch level names
+STATIC CONST CHAR16 *mDispatchLevelNames[EfiDispatchLevelCount] = {
+  L"Scalar",
+  L"SSE2",
+  L"SSE4.2",
+  L"AVX2",
+  L"AVX512",
+  L"NEON"
+};
+// mDispatchLevel
+/// The maximum level used to select the dispatch table kernels
+STATIC EFI_DISPATCH_LEVEL mDispatchLevel = EfiDispatchLevelScalar;
+// mDispatchNotSelected
+/// Whether the dispatch table kernels have been selected
+STATIC BOOLEAN mDispatchNotSelected = TRUE;
+// mDispatchCarrylessMultiply
+/// Whether the CPU supports PCLMULQDQ, which the SSE4.2 CRC kernel requires in addition to the SSE4.2 level
+STATIC BOOLEAN mDispatchCarrylessMultiply = FALSE;
+
+// EfiDispatchGetSupportedLevels
+/// Detect the dispatch levels supported by the CPU
+/// @return The bitmask of supported dispatch levels
+STATIC
+UINT64
+EFIAPI
+EfiDispatchGetSupportedLevels (
+  VOID
+) {
+  STATIC BOOLEAN NotDetected = TRUE;
+  STATIC UINT64  Supported = EFI_BIT(EfiDispatchLevelScalar);
+  // Check if the detection has already occured
+  if (NotDetected) {
+#if defined(EFI_ARCH_IA32) || defined(EFI_ARCH_X64)
+    CPU_FEATURES Features;
+    UINT64       Xcr0;
+    // Get the CPU features
+    if (!EFI_ERROR(CpuGetFeatures(&Features))) {
+      // SSE2
+      if (Features.Sse2) {
+        Supported |= EFI_BIT(EfiDispatchLevelSse2);
+        // SSE4.2 with SSSE3 and SSE4.1
+        if (Features.Ssse3 && Features.Sse4_1 && Features.Sse4_2) {
+          Supported |= EFI_BIT(EfiDispatchLevelSse4_2);
+          mDispatchCarrylessMultiply = Features.CarrylessMultiply;
+        }
+      }
+      // The extended register state must be enabled by the firmware for AVX
+      if (Features.SaveExtendedStateEnabled && Features.AdvancedVectorExtensions) {
+        Xcr0 = EfiGetExtendedControlRegister(0);
+        // AVX2 requires SSE and AVX state
+        if (EFI_BIT_IS_SET(Supported, EfiDispatchLevelSse4_2) &&
+            EFI_BITS_ARE_SET(Xcr0, EFI_BIT(1) | EFI_BIT(2)) && Features.AdvancedVectorExtensions2) {
+          Supported |= EFI_BIT(EfiDispatchLevelAvx2);
+          // AVX-512 F, BW and VL require opmask, ZMM_Hi256 and Hi16_ZMM state
+          if (EFI_BITS_ARE_SET(Xcr0, EFI_BIT(5) | EFI_BIT(6) | EFI_BIT(7)) &&
+              Features.Avx512 && Features.Avx512ByteWord && Features.Avx512VectorLength) {
+            Supported |= EFI_BIT(EfiDispatchLevelAvx512);
+          }
+        }
+      }
+    }
+#elif defined(EFI_ARCH_AA64)
+    // Advanced SIMD is mandatory for ARM64 architecture
+    Supported |= EFI_BIT(EfiDispatchLevelNeon);
+#endif
+    // Detection has taken place so there is no need to do again if recalled
+    NotDetected = FALSE;
+  }
+  return Supported;
+}
+// DispatchIsKernelSupported
+/// Check whether a slot kernel can be used at a supported dispatch level, since some kernels need features beyond the level
+/// @param Index The index of the dispatch table slot
+/// @param Level The supported dispatch level of the kernel
+/// @return Whether the slot kernel at the dispatch level can be used
+STATIC
+BOOLEAN
+EFIAPI
+DispatchIsKernelSupported (
+  IN UINTN              Index,
+  IN EFI_DISPATCH_LEVEL Level
+) {
+  // The SSE4.2 CRC kernel folds with PCLMULQDQ, which some CPUs with SSE4.2 lack
+  if ((Level == EfiDispatchLevelSse4_2) && (mDispatchSlots[Index].Offset == OFFSET_OF(EFI_DISPATCH_TABLE, Crc32))) {
+    return mDispatchCarrylessMultiply;
+  }
+  return TRUE;
+}
+// EfiDispatchSelect
+/// Select the best kernel for each dispatch table slot up to a maximum level
+/// @param Level The maximum dispatch level of the selected kernels
+STATIC
+VOID
+EFIAPI
+EfiDispatchSelect (
+  IN EFI_DISPATCH_LEVEL Level
+) {
+  UINT64              Supported = EfiDispatchGetSupportedLevels();
+  UINTN               Index;
+  UINTN               Check;
+  EFI_DISPATCH_KERNEL Kernel;
+  // Select each slot kernel
+  for (Index = 0; Index < ARRAY_COUNT(mDispatchSlots); ++Index) {
+    // Find the highest supported level with a kernel
+    Check = (UINTN)Level;
+    while (Check > EfiDispatchLevelScalar) {
+      if (EFI_BIT_IS_SET(Supported, Check) && DispatchIsKernelSupported(Index, (EFI_DISPATCH_LEVEL)Check)) {
+        Kernel = *ADDRESS_OFFSET(CONST EFI_DISPATCH_KERNEL, mDispatchKernels + Check, mDispatchSlots[Index].Offset);
+        if (Kernel != NULL) {
+          break;
+        }
+      }
+      --Check;
+    }
+    // Set the slot kernel
+    Kernel = *ADDRESS_OFFSET(CONST EFI_DISPATCH_KERNEL, mDispatchKernels + Check, mDispatchSlots[Index].Offset);
+    *ADDRESS_OFFSET(EFI_DISPATCH_KERNEL, &mDispatchTable, mDispatchSlots[Index].Offset) = Kernel;
+    mDispatchSlotLevels[Index] = (EFI_DISPATCH_LEVEL)Check;
+  }
+  mDispatchLevel = Level;
+  mDispatchNotSelected = FALSE;
+}
+
+// EfiDispatch
+/// Get the dispatch table, the first use selects the best kernels supported by the CPU
+/// @return The dispatch table of selected kernels
+CONST EFI_DISPATCH_TABLE *
+EFIAPI
+EfiDispatch (
+  VOID
+) {
+  if (mDispatchNotSelected) {
+    EfiDispatchSelect(EfiDispatchGetBestLevel());
+  }
+  return &mDispatchTable;
+}
+// EfiDispatchInitialize
+/// Select the dispatch table kernels using the configured maximum level from /Dispatch/Level and log the selected kernels
+/// @retval EFI_NOT_FOUND   The configured level is not a dispatch level name so the best supported level was selected
+/// @retval EFI_UNSUPPORTED The configured level is not supported by the CPU so the best supported level was selected
+/// @retval EFI_SUCCESS     The dispatch table kernels were selected
+EFI_STATUS
+EFIAPI
+EfiDispatchInitialize (
+  VOID
+) {
+  EFI_STATUS          Status = EFI_SUCCESS;
+  EFI_DISPATCH_LEVEL  Best = EfiDispatchGetBestLevel();
+  EFI_DISPATCH_LEVEL  Level = Best;
+  CONST CHAR16       *Name;
+  UINTN               Index;
+  // Get the configured level
+  Name = EfiConfigurationGetString(L"/Dispatch/Level", L"Auto");
+  if ((Name != NULL) && (StriCmp(Name, L"Auto") != 0)) {
+    Status = EfiDispatchLevelFromString(Name, &Level);
+    if (EFI_ERROR(Status)) {
+      LOG(L"Dispatch level \"%s\" is not valid: %r\n", Name, Status);
+      Level = Best;
+    } else if (!EfiDispatchIsLevelSupported(Level)) {
+      LOG(L"Dispatch level %s is not supported\n", mDispatchLevelNames[Level]);
+      Status = EFI_UNSUPPORTED;
+      Level = Best;
+    }
+  }
+  // Select the kernels
+  EfiDispatchSelect(Level);
+  // Log the selected kernels
+  LOG(L"Dispatch level: %s (best supported %s)\n", mDispatchLevelNames[Level], mDispatchLevelNames[Best]);
+  for (Index = 0; Index < ARRAY_COUNT(mDispatchSlots); ++Index) {
+    VERBOSE(L"  %-14s %s\n", mDispatchSlots[Index].Name, mDispatchLevelNames[mDispatchSlotLevels[Index]]);
+  }
+  return Status;
+}
+
+// EfiDispatchGetLevel
+/// Get the maximum level used to select the dispatch table kernels
+/// @return The maximum dispatch level
+EFI_DISPATCH_LEVEL
+EFIAPI
+EfiDispatchGetLevel (
+  VOID
+) {
+  if (mDispatchNotSelected) {
+    EfiDispatchSelect(EfiDispatchGetBestLevel());
+  }
+  return mDispatchLevel;
+}
+// EfiDispatchSetLevel
+/// Select the dispatch table kernels with a maximum level
+/// @param Level The maximum dispatch level of the selected kernels
+/// @retval EFI_INVALID_PARAMETER If Level is not a valid dispatch level
+/// @retval EFI_UNSUPPORTED       If Level is not supported by the CPU
+/// @retval EFI_SUCCESS           The dispatch table kernels were selected
+EFI_STATUS
+EFIAPI
+EfiDispatchSetLevel (
+  IN EFI_DISPATCH_LEVEL Level
+) {
+  if (Level >= EfiDispatchLevelCount) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (!EfiDispatchIsLevelSupported(Level)) {
+    return EFI_UNSUPPORTED;
+  }
+  EfiDispatchSelect(Level);
+  return EFI_SUCCESS;
+}
+// EfiDispatchGetBestLevel
+/// Get the best dispatch level supported by the CPU
+/// @return The best supported dispatch level
+EFI_DISPATCH_LEVEL
+EFIAPI
+EfiDispatchGetBestLevel (
+  VOID
+) {
+  UINT64 Supported = EfiDispatchGetSupportedLevels();
+  UINTN  Level = EfiDispatchLevelCount - 1;
+  while (Level > EfiDispatchLevelScalar) {
+    if (EFI_BIT_IS_SET(Supported, Level)) {
+      break;
+    }
+    --Level;
+  }
+  return (EFI_DISPATCH_LEVEL)Level;
+}
+// EfiDispatchIsLevelSupported
+/// Check whether a dispatch level is supported by the CPU
+/// @param Level The dispatch level to check
+/// @return Whether the dispatch level is supported or not
+BOOLEAN
+EFIAPI
+EfiDispatchIsLevelSupported (
+  IN EFI_DISPATCH_LEVEL Level
+) {
+  if (Level >= EfiDispatchLevelCount) {
+    return FALSE;
+  }
+  return EFI_BIT_IS_SET(EfiDispatchGetSupportedLevels(), Level);
+}
+// EfiDispatchLevelToString
+/// Get the name of a dispatch level
+/// @param Level The dispatch level
+/// @return The name of the dispatch level or NULL if the level is invalid
+CONST CHAR16 *
+EFIAPI
+EfiDispatchLevelToString (
+  IN EFI_DISPATCH_LEVEL Level
+) {
+  if (Level >= EfiDispatchLevelCount) {
+    return NULL;
+  }
+  return mDispatchLevelNames[Level];
+}
+// EfiDispatchLevelFromString
+/// Get a dispatch level from the name of the dispatch level
+/// @param Name  The case insensitive name of the dispatch level
+/// @param Level On output, the dispatch level
+/// @retval EFI_INVALID_PARAMETER If Name or Level is NULL
+/// @retval EFI_NOT_FOUND         If Name is not the name of a dispatch level
+/// @retval EFI_SUCCESS           The dispatch level was returned successfully
+EFI_STATUS
+EFIAPI
+EfiDispatchLevelFromString (
+  IN  CONST CHAR16       *Name,
+  OUT EFI_DISPATCH_LEVEL *Level
+) {
+  UINTN Index;
+  if ((Name == NULL) || (Level == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  for (Index = 0; Index < ARRAY_COUNT(mDispatchLevelNames); ++Index) {
+    if (StriCmp(Name, mDispatchLevelNames[Index]) == 0) {
+      *Level = (EFI_DISPATCH_LEVEL)Index;
+      return EFI_SUCCESS;
+    }
+  }
+  return EFI_NOT_FOUND;
+}
+
+// STRING_BENCHMARK_SHORT_NEEDLE
+/// The count of characters of the short sub-string searched by the string benchmark
+#define STRING_BENCHMARK_SHORT_NEEDLE 8
+// STRING_BENCHMARK_LONG_NEEDLE
+/// The count of characters of the long sub-string searched by the string benchmark
+#define STRING_BENCHMARK_LONG_NEEDLE 40
+
+// EfiDispatchStringBenchmark
+/// Log the time of the string kernels at each supported dispatch level for a sweep of string lengths
+/// @param Count The count of calls to each kernel for each measurement
+/// @retval EFI_INVALID_PARAMETER If Count is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The strings could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EFI_STATUS
+EFIAPI
+EfiDispatchStringBenchmark (
+  IN UINTN Count
+) {
+  STATIC CONST UINTN   Lengths[] = { 8, 32, 128, 512, 2048, 8192 };
+  STATIC CONST CHAR16 *Names[] = { L"StrLen", L"StrCmp", L"StrnCmp", L"StrStr", L"StrStr long", L"AsciiStrLen", L"AsciiStrCmp", L"AsciiStrnCmp", L"AsciiStrStr", L"AsciiStrStr long" };
+  EFI_DISPATCH_LEVEL   Previous;
+  UINTN                Level;
+  UINTN                Length;
+  UINTN                Kind;
+  UINTN                Index;
+  UINTN                Needle;
+  UINT32               Random;
+  CHAR8                Saved;
+  CHAR16              *Str1;
+  CHAR16              *Str2;
+  CHAR8               *Ascii1;
+  CHAR8               *Ascii2;
+  CHAR16               Search[STRING_BENCHMARK_LONG_NEEDLE + 1];
+  CHAR8                AsciiSearch[STRING_BENCHMARK_LONG_NEEDLE + 1];
+  UINT64               Start;
+  UINT64               Elapsed;
+  if (Count == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (EfiGetTimeStampFrequency() == 0) {
+    return EFI_UNSUPPORTED;
+  }
+  // Allocate two copies of the longest string in both widths
+  Length = Lengths[ARRAY_COUNT(Lengths) - 1] + 1;
+  Str1 = EfiAllocateArray(CHAR16, Length);
+  Str2 = EfiAllocateArray(CHAR16, Length);
+  Ascii1 = EfiAllocateArray(CHAR8, Length);
+  Ascii2 = EfiAllocateArray(CHAR8, Length);
+  if ((Str1 != NULL) && (Str2 != NULL) && (Ascii1 != NULL) && (Ascii2 != NULL)) {
+    // Fill the strings with pseudo random letters so the sub-string is only found at the end
+    Random = 0x9E3779B9;
+    for (Index = 0; Index < Length; ++Index) {
+      Random = (Random * 1664525) + 1013904223;
+      Ascii1[Index] = (CHAR8)('a' + ((Random >> 24) % 26));
+      Str1[Index] = (CHAR16)Ascii1[Index];
+    }
+    EfiCopyArray(CHAR16, Str2, Str1, Length);
+    EfiCopyArray(CHAR8, Ascii2, Ascii1, Length);
+    Previous = EfiDispatchGetLevel();
+    LOG(L"String kernel benchmark: %u calls\n", Count);
+    for (Level = EfiDispatchLevelScalar; Level < EfiDispatchLevelCount; ++Level) {
+      if (!EfiDispatchIsLevelSupported((EFI_DISPATCH_LEVEL)Level)) {
+        continue;
+      }
+      EfiDispatchSetLevel((EFI_DISPATCH_LEVEL)Level);
+      for (Index = 0; Index < ARRAY_COUNT(Lengths); ++Index) {
+        // Terminate the strings at the measured length
+        Length = Lengths[Index];
+        Saved = Ascii1[Length];
+        Str1[Length] = 0;
+        Str2[Length] = 0;
+        Ascii1[Length] = 0;
+        Ascii2[Length] = 0;
+        for (Kind = 0; Kind < ARRAY_COUNT(Names); ++Kind) {
+          // Search for the end of the string with a short or long sub-string
+          Needle = ((Kind == 4) || (Kind == 9)) ? STRING_BENCHMARK_LONG_NEEDLE : STRING_BENCHMARK_SHORT_NEEDLE;
+          if (Needle > Length) {
+            continue;
+          }
+          EfiCopyArray(CHAR16, Search, Str1 + Length - Needle, Needle + 1);
+          EfiCopyArray(CHAR8, AsciiSearch, Ascii1 + Length - Needle, Needle + 1);
+          Start = EfiGetTimeStamp();
+          for (Needle = 0; Needle < Count; ++Needle) {
+            switch (Kind) {
+              case 0:
+                StrLen(Str1);
+                break;
+
+              case 1:
+                StrCmp(Str1, Str2);
+                break;
+
+              case 2:
+                StrnCmp(Str1, Str2, Length);
+                break;
+
+              case 3:
+              case 4:
+                StrStr(Str1, Search);
+                break;
+
+              case 5:
+                AsciiStrLen(Ascii1);
+                break;
+
+              case 6:
+                AsciiStrCmp(Ascii1, Ascii2);
+                break;
+
+              case 7:
+                AsciiStrnCmp(Ascii1, Ascii2, Length);
+                break;
+
+              default:
+                AsciiStrStr(Ascii1, AsciiSearch);
+                break;
+            }
+          }
+          Elapsed = EfiTimeStampToNanoseconds(EfiGetTimeStamp() - Start);
+          LOG(L"  %s %s %u: %lu ns, %lu ns each\n", mDispatchLevelNames[Level], Names[Kind], Length, Elapsed, Elapsed / Count);
+        }
+        // Restore the characters at the measured length
+        Ascii1[Length] = Ascii2[Length] = Saved;
+        Str1[Length] = Str2[Length] = (CHAR16)Saved;
+      }
+    }
+    EfiDispatchSetLevel(Previous);
+  }
+  // Free the strings
+  if (Str1 != NULL) {
+    EfiFreePool(Str1);
+  }
+  if (Str2 != NULL) {
+    EfiFreePool(Str2);
+  }
+  if (Ascii1 != NULL) {
+    EfiFreePool(Ascii1);
+  }
+  if (Ascii2 != NULL) {
+    EfiFreePool(Ascii2);
+  }
+  if ((Str1 == NULL) || (Str2 == NULL) || (Ascii1 == NULL) || (Ascii2 == NULL)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  return EFI_SUCCESS;
+}
+
+// CRC32_BENCHMARK_ITERATIONS
+/// The number of times to repeat each CRC benchmark measurement, the fastest is logged
+#define CRC32_BENCHMARK_ITERATIONS 4
+
+// EfiDispatchCrc32Benchmark
+/// Log the time of the CRC kernel at each supported dispatch level and of the firmware boot service for a buffer
+/// @param Size The size in bytes of the buffer to use
+/// @retval EFI_INVALID_PARAMETER If Size is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EFI_STATUS
+EFIAPI
+EfiDispatchCrc32Benchmark (
+  IN UINTN Size
+) {
+  EFI_DISPATCH_LEVEL  Previous;
+  UINTN               Level;
+  UINTN               Index;
+  UINT8              *Buffer;
+  UINT32              Expected;
+  UINT32              Crc32;
+  UINT64              Start;
+  UINT64              Best;
+  UINT64              Elapsed;
+  if (Size == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (EfiGetTimeStampFrequency() == 0) {
+    return EFI_UNSUPPORTED;
+  }
+  // Fill a buffer with a pattern
+  Buffer = EfiAllocateArray(UINT8, Size);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  for (Index = 0; Index < Size; ++Index) {
+    Buffer[Index] = (UINT8)((Index * 31) ^ (Index >> 8));
+  }
+  Expected = Crc32Scalar(0, Buffer, Size);
+  Previous = EfiDispatchGetLevel();
+  LOG(L"CRC32 benchmark: %u bytes\n", Size);
+  // Measure the kernel of each supported level
+  for (Level = EfiDispatchLevelScalar; Level < EfiDispatchLevelCount; ++Level) {
+    if (!EfiDispatchIsLevelSupported((EFI_DISPATCH_LEVEL)Level)) {
+      continue;
+    }
+    EfiDispatchSetLevel((EFI_DISPATCH_LEVEL)Level);
+    Best = MAX_UINT64;
+    Crc32 = 0;
+    for (Index = 0; Index < CRC32_BENCHMARK_ITERATIONS; ++Index) {
+      Start = EfiGetTimeStamp();
+      Crc32 = EfiDispatch()->Crc32(0, Buffer, Size);
+      Elapsed = EfiGetTimeStamp() - Start;
+      if (Elapsed < Best) {
+        Best = Elapsed;
+      }
+    }
+    Elapsed = EfiTimeStampToNanoseconds(Best);
+    LOG(L"  %s: %lu ns, %lu MB/s%s\n", mDispatchLevelNames[Level], Elapsed, (Elapsed != 0) ? ((Size * 1000ULL) / Elapsed) : 0,
+        (Crc32 == Expected) ? L"" : L" (CRC mismatch)");
+  }
+  EfiDispatchSetLevel(Previous);
+  // Measure the firmware boot service
+  if ((gEfiBootServices != NULL) &&
+      (gEfiBootServices->Hdr.Revision >= EFI_1_10_SYSTEM_TABLE_REVISION) &&
+      (gEfiBootServices->CalculateCrc32 != NULL)) {
+    Best = MAX_UINT64;
+    Crc32 = 0;
+    for (Index = 0; Index < CRC32_BENCHMARK_ITERATIONS; ++Index) {
+      Start = EfiGetTimeStamp();
+      gEfiBootServices->CalculateCrc32(Buffer, Size, &Crc32);
+      Elapsed = EfiGetTimeStamp() - Start;
+      if (Elapsed < Best) {
+        Best = Elapsed;
+      }
+    }
+    Elapsed = EfiTimeStampToNanoseconds(Best);
+    LOG(L"  Firmware: %lu ns, %lu MB/s%s\n", Elapsed, (Elapsed != 0) ? ((Size * 1000ULL) / Elapsed) : 0,
+        (Crc32 == Expected) ? L"" : L" (CRC mismatch)");
+  }
+  EfiFreePool(Buffer);
+  return EFI_SUCCESS;
+}
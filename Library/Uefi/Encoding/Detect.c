@@ -0,0 +1,218 @@
+///
+/// @file Library/Uefi/Encoding/Detect.c
+///
+/// Character encoding detection by content sniffing
+///
+
+#include <Uefi.h>
+
+// ENCODING_DETECT_SAMPLE_SIZE
+/// The size in bytes of the leading sample of a buffer that is used to detect the encoding
+#define ENCODING_DETECT_SAMPLE_SIZE 4096
+// ENCODING_DETECT_NAME_SIZE
+/// The size in bytes of the largest declared encoding name, including the null terminator
+#define ENCODING_DETECT_NAME_SIZE 32
+
+// ENCODING_DETECT_ALIAS
+/// A declared encoding name and the name of the encoding that decodes it
+typedef struct ENCODING_DETECT_ALIAS ENCODING_DETECT_ALIAS;
+struct ENCODING_DETECT_ALIAS {
+
+  // Alias
+  /// The declared encoding name
+  CONST CHAR8 *Alias;
+  // Name
+  /// The encoding name
+  CONST CHAR8 *Name;
+
+};
+
+// mEncodingDetectAliases
+/// The declared encoding names that are decoded by an encoding with another name
+STATIC CONST ENCODING_DETECT_ALIAS mEncodingDetectAliases[] = {
+  { "ISO-8859-1", "Latin-1" },
+  { "ISO_8859-1", "Latin-1" },
+  { "ISO8859-1",  "Latin-1" },
+  { "Latin1",     "Latin-1" },
+  { "US-ASCII",   "Latin-1" },
+  { "UTF8",       "UTF-8" }
+};
+
+// EncodingDetectIsSpace
+/// Check if a byte is XML white space
+/// @param Byte The byte to check
+/// @return Whether the byte is XML white space or not
+STATIC
+BOOLEAN
+EFIAPI
+EncodingDetectIsSpace (
+  IN UINT8 Byte
+) {
+  return ((Byte == ' ') || (Byte == '\t') || (Byte == '\r') || (Byte == '\n'));
+}
+// EncodingDetectDeclared
+/// Get the encoding named by the encoding attribute of a leading XML declaration in a byte encoded buffer
+/// @param Bytes The buffer
+/// @param Size  The size in bytes of the buffer
+/// @return The declared encoding or NULL if there is no declared encoding or it is not a byte encoding
+STATIC
+EFI_ENCODING_PROTOCOL *
+EFIAPI
+EncodingDetectDeclared (
+  IN CONST UINT8 *Bytes,
+  IN UINTN        Size
+) {
+  EFI_ENCODING_PROTOCOL *Encoding;
+  CHAR8                  Name[ENCODING_DETECT_NAME_SIZE];
+  UINTN                  Offset = 0;
+  UINTN                  Length;
+  UINTN                  Index;
+  UINT8                  Quote;
+  // Skip leading white space and check for the declaration
+  while ((Offset < Size) && EncodingDetectIsSpace(Bytes[Offset])) {
+    ++Offset;
+  }
+  if (((Size - Offset) < 6) || (AsciiStrnCmp((CONST CHAR8 *)(Bytes + Offset), "<?xml", 5) != 0) || !EncodingDetectIsSpace(Bytes[Offset + 5])) {
+    return NULL;
+  }
+  // Find the encoding attribute before the end of the declaration
+  for (Offset += 6; (Offset + 8) < Size; ++Offset) {
+    if ((Bytes[Offset] == '?') || (Bytes[Offset] == '>')) {
+      return NULL;
+    }
+    if (EncodingDetectIsSpace(Bytes[Offset - 1]) && (AsciiStrnCmp((CONST CHAR8 *)(Bytes + Offset), "encoding", 8) == 0)) {
+      break;
+    }
+  }
+  // Skip to the quoted value
+  for (Offset += 8; (Offset < Size) && EncodingDetectIsSpace(Bytes[Offset]); ++Offset);
+  if ((Offset >= Size) || (Bytes[Offset] != '=')) {
+    return NULL;
+  }
+  for (++Offset; (Offset < Size) && EncodingDetectIsSpace(Bytes[Offset]); ++Offset);
+  if ((Offset >= Size) || ((Bytes[Offset] != '"') && (Bytes[Offset] != '\''))) {
+    return NULL;
+  }
+  Quote = Bytes[Offset++];
+  // Copy the encoding name
+  for (Length = 0; ((Offset + Length) < Size) && (Bytes[Offset + Length] != Quote); ++Length) {
+    if ((Length + 1) >= ENCODING_DETECT_NAME_SIZE) {
+      return NULL;
+    }
+    Name[Length] = (CHAR8)Bytes[Offset + Length];
+  }
+  if (((Offset + Length) >= Size) || (Length == 0)) {
+    return NULL;
+  }
+  Name[Length] = 0;
+  // Get the encoding by name or alias
+  for (Index = 0; Index < ARRAY_COUNT(mEncodingDetectAliases); ++Index) {
+    if (AsciiStriCmp(Name, mEncodingDetectAliases[Index].Alias) == 0) {
+      break;
+    }
+  }
+  Encoding = EfiGetEncoding((Index < ARRAY_COUNT(mEncodingDetectAliases)) ? mEncodingDetectAliases[Index].Name : Name);
+  // The declaration was read as bytes so any other declared unit size is contradictory
+  if ((Encoding == NULL) || (Encoding->UnitSize != sizeof(CHAR8))) {
+    return NULL;
+  }
+  return Encoding;
+}
+
+// EfiEncodingDetect
+/// Detect the encoding of an encoded character string buffer by sampling its content
+/// @param Buffer     The encoded character string buffer
+/// @param Size       The size in bytes of the encoded character string buffer
+/// @param Encoding   On output, the detected encoding protocol interface
+/// @param Confidence On output, the confidence in the detected encoding from EFI_ENCODING_CONFIDENCE_LOW to EFI_ENCODING_CONFIDENCE_CERTAIN
+/// @retval EFI_INVALID_PARAMETER If Buffer or Encoding is NULL or Size is zero
+/// @retval EFI_NOT_FOUND         If the detected encoding is not installed
+/// @retval EFI_SUCCESS           If the encoding was detected
+EFI_STATUS
+EFIAPI
+EfiEncodingDetect (
+  IN  CONST VOID             *Buffer,
+  IN  UINTN                   Size,
+  OUT EFI_ENCODING_PROTOCOL **Encoding,
+  OUT UINTN                  *Confidence OPTIONAL
+) {
+  EFI_ENCODING_PROTOCOL *Detected = NULL;
+  CONST UINT8           *Bytes;
+  UINTN                  Sample;
+  UINTN                  Pairs;
+  UINTN                  EvenZeros = 0;
+  UINTN                  OddZeros = 0;
+  UINTN                  Certainty = EFI_ENCODING_CONFIDENCE_LOW;
+  UINTN                  Validated;
+  UINTN                  Count = 0;
+  EFI_STATUS             Status;
+  // Check parameters
+  if ((Buffer == NULL) || (Size == 0) || (Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Bytes = (CONST UINT8 *)Buffer;
+  Sample = (Size < ENCODING_DETECT_SAMPLE_SIZE) ? Size : ENCODING_DETECT_SAMPLE_SIZE;
+  // Detect byte order marks
+  if ((Sample >= 2) && (Bytes[0] == 0xFF) && (Bytes[1] == 0xFE)) {
+    Detected = EfiUtf16Encoding();
+    Certainty = EFI_ENCODING_CONFIDENCE_CERTAIN;
+  } else if ((Sample >= 2) && (Bytes[0] == 0xFE) && (Bytes[1] == 0xFF)) {
+    Detected = EfiUtf16SwappedEncoding();
+    Certainty = EFI_ENCODING_CONFIDENCE_CERTAIN;
+  } else if ((Sample >= 3) && (Bytes[0] == 0xEF) && (Bytes[1] == 0xBB) && (Bytes[2] == 0xBF)) {
+    Detected = EfiUtf8Encoding();
+    Certainty = EFI_ENCODING_CONFIDENCE_CERTAIN;
+  } else {
+    // Count the null bytes in each half of the units up to a null terminator, mostly Latin text in UTF-16 has a null high byte
+    for (Pairs = 0; (Pairs < (Sample / 2)) && ((Bytes[2 * Pairs] | Bytes[(2 * Pairs) + 1]) != 0); ++Pairs) {
+      EvenZeros += (Bytes[2 * Pairs] == 0) ? 1 : 0;
+      OddZeros += (Bytes[(2 * Pairs) + 1] == 0) ? 1 : 0;
+    }
+    if ((Pairs != 0) && (EvenZeros == 0) && ((OddZeros * 2) >= Pairs)) {
+      Detected = EfiUtf16Encoding();
+      Certainty = ((OddZeros * 4) >= (Pairs * 3)) ? EFI_ENCODING_CONFIDENCE_HIGH : EFI_ENCODING_CONFIDENCE_MEDIUM;
+    } else if ((Pairs != 0) && (OddZeros == 0) && ((EvenZeros * 2) >= Pairs)) {
+      Detected = EfiUtf16SwappedEncoding();
+      Certainty = ((EvenZeros * 4) >= (Pairs * 3)) ? EFI_ENCODING_CONFIDENCE_HIGH : EFI_ENCODING_CONFIDENCE_MEDIUM;
+    } else {
+      // Honor the encoding of an XML declaration
+      Detected = EncodingDetectDeclared(Bytes, Sample);
+      if (Detected != NULL) {
+        Certainty = EFI_ENCODING_CONFIDENCE_HIGH;
+      } else {
+        // Validate the sample as UTF-8 in bulk, a character may be truncated by the end of the sample
+        Detected = EfiUtf8Encoding();
+        if ((Detected != NULL) && (Detected->Validate != NULL)) {
+          Validated = Sample;
+          Status = Detected->Validate(Detected, Bytes, &Validated, &Count);
+          if ((Status == EFI_SUCCESS) || ((Sample < Size) && ((Sample - Validated) < Detected->MaxUnits))) {
+            // Multiple unit characters are unlikely to be valid by chance but an ASCII sample only says the rest is ASCII compatible
+            if (Count != Validated) {
+              Certainty = EFI_ENCODING_CONFIDENCE_HIGH;
+            } else {
+              Certainty = (Sample < Size) ? EFI_ENCODING_CONFIDENCE_LOW : EFI_ENCODING_CONFIDENCE_MEDIUM;
+            }
+          } else {
+            Detected = NULL;
+          }
+        } else {
+          Detected = NULL;
+        }
+        // Any bytes decode as Latin-1
+        if (Detected == NULL) {
+          Detected = EfiLatin1Encoding();
+          Certainty = EFI_ENCODING_CONFIDENCE_LOW;
+        }
+      }
+    }
+  }
+  if (Detected == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  // Return the detected encoding and confidence
+  *Encoding = Detected;
+  if (Confidence != NULL) {
+    *Confidence = Certainty;
+  }
+  return EFI_SUCCESS;
+}
@@ -7,7 +7,7 @@
 #include <Uefi.h>
 
 // ENCODING_STRING_DEFAULT_SIZE
-/// The default or increment size of a string in characters
+/// The default size of a string in characters, strings double in size when they grow
 #define ENCODING_STRING_DEFAULT_SIZE 16
 
 // gEfiEncodingProtocolGuid
@@ -82,6 +82,37 @@ Utf16SwappedEncodingUninstall (
   VOID
 );
 
+// EncodingTranscodeInstall
+/// Install direct transcoders between encodings
+EXTERN
+EFI_STATUS
+EFIAPI
+EncodingTranscodeInstall (
+  VOID
+);
+// EncodingTranscodeUninstall
+/// Uninstall direct transcoders between encodings
+EXTERN
+EFI_STATUS
+EFIAPI
+EncodingTranscodeUninstall (
+  VOID
+);
+// EncodingTranscode
+/// Convert an encoded string directly to another encoding if there is a transcoder for the pair of encodings
+EXTERN
+EFI_STATUS
+EFIAPI
+EncodingTranscode (
+  IN     EFI_ENCODING_PROTOCOL *Encoding,
+  OUT    VOID                  *Buffer OPTIONAL,
+  IN OUT UINTN                 *Size,
+  IN     EFI_ENCODING_PROTOCOL *InputEncoding,
+  IN     CONST VOID            *Input,
+  IN     UINTN                  InputSize,
+  IN     BOOLEAN                Validated
+);
+
 // EfiDefaultEncoding
 /// Get the default encoding protocol
 /// @return The default encoding protocol or NULL if there was an error
@@ -101,6 +132,8 @@ EFIAPI
 EfiEncodingUninstall (
   VOID
 ) {
+  // Uninstall direct transcoders
+  EncodingTranscodeUninstall();
   // Uninstall Latin-1 encoding
   Latin1EncodingUninstall();
   // Uninstall UTF-8 encoding
@@ -141,8 +174,10 @@ EfiEncodingInstall (
   Status = Utf16SwappedEncodingInstall();
   if (EFI_ERROR(Status)) {
     EfiEncodingUninstall();
+    return Status;
   }
-  return Status;
+  // Install direct transcoders
+  return EncodingTranscodeInstall();
 }
 
 // EfiGetEncoding
@@ -336,11 +371,11 @@ EfiAppendCharacter (
   BufferSize = *Size;
   // Check if there is space in the buffer for the character
   if ((Ptr == NULL) || (BufferSize == 0) || (BufferSize <= (ThisCount + (2 * Encoding->MaxUnits)))) {
-    // The buffer needs (re)allocated
-    UINTN NewSize = BufferSize;
-    do {
-      NewSize += ENCODING_STRING_DEFAULT_SIZE;
-    } while (NewSize <= (ThisCount + (2 * Encoding->MaxUnits)));
+    // The buffer needs (re)allocated, grow geometrically so appending is amortized constant time
+    UINTN NewSize = (BufferSize < ENCODING_STRING_DEFAULT_SIZE) ? ENCODING_STRING_DEFAULT_SIZE : (BufferSize * 2);
+    while (NewSize <= (ThisCount + (2 * Encoding->MaxUnits))) {
+      NewSize *= 2;
+    }
     // Allocate or reallocate the buffer
     if (Ptr != NULL) {
       Ptr = (CHAR16 *)EfiReallocate(NewSize * Encoding->UnitSize, BufferSize * Encoding->UnitSize, Ptr);
@@ -561,6 +596,13 @@ EfiEncodingStringLength (
   }
   // Get the buffer size
   BufferSize = *Size;
+  // Count the characters with the fast validation if the string is well formed
+  if ((Encoding->Validate != NULL) && (Encoding->Validate(Encoding, Buffer, &BufferSize, &Count) == EFI_SUCCESS)) {
+    *Size = Count;
+    return EFI_SUCCESS;
+  }
+  Count = 0;
+  BufferSize = *Size;
   if (BufferSize != 0) {
     // Count the characters with (assumed) known size
     do {
@@ -642,6 +684,12 @@ EfiEncodingStringSize (
   if ((Encoding == NULL) || (Buffer == NULL) || (Size == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
+  // Get the size with the fast validation if the string is well formed
+  if ((Encoding->Validate != NULL) && (Encoding->Validate(Encoding, Buffer, &BufferSize, NULL) == EFI_SUCCESS)) {
+    *Size = BufferSize + Encoding->UnitSize;
+    return EFI_SUCCESS;
+  }
+  BufferSize = 0;
   // Get the max units size in bytes (two max character units characters size in bytes should be enough to find one valid character)
   MaxUnitsSize = 2 * Encoding->UnitSize * Encoding->MaxUnits;
   // Get the count of bytes for each of the characters
@@ -693,11 +741,12 @@ EfiEncodingConvert (
   IN     VOID                  *Input,
   IN     UINTN                  InputSize
 ) {
-  EFI_STATUS Status = EFI_NOT_FOUND;
-  UINTN      RemainingSize;
-  UINTN      BufferSize = 0;
-  UINTN      ThisSize;
-  UINT32     Character;
+  EFI_STATUS               Status = EFI_NOT_FOUND;
+  EFI_ENCODING_DECODE_CHAR Decode = NULL;
+  UINTN                    RemainingSize;
+  UINTN                    BufferSize = 0;
+  UINTN                    ThisSize;
+  UINT32                   Character;
   // Check parameters
   if ((Input == NULL) || (InputSize == 0) || (Size == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -712,6 +761,19 @@ EfiEncodingConvert (
   if ((InputEncoding == NULL) || (Encoding == NULL)) {
     return EFI_NOT_FOUND;
   }
+  // Validate the whole input once so it can be converted without checking each character
+  if ((InputEncoding->Validate != NULL) && (InputEncoding->DecodeValidated != NULL)) {
+    ThisSize = InputSize;
+    if (InputEncoding->Validate(InputEncoding, Input, &ThisSize, NULL) == EFI_SUCCESS) {
+      Decode = InputEncoding->DecodeValidated;
+    }
+  }
+  // Use the direct transcoder for the pair of encodings if there is one
+  Status = EncodingTranscode(Encoding, Buffer, Size, InputEncoding, Input, InputSize, (Decode != NULL) ? TRUE : FALSE);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+  Status = EFI_NOT_FOUND;
   // Get the total size
   RemainingSize = *Size;
   // Convert the character buffers
@@ -719,7 +781,11 @@ EfiEncodingConvert (
     ThisSize = InputSize;
     Character = 0;
     // Decode the next input buffer character
-    Status = EfiDecodeCharacter(InputEncoding, Input, &ThisSize, &Character);
+    if (Decode != NULL) {
+      Status = Decode(InputEncoding, Input, &ThisSize, &Character);
+    } else {
+      Status = EfiDecodeCharacter(InputEncoding, Input, &ThisSize, &Character);
+    }
     if (EFI_ERROR(Status)) {
       break;
     }
@@ -727,8 +793,8 @@ EfiEncodingConvert (
     InputSize -= ThisSize;
     // Advance the input
     Input = ADDRESS_OFFSET(VOID, Input, ThisSize);
-    // Check character is valid
-    if ((Character != 0) && !IsUnicodeCharacter(Character)) {
+    // Check character is valid unless the input was validated
+    if ((Decode == NULL) && (Character != 0) && !IsUnicodeCharacter(Character)) {
       // Skip this character as it is invalid
       continue;
     }
@@ -742,6 +808,12 @@ EfiEncodingConvert (
     if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
       break;
     }
+    // Decrease remaining size
+    if (RemainingSize > ThisSize) {
+      RemainingSize -= ThisSize;
+    } else {
+      RemainingSize = 0;
+    }
     // Increase Buffer size
     BufferSize += ThisSize;
     // Advance the Buffer if needed
@@ -841,7 +913,7 @@ EfiEncodingConvertCount (
   UINTN      RemainingSize;
   UINTN      BufferSize = 0;
   UINTN      ThisSize;
-  UINT32     Character;
+  UINT32     Character = 0;
   // Check parameters
   if ((Input == NULL) || (InputSize == 0) || (Size == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -886,6 +958,12 @@ EfiEncodingConvertCount (
     if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
       break;
     }
+    // Decrease remaining size
+    if (RemainingSize > ThisSize) {
+      RemainingSize -= ThisSize;
+    } else {
+      RemainingSize = 0;
+    }
     // Increase Buffer size
     BufferSize += ThisSize;
     // Advance the Buffer if needed
@@ -897,8 +975,8 @@ EfiEncodingConvertCount (
       break;
     }
   }
-  // Check if input ended before null terminator
-  if (Status == EFI_NOT_FOUND) {
+  // Check if input or count ended before null terminator
+  if ((Status == EFI_NOT_FOUND) || (((Status == EFI_SUCCESS) || (Status == EFI_BUFFER_TOO_SMALL)) && (Character != 0))) {
     // Encode the null terminator into the output buffer
     if (RemainingSize >= Encoding->UnitSize) {
       ThisSize = RemainingSize;
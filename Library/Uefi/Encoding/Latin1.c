@@ -56,7 +56,7 @@ Latin1DecodeCharacter (
     return EFI_NOT_FOUND;
   }
   // Every Latin-1 character unit is a valid one to one code point
-  *Character = (UINT32)(*((CHAR8 *)Buffer));
+  *Character = (UINT32)(*((CONST UINT8 *)Buffer));
   *Size = sizeof(CHAR8);
   return EFI_SUCCESS;
 }
@@ -149,6 +149,8 @@ Latin1EncodingInstall (
   Encoding->MaxUnits = 1;
   Encoding->DecodeCharacter = Latin1DecodeCharacter;
   Encoding->EncodeCharacter = Latin1EncodeCharacter;
+  Encoding->Validate = NULL;
+  Encoding->DecodeValidated = NULL;
   // Install the encoding protocol
   Status = EfiInstallMultipleProtocolInterfaces(&mLatin1Handle, &gEfiLatin1EncodingProtocolGuid, Encoding, &gEfiEncodingProtocolGuid, Encoding, NULL);
   if (EFI_ERROR(Status)) {
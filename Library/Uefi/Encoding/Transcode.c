@@ -0,0 +1,715 @@
+///
+/// @file Library/Uefi/Encoding/Transcode.c
+///
+/// Direct transcoding between pairs of character encodings
+///
+
+#include <Uefi.h>
+
+// TRANSCODE_SCRATCH_SIZE
+/// The size in bytes of the scratch buffer that runs are converted into after the output buffer is too small, so the output size can still be counted
+#define TRANSCODE_SCRATCH_SIZE 256
+
+// TRANSCODE_ENCODING
+/// The encodings that have direct transcoders
+typedef enum TRANSCODE_ENCODING TRANSCODE_ENCODING;
+enum TRANSCODE_ENCODING {
+
+  // TranscodeLatin1
+  /// Latin-1 encoding
+  TranscodeLatin1 = 0,
+  // TranscodeUtf8
+  /// UTF-8 encoding
+  TranscodeUtf8,
+  // TranscodeUtf16
+  /// UTF-16 encoding
+  TranscodeUtf16,
+  // TranscodeUtf16Swapped
+  /// UTF-16 byte swapped encoding
+  TranscodeUtf16Swapped,
+  // TranscodeEncodingCount
+  /// The count of encodings that have direct transcoders
+  TranscodeEncodingCount
+
+};
+
+// TRANSCODE_OUTPUT
+/// The output of a transcoder
+typedef struct TRANSCODE_OUTPUT TRANSCODE_OUTPUT;
+struct TRANSCODE_OUTPUT {
+
+  // Buffer
+  /// The position in the output buffer at which to write the next character or NULL if the output buffer is too small
+  UINT8 *Buffer;
+  // Remaining
+  /// The size in bytes remaining in the output buffer
+  UINTN  Remaining;
+  // Size
+  /// The total size in bytes of the converted characters, including those that did not fit in the output buffer
+  UINTN  Size;
+
+};
+
+// ENCODING_TRANSCODER
+/// Convert an encoded string directly to another encoding
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+typedef
+EFI_STATUS
+(EFIAPI
+*ENCODING_TRANSCODER) (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+);
+
+// mTranscodeEncodings
+/// The encoding protocols that have direct transcoders
+STATIC EFI_ENCODING_PROTOCOL *mTranscodeEncodings[TranscodeEncodingCount] = { NULL };
+// mUtf8Minimum
+/// The least code point that can be encoded by each length of UTF-8 sequence, anything less is an overlong encoding
+STATIC CONST UINT32 mUtf8Minimum[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+// TranscodeStatus
+/// Get the status of a transcoder that converted the whole string
+/// @param Output The transcoder output
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+TranscodeStatus (
+  IN TRANSCODE_OUTPUT *Output
+) {
+  return (Output->Buffer == NULL) ? EFI_BUFFER_TOO_SMALL : EFI_SUCCESS;
+}
+// TranscodeReserve
+/// Reserve room in the output for an encoded character, once a character does not fit nothing else is written but the size is still counted
+/// @param Output The transcoder output
+/// @param Size   The size in bytes of the encoded character
+/// @return The position at which to write the encoded character or NULL if the output buffer is too small
+STATIC
+VOID *
+EFIAPI
+TranscodeReserve (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     UINTN             Size
+) {
+  VOID *Position = NULL;
+  if ((Output->Buffer != NULL) && (Output->Remaining >= Size)) {
+    Position = Output->Buffer;
+    Output->Buffer += Size;
+    Output->Remaining -= Size;
+  } else {
+    Output->Buffer = NULL;
+  }
+  Output->Size += Size;
+  return Position;
+}
+// TranscodeRunBuffer
+/// Get the buffer into which to convert a run of characters
+/// @param Output   The transcoder output
+/// @param UnitSize The size in bytes of each converted character
+/// @param Scratch  The scratch buffer of TRANSCODE_SCRATCH_SIZE bytes to use if the output buffer is too small
+/// @param Count    On input, the count of characters remaining in the input, on output, the most characters the run may convert
+/// @return The buffer into which to convert the run
+STATIC
+VOID *
+EFIAPI
+TranscodeRunBuffer (
+  IN     TRANSCODE_OUTPUT *Output,
+  IN     UINTN             UnitSize,
+  IN     VOID             *Scratch,
+  IN OUT UINTN            *Count
+) {
+  UINTN Limit;
+  if (Output->Buffer == NULL) {
+    Limit = TRANSCODE_SCRATCH_SIZE / UnitSize;
+  } else {
+    Limit = Output->Remaining / UnitSize;
+  }
+  if (*Count > Limit) {
+    *Count = Limit;
+  }
+  return (Output->Buffer == NULL) ? Scratch : Output->Buffer;
+}
+// TranscodeRunCommit
+/// Account for a run of converted characters
+/// @param Output The transcoder output
+/// @param Size   The size in bytes of the converted run
+STATIC
+VOID
+EFIAPI
+TranscodeRunCommit (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     UINTN             Size
+) {
+  if (Output->Buffer != NULL) {
+    Output->Buffer += Size;
+    Output->Remaining -= Size;
+  }
+  Output->Size += Size;
+}
+
+// Utf8ToUtf16Transcode
+/// Convert a UTF-8 encoded string directly to UTF-16
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf8ToUtf16Transcode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  CONST EFI_DISPATCH_TABLE *Dispatch = EfiDispatch();
+  CONST UINT8              *Utf8 = (CONST UINT8 *)Input;
+  CHAR16                   *Utf16;
+  UINT32                    Character;
+  UINTN                     Length;
+  UINTN                     Index;
+  UINTN                     Limit;
+  UINTN                     Run;
+  UINT8                     Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (InputSize != 0) {
+    // Widen runs of ASCII characters
+    do {
+      Limit = InputSize;
+      Utf16 = (CHAR16 *)TranscodeRunBuffer(Output, sizeof(CHAR16), Scratch, &Limit);
+      Run = Dispatch->AsciiToUtf16(Utf16, (CONST CHAR8 *)Utf8, Limit);
+      TranscodeRunCommit(Output, Run * sizeof(CHAR16));
+      Utf8 += Run;
+      InputSize -= Run;
+    } while ((Run != 0) && (Run == Limit) && (InputSize != 0));
+    if (InputSize == 0) {
+      break;
+    }
+    // Decode the next character, any irregular sequence is left to the generic conversion
+    Character = Utf8[0];
+    if (Character < 0x80) {
+      Length = 1;
+    } else if ((Character >= 0xC2) && (Character <= 0xDF)) {
+      Length = 2;
+      Character &= 0x1F;
+    } else if ((Character >= 0xE0) && (Character <= 0xEF)) {
+      Length = 3;
+      Character &= 0x0F;
+    } else if ((Character >= 0xF0) && (Character <= 0xF4)) {
+      Length = 4;
+      Character &= 0x07;
+    } else {
+      return EFI_UNSUPPORTED;
+    }
+    if (InputSize < Length) {
+      return EFI_UNSUPPORTED;
+    }
+    for (Index = 1; Index < Length; ++Index) {
+      if ((Utf8[Index] & 0xC0) != 0x80) {
+        return EFI_UNSUPPORTED;
+      }
+      Character = (Character << 6) | (Utf8[Index] & 0x3F);
+    }
+    if ((Character < mUtf8Minimum[Length]) || (Character > 0x10FFFF) || ((Character >= 0xD800) && (Character <= 0xDFFF)) ||
+        ((Character > 0x377) && !IsUnicodeCharacter(Character))) {
+      return EFI_UNSUPPORTED;
+    }
+    Utf8 += Length;
+    InputSize -= Length;
+    // Encode the character
+    if (Character > 0xFFFF) {
+      Utf16 = (CHAR16 *)TranscodeReserve(Output, 2 * sizeof(CHAR16));
+      if (Utf16 != NULL) {
+        Character -= 0x10000;
+        Utf16[0] = (CHAR16)(0xD800 + EFI_BITFIELD(Character, 10, 19));
+        Utf16[1] = (CHAR16)(0xDC00 + EFI_BITFIELD(Character, 0, 9));
+      }
+    } else {
+      Utf16 = (CHAR16 *)TranscodeReserve(Output, sizeof(CHAR16));
+      if (Utf16 != NULL) {
+        *Utf16 = (CHAR16)Character;
+      }
+      // Stop after the null terminator
+      if (Character == 0) {
+        break;
+      }
+    }
+  }
+  return TranscodeStatus(Output);
+}
+// Utf8ToUtf16ValidatedTranscode
+/// Convert a validated UTF-8 encoded string directly to UTF-16 without checking the character units
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer, which must be well formed up to the null terminator or the end of the buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf8ToUtf16ValidatedTranscode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  CONST EFI_DISPATCH_TABLE *Dispatch = EfiDispatch();
+  CONST UINT8              *Utf8 = (CONST UINT8 *)Input;
+  CHAR16                   *Utf16;
+  UINT32                    Character;
+  UINTN                     Length;
+  UINTN                     Index;
+  UINTN                     Limit;
+  UINTN                     Run;
+  UINT8                     Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (InputSize != 0) {
+    // Widen runs of ASCII characters
+    do {
+      Limit = InputSize;
+      Utf16 = (CHAR16 *)TranscodeRunBuffer(Output, sizeof(CHAR16), Scratch, &Limit);
+      Run = Dispatch->AsciiToUtf16(Utf16, (CONST CHAR8 *)Utf8, Limit);
+      TranscodeRunCommit(Output, Run * sizeof(CHAR16));
+      Utf8 += Run;
+      InputSize -= Run;
+    } while ((Run != 0) && (Run == Limit) && (InputSize != 0));
+    if (InputSize == 0) {
+      break;
+    }
+    // Decode the next character, the leading unit gives the length of the sequence since the string is well formed
+    Character = Utf8[0];
+    if (Character < 0x80) {
+      Length = 1;
+    } else if (Character < 0xE0) {
+      Length = 2;
+      Character &= 0x1F;
+    } else if (Character < 0xF0) {
+      Length = 3;
+      Character &= 0x0F;
+    } else {
+      Length = 4;
+      Character &= 0x07;
+    }
+    for (Index = 1; Index < Length; ++Index) {
+      Character = (Character << 6) | (Utf8[Index] & 0x3F);
+    }
+    Utf8 += Length;
+    InputSize -= Length;
+    // Encode the character
+    if (Character > 0xFFFF) {
+      Utf16 = (CHAR16 *)TranscodeReserve(Output, 2 * sizeof(CHAR16));
+      if (Utf16 != NULL) {
+        Character -= 0x10000;
+        Utf16[0] = (CHAR16)(0xD800 + EFI_BITFIELD(Character, 10, 19));
+        Utf16[1] = (CHAR16)(0xDC00 + EFI_BITFIELD(Character, 0, 9));
+      }
+    } else {
+      Utf16 = (CHAR16 *)TranscodeReserve(Output, sizeof(CHAR16));
+      if (Utf16 != NULL) {
+        *Utf16 = (CHAR16)Character;
+      }
+      // Stop after the null terminator
+      if (Character == 0) {
+        break;
+      }
+    }
+  }
+  return TranscodeStatus(Output);
+}
+// Utf16ToUtf8Transcode
+/// Convert a UTF-16 encoded string directly to UTF-8
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf16ToUtf8Transcode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  CONST EFI_DISPATCH_TABLE *Dispatch = EfiDispatch();
+  CONST CHAR16             *Utf16 = (CONST CHAR16 *)Input;
+  UINTN                     Count = InputSize / sizeof(CHAR16);
+  UINT8                    *Utf8;
+  UINT32                    Character;
+  UINTN                     Limit;
+  UINTN                     Run;
+  UINT8                     Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (Count != 0) {
+    // Narrow runs of ASCII characters
+    do {
+      Limit = Count;
+      Utf8 = (UINT8 *)TranscodeRunBuffer(Output, sizeof(CHAR8), Scratch, &Limit);
+      Run = Dispatch->Utf16ToAscii((CHAR8 *)Utf8, Utf16, Limit);
+      TranscodeRunCommit(Output, Run);
+      Utf16 += Run;
+      Count -= Run;
+    } while ((Run != 0) && (Run == Limit) && (Count != 0));
+    if (Count == 0) {
+      break;
+    }
+    // Surrogates and invalid characters are left to the generic conversion
+    Character = *Utf16++;
+    --Count;
+    if (((Character >= 0xD800) && (Character <= 0xDFFF)) || ((Character > 0x377) && !IsUnicodeCharacter(Character))) {
+      return EFI_UNSUPPORTED;
+    }
+    // Encode the character
+    if (Character <= 0x7F) {
+      Utf8 = (UINT8 *)TranscodeReserve(Output, sizeof(CHAR8));
+      if (Utf8 != NULL) {
+        *Utf8 = (UINT8)Character;
+      }
+      // Stop after the null terminator
+      if (Character == 0) {
+        break;
+      }
+    } else if (Character <= 0x7FF) {
+      Utf8 = (UINT8 *)TranscodeReserve(Output, 2 * sizeof(CHAR8));
+      if (Utf8 != NULL) {
+        Utf8[0] = (UINT8)(EFI_BITFIELD(Character, 6, 10) | 0xC0);
+        Utf8[1] = (UINT8)(EFI_BITFIELD(Character, 0, 5) | 0x80);
+      }
+    } else {
+      Utf8 = (UINT8 *)TranscodeReserve(Output, 3 * sizeof(CHAR8));
+      if (Utf8 != NULL) {
+        Utf8[0] = (UINT8)(EFI_BITFIELD(Character, 12, 15) | 0xE0);
+        Utf8[1] = (UINT8)(EFI_BITFIELD(Character, 6, 11) | 0x80);
+        Utf8[2] = (UINT8)(EFI_BITFIELD(Character, 0, 5) | 0x80);
+      }
+    }
+  }
+  return TranscodeStatus(Output);
+}
+// Latin1ToUtf16Transcode
+/// Convert a Latin-1 encoded string directly to UTF-16
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Latin1ToUtf16Transcode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  CONST EFI_DISPATCH_TABLE *Dispatch = EfiDispatch();
+  CONST UINT8              *Latin1 = (CONST UINT8 *)Input;
+  CHAR16                   *Utf16;
+  UINTN                     Limit;
+  UINTN                     Run;
+  UINT8                     Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (InputSize != 0) {
+    // Widen runs of characters, every Latin-1 character is a valid code point
+    do {
+      Limit = InputSize;
+      Utf16 = (CHAR16 *)TranscodeRunBuffer(Output, sizeof(CHAR16), Scratch, &Limit);
+      Run = Dispatch->Latin1ToUtf16(Utf16, Latin1, Limit);
+      TranscodeRunCommit(Output, Run * sizeof(CHAR16));
+      Latin1 += Run;
+      InputSize -= Run;
+    } while ((Run != 0) && (Run == Limit) && (InputSize != 0));
+    if (InputSize == 0) {
+      break;
+    }
+    // Encode the next character
+    Utf16 = (CHAR16 *)TranscodeReserve(Output, sizeof(CHAR16));
+    if (Utf16 != NULL) {
+      *Utf16 = (CHAR16)*Latin1;
+    }
+    // Stop after the null terminator
+    if (*Latin1++ == 0) {
+      break;
+    }
+    --InputSize;
+  }
+  return TranscodeStatus(Output);
+}
+// Utf16ToLatin1Transcode
+/// Convert a UTF-16 encoded string directly to Latin-1
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf16ToLatin1Transcode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  CONST EFI_DISPATCH_TABLE *Dispatch = EfiDispatch();
+  CONST CHAR16             *Utf16 = (CONST CHAR16 *)Input;
+  UINTN                     Count = InputSize / sizeof(CHAR16);
+  UINT8                    *Latin1;
+  UINTN                     Limit;
+  UINTN                     Run;
+  UINT8                     Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (Count != 0) {
+    // Narrow runs of Latin-1 characters
+    do {
+      Limit = Count;
+      Latin1 = (UINT8 *)TranscodeRunBuffer(Output, sizeof(CHAR8), Scratch, &Limit);
+      Run = Dispatch->Utf16ToLatin1(Latin1, Utf16, Limit);
+      TranscodeRunCommit(Output, Run);
+      Utf16 += Run;
+      Count -= Run;
+    } while ((Run != 0) && (Run == Limit) && (Count != 0));
+    if (Count == 0) {
+      break;
+    }
+    // Characters that can not be mapped are left to the generic conversion
+    if (*Utf16 > 0xFF) {
+      return EFI_UNSUPPORTED;
+    }
+    // Encode the next character
+    Latin1 = (UINT8 *)TranscodeReserve(Output, sizeof(CHAR8));
+    if (Latin1 != NULL) {
+      *Latin1 = (UINT8)*Utf16;
+    }
+    // Stop after the null terminator
+    if (*Utf16++ == 0) {
+      break;
+    }
+    --Count;
+  }
+  return TranscodeStatus(Output);
+}
+// Utf16SwapTranscode
+/// Convert a UTF-16 encoded string directly to the other byte order
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @param Swap      The kernel that swaps runs of characters
+/// @param Swapped   Whether the input is byte swapped or not
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf16SwapTranscode (
+  IN OUT TRANSCODE_OUTPUT        *Output,
+  IN     CONST VOID              *Input,
+  IN     UINTN                    InputSize,
+  IN     EFI_DISPATCH_UTF16_SWAP  Swap,
+  IN     BOOLEAN                  Swapped
+) {
+  CONST CHAR16 *Utf16 = (CONST CHAR16 *)Input;
+  UINTN         Count = InputSize / sizeof(CHAR16);
+  CHAR16       *Buffer;
+  UINT16        Character;
+  UINTN         Limit;
+  UINTN         Run;
+  UINT8         Scratch[TRANSCODE_SCRATCH_SIZE];
+  while (Count != 0) {
+    // Swap runs of characters that need no validation
+    do {
+      Limit = Count;
+      Buffer = (CHAR16 *)TranscodeRunBuffer(Output, sizeof(CHAR16), Scratch, &Limit);
+      Run = Swap(Buffer, Utf16, Limit);
+      TranscodeRunCommit(Output, Run * sizeof(CHAR16));
+      Utf16 += Run;
+      Count -= Run;
+    } while ((Run != 0) && (Run == Limit) && (Count != 0));
+    if (Count == 0) {
+      break;
+    }
+    // Surrogates and invalid characters are left to the generic conversion
+    Character = Swapped ? EfiByteSwap16(*Utf16) : *Utf16;
+    if (((Character >= 0xD800) && (Character <= 0xDFFF)) || ((Character > 0x377) && !IsUnicodeCharacter(Character))) {
+      return EFI_UNSUPPORTED;
+    }
+    // Encode the next character
+    Buffer = (CHAR16 *)TranscodeReserve(Output, sizeof(CHAR16));
+    if (Buffer != NULL) {
+      *Buffer = EfiByteSwap16(*Utf16);
+    }
+    ++Utf16;
+    --Count;
+    // Stop after the null terminator
+    if (Character == 0) {
+      break;
+    }
+  }
+  return TranscodeStatus(Output);
+}
+// Utf16ToSwappedTranscode
+/// Convert a UTF-16 encoded string directly to UTF-16 byte swapped
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+Utf16ToSwappedTranscode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  return Utf16SwapTranscode(Output, Input, InputSize, EfiDispatch()->Utf16ToSwapped, FALSE);
+}
+// SwappedToUtf16Transcode
+/// Convert a UTF-16 byte swapped encoded string directly to UTF-16
+/// @param Output    The transcoder output
+/// @param Input     The input encoded string buffer
+/// @param InputSize The size in bytes of the input encoded string buffer
+/// @retval EFI_UNSUPPORTED      If the input needs the generic conversion because it is irregular, invalid, or can not be mapped
+/// @retval EFI_BUFFER_TOO_SMALL If the output buffer was too small for the converted string
+/// @retval EFI_SUCCESS          If the string was converted
+STATIC
+EFI_STATUS
+EFIAPI
+SwappedToUtf16Transcode (
+  IN OUT TRANSCODE_OUTPUT *Output,
+  IN     CONST VOID       *Input,
+  IN     UINTN             InputSize
+) {
+  return Utf16SwapTranscode(Output, Input, InputSize, EfiDispatch()->SwappedToUtf16, TRUE);
+}
+
+// mTranscoders
+/// The direct transcoders indexed by input encoding then output encoding, NULL if the pair uses the generic conversion
+STATIC CONST ENCODING_TRANSCODER mTranscoders[TranscodeEncodingCount][TranscodeEncodingCount] = {
+  // TranscodeLatin1
+  { NULL, NULL, Latin1ToUtf16Transcode, NULL },
+  // TranscodeUtf8
+  { NULL, NULL, Utf8ToUtf16Transcode, NULL },
+  // TranscodeUtf16
+  { Utf16ToLatin1Transcode, Utf16ToUtf8Transcode, NULL, Utf16ToSwappedTranscode },
+  // TranscodeUtf16Swapped
+  { NULL, NULL, SwappedToUtf16Transcode, NULL }
+};
+// mValidatedTranscoders
+/// The direct transcoders for input that was validated by the input encoding indexed by input encoding then output encoding, NULL if the pair uses the other transcoders
+STATIC CONST ENCODING_TRANSCODER mValidatedTranscoders[TranscodeEncodingCount][TranscodeEncodingCount] = {
+  // TranscodeLatin1
+  { NULL, NULL, NULL, NULL },
+  // TranscodeUtf8
+  { NULL, NULL, Utf8ToUtf16ValidatedTranscode, NULL },
+  // TranscodeUtf16
+  { NULL, NULL, NULL, NULL },
+  // TranscodeUtf16Swapped
+  { NULL, NULL, NULL, NULL }
+};
+
+// TranscodeFindEncoding
+/// Find the transcoder index of an encoding protocol
+/// @param Encoding The encoding protocol
+/// @return The transcoder index of the encoding or TranscodeEncodingCount if the encoding has no direct transcoders
+STATIC
+TRANSCODE_ENCODING
+EFIAPI
+TranscodeFindEncoding (
+  IN EFI_ENCODING_PROTOCOL *Encoding
+) {
+  UINTN Index;
+  for (Index = 0; Index < TranscodeEncodingCount; ++Index) {
+    if (mTranscodeEncodings[Index] == Encoding) {
+      break;
+    }
+  }
+  return (TRANSCODE_ENCODING)Index;
+}
+
+// EncodingTranscode
+/// Convert an encoded string directly to another encoding if there is a transcoder for the pair of encodings
+/// @param Encoding      The output encoding
+/// @param Buffer        On output, the output encoded string buffer
+/// @param Size          On input, the size in bytes of the output encoded string buffer, on output, the size in bytes of the converted string
+/// @param InputEncoding The input encoding
+/// @param Input         The input encoded string buffer to decode
+/// @param InputSize     The size in bytes of the input encoded string buffer
+/// @param Validated     Whether the input encoding validated the input encoded string so it can be converted without checking
+/// @retval EFI_UNSUPPORTED      If there is no transcoder for the pair of encodings or the string needs the generic conversion
+/// @retval EFI_BUFFER_TOO_SMALL The specified output buffer size is not large enough to hold the converted string, *Size is updated with the required size
+/// @retval EFI_SUCCESS          If the string was converted
+EFI_STATUS
+EFIAPI
+EncodingTranscode (
+  IN     EFI_ENCODING_PROTOCOL *Encoding,
+  OUT    VOID                  *Buffer OPTIONAL,
+  IN OUT UINTN                 *Size,
+  IN     EFI_ENCODING_PROTOCOL *InputEncoding,
+  IN     CONST VOID            *Input,
+  IN     UINTN                  InputSize,
+  IN     BOOLEAN                Validated
+) {
+  EFI_STATUS           Status;
+  TRANSCODE_OUTPUT     Output;
+  TRANSCODE_ENCODING   From;
+  TRANSCODE_ENCODING   To;
+  ENCODING_TRANSCODER  Transcoder;
+  // Find the transcoder for the pair of encodings, preferring the one that does not check validated input
+  From = TranscodeFindEncoding(InputEncoding);
+  To = TranscodeFindEncoding(Encoding);
+  if ((From >= TranscodeEncodingCount) || (To >= TranscodeEncodingCount) || (InputSize < InputEncoding->UnitSize)) {
+    return EFI_UNSUPPORTED;
+  }
+  Transcoder = Validated ? mValidatedTranscoders[From][To] : NULL;
+  if (Transcoder == NULL) {
+    Transcoder = mTranscoders[From][To];
+    if (Transcoder == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+  // Convert the string
+  Output.Buffer = (UINT8 *)Buffer;
+  Output.Remaining = (Buffer != NULL) ? *Size : 0;
+  Output.Size = 0;
+  Status = Transcoder(&Output, Input, InputSize);
+  if (!EFI_ERROR(Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
+    *Size = Output.Size;
+  }
+  return Status;
+}
+
+// EncodingTranscodeUninstall
+/// Forget the encoding protocols that have direct transcoders
+/// @retval EFI_SUCCESS The transcoders were uninstalled
+EFI_STATUS
+EFIAPI
+EncodingTranscodeUninstall (
+  VOID
+) {
+  UINTN Index;
+  for (Index = 0; Index < TranscodeEncodingCount; ++Index) {
+    mTranscodeEncodings[Index] = NULL;
+  }
+  return EFI_SUCCESS;
+}
+// EncodingTranscodeInstall
+/// Remember the encoding protocols that have direct transcoders so they can be matched without locating them each conversion
+/// @retval EFI_SUCCESS The transcoders were installed
+EFI_STATUS
+EFIAPI
+EncodingTranscodeInstall (
+  VOID
+) {
+  mTranscodeEncodings[TranscodeLatin1] = EfiLatin1Encoding();
+  mTranscodeEncodings[TranscodeUtf8] = EfiUtf8Encoding();
+  mTranscodeEncodings[TranscodeUtf16] = EfiUtf16Encoding();
+  mTranscodeEncodings[TranscodeUtf16Swapped] = EfiUtf16SwappedEncoding();
+  return EFI_SUCCESS;
+}
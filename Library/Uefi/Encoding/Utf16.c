@@ -222,6 +222,8 @@ Utf16EncodingInstall (
   Encoding->MaxUnits = 2;
   Encoding->DecodeCharacter = Utf16DecodeCharacter;
   Encoding->EncodeCharacter = Utf16EncodeCharacter;
+  Encoding->Validate = NULL;
+  Encoding->DecodeValidated = NULL;
   // Install the encoding protocol
   Status = EfiInstallMultipleProtocolInterfaces(&mUtf16Handle, &gEfiUtf16EncodingProtocolGuid, Encoding, &gEfiEncodingProtocolGuid, Encoding, NULL);
   if (EFI_ERROR(Status)) {
@@ -228,6 +228,8 @@ Utf16SwappedEncodingInstall (
   Encoding->MaxUnits = 2;
   Encoding->DecodeCharacter = Utf16SwappedDecodeCharacter;
   Encoding->EncodeCharacter = Utf16SwappedEncodeCharacter;
+  Encoding->Validate = NULL;
+  Encoding->DecodeValidated = NULL;
   // Install the encoding protocol
   Status = EfiInstallMultipleProtocolInterfaces(&mUtf16SwappedHandle, &gEfiUtf16SwappedEncodingProtocolGuid, Encoding, &gEfiEncodingProtocolGuid, Encoding, NULL);
   if (EFI_ERROR(Status)) {
@@ -63,14 +63,14 @@ Utf8DecodeCharacter (
   BufferSize = *Size;
   // Get the string buffer
   Utf8 = (CONST CHAR8 *)Buffer;
-  // Try to decode characters
-  do {
+  // Try to decode characters until a valid one
+  for (;;) {
     // Check there is buffer remaining to decode
     if (BufferSize < sizeof(CHAR8)) {
       return (Status == EFI_WARN_UNKNOWN_GLYPH) ? EFI_NO_MAPPING : EFI_NOT_FOUND;
     }
     // Get the character unit
-    Unit = (UINT32)*Utf8++;
+    Unit = (UINT32)(UINT8)*Utf8++;
     // Decrease the size by a character
     BufferSize -= sizeof(CHAR8);
     // Check character is valid
@@ -86,18 +86,18 @@ Utf8DecodeCharacter (
         Status = EFI_WARN_UNKNOWN_GLYPH;
       }
       // Leading character unit
-      if (EFI_BIT_IS_UNSET(Unit, 6)) {
+      if (EFI_BIT_IS_UNSET(Unit, 5)) {
         // Two character sequence
         Trailers = 1;
-        Char = (UINT32)EFI_BITFIELD(Unit, 0, 5);
-      } else if (EFI_BIT_IS_UNSET(Unit, 5)) {
-        // Three character sequence
-        Trailers = 2;
         Char = (UINT32)EFI_BITFIELD(Unit, 0, 4);
       } else if (EFI_BIT_IS_UNSET(Unit, 4)) {
+        // Three character sequence
+        Trailers = 2;
+        Char = (UINT32)EFI_BITFIELD(Unit, 0, 3);
+      } else if (EFI_BIT_IS_UNSET(Unit, 3)) {
         // Four character sequence
         Trailers = 3;
-        Char = (UINT32)EFI_BITFIELD(Unit, 0, 3);
+        Char = (UINT32)EFI_BITFIELD(Unit, 0, 2);
       } else {
         // This character unit is skipped because of invalid encoding
         Status = EFI_WARN_UNKNOWN_GLYPH;
@@ -110,7 +110,7 @@ Utf8DecodeCharacter (
       if (Trailers != 0) {
         // Decode the trailing character unit
         Char <<= 6;
-        Char |= (UINT32)EFI_BITFIELD(Unit, 0, 6);
+        Char |= (UINT32)EFI_BITFIELD(Unit, 0, 5);
         // Keep decoding if more trailing character units are expected
         if (--Trailers != 0) {
           continue;
@@ -129,8 +129,11 @@ Utf8DecodeCharacter (
       // Single character unit code point
       Char = Unit;
     }
-  // Check the decoded character is valid
-  } while (!IsUnicodeCharacter(Char));
+    // Check the decoded character is valid
+    if (IsUnicodeCharacter(Char)) {
+      break;
+    }
+  }
   // Return the character
   *Character = Char;
   // Return the size of the buffer and status
@@ -216,6 +219,134 @@ Utf8EncodeCharacter (
   return Status;
 }
 
+// Utf8Validate
+/// Validate and count the leading run of well formed characters of an encoded character string
+/// @param This   The encoding protocol interface
+/// @param Buffer The encoded character string buffer to validate
+/// @param Size   On input, the size in bytes of the encoded character string buffer or zero if the string is null terminated, on output, the size in bytes of the well formed characters before the null terminator or the first invalid character
+/// @param Count  On output, the count of well formed characters
+/// @retval EFI_INVALID_PARAMETER If This, Buffer, or Size is NULL
+/// @retval EFI_NO_MAPPING        If validation stopped before an invalid or truncated character
+/// @retval EFI_SUCCESS           If every character before the null terminator or the end of the buffer is well formed
+STATIC
+EFI_STATUS
+EFIAPI
+Utf8Validate (
+  IN     EFI_ENCODING_PROTOCOL *This,
+  IN     CONST VOID            *Buffer,
+  IN OUT UINTN                 *Size,
+  OUT    UINTN                 *Count OPTIONAL
+) {
+  CONST UINT8 *Utf8;
+  UINTN        BufferSize;
+  UINTN        Validated;
+  UINTN        Characters;
+  UINTN        Offset;
+  UINTN        Index;
+  UINTN        Length;
+  UINT32       Char;
+  // Check parameters
+  if ((This == NULL) || (Buffer == NULL) || (Size == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Utf8 = (CONST UINT8 *)Buffer;
+  // Get the buffer size up to the null terminator if unknown
+  BufferSize = *Size;
+  if (BufferSize == 0) {
+    BufferSize = AsciiStrLen((CONST CHAR8 *)Buffer);
+  }
+  // Validate and count the well formed characters
+  Validated = EfiDispatch()->Utf8Validate(Utf8, BufferSize, &Characters);
+  // Well formed characters may still be code points the decoder rejects, every code point below 0x378 is valid so only
+  //  sequences with a leading unit of 0xCD or above need to be checked and only if there were any multiple unit sequences
+  if (Characters != Validated) {
+    for (Offset = 0, Index = 0; Offset < Validated; Offset += Length, ++Index) {
+      if (Utf8[Offset] < 0xCD) {
+        Length = (Utf8[Offset] < 0x80) ? 1 : 2;
+        continue;
+      }
+      if (Utf8[Offset] < 0xE0) {
+        Length = 2;
+        Char = ((UINT32)(Utf8[Offset] & 0x1F) << 6) | (UINT32)(Utf8[Offset + 1] & 0x3F);
+      } else if (Utf8[Offset] < 0xF0) {
+        Length = 3;
+        Char = ((UINT32)(Utf8[Offset] & 0x0F) << 12) | ((UINT32)(Utf8[Offset + 1] & 0x3F) << 6) | (UINT32)(Utf8[Offset + 2] & 0x3F);
+      } else {
+        Length = 4;
+        Char = ((UINT32)(Utf8[Offset] & 0x07) << 18) | ((UINT32)(Utf8[Offset + 1] & 0x3F) << 12) |
+               ((UINT32)(Utf8[Offset + 2] & 0x3F) << 6) | (UINT32)(Utf8[Offset + 3] & 0x3F);
+      }
+      if (!IsUnicodeCharacter(Char)) {
+        // Stop before the invalid code point
+        Validated = Offset;
+        Characters = Index;
+        break;
+      }
+    }
+  }
+  // Return the size and count of the well formed characters
+  if (Count != NULL) {
+    *Count = Characters;
+  }
+  *Size = Validated;
+  // Validation stopped early if the run did not reach the end of the buffer or the null terminator
+  return ((Validated == BufferSize) || (Utf8[Validated] == 0)) ? EFI_SUCCESS : EFI_NO_MAPPING;
+}
+// Utf8DecodeValidated
+/// Decode a character from an encoded character string that was validated, without checking the character units
+/// @param This      The encoding protocol interface
+/// @param Buffer    The validated encoded character string buffer to decode
+/// @param Size      On input, the size in bytes of the output string buffer, on output, the size in bytes used to decode the character from the output string buffer
+/// @param Character On output, the decoded Unicode character
+/// @retval EFI_INVALID_PARAMETER If This, Buffer, Size, or Character is NULL
+/// @retval EFI_NOT_FOUND         There were no characters remaining to decode
+/// @retval EFI_SUCCESS           The character was decoded successfully
+STATIC
+EFI_STATUS
+EFIAPI
+Utf8DecodeValidated (
+  IN     EFI_ENCODING_PROTOCOL *This,
+  IN     CONST VOID            *Buffer,
+  IN OUT UINTN                 *Size,
+  OUT    UINT32                *Character
+) {
+  CONST UINT8 *Utf8;
+  UINTN        Length;
+  UINTN        Index;
+  UINT32       Char;
+  // Check parameters
+  if ((This == NULL) || (Buffer == NULL) || (Size == NULL) || (Character == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (*Size < sizeof(CHAR8)) {
+    return EFI_NOT_FOUND;
+  }
+  Utf8 = (CONST UINT8 *)Buffer;
+  // The leading unit gives the length of the sequence since the string is well formed
+  Char = Utf8[0];
+  if (Char < 0x80) {
+    Length = 1;
+  } else if (Char < 0xE0) {
+    Length = 2;
+    Char &= 0x1F;
+  } else if (Char < 0xF0) {
+    Length = 3;
+    Char &= 0x0F;
+  } else {
+    Length = 4;
+    Char &= 0x07;
+  }
+  if (*Size < Length) {
+    return EFI_NOT_FOUND;
+  }
+  for (Index = 1; Index < Length; ++Index) {
+    Char = (Char << 6) | (UINT32)(Utf8[Index] & 0x3F);
+  }
+  *Size = Length;
+  *Character = Char;
+  return EFI_SUCCESS;
+}
+
 // Utf8EncodingUninstall
 /// Uninstall UTF-8 encoding protocol
 EFI_STATUS
@@ -263,6 +394,8 @@ Utf8EncodingInstall (
   Encoding->MaxUnits = 4;
   Encoding->DecodeCharacter = Utf8DecodeCharacter;
   Encoding->EncodeCharacter = Utf8EncodeCharacter;
+  Encoding->Validate = Utf8Validate;
+  Encoding->DecodeValidated = Utf8DecodeValidated;
   // Install the encoding protocol
   Status = EfiInstallMultipleProtocolInterfaces(&mUtf8Handle, &gEfiUtf8EncodingProtocolGuid, Encoding, &gEfiEncodingProtocolGuid, Encoding, NULL);
   if (EFI_ERROR(Status)) {
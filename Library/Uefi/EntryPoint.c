@@ -189,6 +189,11 @@ EfiEntryPointInstall (
   if (EFI_ERROR(Status)) {
     return Status;
   }
+  // Install image override protocol before the protocols that register exit boot services callbacks
+  Status = EfiImageOverrideInstall();
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
   // Install the locale protocols
   Status = EfiLocaleInstall();
   if (EFI_ERROR(Status)) {
@@ -205,14 +210,6 @@ EfiEntryPointInstall (
 #endif
   // Install configuration protocol
   Status = EfiConfigurationInstall();
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  // Install image override protocol
-  Status = EfiImageOverrideInstall();
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
   return Status;
 }
 
@@ -230,6 +227,8 @@ EfiEntryPointUninstall (
   EfiImageOverrideUninstall(ImageHandle);
   // Uninstall configuration protocol
   EfiConfigurationUninstall();
+  // Free the interned strings
+  EfiInternFree();
 #if defined(EFI_MEMORY_VIRTUAL)
   // Print memory allocation records
   EfiPrintMemoryRecords();
@@ -242,6 +241,8 @@ EfiEntryPointUninstall (
   EfiLogUninstall();
   // Uninstall the locale protocols
   EfiLocaleUninstall();
+  // Free the compiled glob patterns
+  EfiGlobCacheFree();
   // Uninstall the encoding protocols
   EfiEncodingUninstall();
 #if defined(EFI_MEMORY_VIRTUAL)
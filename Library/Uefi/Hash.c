@@ -0,0 +1,582 @@
+///
+/// @file Library/Uefi/Hash.c
+///
+/// UEFI fast non-cryptographic hashing
+///
+
+#include <Uefi.h>
+
+// HASH_PRIME32_1
+/// The first 32-bit prime
+#define HASH_PRIME32_1 0x9E3779B1ULL
+// HASH_PRIME32_2
+/// The second 32-bit prime
+#define HASH_PRIME32_2 0x85EBCA77ULL
+// HASH_PRIME32_3
+/// The third 32-bit prime
+#define HASH_PRIME32_3 0xC2B2AE3DULL
+// HASH_PRIME64_1
+/// The first 64-bit prime
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ULL
+// HASH_PRIME64_2
+/// The second 64-bit prime
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+// HASH_PRIME64_3
+/// The third 64-bit prime
+#define HASH_PRIME64_3 0x165667B19E3779F9ULL
+// HASH_PRIME64_4
+/// The fourth 64-bit prime
+#define HASH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+// HASH_PRIME64_5
+/// The fifth 64-bit prime
+#define HASH_PRIME64_5 0x27D4EB2F165667C5ULL
+// HASH_PRIME_MIX_1
+/// The multiplier of the final avalanche
+#define HASH_PRIME_MIX_1 0x165667919E3779F9ULL
+// HASH_PRIME_MIX_2
+/// The multiplier of the four to eight byte mix
+#define HASH_PRIME_MIX_2 0x9FB21C651E98DF25ULL
+// HASH_STRIPE_SIZE
+/// The size in bytes of a stripe of long data
+#define HASH_STRIPE_SIZE 64
+// HASH_BLOCK_STRIPES
+/// The count of stripes in a block of long data, the accumulators are scrambled after each block
+#define HASH_BLOCK_STRIPES ((EFI_HASH_SECRET_SIZE - HASH_STRIPE_SIZE) / 8)
+// HASH_SHORT_MAXIMUM
+/// The largest size in bytes of data that is hashed without stripes
+#define HASH_SHORT_MAXIMUM 240
+// HASH_FOLD_CHUNK_LENGTH
+/// The count of upper case characters that are hashed at once by the case insensitive string hashes
+#define HASH_FOLD_CHUNK_LENGTH (HASH_SHORT_MAXIMUM / sizeof(CHAR16))
+
+// mHashSecret
+/// The default secret
+STATIC CONST UINT8 mHashSecret[EFI_HASH_SECRET_SIZE] = {
+  0xB8, 0xFE, 0x6C, 0x39, 0x23, 0xA4, 0x4B, 0xBE, 0x7C, 0x01, 0x81, 0x2C, 0xF7, 0x21, 0xAD, 0x1C,
+  0xDE, 0xD4, 0x6D, 0xE9, 0x83, 0x90, 0x97, 0xDB, 0x72, 0x40, 0xA4, 0xA4, 0xB7, 0xB3, 0x67, 0x1F,
+  0xCB, 0x79, 0xE6, 0x4E, 0xCC, 0xC0, 0xE5, 0x78, 0x82, 0x5A, 0xD0, 0x7D, 0xCC, 0xFF, 0x72, 0x21,
+  0xB8, 0x08, 0x46, 0x74, 0xF7, 0x43, 0x24, 0x8E, 0xE0, 0x35, 0x90, 0xE6, 0x81, 0x3A, 0x26, 0x4C,
+  0x3C, 0x28, 0x52, 0xBB, 0x91, 0xC3, 0x00, 0xCB, 0x88, 0xD0, 0x65, 0x8B, 0x1B, 0x53, 0x2E, 0xA3,
+  0x71, 0x64, 0x48, 0x97, 0xA2, 0x0D, 0xF9, 0x4E, 0x38, 0x19, 0xEF, 0x46, 0xA9, 0xDE, 0xAC, 0xD8,
+  0xA8, 0xFA, 0x76, 0x3F, 0xE3, 0x9C, 0x34, 0x3F, 0xF9, 0xDC, 0xBB, 0xC7, 0xC7, 0x0B, 0x4F, 0x1D,
+  0x8A, 0x51, 0xE0, 0x4B, 0xCD, 0xB4, 0x59, 0x31, 0xC8, 0x9F, 0x7E, 0xC9, 0xD9, 0x78, 0x73, 0x64,
+  0xEA, 0xC5, 0xAC, 0x83, 0x34, 0xD3, 0xEB, 0xC3, 0xC5, 0x81, 0xA0, 0xFF, 0xFA, 0x13, 0x63, 0xEB,
+  0x17, 0x0D, 0xDD, 0x51, 0xB7, 0xF0, 0xDA, 0x49, 0xD3, 0x16, 0x55, 0x26, 0x29, 0xD4, 0x68, 0x9E,
+  0x2B, 0x16, 0xBE, 0x58, 0x7D, 0x47, 0xA1, 0xFC, 0x8F, 0xF8, 0xB8, 0xD1, 0x7A, 0xD0, 0x31, 0xCE,
+  0x45, 0xCB, 0x3A, 0x8F, 0x95, 0x16, 0x04, 0x28, 0xAF, 0xD7, 0xFB, 0xCA, 0xBB, 0x4B, 0x40, 0x7E
+};
+// mHashAccumulators
+/// The initial accumulators of long data
+STATIC CONST UINT64 mHashAccumulators[8] = {
+  HASH_PRIME32_3, HASH_PRIME64_1, HASH_PRIME64_2, HASH_PRIME64_3, HASH_PRIME64_4, HASH_PRIME32_2, HASH_PRIME64_5, HASH_PRIME32_1
+};
+
+// HashRead32
+/// Read a little endian 32-bit value
+/// @param Ptr The bytes to read
+/// @return The 32-bit value
+STATIC
+UINT32
+EFIAPI
+HashRead32 (
+  IN CONST UINT8 *Ptr
+) {
+  return (UINT32)Ptr[0] | ((UINT32)Ptr[1] << 8) | ((UINT32)Ptr[2] << 16) | ((UINT32)Ptr[3] << 24);
+}
+// HashRead64
+/// Read a little endian 64-bit value
+/// @param Ptr The bytes to read
+/// @return The 64-bit value
+STATIC
+UINT64
+EFIAPI
+HashRead64 (
+  IN CONST UINT8 *Ptr
+) {
+  return (UINT64)HashRead32(Ptr) | ((UINT64)HashRead32(Ptr + 4) << 32);
+}
+// HashWrite64
+/// Write a little endian 64-bit value
+/// @param Ptr   The bytes to write
+/// @param Value The 64-bit value
+STATIC
+VOID
+EFIAPI
+HashWrite64 (
+  OUT UINT8  *Ptr,
+  IN  UINT64  Value
+) {
+  UINTN Index;
+  for (Index = 0; Index < sizeof(UINT64); ++Index) {
+    Ptr[Index] = (UINT8)(Value >> (Index * 8));
+  }
+}
+// HashMultiplyFold
+/// Multiply two 64-bit values to a 128-bit product and fold the halves of the product together
+/// @param Left  The first value
+/// @param Right The second value
+/// @return The exclusive or of the low and high halves of the product
+STATIC
+UINT64
+EFIAPI
+HashMultiplyFold (
+  IN UINT64 Left,
+  IN UINT64 Right
+) {
+  UINT64 LowLow = (Left & 0xFFFFFFFF) * (Right & 0xFFFFFFFF);
+  UINT64 HighLow = (Left >> 32) * (Right & 0xFFFFFFFF);
+  UINT64 LowHigh = (Left & 0xFFFFFFFF) * (Right >> 32);
+  UINT64 HighHigh = (Left >> 32) * (Right >> 32);
+  UINT64 Cross = (LowLow >> 32) + (HighLow & 0xFFFFFFFF) + LowHigh;
+  return ((Cross << 32) | (LowLow & 0xFFFFFFFF)) ^ ((HighLow >> 32) + (Cross >> 32) + HighHigh);
+}
+// HashAvalanche
+/// Mix the bits of an accumulated hash
+/// @param Hash The accumulated hash
+/// @return The mixed hash
+STATIC
+UINT64
+EFIAPI
+HashAvalanche (
+  IN UINT64 Hash
+) {
+  Hash ^= Hash >> 37;
+  Hash *= HASH_PRIME_MIX_1;
+  return Hash ^ (Hash >> 32);
+}
+// HashAvalancheStrong
+/// Mix the bits of a hash of data that was mixed only once
+/// @param Hash The hash
+/// @return The mixed hash
+STATIC
+UINT64
+EFIAPI
+HashAvalancheStrong (
+  IN UINT64 Hash
+) {
+  Hash ^= Hash >> 33;
+  Hash *= HASH_PRIME64_2;
+  Hash ^= Hash >> 29;
+  Hash *= HASH_PRIME64_3;
+  return Hash ^ (Hash >> 32);
+}
+// HashMix16
+/// Mix sixteen bytes of data with sixteen bytes of secret
+/// @param Data   The data
+/// @param Secret The secret
+/// @param Seed   The seed of the hash
+/// @return The mixed bytes
+STATIC
+UINT64
+EFIAPI
+HashMix16 (
+  IN CONST UINT8 *Data,
+  IN CONST UINT8 *Secret,
+  IN UINT64       Seed
+) {
+  return HashMultiplyFold(HashRead64(Data) ^ (HashRead64(Secret) + Seed), HashRead64(Data + 8) ^ (HashRead64(Secret + 8) - Seed));
+}
+// HashShort
+/// Hash data without stripes
+/// @param Data The data
+/// @param Size The size in bytes of the data, which must be at most HASH_SHORT_MAXIMUM
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the data
+STATIC
+UINT64
+EFIAPI
+HashShort (
+  IN CONST UINT8 *Data,
+  IN UINTN        Size,
+  IN UINT64       Seed
+) {
+  CONST UINT8 *Secret = mHashSecret;
+  UINT64       Hash;
+  UINT64       Low;
+  UINT64       High;
+  UINTN        Rounds;
+  UINTN        Index;
+  if (Size == 0) {
+    return HashAvalancheStrong(Seed ^ (HashRead64(Secret + 56) ^ HashRead64(Secret + 64)));
+  }
+  if (Size < 4) {
+    // Combine the first, middle and last bytes with the size
+    Low = ((UINT64)Data[0] << 16) | ((UINT64)Data[Size >> 1] << 24) | (UINT64)Data[Size - 1] | ((UINT64)Size << 8);
+    return HashAvalancheStrong(Low ^ ((UINT64)(HashRead32(Secret) ^ HashRead32(Secret + 4)) + Seed));
+  }
+  if (Size <= 8) {
+    // Combine the overlapping first and last four bytes
+    Seed ^= (UINT64)EfiByteSwap32((UINT32)Seed) << 32;
+    Hash = ((UINT64)HashRead32(Data + Size - 4) + ((UINT64)HashRead32(Data) << 32)) ^ ((HashRead64(Secret + 8) ^ HashRead64(Secret + 16)) - Seed);
+    Hash ^= ((Hash << 49) | (Hash >> 15)) ^ ((Hash << 24) | (Hash >> 40));
+    Hash *= HASH_PRIME_MIX_2;
+    Hash ^= (Hash >> 35) + Size;
+    Hash *= HASH_PRIME_MIX_2;
+    return Hash ^ (Hash >> 28);
+  }
+  if (Size <= 16) {
+    // Combine the overlapping first and last eight bytes
+    Low = HashRead64(Data) ^ ((HashRead64(Secret + 24) ^ HashRead64(Secret + 32)) + Seed);
+    High = HashRead64(Data + Size - 8) ^ ((HashRead64(Secret + 40) ^ HashRead64(Secret + 48)) - Seed);
+    return HashAvalanche(Size + EfiByteSwap64(Low) + High + HashMultiplyFold(Low, High));
+  }
+  Hash = Size * HASH_PRIME64_1;
+  if (Size <= 128) {
+    // Mix pairs of sixteen bytes from both ends toward the middle
+    Rounds = (Size - 1) / 32;
+    for (Index = Rounds + 1; Index-- != 0;) {
+      Hash += HashMix16(Data + (Index * 16), Secret + (Index * 32), Seed);
+      Hash += HashMix16(Data + Size - ((Index + 1) * 16), Secret + (Index * 32) + 16, Seed);
+    }
+    return HashAvalanche(Hash);
+  }
+  // Mix the first eight sixteen bytes, then the rest with an offset secret, then the last sixteen bytes
+  Rounds = Size / 16;
+  for (Index = 0; Index < 8; ++Index) {
+    Hash += HashMix16(Data + (Index * 16), Secret + (Index * 16), Seed);
+  }
+  Hash = HashAvalanche(Hash);
+  for (Index = 8; Index < Rounds; ++Index) {
+    Hash += HashMix16(Data + (Index * 16), Secret + ((Index - 8) * 16) + 3, Seed);
+  }
+  Hash += HashMix16(Data + Size - 16, Secret + 136 - 17, Seed);
+  return HashAvalanche(Hash);
+}
+// HashDeriveSecret
+/// Derive the secret of a seed from the default secret
+/// @param Secret On output, the secret
+/// @param Seed   The seed of the hash
+STATIC
+VOID
+EFIAPI
+HashDeriveSecret (
+  OUT UINT8  *Secret,
+  IN  UINT64  Seed
+) {
+  UINTN Index;
+  for (Index = 0; Index < EFI_HASH_SECRET_SIZE; Index += 16) {
+    HashWrite64(Secret + Index, HashRead64(mHashSecret + Index) + Seed);
+    HashWrite64(Secret + Index + 8, HashRead64(mHashSecret + Index + 8) - Seed);
+  }
+}
+// HashScramble
+/// Scramble the accumulators at the end of a block
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Secret       The secret
+STATIC
+VOID
+EFIAPI
+HashScramble (
+  IN OUT UINT64      *Accumulators,
+  IN     CONST UINT8 *Secret
+) {
+  UINTN Index;
+  Secret += EFI_HASH_SECRET_SIZE - HASH_STRIPE_SIZE;
+  for (Index = 0; Index < 8; ++Index) {
+    Accumulators[Index] ^= Accumulators[Index] >> 47;
+    Accumulators[Index] ^= HashRead64(Secret + (Index * 8));
+    Accumulators[Index] *= HASH_PRIME32_1;
+  }
+}
+// HashConsume
+/// Accumulate stripes of data, scrambling the accumulators at the end of each block
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Consumed     The count of stripes already accumulated in the current block
+/// @param Data         The data
+/// @param Stripes      The count of stripes of the data
+/// @param Secret       The secret
+STATIC
+VOID
+EFIAPI
+HashConsume (
+  IN OUT UINT64      *Accumulators,
+  IN OUT UINTN       *Consumed,
+  IN     CONST UINT8 *Data,
+  IN     UINTN        Stripes,
+  IN     CONST UINT8 *Secret
+) {
+  EFI_DISPATCH_HASH_ACCUMULATE Accumulate = EfiDispatch()->HashAccumulate;
+  UINTN                        Count;
+  while (Stripes != 0) {
+    Count = HASH_BLOCK_STRIPES - *Consumed;
+    if (Count > Stripes) {
+      Count = Stripes;
+    }
+    Accumulate(Accumulators, Data, Count, Secret + (*Consumed * 8));
+    Data += Count * HASH_STRIPE_SIZE;
+    Stripes -= Count;
+    *Consumed += Count;
+    if (*Consumed == HASH_BLOCK_STRIPES) {
+      HashScramble(Accumulators, Secret);
+      *Consumed = 0;
+    }
+  }
+}
+// HashMerge
+/// Merge the accumulators after the last stripe into the hash
+/// @param Accumulators The eight 64-bit hash accumulators
+/// @param Secret       The secret
+/// @param Size         The size in bytes of the data
+/// @return The 64-bit hash of the data
+STATIC
+UINT64
+EFIAPI
+HashMerge (
+  IN CONST UINT64 *Accumulators,
+  IN CONST UINT8  *Secret,
+  IN UINT64        Size
+) {
+  UINT64 Hash = Size * HASH_PRIME64_1;
+  UINTN  Index;
+  for (Index = 0; Index < 8; Index += 2) {
+    Hash += HashMultiplyFold(Accumulators[Index] ^ HashRead64(Secret + 11 + (Index * 8)),
+                             Accumulators[Index + 1] ^ HashRead64(Secret + 19 + (Index * 8)));
+  }
+  return HashAvalanche(Hash);
+}
+
+// EfiHash64
+/// Compute the 64-bit hash of a data buffer, the hash is the XXH3 64-bit hash
+/// @param Data The data buffer, which may be NULL if Size is zero
+/// @param Size The size in bytes of the data buffer
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the data buffer
+UINT64
+EFIAPI
+EfiHash64 (
+  IN CONST VOID *Data OPTIONAL,
+  IN UINTN       Size,
+  IN UINT64      Seed
+) {
+  CONST UINT8 *Ptr = (CONST UINT8 *)Data;
+  CONST UINT8 *Secret = mHashSecret;
+  UINT8        Derived[EFI_HASH_SECRET_SIZE];
+  UINT64       Accumulators[8];
+  UINTN        Consumed = 0;
+  if ((Ptr == NULL) || (Size <= HASH_SHORT_MAXIMUM)) {
+    return HashShort(Ptr, (Ptr == NULL) ? 0 : Size, Seed);
+  }
+  if (Seed != 0) {
+    HashDeriveSecret(Derived, Seed);
+    Secret = Derived;
+  }
+  // Accumulate every stripe before the last byte then the last full stripe
+  EfiCopyArray(UINT64, Accumulators, mHashAccumulators, ARRAY_COUNT(Accumulators));
+  HashConsume(Accumulators, &Consumed, Ptr, (Size - 1) / HASH_STRIPE_SIZE, Secret);
+  EfiDispatch()->HashAccumulate(Accumulators, Ptr + Size - HASH_STRIPE_SIZE, 1, Secret + EFI_HASH_SECRET_SIZE - HASH_STRIPE_SIZE - 7);
+  return HashMerge(Accumulators, Secret, Size);
+}
+
+// EfiHash64Init
+/// Initialize a context to compute a 64-bit hash incrementally
+/// @param Context The hash context to initialize
+/// @param Seed    The seed of the hash
+/// @retval EFI_INVALID_PARAMETER If Context is NULL
+/// @retval EFI_SUCCESS           If the context was initialized
+EFI_STATUS
+EFIAPI
+EfiHash64Init (
+  OUT EFI_HASH_CONTEXT *Context,
+  IN  UINT64            Seed
+) {
+  if (Context == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  EfiCopyArray(UINT64, Context->Accumulators, mHashAccumulators, ARRAY_COUNT(Context->Accumulators));
+  HashDeriveSecret(Context->Secret, Seed);
+  Context->Size = 0;
+  Context->Seed = Seed;
+  Context->Buffered = 0;
+  Context->Stripes = 0;
+  return EFI_SUCCESS;
+}
+// EfiHash64Update
+/// Update a 64-bit hash context with the next part of the data
+/// @param Context The hash context
+/// @param Data    The next part of the data, which may be NULL if Size is zero
+/// @param Size    The size in bytes of the next part of the data
+/// @retval EFI_INVALID_PARAMETER If Context is NULL or Data is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the context was updated
+EFI_STATUS
+EFIAPI
+EfiHash64Update (
+  IN OUT EFI_HASH_CONTEXT *Context,
+  IN     CONST VOID       *Data OPTIONAL,
+  IN     UINTN             Size
+) {
+  CONST UINT8 *Ptr = (CONST UINT8 *)Data;
+  UINTN        Count;
+  if ((Context == NULL) || ((Ptr == NULL) && (Size != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Context->Size += Size;
+  // Buffer the data while it fits, a byte is always kept back so the last stripe is accumulated by the final hash
+  if (Size <= (EFI_HASH_BUFFER_SIZE - Context->Buffered)) {
+    EfiCopyMem(Context->Buffer + Context->Buffered, Ptr, Size);
+    Context->Buffered += Size;
+    return EFI_SUCCESS;
+  }
+  // Fill and consume the buffer
+  if (Context->Buffered != 0) {
+    Count = EFI_HASH_BUFFER_SIZE - Context->Buffered;
+    EfiCopyMem(Context->Buffer + Context->Buffered, Ptr, Count);
+    Ptr += Count;
+    Size -= Count;
+    HashConsume(Context->Accumulators, &(Context->Stripes), Context->Buffer, EFI_HASH_BUFFER_SIZE / HASH_STRIPE_SIZE, Context->Secret);
+    Context->Buffered = 0;
+  }
+  // Consume the stripes directly from the data, keeping the last consumed stripe in case the final stripe needs it
+  if (Size > EFI_HASH_BUFFER_SIZE) {
+    Count = (Size - 1) / HASH_STRIPE_SIZE;
+    HashConsume(Context->Accumulators, &(Context->Stripes), Ptr, Count, Context->Secret);
+    Ptr += Count * HASH_STRIPE_SIZE;
+    Size -= Count * HASH_STRIPE_SIZE;
+    EfiCopyMem(Context->Buffer + EFI_HASH_BUFFER_SIZE - HASH_STRIPE_SIZE, Ptr - HASH_STRIPE_SIZE, HASH_STRIPE_SIZE);
+  }
+  EfiCopyMem(Context->Buffer, Ptr, Size);
+  Context->Buffered = Size;
+  return EFI_SUCCESS;
+}
+// EfiHash64Final
+/// Get the 64-bit hash of all the data a context was updated with, the context is unchanged and may be updated further
+/// @param Context The hash context
+/// @param Hash    On output, the 64-bit hash, which is the same as the hash of all the data at once
+/// @retval EFI_INVALID_PARAMETER If Context or Hash is NULL
+/// @retval EFI_SUCCESS           If the 64-bit hash was returned
+EFI_STATUS
+EFIAPI
+EfiHash64Final (
+  IN  CONST EFI_HASH_CONTEXT *Context,
+  OUT UINT64                 *Hash
+) {
+  UINT64 Accumulators[8];
+  UINT8  Stripe[HASH_STRIPE_SIZE];
+  UINTN  Consumed;
+  UINTN  Count;
+  if ((Context == NULL) || (Hash == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Context->Size <= HASH_SHORT_MAXIMUM) {
+    *Hash = HashShort(Context->Buffer, (UINTN)Context->Size, Context->Seed);
+    return EFI_SUCCESS;
+  }
+  // Accumulate the buffered stripes before the last byte then the last full stripe, which may start in the last consumed stripe
+  EfiCopyArray(UINT64, Accumulators, Context->Accumulators, ARRAY_COUNT(Accumulators));
+  Consumed = Context->Stripes;
+  if (Context->Buffered >= HASH_STRIPE_SIZE) {
+    HashConsume(Accumulators, &Consumed, Context->Buffer, (Context->Buffered - 1) / HASH_STRIPE_SIZE, Context->Secret);
+    EfiCopyMem(Stripe, Context->Buffer + Context->Buffered - HASH_STRIPE_SIZE, HASH_STRIPE_SIZE);
+  } else {
+    Count = HASH_STRIPE_SIZE - Context->Buffered;
+    EfiCopyMem(Stripe, Context->Buffer + EFI_HASH_BUFFER_SIZE - Count, Count);
+    EfiCopyMem(Stripe + Count, Context->Buffer, Context->Buffered);
+  }
+  EfiDispatch()->HashAccumulate(Accumulators, Stripe, 1, Context->Secret + EFI_HASH_SECRET_SIZE - HASH_STRIPE_SIZE - 7);
+  *Hash = HashMerge(Accumulators, Context->Secret, Context->Size);
+  return EFI_SUCCESS;
+}
+
+// StrHash64
+/// Compute the 64-bit hash of the characters of a string, which is the hash of the characters as UTF-16 data
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+UINT64
+EFIAPI
+StrHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINT64        Seed
+) {
+  return EfiHash64(Str, (Str == NULL) ? 0 : (StrLen(Str) * sizeof(CHAR16)), Seed);
+}
+// StrnHash64
+/// Compute the 64-bit hash of at most a count of characters of a string, which is the hash of the characters as UTF-16 data
+/// @param Str    The string, which may be NULL to hash no characters
+/// @param Length The maximum count of characters to hash, the string is hashed up to the null terminator if it is shorter
+/// @param Seed   The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+UINT64
+EFIAPI
+StrnHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINTN         Length,
+  IN UINT64        Seed
+) {
+  UINTN Count = 0;
+  if (Str != NULL) {
+    while ((Count < Length) && (Str[Count] != 0)) {
+      ++Count;
+    }
+  }
+  return EfiHash64(Str, Count * sizeof(CHAR16), Seed);
+}
+// StriHash64
+/// Compute the case insensitive 64-bit hash of the characters of a string, which is the hash of the upper case characters as UTF-16 data
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the upper case characters of the string
+UINT64
+EFIAPI
+StriHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINT64        Seed
+) {
+  return StrniHash64(Str, MAX_UINTN, Seed);
+}
+// StrniHash64
+/// Compute the case insensitive 64-bit hash of at most a count of characters of a string, which is the hash of the upper case characters as UTF-16 data
+/// @param Str    The string, which may be NULL to hash no characters
+/// @param Length The maximum count of characters to hash, the string is hashed up to the null terminator if it is shorter
+/// @param Seed   The seed of the hash
+/// @return The 64-bit hash of the upper case characters of the string
+UINT64
+EFIAPI
+StrniHash64 (
+  IN CONST CHAR16 *Str OPTIONAL,
+  IN UINTN         Length,
+  IN UINT64        Seed
+) {
+  EFI_HASH_CONTEXT Context;
+  CHAR16           Chunk[HASH_FOLD_CHUNK_LENGTH];
+  BOOLEAN          Streaming = FALSE;
+  UINT64           Hash;
+  UINTN            Count;
+  if (Str == NULL) {
+    return EfiHash64(NULL, 0, Seed);
+  }
+  for (;;) {
+    // Fold a chunk of characters to upper case
+    for (Count = 0; (Count < ARRAY_COUNT(Chunk)) && (Count < Length) && (Str[Count] != 0); ++Count) {
+      Chunk[Count] = CharToUpper(Str[Count]);
+    }
+    Str += Count;
+    Length -= Count;
+    // Short strings are hashed at once from the first chunk
+    if (!Streaming) {
+      if ((Length == 0) || (*Str == 0)) {
+        return EfiHash64(Chunk, Count * sizeof(CHAR16), Seed);
+      }
+      EfiHash64Init(&Context, Seed);
+      Streaming = TRUE;
+    }
+    EfiHash64Update(&Context, Chunk, Count * sizeof(CHAR16));
+    if ((Length == 0) || (*Str == 0)) {
+      break;
+    }
+  }
+  EfiHash64Final(&Context, &Hash);
+  return Hash;
+}
+// AsciiStrHash64
+/// Compute the 64-bit hash of the characters of a string
+/// @param Str  The string, which may be NULL to hash no characters
+/// @param Seed The seed of the hash
+/// @return The 64-bit hash of the characters of the string
+UINT64
+EFIAPI
+AsciiStrHash64 (
+  IN CONST CHAR8 *Str OPTIONAL,
+  IN UINT64       Seed
+) {
+  return EfiHash64(Str, (Str == NULL) ? 0 : AsciiStrLen(Str), Seed);
+}
@@ -0,0 +1,113 @@
+///
+/// @file Library/Uefi/HashMap.c
+///
+/// UEFI open addressing hash map key functions
+///
+
+#include <Uefi.h>
+
+// EfiHashMapStrHash
+/// Hash a string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the string key
+UINT64
+EFIAPI
+EfiHashMapStrHash (
+  IN CONST CHAR16 *Key
+) {
+  return StrHash64(Key, 0);
+}
+// EfiHashMapStrEqual
+/// Check if two string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal or not
+BOOLEAN
+EFIAPI
+EfiHashMapStrEqual (
+  IN CONST CHAR16 *Key1,
+  IN CONST CHAR16 *Key2
+) {
+  if ((Key1 == NULL) || (Key2 == NULL)) {
+    return (Key1 == Key2);
+  }
+  return ((Key1 == Key2) || (StrCmp(Key1, Key2) == 0));
+}
+// EfiHashMapStriHash
+/// Hash a case insensitive string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the upper case string key
+UINT64
+EFIAPI
+EfiHashMapStriHash (
+  IN CONST CHAR16 *Key
+) {
+  return StriHash64(Key, 0);
+}
+// EfiHashMapStriEqual
+/// Check if two case insensitive string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal ignoring case or not
+BOOLEAN
+EFIAPI
+EfiHashMapStriEqual (
+  IN CONST CHAR16 *Key1,
+  IN CONST CHAR16 *Key2
+) {
+  if ((Key1 == NULL) || (Key2 == NULL)) {
+    return (Key1 == Key2);
+  }
+  return ((Key1 == Key2) || (StriCmp(Key1, Key2) == 0));
+}
+// EfiHashMapAsciiStrHash
+/// Hash a string key of a hash map
+/// @param Key The string key
+/// @return The 64-bit hash of the string key
+UINT64
+EFIAPI
+EfiHashMapAsciiStrHash (
+  IN CONST CHAR8 *Key
+) {
+  return AsciiStrHash64(Key, 0);
+}
+// EfiHashMapAsciiStrEqual
+/// Check if two string keys of a hash map are equal
+/// @param Key1 The first string key
+/// @param Key2 The second string key
+/// @return Whether the string keys are equal or not
+BOOLEAN
+EFIAPI
+EfiHashMapAsciiStrEqual (
+  IN CONST CHAR8 *Key1,
+  IN CONST CHAR8 *Key2
+) {
+  if ((Key1 == NULL) || (Key2 == NULL)) {
+    return (Key1 == Key2);
+  }
+  return ((Key1 == Key2) || (AsciiStrCmp(Key1, Key2) == 0));
+}
+// EfiHashMapPointerHash
+/// Hash a pointer or integer key of a hash map
+/// @param Key The pointer or integer key
+/// @return The 64-bit hash of the key
+UINT64
+EFIAPI
+EfiHashMapPointerHash (
+  IN CONST VOID *Key
+) {
+  return EfiHash64(&Key, sizeof(Key), 0);
+}
+// EfiHashMapPointerEqual
+/// Check if two pointer or integer keys of a hash map are equal
+/// @param Key1 The first key
+/// @param Key2 The second key
+/// @return Whether the keys are equal or not
+BOOLEAN
+EFIAPI
+EfiHashMapPointerEqual (
+  IN CONST VOID *Key1,
+  IN CONST VOID *Key2
+) {
+  return (Key1 == Key2);
+}
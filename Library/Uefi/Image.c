@@ -627,3 +627,38 @@ EfiExitBootServicesCallback (
   ImageOverride->ExitBootServicesCallbacks = Callbacks;
   return EFI_SUCCESS;
 }
+// EfiExitBootServicesRemoveCallback
+/// Remove an exit boot services callback
+/// @param Callback     The callback function that was registered
+/// @param CallbackData The data that was registered with the callback function
+/// @retval EFI_UNSUPPORTED       The image override protocol is not installed
+/// @retval EFI_INVALID_PARAMETER If Callback is NULL
+/// @retval EFI_NOT_FOUND         The callback was not registered with the callback data
+/// @retval EFI_SUCCESS           The callback was removed
+EFI_STATUS
+EFIAPI
+EfiExitBootServicesRemoveCallback (
+  IN EFI_IMAGE_CALLBACK  Callback,
+  IN VOID               *CallbackData OPTIONAL
+) {
+  EFI_IMAGE_OVERRIDE_PROTOCOL  *ImageOverride = ImageOverrideGetProtocol();
+  EFI_IMAGE_OVERRIDE_CALLBACK **Link;
+  EFI_IMAGE_OVERRIDE_CALLBACK  *Callbacks;
+  // Check parameters
+  if (ImageOverride == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  if (Callback == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Find the callback registered by this image with the same data
+  for (Link = &(ImageOverride->ExitBootServicesCallbacks); *Link != NULL; Link = &((*Link)->Next)) {
+    Callbacks = *Link;
+    if ((Callbacks->ImageHandle == gEfiImageHandle) && (Callbacks->Callback.Default == Callback) && (Callbacks->Data == CallbackData)) {
+      // Remove callback
+      *Link = Callbacks->Next;
+      return EfiFreePool((VOID *)Callbacks);
+    }
+  }
+  return EFI_NOT_FOUND;
+}
@@ -0,0 +1,215 @@
+///
+/// @file Library/Uefi/Intern.c
+///
+/// UEFI string interning
+///
+
+#include <Uefi.h>
+
+// INTERN_ARENA_CHUNK_SIZE
+/// The size in bytes of each chunk of the arena that stores the interned strings
+#define INTERN_ARENA_CHUNK_SIZE 8192
+
+// INTERN_KEY
+/// An intern table key, the characters of a string that may not be null terminated
+typedef struct INTERN_KEY INTERN_KEY;
+struct INTERN_KEY {
+
+  // String
+  /// The characters of the string
+  CONST CHAR16 *String;
+  // Length
+  /// The count of characters of the string
+  UINTN         Length;
+
+};
+
+// InternHash
+/// Hash the characters of a string
+/// @param Key The characters of the string
+/// @return The hash of the characters
+STATIC
+UINT64
+EFIAPI
+InternHash (
+  IN INTERN_KEY Key
+) {
+  return StrnHash64(Key.String, Key.Length, 0);
+}
+// InternEqual
+/// Check if the characters of two strings are equal
+/// @param Key1 The characters of the first string
+/// @param Key2 The characters of the second string
+/// @return Whether the characters are equal or not
+STATIC
+BOOLEAN
+EFIAPI
+InternEqual (
+  IN INTERN_KEY Key1,
+  IN INTERN_KEY Key2
+) {
+  UINTN Index;
+  if (Key1.Length != Key2.Length) {
+    return FALSE;
+  }
+  for (Index = 0; Index < Key1.Length; ++Index) {
+    if (Key1.String[Index] != Key2.String[Index]) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+// InternCaseHash
+/// Hash the upper case characters of a string
+/// @param Key The characters of the string
+/// @return The hash of the upper case characters
+STATIC
+UINT64
+EFIAPI
+InternCaseHash (
+  IN INTERN_KEY Key
+) {
+  return StrniHash64(Key.String, Key.Length, 0);
+}
+// InternCaseEqual
+/// Check if the characters of two strings are equal ignoring case
+/// @param Key1 The characters of the first string
+/// @param Key2 The characters of the second string
+/// @return Whether the upper case characters are equal or not
+STATIC
+BOOLEAN
+EFIAPI
+InternCaseEqual (
+  IN INTERN_KEY Key1,
+  IN INTERN_KEY Key2
+) {
+  UINTN Index;
+  if (Key1.Length != Key2.Length) {
+    return FALSE;
+  }
+  for (Index = 0; Index < Key1.Length; ++Index) {
+    if ((Key1.String[Index] != Key2.String[Index]) && (CharToUpper(Key1.String[Index]) != CharToUpper(Key2.String[Index]))) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+// INTERN_TABLE
+/// The case sensitive intern table of interned strings keyed by their characters
+EFI_HASH_MAP_DECLARE(INTERN_TABLE, InternTable, INTERN_KEY, CONST CHAR16 *);
+EFI_HASH_MAP_DEFINE(INTERN_TABLE, InternTable, INTERN_KEY, CONST CHAR16 *, InternHash, InternEqual)
+// INTERN_CASE_TABLE
+/// The case insensitive intern table of interned strings keyed by their characters
+EFI_HASH_MAP_DECLARE(INTERN_CASE_TABLE, InternCaseTable, INTERN_KEY, CONST CHAR16 *);
+EFI_HASH_MAP_DEFINE(INTERN_CASE_TABLE, InternCaseTable, INTERN_KEY, CONST CHAR16 *, InternCaseHash, InternCaseEqual)
+
+// mInternLock
+/// The intern tables lock
+STATIC EFI_LOCK          mInternLock = (EFI_LOCK)EFI_LOCK_RELEASED;
+// mInternArena
+/// The arena that stores the interned strings of both tables
+STATIC EFI_STRING_ARENA *mInternArena = NULL;
+// mInternTable
+/// The case sensitive intern table
+STATIC INTERN_TABLE      mInternTable = { NULL, 0, 0 };
+// mInternCaseTable
+/// The case insensitive intern table
+STATIC INTERN_CASE_TABLE mInternCaseTable = { NULL, 0, 0 };
+
+// StrIntern
+/// Intern a string so that equal strings have the same stable pointer and compare with pointer equality
+/// @param Str   The string to intern
+/// @param Flags The interning flags
+/// @return The interned string, which must not be modified or freed, or NULL if Str is NULL, memory could not be allocated, or STR_INTERN_FIND_ONLY was used and the string was not interned
+CONST CHAR16 *
+EFIAPI
+StrIntern (
+  IN CONST CHAR16 *Str,
+  IN UINTN         Flags
+) {
+  return StrnIntern(Str, MAX_UINTN, Flags);
+}
+// StrnIntern
+/// Intern at most a count of characters of a string so that equal strings have the same stable pointer and compare with pointer equality
+/// @param Str    The string to intern
+/// @param Length The maximum count of characters to intern, the string is interned up to the null terminator if it is shorter
+/// @param Flags  The interning flags
+/// @return The null terminated interned string, which must not be modified or freed, or NULL if Str is NULL, memory could not be allocated, or STR_INTERN_FIND_ONLY was used and the string was not interned
+CONST CHAR16 *
+EFIAPI
+StrnIntern (
+  IN CONST CHAR16 *Str,
+  IN UINTN         Length,
+  IN UINTN         Flags
+) {
+  BOOLEAN        CaseInsensitive;
+  INTERN_KEY     Key;
+  CONST CHAR16 **Value;
+  CHAR16        *String;
+  EFI_STATUS     Status;
+  UINTN          Count;
+  // Check parameters
+  if (Str == NULL) {
+    return NULL;
+  }
+  // Get the count of characters outside the lock
+  for (Count = 0; (Count < Length) && (Str[Count] != 0); ++Count);
+  CaseInsensitive = EFI_BITS_ANY_SET(Flags, STR_INTERN_CASE_INSENSITIVE);
+  Key.String = Str;
+  Key.Length = Count;
+  EfiLock(&mInternLock);
+  // Find the string if already interned
+  Value = CaseInsensitive ? InternCaseTableFind(&mInternCaseTable, Key) : InternTableFind(&mInternTable, Key);
+  if ((Value != NULL) || EFI_BITS_ANY_SET(Flags, STR_INTERN_FIND_ONLY)) {
+    EfiUnlock(&mInternLock);
+    return (Value != NULL) ? *Value : NULL;
+  }
+  // Copy the string into the arena so the table key refers to the interned string
+  if ((mInternArena == NULL) && EFI_ERROR(EfiStringArenaCreate(&mInternArena, INTERN_ARENA_CHUNK_SIZE))) {
+    EfiUnlock(&mInternLock);
+    return NULL;
+  }
+  String = (CHAR16 *)EfiStringArenaAllocate(mInternArena, (Count + 1) * sizeof(CHAR16));
+  if (String == NULL) {
+    EfiUnlock(&mInternLock);
+    return NULL;
+  }
+  EfiCopyArray(CHAR16, String, Str, Count);
+  String[Count] = 0;
+  // Add the string to the table
+  Key.String = String;
+  if (CaseInsensitive) {
+    Status = InternCaseTableInsert(&mInternCaseTable, Key, &Value);
+  } else {
+    Status = InternTableInsert(&mInternTable, Key, &Value);
+  }
+  if (EFI_ERROR(Status)) {
+    // The arena copy is only reclaimed when every interned string is freed
+    EfiUnlock(&mInternLock);
+    return NULL;
+  }
+  *Value = String;
+  EfiUnlock(&mInternLock);
+  return String;
+}
+
+// EfiInternFree
+/// Free every interned string, any interned string pointer is invalid afterwards
+/// @return Whether the interned strings were freed or not
+/// @retval EFI_SUCCESS If the interned strings were freed
+EFI_STATUS
+EFIAPI
+EfiInternFree (
+  VOID
+) {
+  EfiLock(&mInternLock);
+  InternTableFree(&mInternTable);
+  InternCaseTableFree(&mInternCaseTable);
+  if (mInternArena != NULL) {
+    EfiStringArenaFree(mInternArena);
+    mInternArena = NULL;
+  }
+  EfiUnlock(&mInternLock);
+  return EFI_SUCCESS;
+}
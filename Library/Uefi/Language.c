@@ -10,6 +10,19 @@
 /// The default language
 #define DEFAULT_LANGUAGE "en"
 
+// mLanguageCollation
+/// The cached collation protocol for the current language
+STATIC EFI_UNICODE_COLLATION_PROTOCOL *mLanguageCollation = NULL;
+// mLanguageCollationResolved
+/// Whether the cached collation protocol for the current language is valid
+STATIC BOOLEAN mLanguageCollationResolved = FALSE;
+// mLanguageCollationEvent
+/// The event signaled when a collation protocol is installed
+STATIC EFI_EVENT mLanguageCollationEvent = NULL;
+// mLanguageCollationRegistration
+/// The collation protocol notify registrations
+STATIC VOID *mLanguageCollationRegistration[2] = { NULL, NULL };
+
 // EfiGetBestLanguage
 /// Select the best matching language from a set of supported languages
 /// @param SupportedLanguages A null-terminated string that contains a set of language codes in the format specified by Iso639Language
@@ -191,6 +204,8 @@ EfiSetLanguage (
   // Set platform language
   Status = EfiSetVariable(L"PlatformLang", &gEfiGlobalVariableGuid, Options, AsciiStrSize(LanguageCode), (VOID *)LanguageCode);
   EfiFreePool(LanguageCode);
+  // The current language collation protocol must be located again
+  mLanguageCollationResolved = FALSE;
   return Status;
 }
 // EfiGetLanguage
@@ -258,13 +273,29 @@ EfiGetLanguages (
   return Status;
 }
 
-// EfiGetLanguageCollationProtocol
-/// Get a collation protocol by language
+// LanguageCollationNotify
+/// Invalidate the cached current language collation protocol when a collation protocol is installed
+/// @param Event   The collation protocol notify event
+/// @param Context Not used
+STATIC
+VOID
+EFIAPI
+LanguageCollationNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  UNUSED_PARAMETER(Event);
+  UNUSED_PARAMETER(Context);
+  mLanguageCollationResolved = FALSE;
+}
+// LanguageLocateCollationProtocol
+/// Locate a collation protocol by language
 /// @param Language The language of the collation protocol or NULL for the current language collation prtocol
 /// @return The collation protocol for the specified language or NULL if not found
+STATIC
 EFI_UNICODE_COLLATION_PROTOCOL *
 EFIAPI
-EfiGetLanguageCollationProtocol (
+LanguageLocateCollationProtocol (
   IN CONST CHAR8 *Language OPTIONAL
 ) {
   EFI_STATUS                      Status;
@@ -330,3 +361,37 @@ EfiGetLanguageCollationProtocol (
   EfiFreePool(LanguageRequest);
   return NULL;
 }
+// EfiGetLanguageCollationProtocol
+/// Get a collation protocol by language, the current language collation protocol is cached until the language is
+///  changed with EfiSetLanguage or a collation protocol is installed
+/// @param Language The language of the collation protocol or NULL for the current language collation prtocol
+/// @return The collation protocol for the specified language or NULL if not found
+EFI_UNICODE_COLLATION_PROTOCOL *
+EFIAPI
+EfiGetLanguageCollationProtocol (
+  IN CONST CHAR8 *Language OPTIONAL
+) {
+  // A specific language is always located
+  if ((Language != NULL) && (*Language != '\0')) {
+    return LanguageLocateCollationProtocol(Language);
+  }
+  // Watch for collation protocols being installed so the cache can be invalidated
+  if ((mLanguageCollationEvent == NULL) &&
+      !EFI_ERROR(EfiCreateEvent(EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LanguageCollationNotify, NULL, &mLanguageCollationEvent))) {
+    if (EFI_ERROR(EfiRegisterProtocolNotify(&gEfiUnicodeCollation2ProtocolGuid, mLanguageCollationEvent, mLanguageCollationRegistration)) ||
+        EFI_ERROR(EfiRegisterProtocolNotify(&gEfiUnicodeCollationProtocolGuid, mLanguageCollationEvent, mLanguageCollationRegistration + 1))) {
+      // Without notification the cache could become stale so it is never used
+      EfiCloseEvent(mLanguageCollationEvent);
+      mLanguageCollationEvent = NULL;
+    }
+  }
+  if (mLanguageCollationEvent == NULL) {
+    return LanguageLocateCollationProtocol(NULL);
+  }
+  // Locate the current language collation protocol once
+  if (!mLanguageCollationResolved) {
+    mLanguageCollation = LanguageLocateCollationProtocol(NULL);
+    mLanguageCollationResolved = TRUE;
+  }
+  return mLanguageCollation;
+}
@@ -4,7 +4,9 @@
 /// Locale protocol
 ///
 
-#include <Uefi.h>
+#include "VirtualMemory.h"
+
+#include <Uefi/Protocol/MpService.h>
 
 // TODO: Write documentation for these flags
 #define INTERNAL_PRINT_FLAG_WIDTH_AS_ARG EFI_BIT(0)
@@ -31,6 +33,140 @@
 #define INTERNAL_PRINT_FLAG_GUID EFI_BIT(21)
 #define INTERNAL_PRINT_FLAG_TIME EFI_BIT(22)
 #define INTERNAL_PRINT_FLAG_DATE EFI_BIT(23)
+#define INTERNAL_PRINT_FLAG_DEFAULT_WIDTH EFI_BIT(24)
+#define INTERNAL_PRINT_FLAG_SHORTEST EFI_BIT(25)
+
+// INTERNAL_PRINT_OP_LITERAL
+/// A span of literal characters from the format specifier string
+#define INTERNAL_PRINT_OP_LITERAL 0
+// INTERNAL_PRINT_OP_LINE
+/// A line ending that is translated to CR+LF
+#define INTERNAL_PRINT_OP_LINE 1
+// INTERNAL_PRINT_OP_ARGUMENT
+/// An argument conversion specifier
+#define INTERNAL_PRINT_OP_ARGUMENT 2
+
+// INTERNAL_PRINT_CHUNK_COUNT
+/// The count of operations compiled at a time for a format specifier string that is not cached
+#define INTERNAL_PRINT_CHUNK_COUNT 16
+// INTERNAL_PRINT_CACHE_CAPACITY
+/// The maximum count of compiled format specifier strings that are cached
+#define INTERNAL_PRINT_CACHE_CAPACITY 512
+// INTERNAL_PRINT_CACHE_SLOTS
+/// The count of slots of the compiled format specifier string cache, must be a power of two larger than the capacity
+#define INTERNAL_PRINT_CACHE_SLOTS 1024
+// INTERNAL_IMAGE_SECTION_COUNT
+/// The maximum count of read only image sections that contain cached format specifier strings
+#define INTERNAL_IMAGE_SECTION_COUNT 4
+// INTERNAL_IMAGE_SECTION_READ
+/// The image section characteristics flag for a readable section
+#define INTERNAL_IMAGE_SECTION_READ 0x40000000
+// INTERNAL_IMAGE_SECTION_WRITE
+/// The image section characteristics flag for a writable section
+#define INTERNAL_IMAGE_SECTION_WRITE 0x80000000
+
+// EFI_LOCALE_PRINT_OP
+/// A compiled format specifier string operation
+typedef struct EFI_LOCALE_PRINT_OP EFI_LOCALE_PRINT_OP;
+struct EFI_LOCALE_PRINT_OP {
+
+  // Type
+  /// The type of operation
+  UINT32      Type;
+  // Character
+  /// The argument type character
+  UINT32      Character;
+  // Flags
+  /// The argument print flags
+  UINTN       Flags;
+  // Width
+  /// The argument width if not an argument itself
+  UINTN       Width;
+  // Precision
+  /// The argument precision if not an argument itself
+  UINTN       Precision;
+  // Literal
+  /// The literal characters encoded in the format specifier string encoding
+  CONST VOID *Literal;
+  // LiteralSize
+  /// The size in bytes of the literal characters
+  UINTN       LiteralSize;
+
+};
+
+// EFI_LOCALE_PRINT_FORMAT
+/// A cached compiled format specifier string
+typedef struct EFI_LOCALE_PRINT_FORMAT EFI_LOCALE_PRINT_FORMAT;
+struct EFI_LOCALE_PRINT_FORMAT {
+
+  // Format
+  /// The format specifier string
+  CONST VOID            *Format;
+  // FormatEncoding
+  /// The encoding of the format specifier string
+  EFI_ENCODING_PROTOCOL *FormatEncoding;
+  // FormatSize
+  /// The size in bytes of the format specifier string
+  UINTN                  FormatSize;
+  // Count
+  /// The count of compiled operations
+  UINTN                  Count;
+  // Ops
+  /// The compiled operations
+  EFI_LOCALE_PRINT_OP   *Ops;
+
+};
+
+// EFI_LOCALE_PRINT_OUTPUT
+/// The output of a formatted character string
+typedef struct EFI_LOCALE_PRINT_OUTPUT EFI_LOCALE_PRINT_OUTPUT;
+struct EFI_LOCALE_PRINT_OUTPUT {
+
+  // Encoding
+  /// The encoding of the formatted character string
+  EFI_ENCODING_PROTOCOL *Encoding;
+  // Buffer
+  /// The current position in the formatted character string buffer or NULL
+  VOID                  *Buffer;
+  // Remaining
+  /// The remaining size in bytes of the formatted character string buffer
+  UINTN                  Remaining;
+  // Size
+  /// The size in bytes of the formatted character string so far
+  UINTN                  Size;
+
+};
+
+// mLocalePrintLock
+/// The lock of the compiled format specifier string cache
+STATIC EFI_LOCK                  mLocalePrintLock = (EFI_LOCK)EFI_LOCK_RELEASED;
+// mLocalePrintCache
+/// The slots of the compiled format specifier string cache keyed by format specifier string
+STATIC EFI_LOCALE_PRINT_FORMAT **mLocalePrintCache = NULL;
+// mLocalePrintCacheCount
+/// The count of compiled format specifier strings in the cache
+STATIC UINTN                     mLocalePrintCacheCount = 0;
+// mLocalePrintCompile
+/// Whether format specifier strings may be compiled to cache, which allocates so only before exiting boot services
+STATIC BOOLEAN                   mLocalePrintCompile = FALSE;
+// mLocalePrintMpServices
+/// The multiprocessor services protocol to identify the boot strap processor, the only processor that may compile to cache, or NULL if there are no application processors
+STATIC EFI_MP_SERVICES_PROTOCOL *mLocalePrintMpServices = NULL;
+// mLocalePrintBsp
+/// The number of the boot strap processor
+STATIC UINTN                     mLocalePrintBsp = 0;
+// mLocaleImageSections
+/// The start and end addresses of the read only sections of the loaded image, only constant format specifier strings inside these sections are cached
+STATIC UINTN                     mLocaleImageSections[INTERNAL_IMAGE_SECTION_COUNT][2] = { { 0 } };
+// mLocaleImageSectionCount
+/// The count of read only sections of the loaded image
+STATIC UINTN                     mLocaleImageSectionCount = 0;
+// mLocaleCurrent
+/// The current locale protocol interface so the platform locale variable is not read for each conversion
+STATIC EFI_LOCALE_PROTOCOL      *mLocaleCurrent = NULL;
+// mLocaleDefault
+/// The default locale protocol interface, conversions with the default locale are parsed directly
+STATIC EFI_LOCALE_PROTOCOL      *mLocaleDefault = NULL;
 
 // EfiLocaleProtocolGuid
 /// The locale protocol unique identifier
@@ -41,17 +177,1215 @@ EFI_GUID gEfiLocaleProtocolGuid = EFI_LOCALE_PROTOCOL_GUID;
 EXTERN
 EFI_STATUS
 EFIAPI
-DefaultLocaleInstall (
+DefaultLocaleInstall (
+  VOID
+);
+// DefaultLocaleUninstall
+/// Uninstall default locale protocol
+EXTERN
+EFI_STATUS
+EFIAPI
+DefaultLocaleUninstall (
+  VOID
+);
+// DefaultLocaleParseUnitSize
+/// Get the size of a character unit if an encoding stores the ASCII characters in a single unit so they can be parsed directly
+EXTERN
+UINTN
+EFIAPI
+DefaultLocaleParseUnitSize (
+  IN EFI_ENCODING_PROTOCOL *Encoding
+);
+// DefaultLocaleParseUnsigned
+/// Convert an unsigned integer formatted character string buffer to an unsigned integer without decoding each character
+EXTERN
+EFI_STATUS
+EFIAPI
+DefaultLocaleParseUnsigned (
+  IN     UINTN    UnitSize,
+  IN OUT VOID   **Buffer,
+  IN OUT UINTN   *Size OPTIONAL,
+  OUT    UINT64  *Unsigned,
+  IN     UINTN    Base
+);
+// DefaultLocaleParseInteger
+/// Convert a signed integer formatted character string buffer to a signed integer without decoding each character
+EXTERN
+EFI_STATUS
+EFIAPI
+DefaultLocaleParseInteger (
+  IN     UINTN    UnitSize,
+  IN OUT VOID   **Buffer,
+  IN OUT UINTN   *Size OPTIONAL,
+  OUT    INT64   *Integer,
+  IN     UINTN    Base
+);
+// DefaultLocaleParseFloat
+/// Convert a floating point formatted character string buffer to a floating point without decoding each character
+EXTERN
+EFI_STATUS
+EFIAPI
+DefaultLocaleParseFloat (
+  IN     UINTN     UnitSize,
+  IN OUT VOID    **Buffer,
+  IN OUT UINTN    *Size OPTIONAL,
+  OUT    FLOAT64  *Float
+);
+// DefaultLocaleParseDateTime
+/// Convert an ISO 8601 date and/or time formatted character string buffer to a date and time without decoding each character
+EXTERN
+EFI_STATUS
+EFIAPI
+DefaultLocaleParseDateTime (
+  IN     UINTN      UnitSize,
+  IN OUT VOID     **Buffer,
+  IN OUT UINTN     *Size OPTIONAL,
+  IN OUT EFI_TIME  *DateTime
+);
+
+// LocaleFinishLiteral
+/// Finish a literal span print operation
+/// @param Ops         The compiled print operations or NULL if only counting
+/// @param Index       The index of the literal span print operation
+/// @param Literal     The literal characters or NULL if there is no literal span
+/// @param LiteralSize The size in bytes of the literal characters
+STATIC
+VOID
+EFIAPI
+LocaleFinishLiteral (
+  OUT EFI_LOCALE_PRINT_OP *Ops OPTIONAL,
+  IN  UINTN                Index,
+  IN  CONST VOID          *Literal OPTIONAL,
+  IN  UINTN                LiteralSize
+) {
+  if ((Ops == NULL) || (Literal == NULL)) {
+    return;
+  }
+  Ops[Index].Type = INTERNAL_PRINT_OP_LITERAL;
+  Ops[Index].Character = 0;
+  Ops[Index].Flags = 0;
+  Ops[Index].Width = 0;
+  Ops[Index].Precision = 0;
+  Ops[Index].Literal = Literal;
+  Ops[Index].LiteralSize = LiteralSize;
+}
+// LocaleCompileFormat
+/// Compile a format specifier string into print operations
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         On input, the format specifier string, on output, the remaining format specifier string that was not compiled
+/// @param FormatSize     On input, the size in bytes of the format specifier string, on output, the size in bytes of the remaining format specifier string or zero if it was entirely compiled
+/// @param Ops            On output, the compiled print operations or NULL to only count the print operations
+/// @param Count          On input, the maximum count of print operations, on output, the count of compiled print operations
+/// @retval EFI_SUCCESS The format specifier string was compiled
+STATIC
+EFI_STATUS
+EFIAPI
+LocaleCompileFormat (
+  IN     EFI_ENCODING_PROTOCOL  *FormatEncoding,
+  IN OUT CONST VOID            **Format,
+  IN OUT UINTN                  *FormatSize,
+  OUT    EFI_LOCALE_PRINT_OP    *Ops OPTIONAL,
+  IN OUT UINTN                  *Count
+) {
+  EFI_STATUS  Status;
+  CONST VOID *Current = *Format;
+  CONST VOID *Literal = NULL;
+  UINTN       Remaining = *FormatSize;
+  UINTN       LiteralSize = 0;
+  UINTN       LiteralIndex = 0;
+  UINTN       Index = 0;
+  UINTN       ThisSize;
+  // Parse the format buffer
+  while (Remaining >= FormatEncoding->UnitSize) {
+    CONST VOID *Start = Current;
+    UINTN       StartSize = Remaining;
+    UINTN       Precision = 0;
+    UINTN       Width = 0;
+    UINTN       Flags = 0;
+    UINT32      Type = INTERNAL_PRINT_OP_LITERAL;
+    UINT32      Character = 0;
+    // Decode the next character from the format buffer
+    ThisSize = Remaining;
+    Status = EfiDecodeCharacter(FormatEncoding, Current, &ThisSize, &Character);
+    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      return Status;
+    }
+    // Check to make sure that this is not a null terminator character
+    if (Character == 0) {
+      Remaining = 0;
+      break;
+    }
+    // Advance the format buffer
+    Remaining -= ThisSize;
+    Current = ADDRESS_OFFSET(CONST VOID, Current, ThisSize);
+    if (Character == '\r') {
+      // Translate CR to CR+LF and CR+LF stays the same, unless the CR is the last character
+      ThisSize = Remaining;
+      Character = 0;
+      if (Remaining >= FormatEncoding->UnitSize) {
+        Status = EfiDecodeCharacter(FormatEncoding, Current, &ThisSize, &Character);
+        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+          return Status;
+        }
+      }
+      if (Character == '\n') {
+        Remaining -= ThisSize;
+        Current = ADDRESS_OFFSET(CONST VOID, Current, ThisSize);
+      }
+      if (Character != 0) {
+        Type = INTERNAL_PRINT_OP_LINE;
+      }
+    } else if (Character == '\n') {
+      // Translate LF to CR+LF
+      Type = INTERNAL_PRINT_OP_LINE;
+    } else if (Character == '%') {
+      // Parse the argument conversion specifier
+      Type = INTERNAL_PRINT_OP_ARGUMENT;
+      Character = 0;
+      while ((Character == 0) && (Remaining >= FormatEncoding->UnitSize)) {
+        ThisSize = Remaining;
+        Status = EfiDecodeCharacter(FormatEncoding, Current, &ThisSize, &Character);
+        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+          return Status;
+        }
+        // The format specifier string ended before the argument type
+        if (Character == 0) {
+          break;
+        }
+        Remaining -= ThisSize;
+        Current = ADDRESS_OFFSET(CONST VOID, Current, ThisSize);
+        switch (Character) {
+
+          default:
+            // Unknown character for argument so skip and return to normal processing
+            Type = INTERNAL_PRINT_OP_LITERAL;
+            break;
+
+          //
+          // Argument flags
+          //
+
+          case '-':
+            // Left justify instead of right justify
+            Flags |= INTERNAL_PRINT_FLAG_LEFT_JUSTIFY;
+            Character = 0;
+            continue;
+
+          case ' ':
+          case '\t':
+          case '\r':
+          case '\n':
+            // Skip any whitespace
+            Character = 0;
+            continue;
+
+          case '+':
+            // Prefix integer sign (+ or -)
+            Flags |= INTERNAL_PRINT_FLAG_PREFIX_SIGN;
+            Character = 0;
+            continue;
+
+          case ',':
+            // Separate integer digits into groups of three
+            Flags |= INTERNAL_PRINT_FLAG_SEPARATOR;
+            Character = 0;
+            continue;
+
+          case '#':
+            // Print the fewest floating point digits that convert back to the same value
+            Flags |= INTERNAL_PRINT_FLAG_SHORTEST;
+            Character = 0;
+            continue;
+
+          case 'L':
+          case 'l':
+            // Force long integer instead of normal integer
+            Flags |= INTERNAL_PRINT_FLAG_LONG;
+            Character = 0;
+            continue;
+
+          case '0':
+            // If no width or precision yet, then prefix zeroes
+            if ((Width == 0) && EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+              // Pad with zeroes instead of spaces
+              Flags |= INTERNAL_PRINT_FLAG_PAD_ZEROES;
+            } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+              // Precision
+              Precision *= 10;
+            } else {
+              // Width
+              Width *= 10;
+            }
+            Character = 0;
+            continue;
+
+          //
+          // Width and precision
+          //
+
+          case '1':
+          case '2':
+          case '3':
+          case '4':
+          case '5':
+          case '6':
+          case '7':
+          case '8':
+          case '9':
+            // Width or precision
+            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+              // Precision
+              Precision *= 10;
+              Precision += (Character - '0');
+            } else {
+              // Width
+              Width *= 10;
+              Width += (Character - '0');
+            }
+            Character = 0;
+            continue;
+
+          case '*':
+            // The width and/or precision are the arguments before this argument
+            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+              Flags |= INTERNAL_PRINT_FLAG_PRECISION_AS_ARG;
+            } else {
+              Flags |= INTERNAL_PRINT_FLAG_WIDTH_AS_ARG;
+            }
+            Character = 0;
+            continue;
+
+          case '.':
+            // Switch from width field parsing to precision field parsing
+            Flags |= INTERNAL_PRINT_FLAG_PRECISION;
+            Character = 0;
+            continue;
+
+          //
+          // Argument type
+          //
+
+          case '%':
+            // Percent sign
+          case 'c':
+          case 'C':
+            // Unicode character
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
+            Flags |= INTERNAL_PRINT_FLAG_CHAR;
+            break;
+
+          case 'p':
+            // Lowercase pointer argument
+            Flags |= INTERNAL_PRINT_FLAG_PREFIX_HEXADECIMAL;
+
+          case 'h':
+            // Lowercase hexadecimal with default integer width
+            Flags |= (INTERNAL_PRINT_FLAG_DEFAULT_WIDTH | INTERNAL_PRINT_FLAG_PAD_ZEROES);
+
+          case 'x':
+            // Lowercase hexadecimal
+            Flags &= ~INTERNAL_PRINT_FLAG_PREFIX_SIGN;
+            Flags |= INTERNAL_PRINT_FLAG_HEXADECIMAL;
+            break;
+
+          case 'P':
+            // Uppercase pointer argument
+            Flags |= INTERNAL_PRINT_FLAG_PREFIX_HEXADECIMAL;
+
+          case 'H':
+            // Uppercase hexadecimal with default integer width
+            Flags |= (INTERNAL_PRINT_FLAG_DEFAULT_WIDTH | INTERNAL_PRINT_FLAG_PAD_ZEROES);
+
+          case 'X':
+            // Uppercase hexadecimal
+            Flags &= ~INTERNAL_PRINT_FLAG_PREFIX_SIGN;
+            Flags |= (INTERNAL_PRINT_FLAG_UPPERCASE | INTERNAL_PRINT_FLAG_HEXADECIMAL);
+            break;
+
+          case 'O':
+            // Octal integer argument with prefix
+            Flags |= INTERNAL_PRINT_FLAG_PREFIX_OCTAL;
+
+          case 'o':
+            // Octal integer argument
+            Flags |= INTERNAL_PRINT_FLAG_OCTAL;
+            break;
+
+          case 'B':
+            // Binary integer argument with prefix
+            Flags |= INTERNAL_PRINT_FLAG_PREFIX_BINARY;
+
+          case 'b':
+            // Binary integer argument
+            Flags |= INTERNAL_PRINT_FLAG_BINARY;
+            break;
+
+          case 'd':
+          case 'i':
+            // Signed decimal integer argument
+            Flags |= INTERNAL_PRINT_FLAG_SIGNED;
+            break;
+
+          case 'u':
+            // Unsigned decimal integer argument
+            break;
+
+          case 'F':
+            // Uppercase floating point
+            Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
+
+          case 'f':
+            // Floating point
+            Flags |= INTERNAL_PRINT_FLAG_FLOAT;
+            break;
+
+          case 'E':
+            // Uppercase scientific floating point
+            Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
+
+          case 'e':
+            // Scientific floating point
+            Flags |= INTERNAL_PRINT_FLAG_SCIENTIFIC;
+            break;
+
+          case 'm':
+            // Monetary floating point
+            Flags |= INTERNAL_PRINT_FLAG_MONETARY;
+            break;
+
+          case 'a':
+            // Latin-1 string argument
+          case 'A':
+            // UTF-8 string argument
+          case 's':
+            // Unicode string argument
+          case 'S':
+            // Encoding argument and encoded string argument
+          case 'r':
+            // Status code argument
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
+            Flags |= INTERNAL_PRINT_FLAG_BUFFER;
+            break;
+
+          case 'G':
+            // Uppercase GUID argument
+            Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
+
+          case 'g':
+            // GUID argument
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
+            Flags |= INTERNAL_PRINT_FLAG_GUID;
+            break;
+
+          case 't':
+            // Time argument
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
+            Flags |= INTERNAL_PRINT_FLAG_TIME;
+            break;
+
+          case 'D':
+            // Date argument
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
+            Flags |= INTERNAL_PRINT_FLAG_DATE;
+            break;
+
+          case 'T':
+            // Date and time argument
+            Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
+            Flags |= (INTERNAL_PRINT_FLAG_DATE | INTERNAL_PRINT_FLAG_TIME);
+            break;
+
+        }
+      }
+      // Nothing is printed for an unknown or incomplete argument but the literal span still ends
+      if ((Type != INTERNAL_PRINT_OP_ARGUMENT) || (Character == 0)) {
+        LocaleFinishLiteral(Ops, LiteralIndex, Literal, LiteralSize);
+        Literal = NULL;
+        continue;
+      }
+    }
+    if ((Type == INTERNAL_PRINT_OP_LITERAL) && (Literal != NULL)) {
+      // Extend the literal span
+      LiteralSize += (StartSize - Remaining);
+      continue;
+    }
+    // Finish the literal span before any other operation
+    LocaleFinishLiteral(Ops, LiteralIndex, Literal, LiteralSize);
+    Literal = NULL;
+    // Stop before this operation if there are no more operations remaining
+    if (Index >= *Count) {
+      Current = Start;
+      Remaining = StartSize;
+      break;
+    }
+    if (Type == INTERNAL_PRINT_OP_LITERAL) {
+      // Start a literal span
+      Literal = Start;
+      LiteralSize = (StartSize - Remaining);
+      LiteralIndex = Index;
+    } else if (Ops != NULL) {
+      // Add a line or argument operation
+      Ops[Index].Type = Type;
+      Ops[Index].Character = Character;
+      Ops[Index].Flags = Flags;
+      Ops[Index].Width = Width;
+      Ops[Index].Precision = Precision;
+      Ops[Index].Literal = NULL;
+      Ops[Index].LiteralSize = 0;
+    }
+    ++Index;
+  }
+  // Finish the last literal span
+  LocaleFinishLiteral(Ops, LiteralIndex, Literal, LiteralSize);
+  // Return the remaining format buffer and the count of operations
+  *Format = Current;
+  *FormatSize = (Remaining >= FormatEncoding->UnitSize) ? Remaining : 0;
+  *Count = Index;
+  return EFI_SUCCESS;
+}
+// LocalePrintAvailable
+/// Get the size in bytes available to print into the formatted character string buffer
+/// @param Output The formatted character string output
+/// @return The size in bytes available to print into the formatted character string buffer
+STATIC
+UINTN
+EFIAPI
+LocalePrintAvailable (
+  IN EFI_LOCALE_PRINT_OUTPUT *Output
+) {
+  return (Output->Remaining > Output->Encoding->UnitSize) ? Output->Remaining : 0;
+}
+// LocalePrintAdvance
+/// Advance the formatted character string output
+/// @param Output   The formatted character string output
+/// @param ThisSize The size in bytes that was printed or is required to print
+STATIC
+VOID
+EFIAPI
+LocalePrintAdvance (
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     UINTN                    ThisSize
+) {
+  // Decrease remaining size
+  if (Output->Remaining > ThisSize) {
+    Output->Remaining -= ThisSize;
+  } else {
+    Output->Remaining = 0;
+  }
+  // Increase the buffer size
+  Output->Size += ThisSize;
+  // Advance the buffer
+  if (Output->Buffer != NULL) {
+    Output->Buffer = ADDRESS_OFFSET(VOID, Output->Buffer, ThisSize);
+  }
+}
+// LocalePrintCharacter
+/// Print a character to the formatted character string output
+/// @param Output    The formatted character string output
+/// @param Character The character to print
+/// @retval EFI_SUCCESS The character was printed or the size required was added
+STATIC
+EFI_STATUS
+EFIAPI
+LocalePrintCharacter (
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     UINT32                   Character
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize = LocalePrintAvailable(Output);
+  Status = EfiEncodeCharacter(Output->Encoding, Output->Buffer, &ThisSize, Character);
+  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+    return Status;
+  }
+  LocalePrintAdvance(Output, ThisSize);
+  return EFI_SUCCESS;
+}
+// LocalePrintFill
+/// Print padding characters to the formatted character string output
+/// @param Output    The formatted character string output
+/// @param Count     The count of padding characters
+/// @param Character The padding character
+/// @retval EFI_SUCCESS The padding characters were printed or the size required was added
+STATIC
+EFI_STATUS
+EFIAPI
+LocalePrintFill (
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     UINTN                    Count,
+  IN     UINT32                   Character
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize = LocalePrintAvailable(Output);
+  Status = EfiFillCharacter(Output->Encoding, Output->Buffer, &ThisSize, Count, Character);
+  if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+    return Status;
+  }
+  LocalePrintAdvance(Output, ThisSize);
+  return EFI_SUCCESS;
+}
+// LocalePrintLiteral
+/// Print literal characters from the format specifier string to the formatted character string output
+/// @param Output         The formatted character string output
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Literal        The literal characters
+/// @param LiteralSize    The size in bytes of the literal characters
+/// @retval EFI_SUCCESS The literal characters were printed or the size required was added
+STATIC
+EFI_STATUS
+EFIAPI
+LocalePrintLiteral (
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     EFI_ENCODING_PROTOCOL   *FormatEncoding,
+  IN     CONST VOID              *Literal,
+  IN     UINTN                    LiteralSize
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize;
+  UINT32     Character;
+  // Copy the literal characters as is when the encodings are the same
+  if (Output->Encoding == FormatEncoding) {
+    if ((Output->Buffer != NULL) && (LiteralSize <= LocalePrintAvailable(Output))) {
+      EfiCopyMem(Output->Buffer, (VOID *)Literal, LiteralSize);
+    }
+    LocalePrintAdvance(Output, LiteralSize);
+    return EFI_SUCCESS;
+  }
+  // Otherwise convert each character
+  while (LiteralSize >= FormatEncoding->UnitSize) {
+    ThisSize = LiteralSize;
+    Character = 0;
+    Status = EfiDecodeCharacter(FormatEncoding, Literal, &ThisSize, &Character);
+    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      return Status;
+    }
+    if ((Character == 0) || (ThisSize == 0)) {
+      break;
+    }
+    LiteralSize -= ThisSize;
+    Literal = ADDRESS_OFFSET(CONST VOID, Literal, ThisSize);
+    Status = LocalePrintCharacter(Output, Character);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// LocalePrintArgument
+/// Print an argument to the formatted character string output
+/// @param Locale The locale to use in formatting
+/// @param Output The formatted character string output
+/// @param Op     The argument print operation
+/// @param Marker The arguments to format, advanced past the argument on output
+/// @retval EFI_SUCCESS The argument was printed or the size required was added
+STATIC
+EFI_STATUS
+EFIAPI
+LocalePrintArgument (
+  IN     EFI_LOCALE_PROTOCOL     *Locale,
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     EFI_LOCALE_PRINT_OP     *Op,
+  IN OUT VA_LIST                 *Marker
+) {
+  EFI_ENCODING_PROTOCOL *Encoding = Output->Encoding;
+  EFI_ENCODING_PROTOCOL *ArgumentEncoding = NULL;
+  EFI_STATUS             Status = EFI_SUCCESS;
+  UINT64                 ArgumentValue = 0;
+  VOID                  *ArgumentBuffer = NULL;
+  UINTN                  ArgumentSize = 0;
+  UINTN                  Precision = Op->Precision;
+  UINTN                  Width = Op->Width;
+  UINTN                  Flags = Op->Flags;
+  UINTN                  ThisSize;
+  UINTN                  Padding = 0;
+  UINT32                 Character = Op->Character;
+  UINT32                 PadCharacter = EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PAD_ZEROES) ? '0' : ' ';
+  // The width and/or precision are the arguments before this argument
+  if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_WIDTH_AS_ARG)) {
+    Width = VA_ARG(*Marker, UINTN);
+  }
+  if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION_AS_ARG)) {
+    Precision = VA_ARG(*Marker, UINTN);
+  }
+  // Hexadecimal with default integer width
+  if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_DEFAULT_WIDTH) && (Width == 0)) {
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
+      Width = (sizeof(UINT64) << 1);
+    } else {
+      Width = (sizeof(UINTN) << 1);
+    }
+  }
+  // Get the argument
+  switch (Character) {
+
+    default:
+      // Percent sign
+      break;
+
+    case 'c':
+    case 'C':
+      // Unicode character
+      Character = VA_ARG(*Marker, UINT32);
+      break;
+
+    case 'p':
+    case 'h':
+    case 'x':
+    case 'P':
+    case 'H':
+    case 'X':
+    case 'O':
+    case 'o':
+    case 'B':
+    case 'b':
+    case 'u':
+      // Unsigned integer argument
+      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
+        ArgumentValue = VA_ARG(*Marker, UINT64);
+      } else {
+        ArgumentValue = (UINT64)VA_ARG(*Marker, UINTN);
+      }
+      break;
+
+    case 'd':
+    case 'i':
+      // Signed decimal integer argument
+      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
+        ArgumentValue = (UINT64)VA_ARG(*Marker, INT64);
+      } else {
+        ArgumentValue = (UINT64)(INT64)VA_ARG(*Marker, INTN);
+      }
+      break;
+
+    case 'F':
+    case 'f':
+    case 'E':
+    case 'e':
+    case 'm':
+      // Floating point argument
+      ArgumentBuffer = (VOID *)VA_ADDRESS(*Marker, FLOAT64);
+      break;
+
+    case 'a':
+      // Latin-1 string argument
+      ArgumentEncoding = EfiLatin1Encoding();
+      ArgumentBuffer = VA_ARG(*Marker, VOID *);
+      break;
+
+    case 'A':
+      // UTF-8 string argument
+      ArgumentEncoding = EfiUtf8Encoding();
+      ArgumentBuffer = VA_ARG(*Marker, VOID *);
+      break;
+
+    case 's':
+      // Unicode string argument
+      ArgumentEncoding = EfiUtf16Encoding();
+      ArgumentBuffer = VA_ARG(*Marker, VOID *);
+      break;
+
+    case 'S':
+      // Encoding argument and encoded string argument
+      ArgumentEncoding = VA_ARG(*Marker, EFI_ENCODING_PROTOCOL *);
+      ArgumentBuffer = VA_ARG(*Marker, VOID *);
+      break;
+
+    case 'r':
+      // Status code argument
+      ArgumentEncoding = EfiLatin1Encoding();
+      ArgumentBuffer = (VOID *)AsciiStrFromStatus(VA_ARG(*Marker, EFI_STATUS));
+      break;
+
+    case 'G':
+    case 'g':
+      // GUID argument
+      ArgumentBuffer = (VOID *)VA_ARG(*Marker, EFI_GUID *);
+      break;
+
+    case 't':
+    case 'D':
+    case 'T':
+      // Date and/or time argument
+      ArgumentBuffer = (VOID *)VA_ARG(*Marker, EFI_TIME *);
+      break;
+
+  }
+  // Print argument
+  if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_CHAR | INTERNAL_PRINT_FLAG_BUFFER | INTERNAL_PRINT_FLAG_GUID)) {
+    // Nothing is printed for an invalid string argument
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BUFFER) && EFI_ERROR(EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize))) {
+      return EFI_SUCCESS;
+    }
+    // Character or buffer argument
+    if (Width != 0) {
+      UINTN Length = 0;
+      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_GUID)) {
+        // The length of the GUID is 36 characters for 16 bytes of hexadecimal and four separators
+        Length = 36;
+      } else {
+        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BUFFER)) {
+          // Get the length of the argument buffer
+          Length = ArgumentSize;
+          Status = EfiEncodingStringLength(ArgumentEncoding, ArgumentBuffer, &Length);
+          if (EFI_ERROR(Status)) {
+            return Status;
+          }
+        } else {
+          // Just one character
+          Length = 1;
+        }
+        // Check the length is less than the precision
+        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION) && (Length > Precision)) {
+          Length = Precision;
+        }
+      }
+      // Get the padding size for the argument
+      if (Width > Length) {
+        Padding = Width - Length;
+      }
+    }
+    // Pad for right justification
+    if ((Padding != 0) && EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
+      Status = LocalePrintFill(Output, Padding, PadCharacter);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+    }
+    // Encode the argument into the output buffer
+    ThisSize = LocalePrintAvailable(Output);
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_CHAR)) {
+      // Character argument
+      if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) || (Precision != 0)) {
+        Status = EfiEncodeCharacter(Encoding, Output->Buffer, &ThisSize, Character);
+      } else {
+        ThisSize = 0;
+      }
+    } else {
+      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_GUID)) {
+        // GUID argument - precision does not apply to this argument type!
+        Status = EfiEncodingPrintGuid(Encoding, Output->Buffer, &ThisSize, (EFI_GUID *)ArgumentBuffer, EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_UPPERCASE));
+      } else if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+        // Convert the entire argument buffer into the output buffer
+        Status = EfiEncodingConvert(Encoding, Output->Buffer, &ThisSize, ArgumentEncoding, ArgumentBuffer, ArgumentSize);
+      } else if (Precision != 0) {
+        // Convert the argument buffer into the output buffer with a maximum count
+        Status = EfiEncodingConvertCount(Encoding, Output->Buffer, &ThisSize, ArgumentEncoding, ArgumentBuffer, ArgumentSize, Precision);
+      } else {
+        ThisSize = 0;
+      }
+      // Do not include the null terminator until the end of the output
+      if (ThisSize >= Encoding->UnitSize) {
+        ThisSize -= Encoding->UnitSize;
+      }
+    }
+    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      return Status;
+    }
+    LocalePrintAdvance(Output, ThisSize);
+    // Pad for left justification
+    if ((Padding != 0) && EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
+      return LocalePrintFill(Output, Padding, PadCharacter);
+    }
+  } else {
+    UINTN Base;
+    UINTN ArgumentFlags = 0;
+    // Determine the argument print flags
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_UPPERCASE)) {
+      ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_UPPERCASE;
+    }
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
+      ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_LEFT_JUSTIFY;
+    }
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PAD_ZEROES)) {
+      ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_PAD_ZEROES;
+    }
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PREFIX_SIGN)) {
+      ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_PREFIX_SIGN;
+    }
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SHORTEST)) {
+      ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_SHORTEST;
+    }
+    // Determine the base of the argument
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_HEXADECIMAL)) {
+      Base = 16;
+    } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_OCTAL)) {
+      Base = 8;
+    } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BINARY)) {
+      Base = 2;
+    } else {
+      Base = 10;
+    }
+    // Encode the argument into the output buffer
+    ThisSize = LocalePrintAvailable(Output);
+    if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_TIME | INTERNAL_PRINT_FLAG_DATE)) {
+      // Time and/or date argument
+      UINTN Type = EFI_LOCALE_PRINT_TIME | EFI_LOCALE_PRINT_DATE;
+      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_TIME)) {
+        if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_DATE)) {
+          Type = EFI_LOCALE_PRINT_TIME;
+        }
+      } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_DATE)) {
+        Type = EFI_LOCALE_PRINT_DATE;
+      }
+      Status = EfiLocalePrintDateTime(Locale, Encoding, Output->Buffer, &ThisSize, (EFI_TIME *)ArgumentBuffer, Type, Width, ArgumentFlags);
+    } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_FLOAT)) {
+      // Floating point argument
+      if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
+        Precision = EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SHORTEST) ? EFI_LOCALE_PRINT_FLOAT_SHORTEST_PRECISION : EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION;
+      }
+      Status = EfiLocalePrintFloat(Locale, Encoding, Output->Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, Precision, ArgumentFlags);
+    } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SCIENTIFIC)) {
+      // Floating point in scientific notation argument
+      Status = EfiLocalePrintScientific(Locale, Encoding, Output->Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) ? EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION : Precision, ArgumentFlags);
+    } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_MONETARY)) {
+      // Floating point in monetary notation argument
+      Status = EfiLocalePrintMonetary(Locale, Encoding, Output->Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) ? EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION : Precision, ArgumentFlags);
+    //} else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SIGNED)) {
+    //  // Signed integer argument
+    //  Status = EfiLocalePrintInteger(Locale, Encoding, Output->Buffer, &ThisSize, (INT64)ArgumentValue, Base, Width, ArgumentFlags);
+    } else {
+      // Unsigned integer argument
+      Status = EfiLocalePrintUnsigned(Locale, Encoding, Output->Buffer, &ThisSize, ArgumentValue, Base, Width, ArgumentFlags);
+    }
+    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+      return Status;
+    }
+    // Do not include the null terminator until the end of the output
+    if (ThisSize >= Encoding->UnitSize) {
+      ThisSize -= Encoding->UnitSize;
+    }
+    LocalePrintAdvance(Output, ThisSize);
+  }
+  return EFI_SUCCESS;
+}
+// LocalePrintOps
+/// Print compiled print operations to the formatted character string output
+/// @param Locale         The locale to use in formatting
+/// @param Output         The formatted character string output
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Ops            The compiled print operations
+/// @param Count          The count of compiled print operations
+/// @param Marker         The arguments to format, advanced past the printed arguments on output
+/// @retval EFI_SUCCESS The print operations were printed or the size required was added
+STATIC
+EFI_STATUS
+EFIAPI
+LocalePrintOps (
+  IN     EFI_LOCALE_PROTOCOL     *Locale,
+  IN OUT EFI_LOCALE_PRINT_OUTPUT *Output,
+  IN     EFI_ENCODING_PROTOCOL   *FormatEncoding,
+  IN     EFI_LOCALE_PRINT_OP     *Ops,
+  IN     UINTN                    Count,
+  IN OUT VA_LIST                 *Marker
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  UINTN      Index;
+  // Execute each operation
+  for (Index = 0; !EFI_ERROR(Status) && (Index < Count); ++Index) {
+    switch (Ops[Index].Type) {
+
+      case INTERNAL_PRINT_OP_LITERAL:
+        Status = LocalePrintLiteral(Output, FormatEncoding, Ops[Index].Literal, Ops[Index].LiteralSize);
+        break;
+
+      case INTERNAL_PRINT_OP_LINE:
+        Status = LocalePrintCharacter(Output, '\r');
+        if (!EFI_ERROR(Status)) {
+          Status = LocalePrintCharacter(Output, '\n');
+        }
+        break;
+
+      default:
+        Status = LocalePrintArgument(Locale, Output, Ops + Index, Marker);
+        break;
+
+    }
+  }
+  return Status;
+}
+
+// LocaleCompileCachedFormat
+/// Compile an entire format specifier string to cache
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @return The compiled format specifier string or NULL if there was an error
+STATIC
+EFI_LOCALE_PRINT_FORMAT *
+EFIAPI
+LocaleCompileCachedFormat (
+  IN EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN CONST VOID            *Format,
+  IN UINTN                  FormatSize
+) {
+  EFI_LOCALE_PRINT_FORMAT *Compiled;
+  CONST VOID              *Current = Format;
+  UINTN                    Remaining = FormatSize;
+  UINTN                    Count = MAX_UINTN;
+  // Count the operations
+  if (EFI_ERROR(LocaleCompileFormat(FormatEncoding, &Current, &Remaining, NULL, &Count))) {
+    return NULL;
+  }
+  // Allocate the compiled format specifier string with the operations following
+  Compiled = (EFI_LOCALE_PRINT_FORMAT *)
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalAllocate(sizeof(EFI_LOCALE_PRINT_FORMAT) + (Count * sizeof(EFI_LOCALE_PRINT_OP)));
+#else
+    EfiAllocate(sizeof(EFI_LOCALE_PRINT_FORMAT) + (Count * sizeof(EFI_LOCALE_PRINT_OP)));
+#endif
+  if (Compiled == NULL) {
+    return NULL;
+  }
+  Compiled->Format = Format;
+  Compiled->FormatEncoding = FormatEncoding;
+  Compiled->FormatSize = FormatSize;
+  Compiled->Count = Count;
+  Compiled->Ops = (EFI_LOCALE_PRINT_OP *)(Compiled + 1);
+  // Compile the operations
+  Current = Format;
+  Remaining = FormatSize;
+  if (EFI_ERROR(LocaleCompileFormat(FormatEncoding, &Current, &Remaining, Compiled->Ops, &(Compiled->Count)))) {
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalFreePool(Compiled);
+#else
+    EfiFreePool(Compiled);
+#endif
+    return NULL;
+  }
+  return Compiled;
+}
+// LocaleReadImage
+/// Read a little endian value from the loaded image headers
+/// @param Image  The loaded image
+/// @param Offset The offset in bytes of the value
+/// @param Size   The size in bytes of the value, which must be no more than four
+/// @return The value
+STATIC
+UINT32
+EFIAPI
+LocaleReadImage (
+  IN CONST UINT8 *Image,
+  IN UINTN        Offset,
+  IN UINTN        Size
+) {
+  UINT32 Value = 0;
+  // The headers are not guaranteed to be aligned so read a byte at a time
+  while (Size-- > 0) {
+    Value = (Value << 8) | Image[Offset + Size];
+  }
+  return Value;
+}
+// LocaleFindImageSections
+/// Find the read only sections of the loaded image
+/// @param Image     The loaded image
+/// @param ImageSize The size in bytes of the loaded image
+STATIC
+VOID
+EFIAPI
+LocaleFindImageSections (
+  IN CONST UINT8 *Image,
+  IN UINTN        ImageSize
+) {
+  UINTN  Offset;
+  UINTN  Count;
+  UINTN  Address;
+  UINTN  Size;
+  UINT32 Flags;
+  mLocaleImageSectionCount = 0;
+  // Check the DOS header and get the offset of the PE header
+  if ((Image == NULL) || (ImageSize < 0x40) || (Image[0] != 'M') || (Image[1] != 'Z')) {
+    return;
+  }
+  Offset = LocaleReadImage(Image, 0x3C, 4);
+  // Check the PE signature and the file header
+  if ((Offset > ImageSize) || ((ImageSize - Offset) < 24) ||
+      (Image[Offset] != 'P') || (Image[Offset + 1] != 'E') || (Image[Offset + 2] != 0) || (Image[Offset + 3] != 0)) {
+    return;
+  }
+  Count = LocaleReadImage(Image, Offset + 6, 2);
+  Offset += 24 + LocaleReadImage(Image, Offset + 20, 2);
+  // Remember each section that is readable and not writable
+  while ((Count-- > 0) && (mLocaleImageSectionCount < INTERNAL_IMAGE_SECTION_COUNT) &&
+         (Offset <= ImageSize) && ((ImageSize - Offset) >= 40)) {
+    Size = LocaleReadImage(Image, Offset + 8, 4);
+    Address = LocaleReadImage(Image, Offset + 12, 4);
+    Flags = LocaleReadImage(Image, Offset + 36, 4);
+    Offset += 40;
+    if (((Flags & INTERNAL_IMAGE_SECTION_READ) == 0) || ((Flags & INTERNAL_IMAGE_SECTION_WRITE) != 0) ||
+        (Size == 0) || (Address > ImageSize) || (Size > (ImageSize - Address))) {
+      continue;
+    }
+    mLocaleImageSections[mLocaleImageSectionCount][0] = (UINTN)Image + Address;
+    mLocaleImageSections[mLocaleImageSectionCount][1] = (UINTN)Image + Address + Size;
+    ++mLocaleImageSectionCount;
+  }
+}
+// LocaleCanCompileFormat
+/// Check whether a format specifier string may be compiled to cache, which allocates so only on the boot strap processor at or below TPL_NOTIFY
+/// @return Whether a format specifier string may be compiled to cache or not
+STATIC
+BOOLEAN
+EFIAPI
+LocaleCanCompileFormat (
   VOID
-);
-// DefaultLocaleUninstall
-/// Uninstall default locale protocol
-EXTERN
+) {
+  EFI_TPL Tpl;
+  UINTN   Processor = mLocalePrintBsp;
+  if (!mLocalePrintCompile) {
+    return FALSE;
+  }
+  // Application processors can not use boot services
+  if ((mLocalePrintMpServices != NULL) &&
+      (EFI_ERROR(mLocalePrintMpServices->WhoAmI(mLocalePrintMpServices, &Processor)) || (Processor != mLocalePrintBsp))) {
+    return FALSE;
+  }
+  // Memory can not be allocated above TPL_NOTIFY
+  Tpl = EfiRaiseTPL(TPL_HIGH_LEVEL);
+  EfiRestoreTPL(Tpl);
+  return (Tpl <= TPL_NOTIFY);
+}
+// LocaleLookupFormat
+/// Get the cached compiled format specifier string, compiling and caching it if needed and possible
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @return The cached compiled format specifier string or NULL if the format specifier string is not cached
+STATIC
+EFI_LOCALE_PRINT_FORMAT *
+EFIAPI
+LocaleLookupFormat (
+  IN EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN CONST VOID            *Format,
+  IN UINTN                  FormatSize
+) {
+  EFI_LOCALE_PRINT_FORMAT *Compiled;
+  UINTN                    Slot;
+  // Only the format specifier strings inside the read only sections of the image are constant so the format pointer is a valid key
+  for (Slot = 0; Slot < mLocaleImageSectionCount; ++Slot) {
+    if (((UINTN)Format >= mLocaleImageSections[Slot][0]) && ((UINTN)Format < mLocaleImageSections[Slot][1]) &&
+        (FormatSize <= (mLocaleImageSections[Slot][1] - (UINTN)Format))) {
+      break;
+    }
+  }
+  if (Slot >= mLocaleImageSectionCount) {
+    return NULL;
+  }
+  // Do not wait for the cache, the format specifier string is compiled without caching instead
+  if (!EfiTryLock(&mLocalePrintLock)) {
+    return NULL;
+  }
+  // The cache slots are allocated when the locale protocols are installed
+  if (mLocalePrintCache == NULL) {
+    EfiUnlock(&mLocalePrintLock);
+    return NULL;
+  }
+  // Probe for the format specifier string, there is always an empty slot because the capacity is less than the slots
+  Slot = (((UINTN)Format >> 1) * 0x9E3779B9) & (INTERNAL_PRINT_CACHE_SLOTS - 1);
+  while ((Compiled = mLocalePrintCache[Slot]) != NULL) {
+    if ((Compiled->Format == Format) && (Compiled->FormatEncoding == FormatEncoding) && (Compiled->FormatSize == FormatSize)) {
+      break;
+    }
+    Slot = (Slot + 1) & (INTERNAL_PRINT_CACHE_SLOTS - 1);
+  }
+  // Compile and cache the format specifier string if not found, the cache is not full and allocating is possible
+  if ((Compiled == NULL) && (mLocalePrintCacheCount < INTERNAL_PRINT_CACHE_CAPACITY) && LocaleCanCompileFormat()) {
+    Compiled = LocaleCompileCachedFormat(FormatEncoding, Format, FormatSize);
+    if (Compiled != NULL) {
+      mLocalePrintCache[Slot] = Compiled;
+      ++mLocalePrintCacheCount;
+    }
+  }
+  EfiUnlock(&mLocalePrintLock);
+  return Compiled;
+}
+// LocaleExitBootServices
+/// Stop compiling format specifier strings to cache before exiting boot services, the cached ones are still used
+/// @param ImageHandle The image handle
+/// @param Data        Unused
+/// @return EFI_SUCCESS so exiting boot services is never aborted
+STATIC
 EFI_STATUS
 EFIAPI
-DefaultLocaleUninstall (
+LocaleExitBootServices (
+  IN EFI_HANDLE  ImageHandle,
+  IN VOID       *Data OPTIONAL
+) {
+  UNUSED_PARAMETER(ImageHandle);
+  UNUSED_PARAMETER(Data);
+  mLocalePrintCompile = FALSE;
+  mLocalePrintMpServices = NULL;
+  return EFI_SUCCESS;
+}
+// LocaleSetupFormats
+/// Set up the compiled format specifier string cache, must be called from the boot strap processor
+STATIC
+VOID
+EFIAPI
+LocaleSetupFormats (
   VOID
-);
+) {
+  EFI_MP_SERVICES_PROTOCOL *MpServices = NULL;
+  UINTN                     Bsp = 0;
+  // Nothing can be cached without the read only sections of the image or the exit boot services callback to stop compiling
+  if ((mLocaleImageSectionCount == 0) || (mLocalePrintCache != NULL) ||
+      EFI_ERROR(EfiExitBootServicesCallback(LocaleExitBootServices, NULL))) {
+    return;
+  }
+  // Allocate the cache slots
+  mLocalePrintCache = (EFI_LOCALE_PRINT_FORMAT **)
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalAllocate(INTERNAL_PRINT_CACHE_SLOTS * sizeof(EFI_LOCALE_PRINT_FORMAT *));
+#else
+    EfiAllocate(INTERNAL_PRINT_CACHE_SLOTS * sizeof(EFI_LOCALE_PRINT_FORMAT *));
+#endif
+  if (mLocalePrintCache == NULL) {
+    EfiExitBootServicesRemoveCallback(LocaleExitBootServices, NULL);
+    return;
+  }
+  EfiZeroArray(EFI_LOCALE_PRINT_FORMAT *, mLocalePrintCache, INTERNAL_PRINT_CACHE_SLOTS);
+  // Identify the boot strap processor so application processors only use the formats that are already cached
+  if (EFI_ERROR(EfiLocateProtocol(&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices)) || (MpServices == NULL) ||
+      (MpServices->WhoAmI == NULL) || EFI_ERROR(MpServices->WhoAmI(MpServices, &Bsp))) {
+    MpServices = NULL;
+    Bsp = 0;
+  }
+  mLocalePrintMpServices = MpServices;
+  mLocalePrintBsp = Bsp;
+  mLocalePrintCompile = TRUE;
+}
+// LocaleFreeFormats
+/// Free the compiled format specifier string cache
+STATIC
+VOID
+EFIAPI
+LocaleFreeFormats (
+  VOID
+) {
+  UINTN Slot;
+  EfiLock(&mLocalePrintLock);
+  if (mLocalePrintCache != NULL) {
+    EfiExitBootServicesRemoveCallback(LocaleExitBootServices, NULL);
+    for (Slot = 0; Slot < INTERNAL_PRINT_CACHE_SLOTS; ++Slot) {
+      if (mLocalePrintCache[Slot] != NULL) {
+#if defined(EFI_MEMORY_VIRTUAL)
+        EfiInternalFreePool(mLocalePrintCache[Slot]);
+#else
+        EfiFreePool(mLocalePrintCache[Slot]);
+#endif
+      }
+    }
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalFreePool(mLocalePrintCache);
+#else
+    EfiFreePool(mLocalePrintCache);
+#endif
+    mLocalePrintCache = NULL;
+  }
+  mLocalePrintCacheCount = 0;
+  mLocalePrintCompile = FALSE;
+  mLocalePrintMpServices = NULL;
+  mLocaleImageSectionCount = 0;
+  EfiUnlock(&mLocalePrintLock);
+}
 
 // EfiLocaleUninstall
 /// Uninstall locale protocols
@@ -61,8 +1395,13 @@ EFIAPI
 EfiLocaleUninstall (
   VOID
 ) {
+  // Forget the current and default locales
+  mLocaleCurrent = NULL;
+  mLocaleDefault = NULL;
   // Uninstall the default locale
   DefaultLocaleUninstall();
+  // Free the compiled format specifier string cache
+  LocaleFreeFormats();
   return EFI_SUCCESS;
 }
 // EfiLocaleInstall
@@ -73,7 +1412,14 @@ EFIAPI
 EfiLocaleInstall (
   VOID
 ) {
-  EFI_STATUS Status;
+  EFI_STATUS                 Status;
+  EFI_LOADED_IMAGE_PROTOCOL *LoadedImage;
+  // Remember the read only sections of the loaded image so format specifier strings inside them can be cached
+  LoadedImage = EfiLoadedImage(NULL);
+  if (LoadedImage != NULL) {
+    LocaleFindImageSections((CONST UINT8 *)LoadedImage->ImageBase, (UINTN)LoadedImage->ImageSize);
+  }
+  LocaleSetupFormats();
   // Install the default locale
   Status = DefaultLocaleInstall();
   return Status;
@@ -93,16 +1439,24 @@ EfiGetLocale (
   EFI_HANDLE          *Handles = NULL;
   UINTN                Count = 0;
   UINTN                Index;
+  BOOLEAN              Current = FALSE;
   // Check parameters
   if ((Name == NULL) || (*Name == 0)) {
+    // Return the current locale if already found
+    if (mLocaleCurrent != NULL) {
+      return mLocaleCurrent;
+    }
+    Current = TRUE;
     // Get the current locale name
     if (EFI_ERROR(EfiGetGlobalVariableBuffer(L"PlatformLocale", NULL, NULL, &LocaleName)) || (LocaleName == NULL)) {
-      return EfiDefaultLocale();
+      mLocaleCurrent = EfiDefaultLocale();
+      return mLocaleCurrent;
     }
     // Check the name is valid
     if (*LocaleName == 0) {
       EfiFreePool(LocaleName);
-      return EfiDefaultLocale();
+      mLocaleCurrent = EfiDefaultLocale();
+      return mLocaleCurrent;
     }
     // Set the name to the current locale name
     Name = LocaleName;
@@ -130,6 +1484,10 @@ EfiGetLocale (
   if (LocaleName != NULL) {
     EfiFreePool(LocaleName);
   }
+  // Remember the current locale
+  if (Current) {
+    mLocaleCurrent = Locale;
+  }
   // Return the locale if found
   return Locale;
 }
@@ -143,6 +1501,8 @@ EFIAPI
 EfiSetLocale (
   IN CONST CHAR8 *Name OPTIONAL
 ) {
+  // Find the current locale again on next use
+  mLocaleCurrent = NULL;
   return EfiSetVariable(L"PlatformLocale", &gEfiGlobalVariableGuid, EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS, AsciiStrSize(Name), (VOID *)Name);
 }
 
@@ -250,26 +1610,18 @@ EfiLocalePoolVPrint (
   IN  UINTN                  FormatSize,
   VA_LIST                    Marker
 ) {
-  VOID  *String;
-  // Get the size of the formatted string
-  UINTN  BufferSize = EfiLocaleVPrintSize(Locale, Encoding, FormatEncoding, Format, FormatSize, Marker);
-  if (BufferSize == 0) {
+  EFI_STRING_BUILDER  Builder;
+  VOID               *String = NULL;
+  // Print the formatted string into a growable string buffer, most strings fit the initial capacity so they are only formatted once
+  if (EFI_ERROR(EfiStringBuilderInitialize(&Builder, Encoding, NULL, 0))) {
     return NULL;
   }
-  // Allocate the string buffer
-  String = EfiAllocate(BufferSize);
-  if (String == NULL) {
-    return NULL;
-  }
-  // Print the formatted string
-  if (EFI_ERROR(EfiLocaleVSPrint(Locale, Encoding, String, &BufferSize, FormatEncoding, Format, FormatSize, Marker))) {
+  if (EFI_ERROR(EfiStringBuilderVAppendFormatted(&Builder, Locale, FormatEncoding, Format, FormatSize, Marker)) ||
+      EFI_ERROR(EfiStringBuilderSteal(&Builder, &String, Size))) {
     // Cleanup on error
-    EfiFreePool(String);
+    EfiStringBuilderFree(&Builder);
     return NULL;
   }
-  if (Size != NULL) {
-    *Size = BufferSize;
-  }
   // Return the string
   return String;
 }
@@ -328,21 +1680,16 @@ EfiLocaleVSPrint (
   IN     UINTN                  FormatSize,
   IN     VA_LIST                Marker
 ) {
-  EFI_STATUS Status = EFI_INVALID_PARAMETER;
-  UINTN      BufferSize = 0;
-  UINTN      RemainingSize;
-  UINTN      ThisSize;
-  UINTN      Precision = 0;
-  UINTN      Width = 0;
-  UINTN      Flags = 0;
-  BOOLEAN    Argument = FALSE;
-  BOOLEAN    CarriageReturn = FALSE;
+  EFI_STATUS               Status;
+  EFI_LOCALE_PRINT_FORMAT *Compiled;
+  EFI_LOCALE_PRINT_OUTPUT  Output;
+  EFI_LOCALE_PRINT_OP      Ops[INTERNAL_PRINT_CHUNK_COUNT];
+  UINTN                    ThisSize;
+  UINTN                    Count;
   // Check parameters
   if ((Encoding == NULL) || (Size == NULL) || (FormatEncoding == NULL) || (Format == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the remaining size
-  RemainingSize = *Size;
   // Get the current locale if needed
   if (Locale == NULL) {
     Locale = EfiGetLocale(NULL);
@@ -350,652 +1697,44 @@ EfiLocaleVSPrint (
       return EFI_UNSUPPORTED;
     }
   }
-  // Parse the format buffer
-  while (FormatSize >= FormatEncoding->UnitSize) {
-    EFI_ENCODING_PROTOCOL *ArgumentEncoding = NULL;
-    UINT64                 ArgumentValue = 0;
-    VOID                  *ArgumentBuffer = NULL;
-    UINTN                  ArgumentSize = 0;
-    UINT32                 Character = 0;
-    // Decode the next character from the format buffer
-    ThisSize = FormatSize;
-    Status = EfiDecodeCharacter(FormatEncoding, Format, &ThisSize, &Character);
-    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  // Set up the output
+  Output.Encoding = Encoding;
+  Output.Buffer = Buffer;
+  Output.Remaining = *Size;
+  Output.Size = 0;
+  // Print the cached compiled format specifier string if possible
+  Compiled = LocaleLookupFormat(FormatEncoding, Format, FormatSize);
+  if (Compiled != NULL) {
+    Status = LocalePrintOps(Locale, &Output, FormatEncoding, Compiled->Ops, Compiled->Count, &Marker);
+    if (EFI_ERROR(Status)) {
       return Status;
     }
-    // Check to make sure that this is not a null terminator character
-    if (Character == 0) {
-      break;
-    }
-    // Decrease the format buffer size
-    FormatSize -= ThisSize;
-    // Advance the format buffer
-    Format = ADDRESS_OFFSET(VOID, Format, ThisSize);
-    // Check if processing an argument
-    if (Argument) {
-      // Argument processing
-      switch (Character) {
-
-        default:
-          // Unknown character for argument so skip and return to normal processing
-          Argument = FALSE;
-          Precision = 0;
-          Width = 0;
-          Flags = 0;
-          continue;
-
-        //
-        // Argument flags
-        //
-
-        case '-':
-          // Left justify instead of right justify
-          Flags |= INTERNAL_PRINT_FLAG_LEFT_JUSTIFY;
-          continue;
-
-        case ' ':
-        case '\t':
-        case '\r':
-        case '\n':
-          // Skip any whitespace
-          continue;
-
-        case '+':
-          // Prefix integer sign (+ or -)
-          Flags |= INTERNAL_PRINT_FLAG_PREFIX_SIGN;
-          continue;
-
-        case ',':
-          // Separate integer digits into groups of three
-          Flags |= INTERNAL_PRINT_FLAG_SEPARATOR;
-          continue;
-
-        case 'L':
-        case 'l':
-          // Force long integer instead of normal integer
-          Flags |= INTERNAL_PRINT_FLAG_LONG;
-          continue;
-
-        case '0':
-
-          // If no width or precision yet, then prefix zeroes
-          if ((Width == 0) && EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
-            // Pad with zeroes instead of spaces
-            Flags |= INTERNAL_PRINT_FLAG_PAD_ZEROES;
-          } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) { 
-            // Precision
-            Precision *= 10;
-          } else {
-            // Width
-            Width *= 10;
-          }
-          continue;
-
-        //
-        // Width and precision
-        //
-
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-          // Width or precision
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
-            // Precision
-            Precision *= 10;
-            Precision += (Character - '0');
-          } else {
-            // Width
-            Width *= 10;
-            Width += (Character - '0');
-          }
-          continue;
-
-        case '*':
-          // The width and/or precision are the arguments before this argument
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
-            // Get the precision from the arguments
-            if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION_AS_ARG)) {
-              Precision = VA_ARG(Marker, UINTN);
-              Flags |= INTERNAL_PRINT_FLAG_PRECISION_AS_ARG;
-            }
-          } else if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_WIDTH_AS_ARG)) {
-            // Get the width from the arguments
-            Width = VA_ARG(Marker, UINTN);
-            Flags |= INTERNAL_PRINT_FLAG_WIDTH_AS_ARG;
-          }
-          continue;
-
-        case '.':
-          // Switch from width field parsing to precision field parsing
-          Flags |= INTERNAL_PRINT_FLAG_PRECISION;
-          continue;
-
-        //
-        // Argument type
-        //
-
-        case '%':
-          // Percent sign
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= INTERNAL_PRINT_FLAG_CHAR;
-          break;
-
-        case 'c':
-        case 'C':
-          // Unicode character
-          Character = VA_ARG(Marker, UINT32);
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= INTERNAL_PRINT_FLAG_CHAR;
-          break;
-
-        case 'p':
-          // Lowercase pointer argument
-          Flags |= INTERNAL_PRINT_FLAG_PREFIX_HEXADECIMAL;
-
-        case 'h':
-          // Lowercase hexadecimal with default integer width
-          if (Width == 0) {
-            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-              Width = (sizeof(UINT64) << 1);
-            } else {
-              Width = (sizeof(UINTN) << 1);
-            }
-          }
-          Flags |= INTERNAL_PRINT_FLAG_PAD_ZEROES;
-
-        case 'x':
-          // Lowercase hexadecimal
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = VA_ARG(Marker, UINT64);
-          } else {
-            ArgumentValue = (UINT64)VA_ARG(Marker, UINTN);
-          }
-          Flags &= ~INTERNAL_PRINT_FLAG_PREFIX_SIGN;
-          Flags |= INTERNAL_PRINT_FLAG_HEXADECIMAL;
-          break;
-
-        case 'P':
-          // Uppercase pointer argument
-          Flags |= INTERNAL_PRINT_FLAG_PREFIX_HEXADECIMAL;
-
-        case 'H':
-          // Uppercase hexadecimal with default integer width
-          if (Width == 0) {
-            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-              Width = (sizeof(UINT64) << 1);
-            } else {
-              Width = (sizeof(UINTN) << 1);
-            }
-          }
-          Flags |= INTERNAL_PRINT_FLAG_PAD_ZEROES;
-
-        case 'X':
-          // Uppercase hexadecimal
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = VA_ARG(Marker, UINT64);
-          } else {
-            ArgumentValue = (UINT64)VA_ARG(Marker, UINTN);
-          }
-          Flags &= ~INTERNAL_PRINT_FLAG_PREFIX_SIGN;
-          Flags |= (INTERNAL_PRINT_FLAG_UPPERCASE | INTERNAL_PRINT_FLAG_HEXADECIMAL);
-          break;
-
-        case 'O':
-          // Octal integer argument with prefix
-          Flags |= INTERNAL_PRINT_FLAG_PREFIX_OCTAL;
-
-        case 'o':
-          // Octal integer argument
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = VA_ARG(Marker, UINT64);
-          } else {
-            ArgumentValue = (UINT64)VA_ARG(Marker, UINTN);
-          }
-          Flags |= INTERNAL_PRINT_FLAG_OCTAL;
-          break;
-
-        case 'B':
-          // Binary integer argument with prefix
-          Flags |= INTERNAL_PRINT_FLAG_PREFIX_BINARY;
-
-        case 'b':
-          // Binary integer argument
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = VA_ARG(Marker, UINT64);
-          } else {
-            ArgumentValue = (UINT64)VA_ARG(Marker, UINTN);
-          }
-          Flags |= INTERNAL_PRINT_FLAG_BINARY;
-          break;
-
-        case 'd':
-        case 'i':
-          // Signed decimal integer argument
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = (UINT64)VA_ARG(Marker, INT64);
-          } else {
-            ArgumentValue = (UINT64)(INT64)VA_ARG(Marker, INTN);
-          }
-          Flags |= INTERNAL_PRINT_FLAG_SIGNED;
-          break;
-
-        case 'u':
-          // Unsigned decimal integer argument
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LONG)) {
-            ArgumentValue = VA_ARG(Marker, UINT64);
-          } else {
-            ArgumentValue = (UINT64)VA_ARG(Marker, UINTN);
-          }
-          break;
-
-        case 'F':
-          // Uppercase floating point
-          Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
-
-        case 'f':
-          // Floating point
-          ArgumentBuffer = (VOID *)VA_ADDRESS(Marker, FLOAT64);
-          Flags |= INTERNAL_PRINT_FLAG_FLOAT;
-          break;
-
-        case 'E':
-          // Uppercase scientific floating point
-          Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
-
-        case 'e':
-          // Scientific floating point
-          ArgumentBuffer = (VOID *)VA_ADDRESS(Marker, FLOAT64);
-          Flags |= INTERNAL_PRINT_FLAG_SCIENTIFIC;
-          break;
-
-        case 'm':
-          // Monetary floating point
-          ArgumentBuffer = (VOID *)VA_ADDRESS(Marker, FLOAT64);
-          Flags |= INTERNAL_PRINT_FLAG_MONETARY;
-          break;
-
-        case 'a':
-          // Latin-1 string argument
-          ArgumentEncoding = EfiLatin1Encoding();
-          ArgumentBuffer = VA_ARG(Marker, VOID *);
-          Status = EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize);
-          if (EFI_ERROR(Status)) {
-            Argument = FALSE;
-            continue;
-          }
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
-          Flags |= INTERNAL_PRINT_FLAG_BUFFER;
-          break;
-
-        case 'A':
-          // UTF-8 string argument
-          ArgumentEncoding = EfiUtf8Encoding();
-          ArgumentBuffer = VA_ARG(Marker, VOID *);
-          Status = EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize);
-          if (EFI_ERROR(Status)) {
-            Argument = FALSE;
-            continue;
-          }
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
-          Flags |= INTERNAL_PRINT_FLAG_BUFFER;
-          break;
-
-        case 's':
-          // Unicode string argument
-          ArgumentEncoding = EfiUtf16Encoding();
-          ArgumentBuffer = VA_ARG(Marker, VOID *);
-          Status = EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize);
-          if (EFI_ERROR(Status)) {
-            Argument = FALSE;
-            continue;
-          }
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
-          Flags |= INTERNAL_PRINT_FLAG_BUFFER;
-          break;
-
-        case 'S':
-          // Encoding argument and encoded string argument
-          ArgumentEncoding = VA_ARG(Marker, EFI_ENCODING_PROTOCOL *);
-          ArgumentBuffer = VA_ARG(Marker, VOID *);
-          Status = EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize);
-          if (EFI_ERROR(Status)) {
-            Argument = FALSE;
-            continue;
-          }
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
-          Flags |= INTERNAL_PRINT_FLAG_BUFFER;
-          break;
-
-        case 'r':
-          // Status code argument
-          ArgumentEncoding = EfiLatin1Encoding();
-          ArgumentBuffer = (VOID *)AsciiStrFromStatus(VA_ARG(Marker, EFI_STATUS));
-          Status = EfiEncodingStringSize(ArgumentEncoding, ArgumentBuffer, &ArgumentSize);
-          if (EFI_ERROR(Status)) {
-            Argument = FALSE;
-            continue;
-          }
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN);
-          Flags |= INTERNAL_PRINT_FLAG_BUFFER;
-          break;
-
-        case 'G':
-          // Uppercase GUID argument
-          Flags |= INTERNAL_PRINT_FLAG_UPPERCASE;
-
-        case 'g':
-          // GUID argument
-          ArgumentBuffer = (VOID *)VA_ARG(Marker, EFI_GUID *);
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= INTERNAL_PRINT_FLAG_GUID;
-          break;
-
-        case 't':
-          // Time argument
-          ArgumentBuffer = (VOID *)VA_ARG(Marker, EFI_TIME *);
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= INTERNAL_PRINT_FLAG_TIME;
-          break;
-
-        case 'D':
-          // Date argument
-          ArgumentBuffer = (VOID *)VA_ARG(Marker, EFI_TIME *);
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= INTERNAL_PRINT_FLAG_DATE;
-          break;
-
-        case 'T':
-          // Date and time argument
-          ArgumentBuffer = (VOID *)VA_ARG(Marker, EFI_TIME *);
-          Flags &= ~(INTERNAL_PRINT_FLAG_PAD_ZEROES | INTERNAL_PRINT_FLAG_PREFIX_SIGN | INTERNAL_PRINT_FLAG_PRECISION);
-          Flags |= (INTERNAL_PRINT_FLAG_DATE | INTERNAL_PRINT_FLAG_TIME);
-          break;
-
-      }
-    } else if (Character == '\n') {
-      // Translate LF to CR+LF if needed
-      if (CarriageReturn) {
-        CarriageReturn = FALSE;
-      } else {
-        if (RemainingSize > Encoding->UnitSize) {
-          ThisSize = RemainingSize;
-        } else {
-          ThisSize = 0;
-        }
-        Status = EfiEncodeCharacter(Encoding, Buffer, &ThisSize, '\r');
-        if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-          return Status;
-        }
-        // Decrease remaining size
-        if (RemainingSize > ThisSize) {
-          RemainingSize -= ThisSize;
-        } else {
-          RemainingSize = 0;
-        }
-        // Increase the buffer size
-        BufferSize += ThisSize;
-        // Advance the buffer
-        if (Buffer != NULL) {
-          Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-        }
-      }
-    } else if (CarriageReturn) {
-      // Translate CR to CR+LF if needed
-      if (RemainingSize > Encoding->UnitSize) {
-        ThisSize = RemainingSize;
-      } else {
-        ThisSize = 0;
-      }
-      Status = EfiEncodeCharacter(Encoding, Buffer, &ThisSize, '\n');
-      if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
+  } else {
+    // Otherwise compile and print the format specifier string a chunk at a time
+    while (FormatSize >= FormatEncoding->UnitSize) {
+      Count = ARRAY_COUNT(Ops);
+      Status = LocaleCompileFormat(FormatEncoding, &Format, &FormatSize, Ops, &Count);
+      if (EFI_ERROR(Status)) {
         return Status;
       }
-      // Decrease remaining size
-      if (RemainingSize > ThisSize) {
-        RemainingSize -= ThisSize;
-      } else {
-        RemainingSize = 0;
-      }
-      // Increase the buffer size
-      BufferSize += ThisSize;
-      // Advance the buffer
-      if (Buffer != NULL) {
-        Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-      }
-      // Still remember carriage return for translation
-      CarriageReturn = (Character == '\r') ? TRUE : FALSE;
-    } else if (Character == '%') {
-      // Switch to argument processing
-      Argument = TRUE;
-      Precision = 0;
-      Width = 0;
-      Flags = 0;
-      continue;
-    } else {
-      // Remember carriage return for translation
-      CarriageReturn = (Character == '\r') ? TRUE : FALSE;
-    }
-    // Set the remaining size for the argument or character in the buffer if any
-    if (RemainingSize > Encoding->UnitSize) {
-      ThisSize = RemainingSize;
-    } else {
-      ThisSize = 0;
-    }
-    // Check if there is an argument buffer
-    if (Argument) {
-      UINTN  Padding = 0;
-      UINT32 PadCharacter = EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PAD_ZEROES) ? '0' : ' ';
-      // Print argument
-      if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_CHAR | INTERNAL_PRINT_FLAG_BUFFER | INTERNAL_PRINT_FLAG_GUID)) {
-        // Character or buffer argument
-        if (Width != 0) {
-          UINTN Length = 0;
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_GUID)) {
-            // The length of the GUID is 36 characters for 16 bytes of hexadecimal and four separators
-            Length = 36;
-          } else {
-            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BUFFER)) {
-              // Get the length of the argument buffer
-              Length = ArgumentSize;
-              Status = EfiEncodingStringLength(ArgumentEncoding, ArgumentBuffer, &Length);
-              if (EFI_ERROR(Status)) {
-                return Status;
-              }
-            } else {
-              // Just one character
-              Length = 1;
-            }
-            // Check the length is less than the precision
-            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION) && (Length > Precision)) {
-              Length = Precision;
-            }
-          }
-          // Get the padding size for the argument
-          if (Width > Length) {
-            Padding = Width - Length;
-          }
-        }
-        // Pad for right justification
-        if ((Padding != 0) && EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
-          // Encode the padding character into the output buffer
-          Status = EfiFillCharacter(Encoding, Buffer, &ThisSize, Padding, PadCharacter);
-          if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-            return Status;
-          }
-          // Decrease remaining size
-          if (RemainingSize > ThisSize) {
-            RemainingSize -= ThisSize;
-          } else {
-            RemainingSize = 0;
-          }
-          // Increase the buffer size
-          BufferSize += ThisSize;
-          // Advance the buffer
-          if (Buffer != NULL) {
-            Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-          }
-          if (RemainingSize > Encoding->UnitSize) {
-            ThisSize = RemainingSize;
-          } else {
-            ThisSize = 0;
-          }
-        }
-        // Encode the characters from the format buffer into the output buffer
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_CHAR)) {
-          // Character buffer argument
-          if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) || (Precision != 0)) {
-            Status = EfiEncodeCharacter(Encoding, Buffer, &ThisSize, Character);
-          }
-        } else {
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BUFFER)) {
-            // String buffer argument
-            if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PRECISION)) {
-              if (Precision != 0) {
-                // Convert the argument buffer into the output buffer with a maximum count
-                Status = EfiEncodingConvertCount(Encoding, Buffer, &ThisSize, ArgumentEncoding, ArgumentBuffer, ArgumentSize, Precision);
-              }
-            } else {
-              // Convert the entire argument buffer into the output buffer
-              Status = EfiEncodingConvert(Encoding, Buffer, &ThisSize, ArgumentEncoding, ArgumentBuffer, ArgumentSize);
-            }
-          } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_GUID)) {
-            // GUID argument - precision does not apply to this argument type!
-            Status = EfiEncodingPrintGuid(Encoding, Buffer, &ThisSize, (EFI_GUID *)ArgumentBuffer, EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_UPPERCASE));
-          }
-          // Do not include the null terminator until the end of the output
-          if (ThisSize >= Encoding->UnitSize) {
-            ThisSize -= Encoding->UnitSize;
-          }
-        }
-        // Pad for left justification
-        if ((Padding != 0) && EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
-          if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-            return Status;
-          }
-          // Decrease remaining size
-          if (RemainingSize > ThisSize) {
-            RemainingSize -= ThisSize;
-          } else {
-            RemainingSize = 0;
-          }
-          // Increase the buffer size
-          BufferSize += ThisSize;
-          // Advance the buffer
-          if (Buffer != NULL) {
-            Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
-          }
-          // Encode the padding character into the output buffer
-          if (RemainingSize > Encoding->UnitSize) {
-            ThisSize = RemainingSize;
-          } else {
-            ThisSize = 0;
-          }
-          Status = EfiFillCharacter(Encoding, Buffer, &ThisSize, Padding, PadCharacter);
-        }
-      } else {
-        UINTN Base;
-        UINTN ArgumentFlags = 0;
-        // Determine the argument print flags
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_UPPERCASE)) {
-          ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_UPPERCASE;
-        }
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_LEFT_JUSTIFY)) {
-          ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_LEFT_JUSTIFY;
-        }
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PAD_ZEROES)) {
-          ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_PAD_ZEROES;
-        }
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_PREFIX_SIGN)) {
-          ArgumentFlags |= EFI_LOCALE_PRINT_FLAG_PREFIX_SIGN;
-        }
-        // Determine the base of the argument
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_HEXADECIMAL)) {
-          Base = 16;
-        } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_OCTAL)) {
-          Base = 8;
-        } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_BINARY)) {
-          Base = 2;
-        } else {
-          Base = 10;
-        }
-        // Encode the argument into the output buffer
-        if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_TIME | INTERNAL_PRINT_FLAG_DATE)) {
-          // Time and/or date argument
-          UINTN Type = EFI_LOCALE_PRINT_TIME | EFI_LOCALE_PRINT_DATE;
-          if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_TIME)) {
-            if (EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_DATE)) {
-              Type = EFI_LOCALE_PRINT_TIME;
-            }
-          } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_DATE)) {
-            Type = EFI_LOCALE_PRINT_DATE;
-          }
-          Status = EfiLocalePrintDateTime(Locale, Encoding, Buffer, &ThisSize, (EFI_TIME *)ArgumentBuffer, Type, Width, ArgumentFlags);
-        } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_FLOAT)) {
-          // Floating point argument
-          Status = EfiLocalePrintFloat(Locale, Encoding, Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) ? EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION : Precision, ArgumentFlags);
-        } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SCIENTIFIC)) {
-          // Floating point in scientific notation argument
-          Status = EfiLocalePrintScientific(Locale, Encoding, Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) ? EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION : Precision, ArgumentFlags);
-        } else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_MONETARY)) {
-          // Floating point in monetary notation argument
-          Status = EfiLocalePrintMonetary(Locale, Encoding, Buffer, &ThisSize, *((FLOAT64 *)ArgumentBuffer), Width, EFI_BITS_ARE_UNSET(Flags, INTERNAL_PRINT_FLAG_PRECISION) ? EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION : Precision, ArgumentFlags);
-        //} else if (EFI_BITS_ANY_SET(Flags, INTERNAL_PRINT_FLAG_SIGNED)) {
-        //  // Signed integer argument
-        //  Status = EfiLocalePrintInteger(Locale, Encoding, Buffer, &ThisSize, (INT64)ArgumentValue, Base, Width, ArgumentFlags);
-        } else {
-          // Unsigned integer argument
-          Status = EfiLocalePrintUnsigned(Locale, Encoding, Buffer, &ThisSize, ArgumentValue, Base, Width, ArgumentFlags);
-        }
-        // Do not include the null terminator until the end of the output
-        if (ThisSize >= Encoding->UnitSize) {
-          ThisSize -= Encoding->UnitSize;
-        }
+      Status = LocalePrintOps(Locale, &Output, FormatEncoding, Ops, Count, &Marker);
+      if (EFI_ERROR(Status)) {
+        return Status;
       }
-      // Switch back to normal processing
-      Argument = FALSE;
-      Precision = 0;
-      Width = 0;
-      Flags = 0;
-    } else {
-      // Encode the character from the format buffer into the output buffer
-      Status = EfiEncodeCharacter(Encoding, Buffer, &ThisSize, Character);
-    }
-    if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
-      return Status;
-    }
-    // Decrease remaining size
-    if (RemainingSize > ThisSize) {
-      RemainingSize -= ThisSize;
-    } else {
-      RemainingSize = 0;
-    }
-    // Increase the buffer size
-    BufferSize += ThisSize;
-    // Advance the buffer
-    if (Buffer != NULL) {
-      Buffer = ADDRESS_OFFSET(VOID, Buffer, ThisSize);
     }
   }
   // Encode the null-terminator into the output buffer
-  if (RemainingSize >= Encoding->UnitSize) {
-    ThisSize = RemainingSize;
+  if (Output.Remaining >= Encoding->UnitSize) {
+    ThisSize = Output.Remaining;
   } else {
     ThisSize = 0;
   }
-  Status = EfiEncodeCharacter(Encoding, Buffer, &ThisSize, 0);
+  Status = EfiEncodeCharacter(Encoding, Output.Buffer, &ThisSize, 0);
   if (EFI_ERROR(Status) && (Status != EFI_BUFFER_TOO_SMALL)) {
     return Status;
   }
-  // Increase the buffer size
-  BufferSize += ThisSize;
   // Set the new buffer size
-  *Size = BufferSize;
+  *Size = Output.Size + ThisSize;
   return Status;
 }
 
@@ -1468,6 +2207,21 @@ EfiLocaleToBoolean (
   // Call print method
   return Locale->ToBoolean(Locale, Encoding, Buffer, Size, Boolean);
 }
+// LocaleIsDefault
+/// Check if a locale is the default locale so conversions can be parsed directly without the protocol
+/// @param Locale The locale protocol
+/// @return Whether the locale is the default locale or not
+STATIC
+BOOLEAN
+EFIAPI
+LocaleIsDefault (
+  IN EFI_LOCALE_PROTOCOL *Locale
+) {
+  if (mLocaleDefault == NULL) {
+    mLocaleDefault = EfiDefaultLocale();
+  }
+  return ((Locale != NULL) && (Locale == mLocaleDefault)) ? TRUE : FALSE;
+}
 // EfiLocaleToUnsigned
 /// Convert an unsigned integer formatted character string buffer to an unsigned integer
 /// @param Locale   The locale protocol
@@ -1489,6 +2243,7 @@ EfiLocaleToUnsigned (
   IN OUT UINT64                 *Unsigned,
   IN     UINTN                   Base
 ) {
+  UINTN UnitSize;
   // Check for locale
   if (Locale == NULL) {
     // Get current locale
@@ -1497,6 +2252,13 @@ EfiLocaleToUnsigned (
       return EFI_UNSUPPORTED;
     }
   }
+  // Parse directly with the default locale
+  if (LocaleIsDefault(Locale)) {
+    UnitSize = DefaultLocaleParseUnitSize(Encoding);
+    if (UnitSize != 0) {
+      return DefaultLocaleParseUnsigned(UnitSize, Buffer, Size, Unsigned, Base);
+    }
+  }
   // Check for method
   if (Locale->ToUnsigned == NULL) {
     return EFI_UNSUPPORTED;
@@ -1525,6 +2287,7 @@ EfiLocaleToInteger (
   IN OUT INT64                  *Integer,
   IN     UINTN                   Base
 ) {
+  UINTN UnitSize;
   // Check for locale
   if (Locale == NULL) {
     // Get current locale
@@ -1533,6 +2296,13 @@ EfiLocaleToInteger (
       return EFI_UNSUPPORTED;
     }
   }
+  // Parse directly with the default locale
+  if (LocaleIsDefault(Locale)) {
+    UnitSize = DefaultLocaleParseUnitSize(Encoding);
+    if (UnitSize != 0) {
+      return DefaultLocaleParseInteger(UnitSize, Buffer, Size, Integer, Base);
+    }
+  }
   // Check for method
   if (Locale->ToInteger == NULL) {
     return EFI_UNSUPPORTED;
@@ -1559,6 +2329,7 @@ EfiLocaleToFloat (
   IN OUT UINTN                  *Size OPTIONAL,
   IN OUT FLOAT64                *Float
 ) {
+  UINTN UnitSize;
   // Check for locale
   if (Locale == NULL) {
     // Get current locale
@@ -1567,6 +2338,13 @@ EfiLocaleToFloat (
       return EFI_UNSUPPORTED;
     }
   }
+  // Parse directly with the default locale
+  if (LocaleIsDefault(Locale)) {
+    UnitSize = DefaultLocaleParseUnitSize(Encoding);
+    if (UnitSize != 0) {
+      return DefaultLocaleParseFloat(UnitSize, Buffer, Size, Float);
+    }
+  }
   // Check for method
   if (Locale->ToFloat == NULL) {
     return EFI_UNSUPPORTED;
@@ -1593,6 +2371,7 @@ EfiLocaleToScientific (
   IN OUT UINTN                  *Size OPTIONAL,
   IN OUT FLOAT64                *Float
 ) {
+  UINTN UnitSize;
   // Check for locale
   if (Locale == NULL) {
     // Get current locale
@@ -1601,6 +2380,13 @@ EfiLocaleToScientific (
       return EFI_UNSUPPORTED;
     }
   }
+  // Parse directly with the default locale
+  if (LocaleIsDefault(Locale)) {
+    UnitSize = DefaultLocaleParseUnitSize(Encoding);
+    if (UnitSize != 0) {
+      return DefaultLocaleParseFloat(UnitSize, Buffer, Size, Float);
+    }
+  }
   // Check for method
   if (Locale->ToScientific == NULL) {
     return EFI_UNSUPPORTED;
@@ -1661,6 +2447,7 @@ EfiLocaleToDateTime (
   IN OUT UINTN                  *Size OPTIONAL,
   IN OUT EFI_TIME               *DateTime
 ) {
+  UINTN UnitSize;
   // Check for locale
   if (Locale == NULL) {
     // Get current locale
@@ -1669,6 +2456,13 @@ EfiLocaleToDateTime (
       return EFI_UNSUPPORTED;
     }
   }
+  // Parse directly with the default locale
+  if (LocaleIsDefault(Locale)) {
+    UnitSize = DefaultLocaleParseUnitSize(Encoding);
+    if (UnitSize != 0) {
+      return DefaultLocaleParseDateTime(UnitSize, Buffer, Size, DateTime);
+    }
+  }
   // Check for method
   if (Locale->ToDateTime == NULL) {
     return EFI_UNSUPPORTED;
@@ -1676,3 +2470,84 @@ EfiLocaleToDateTime (
   // Call print method
   return Locale->ToDateTime(Locale, Encoding, Buffer, Size, DateTime);
 }
+
+// EfiLocalePrintBenchmark
+/// Log the time to print integers and floating points with the current locale in the UTF-16, UTF-8 and UTF-16 byte swapped encodings
+/// @param Count The count of values to print for each measurement
+/// @retval EFI_INVALID_PARAMETER If Count is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined or there is no current locale
+/// @retval EFI_SUCCESS           The benchmark was logged
+EFI_STATUS
+EFIAPI
+EfiLocalePrintBenchmark (
+  IN UINTN Count
+) {
+  STATIC CONST CHAR16   *Names[] = { L"decimal", L"hexadecimal", L"signed", L"float", L"shortest float" };
+  EFI_ENCODING_PROTOCOL *Encodings[3];
+  EFI_LOCALE_PROTOCOL   *Locale;
+  UINT64                 Buffer[16];
+  UINTN                  Size;
+  UINTN                  Encoding;
+  UINTN                  Kind;
+  UINTN                  Index;
+  UINT64                 Unsigned;
+  FLOAT64                Float;
+  UINT64                 Start;
+  UINT64                 Elapsed;
+  if (Count == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Locale = EfiGetLocale(NULL);
+  if ((Locale == NULL) || (EfiGetTimeStampFrequency() == 0)) {
+    return EFI_UNSUPPORTED;
+  }
+  // The byte swapped encoding cannot take the direct write path so it measures encoding each character
+  Encodings[0] = EfiUtf16Encoding();
+  Encodings[1] = EfiUtf8Encoding();
+  Encodings[2] = EfiUtf16SwappedEncoding();
+  LOG(L"Locale print benchmark: %u values\n", Count);
+  for (Encoding = 0; Encoding < ARRAY_COUNT(Encodings); ++Encoding) {
+    if (Encodings[Encoding] == NULL) {
+      continue;
+    }
+    for (Kind = 0; Kind < ARRAY_COUNT(Names); ++Kind) {
+      // Use the same spread of values for each measurement
+      Unsigned = 0x9E3779B97F4A7C15ULL;
+      Float = 0.1;
+      Start = EfiGetTimeStamp();
+      for (Index = 0; Index < Count; ++Index) {
+        Size = sizeof(Buffer);
+        switch (Kind) {
+          case 0:
+            EfiLocalePrintUnsigned(Locale, Encodings[Encoding], Buffer, &Size, Unsigned, 10, 0, 0);
+            break;
+
+          case 1:
+            EfiLocalePrintUnsigned(Locale, Encodings[Encoding], Buffer, &Size, Unsigned, 16, 0, 0);
+            break;
+
+          case 2:
+            EfiLocalePrintInteger(Locale, Encodings[Encoding], Buffer, &Size, (INT64)Unsigned, 10, 0, 0);
+            break;
+
+          case 3:
+            EfiLocalePrintFloat(Locale, Encodings[Encoding], Buffer, &Size, Float, 0, EFI_LOCALE_PRINT_FLOAT_DEFAULT_PRECISION, 0);
+            break;
+
+          default:
+            EfiLocalePrintFloat(Locale, Encodings[Encoding], Buffer, &Size, Float, 0, EFI_LOCALE_PRINT_FLOAT_SHORTEST_PRECISION, EFI_LOCALE_PRINT_FLAG_SHORTEST);
+            break;
+        }
+        // Vary the magnitude of the values
+        Unsigned = (Unsigned >> 3) | (Unsigned << 61);
+        Float = (Float * 1.75) + 0.375;
+        if (Float > 1000000.0) {
+          Float /= 999983.0;
+        }
+      }
+      Elapsed = EfiTimeStampToNanoseconds(EfiGetTimeStamp() - Start);
+      LOG(L"  %a %s: %lu ns, %lu ns each\n", Encodings[Encoding]->Name, Names[Kind], Elapsed, Elapsed / Count);
+    }
+  }
+  return EFI_SUCCESS;
+}
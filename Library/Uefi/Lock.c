@@ -33,7 +33,7 @@ EfiLock (
     return FALSE;
   }
   // Compare and exchange with release to acquire the lock
-  while (EfiCompareAndExchange32(Lock, EFI_LOCK_RELEASED, EFI_LOCK_ACQUIRED) == EFI_LOCK_RELEASED) {
+  while (EfiCompareAndExchange32(Lock, EFI_LOCK_RELEASED, EFI_LOCK_ACQUIRED) != EFI_LOCK_RELEASED) {
     // Pause and try again
     EfiCpuPause();
   }
@@ -52,7 +52,7 @@ EfiTryLock (
     return FALSE;
   }
   // Compare and exchange with release to acquire the lock
-  if (EfiCompareAndExchange32(Lock, EFI_LOCK_RELEASED, EFI_LOCK_ACQUIRED) == EFI_LOCK_RELEASED) {
+  if (EfiCompareAndExchange32(Lock, EFI_LOCK_RELEASED, EFI_LOCK_ACQUIRED) != EFI_LOCK_RELEASED) {
     return FALSE;
   }
   return TRUE;
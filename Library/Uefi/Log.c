@@ -6,6 +6,8 @@
 
 #include "VirtualMemory.h"
 
+#include <Uefi/Protocol/MpService.h>
+
 // EFI_LOG_PROTOCOL_IMPL_SIGNATURE
 /// The logging protocol implementation signature
 #define EFI_LOG_PROTOCOL_IMPL_SIGNATURE 0x00474F4C544E4C43
@@ -31,9 +33,167 @@
 # define EFI_LOG_VERBOSITY_DEFAULT EFI_LOG_VERBOSITY_NONE
 #endif
 
+// EFI_LOG_FILE_BUFFER_DEFAULT_SIZE
+/// The default size in bytes of the log file write behind buffer
+#if !defined(EFI_LOG_FILE_BUFFER_DEFAULT_SIZE)
+# define EFI_LOG_FILE_BUFFER_DEFAULT_SIZE 0x10000
+#endif
+// EFI_LOG_FILE_FLUSH_DEFAULT_PERIOD
+/// The default period in milliseconds of the timer that flushes the log file write behind buffer
+#define EFI_LOG_FILE_FLUSH_DEFAULT_PERIOD 1000
+
+// EFI_LOG_RING_SIZE
+/// The size in bytes of the staging ring of each processor, must be a power of two
+#if !defined(EFI_LOG_RING_SIZE)
+# define EFI_LOG_RING_SIZE 0x4000
+#endif
+// EFI_LOG_RING_DRAIN_PERIOD
+/// The period in 100ns units of the timer that drains the staging rings (10ms)
+#define EFI_LOG_RING_DRAIN_PERIOD 100000
+// EFI_LOG_ARGUMENT_MAXIMUM
+/// The maximum count of arguments of a staged message
+#define EFI_LOG_ARGUMENT_MAXIMUM 32
+// EFI_LOG_STRING_MAXIMUM
+/// The maximum count of characters of a string argument copied into a staged message
+#define EFI_LOG_STRING_MAXIMUM 256
+// EFI_LOG_STRING_ELLIPSIS
+/// The count of periods appended to a string argument that was truncated when copied into a staged message
+#define EFI_LOG_STRING_ELLIPSIS 3
+
+// EFI_LOG_RECORD_RESERVED
+/// The record is reserved but the producer has not finished writing it
+#define EFI_LOG_RECORD_RESERVED 0
+// EFI_LOG_RECORD_READY
+/// The record is ready to be formatted and output
+#define EFI_LOG_RECORD_READY 1
+// EFI_LOG_RECORD_PADDING
+/// The record pads the end of the ring so the next record does not wrap
+#define EFI_LOG_RECORD_PADDING 2
+
+// EFI_LOG_ARGUMENT_VALUE
+/// A value argument that is copied as is
+#define EFI_LOG_ARGUMENT_VALUE 0
+// EFI_LOG_ARGUMENT_STATUS
+/// A status code argument that is copied as is
+#define EFI_LOG_ARGUMENT_STATUS 1
+// EFI_LOG_ARGUMENT_STRING
+/// A pointer to a null terminated UTF-16 string that is copied into the record, this and the following kinds have copied data
+#define EFI_LOG_ARGUMENT_STRING 2
+// EFI_LOG_ARGUMENT_ASCII
+/// A pointer to a null terminated byte string that is copied into the record
+#define EFI_LOG_ARGUMENT_ASCII 3
+// EFI_LOG_ARGUMENT_GUID
+/// A pointer to a GUID that is copied into the record
+#define EFI_LOG_ARGUMENT_GUID 4
+// EFI_LOG_ARGUMENT_TIME
+/// A pointer to a time that is copied into the record
+#define EFI_LOG_ARGUMENT_TIME 5
+
+// EFI_LOG_FORMAT_DEFAULT_CAPACITY
+/// The initial count of format specifier strings the binary log format table holds, must be a power of two
+#define EFI_LOG_FORMAT_DEFAULT_CAPACITY 64
+
+// EFI_LOG_ALIGN
+/// Align a size in bytes of a record or part of a record
+/// @param Size The size in bytes to align
+/// @return The aligned size in bytes
+#define EFI_LOG_ALIGN(Size) ((((UINTN)(Size)) + 7) & ~((UINTN)7))
+
 // mEfiLogProtocolGuid
 /// The logging protocol unique identifier
 EFI_GUID gEfiLogProtocolGuid = EFI_LOG_PROTOCOL_GUID;
+// mLogProtocol
+/// The cached logging protocol so application processors never need to locate it
+STATIC EFI_LOG_PROTOCOL *mLogProtocol = NULL;
+
+// EFI_LOG_RECORD
+/// A staged log message, the arguments follow the record header then any copied argument data
+typedef struct EFI_LOG_RECORD EFI_LOG_RECORD;
+struct EFI_LOG_RECORD {
+
+  // Size
+  /// The aligned size in bytes of the record including the header
+  UINT32        Size;
+  // State
+  /// The state of the record, written last by the producer
+  UINT32        State;
+  // TimeStamp
+  /// The time stamp of when the message was logged
+  UINT64        TimeStamp;
+  // Format
+  /// The format specifier string, which must remain valid until the record is drained
+  CONST CHAR16 *Format;
+  // ArgumentSize
+  /// The size in bytes of the arguments
+  UINT32        ArgumentSize;
+  // Processor
+  /// The number of the processor that logged the message
+  UINT32        Processor;
+
+};
+
+// EFI_LOG_ARGUMENT
+/// A scanned argument of a format specifier string
+typedef struct EFI_LOG_ARGUMENT EFI_LOG_ARGUMENT;
+struct EFI_LOG_ARGUMENT {
+
+  // Kind
+  /// The kind of the argument
+  UINT32  Kind;
+  // Offset
+  /// The offset in bytes of the argument in the arguments
+  UINT32  Offset;
+  // Size
+  /// The size in bytes of the data copied into the record for the argument, not including alignment
+  UINTN   Size;
+  // Truncated
+  /// Whether the string argument was truncated and the copied data ends with periods
+  BOOLEAN Truncated;
+
+};
+
+// EFI_LOG_FORMAT
+/// A format specifier string recorded in the binary log, identified by its index
+typedef struct EFI_LOG_FORMAT EFI_LOG_FORMAT;
+struct EFI_LOG_FORMAT {
+
+  // Format
+  /// The format specifier string, only used to identify messages logged with the same format specifier string
+  CONST CHAR16 *Format;
+  // Offset
+  /// The offset in bytes of the format record in the binary log records, which holds the copy of the format specifier string used for formatting
+  UINTN         Offset;
+  // Written
+  /// Whether the format specifier string was defined in the current binary log file session
+  BOOLEAN       Written;
+
+};
+
+// EFI_LOG_RING
+/// The staging ring of a processor, producers reserve space by advancing the head and only the boot strap processor advances the tail
+typedef struct EFI_LOG_RING EFI_LOG_RING;
+struct EFI_LOG_RING {
+
+  // Buffer
+  /// The ring buffer
+  UINT8          *Buffer;
+  // Head
+  /// The position after the last reserved byte, only ever increases
+  VOLATILE UINTN  Head;
+  // Tail
+  /// The position of the first record that has not been drained, only ever increases
+  VOLATILE UINTN  Tail;
+  // Dropped
+  /// The count of messages that were dropped because the ring was full
+  VOLATILE UINTN  Dropped;
+  // Reported
+  /// The count of dropped messages that have been reported in the log
+  UINTN           Reported;
+  // Limit
+  /// The head position when the current drain started
+  UINTN           Limit;
+
+};
 
 // EFI_LOG_PROTOCOL_IMPL
 /// Logging protocol implementation
@@ -56,6 +216,21 @@ struct EFI_LOG_PROTOCOL_IMPL {
   // Size
   /// The size in characters of the log memory
   UINTN              Size;
+  // Capacity
+  /// The capacity in bytes of the log ring or zero if the log grows without bound
+  UINTN              Capacity;
+  // RingStart
+  /// The position in characters of the oldest text in the log ring
+  UINTN              RingStart;
+  // RingLength
+  /// The count of characters in the log ring
+  UINTN              RingLength;
+  // Scratch
+  /// The buffer messages are formatted into before being appended to the log ring
+  CHAR16            *Scratch;
+  // ScratchSize
+  /// The size in bytes of the scratch buffer
+  UINTN              ScratchSize;
   // File
   /// The log output file interface
   EFI_FILE_PROTOCOL *File;
@@ -68,6 +243,81 @@ struct EFI_LOG_PROTOCOL_IMPL {
   // Verbosity
   /// The verbose level of messages to log, messages logged above this level will be discarded, verbose level zero is never discarded
   UINT32             Verbosity;
+  // MpServices
+  /// The multiprocessor services protocol or NULL if there are no staging rings
+  EFI_MP_SERVICES_PROTOCOL *MpServices;
+  // Bsp
+  /// The processor number of the boot strap processor
+  UINTN              Bsp;
+  // Rings
+  /// The staging rings of every processor or NULL if messages are only logged from the boot strap processor
+  EFI_LOG_RING      *Rings;
+  // RingCount
+  /// The count of staging rings
+  UINTN              RingCount;
+  // RingPages
+  /// The count of pages allocated for the staging rings
+  UINTN              RingPages;
+  // DrainEvent
+  /// The periodic timer event that drains the staging rings
+  EFI_EVENT          DrainEvent;
+  // Writing
+  /// Whether the boot strap processor is writing to the log and outputs
+  VOLATILE UINTN     Writing;
+  // Dropped
+  /// The count of messages that were dropped because there was no staging ring for them
+  VOLATILE UINTN     Dropped;
+  // Reported
+  /// The count of messages dropped without a staging ring that have been reported in the log
+  UINTN              Reported;
+  // FileBuffer
+  /// The log file write behind buffer or NULL to write and flush the log file for every message
+  UINT8             *FileBuffer;
+  // FileBufferSize
+  /// The size in bytes of the log file write behind buffer
+  UINTN              FileBufferSize;
+  // FileBufferOffset
+  /// The size in bytes of the output in the log file write behind buffer
+  UINTN              FileBufferOffset;
+  // FilePolicy
+  /// The log file flush policy
+  UINT32             FilePolicy;
+  // FlushEvent
+  /// The periodic timer event that flushes the log file write behind buffer
+  EFI_EVENT          FlushEvent;
+  // ExitBootServices
+  /// Whether the exit boot services callback that drains the staging rings and flushes the log file write behind buffer is registered
+  BOOLEAN            ExitBootServices;
+  // Binary
+  /// Whether messages are recorded in the binary log format and formatted only when read or output to a text output
+  BOOLEAN            Binary;
+  // FileSession
+  /// Whether the binary log session record was written to the current log file
+  BOOLEAN            FileSession;
+  // Records
+  /// The binary log records or NULL if no message was recorded
+  UINT8             *Records;
+  // RecordsSize
+  /// The size in bytes of the binary log records memory
+  UINTN              RecordsSize;
+  // RecordsOffset
+  /// The size in bytes of the binary log records
+  UINTN              RecordsOffset;
+  // RecordsFormatted
+  /// The size in bytes of the binary log records that were formatted into the log
+  UINTN              RecordsFormatted;
+  // Formats
+  /// The format specifier strings recorded in the binary log, indexed by identifier
+  EFI_LOG_FORMAT    *Formats;
+  // FormatCount
+  /// The count of format specifier strings recorded in the binary log
+  UINTN              FormatCount;
+  // FormatCapacity
+  /// The count of format specifier strings the format table holds, the hash slots are twice as many
+  UINTN              FormatCapacity;
+  // FormatSlots
+  /// The open addressed hash slots of format identifiers plus one by format specifier string address, zero if empty
+  UINT32            *FormatSlots;
 
 };
 
@@ -75,13 +325,15 @@ struct EFI_LOG_PROTOCOL_IMPL {
 /// Open the log output file
 /// @param OutputFile     On input, the current output file or NULL, on output, the current or opened output file
 /// @param OutputFilePath The output file path
+/// @param Binary         Whether the output file is in the binary log format, which has a different default path and is never separated by a new line
 /// @return Whether the output file was opened or not
 STATIC
 EFI_STATUS
 EFIAPI
 OpenOutputFile (
   IN OUT EFI_FILE_PROTOCOL **OutputFile,
-  IN OUT CHAR16            **OutputFilePath
+  IN OUT CHAR16            **OutputFilePath,
+  IN     BOOLEAN             Binary
 ) {
   // Check output file pointer is valid
   if ((OutputFile == NULL) || (OutputFilePath == NULL)) {
@@ -108,7 +360,7 @@ OpenOutputFile (
       EfiFreePool(ImagePath);
       return EFI_OUT_OF_RESOURCES;
     }
-    // Reallocate the string to have four more characters for ".log" appended
+    // Reallocate the string to have four more characters for ".log" or ".bin" appended
     Path = (CHAR16 *)
 #if defined(EFI_MEMORY_VIRTUAL)
       EfiInternalAllocate((Length + 5) * sizeof(CHAR16));
@@ -122,72 +374,1896 @@ OpenOutputFile (
     // Copy the image path to the output file path
     EfiCopyArray(CHAR16, Path, ImagePath, Length);
     EfiFreePool(ImagePath);
-    // Append ".log"
-    EfiCopyArray(CHAR16, Path + Length, L".log", 5);
+    // Append ".log" or ".bin"
+    EfiCopyArray(CHAR16, Path + Length, Binary ? L".bin" : L".log", 5);
     // Set the output file path
     *OutputFilePath = Path;
   }
-  // Only open if not open already
-  if (*OutputFile == NULL) {
-    EFI_STATUS Status;
-    UINT64     Offset = 0;
-    Status = EfiFileOpenPath(OutputFile, *OutputFilePath, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
-    if (EFI_ERROR(Status)) {
-      return Status;
-    }
-    if (*OutputFile == NULL) {
-      return EFI_NOT_FOUND;
-    }
-    // Append don't replace, so seek to end of file
-    Status = EfiFileSetPosition(*OutputFile, 0xFFFFFFFFFFFFFFFF);
-    if (EFI_ERROR(Status)) {
-      return Status;
+  // Only open if not open already
+  if (*OutputFile == NULL) {
+    EFI_STATUS Status;
+    UINT64     Offset = 0;
+    Status = EfiFileOpenPath(OutputFile, *OutputFilePath, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+    if (*OutputFile == NULL) {
+      return EFI_NOT_FOUND;
+    }
+    // Append don't replace, so seek to end of file
+    Status = EfiFileSetPosition(*OutputFile, 0xFFFFFFFFFFFFFFFF);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+    // Write extra new line if there is already file contents, binary log sessions are simply appended
+    if (!Binary && !EFI_ERROR(EfiFileGetPosition(*OutputFile, &Offset)) && (Offset != 0)) {
+      UINTN Size = 2 * sizeof(CHAR16);
+      EfiFileWrite(*OutputFile, &Size, (VOID *)L"\r\n");
+      EfiFileFlush(*OutputFile);
+    }
+  }
+  // Return whether output file was opened
+  return EFI_SUCCESS;
+}
+// OutputFilePrint
+/// Output to the log output file
+/// @param OutputFile     On input, the current output file or NULL, on output, the current or opened output file
+/// @param OutputFilePath The output file path
+/// @param Text           The text to print to the output file
+/// @param Size           The size in bytes of the text
+/// @param Binary         Whether the output file is in the binary log format
+STATIC
+EFI_STATUS
+EFIAPI
+OutputFilePrint (
+  IN OUT EFI_FILE_PROTOCOL **OutputFile,
+  IN OUT CHAR16            **OutputFilePath,
+  IN     CONST CHAR16       *Text,
+  IN     UINTN               Size,
+  IN     BOOLEAN             Binary
+) {
+  EFI_STATUS Status;
+  // Open the output log file if needed
+  Status = OpenOutputFile(OutputFile, OutputFilePath, Binary);
+  if (!EFI_ERROR(Status)) {
+    // Write to the output file
+    Status = EfiFileWrite(*OutputFile, &Size, (VOID *)Text);
+    if (!EFI_ERROR(Status)) {
+      // Flush the output file
+      Status = EfiFileFlush(*OutputFile);
+    }
+  }
+  return Status;
+}
+
+// LogScanArguments
+/// Scan a format specifier string for the kind, offset and copied data size of each argument, this must match EfiLocaleVSPrint
+/// @param Format       The format specifier string
+/// @param Marker       The arguments to format or NULL to only scan the kind and offset of each argument without measuring the data to copy
+/// @param Arguments    On output, the scanned arguments
+/// @param Count        On output, the count of scanned arguments
+/// @param ArgumentSize On output, the size in bytes of the arguments
+/// @param DataSize     On output, the aligned size in bytes of the argument data to copy into a record
+/// @return Whether the format specifier string was scanned or there are too many arguments
+STATIC
+BOOLEAN
+EFIAPI
+LogScanArguments (
+  IN  CONST CHAR16     *Format,
+  IN  VA_LIST           Marker OPTIONAL,
+  OUT EFI_LOG_ARGUMENT *Arguments,
+  OUT UINTN            *Count,
+  OUT UINTN            *ArgumentSize,
+  OUT UINTN            *DataSize
+) {
+  BOOLEAN Argument = FALSE;
+  BOOLEAN Long = FALSE;
+  BOOLEAN Precision = FALSE;
+  BOOLEAN WidthArgument = FALSE;
+  BOOLEAN PrecisionArgument = FALSE;
+  UINTN   Offset = 0;
+  UINTN   Index = 0;
+  UINTN   Data = 0;
+  // Parse the format specifier string
+  for (; *Format != 0; ++Format) {
+    UINT32 Kind = EFI_LOG_ARGUMENT_VALUE;
+    UINTN  Size = sizeof(UINTN);
+    if (!Argument) {
+      // Start of an argument
+      if (*Format == L'%') {
+        Argument = TRUE;
+        Long = FALSE;
+        Precision = FALSE;
+        WidthArgument = FALSE;
+        PrecisionArgument = FALSE;
+      }
+      continue;
+    }
+    switch (*Format) {
+
+      case L'-':
+      case L' ':
+      case L'\t':
+      case L'\r':
+      case L'\n':
+      case L'+':
+      case L',':
+      case L'0':
+      case L'1':
+      case L'2':
+      case L'3':
+      case L'4':
+      case L'5':
+      case L'6':
+      case L'7':
+      case L'8':
+      case L'9':
+        // Flags, width and precision
+        continue;
+
+      case L'L':
+      case L'l':
+        // Long integer
+        Long = TRUE;
+        continue;
+
+      case L'.':
+        // Switch to precision
+        Precision = TRUE;
+        continue;
+
+      case L'*':
+        // The width and/or precision are the arguments before this argument
+        if (Precision) {
+          if (PrecisionArgument) {
+            continue;
+          }
+          PrecisionArgument = TRUE;
+        } else {
+          if (WidthArgument) {
+            continue;
+          }
+          WidthArgument = TRUE;
+        }
+        break;
+
+      case L'c':
+      case L'C':
+        // Character argument
+        Argument = FALSE;
+        break;
+
+      case L'r':
+        // Status code argument
+        Kind = EFI_LOG_ARGUMENT_STATUS;
+        Argument = FALSE;
+        break;
+
+      case L'p':
+      case L'h':
+      case L'x':
+      case L'P':
+      case L'H':
+      case L'X':
+      case L'O':
+      case L'o':
+      case L'B':
+      case L'b':
+      case L'd':
+      case L'i':
+      case L'u':
+        // Integer arguments
+        if (Long) {
+          Size = sizeof(UINT64);
+        }
+        Argument = FALSE;
+        break;
+
+      case L'F':
+      case L'f':
+      case L'E':
+      case L'e':
+      case L'm':
+        // Floating point arguments
+        Size = sizeof(FLOAT64);
+        Argument = FALSE;
+        break;
+
+      case L'a':
+      case L'A':
+        // Byte string arguments
+        Kind = EFI_LOG_ARGUMENT_ASCII;
+        Argument = FALSE;
+        break;
+
+      case L's':
+        // Unicode string argument
+        Kind = EFI_LOG_ARGUMENT_STRING;
+        Argument = FALSE;
+        break;
+
+      case L'S':
+        // Encoding argument and encoded string argument, the string is not copied as measuring it needs the encoding protocol
+        Size = sizeof(UINTN) << 1;
+        Argument = FALSE;
+        break;
+
+      case L'G':
+      case L'g':
+        // GUID argument
+        Kind = EFI_LOG_ARGUMENT_GUID;
+        Argument = FALSE;
+        break;
+
+      case L't':
+      case L'D':
+      case L'T':
+        // Time argument
+        Kind = EFI_LOG_ARGUMENT_TIME;
+        Argument = FALSE;
+        break;
+
+      default:
+        // Percent sign and unknown characters do not have arguments
+        Argument = FALSE;
+        continue;
+
+    }
+    // Check there are not too many arguments
+    if (Index >= EFI_LOG_ARGUMENT_MAXIMUM) {
+      return FALSE;
+    }
+    // Measure the data to copy for pointer arguments
+    Arguments[Index].Kind = Kind;
+    Arguments[Index].Offset = (UINT32)Offset;
+    Arguments[Index].Size = 0;
+    Arguments[Index].Truncated = FALSE;
+    if ((Kind >= EFI_LOG_ARGUMENT_STRING) && (Marker != NULL)) {
+      VOID *Pointer = *((VOID **)(Marker + Offset));
+      if (Pointer == NULL) {
+        Arguments[Index].Kind = EFI_LOG_ARGUMENT_VALUE;
+      } else {
+        UINTN Length = 0;
+        switch (Kind) {
+
+          case EFI_LOG_ARGUMENT_STRING:
+            while ((Length < EFI_LOG_STRING_MAXIMUM) && (((CONST CHAR16 *)Pointer)[Length] != 0)) {
+              ++Length;
+            }
+            if (((CONST CHAR16 *)Pointer)[Length] != 0) {
+              Arguments[Index].Truncated = TRUE;
+              Length += EFI_LOG_STRING_ELLIPSIS;
+            }
+            Arguments[Index].Size = (Length + 1) * sizeof(CHAR16);
+            break;
+
+          case EFI_LOG_ARGUMENT_ASCII:
+            while ((Length < EFI_LOG_STRING_MAXIMUM) && (((CONST CHAR8 *)Pointer)[Length] != 0)) {
+              ++Length;
+            }
+            if (((CONST CHAR8 *)Pointer)[Length] != 0) {
+              Arguments[Index].Truncated = TRUE;
+              Length += EFI_LOG_STRING_ELLIPSIS;
+            }
+            Arguments[Index].Size = (Length + 1) * sizeof(CHAR8);
+            break;
+
+          case EFI_LOG_ARGUMENT_GUID:
+            Arguments[Index].Size = sizeof(EFI_GUID);
+            break;
+
+          case EFI_LOG_ARGUMENT_TIME:
+            Arguments[Index].Size = sizeof(EFI_TIME);
+            break;
+
+        }
+        Data += EFI_LOG_ALIGN(Arguments[Index].Size);
+      }
+    }
+    // Advance to the next argument
+    Offset += Size;
+    ++Index;
+  }
+  *Count = Index;
+  *ArgumentSize = Offset;
+  *DataSize = Data;
+  return TRUE;
+}
+// LogCopyArgument
+/// Copy the data of a pointer argument into a record, terminating string arguments and ending truncated string arguments with periods
+/// @param Data     The data in the record
+/// @param Pointer  The pointer argument
+/// @param Argument The scanned argument
+STATIC
+VOID
+EFIAPI
+LogCopyArgument (
+  OUT UINT8                  *Data,
+  IN  CONST VOID             *Pointer,
+  IN  CONST EFI_LOG_ARGUMENT *Argument
+) {
+  UINTN Length;
+  UINTN Index;
+  if (Argument->Kind == EFI_LOG_ARGUMENT_STRING) {
+    Length = (Argument->Size / sizeof(CHAR16)) - (Argument->Truncated ? (EFI_LOG_STRING_ELLIPSIS + 1) : 1);
+    EfiCopyMem(Data, Pointer, Length * sizeof(CHAR16));
+    if (Argument->Truncated) {
+      for (Index = 0; Index < EFI_LOG_STRING_ELLIPSIS; ++Index) {
+        ((CHAR16 *)Data)[Length++] = L'.';
+      }
+    }
+    ((CHAR16 *)Data)[Length] = 0;
+  } else if (Argument->Kind == EFI_LOG_ARGUMENT_ASCII) {
+    Length = (Argument->Size / sizeof(CHAR8)) - (Argument->Truncated ? (EFI_LOG_STRING_ELLIPSIS + 1) : 1);
+    EfiCopyMem(Data, Pointer, Length * sizeof(CHAR8));
+    if (Argument->Truncated) {
+      for (Index = 0; Index < EFI_LOG_STRING_ELLIPSIS; ++Index) {
+        Data[Length++] = '.';
+      }
+    }
+    Data[Length] = 0;
+  } else {
+    EfiCopyMem(Data, Pointer, Argument->Size);
+  }
+}
+// LogHasErrorStatus
+/// Check whether a message has an error status code argument
+/// @param Format The format specifier string
+/// @param Marker The arguments to format
+/// @return Whether the message has an error status code argument
+STATIC
+BOOLEAN
+EFIAPI
+LogHasErrorStatus (
+  IN CONST CHAR16 *Format,
+  IN VA_LIST       Marker
+) {
+  EFI_LOG_ARGUMENT Arguments[EFI_LOG_ARGUMENT_MAXIMUM];
+  UINTN            Count = 0;
+  UINTN            ArgumentSize = 0;
+  UINTN            DataSize = 0;
+  UINTN            Index;
+  if (!LogScanArguments(Format, Marker, Arguments, &Count, &ArgumentSize, &DataSize)) {
+    return FALSE;
+  }
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Arguments[Index].Kind == EFI_LOG_ARGUMENT_STATUS) && EFI_ERROR(*((EFI_STATUS *)(Marker + Arguments[Index].Offset)))) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+// LogFileFlush
+/// Write the log file write behind buffer to the log file and flush the file, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+/// @return Whether the buffered output was written or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogFileFlush (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  UINTN Size = This->FileBufferOffset;
+  if ((This->FileBuffer == NULL) || (Size == 0)) {
+    return EFI_SUCCESS;
+  }
+  This->FileBufferOffset = 0;
+  return OutputFilePrint(&(This->File), &(This->Path), (CONST CHAR16 *)(This->FileBuffer), Size, This->Binary);
+}
+// LogFileWrite
+/// Output to the log file through the write behind buffer, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+/// @param Text The text to print to the output file
+/// @param Size The size in bytes of the text
+/// @return Whether the text was buffered or written or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogFileWrite (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Text,
+  IN UINTN                  Size
+) {
+  EFI_STATUS Status;
+  // Write and flush every message without a buffer
+  if (This->FileBuffer == NULL) {
+    return OutputFilePrint(&(This->File), &(This->Path), Text, Size, This->Binary);
+  }
+  // Flush the buffer when the text would fill it
+  if ((This->FileBufferOffset + Size) > This->FileBufferSize) {
+    Status = LogFileFlush(This);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  // Write text larger than the buffer directly, it will be flushed with the next buffer
+  if (Size >= This->FileBufferSize) {
+    Status = OpenOutputFile(&(This->File), &(This->Path), This->Binary);
+    if (!EFI_ERROR(Status)) {
+      Status = EfiFileWrite(This->File, &Size, (VOID *)Text);
+    }
+    return Status;
+  }
+  // Append the text to the buffer
+  EfiCopyMem(This->FileBuffer + This->FileBufferOffset, Text, Size);
+  This->FileBufferOffset += Size;
+  return EFI_SUCCESS;
+}
+
+// LogAllocate
+/// Allocate the log buffer, with the ring capacity in ring mode or the default size
+/// @param This   The logging protocol interface
+/// @param Length The count of characters the log buffer must fit if it is not a ring
+/// @return Whether the log buffer was allocated or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogAllocate (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Length
+) {
+  EFI_STATUS           Status;
+  EFI_PHYSICAL_ADDRESS Address = NULL;
+  UINTN                Count;
+  // The log needs room for the byte order mark and a null terminator besides its contents
+  if (This->Capacity != 0) {
+    Count = EFI_SIZE_TO_PAGES(This->Capacity + (2 * sizeof(CHAR16)));
+  } else {
+    Count = EFI_SIZE_TO_PAGES((Length + 2) * sizeof(CHAR16));
+    if (Count < EFI_LOG_DEFAULT_PAGE_COUNT) {
+      Count = EFI_LOG_DEFAULT_PAGE_COUNT;
+    }
+  }
+#if defined(EFI_MEMORY_VIRTUAL)
+  Status = EfiInternalAllocatePages(Count, &Address);
+#else
+  Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Count, &Address);
+#endif
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Address == NULL) {
+    // Failed to allocate the pages for log!
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Set the new buffer
+  This->Log = (CHAR16 *)(UINTN)Address;
+  This->Size = (EFI_PAGES_TO_SIZE(Count) / sizeof(CHAR16));
+  This->Offset = 1;
+  This->RingStart = 0;
+  This->RingLength = 0;
+  // Start the log with a UTF-16 byte order mark
+  This->Log[0] = L'\xFEFF';
+  This->Log[1] = 0;
+  return EFI_SUCCESS;
+}
+// LogRingAppend
+/// Append text to the ring, overwriting the oldest text if needed
+/// @param This   The logging protocol interface
+/// @param Text   The text to append
+/// @param Length The count of characters of the text
+STATIC
+VOID
+EFIAPI
+LogRingAppend (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Text,
+  IN UINTN                  Length
+) {
+  // The ring starts after the byte order mark and leaves room for a null terminator
+  CHAR16 *Ring = This->Log + 1;
+  UINTN   Capacity = This->Size - 2;
+  UINTN   Position;
+  UINTN   Count;
+  // Only the newest text fits if the text is larger than the ring
+  if (Length >= Capacity) {
+    EfiCopyArray(CHAR16, Ring, Text + (Length - Capacity), Capacity);
+    This->RingStart = 0;
+    This->RingLength = Capacity;
+    return;
+  }
+  // Copy the text up to the end of the ring then wrap around to the start
+  Position = This->RingStart + This->RingLength;
+  if (Position >= Capacity) {
+    Position -= Capacity;
+  }
+  Count = Capacity - Position;
+  if (Count > Length) {
+    Count = Length;
+  }
+  EfiCopyArray(CHAR16, Ring + Position, Text, Count);
+  if (Count < Length) {
+    EfiCopyArray(CHAR16, Ring, Text + Count, Length - Count);
+  }
+  // Drop the oldest text that was overwritten
+  This->RingLength += Length;
+  if (This->RingLength > Capacity) {
+    This->RingStart += (This->RingLength - Capacity);
+    if (This->RingStart >= Capacity) {
+      This->RingStart -= Capacity;
+    }
+    This->RingLength = Capacity;
+  }
+}
+// LogRingReverse
+/// Reverse characters in place
+/// @param Text   The characters to reverse
+/// @param Length The count of characters
+STATIC
+VOID
+EFIAPI
+LogRingReverse (
+  IN OUT CHAR16 *Text,
+  IN     UINTN   Length
+) {
+  CHAR16 *End = Text + Length;
+  while ((Text + 1) < End) {
+    CHAR16 Character = *Text;
+    *Text++ = *--End;
+    *End = Character;
+  }
+}
+// LogRingLinearize
+/// Rotate the ring in place so the oldest text is first and the log contents are a contiguous null terminated string
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogRingLinearize (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  CHAR16 *Ring = This->Log + 1;
+  UINTN   Capacity = This->Size - 2;
+  // Rotate left by the start with three reversals, text only wraps once the ring is full
+  if (This->RingStart != 0) {
+    LogRingReverse(Ring, This->RingStart);
+    LogRingReverse(Ring + This->RingStart, Capacity - This->RingStart);
+    LogRingReverse(Ring, Capacity);
+    This->RingStart = 0;
+  }
+  // Terminate the contents and set the offset as if the log were not a ring
+  Ring[This->RingLength] = 0;
+  This->Offset = This->RingLength + 1;
+}
+
+// LogOutput
+/// Print formatted text to the outputs, must only be called from the boot strap processor while writing
+/// @param This   The logging protocol interface
+/// @param Text   The null terminated formatted text
+/// @param Length The count of characters of the text
+/// @param Format  The format specifier string of the text
+/// @param Marker  The arguments of the text
+/// @param Outputs The outputs to print to if they are enabled
+STATIC
+VOID
+EFIAPI
+LogOutput (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Text,
+  IN UINTN                  Length,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker,
+  IN UINT32                 Outputs
+) {
+  Outputs &= This->Outputs;
+  if (EFI_BITS_ANY_SET(Outputs, EFI_LOG_OUTPUT_CONSOLE)) {
+    // Log console output
+    if (EFI_ERROR(EfiConOutPrint(Text))) {
+      This->Outputs &= ~EFI_LOG_OUTPUT_CONSOLE;
+    }
+  }
+  if (EFI_BITS_ANY_SET(Outputs, EFI_LOG_OUTPUT_FILE)) {
+    // Log file output
+    if (EFI_ERROR(LogFileWrite(This, Text, Length * sizeof(CHAR16)))) {
+      // Disable file output on an error
+      This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+    } else if ((This->FileBufferOffset != 0) && EFI_BITS_ANY_SET(This->FilePolicy, EFI_LOG_FLUSH_ERROR) && LogHasErrorStatus(Format, Marker)) {
+      // Persist the buffered output now since something failed
+      if (EFI_ERROR(LogFileFlush(This))) {
+        This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+      }
+    }
+  }
+#if !defined(EFI_SERIAL_DISABLE)
+  if (EFI_BITS_ANY_SET(Outputs, EFI_LOG_OUTPUT_SERIAL)) {
+    // Log serial output
+    if (EFI_ERROR(EfiSerialStrWriteAll(Text))) {
+      This->Outputs &= ~EFI_LOG_OUTPUT_SERIAL;
+    }
+  }
+#endif
+}
+// LogFormatScratch
+/// Format a message into the scratch buffer, must only be called from the boot strap processor while writing
+/// @param This   The logging protocol interface
+/// @param Format The format specifier string
+/// @param Marker The arguments to format
+/// @return The number of characters formatted into the scratch buffer, excluding the null terminator
+STATIC
+UINTN
+EFIAPI
+LogFormatScratch (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker
+) {
+  EFI_STATUS Status;
+  UINTN      Size = This->ScratchSize;
+  Status = EfiVSPrint(This->Scratch, &Size, Format, Marker);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    // Grow the scratch buffer to fit the message, it is only as large as the largest message
+    CHAR16 *Scratch = (CHAR16 *)
+#if defined(EFI_MEMORY_VIRTUAL)
+      EfiInternalAllocate(Size);
+#else
+      EfiAllocate(Size);
+#endif
+    if (Scratch == NULL) {
+      return 0;
+    }
+    if (This->Scratch != NULL) {
+#if defined(EFI_MEMORY_VIRTUAL)
+      EfiInternalFreePool(This->Scratch);
+#else
+      EfiFreePool(This->Scratch);
+#endif
+    }
+    This->Scratch = Scratch;
+    This->ScratchSize = Size;
+    Status = EfiVSPrint(This->Scratch, &Size, Format, Marker);
+  }
+  if (EFI_ERROR(Status) || (Size <= sizeof(CHAR16))) {
+    return 0;
+  }
+  // Get the count of characters from the size, excluding the null terminator
+  Size /= sizeof(CHAR16);
+  return Size - 1;
+}
+// LogWriteRing
+/// Print a formatted character string to the ring and outputs, must only be called from the boot strap processor while writing
+/// @param This    The logging protocol interface
+/// @param Format  The format specifier string
+/// @param Marker  The arguments to format
+/// @param Outputs The outputs to print to if they are enabled
+/// @return The number of characters printed
+STATIC
+UINTN
+EFIAPI
+LogWriteRing (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker,
+  IN UINT32                 Outputs
+) {
+  // Format the message into the scratch buffer since the ring may wrap
+  UINTN Length = LogFormatScratch(This, Format, Marker);
+  if (Length == 0) {
+    return 0;
+  }
+  // Append to the ring then log to outputs
+  LogRingAppend(This, This->Scratch, Length);
+  LogOutput(This, This->Scratch, Length, Format, Marker, Outputs);
+  return Length;
+}
+// LogWrite
+/// Print a formatted character string to the log and outputs, must only be called from the boot strap processor while writing
+/// @param This    The logging protocol interface
+/// @param Format  The format specifier string
+/// @param Marker  The arguments to format
+/// @param Outputs The outputs to print to if they are enabled
+/// @return The number of characters printed
+STATIC
+UINTN
+EFIAPI
+LogWrite (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker,
+  IN UINT32                 Outputs
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  UINTN      Size;
+  // Check if the log buffer exists
+  if ((This->Log == NULL) && EFI_ERROR(LogAllocate(This, 0))) {
+    return 0;
+  }
+  // A log with a capacity is a ring so memory is bounded and appending does not copy the log
+  if (This->Capacity != 0) {
+    return LogWriteRing(This, Format, Marker, Outputs);
+  }
+  // Get the remaining size of the log buffer
+  Size = (This->Size - This->Offset) * sizeof(CHAR16);
+  // Attempt to print to the log buffer
+  Status = EfiVSPrint(This->Log + This->Offset, &Size, Format, Marker);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    EFI_PHYSICAL_ADDRESS Address = NULL;
+    // Get the new page count needed
+    UINTN Previous = EFI_SIZE_TO_PAGES(This->Size * sizeof(CHAR16));
+    UINTN Count = EFI_SIZE_TO_PAGES(Size);
+    if (Count < EFI_LOG_DEFAULT_PAGE_COUNT) {
+      Count = EFI_LOG_DEFAULT_PAGE_COUNT;
+    }
+    Count += Previous;
+    // Reallocate the log buffer
+#if defined(EFI_MEMORY_VIRTUAL)
+    Status = EfiInternalAllocatePages(Count, &Address);
+#else
+    Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Count, &Address);
+#endif
+    if (EFI_ERROR(Status)) {
+      return 0;
+    }
+    // Copy the old buffer to the new
+    EfiCopyArray(CHAR16, (UINTN)Address, This->Log, (This->Offset + 1));
+    // Free the old buffer
+    EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Log), Previous);
+    // Set the new buffer
+    This->Log = (CHAR16 *)(UINTN)Address;
+    This->Size = (EFI_PAGES_TO_SIZE(Count) / sizeof(CHAR16));
+    // Get the new remaining size of the log buffer
+    Size = (This->Size - This->Offset) * sizeof(CHAR16);
+    // Attempt to print to the log buffer again
+    Status = EfiVSPrint(This->Log + This->Offset, &Size, Format, Marker);
+  }
+  if (EFI_ERROR(Status)) {
+    return 0;
+  }
+  // Check any characters were written
+  if (Size <= sizeof(CHAR16)) {
+    return 0;
+  }
+  // Get the count of characters from the size, excluding the null terminator
+  Size /= sizeof(CHAR16);
+  --Size;
+  // Make sure the log has a null terminator
+  This->Log[This->Offset + Size] = 0;
+  // Log to outputs
+  LogOutput(This, This->Log + This->Offset, Size, Format, Marker, Outputs);
+  // Get the count of characters written and advance the offset
+  This->Offset += Size;
+  return Size;
+}
+// LogBinaryEvict
+/// Drop the oldest binary log message records and compact the remaining records, the session and format records are kept since later messages refer to them, must only be called from the boot strap processor while writing
+/// @param This  The logging protocol interface
+/// @param Count The size in bytes of the message records to drop
+STATIC
+VOID
+EFIAPI
+LogBinaryEvict (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Count
+) {
+  EFI_LOG_BINARY_HEADER *Header;
+  UINTN                  Read = sizeof(EFI_LOG_BINARY_SESSION);
+  UINTN                  Write = sizeof(EFI_LOG_BINARY_SESSION);
+  UINTN                  Formatted = sizeof(EFI_LOG_BINARY_SESSION);
+  UINTN                  Dropped = 0;
+  UINTN                  Size;
+  while (Read < This->RecordsOffset) {
+    Header = (EFI_LOG_BINARY_HEADER *)(This->Records + Read);
+    Size = Header->Size;
+    if ((Header->Type == EFI_LOG_BINARY_TYPE_MESSAGE) && (Dropped < Count)) {
+      // Drop the oldest message
+      Dropped += Size;
+    } else {
+      // Move the record down and update the offset of a moved format record
+      if (Write != Read) {
+        EfiCopyMem(This->Records + Write, Header, Size);
+        Header = (EFI_LOG_BINARY_HEADER *)(This->Records + Write);
+        if ((Header->Type == EFI_LOG_BINARY_TYPE_FORMAT) && (((EFI_LOG_BINARY_FORMAT *)Header)->Id < This->FormatCount)) {
+          This->Formats[((EFI_LOG_BINARY_FORMAT *)Header)->Id].Offset = Write;
+        }
+      }
+      Write += Size;
+    }
+    Read += Size;
+    // Formatting resumes after the moved records that were already formatted
+    if (Read <= This->RecordsFormatted) {
+      Formatted = Write;
+    }
+  }
+  This->RecordsOffset = Write;
+  This->RecordsFormatted = Formatted;
+}
+// LogBinaryReserve
+/// Reserve space at the end of the binary log records, starting the records with a session record and dropping the oldest messages if the log has a capacity, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+/// @param Size The aligned size in bytes of the record
+/// @return The zeroed reserved record or NULL if the records could not be grown, the caller advances the records offset
+STATIC
+UINT8 *
+EFIAPI
+LogBinaryReserve (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Size
+) {
+  EFI_STATUS             Status;
+  EFI_PHYSICAL_ADDRESS   Address = NULL;
+  EFI_LOG_BINARY_SESSION Session;
+  UINTN                  Previous;
+  UINTN                  Count;
+  UINTN                  Offset = This->RecordsOffset;
+  if (This->Records == NULL) {
+    Offset = sizeof(EFI_LOG_BINARY_SESSION);
+  } else if ((This->Capacity != 0) && ((Offset + Size) > This->Capacity)) {
+    // Drop the oldest messages so the records stay within the capacity of the log
+    LogBinaryEvict(This, (Offset + Size) - This->Capacity);
+    Offset = This->RecordsOffset;
+  }
+  if ((This->Records == NULL) || ((Offset + Size) > This->RecordsSize)) {
+    Previous = EFI_SIZE_TO_PAGES(This->RecordsSize);
+    if (This->Capacity != 0) {
+      // Allocate the capacity, only growing past it if the format records leave no room for the record
+      Count = EFI_SIZE_TO_PAGES(((Offset + Size) > This->Capacity) ? (Offset + Size) : This->Capacity);
+    } else {
+      // Grow the records by at least the default page count
+      Count = EFI_SIZE_TO_PAGES(Offset + Size);
+      if (Count < EFI_LOG_DEFAULT_PAGE_COUNT) {
+        Count = EFI_LOG_DEFAULT_PAGE_COUNT;
+      }
+      Count += Previous;
+    }
+#if defined(EFI_MEMORY_VIRTUAL)
+    Status = EfiInternalAllocatePages(Count, &Address);
+#else
+    Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Count, &Address);
+#endif
+    if (EFI_ERROR(Status) || (Address == NULL)) {
+      return NULL;
+    }
+    if (This->Records != NULL) {
+      EfiCopyMem((VOID *)(UINTN)Address, This->Records, This->RecordsOffset);
+      EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Records), Previous);
+    } else {
+      // Start the records with a session record so they can be written to a file as is
+      EfiZeroMem(&Session, sizeof(EFI_LOG_BINARY_SESSION));
+      Session.Header.Size = sizeof(EFI_LOG_BINARY_SESSION);
+      Session.Header.Type = EFI_LOG_BINARY_TYPE_SESSION;
+      Session.Signature = EFI_LOG_BINARY_SIGNATURE;
+      Session.Version = EFI_LOG_BINARY_VERSION;
+      Session.PointerSize = sizeof(VOID *);
+      Session.Frequency = EfiGetTimeStampFrequency();
+      EfiCopyMem((VOID *)(UINTN)Address, &Session, sizeof(EFI_LOG_BINARY_SESSION));
+      This->RecordsOffset = sizeof(EFI_LOG_BINARY_SESSION);
+      This->RecordsFormatted = sizeof(EFI_LOG_BINARY_SESSION);
+    }
+    This->Records = (UINT8 *)(UINTN)Address;
+    This->RecordsSize = EFI_PAGES_TO_SIZE(Count);
+  }
+  EfiZeroMem(This->Records + This->RecordsOffset, Size);
+  return This->Records + This->RecordsOffset;
+}
+// LogBinaryFileWrite
+/// Write binary log records to the log file, starting the log file session and disabling file output on an error, must only be called from the boot strap processor while writing
+/// @param This   The logging protocol interface
+/// @param Record The records to write
+/// @param Size   The size in bytes of the records
+/// @return Whether the records were written or not
+STATIC
+BOOLEAN
+EFIAPI
+LogBinaryFileWrite (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST VOID            *Record,
+  IN UINTN                  Size
+) {
+  if (EFI_BITS_ARE_UNSET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
+    return FALSE;
+  }
+  // Every log file session starts with the session record at the start of the records
+  if (!This->FileSession) {
+    if (EFI_ERROR(LogFileWrite(This, (CONST CHAR16 *)(This->Records), sizeof(EFI_LOG_BINARY_SESSION)))) {
+      This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+      return FALSE;
+    }
+    This->FileSession = TRUE;
+  }
+  if (EFI_ERROR(LogFileWrite(This, (CONST CHAR16 *)Record, Size))) {
+    This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+    return FALSE;
+  }
+  return TRUE;
+}
+// LogBinaryFileReset
+/// Forget which binary log records were written to the log file so the next log file session defines them again
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogBinaryFileReset (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  UINTN Index;
+  for (Index = 0; Index < This->FormatCount; ++Index) {
+    This->Formats[Index].Written = FALSE;
+  }
+  This->FileSession = FALSE;
+}
+// LogBinaryHash
+/// Hash the address of a format specifier string
+/// @param Format The format specifier string
+/// @return The hash of the address
+STATIC
+UINTN
+EFIAPI
+LogBinaryHash (
+  IN CONST CHAR16 *Format
+) {
+  return ((((UINTN)Format) >> 1) * 0x9E3779B9);
+}
+// LogBinaryGrowFormats
+/// Double the capacity of the binary log format table and rehash the slots
+/// @param This The logging protocol interface
+/// @return Whether the format table was grown or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogBinaryGrowFormats (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  EFI_LOG_FORMAT *Formats;
+  UINT32         *Slots;
+  UINTN           Capacity = (This->FormatCapacity == 0) ? EFI_LOG_FORMAT_DEFAULT_CAPACITY : (This->FormatCapacity << 1);
+  UINTN           Mask = (Capacity << 1) - 1;
+  UINTN           Index;
+#if defined(EFI_MEMORY_VIRTUAL)
+  Formats = (EFI_LOG_FORMAT *)EfiInternalAllocate(Capacity * sizeof(EFI_LOG_FORMAT));
+  Slots = (UINT32 *)EfiInternalAllocate((Capacity << 1) * sizeof(UINT32));
+#else
+  Formats = (EFI_LOG_FORMAT *)EfiAllocate(Capacity * sizeof(EFI_LOG_FORMAT));
+  Slots = (UINT32 *)EfiAllocate((Capacity << 1) * sizeof(UINT32));
+#endif
+  if ((Formats == NULL) || (Slots == NULL)) {
+#if defined(EFI_MEMORY_VIRTUAL)
+    if (Formats != NULL) {
+      EfiInternalFreePool(Formats);
+    }
+    if (Slots != NULL) {
+      EfiInternalFreePool(Slots);
+    }
+#else
+    if (Formats != NULL) {
+      EfiFreePool(Formats);
+    }
+    if (Slots != NULL) {
+      EfiFreePool(Slots);
+    }
+#endif
+    return EFI_OUT_OF_RESOURCES;
+  }
+  EfiZeroMem(Slots, (Capacity << 1) * sizeof(UINT32));
+  // Copy the formats and rehash their identifiers into the new slots
+  for (Index = 0; Index < This->FormatCount; ++Index) {
+    UINTN Slot = LogBinaryHash(This->Formats[Index].Format) & Mask;
+    while (Slots[Slot] != 0) {
+      Slot = (Slot + 1) & Mask;
+    }
+    Slots[Slot] = (UINT32)(Index + 1);
+    Formats[Index] = This->Formats[Index];
+  }
+  if (This->Formats != NULL) {
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalFreePool(This->Formats);
+    EfiInternalFreePool(This->FormatSlots);
+#else
+    EfiFreePool(This->Formats);
+    EfiFreePool(This->FormatSlots);
+#endif
+  }
+  This->Formats = Formats;
+  This->FormatSlots = Slots;
+  This->FormatCapacity = Capacity;
+  return EFI_SUCCESS;
+}
+// LogBinaryDefine
+/// Get the identifier of a format specifier string, recording a format record before its first message in the binary log and log file, must only be called from the boot strap processor while writing
+/// @param This   The logging protocol interface
+/// @param Format The format specifier string
+/// @param Id     On output, the identifier of the format specifier string
+/// @return Whether the format specifier string was defined or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogBinaryDefine (
+  IN  EFI_LOG_PROTOCOL_IMPL *This,
+  IN  CONST CHAR16          *Format,
+  OUT UINT32                *Id
+) {
+  EFI_LOG_BINARY_FORMAT *Record;
+  EFI_LOG_FORMAT        *Entry;
+  UINTN                  Mask;
+  UINTN                  Slot;
+  UINTN                  Length;
+  UINTN                  Size;
+  // Look up the format by address, which is the same for every message logged with a string literal
+  if (This->FormatSlots != NULL) {
+    Mask = (This->FormatCapacity << 1) - 1;
+    for (Slot = LogBinaryHash(Format) & Mask; This->FormatSlots[Slot] != 0; Slot = (Slot + 1) & Mask) {
+      Entry = This->Formats + (This->FormatSlots[Slot] - 1);
+      // The format specifier string may be in a buffer that was rewritten so also compare it with the recorded copy
+      if ((Entry->Format != Format) ||
+          (StrCmp((CONST CHAR16 *)(This->Records + Entry->Offset + sizeof(EFI_LOG_BINARY_FORMAT)), Format) != 0)) {
+        continue;
+      }
+      *Id = This->FormatSlots[Slot] - 1;
+      // Define the format in the log file session if the log file was opened since it was recorded, the records already define the format
+      if (!Entry->Written && EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
+        Record = (EFI_LOG_BINARY_FORMAT *)(This->Records + Entry->Offset);
+        Entry->Written = LogBinaryFileWrite(This, Record, Record->Header.Size);
+      }
+      return EFI_SUCCESS;
+    }
+  }
+  // Add the format to the table
+  if ((This->FormatCount == This->FormatCapacity) && EFI_ERROR(LogBinaryGrowFormats(This))) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Record the format
+  Length = StrLen(Format) + 1;
+  Size = EFI_LOG_ALIGN(sizeof(EFI_LOG_BINARY_FORMAT) + (Length * sizeof(CHAR16)));
+  Record = (EFI_LOG_BINARY_FORMAT *)LogBinaryReserve(This, Size);
+  if (Record == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  *Id = (UINT32)This->FormatCount;
+  Record->Header.Size = (UINT32)Size;
+  Record->Header.Type = EFI_LOG_BINARY_TYPE_FORMAT;
+  Record->Id = *Id;
+  Record->Length = (UINT32)Length;
+  EfiCopyArray(CHAR16, (CHAR16 *)(Record + 1), Format, Length);
+  This->RecordsOffset += Size;
+  // Insert the identifier into the slots
+  Mask = (This->FormatCapacity << 1) - 1;
+  for (Slot = LogBinaryHash(Format) & Mask; This->FormatSlots[Slot] != 0; Slot = (Slot + 1) & Mask);
+  This->FormatSlots[Slot] = *Id + 1;
+  Entry = This->Formats + This->FormatCount++;
+  Entry->Format = Format;
+  Entry->Offset = (UINTN)(((UINT8 *)Record) - This->Records);
+  Entry->Written = LogBinaryFileWrite(This, Record, Size);
+  return EFI_SUCCESS;
+}
+// LogWriteBinary
+/// Record a message in the binary log and log file without formatting it, only formatting it for the text outputs, must only be called from the boot strap processor while writing
+/// @param This      The logging protocol interface
+/// @param TimeStamp The time stamp of when the message was logged
+/// @param Processor The number of the processor that logged the message
+/// @param Format    The format specifier string
+/// @param Marker    The arguments to format
+/// @return The number of characters printed to the text outputs, or the number of characters in the format specifier string if there are no text outputs
+STATIC
+UINTN
+EFIAPI
+LogWriteBinary (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINT64                 TimeStamp,
+  IN UINTN                  Processor,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker
+) {
+  EFI_LOG_ARGUMENT        Arguments[EFI_LOG_ARGUMENT_MAXIMUM];
+  EFI_LOG_BINARY_MESSAGE *Record;
+  UINT8                  *Copy;
+  UINT8                  *Data;
+  UINTN                   Count = 0;
+  UINTN                   ArgumentSize = 0;
+  UINTN                   DataSize = 0;
+  UINTN                   Size;
+  UINTN                   Index;
+  UINT32                  Id = 0;
+  // Record a message with too many arguments as its formatted text
+  if (!LogScanArguments(Format, Marker, Arguments, &Count, &ArgumentSize, &DataSize)) {
+    CONST CHAR16 *Text;
+    if (LogFormatScratch(This, Format, Marker) == 0) {
+      return 0;
+    }
+    Text = This->Scratch;
+    return LogWriteBinary(This, TimeStamp, Processor, L"%s", (VA_LIST)&Text);
+  }
+  // Get the identifier of the format, which is defined before the message
+  if (EFI_ERROR(LogBinaryDefine(This, Format, &Id))) {
+    return 0;
+  }
+  // Reserve the message record
+  Size = sizeof(EFI_LOG_BINARY_MESSAGE) + EFI_LOG_ALIGN(ArgumentSize) + DataSize;
+  Record = (EFI_LOG_BINARY_MESSAGE *)LogBinaryReserve(This, Size);
+  if (Record == NULL) {
+    return 0;
+  }
+  Record->Header.Size = (UINT32)Size;
+  Record->Header.Type = EFI_LOG_BINARY_TYPE_MESSAGE;
+  Record->TimeStamp = TimeStamp;
+  Record->Processor = (UINT32)Processor;
+  Record->Format = Id;
+  Record->ArgumentSize = (UINT32)ArgumentSize;
+  // Copy the raw arguments
+  Copy = (UINT8 *)(Record + 1);
+  Data = Copy + EFI_LOG_ALIGN(ArgumentSize);
+  if (ArgumentSize != 0) {
+    EfiCopyMem(Copy, Marker, ArgumentSize);
+  }
+  // Copy the data of pointer arguments and replace the pointers with offsets so the record can be moved and decoded elsewhere
+  for (Index = 0; Index < Count; ++Index) {
+    if (Arguments[Index].Kind >= EFI_LOG_ARGUMENT_STRING) {
+      UINTN *Pointer = (UINTN *)(Copy + Arguments[Index].Offset);
+      LogCopyArgument(Data, (CONST VOID *)*Pointer, Arguments + Index);
+      *Pointer = (UINTN)(Data - (UINT8 *)Record);
+      Data += EFI_LOG_ALIGN(Arguments[Index].Size);
+    }
+  }
+  This->RecordsOffset += Size;
+  // Write the record to the log file
+  if (LogBinaryFileWrite(This, Record, Size) && (This->FileBufferOffset != 0) &&
+      EFI_BITS_ANY_SET(This->FilePolicy, EFI_LOG_FLUSH_ERROR) && LogHasErrorStatus(Format, Marker)) {
+    // Persist the buffered output now since something failed
+    if (EFI_ERROR(LogFileFlush(This))) {
+      This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+    }
+  }
+  // Only format the message now for the text outputs
+  if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_CONSOLE | EFI_LOG_OUTPUT_SERIAL)) {
+    Size = LogFormatScratch(This, Format, Marker);
+    if (Size != 0) {
+      LogOutput(This, This->Scratch, Size, Format, Marker, EFI_LOG_OUTPUT_CONSOLE | EFI_LOG_OUTPUT_SERIAL);
+    }
+    return Size;
+  }
+  return StrLen(Format);
+}
+// LogBinaryFormat
+/// Format the binary log records that were not yet formatted into the log without printing them to the outputs, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogBinaryFormat (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  EFI_LOG_ARGUMENT Arguments[EFI_LOG_ARGUMENT_MAXIMUM];
+  UINT64           Marker[EFI_LOG_ARGUMENT_MAXIMUM << 1];
+  UINTN            Count;
+  UINTN            ArgumentSize;
+  UINTN            DataSize;
+  UINTN            Index;
+  CONST CHAR16    *Format;
+  while (This->RecordsFormatted < This->RecordsOffset) {
+    EFI_LOG_BINARY_MESSAGE *Record = (EFI_LOG_BINARY_MESSAGE *)(This->Records + This->RecordsFormatted);
+    This->RecordsFormatted += Record->Header.Size;
+    if ((Record->Header.Type != EFI_LOG_BINARY_TYPE_MESSAGE) || (Record->Format >= This->FormatCount) ||
+        (Record->ArgumentSize > sizeof(Marker))) {
+      continue;
+    }
+    // Format with the copy of the format specifier string in the format record since the original may have changed
+    Format = (CONST CHAR16 *)(This->Records + This->Formats[Record->Format].Offset + sizeof(EFI_LOG_BINARY_FORMAT));
+    // Copy the raw arguments and point the pointer arguments back to their copied data
+    EfiCopyMem(Marker, Record + 1, Record->ArgumentSize);
+    if (!LogScanArguments(Format, NULL, Arguments, &Count, &ArgumentSize, &DataSize)) {
+      continue;
+    }
+    for (Index = 0; Index < Count; ++Index) {
+      UINTN *Pointer = (UINTN *)(((UINT8 *)Marker) + Arguments[Index].Offset);
+      if ((Arguments[Index].Kind >= EFI_LOG_ARGUMENT_STRING) && (*Pointer != 0)) {
+        *Pointer += (UINTN)Record;
+      }
+    }
+    LogWrite(This, Format, (VA_LIST)Marker, EFI_LOG_OUTPUT_NONE);
+  }
+}
+// LogBinaryReset
+/// Free the binary log records and format table, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogBinaryReset (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  if (This->Records != NULL) {
+    EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Records), EFI_SIZE_TO_PAGES(This->RecordsSize));
+    This->Records = NULL;
+  }
+  if (This->Formats != NULL) {
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalFreePool(This->Formats);
+    EfiInternalFreePool(This->FormatSlots);
+#else
+    EfiFreePool(This->Formats);
+    EfiFreePool(This->FormatSlots);
+#endif
+    This->Formats = NULL;
+    This->FormatSlots = NULL;
+  }
+  This->RecordsSize = 0;
+  This->RecordsOffset = 0;
+  This->RecordsFormatted = 0;
+  This->FormatCount = 0;
+  This->FormatCapacity = 0;
+  This->FileSession = FALSE;
+}
+// LogWriteRecord
+/// Record a message in the binary log or print it to the log, and output it, must only be called from the boot strap processor while writing
+/// @param This      The logging protocol interface
+/// @param TimeStamp The time stamp of when the message was logged
+/// @param Processor The number of the processor that logged the message
+/// @param Format    The format specifier string
+/// @param Marker    The arguments to format
+/// @return The number of characters printed
+STATIC
+UINTN
+EFIAPI
+LogWriteRecord (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINT64                 TimeStamp,
+  IN UINTN                  Processor,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker
+) {
+  if (This->Binary) {
+    return LogWriteBinary(This, TimeStamp, Processor, Format, Marker);
+  }
+  return LogWrite(This, Format, Marker, EFI_LOG_OUTPUT_ALL);
+}
+// LogWriteFormat
+/// Print a formatted character string to the log and outputs, must only be called from the boot strap processor while writing
+/// @param This   The logging protocol interface
+/// @param Format The format specifier string
+/// @param ...    The arguments to format
+/// @return The number of characters printed
+STATIC
+UINTN
+EFIAPI
+LogWriteFormat (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN CONST CHAR16          *Format,
+  ...
+) {
+  UINTN   Count;
+  VA_LIST Marker;
+  VA_START(Marker, Format);
+  Count = LogWriteRecord(This, EfiGetTimeStamp(), This->Bsp, Format, Marker);
+  VA_END(Marker);
+  return Count;
+}
+
+// LogIncrement
+/// Atomically increment a counter
+/// @param Value The counter to increment
+STATIC
+VOID
+EFIAPI
+LogIncrement (
+  IN OUT VOLATILE UINTN *Value
+) {
+  UINTN Current;
+  do {
+    Current = *Value;
+  } while ((UINTN)EfiCompareAndExchange((UINTN *)Value, Current, Current + 1) != Current);
+}
+// LogBeginWrite
+/// Try to begin writing to the log and outputs from the boot strap processor
+/// @param This The logging protocol interface
+/// @return Whether writing began or the log is already being written by an interrupted caller
+STATIC
+BOOLEAN
+EFIAPI
+LogBeginWrite (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  return ((UINTN)EfiCompareAndExchange((UINTN *)&(This->Writing), FALSE, TRUE) == FALSE);
+}
+// LogEndWrite
+/// End writing to the log and outputs
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogEndWrite (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  This->Writing = FALSE;
+}
+
+// LogReserve
+/// Reserve a record in a staging ring, may be called from any processor and never blocks
+/// @param Ring The staging ring
+/// @param Size The aligned size in bytes of the record
+/// @return The reserved record or NULL if the ring is full and the message was counted as dropped
+STATIC
+EFI_LOG_RECORD *
+EFIAPI
+LogReserve (
+  IN EFI_LOG_RING *Ring,
+  IN UINTN         Size
+) {
+  EFI_LOG_RECORD *Record;
+  UINTN           Head;
+  UINTN           Offset;
+  UINTN           Padding;
+  // Reserve space by advancing the head only if the record fits, so overflow is detected instead of overwriting records
+  do {
+    Head = Ring->Head;
+    Offset = (Head & (EFI_LOG_RING_SIZE - 1));
+    // Pad to the end of the ring if the record would wrap
+    Padding = ((Offset + Size) > EFI_LOG_RING_SIZE) ? (EFI_LOG_RING_SIZE - Offset) : 0;
+    if (((Head + Padding + Size) - Ring->Tail) > EFI_LOG_RING_SIZE) {
+      LogIncrement(&(Ring->Dropped));
+      return NULL;
+    }
+  } while ((UINTN)EfiCompareAndExchange((UINTN *)&(Ring->Head), Head, Head + Padding + Size) != Head);
+  // Commit the padding record immediately
+  if (Padding != 0) {
+    Record = (EFI_LOG_RECORD *)(Ring->Buffer + Offset);
+    Record->Size = (UINT32)Padding;
+    EfiStore32(&(Record->State), EFI_LOG_RECORD_PADDING);
+    Offset = 0;
+  }
+  Record = (EFI_LOG_RECORD *)(Ring->Buffer + Offset);
+  Record->Size = (UINT32)Size;
+  return Record;
+}
+// LogStage
+/// Stage a message in the ring of the calling processor to be formatted when drained, may be called from any processor and never blocks
+/// @param This      The logging protocol interface
+/// @param Processor The calling processor number
+/// @param Format    The format specifier string
+/// @param Marker    The arguments to format
+/// @return The number of characters in the format specifier string or zero if the message was dropped
+STATIC
+UINTN
+EFIAPI
+LogStage (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Processor,
+  IN CONST CHAR16          *Format,
+  IN VA_LIST                Marker
+) {
+  EFI_LOG_ARGUMENT  Arguments[EFI_LOG_ARGUMENT_MAXIMUM];
+  EFI_LOG_RECORD   *Record;
+  EFI_LOG_RING     *Ring;
+  UINT8            *Copy;
+  UINT8            *Data;
+  UINTN             Count = 0;
+  UINTN             ArgumentSize = 0;
+  UINTN             DataSize = 0;
+  UINTN             Size;
+  UINTN             Index;
+  UINT64            TimeStamp = EfiGetTimeStamp();
+  // Check the processor has a ring, a nested message on the boot strap processor has nowhere to go without the rings
+  if ((This->Rings == NULL) || (Processor >= This->RingCount)) {
+    LogIncrement(&(This->Dropped));
+    return 0;
+  }
+  Ring = This->Rings + Processor;
+  // Scan the arguments to determine the size of the record
+  if (!LogScanArguments(Format, Marker, Arguments, &Count, &ArgumentSize, &DataSize)) {
+    LogIncrement(&(Ring->Dropped));
+    return 0;
+  }
+  Size = EFI_LOG_ALIGN(sizeof(EFI_LOG_RECORD)) + EFI_LOG_ALIGN(ArgumentSize) + DataSize;
+  if (Size > (EFI_LOG_RING_SIZE >> 1)) {
+    LogIncrement(&(Ring->Dropped));
+    return 0;
+  }
+  // Reserve the record
+  Record = LogReserve(Ring, Size);
+  if (Record == NULL) {
+    return 0;
+  }
+  Record->TimeStamp = TimeStamp;
+  Record->Format = Format;
+  Record->ArgumentSize = (UINT32)ArgumentSize;
+  Record->Processor = (UINT32)Processor;
+  // Copy the arguments
+  Copy = ((UINT8 *)Record) + EFI_LOG_ALIGN(sizeof(EFI_LOG_RECORD));
+  Data = Copy + EFI_LOG_ALIGN(ArgumentSize);
+  if (ArgumentSize != 0) {
+    EfiCopyMem(Copy, Marker, ArgumentSize);
+  }
+  // Copy the data of pointer arguments so they do not need to remain valid, then point the copied argument to the copied data
+  for (Index = 0; Index < Count; ++Index) {
+    if (Arguments[Index].Kind >= EFI_LOG_ARGUMENT_STRING) {
+      VOID **Pointer = (VOID **)(Copy + Arguments[Index].Offset);
+      LogCopyArgument(Data, *Pointer, Arguments + Index);
+      *Pointer = (VOID *)Data;
+      Data += EFI_LOG_ALIGN(Arguments[Index].Size);
+    }
+  }
+  // Commit the record
+  EfiStore32(&(Record->State), EFI_LOG_RECORD_READY);
+  return StrLen(Format);
+}
+// LogDrainRings
+/// Format and output the ready records of the staging rings in time stamp order, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogDrainRings (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  UINTN Index;
+  UINTN Dropped = This->Dropped;
+  // Report any messages dropped without a staging ring
+  if (Dropped != This->Reported) {
+    LogWriteFormat(This, L"Log: %u messages dropped without a staging ring\n", Dropped - This->Reported);
+    This->Reported = Dropped;
+  }
+  if (This->Rings == NULL) {
+    return;
+  }
+  // Only drain the records reserved before draining started so producers can not keep the drain going forever
+  for (Index = 0; Index < This->RingCount; ++Index) {
+    This->Rings[Index].Limit = This->Rings[Index].Head;
+  }
+  for (;;) {
+    EFI_LOG_RECORD *Oldest = NULL;
+    EFI_LOG_RING   *OldestRing = NULL;
+    // Find the oldest ready record at the tail of each ring
+    for (Index = 0; Index < This->RingCount; ++Index) {
+      EFI_LOG_RING *Ring = This->Rings + Index;
+      while (Ring->Tail != Ring->Limit) {
+        EFI_LOG_RECORD *Record = (EFI_LOG_RECORD *)(Ring->Buffer + (Ring->Tail & (EFI_LOG_RING_SIZE - 1)));
+        UINT32          State = ((VOLATILE EFI_LOG_RECORD *)Record)->State;
+        UINTN           Size;
+        if (State == EFI_LOG_RECORD_READY) {
+          if ((Oldest == NULL) || (Record->TimeStamp < Oldest->TimeStamp)) {
+            Oldest = Record;
+            OldestRing = Ring;
+          }
+        }
+        if (State != EFI_LOG_RECORD_PADDING) {
+          // The record is ready or still being written
+          break;
+        }
+        // Skip the padding, records must be zeroed before the tail passes them so stale states are never seen
+        Size = Record->Size;
+        EfiZeroMem(Record, Size);
+        Ring->Tail += Size;
+      }
+    }
+    if (Oldest == NULL) {
+      break;
+    }
+    // Record or format and output the oldest record then release it
+    LogWriteRecord(This, Oldest->TimeStamp, Oldest->Processor, Oldest->Format, ((VA_LIST)Oldest) + EFI_LOG_ALIGN(sizeof(EFI_LOG_RECORD)));
+    Index = Oldest->Size;
+    EfiZeroMem(Oldest, Index);
+    OldestRing->Tail += Index;
+  }
+  // Report any dropped messages
+  for (Index = 0; Index < This->RingCount; ++Index) {
+    EFI_LOG_RING *Ring = This->Rings + Index;
+    UINTN         Dropped = Ring->Dropped;
+    if (Dropped != Ring->Reported) {
+      LogWriteFormat(This, L"Log: %u messages dropped from processor %u\n", Dropped - Ring->Reported, Index);
+      Ring->Reported = Dropped;
+    }
+  }
+}
+// LogDrain
+/// Drain the staging rings to the log and outputs, must only be called from the boot strap processor
+/// @param This The logging protocol interface
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol
+/// @retval EFI_NOT_READY         The log is already being written by an interrupted caller
+/// @retval EFI_SUCCESS           The staging rings were drained
+STATIC
+EFI_STATUS
+EFIAPI
+LogDrain (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (!LogBeginWrite(This)) {
+    return EFI_NOT_READY;
+  }
+  LogDrainRings(This);
+  LogEndWrite(This);
+  return EFI_SUCCESS;
+}
+// LogDrainNotify
+/// Periodically drain the staging rings
+/// @param Event   The drain timer event
+/// @param Context The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogDrainNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  UNUSED_PARAMETER(Event);
+  LogDrain((EFI_LOG_PROTOCOL_IMPL *)Context);
+}
+// LogExitBootServices
+/// Persist the staged messages and the log file write behind buffer before exiting boot services, then log directly from the boot strap processor
+/// @param ImageHandle The image handle
+/// @param Data        The logging protocol interface
+/// @return EFI_SUCCESS so exiting boot services is never aborted by logging
+STATIC
+EFI_STATUS
+EFIAPI
+LogExitBootServices (
+  IN EFI_HANDLE  ImageHandle,
+  IN VOID       *Data OPTIONAL
+) {
+  EFI_LOG_PROTOCOL_IMPL *This = (EFI_LOG_PROTOCOL_IMPL *)Data;
+  BOOLEAN                Writing;
+  UNUSED_PARAMETER(ImageHandle);
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
+    return EFI_SUCCESS;
+  }
+  // Output the staged messages unless this interrupted a log write, then flush the buffer regardless since this is the last chance
+  Writing = LogBeginWrite(This);
+  if (Writing) {
+    LogDrainRings(This);
+  }
+  // Stop staging messages since the drain timer and the multiprocessor services can not be used after exiting boot services,
+  //  the ring pages are left allocated since freeing them would change the memory map
+  if (This->DrainEvent != NULL) {
+    EfiCloseEvent(This->DrainEvent);
+    This->DrainEvent = NULL;
+  }
+  This->Rings = NULL;
+  This->RingCount = 0;
+  This->RingPages = 0;
+  This->MpServices = NULL;
+  if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
+    LogFileFlush(This);
+    // The file system can not be used after exiting boot services
+    This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+  }
+  This->FileBufferOffset = 0;
+  if (Writing) {
+    LogEndWrite(This);
+  }
+  return EFI_SUCCESS;
+}
+// LogRemoveExitBootServices
+/// Remove the exit boot services callback so it is not called with a freed logging protocol interface
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogRemoveExitBootServices (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  if (This->ExitBootServices) {
+    EfiExitBootServicesRemoveCallback(LogExitBootServices, (VOID *)This);
+    This->ExitBootServices = FALSE;
+  }
+}
+// LogCreateRings
+/// Create a staging ring for every processor and the timer to drain them, must be called from the boot strap processor
+/// @param This The logging protocol interface
+/// @retval EFI_UNSUPPORTED      There are no application processors so no staging rings are needed, or the rings can not be drained before exiting boot services
+/// @retval EFI_OUT_OF_RESOURCES The staging rings could not be allocated
+/// @retval EFI_SUCCESS          The staging rings were created
+STATIC
+EFI_STATUS
+EFIAPI
+LogCreateRings (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  EFI_MP_SERVICES_PROTOCOL *MpServices = NULL;
+  EFI_PHYSICAL_ADDRESS      Address = 0;
+  UINTN                     NumberOfProcessors = 1;
+  UINTN                     NumberOfEnabledProcessors = 1;
+  UINTN                     Bsp = 0;
+  UINTN                     HeaderSize;
+  UINTN                     Pages;
+  UINTN                     Index;
+  EFI_STATUS                Status;
+  // Locate the multiprocessor services protocol to identify the processors
+  if (EFI_ERROR(EfiLocateProtocol(&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices)) || (MpServices == NULL) ||
+      (MpServices->GetNumberOfProcessors == NULL) || (MpServices->WhoAmI == NULL) ||
+      EFI_ERROR(MpServices->GetNumberOfProcessors(MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors)) ||
+      EFI_ERROR(MpServices->WhoAmI(MpServices, &Bsp)) || (NumberOfProcessors <= 1) || (Bsp >= NumberOfProcessors)) {
+    return EFI_UNSUPPORTED;
+  }
+  // Allocate the ring headers followed by the page aligned ring buffers
+  HeaderSize = EFI_PAGES_TO_SIZE(EFI_SIZE_TO_PAGES(NumberOfProcessors * sizeof(EFI_LOG_RING)));
+  Pages = EFI_SIZE_TO_PAGES(HeaderSize + (NumberOfProcessors * EFI_LOG_RING_SIZE));
+#if defined(EFI_MEMORY_VIRTUAL)
+  Status = EfiInternalAllocatePages(Pages, &Address);
+#else
+  Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Pages, &Address);
+#endif
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Address == 0) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  EfiZeroMem((VOID *)(UINTN)Address, EFI_PAGES_TO_SIZE(Pages));
+  This->Rings = (EFI_LOG_RING *)(UINTN)Address;
+  for (Index = 0; Index < NumberOfProcessors; ++Index) {
+    This->Rings[Index].Buffer = ((UINT8 *)(UINTN)Address) + HeaderSize + (Index * EFI_LOG_RING_SIZE);
+  }
+  This->RingCount = NumberOfProcessors;
+  This->RingPages = Pages;
+  This->MpServices = MpServices;
+  This->Bsp = Bsp;
+  // The staged messages must be drained and the multiprocessor services released before exiting boot services, so only stage if that is possible
+  if (!This->ExitBootServices) {
+    This->ExitBootServices = !EFI_ERROR(EfiExitBootServicesCallback(LogExitBootServices, (VOID *)This));
+  }
+  if (!This->ExitBootServices) {
+    EfiFreePages(Address, Pages);
+    This->Rings = NULL;
+    This->RingCount = 0;
+    This->RingPages = 0;
+    This->MpServices = NULL;
+    return EFI_UNSUPPORTED;
+  }
+  // Drain the staging rings periodically while the boot strap processor is idle
+  if (!EFI_ERROR(EfiCreateEvent(EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LogDrainNotify, (VOID *)This, &(This->DrainEvent))) &&
+      EFI_ERROR(EfiSetTimer(This->DrainEvent, TimerPeriodic, EFI_LOG_RING_DRAIN_PERIOD))) {
+    EfiCloseEvent(This->DrainEvent);
+    This->DrainEvent = NULL;
+  }
+  return EFI_SUCCESS;
+}
+// LogFreeRings
+/// Drain then free the staging rings, must be called from the boot strap processor when no other processor logs
+/// @param This The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogFreeRings (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  if (This->DrainEvent != NULL) {
+    EfiCloseEvent(This->DrainEvent);
+    This->DrainEvent = NULL;
+  }
+  if (This->Rings != NULL) {
+    LogDrain(This);
+    EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Rings), This->RingPages);
+    This->Rings = NULL;
+  }
+  This->RingCount = 0;
+  This->RingPages = 0;
+  This->MpServices = NULL;
+}
+
+// LogFlushNotify
+/// Periodically flush the log file write behind buffer
+/// @param Event   The flush timer event
+/// @param Context The logging protocol interface
+STATIC
+VOID
+EFIAPI
+LogFlushNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  EFI_LOG_PROTOCOL_IMPL *This = (EFI_LOG_PROTOCOL_IMPL *)Context;
+  UNUSED_PARAMETER(Event);
+  // Try again on the next period if this interrupted a log write
+  if ((This != NULL) && (This->Signature == EFI_LOG_PROTOCOL_IMPL_SIGNATURE) && LogBeginWrite(This)) {
+    if (EFI_ERROR(LogFileFlush(This))) {
+      This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+    }
+    LogEndWrite(This);
+  }
+}
+// LogFreeFileBuffer
+/// Flush then free the log file write behind buffer, must only be called from the boot strap processor while writing
+/// @param This The logging protocol interface
+/// @return Whether the buffered output was written or not
+STATIC
+EFI_STATUS
+EFIAPI
+LogFreeFileBuffer (
+  IN EFI_LOG_PROTOCOL_IMPL *This
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  if (This->FlushEvent != NULL) {
+    EfiCloseEvent(This->FlushEvent);
+    This->FlushEvent = NULL;
+  }
+  if (This->FileBuffer != NULL) {
+    if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
+      Status = LogFileFlush(This);
+    }
+#if defined(EFI_MEMORY_VIRTUAL)
+    EfiInternalFreePool(This->FileBuffer);
+#else
+    EfiFreePool(This->FileBuffer);
+#endif
+    This->FileBuffer = NULL;
+  }
+  This->FileBufferSize = 0;
+  This->FileBufferOffset = 0;
+  return Status;
+}
+// LogSetFileBuffering
+/// Set the log file write behind buffer size and flush policy, must be called from the boot strap processor
+/// @param This        The logging protocol interface
+/// @param Size        The size in bytes of the write behind buffer or zero to write and flush the log file for every message
+/// @param Policy      The flush policy
+/// @param FlushPeriod The period in milliseconds of the flush timer if the policy includes EFI_LOG_FLUSH_TIMER
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol, or the policy includes EFI_LOG_FLUSH_TIMER and FlushPeriod is zero
+/// @retval EFI_NOT_READY         The log is being written by an interrupted caller
+/// @retval EFI_UNSUPPORTED       The buffer can not be persisted before exiting boot services so the log file is written for every message
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated so the log file is written for every message
+/// @retval EFI_SUCCESS           The log file buffering was set
+STATIC
+EFI_STATUS
+EFIAPI
+LogSetFileBuffering (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Size,
+  IN UINT32                 Policy,
+  IN UINTN                  FlushPeriod
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  // Check parameters
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE) ||
+      (EFI_BITS_ANY_SET(Policy, EFI_LOG_FLUSH_TIMER) && (FlushPeriod == 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (!LogBeginWrite(This)) {
+    return EFI_NOT_READY;
+  }
+  // Persist and free the previous buffer
+  if (EFI_ERROR(LogFreeFileBuffer(This))) {
+    This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
+  }
+  This->FilePolicy = Policy;
+  if ((Size == 0) && (This->Rings == NULL)) {
+    // Nothing remains to be persisted before exiting boot services
+    LogRemoveExitBootServices(This);
+  } else if (Size != 0) {
+    // The buffered tail must be persisted before the operating system loader runs, so only buffer if that is possible
+    if (!This->ExitBootServices) {
+      This->ExitBootServices = !EFI_ERROR(EfiExitBootServicesCallback(LogExitBootServices, (VOID *)This));
     }
-    // Write extra new line if there is already file contents
-    if (!EFI_ERROR(EfiFileGetPosition(*OutputFile, &Offset)) && (Offset != 0)) {
-      UINTN Size = 2 * sizeof(CHAR16);
-      EfiFileWrite(*OutputFile, &Size, (VOID *)L"\r\n");
-      EfiFileFlush(*OutputFile);
+    if (!This->ExitBootServices) {
+      Status = EFI_UNSUPPORTED;
+    } else {
+      // Allocate the buffer
+      This->FileBuffer = (UINT8 *)
+#if defined(EFI_MEMORY_VIRTUAL)
+        EfiInternalAllocate(Size);
+#else
+        EfiAllocate(Size);
+#endif
+      if (This->FileBuffer == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+      } else {
+        This->FileBufferSize = Size;
+        // Flush the buffer periodically
+        if (EFI_BITS_ANY_SET(Policy, EFI_LOG_FLUSH_TIMER) &&
+            !EFI_ERROR(EfiCreateEvent(EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LogFlushNotify, (VOID *)This, &(This->FlushEvent))) &&
+            EFI_ERROR(EfiSetTimer(This->FlushEvent, TimerPeriodic, ((UINT64)FlushPeriod) * 10000))) {
+          EfiCloseEvent(This->FlushEvent);
+          This->FlushEvent = NULL;
+        }
+      }
     }
   }
-  // Return whether output file was opened
+  LogEndWrite(This);
+  return Status;
+}
+// LogSetCapacity
+/// Set the capacity of the log, keeping the newest contents that fit, must be called from the boot strap processor
+/// @param This     The logging protocol interface
+/// @param Capacity The capacity in bytes of the log ring, the oldest contents are overwritten when it is full, or zero for the log to grow without bound
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol
+/// @retval EFI_NOT_READY         The log is being written by an interrupted caller
+/// @retval EFI_OUT_OF_RESOURCES  The log could not be reallocated so the capacity was not changed
+/// @retval EFI_SUCCESS           The log capacity was set
+STATIC
+EFI_STATUS
+EFIAPI
+LogSetCapacity (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN UINTN                  Capacity
+) {
+  EFI_STATUS  Status;
+  CHAR16     *Log;
+  UINTN       Size;
+  UINTN       Previous;
+  UINTN       Length;
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Capacity == This->Capacity) {
+    return EFI_SUCCESS;
+  }
+  if (!LogBeginWrite(This)) {
+    return EFI_NOT_READY;
+  }
+  // Allocate the log lazily if there are no contents yet
+  Log = This->Log;
+  if (Log == NULL) {
+    This->Capacity = Capacity;
+    LogEndWrite(This);
+    return EFI_SUCCESS;
+  }
+  // Make the previous contents contiguous
+  if (This->Capacity != 0) {
+    LogRingLinearize(This);
+  }
+  Size = This->Size;
+  Length = This->Offset - 1;
+  Previous = This->Capacity;
+  // Allocate the new log
+  This->Capacity = Capacity;
+  This->Log = NULL;
+  Status = LogAllocate(This, Length);
+  if (EFI_ERROR(Status)) {
+    This->Log = Log;
+    This->Size = Size;
+    This->Capacity = Previous;
+    LogEndWrite(This);
+    return Status;
+  }
+  // Copy the previous contents, a ring keeps only the newest that fit
+  if (Capacity != 0) {
+    LogRingAppend(This, Log + 1, Length);
+  } else {
+    EfiCopyArray(CHAR16, This->Log + 1, Log + 1, Length);
+    This->Offset = Length + 1;
+    This->Log[This->Offset] = 0;
+  }
+  EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)Log, EFI_SIZE_TO_PAGES(Size * sizeof(CHAR16)));
+  LogEndWrite(This);
   return EFI_SUCCESS;
 }
-// OutputFilePrint
-/// Output to the log output file
-/// @param OutputFile     On input, the current output file or NULL, on output, the current or opened output file
-/// @param OutputFilePath The output file path
-/// @param Text           The text to print to the output file
-/// @param Size           The size in bytes of the text
+// LogSetBinary
+/// Set whether messages are recorded in the binary log format and formatted only when read or output to a text output, must be called from the boot strap processor
+/// @param This   The logging protocol interface
+/// @param Binary Whether to record messages in the binary log format, the log file is written in the binary log format while enabled
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol
+/// @retval EFI_NOT_READY         The log is being written by an interrupted caller
+/// @retval EFI_SUCCESS           The binary log format was enabled or disabled
 STATIC
 EFI_STATUS
 EFIAPI
-OutputFilePrint (
-  IN OUT EFI_FILE_PROTOCOL **OutputFile,
-  IN OUT CHAR16            **OutputFilePath,
-  IN     CONST CHAR16       *Text,
-  IN     UINTN               Size
+LogSetBinary (
+  IN EFI_LOG_PROTOCOL_IMPL *This,
+  IN BOOLEAN                Binary
 ) {
-  EFI_STATUS Status;
-  // Open the output log file if needed
-  Status = OpenOutputFile(OutputFile, OutputFilePath);
-  if (!EFI_ERROR(Status)) {
-    // Write to the output file
-    Status = EfiFileWrite(*OutputFile, &Size, (VOID *)Text);
-    if (!EFI_ERROR(Status)) {
-      // Flush the output file
-      Status = EfiFileFlush(*OutputFile);
-    }
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
+    return EFI_INVALID_PARAMETER;
   }
-  return Status;
+  Binary = (Binary ? TRUE : FALSE);
+  if (Binary == This->Binary) {
+    return EFI_SUCCESS;
+  }
+  if (!LogBeginWrite(This)) {
+    return EFI_NOT_READY;
+  }
+  // Output the staged messages in the previous format and keep the text of the recorded binary messages
+  LogDrainRings(This);
+  if (This->Binary) {
+    LogBinaryFormat(This);
+  }
+  // Persist the buffered output then close the log file since the format changes
+  if (This->FileBufferOffset != 0) {
+    LogFileFlush(This);
+  }
+  if (This->File != NULL) {
+    EfiFileClose(This->File);
+    This->File = NULL;
+  }
+  LogBinaryReset(This);
+  This->Binary = Binary;
+  LogEndWrite(This);
+  return EFI_SUCCESS;
 }
 
 // LogVLog
-/// Print a formatted character string to log
+/// Print a formatted character string to log, may be called from any processor
 /// @param This   The logging protocol interface
 /// @param Format The format specifier string
 /// @param Marker The arguments to format
-/// @return The number of characters printed
+/// @return The number of characters printed, or the number of characters in the format specifier string if the message was staged
 STATIC
 UINTN
 EFIAPI
@@ -196,107 +2272,31 @@ LogVLog (
   IN CONST CHAR16          *Format,
   IN VA_LIST                Marker
 ) {
-  EFI_STATUS Status = EFI_SUCCESS;
-  UINTN      Size;
+  UINTN Processor;
+  UINTN Count;
   // Check parameters
   if ((This == NULL) || (Format == NULL) || (Marker == NULL) ||
       (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
     return 0;
   }
-  // Check if the log buffer exists
-  if (This->Log == NULL) {
-    EFI_PHYSICAL_ADDRESS Address = NULL;
-    // Allocate the log buffer with the default size
-    This->Offset = 1;
-    This->Size = (EFI_PAGES_TO_SIZE(EFI_LOG_DEFAULT_PAGE_COUNT) / sizeof(CHAR16));
-#if defined(EFI_MEMORY_VIRTUAL)
-    Status = EfiInternalAllocatePages(EFI_LOG_DEFAULT_PAGE_COUNT, &Address);
-#else
-    Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, EFI_LOG_DEFAULT_PAGE_COUNT, &Address);
-#endif
-    if (EFI_ERROR(Status)) {
-      return 0;
-    }
-    // Set the new buffer
-    This->Log = (CHAR16 *)(UINTN)Address;
-    if (This->Log == NULL) {
-      // Failed to allocate the pages for log!
-      return 0;
-    }
-    // Start the log with a UTF-16 byte order mark
-    *(This->Log) = L'\xFEFF';
-  }
-  // Get the remaining size of the log buffer
-  Size = (This->Size - This->Offset) * sizeof(CHAR16);
-  // Attempt to print to the log buffer
-  Status = EfiVSPrint(This->Log + This->Offset, &Size, Format, Marker);
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    EFI_PHYSICAL_ADDRESS Address = NULL;
-    // Get the new page count needed
-    UINTN Previous = EFI_SIZE_TO_PAGES(This->Size * sizeof(CHAR16));
-    UINTN Count = EFI_SIZE_TO_PAGES(Size);
-    if (Count < EFI_LOG_DEFAULT_PAGE_COUNT) {
-      Count = EFI_LOG_DEFAULT_PAGE_COUNT;
-    }
-    Count += Previous;
-    // Reallocate the log buffer
-#if defined(EFI_MEMORY_VIRTUAL)
-    Status = EfiInternalAllocatePages(Count, &Address);
-#else
-    Status = EfiAllocatePages(AllocateAnyPages, EFI_MEMORY_TYPE_DEFAULT_POOL, Count, &Address);
-#endif
-    if (EFI_ERROR(Status)) {
-      return 0;
-    }
-    // Copy the old buffer to the new
-    EfiCopyArray(CHAR16, (UINTN)Address, This->Log, (This->Offset + 1));
-    // Free the old buffer
-    EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Log), Previous);
-    // Set the new buffer
-    This->Log = (CHAR16 *)(UINTN)Address;
-    This->Size = (EFI_PAGES_TO_SIZE(Count) / sizeof(CHAR16));
-    // Get the new remaining size of the log buffer
-    Size = (This->Size - This->Offset) * sizeof(CHAR16);
-    // Attempt to print to the log buffer again
-    Status = EfiVSPrint(This->Log + This->Offset, &Size, Format, Marker);
-  }
-  if (EFI_ERROR(Status)) {
-    return 0;
-  }
-  // Check any characters were written
-  if (Size <= sizeof(CHAR16)) {
+  // Identify the calling processor, only the boot strap processor remains after exiting boot services so write directly
+  Processor = This->Bsp;
+  if ((This->MpServices != NULL) && EFI_ERROR(This->MpServices->WhoAmI(This->MpServices, &Processor))) {
     return 0;
   }
-  // Get the count of characters from the size, excluding the null terminator
-  Size /= sizeof(CHAR16);
-  --Size;
-  // Make sure the log has a null terminator
-  This->Log[This->Offset + Size] = 0;
-  // Log to outputs
-  if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_CONSOLE)) {
-    // Log console output
-    if (EFI_ERROR(EfiConOutPrint(This->Log + This->Offset))) {
-      This->Outputs &= ~EFI_LOG_OUTPUT_CONSOLE;
-    }
-  }
-  if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
-    // Log file output
-    if (EFI_ERROR(OutputFilePrint(&(This->File), &(This->Path), This->Log + This->Offset, Size * sizeof(CHAR16)))) {
-      // Disable file output on an error
-      This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
-    }
+  // Application processors can not use boot services so stage the message to be formatted and output by the boot strap processor
+  if (Processor != This->Bsp) {
+    return LogStage(This, Processor, Format, Marker);
   }
-#if !defined(EFI_SERIAL_DISABLE)
-  if (EFI_BITS_ANY_SET(This->Outputs, EFI_LOG_OUTPUT_SERIAL)) {
-    // Log serial output
-    if (EFI_ERROR(EfiSerialStrWriteAll(This->Log + This->Offset))) {
-      This->Outputs &= ~EFI_LOG_OUTPUT_SERIAL;
-    }
+  // Stage the message if this interrupted another log write on the boot strap processor
+  if (!LogBeginWrite(This)) {
+    return LogStage(This, Processor, Format, Marker);
   }
-#endif
-  // Get the count of characters written and advance the offset
-  This->Offset += Size;
-  return Size;
+  // Output the staged messages first since they are older then output this message
+  LogDrainRings(This);
+  Count = LogWriteRecord(This, EfiGetTimeStamp(), Processor, Format, Marker);
+  LogEndWrite(This);
+  return Count;
 }
 // LogVVerbose
 /// Print a formatted character string to log with verbosity
@@ -336,7 +2336,78 @@ EFIAPI
 LogGetContents (
   IN EFI_LOG_PROTOCOL_IMPL *This
 ) {
-  return ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) ? NULL : This->Log;
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
+    return NULL;
+  }
+  // Include any staged messages
+  LogDrain(This);
+  if (LogBeginWrite(This)) {
+    // Format the recorded binary messages
+    if (This->Binary) {
+      LogBinaryFormat(This);
+    }
+    // Make the log ring contiguous
+    if ((This->Log != NULL) && (This->Capacity != 0)) {
+      LogRingLinearize(This);
+    }
+    LogEndWrite(This);
+  }
+  return This->Log;
+}
+// LogGetSpans
+/// Get the log contents as up to two spans without copying or rearranging the log, the spans are not null terminated
+/// @param This         The logging protocol interface
+/// @param First        On output, the oldest part of the log contents, not including the byte order mark
+/// @param FirstLength  On output, the count of characters of the first span
+/// @param Second       On output, the newest part of the log contents if the log ring wrapped, otherwise NULL
+/// @param SecondLength On output, the count of characters of the second span
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol or First, FirstLength, Second, or SecondLength is NULL
+/// @retval EFI_NOT_FOUND         The log is empty
+/// @retval EFI_SUCCESS           The log spans were returned
+STATIC
+EFI_STATUS
+EFIAPI
+LogGetSpans (
+  IN  EFI_LOG_PROTOCOL_IMPL  *This,
+  OUT CONST CHAR16          **First,
+  OUT UINTN                  *FirstLength,
+  OUT CONST CHAR16          **Second,
+  OUT UINTN                  *SecondLength
+) {
+  UINTN Capacity;
+  if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE) ||
+      (First == NULL) || (FirstLength == NULL) || (Second == NULL) || (SecondLength == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Include any staged messages and format the recorded binary messages
+  LogDrain(This);
+  if (This->Binary && LogBeginWrite(This)) {
+    LogBinaryFormat(This);
+    LogEndWrite(This);
+  }
+  *Second = NULL;
+  *SecondLength = 0;
+  if (This->Log == NULL) {
+    *First = NULL;
+    *FirstLength = 0;
+    return EFI_NOT_FOUND;
+  }
+  *First = This->Log + 1;
+  if (This->Capacity == 0) {
+    *FirstLength = This->Offset - 1;
+    return EFI_SUCCESS;
+  }
+  // The ring may wrap around to the start
+  Capacity = This->Size - 2;
+  *First += This->RingStart;
+  if ((This->RingStart + This->RingLength) > Capacity) {
+    *FirstLength = Capacity - This->RingStart;
+    *Second = This->Log + 1;
+    *SecondLength = This->RingLength - *FirstLength;
+  } else {
+    *FirstLength = This->RingLength;
+  }
+  return EFI_SUCCESS;
 }
 // LogClear
 /// Clear the log contents
@@ -352,6 +2423,17 @@ LogClear (
       EfiFreePages((EFI_PHYSICAL_ADDRESS)(UINTN)(This->Log), EFI_SIZE_TO_PAGES(This->Size * sizeof(CHAR16)));
       This->Log = NULL;
     }
+    LogFreeFileBuffer(This);
+    LogBinaryReset(This);
+    if (This->Scratch != NULL) {
+#if defined(EFI_MEMORY_VIRTUAL)
+      EfiInternalFreePool(This->Scratch);
+#else
+      EfiFreePool(This->Scratch);
+#endif
+      This->Scratch = NULL;
+    }
+    This->ScratchSize = 0;
     if (This->File != NULL) {
       EfiFileClose(This->File);
       This->File = NULL;
@@ -362,6 +2444,8 @@ LogClear (
     }
     This->Size = 0;
     This->Offset = 0;
+    This->RingStart = 0;
+    This->RingLength = 0;
     This->Outputs = EFI_LOG_OUTPUT_DEFAULT;
     This->Verbosity = EFI_LOG_VERBOSITY_DEFAULT;
   }
@@ -396,6 +2480,17 @@ LogSetOutputs (
   }
   // Check if flushing or just changing outputs
   if (Flush) {
+    // Include any staged messages, format the recorded binary messages, and make the log ring contiguous
+    LogDrain(This);
+    if (LogBeginWrite(This)) {
+      if (This->Binary) {
+        LogBinaryFormat(This);
+      }
+      if ((This->Log != NULL) && (This->Capacity != 0)) {
+        LogRingLinearize(This);
+      }
+      LogEndWrite(This);
+    }
     // Flush the outputs, there should be more than one character as the first should be the byte order mark
     if ((This->Log != NULL) && (This->Offset > 1)) {
       // Always flush the console even if already an active output
@@ -405,8 +2500,22 @@ LogSetOutputs (
       }
       // Only flush to file if not already an active output
       if (EFI_BITS_ANY_SET(Outputs, EFI_LOG_OUTPUT_FILE)) {
-        // Flush file output
-        if (EFI_ERROR(OutputFilePrint(&(This->File), &(This->Path), This->Log, This->Offset * sizeof(CHAR16)))) {
+        if (This->Binary) {
+          // Flush the binary log records, which start a new log file session that defines every recorded format
+          if ((This->Records != NULL) && LogBeginWrite(This)) {
+            LogFileFlush(This);
+            if (EFI_ERROR(OutputFilePrint(&(This->File), &(This->Path), (CONST CHAR16 *)(This->Records), This->RecordsOffset, TRUE))) {
+              Outputs &= ~EFI_LOG_OUTPUT_FILE;
+            } else {
+              UINTN Index;
+              for (Index = 0; Index < This->FormatCount; ++Index) {
+                This->Formats[Index].Written = TRUE;
+              }
+              This->FileSession = TRUE;
+            }
+            LogEndWrite(This);
+          }
+        } else if (EFI_ERROR(OutputFilePrint(&(This->File), &(This->Path), This->Log, This->Offset * sizeof(CHAR16), FALSE))) {
           // Disable file output on an error
           Outputs &= ~EFI_LOG_OUTPUT_FILE;
         }
@@ -423,7 +2532,7 @@ LogSetOutputs (
     }
   } else if (EFI_BITS_ANY_SET(Outputs, EFI_LOG_OUTPUT_FILE)) {
     // Open the output log file if needed
-    if (EFI_ERROR(OpenOutputFile(&(This->File), &(This->Path)))) {
+    if (EFI_ERROR(OpenOutputFile(&(This->File), &(This->Path), This->Binary))) {
       Outputs &= ~EFI_LOG_OUTPUT_FILE;
     }
   }
@@ -447,9 +2556,12 @@ LogGetFile (
   return This->Path;
 }
 // LogSetFile
-/// Set the log output file path
+/// Set the log output file path, must be called from the boot strap processor
 /// @param This    The logging protocol interface
 /// @param LogPath The log output file path
+/// @retval EFI_INVALID_PARAMETER If This is NULL or not a valid logging protocol
+/// @retval EFI_NOT_READY         The log is being written by an interrupted caller
+/// @retval EFI_SUCCESS           The log output file path was set
 STATIC
 EFI_STATUS
 EFIAPI
@@ -462,6 +2574,14 @@ LogSetFile (
   if ((This == NULL) || (This->Signature != EFI_LOG_PROTOCOL_IMPL_SIGNATURE)) {
     return EFI_INVALID_PARAMETER;
   }
+  // The buffered output and the output file must not change while the log is being written
+  if (!LogBeginWrite(This)) {
+    return EFI_NOT_READY;
+  }
+  // Persist the buffered output to the previous output file
+  if (This->FileBufferOffset != 0) {
+    LogFileFlush(This);
+  }
   // Free old output file path if any
   if (This->Path != NULL) {
     EfiFreePool(This->Path);
@@ -473,16 +2593,20 @@ LogSetFile (
     EfiFileClose(This->File);
     This->File = NULL;
   }
+  // The next output file starts a new binary log session
+  LogBinaryFileReset(This);
   // Do not attempt to open file if output not enable
   if (EFI_BITS_ARE_UNSET(This->Outputs, EFI_LOG_OUTPUT_FILE)) {
+    LogEndWrite(This);
     return EFI_SUCCESS;
   }
   // Attempt to open output file
-  Status = OpenOutputFile(&(This->File), &(This->Path));
+  Status = OpenOutputFile(&(This->File), &(This->Path), This->Binary);
   if (EFI_ERROR(Status)) {
     // Disable the log file if something failed
     This->Outputs &= ~EFI_LOG_OUTPUT_FILE;
   }
+  LogEndWrite(This);
   return Status;
 }
 // LogGetVerbosity
@@ -524,11 +2648,16 @@ GetLogProtocol (
 ) {
   EFI_LOG_PROTOCOL *Log = NULL;
   // Check if there is already a logging protocol
+  // Use the cached logging protocol, which must be used from application processors
+  if (mLogProtocol != NULL) {
+    return mLogProtocol;
+  }
   if (EFI_ERROR(EfiLocateProtocol(&gEfiLogProtocolGuid, NULL, (VOID **)&Log))) {
     // Logging protocol not found
     return NULL;
   }
   // Return the logging protocol interface
+  mLogProtocol = Log;
   return Log;
 }
 
@@ -568,19 +2697,60 @@ EfiLogInstall (
   Impl->Protocol.SetFile = (EFI_LOG_SET_FILE)LogSetFile;
   Impl->Protocol.GetVerbosity = (EFI_LOG_GET_VERBOSITY)LogGetVerbosity;
   Impl->Protocol.SetVerbosity = (EFI_LOG_SET_VERBOSITY)LogSetVerbosity;
+  Impl->Protocol.Drain = (EFI_LOG_DRAIN)LogDrain;
+  Impl->Protocol.SetFileBuffering = (EFI_LOG_SET_FILE_BUFFERING)LogSetFileBuffering;
+  Impl->Protocol.GetSpans = (EFI_LOG_GET_SPANS)LogGetSpans;
+  Impl->Protocol.SetCapacity = (EFI_LOG_SET_CAPACITY)LogSetCapacity;
+  Impl->Protocol.SetBinary = (EFI_LOG_SET_BINARY)LogSetBinary;
   // Setup the logging protocol implementation interface
   Impl->Signature = EFI_LOG_PROTOCOL_IMPL_SIGNATURE;
   Impl->Log = NULL;
   Impl->Offset = 0;
   Impl->Size = 0;
+  Impl->Capacity = 0;
+  Impl->RingStart = 0;
+  Impl->RingLength = 0;
+  Impl->Scratch = NULL;
+  Impl->ScratchSize = 0;
   Impl->File = NULL;
   Impl->Path = NULL;
   Impl->Outputs = EFI_LOG_OUTPUT_DEFAULT;
   Impl->Verbosity = EFI_LOG_VERBOSITY_DEFAULT;
+  Impl->MpServices = NULL;
+  Impl->Bsp = 0;
+  Impl->Rings = NULL;
+  Impl->RingCount = 0;
+  Impl->RingPages = 0;
+  Impl->DrainEvent = NULL;
+  Impl->Writing = FALSE;
+  Impl->Dropped = 0;
+  Impl->Reported = 0;
+  Impl->FileBuffer = NULL;
+  Impl->FileBufferSize = 0;
+  Impl->FileBufferOffset = 0;
+  Impl->FilePolicy = EFI_LOG_FLUSH_FULL;
+  Impl->FlushEvent = NULL;
+  Impl->ExitBootServices = FALSE;
+  Impl->Binary = FALSE;
+  Impl->FileSession = FALSE;
+  Impl->Records = NULL;
+  Impl->RecordsSize = 0;
+  Impl->RecordsOffset = 0;
+  Impl->RecordsFormatted = 0;
+  Impl->Formats = NULL;
+  Impl->FormatCount = 0;
+  Impl->FormatCapacity = 0;
+  Impl->FormatSlots = NULL;
+  // Create the staging rings so any processor may log, without them only the boot strap processor may log
+  LogCreateRings(Impl);
   // Install the logging protocol
   Status = EfiInstallProtocolInterface(&gEfiImageHandle, &gEfiLogProtocolGuid, EFI_NATIVE_INTERFACE, (VOID *)Impl);
-  if (EFI_ERROR(Status)) {
+  if (!EFI_ERROR(Status)) {
+    mLogProtocol = &(Impl->Protocol);
+  } else {
     // Free the logging protocol interface since there was an error
+    LogFreeRings(Impl);
+    LogRemoveExitBootServices(Impl);
 #if defined(EFI_MEMORY_VIRTUAL)
     EfiInternalFreePool(Impl);
 #else
@@ -605,6 +2775,12 @@ EfiLogUninstall (
   }
   // Uninstall the protocol
   EfiUninstallProtocolInterface(gEfiImageHandle, &gEfiLogProtocolGuid, (VOID *)Log);
+  mLogProtocol = NULL;
+  // Free the staging rings and remove the exit boot services callback before the interface is freed
+  if (((EFI_LOG_PROTOCOL_IMPL *)Log)->Signature == EFI_LOG_PROTOCOL_IMPL_SIGNATURE) {
+    LogFreeRings((EFI_LOG_PROTOCOL_IMPL *)Log);
+    LogRemoveExitBootServices((EFI_LOG_PROTOCOL_IMPL *)Log);
+  }
   // Clear the protocol contents
   if (Log->Clear != NULL) {
     Log->Clear(Log);
@@ -689,6 +2865,23 @@ EfiVVerbose (
   return Log->VVerbose(Log, Verbosity, Format, Marker);
 }
 
+// EfiLogDrain
+/// Output the messages staged by application processors or interrupted log writes, must be called from the boot strap processor
+/// @retval EFI_NOT_FOUND The logging protocol was not found
+/// @retval EFI_NOT_READY The log is already being written by an interrupted caller
+/// @retval EFI_SUCCESS   The staged messages were output
+EFI_STATUS
+EFIAPI
+EfiLogDrain (
+  VOID
+) {
+  EFI_LOG_PROTOCOL *Log = GetLogProtocol();
+  if ((Log == NULL) || (Log->Drain == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return Log->Drain(Log);
+}
+
 // EfiLogGetContents
 /// Get the log contents
 /// @return The log contents
@@ -703,6 +2896,29 @@ EfiLogGetContents (
   }
   return Log->GetContents(Log);
 }
+// EfiLogGetSpans
+/// Get the log contents as up to two spans without copying or rearranging the log, the spans are not null terminated
+/// @param First        On output, the oldest part of the log contents, not including the byte order mark
+/// @param FirstLength  On output, the count of characters of the first span
+/// @param Second       On output, the newest part of the log contents if the log ring wrapped, otherwise NULL
+/// @param SecondLength On output, the count of characters of the second span
+/// @retval EFI_INVALID_PARAMETER If First, FirstLength, Second, or SecondLength is NULL
+/// @retval EFI_NOT_FOUND         The logging protocol was not found or the log is empty
+/// @retval EFI_SUCCESS           The log spans were returned
+EFI_STATUS
+EFIAPI
+EfiLogGetSpans (
+  OUT CONST CHAR16 **First,
+  OUT UINTN         *FirstLength,
+  OUT CONST CHAR16 **Second,
+  OUT UINTN         *SecondLength
+) {
+  EFI_LOG_PROTOCOL *Log = GetLogProtocol();
+  if ((Log == NULL) || (Log->GetSpans == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return Log->GetSpans(Log, First, FirstLength, Second, SecondLength);
+}
 
 // EfiLogClear
 /// Clear the log contents
@@ -768,6 +2984,106 @@ EfiLogSetOutputs (
   return Log->SetOutputs(Log, Outputs, Flush);
 }
 
+// EfiLogSetFileBuffering
+/// Set the log file write behind buffer size and flush policy
+/// @param Size        The size in bytes of the write behind buffer or zero to write and flush the log file for every message
+/// @param Policy      The flush policy
+/// @param FlushPeriod The period in milliseconds of the flush timer if the policy includes EFI_LOG_FLUSH_TIMER
+/// @retval EFI_NOT_FOUND         The logging protocol was not found
+/// @retval EFI_INVALID_PARAMETER The policy includes EFI_LOG_FLUSH_TIMER and FlushPeriod is zero
+/// @retval EFI_UNSUPPORTED       The buffer can not be persisted before exiting boot services so the log file is written for every message
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated so the log file is written for every message
+/// @retval EFI_SUCCESS           The log file buffering was set
+EFI_STATUS
+EFIAPI
+EfiLogSetFileBuffering (
+  IN UINTN  Size,
+  IN UINT32 Policy,
+  IN UINTN  FlushPeriod
+) {
+  EFI_LOG_PROTOCOL *Log = GetLogProtocol();
+  if ((Log == NULL) || (Log->SetFileBuffering == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return Log->SetFileBuffering(Log, Size, Policy, FlushPeriod);
+}
+// EfiLogSetDefaultFileBuffering
+/// Set the log file write behind buffer size and flush policy from the configuration
+/// @return The status of setting the log file buffering
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultFileBuffering (
+  VOID
+) {
+  UINT32 Policy = EFI_LOG_FLUSH_FULL;
+  UINTN  Size = (UINTN)EfiConfigurationGetUnsigned(L"/Boot/Output/FileBuffer", EFI_LOG_FILE_BUFFER_DEFAULT_SIZE);
+  UINTN  FlushPeriod = (UINTN)EfiConfigurationGetUnsigned(L"/Boot/Output/FileFlushPeriod", EFI_LOG_FILE_FLUSH_DEFAULT_PERIOD);
+  if (FlushPeriod != 0) {
+    Policy |= EFI_LOG_FLUSH_TIMER;
+  }
+  if (EfiConfigurationGetBoolean(L"/Boot/Output/FileFlushOnError", TRUE)) {
+    Policy |= EFI_LOG_FLUSH_ERROR;
+  }
+  return EfiLogSetFileBuffering(Size, Policy, FlushPeriod);
+}
+
+// EfiLogSetCapacity
+/// Set the capacity of the log, keeping the newest contents that fit
+/// @param Capacity The capacity in bytes of the log ring, the oldest contents are overwritten when it is full, or zero for the log to grow without bound
+/// @retval EFI_NOT_FOUND        The logging protocol was not found
+/// @retval EFI_NOT_READY        The log is being written by an interrupted caller
+/// @retval EFI_OUT_OF_RESOURCES The log could not be reallocated so the capacity was not changed
+/// @retval EFI_SUCCESS          The log capacity was set
+EFI_STATUS
+EFIAPI
+EfiLogSetCapacity (
+  IN UINTN Capacity
+) {
+  EFI_LOG_PROTOCOL *Log = GetLogProtocol();
+  if ((Log == NULL) || (Log->SetCapacity == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return Log->SetCapacity(Log, Capacity);
+}
+// EfiLogSetDefaultCapacity
+/// Set the capacity of the log from the configuration
+/// @return The status of setting the log capacity
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultCapacity (
+  VOID
+) {
+  return EfiLogSetCapacity((UINTN)EfiConfigurationGetUnsigned(L"/Boot/Output/Capacity", 0));
+}
+
+// EfiLogSetBinary
+/// Set whether messages are recorded in the binary log format and formatted only when read or output to a text output
+/// @param Binary Whether to record messages in the binary log format, the log file is written in the binary log format while enabled
+/// @retval EFI_NOT_FOUND The logging protocol was not found
+/// @retval EFI_NOT_READY The log is being written by an interrupted caller
+/// @retval EFI_SUCCESS   The binary log format was enabled or disabled
+EFI_STATUS
+EFIAPI
+EfiLogSetBinary (
+  IN BOOLEAN Binary
+) {
+  EFI_LOG_PROTOCOL *Log = GetLogProtocol();
+  if ((Log == NULL) || (Log->SetBinary == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return Log->SetBinary(Log, Binary);
+}
+// EfiLogSetDefaultBinary
+/// Set whether messages are recorded in the binary log format from the configuration
+/// @return The status of setting the binary log format
+EFI_STATUS
+EFIAPI
+EfiLogSetDefaultBinary (
+  VOID
+) {
+  return EfiLogSetBinary(EfiConfigurationGetBoolean(L"/Boot/Output/Binary", FALSE));
+}
+
 // EfiLogGetFile
 /// Get the log output file path
 /// @return The log output file path
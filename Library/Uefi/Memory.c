@@ -759,6 +759,224 @@ EfiByteSwapMemoryDescriptor (
   return EFI_SUCCESS;
 }
 
+// EFI_MEMORY_MAP_SORT_RUN
+/// The number of descriptors in each run that is sorted before the runs are merged
+#define EFI_MEMORY_MAP_SORT_RUN 32
+// EFI_MEMORY_MAP_PARALLEL_COUNT
+/// The minimum number of descriptors to sort in parallel, smaller memory maps are sorted on this processor only
+#define EFI_MEMORY_MAP_PARALLEL_COUNT 512
+
+// EFI_MEMORY_MAP_SORT
+/// Memory map sort context
+typedef struct EFI_MEMORY_MAP_SORT EFI_MEMORY_MAP_SORT;
+struct EFI_MEMORY_MAP_SORT {
+
+  // Memory
+  /// The memory map descriptors
+  UINT8 *Memory;
+  // Count
+  /// The count of memory map descriptors
+  UINTN  Count;
+  // DescriptorSize
+  /// The size in bytes of an individual memory map descriptor
+  UINTN  DescriptorSize;
+  // Width
+  /// The count of descriptors in each sorted run being merged
+  UINTN  Width;
+
+};
+
+// MemoryMapSortDescriptor
+/// Get a memory map descriptor by index
+/// @param Sort  The memory map sort context
+/// @param Index The index of the descriptor
+/// @return The memory map descriptor
+#define MemoryMapSortDescriptor(Sort, Index) ((EFI_MEMORY_DESCRIPTOR *)((Sort)->Memory + ((Index) * (Sort)->DescriptorSize)))
+
+// MemoryMapSortSwap
+/// Swap a memory map descriptor with the descriptor before it, without boot services so it is safe on any processor
+/// @param Sort  The memory map sort context
+/// @param Index The index of the descriptor, which must not be zero
+STATIC
+VOID
+EFIAPI
+MemoryMapSortSwap (
+  IN EFI_MEMORY_MAP_SORT *Sort,
+  IN UINTN                Index
+) {
+  UINT8 *This2 = (UINT8 *)MemoryMapSortDescriptor(Sort, Index);
+  UINT8 *This1 = This2 - Sort->DescriptorSize;
+  UINTN  Size = Sort->DescriptorSize;
+  UINT8  Byte;
+  while (Size-- != 0) {
+    Byte = *This1;
+    *This1++ = *This2;
+    *This2++ = Byte;
+  }
+}
+// MemoryMapSortCopy
+/// Copy memory map descriptors, without boot services so it is safe on any processor
+/// @param Destination The destination of the copy, which must not overlap the source after the destination
+/// @param Source      The source of the copy
+/// @param Size        The size in bytes to copy
+STATIC
+VOID
+EFIAPI
+MemoryMapSortCopy (
+  OUT UINT8       *Destination,
+  IN  CONST UINT8 *Source,
+  IN  UINTN        Size
+) {
+  while (Size-- != 0) {
+    *Destination++ = *Source++;
+  }
+}
+// MemoryMapSortRuns
+/// Insertion sort runs of memory map descriptors by physical address
+/// @param Begin   The first run to sort
+/// @param End     The run after the last run to sort
+/// @param Context The memory map sort context
+STATIC
+VOID
+EFIAPI
+MemoryMapSortRuns (
+  IN UINTN  Begin,
+  IN UINTN  End,
+  IN VOID  *Context
+) {
+  EFI_MEMORY_MAP_SORT *Sort = (EFI_MEMORY_MAP_SORT *)Context;
+  UINTN                First;
+  UINTN                Last;
+  UINTN                Index;
+  UINTN                Position;
+  for (; Begin < End; ++Begin) {
+    First = Begin * EFI_MEMORY_MAP_SORT_RUN;
+    Last = ((Sort->Count - First) > EFI_MEMORY_MAP_SORT_RUN) ? (First + EFI_MEMORY_MAP_SORT_RUN) : Sort->Count;
+    for (Index = First + 1; Index < Last; ++Index) {
+      // Move the descriptor down until it is after a descriptor with a lower or equal address
+      for (Position = Index; (Position > First) &&
+           (MemoryMapSortDescriptor(Sort, Position - 1)->PhysicalStart > MemoryMapSortDescriptor(Sort, Position)->PhysicalStart); --Position) {
+        MemoryMapSortSwap(Sort, Position);
+      }
+    }
+  }
+}
+// MemoryMapMergeRuns
+/// Merge pairs of adjacent sorted runs of memory map descriptors in place
+/// @param Begin   The first pair of runs to merge
+/// @param End     The pair after the last pair of runs to merge
+/// @param Context The memory map sort context
+STATIC
+VOID
+EFIAPI
+MemoryMapMergeRuns (
+  IN UINTN  Begin,
+  IN UINTN  End,
+  IN VOID  *Context
+) {
+  EFI_MEMORY_MAP_SORT *Sort = (EFI_MEMORY_MAP_SORT *)Context;
+  UINT8               *Scratch;
+  UINT8               *Output;
+  UINTN                Left;
+  UINTN                Right;
+  UINTN                Last;
+  UINTN                Position;
+  UINTN                Size;
+  for (; Begin < End; ++Begin) {
+    Left = Begin * 2 * Sort->Width;
+    Right = Left + Sort->Width;
+    if (Right >= Sort->Count) {
+      continue;
+    }
+    Last = ((Sort->Count - Right) > Sort->Width) ? (Right + Sort->Width) : Sort->Count;
+    // Firmware memory maps are mostly sorted so the runs are often already in order
+    if (MemoryMapSortDescriptor(Sort, Right - 1)->PhysicalStart <= MemoryMapSortDescriptor(Sort, Right)->PhysicalStart) {
+      continue;
+    }
+    // Skip the left descriptors that are already before the right run
+    while (MemoryMapSortDescriptor(Sort, Left)->PhysicalStart <= MemoryMapSortDescriptor(Sort, Right)->PhysicalStart) {
+      ++Left;
+    }
+    // Merge through a copy of the rest of the left run from the allocation cache of this processor if it is small enough
+    Size = (Right - Left) * Sort->DescriptorSize;
+    Scratch = (Size <= EFI_CPU_POOL_MAXIMUM_SIZE) ? (UINT8 *)EfiCpuPoolAllocate(Size) : NULL;
+    if (Scratch != NULL) {
+      MemoryMapSortCopy(Scratch, (CONST UINT8 *)MemoryMapSortDescriptor(Sort, Left), Size);
+      Output = (UINT8 *)MemoryMapSortDescriptor(Sort, Left);
+      Position = 0;
+      while ((Position < Size) && (Right < Last)) {
+        // Take the left descriptor first when the addresses are equal so the sort is stable
+        if (((EFI_MEMORY_DESCRIPTOR *)(Scratch + Position))->PhysicalStart <= MemoryMapSortDescriptor(Sort, Right)->PhysicalStart) {
+          MemoryMapSortCopy(Output, Scratch + Position, Sort->DescriptorSize);
+          Position += Sort->DescriptorSize;
+        } else {
+          MemoryMapSortCopy(Output, (CONST UINT8 *)MemoryMapSortDescriptor(Sort, Right), Sort->DescriptorSize);
+          ++Right;
+        }
+        Output += Sort->DescriptorSize;
+      }
+      // Copy the rest of the left run, the rest of the right run is already in place
+      MemoryMapSortCopy(Output, Scratch + Position, Size - Position);
+      EfiCpuPoolFree(Scratch);
+      continue;
+    }
+    while ((Left < Right) && (Right < Last)) {
+      if (MemoryMapSortDescriptor(Sort, Left)->PhysicalStart > MemoryMapSortDescriptor(Sort, Right)->PhysicalStart) {
+        // Move the right descriptor down before the left descriptor
+        for (Position = Right; Position > Left; --Position) {
+          MemoryMapSortSwap(Sort, Position);
+        }
+        ++Right;
+      }
+      ++Left;
+    }
+  }
+}
+// EfiSortMemoryMap
+/// Sort memory descriptors by physical address, large memory maps are sorted in parallel
+/// @param MemoryMap      The memory map descriptors
+/// @param MemoryMapSize  The size in bytes of the memory map descriptors
+/// @param DescriptorSize The size in bytes of an individual memory map descriptor
+/// @retval EFI_INVALID_PARAMETER If MemoryMap is NULL
+/// @retval EFI_INVALID_PARAMETER If MemoryMapSize or DescriptorSize is zero
+/// @retval EFI_INVALID_PARAMETER If MemoryMapSize < DescriptorSize
+/// @retval EFI_SUCCESS           The descriptors were sorted, descriptors with equal addresses remain in the same order
+EFI_STATUS
+EFIAPI
+EfiSortMemoryMap (
+  IN EFI_MEMORY_DESCRIPTOR *MemoryMap,
+  IN UINTN                  MemoryMapSize,
+  IN UINTN                  DescriptorSize
+) {
+  EFI_MEMORY_MAP_SORT Sort;
+  UINTN               Count;
+  // Check parameters
+  if ((MemoryMap == NULL) || (MemoryMapSize == 0) || (DescriptorSize == 0) || (MemoryMapSize < DescriptorSize)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Sort.Memory = (UINT8 *)MemoryMap;
+  Sort.Count = MemoryMapSize / DescriptorSize;
+  Sort.DescriptorSize = DescriptorSize;
+  Sort.Width = EFI_MEMORY_MAP_SORT_RUN;
+  // Sort each run then merge pairs of runs until there is one run, each pass is independent so it can run in parallel
+  Count = (Sort.Count + EFI_MEMORY_MAP_SORT_RUN - 1) / EFI_MEMORY_MAP_SORT_RUN;
+  if (Sort.Count < EFI_MEMORY_MAP_PARALLEL_COUNT) {
+    MemoryMapSortRuns(0, Count, (VOID *)&Sort);
+  } else {
+    EfiParallelFor(0, Count, 1, MemoryMapSortRuns, (VOID *)&Sort);
+  }
+  while (Sort.Width < Sort.Count) {
+    Count = (Sort.Count + (2 * Sort.Width) - 1) / (2 * Sort.Width);
+    if (Sort.Count < EFI_MEMORY_MAP_PARALLEL_COUNT) {
+      MemoryMapMergeRuns(0, Count, (VOID *)&Sort);
+    } else {
+      EfiParallelFor(0, Count, 1, MemoryMapMergeRuns, (VOID *)&Sort);
+    }
+    Sort.Width *= 2;
+  }
+  return EFI_SUCCESS;
+}
+
 // EfiCopyMem
 /// Copy the contents of one buffer to another buffer
 /// @param Destination The destination buffer of the memory copy
@@ -771,10 +989,8 @@ EfiCopyMem (
   IN CONST VOID *Source,
   IN UINTN       Length
 ) {
-  if ((gEfiBootServices != NULL) &&
-      (gEfiBootServices->Hdr.Revision >= EFI_1_10_SYSTEM_TABLE_REVISION) &&
-      (gEfiBootServices->CopyMem != NULL) && (Length != 0)) {
-    gEfiBootServices->CopyMem(Destination, (VOID *)Source, Length);
+  if ((Destination != NULL) && (Source != NULL) && (Length != 0)) {
+    EfiDispatch()->CopyMem(Destination, Source, Length);
   }
 }
 // EfiSetMem
@@ -789,11 +1005,8 @@ EfiSetMem (
   IN UINTN  Size,
   IN UINT8  Value
 ) {
-  if ((gEfiBootServices != NULL) &&
-      (gEfiBootServices->Hdr.Revision >= EFI_1_10_SYSTEM_TABLE_REVISION) &&
-      (gEfiBootServices->SetMem != NULL) &&
-      (Buffer != NULL) && (Size != 0)) {
-    gEfiBootServices->SetMem(Buffer, Size, Value);
+  if ((Buffer != NULL) && (Size != 0)) {
+    EfiDispatch()->SetMem(Buffer, Size, Value);
   }
 }
 // EfiZeroMem
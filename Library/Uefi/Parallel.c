@@ -0,0 +1,703 @@
+///
+/// @file Library/Uefi/Parallel.c
+///
+/// UEFI data parallel helpers
+///
+
+#include <Uefi.h>
+
+#include <Uefi/Protocol/MpService.h>
+
+// EFI_PARALLEL_SLOT_HEADER_SIZE
+/// The size in bytes of a result slot header, the result follows the header
+#define EFI_PARALLEL_SLOT_HEADER_SIZE 16
+
+// EFI_PARALLEL_BENCHMARK_ITERATIONS
+/// The number of times to repeat each benchmark measurement
+#define EFI_PARALLEL_BENCHMARK_ITERATIONS 4
+
+// EFI_PARALLEL_JOB
+/// A parallel job shared by every processor that executes it
+typedef struct EFI_PARALLEL_JOB EFI_PARALLEL_JOB;
+struct EFI_PARALLEL_JOB {
+
+  // Body
+  /// The loop body or NULL for a map
+  EFI_PARALLEL_BODY  Body;
+  // Map
+  /// The map or NULL for a loop body
+  EFI_PARALLEL_MAP   Map;
+  // Context
+  /// The context to pass to the loop body or map
+  VOID              *Context;
+  // Begin
+  /// The first index of the range
+  UINTN              Begin;
+  // End
+  /// The index after the last index of the range
+  UINTN              End;
+  // Grain
+  /// The number of indices in each chunk
+  UINTN              Grain;
+  // Chunks
+  /// The number of chunks in the range
+  UINTN              Chunks;
+  // Workers
+  /// The maximum number of processors that may execute the job
+  UINTN              Workers;
+  // Static
+  /// Whether each chunk has its own result slot
+  BOOLEAN            Static;
+  // Slots
+  /// The cache line aligned result slots for a map
+  UINT8             *Slots;
+  // SlotSize
+  /// The size in bytes of each result slot
+  UINTN              SlotSize;
+  // NextWorker
+  /// The next worker index to claim
+  VOLATILE UINTN     NextWorker;
+  // NextChunk
+  /// The next chunk index to claim
+  VOLATILE UINTN     NextChunk;
+
+};
+
+// EFI_PARALLEL_SLOT
+/// A result slot header
+typedef struct EFI_PARALLEL_SLOT EFI_PARALLEL_SLOT;
+struct EFI_PARALLEL_SLOT {
+
+  // Used
+  /// Whether a chunk was mapped into this slot
+  UINTN Used;
+
+};
+
+// EFI_PARALLEL_CRC32
+/// The partial result of a parallel CRC
+typedef struct EFI_PARALLEL_CRC32 EFI_PARALLEL_CRC32;
+struct EFI_PARALLEL_CRC32 {
+
+  // Crc32
+  /// The CRC of the mapped data
+  UINT32 Crc32;
+  // Size
+  /// The size in bytes of the mapped data
+  UINTN  Size;
+
+};
+
+// EFI_PARALLEL_CRC32_CONTEXT
+/// The context of a parallel CRC
+typedef struct EFI_PARALLEL_CRC32_CONTEXT EFI_PARALLEL_CRC32_CONTEXT;
+struct EFI_PARALLEL_CRC32_CONTEXT {
+
+  // Kernel
+  /// The CRC kernel selected on the boot strap processor
+  EFI_DISPATCH_CRC32  Kernel;
+  // Data
+  /// The buffer on which the CRC is computed
+  CONST UINT8        *Data;
+
+};
+
+// mParallelMpServices
+/// The multiprocessor services protocol
+STATIC EFI_MP_SERVICES_PROTOCOL *mParallelMpServices = NULL;
+// mParallelEvent
+/// The event signaled when the application processors finish a job
+STATIC EFI_EVENT mParallelEvent = NULL;
+// mParallelProcessors
+/// The number of enabled processors, including the boot strap processor
+STATIC UINTN mParallelProcessors = 1;
+// mParallelLimit
+/// The maximum number of processors to use or zero for all enabled processors
+STATIC UINTN mParallelLimit = 0;
+// mParallelBusy
+/// Whether the application processors are executing a job
+STATIC VOLATILE UINT32 mParallelBusy = FALSE;
+// mParallelBsp
+/// The processor number of the boot strap processor
+STATIC UINTN mParallelBsp = 0;
+// mParallelSerialLogged
+/// Whether a job running serially because the application processors could not be started was logged
+STATIC BOOLEAN mParallelSerialLogged = FALSE;
+
+// ParallelIncrement
+/// Atomically increment a counter
+/// @param Value The counter to increment
+/// @return The value of the counter before it was incremented
+STATIC
+UINTN
+EFIAPI
+ParallelIncrement (
+  IN OUT VOLATILE UINTN *Value
+) {
+  UINTN Current;
+  do {
+    Current = *Value;
+  } while ((UINTN)EfiCompareAndExchange((UINTN *)Value, Current, Current + 1) != Current);
+  return Current;
+}
+// ParallelWorker
+/// Execute chunks of a job until there are none left
+/// @param Job    The job to execute
+/// @param Worker The worker index of this processor
+STATIC
+VOID
+EFIAPI
+ParallelWorker (
+  IN EFI_PARALLEL_JOB *Job,
+  IN UINTN             Worker
+) {
+  UINTN  Chunk;
+  UINTN  Begin;
+  UINTN  End;
+  UINT8 *Slot;
+  // Claim chunks until the range is finished
+  while ((Chunk = ParallelIncrement(&(Job->NextChunk))) < Job->Chunks) {
+    Begin = Job->Begin + (Chunk * Job->Grain);
+    End = ((Job->End - Begin) > Job->Grain) ? (Begin + Job->Grain) : Job->End;
+    if (Job->Map != NULL) {
+      // Map into the slot for the chunk or this worker
+      Slot = Job->Slots + ((Job->Static ? Chunk : Worker) * Job->SlotSize);
+      ((EFI_PARALLEL_SLOT *)Slot)->Used = TRUE;
+      Job->Map(Begin, End, Job->Context, (VOID *)(Slot + EFI_PARALLEL_SLOT_HEADER_SIZE));
+    } else {
+      Job->Body(Begin, End, Job->Context);
+    }
+  }
+}
+// ParallelProcedure
+/// Application processor procedure for a job
+/// @param ProcedureArgument The job to execute
+STATIC
+VOID
+EFIAPI
+ParallelProcedure (
+  IN VOID *ProcedureArgument
+) {
+  EFI_PARALLEL_JOB *Job = (EFI_PARALLEL_JOB *)ProcedureArgument;
+  UINTN             Worker;
+  // Limit the number of processors executing the job, the boot strap processor is always worker zero
+  Worker = ParallelIncrement(&(Job->NextWorker));
+  if (Worker < Job->Workers) {
+    ParallelWorker(Job, Worker);
+  }
+}
+// ParallelCanStart
+/// Check whether the application processors can be started from the current task priority level
+/// @return Whether the application processors can be started
+STATIC
+BOOLEAN
+EFIAPI
+ParallelCanStart (
+  VOID
+) {
+  // The completion event is signaled from a notification so it can not be waited on at notify level or above
+  EFI_TPL OldTpl = EfiRaiseTPL(TPL_HIGH_LEVEL);
+  EfiRestoreTPL(OldTpl);
+  return (OldTpl < TPL_NOTIFY);
+}
+// ParallelSetup
+/// Setup the scheduling of a job
+/// @param Job   The job to setup
+/// @param Begin The first index of the range
+/// @param End   The index after the last index of the range
+/// @param Grain The number of indices in each dynamically scheduled chunk or EFI_PARALLEL_GRAIN_STATIC for one chunk per processor
+STATIC
+VOID
+EFIAPI
+ParallelSetup (
+  OUT EFI_PARALLEL_JOB *Job,
+  IN  UINTN             Begin,
+  IN  UINTN             End,
+  IN  UINTN             Grain
+) {
+  UINTN Count = End - Begin;
+  EfiZeroMem((VOID *)Job, sizeof(EFI_PARALLEL_JOB));
+  Job->Begin = Begin;
+  Job->End = End;
+  Job->Workers = EfiParallelGetProcessorCount();
+  if (Job->Workers > Count) {
+    Job->Workers = (Count != 0) ? Count : 1;
+  }
+  Job->Static = (Grain == EFI_PARALLEL_GRAIN_STATIC);
+  if (Job->Static) {
+    // One contiguous chunk for each processor
+    Grain = (Count + Job->Workers - 1) / Job->Workers;
+  }
+  Job->Grain = (Grain != 0) ? Grain : 1;
+  Job->Chunks = (Count + Job->Grain - 1) / Job->Grain;
+}
+// ParallelRun
+/// Execute a job on the boot strap processor and, if they are available, the application processors
+/// @param Job The job to execute
+STATIC
+VOID
+EFIAPI
+ParallelRun (
+  IN EFI_PARALLEL_JOB *Job
+) {
+  EFI_STATUS Status = EFI_ALREADY_STARTED;
+  BOOLEAN    Started = FALSE;
+  // This processor is worker zero so the application processors claim the other worker indices
+  Job->NextWorker = 1;
+  // Start the application processors if there is more than one chunk and they are not already busy
+  if ((Job->Workers > 1) && (Job->Chunks > 1) && EfiParallelIsAvailable() && ParallelCanStart()) {
+    if (EfiCompareAndExchange32((UINT32 *)&mParallelBusy, FALSE, TRUE) == FALSE) {
+      Status = mParallelMpServices->StartupAllAPs(mParallelMpServices, ParallelProcedure, FALSE, mParallelEvent, 0, (VOID *)Job, NULL);
+      Started = !EFI_ERROR(Status);
+      if (!Started) {
+        EfiStore32((UINT32 *)&mParallelBusy, FALSE);
+      }
+    }
+    if (!Started && !mParallelSerialLogged) {
+      // The application processors are busy with a job or another procedure, such as a thread started on one of them
+      mParallelSerialLogged = TRUE;
+      LOG(L"Parallel: application processors could not be started, running serially: %r\n", Status);
+    }
+  }
+  // Execute chunks on this processor while the application processors claim their share, which executes every chunk if they were not started
+  ParallelWorker(Job, 0);
+  if (Started) {
+    // Every chunk is claimed so wait for the application processors to finish the chunks they claimed
+    while (EfiCheckEvent(mParallelEvent) == EFI_NOT_READY) {
+      EfiCpuPause();
+    }
+    EfiStore32((UINT32 *)&mParallelBusy, FALSE);
+  }
+}
+
+// ParallelExitBootServices
+/// Stop using the application processors when exiting boot services since the multiprocessor services are no longer available
+/// @param ImageHandle The image handle
+/// @param Data        Unused
+/// @return EFI_SUCCESS so exiting boot services is never aborted
+STATIC
+EFI_STATUS
+EFIAPI
+ParallelExitBootServices (
+  IN EFI_HANDLE  ImageHandle,
+  IN VOID       *Data OPTIONAL
+) {
+  UNUSED_PARAMETER(ImageHandle);
+  UNUSED_PARAMETER(Data);
+  mParallelMpServices = NULL;
+  return EFI_SUCCESS;
+}
+
+// EfiParallelInitialize
+/// Initialize the parallel helpers, must be called from the boot strap processor before any parallel execution is possible
+/// @retval EFI_UNSUPPORTED There are no application processors so parallel helpers will run on the boot strap processor only
+/// @retval EFI_SUCCESS     The parallel helpers were initialized
+EFI_STATUS
+EFIAPI
+EfiParallelInitialize (
+  VOID
+) {
+  EFI_MP_SERVICES_PROTOCOL *MpServices = NULL;
+  UINTN                     NumberOfProcessors = 1;
+  UINTN                     NumberOfEnabledProcessors = 1;
+  UINTN                     Bsp = 0;
+  if (mParallelEvent == NULL) {
+    // Locate the multiprocessor services protocol
+    if (EFI_ERROR(EfiLocateProtocol(&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices)) || (MpServices == NULL) ||
+        (MpServices->GetNumberOfProcessors == NULL) || (MpServices->StartupAllAPs == NULL) || (MpServices->WhoAmI == NULL) ||
+        EFI_ERROR(MpServices->GetNumberOfProcessors(MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors)) ||
+        EFI_ERROR(MpServices->WhoAmI(MpServices, &Bsp)) || (NumberOfEnabledProcessors <= 1)) {
+      LOG(L"Parallel processors: 1\n");
+      return EFI_UNSUPPORTED;
+    }
+    // Create the completion event once so parallel jobs never allocate
+    if (EFI_ERROR(EfiCreateEvent(0, TPL_CALLBACK, NULL, NULL, &mParallelEvent))) {
+      mParallelEvent = NULL;
+      LOG(L"Parallel processors: 1\n");
+      return EFI_UNSUPPORTED;
+    }
+    mParallelMpServices = MpServices;
+    mParallelProcessors = NumberOfEnabledProcessors;
+    mParallelBsp = Bsp;
+    // Stop starting the application processors once boot services are exited
+    EfiExitBootServicesCallback(ParallelExitBootServices, NULL);
+  }
+  // Get the configured processor limit
+  EfiParallelSetProcessorLimit((UINTN)EfiConfigurationGetUnsigned(L"/Parallel/Processors", 0));
+  LOG(L"Parallel processors: %u of %u enabled\n", EfiParallelGetProcessorCount(), mParallelProcessors);
+  return EFI_SUCCESS;
+}
+
+// EfiParallelIsAvailable
+/// Check whether the application processors can be used, which is only from the boot strap processor while boot services are available
+/// @return Whether the application processors can be used
+BOOLEAN
+EFIAPI
+EfiParallelIsAvailable (
+  VOID
+) {
+  EFI_MP_SERVICES_PROTOCOL *MpServices = mParallelMpServices;
+  UINTN                     Processor = 0;
+  if ((MpServices == NULL) || (mParallelEvent == NULL)) {
+    return FALSE;
+  }
+  return (!EFI_ERROR(MpServices->WhoAmI(MpServices, &Processor)) && (Processor == mParallelBsp));
+}
+// EfiParallelGetProcessorCount
+/// Get the number of processors used for parallel execution
+/// @return The number of processors, including the boot strap processor, used for parallel execution
+UINTN
+EFIAPI
+EfiParallelGetProcessorCount (
+  VOID
+) {
+  if ((mParallelLimit != 0) && (mParallelLimit < mParallelProcessors)) {
+    return mParallelLimit;
+  }
+  return mParallelProcessors;
+}
+// EfiParallelSetProcessorLimit
+/// Set the maximum number of processors used for parallel execution
+/// @param Limit The maximum number of processors, including the boot strap processor, or zero for all enabled processors
+/// @return The number of processors that will be used for parallel execution
+UINTN
+EFIAPI
+EfiParallelSetProcessorLimit (
+  IN UINTN Limit
+) {
+  mParallelLimit = Limit;
+  return EfiParallelGetProcessorCount();
+}
+
+// EfiParallelFor
+/// Execute a loop body over a range on the boot strap processor and all enabled application processors
+/// @param Begin   The first index of the range
+/// @param End     The index after the last index of the range
+/// @param Grain   The number of indices in each dynamically scheduled chunk or EFI_PARALLEL_GRAIN_STATIC for one chunk per processor
+/// @param Body    The loop body to call for each chunk
+/// @param Context The context to pass to the loop body
+/// @retval EFI_INVALID_PARAMETER If Body is NULL or End is less than Begin
+/// @retval EFI_SUCCESS           The loop body was called for every chunk of the range
+EFI_STATUS
+EFIAPI
+EfiParallelFor (
+  IN UINTN              Begin,
+  IN UINTN              End,
+  IN UINTN              Grain,
+  IN EFI_PARALLEL_BODY  Body,
+  IN VOID              *Context OPTIONAL
+) {
+  EFI_PARALLEL_JOB Job;
+  if ((Body == NULL) || (End < Begin)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Begin == End) {
+    return EFI_SUCCESS;
+  }
+  // Setup and run the job
+  ParallelSetup(&Job, Begin, End, Grain);
+  Job.Body = Body;
+  Job.Context = Context;
+  ParallelRun(&Job);
+  return EFI_SUCCESS;
+}
+// EfiParallelMapReduce
+/// Map chunks of a range into per processor cache line aligned result slots then reduce the slots into a result
+/// @param Begin      The first index of the range
+/// @param End        The index after the last index of the range
+/// @param Grain      The number of indices in each dynamically scheduled chunk or EFI_PARALLEL_GRAIN_STATIC for one chunk per processor,
+///                    with static scheduling the slots are reduced in range order so the reduction may be order dependent
+/// @param Map        The map to call for each chunk
+/// @param Reduce     The reduce to call for each used slot
+/// @param ResultSize The size in bytes of a result
+/// @param Result     On input, the initial result, on output, the initial result combined with every partial result
+/// @param Context    The context to pass to the map and reduce
+/// @retval EFI_INVALID_PARAMETER If Map, Reduce, or Result is NULL, ResultSize is zero, or End is less than Begin
+/// @retval EFI_OUT_OF_RESOURCES  The result slots could not be allocated
+/// @retval EFI_SUCCESS           The result was reduced from every chunk of the range
+EFI_STATUS
+EFIAPI
+EfiParallelMapReduce (
+  IN     UINTN                Begin,
+  IN     UINTN                End,
+  IN     UINTN                Grain,
+  IN     EFI_PARALLEL_MAP     Map,
+  IN     EFI_PARALLEL_REDUCE  Reduce,
+  IN     UINTN                ResultSize,
+  IN OUT VOID                *Result,
+  IN     VOID                *Context OPTIONAL
+) {
+  EFI_PARALLEL_JOB  Job;
+  VOID             *Buffer;
+  UINTN             Count;
+  UINTN             Index;
+  UINT8            *Slot;
+  if ((Map == NULL) || (Reduce == NULL) || (Result == NULL) || (ResultSize == 0) || (End < Begin)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Begin == End) {
+    return EFI_SUCCESS;
+  }
+  // Setup the job
+  ParallelSetup(&Job, Begin, End, Grain);
+  Job.Map = Map;
+  Job.Context = Context;
+  // Allocate a cache line aligned slot for each chunk or each worker so no two processors write the same cache line
+  Count = Job.Static ? Job.Chunks : Job.Workers;
+  Job.SlotSize = (EFI_PARALLEL_SLOT_HEADER_SIZE + ResultSize + (EFI_PARALLEL_CACHE_LINE_SIZE - 1)) & ~((UINTN)(EFI_PARALLEL_CACHE_LINE_SIZE - 1));
+  Buffer = EfiAllocate((Count * Job.SlotSize) + EFI_PARALLEL_CACHE_LINE_SIZE);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  EfiZeroMem(Buffer, (Count * Job.SlotSize) + EFI_PARALLEL_CACHE_LINE_SIZE);
+  Job.Slots = (UINT8 *)((((UINTN)Buffer) + (EFI_PARALLEL_CACHE_LINE_SIZE - 1)) & ~((UINTN)(EFI_PARALLEL_CACHE_LINE_SIZE - 1)));
+  // Run the job
+  ParallelRun(&Job);
+  // Reduce the used slots in order
+  for (Index = 0; Index < Count; ++Index) {
+    Slot = Job.Slots + (Index * Job.SlotSize);
+    if (((EFI_PARALLEL_SLOT *)Slot)->Used) {
+      Reduce(Result, (CONST VOID *)(Slot + EFI_PARALLEL_SLOT_HEADER_SIZE), Context);
+    }
+  }
+  EfiFreePool(Buffer);
+  return EFI_SUCCESS;
+}
+
+// Crc32MatrixTimes
+/// Multiply a vector by a 32x32 matrix over GF(2)
+/// @param Matrix The matrix
+/// @param Vector The vector
+/// @return The product
+STATIC
+UINT32
+EFIAPI
+Crc32MatrixTimes (
+  IN CONST UINT32 *Matrix,
+  IN UINT32        Vector
+) {
+  UINT32 Sum = 0;
+  while (Vector != 0) {
+    if ((Vector & 1) != 0) {
+      Sum ^= *Matrix;
+    }
+    Vector >>= 1;
+    ++Matrix;
+  }
+  return Sum;
+}
+// Crc32MatrixSquare
+/// Square a 32x32 matrix over GF(2)
+/// @param Square On output, the square of the matrix
+/// @param Matrix The matrix
+STATIC
+VOID
+EFIAPI
+Crc32MatrixSquare (
+  OUT UINT32       *Square,
+  IN  CONST UINT32 *Matrix
+) {
+  UINTN Index;
+  for (Index = 0; Index < 32; ++Index) {
+    Square[Index] = Crc32MatrixTimes(Matrix, Matrix[Index]);
+  }
+}
+// EfiCrc32Combine
+/// Combine two 32-bit CRCs as if the data were contiguous
+/// @param Crc1  The CRC of the first data
+/// @param Crc2  The CRC of the second data
+/// @param Size2 The size in bytes of the second data
+/// @return The CRC of the first data followed by the second data
+UINT32
+EFIAPI
+EfiCrc32Combine (
+  IN UINT32 Crc1,
+  IN UINT32 Crc2,
+  IN UINTN  Size2
+) {
+  UINT32 Even[32];
+  UINT32 Odd[32];
+  UINT32 Row;
+  UINTN  Index;
+  if (Size2 == 0) {
+    return Crc1;
+  }
+  // The operator for one zero bit
+  Odd[0] = 0xEDB88320;
+  Row = 1;
+  for (Index = 1; Index < 32; ++Index) {
+    Odd[Index] = Row;
+    Row <<= 1;
+  }
+  // The operators for two and four zero bits
+  Crc32MatrixSquare(Even, Odd);
+  Crc32MatrixSquare(Odd, Even);
+  // Apply Size2 zero bytes to the first CRC by squaring the operator for each bit of the size
+  do {
+    Crc32MatrixSquare(Even, Odd);
+    if ((Size2 & 1) != 0) {
+      Crc1 = Crc32MatrixTimes(Even, Crc1);
+    }
+    Size2 >>= 1;
+    if (Size2 == 0) {
+      break;
+    }
+    Crc32MatrixSquare(Odd, Even);
+    if ((Size2 & 1) != 0) {
+      Crc1 = Crc32MatrixTimes(Odd, Crc1);
+    }
+    Size2 >>= 1;
+  } while (Size2 != 0);
+  return Crc1 ^ Crc2;
+}
+// ParallelCrc32Map
+/// Compute the CRC of a chunk of a buffer
+/// @param Begin   The offset of the chunk
+/// @param End     The offset after the chunk
+/// @param Context The parallel CRC context
+/// @param Result  On input, the CRC of the previous chunks of the slot, on output, the CRC including this chunk
+STATIC
+VOID
+EFIAPI
+ParallelCrc32Map (
+  IN     UINTN  Begin,
+  IN     UINTN  End,
+  IN     VOID  *Context,
+  IN OUT VOID  *Result
+) {
+  EFI_PARALLEL_CRC32_CONTEXT *Crc32Context = (EFI_PARALLEL_CRC32_CONTEXT *)Context;
+  EFI_PARALLEL_CRC32         *Partial = (EFI_PARALLEL_CRC32 *)Result;
+  Partial->Crc32 = Crc32Context->Kernel(Partial->Crc32, Crc32Context->Data + Begin, End - Begin);
+  Partial->Size += (End - Begin);
+}
+// ParallelCrc32Reduce
+/// Combine the CRC of a slot into the CRC of the preceding data
+/// @param Result  On input, the CRC of the preceding data, on output, the CRC including the slot
+/// @param Partial The CRC of the slot
+/// @param Context The parallel CRC context
+STATIC
+VOID
+EFIAPI
+ParallelCrc32Reduce (
+  IN OUT VOID       *Result,
+  IN     CONST VOID *Partial,
+  IN     VOID       *Context
+) {
+  EFI_PARALLEL_CRC32       *Crc32 = (EFI_PARALLEL_CRC32 *)Result;
+  CONST EFI_PARALLEL_CRC32 *Slot = (CONST EFI_PARALLEL_CRC32 *)Partial;
+  UNUSED_PARAMETER(Context);
+  Crc32->Crc32 = EfiCrc32Combine(Crc32->Crc32, Slot->Crc32, Slot->Size);
+  Crc32->Size += Slot->Size;
+}
+// ParallelCrc32
+/// Compute a 32-bit CRC of a buffer by splitting it across processors regardless of size
+/// @param Crc32 The CRC of the preceding data or zero to start a new CRC
+/// @param Data  The buffer on which the CRC is to be computed
+/// @param Size  The size in bytes of the buffer
+/// @return The CRC of the preceding data and the buffer
+STATIC
+UINT32
+EFIAPI
+ParallelCrc32 (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+) {
+  EFI_PARALLEL_CRC32_CONTEXT Context;
+  EFI_PARALLEL_CRC32         Result;
+  // Select the kernel and build any tables it uses on this processor before the application processors use it
+  Context.Kernel = EfiDispatch()->Crc32;
+  Context.Data = (CONST UINT8 *)Data;
+  Context.Kernel(0, NULL, 0);
+  // Static scheduling keeps one contiguous chunk per slot so the slots combine in order
+  Result.Crc32 = Crc32;
+  Result.Size = 0;
+  if (EFI_ERROR(EfiParallelMapReduce(0, Size, EFI_PARALLEL_GRAIN_STATIC, ParallelCrc32Map, ParallelCrc32Reduce, sizeof(Result), (VOID *)&Result, (VOID *)&Context))) {
+    return Context.Kernel(Crc32, Data, Size);
+  }
+  return Result.Crc32;
+}
+// EfiParallelCrc32
+/// Compute a 32-bit CRC of a buffer by splitting it across processors and combining the partial CRCs
+/// @param Crc32 The CRC of the preceding data or zero to start a new CRC
+/// @param Data  The buffer on which the CRC is to be computed
+/// @param Size  The size in bytes of the buffer
+/// @return The CRC of the preceding data and the buffer
+UINT32
+EFIAPI
+EfiParallelCrc32 (
+  IN UINT32      Crc32,
+  IN CONST VOID *Data,
+  IN UINTN       Size
+) {
+  // Small buffers are not worth starting the application processors
+  if ((Size < EFI_PARALLEL_CRC32_MINIMUM) || (EfiParallelGetProcessorCount() <= 1)) {
+    return EfiDispatch()->Crc32(Crc32, Data, Size);
+  }
+  return ParallelCrc32(Crc32, Data, Size);
+}
+
+// EfiParallelBenchmark
+/// Log the time to compute a parallel CRC of a buffer with each number of processors from one to all enabled processors
+/// @param Size The size in bytes of the buffer to use
+/// @retval EFI_INVALID_PARAMETER If Size is zero
+/// @retval EFI_UNSUPPORTED       The time stamp frequency could not be determined
+/// @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated
+/// @retval EFI_SUCCESS           The benchmark was logged
+EFI_STATUS
+EFIAPI
+EfiParallelBenchmark (
+  IN UINTN Size
+) {
+  UINT8  *Buffer;
+  UINTN   Limit;
+  UINTN   Count;
+  UINTN   Index;
+  UINT32  Expected;
+  UINT32  Crc32;
+  UINT64  Start;
+  UINT64  Best;
+  UINT64  Elapsed;
+  UINT64  Serial = 0;
+  if (Size == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (EfiGetTimeStampFrequency() == 0) {
+    return EFI_UNSUPPORTED;
+  }
+  // Fill a buffer with a pattern
+  Buffer = (UINT8 *)EfiAllocate(Size);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  for (Index = 0; Index < Size; ++Index) {
+    Buffer[Index] = (UINT8)((Index * 31) ^ (Index >> 8));
+  }
+  Expected = EfiDispatch()->Crc32(0, Buffer, Size);
+  // Measure with each number of processors
+  Limit = mParallelLimit;
+  LOG(L"Parallel CRC32 benchmark: %u bytes\n", Size);
+  for (Count = 1; Count <= mParallelProcessors; ++Count) {
+    EfiParallelSetProcessorLimit(Count);
+    Best = MAX_UINT64;
+    Crc32 = 0;
+    for (Index = 0; Index < EFI_PARALLEL_BENCHMARK_ITERATIONS; ++Index) {
+      Start = EfiGetTimeStamp();
+      Crc32 = ParallelCrc32(0, Buffer, Size);
+      Elapsed = EfiGetTimeStamp() - Start;
+      if (Elapsed < Best) {
+        Best = Elapsed;
+      }
+    }
+    Elapsed = EfiTimeStampToNanoseconds(Best);
+    if (Count == 1) {
+      Serial = Elapsed;
+    }
+    LOG(L"  %3u processors: %10lu ns, %3lu.%02lux%s\n", Count, Elapsed,
+        (Elapsed != 0) ? (Serial / Elapsed) : 0, (Elapsed != 0) ? (((Serial % Elapsed) * 100) / Elapsed) : 0,
+        (Crc32 == Expected) ? L"" : L" (CRC mismatch)");
+  }
+  EfiParallelSetProcessorLimit(Limit);
+  EfiFreePool(Buffer);
+  return EFI_SUCCESS;
+}
@@ -6,6 +6,8 @@
 
 #include <Uefi.h>
 
+#include "VirtualMemory.h"
+
 // CHAR_FAT_VALID
 /// Bit mask to indicate the validity of character in FAT file name
 #define CHAR_FAT_VALID 0x01
@@ -21,6 +23,9 @@
 // DEFAULT_LANGUAGE
 /// Default language - English
 #define DEFAULT_LANGUAGE "en"
+// STRING_SEARCH_LONG_LENGTH
+/// The length of a sub-string at which a search uses the two-way search instead of the dispatched search
+#define STRING_SEARCH_LONG_LENGTH 32
 
 // CHARACTER_FLAG_NONE
 /// The character has no modifying flags
@@ -46,6 +51,126 @@ struct CHARACTER_RANGE {
 
 };
 
+// GLOB_ELEMENT_LITERAL
+/// A glob pattern element that matches one character ignoring case
+#define GLOB_ELEMENT_LITERAL 0
+// GLOB_ELEMENT_ANY
+/// A glob pattern element that matches any one character
+#define GLOB_ELEMENT_ANY 1
+// GLOB_ELEMENT_SET
+/// A glob pattern element that matches one character from a set of ranges ignoring case
+#define GLOB_ELEMENT_SET 2
+// GLOB_ELEMENT_STAR
+/// A glob pattern element that matches zero or more characters
+#define GLOB_ELEMENT_STAR 3
+// GLOB_ASCII_MASKS
+/// The count of folded characters that have precomputed masks of matching glob pattern elements
+#define GLOB_ASCII_MASKS 128
+// GLOB_STACK_WORDS
+/// The count of glob pattern state words that are matched without allocating
+#define GLOB_STACK_WORDS 4
+// GLOB_CACHE_SIZE
+/// The count of compiled glob patterns kept by MetaiMatch and AsciiMetaiMatch
+#define GLOB_CACHE_SIZE 8
+
+// CASE_MAPPING_PAGE_COUNT
+/// The count of case mapping pages, the first page is the identity page shared by every page without mappings
+#define CASE_MAPPING_PAGE_COUNT 21
+// CASE_TO_UPPER
+/// Convert a basic multilingual plane character to upper case
+#define CASE_TO_UPPER(a) (CHAR16)((a) + mCaseUpperDeltas[mCaseMappingPages[(UINT16)(a) >> 8]][(UINT8)(a)])
+// CASE_TO_LOWER
+/// Convert a basic multilingual plane character to lower case
+#define CASE_TO_LOWER(a) (CHAR16)((a) + mCaseLowerDeltas[mCaseMappingPages[(UINT16)(a) >> 8]][(UINT8)(a)])
+
+// CASE_MAPPING_RANGE
+/// A range of characters that map to another case by adding a delta
+typedef struct CASE_MAPPING_RANGE CASE_MAPPING_RANGE;
+struct CASE_MAPPING_RANGE {
+
+  // Start
+  /// The first character of the range
+  UINT16 Start;
+  // End
+  /// The last character of the range
+  UINT16 End;
+  // Stride
+  /// The distance between mapped characters in the range
+  UINT16 Stride;
+  // Delta
+  /// The delta added to each mapped character in the range, which may be larger than a signed 16-bit integer
+  INT32  Delta;
+
+};
+
+// GLOB_ELEMENT
+/// A compiled glob pattern element
+typedef struct GLOB_ELEMENT GLOB_ELEMENT;
+struct GLOB_ELEMENT {
+
+  // Kind
+  /// The kind of pattern element
+  UINT32 Kind;
+  // Character
+  /// The folded character matched by a literal element
+  UINT32 Character;
+  // RangeStart
+  /// The index of the first range of a set element
+  UINT32 RangeStart;
+  // RangeCount
+  /// The count of ranges of a set element
+  UINT32 RangeCount;
+
+};
+
+// GLOB_RANGE
+/// A range of folded characters in a compiled glob pattern set
+typedef struct GLOB_RANGE GLOB_RANGE;
+struct GLOB_RANGE {
+
+  // Low
+  /// The first folded character of the range
+  UINT32 Low;
+  // High
+  /// The last folded character of the range
+  UINT32 High;
+
+};
+
+// EFI_GLOB
+/// A compiled glob pattern, each bit of the state masks is the count of pattern elements matched
+struct EFI_GLOB {
+
+  // Count
+  /// The count of pattern elements
+  UINTN         Count;
+  // Words
+  /// The count of 64-bit words in each state mask
+  UINTN         Words;
+  // StarMask
+  /// The states that are followed by a star element
+  UINT64       *StarMask;
+  // AsciiMasks
+  /// The states that are followed by an element matching each folded ASCII character
+  UINT64       *AsciiMasks;
+  // Elements
+  /// The pattern elements
+  GLOB_ELEMENT *Elements;
+  // Ranges
+  /// The ranges of all set elements
+  GLOB_RANGE   *Ranges;
+  // Pattern
+  /// A copy of the pattern
+  VOID         *Pattern;
+  // PatternSize
+  /// The size in bytes of the pattern including the null terminator
+  UINTN         PatternSize;
+  // Ascii
+  /// Whether the pattern is an ASCII string or a Unicode string
+  BOOLEAN       Ascii;
+
+};
+
 // gEfiUnicodeCollationProtocolGuid
 /// The unicode collation protocol unique identifier
 EFI_GUID gEfiUnicodeCollationProtocolGuid;
@@ -968,6 +1093,419 @@ STATIC CHARACTER_RANGE mValidCharRanges[] = {
   { 0x0002F800, 0x0002FA1D, CHARACTER_FLAG_PRINTABLE }
 };
 
+// mCaseUpperRanges
+/// The simple upper case mappings of the basic multilingual plane
+STATIC CONST CASE_MAPPING_RANGE mCaseUpperRanges[] = {
+  { 0x0061, 0x007A, 1,    -32 },
+  { 0x00B5, 0x00B5, 1,    743 },
+  { 0x00E0, 0x00F6, 1,    -32 },
+  { 0x00F8, 0x00FE, 1,    -32 },
+  { 0x00FF, 0x00FF, 1,    121 },
+  { 0x0101, 0x012F, 2,     -1 },
+  { 0x0131, 0x0131, 1,   -232 },
+  { 0x0133, 0x0137, 2,     -1 },
+  { 0x013A, 0x0148, 2,     -1 },
+  { 0x014B, 0x0177, 2,     -1 },
+  { 0x017A, 0x017E, 2,     -1 },
+  { 0x017F, 0x017F, 1,   -300 },
+  { 0x0180, 0x0180, 1,    195 },
+  { 0x0183, 0x0185, 2,     -1 },
+  { 0x0188, 0x0188, 1,     -1 },
+  { 0x018C, 0x018C, 1,     -1 },
+  { 0x0192, 0x0192, 1,     -1 },
+  { 0x0195, 0x0195, 1,     97 },
+  { 0x0199, 0x0199, 1,     -1 },
+  { 0x019A, 0x019A, 1,    163 },
+  { 0x019E, 0x019E, 1,    130 },
+  { 0x01A1, 0x01A5, 2,     -1 },
+  { 0x01A8, 0x01A8, 1,     -1 },
+  { 0x01AD, 0x01AD, 1,     -1 },
+  { 0x01B0, 0x01B0, 1,     -1 },
+  { 0x01B4, 0x01B6, 2,     -1 },
+  { 0x01B9, 0x01B9, 1,     -1 },
+  { 0x01BD, 0x01BD, 1,     -1 },
+  { 0x01BF, 0x01BF, 1,     56 },
+  { 0x01C5, 0x01C5, 1,     -1 },
+  { 0x01C6, 0x01C6, 1,     -2 },
+  { 0x01C8, 0x01C8, 1,     -1 },
+  { 0x01C9, 0x01C9, 1,     -2 },
+  { 0x01CB, 0x01CB, 1,     -1 },
+  { 0x01CC, 0x01CC, 1,     -2 },
+  { 0x01CE, 0x01DC, 2,     -1 },
+  { 0x01DD, 0x01DD, 1,    -79 },
+  { 0x01DF, 0x01EF, 2,     -1 },
+  { 0x01F2, 0x01F2, 1,     -1 },
+  { 0x01F3, 0x01F3, 1,     -2 },
+  { 0x01F5, 0x01F5, 1,     -1 },
+  { 0x01F9, 0x021F, 2,     -1 },
+  { 0x0223, 0x0233, 2,     -1 },
+  { 0x023C, 0x023C, 1,     -1 },
+  { 0x023F, 0x0240, 1,  10815 },
+  { 0x0242, 0x0242, 1,     -1 },
+  { 0x0247, 0x024F, 2,     -1 },
+  { 0x0250, 0x0250, 1,  10783 },
+  { 0x0251, 0x0251, 1,  10780 },
+  { 0x0252, 0x0252, 1,  10782 },
+  { 0x0253, 0x0253, 1,   -210 },
+  { 0x0254, 0x0254, 1,   -206 },
+  { 0x0256, 0x0257, 1,   -205 },
+  { 0x0259, 0x0259, 1,   -202 },
+  { 0x025B, 0x025B, 1,   -203 },
+  { 0x025C, 0x025C, 1,  42319 },
+  { 0x0260, 0x0260, 1,   -205 },
+  { 0x0261, 0x0261, 1,  42315 },
+  { 0x0263, 0x0263, 1,   -207 },
+  { 0x0265, 0x0265, 1,  42280 },
+  { 0x0266, 0x0266, 1,  42308 },
+  { 0x0268, 0x0268, 1,   -209 },
+  { 0x0269, 0x0269, 1,   -211 },
+  { 0x026A, 0x026A, 1,  42308 },
+  { 0x026B, 0x026B, 1,  10743 },
+  { 0x026C, 0x026C, 1,  42305 },
+  { 0x026F, 0x026F, 1,   -211 },
+  { 0x0271, 0x0271, 1,  10749 },
+  { 0x0272, 0x0272, 1,   -213 },
+  { 0x0275, 0x0275, 1,   -214 },
+  { 0x027D, 0x027D, 1,  10727 },
+  { 0x0280, 0x0280, 1,   -218 },
+  { 0x0282, 0x0282, 1,  42307 },
+  { 0x0283, 0x0283, 1,   -218 },
+  { 0x0287, 0x0287, 1,  42282 },
+  { 0x0288, 0x0288, 1,   -218 },
+  { 0x0289, 0x0289, 1,    -69 },
+  { 0x028A, 0x028B, 1,   -217 },
+  { 0x028C, 0x028C, 1,    -71 },
+  { 0x0292, 0x0292, 1,   -219 },
+  { 0x029D, 0x029D, 1,  42261 },
+  { 0x029E, 0x029E, 1,  42258 },
+  { 0x0345, 0x0345, 1,     84 },
+  { 0x0371, 0x0373, 2,     -1 },
+  { 0x0377, 0x0377, 1,     -1 },
+  { 0x037B, 0x037D, 1,    130 },
+  { 0x03AC, 0x03AC, 1,    -38 },
+  { 0x03AD, 0x03AF, 1,    -37 },
+  { 0x03B1, 0x03C1, 1,    -32 },
+  { 0x03C2, 0x03C2, 1,    -31 },
+  { 0x03C3, 0x03CB, 1,    -32 },
+  { 0x03CC, 0x03CC, 1,    -64 },
+  { 0x03CD, 0x03CE, 1,    -63 },
+  { 0x03D0, 0x03D0, 1,    -62 },
+  { 0x03D1, 0x03D1, 1,    -57 },
+  { 0x03D5, 0x03D5, 1,    -47 },
+  { 0x03D6, 0x03D6, 1,    -54 },
+  { 0x03D7, 0x03D7, 1,     -8 },
+  { 0x03D9, 0x03EF, 2,     -1 },
+  { 0x03F0, 0x03F0, 1,    -86 },
+  { 0x03F1, 0x03F1, 1,    -80 },
+  { 0x03F2, 0x03F2, 1,      7 },
+  { 0x03F3, 0x03F3, 1,   -116 },
+  { 0x03F5, 0x03F5, 1,    -96 },
+  { 0x03F8, 0x03F8, 1,     -1 },
+  { 0x03FB, 0x03FB, 1,     -1 },
+  { 0x0430, 0x044F, 1,    -32 },
+  { 0x0450, 0x045F, 1,    -80 },
+  { 0x0461, 0x0481, 2,     -1 },
+  { 0x048B, 0x04BF, 2,     -1 },
+  { 0x04C2, 0x04CE, 2,     -1 },
+  { 0x04CF, 0x04CF, 1,    -15 },
+  { 0x04D1, 0x052F, 2,     -1 },
+  { 0x0561, 0x0586, 1,    -48 },
+  { 0x10D0, 0x10FA, 1,   3008 },
+  { 0x10FD, 0x10FF, 1,   3008 },
+  { 0x13F8, 0x13FD, 1,     -8 },
+  { 0x1C80, 0x1C80, 1,  -6254 },
+  { 0x1C81, 0x1C81, 1,  -6253 },
+  { 0x1C82, 0x1C82, 1,  -6244 },
+  { 0x1C83, 0x1C84, 1,  -6242 },
+  { 0x1C85, 0x1C85, 1,  -6243 },
+  { 0x1C86, 0x1C86, 1,  -6236 },
+  { 0x1C87, 0x1C87, 1,  -6181 },
+  { 0x1C88, 0x1C88, 1,  35266 },
+  { 0x1D79, 0x1D79, 1,  35332 },
+  { 0x1D7D, 0x1D7D, 1,   3814 },
+  { 0x1D8E, 0x1D8E, 1,  35384 },
+  { 0x1E01, 0x1E95, 2,     -1 },
+  { 0x1E9B, 0x1E9B, 1,    -59 },
+  { 0x1EA1, 0x1EFF, 2,     -1 },
+  { 0x1F00, 0x1F07, 1,      8 },
+  { 0x1F10, 0x1F15, 1,      8 },
+  { 0x1F20, 0x1F27, 1,      8 },
+  { 0x1F30, 0x1F37, 1,      8 },
+  { 0x1F40, 0x1F45, 1,      8 },
+  { 0x1F51, 0x1F57, 2,      8 },
+  { 0x1F60, 0x1F67, 1,      8 },
+  { 0x1F70, 0x1F71, 1,     74 },
+  { 0x1F72, 0x1F75, 1,     86 },
+  { 0x1F76, 0x1F77, 1,    100 },
+  { 0x1F78, 0x1F79, 1,    128 },
+  { 0x1F7A, 0x1F7B, 1,    112 },
+  { 0x1F7C, 0x1F7D, 1,    126 },
+  { 0x1FB0, 0x1FB1, 1,      8 },
+  { 0x1FBE, 0x1FBE, 1,  -7205 },
+  { 0x1FD0, 0x1FD1, 1,      8 },
+  { 0x1FE0, 0x1FE1, 1,      8 },
+  { 0x1FE5, 0x1FE5, 1,      7 },
+  { 0x214E, 0x214E, 1,    -28 },
+  { 0x2170, 0x217F, 1,    -16 },
+  { 0x2184, 0x2184, 1,     -1 },
+  { 0x24D0, 0x24E9, 1,    -26 },
+  { 0x2C30, 0x2C5F, 1,    -48 },
+  { 0x2C61, 0x2C61, 1,     -1 },
+  { 0x2C65, 0x2C65, 1, -10795 },
+  { 0x2C66, 0x2C66, 1, -10792 },
+  { 0x2C68, 0x2C6C, 2,     -1 },
+  { 0x2C73, 0x2C73, 1,     -1 },
+  { 0x2C76, 0x2C76, 1,     -1 },
+  { 0x2C81, 0x2CE3, 2,     -1 },
+  { 0x2CEC, 0x2CEE, 2,     -1 },
+  { 0x2CF3, 0x2CF3, 1,     -1 },
+  { 0x2D00, 0x2D25, 1,  -7264 },
+  { 0x2D27, 0x2D27, 1,  -7264 },
+  { 0x2D2D, 0x2D2D, 1,  -7264 },
+  { 0xA641, 0xA66D, 2,     -1 },
+  { 0xA681, 0xA69B, 2,     -1 },
+  { 0xA723, 0xA72F, 2,     -1 },
+  { 0xA733, 0xA76F, 2,     -1 },
+  { 0xA77A, 0xA77C, 2,     -1 },
+  { 0xA77F, 0xA787, 2,     -1 },
+  { 0xA78C, 0xA78C, 1,     -1 },
+  { 0xA791, 0xA793, 2,     -1 },
+  { 0xA794, 0xA794, 1,     48 },
+  { 0xA797, 0xA7A9, 2,     -1 },
+  { 0xA7B5, 0xA7C3, 2,     -1 },
+  { 0xA7C8, 0xA7CA, 2,     -1 },
+  { 0xA7D1, 0xA7D1, 1,     -1 },
+  { 0xA7D7, 0xA7D9, 2,     -1 },
+  { 0xA7F6, 0xA7F6, 1,     -1 },
+  { 0xAB53, 0xAB53, 1,   -928 },
+  { 0xAB70, 0xABBF, 1, -38864 },
+  { 0xFF41, 0xFF5A, 1,    -32 }
+};
+// mCaseLowerRanges
+/// The simple lower case mappings of the basic multilingual plane
+STATIC CONST CASE_MAPPING_RANGE mCaseLowerRanges[] = {
+  { 0x0041, 0x005A, 1,     32 },
+  { 0x00C0, 0x00D6, 1,     32 },
+  { 0x00D8, 0x00DE, 1,     32 },
+  { 0x0100, 0x012E, 2,      1 },
+  { 0x0132, 0x0136, 2,      1 },
+  { 0x0139, 0x0147, 2,      1 },
+  { 0x014A, 0x0176, 2,      1 },
+  { 0x0178, 0x0178, 1,   -121 },
+  { 0x0179, 0x017D, 2,      1 },
+  { 0x0181, 0x0181, 1,    210 },
+  { 0x0182, 0x0184, 2,      1 },
+  { 0x0186, 0x0186, 1,    206 },
+  { 0x0187, 0x0187, 1,      1 },
+  { 0x0189, 0x018A, 1,    205 },
+  { 0x018B, 0x018B, 1,      1 },
+  { 0x018E, 0x018E, 1,     79 },
+  { 0x018F, 0x018F, 1,    202 },
+  { 0x0190, 0x0190, 1,    203 },
+  { 0x0191, 0x0191, 1,      1 },
+  { 0x0193, 0x0193, 1,    205 },
+  { 0x0194, 0x0194, 1,    207 },
+  { 0x0196, 0x0196, 1,    211 },
+  { 0x0197, 0x0197, 1,    209 },
+  { 0x0198, 0x0198, 1,      1 },
+  { 0x019C, 0x019C, 1,    211 },
+  { 0x019D, 0x019D, 1,    213 },
+  { 0x019F, 0x019F, 1,    214 },
+  { 0x01A0, 0x01A4, 2,      1 },
+  { 0x01A6, 0x01A6, 1,    218 },
+  { 0x01A7, 0x01A7, 1,      1 },
+  { 0x01A9, 0x01A9, 1,    218 },
+  { 0x01AC, 0x01AC, 1,      1 },
+  { 0x01AE, 0x01AE, 1,    218 },
+  { 0x01AF, 0x01AF, 1,      1 },
+  { 0x01B1, 0x01B2, 1,    217 },
+  { 0x01B3, 0x01B5, 2,      1 },
+  { 0x01B7, 0x01B7, 1,    219 },
+  { 0x01B8, 0x01B8, 1,      1 },
+  { 0x01BC, 0x01BC, 1,      1 },
+  { 0x01C4, 0x01C4, 1,      2 },
+  { 0x01C5, 0x01C5, 1,      1 },
+  { 0x01C7, 0x01C7, 1,      2 },
+  { 0x01C8, 0x01C8, 1,      1 },
+  { 0x01CA, 0x01CA, 1,      2 },
+  { 0x01CB, 0x01DB, 2,      1 },
+  { 0x01DE, 0x01EE, 2,      1 },
+  { 0x01F1, 0x01F1, 1,      2 },
+  { 0x01F2, 0x01F4, 2,      1 },
+  { 0x01F6, 0x01F6, 1,    -97 },
+  { 0x01F7, 0x01F7, 1,    -56 },
+  { 0x01F8, 0x021E, 2,      1 },
+  { 0x0220, 0x0220, 1,   -130 },
+  { 0x0222, 0x0232, 2,      1 },
+  { 0x023A, 0x023A, 1,  10795 },
+  { 0x023B, 0x023B, 1,      1 },
+  { 0x023D, 0x023D, 1,   -163 },
+  { 0x023E, 0x023E, 1,  10792 },
+  { 0x0241, 0x0241, 1,      1 },
+  { 0x0243, 0x0243, 1,   -195 },
+  { 0x0244, 0x0244, 1,     69 },
+  { 0x0245, 0x0245, 1,     71 },
+  { 0x0246, 0x024E, 2,      1 },
+  { 0x0370, 0x0372, 2,      1 },
+  { 0x0376, 0x0376, 1,      1 },
+  { 0x037F, 0x037F, 1,    116 },
+  { 0x0386, 0x0386, 1,     38 },
+  { 0x0388, 0x038A, 1,     37 },
+  { 0x038C, 0x038C, 1,     64 },
+  { 0x038E, 0x038F, 1,     63 },
+  { 0x0391, 0x03A1, 1,     32 },
+  { 0x03A3, 0x03AB, 1,     32 },
+  { 0x03CF, 0x03CF, 1,      8 },
+  { 0x03D8, 0x03EE, 2,      1 },
+  { 0x03F4, 0x03F4, 1,    -60 },
+  { 0x03F7, 0x03F7, 1,      1 },
+  { 0x03F9, 0x03F9, 1,     -7 },
+  { 0x03FA, 0x03FA, 1,      1 },
+  { 0x03FD, 0x03FF, 1,   -130 },
+  { 0x0400, 0x040F, 1,     80 },
+  { 0x0410, 0x042F, 1,     32 },
+  { 0x0460, 0x0480, 2,      1 },
+  { 0x048A, 0x04BE, 2,      1 },
+  { 0x04C0, 0x04C0, 1,     15 },
+  { 0x04C1, 0x04CD, 2,      1 },
+  { 0x04D0, 0x052E, 2,      1 },
+  { 0x0531, 0x0556, 1,     48 },
+  { 0x10A0, 0x10C5, 1,   7264 },
+  { 0x10C7, 0x10C7, 1,   7264 },
+  { 0x10CD, 0x10CD, 1,   7264 },
+  { 0x13A0, 0x13EF, 1,  38864 },
+  { 0x13F0, 0x13F5, 1,      8 },
+  { 0x1C90, 0x1CBA, 1,  -3008 },
+  { 0x1CBD, 0x1CBF, 1,  -3008 },
+  { 0x1E00, 0x1E94, 2,      1 },
+  { 0x1E9E, 0x1E9E, 1,  -7615 },
+  { 0x1EA0, 0x1EFE, 2,      1 },
+  { 0x1F08, 0x1F0F, 1,     -8 },
+  { 0x1F18, 0x1F1D, 1,     -8 },
+  { 0x1F28, 0x1F2F, 1,     -8 },
+  { 0x1F38, 0x1F3F, 1,     -8 },
+  { 0x1F48, 0x1F4D, 1,     -8 },
+  { 0x1F59, 0x1F5F, 2,     -8 },
+  { 0x1F68, 0x1F6F, 1,     -8 },
+  { 0x1F88, 0x1F8F, 1,     -8 },
+  { 0x1F98, 0x1F9F, 1,     -8 },
+  { 0x1FA8, 0x1FAF, 1,     -8 },
+  { 0x1FB8, 0x1FB9, 1,     -8 },
+  { 0x1FBA, 0x1FBB, 1,    -74 },
+  { 0x1FBC, 0x1FBC, 1,     -9 },
+  { 0x1FC8, 0x1FCB, 1,    -86 },
+  { 0x1FCC, 0x1FCC, 1,     -9 },
+  { 0x1FD8, 0x1FD9, 1,     -8 },
+  { 0x1FDA, 0x1FDB, 1,   -100 },
+  { 0x1FE8, 0x1FE9, 1,     -8 },
+  { 0x1FEA, 0x1FEB, 1,   -112 },
+  { 0x1FEC, 0x1FEC, 1,     -7 },
+  { 0x1FF8, 0x1FF9, 1,   -128 },
+  { 0x1FFA, 0x1FFB, 1,   -126 },
+  { 0x1FFC, 0x1FFC, 1,     -9 },
+  { 0x2126, 0x2126, 1,  -7517 },
+  { 0x212A, 0x212A, 1,  -8383 },
+  { 0x212B, 0x212B, 1,  -8262 },
+  { 0x2132, 0x2132, 1,     28 },
+  { 0x2160, 0x216F, 1,     16 },
+  { 0x2183, 0x2183, 1,      1 },
+  { 0x24B6, 0x24CF, 1,     26 },
+  { 0x2C00, 0x2C2F, 1,     48 },
+  { 0x2C60, 0x2C60, 1,      1 },
+  { 0x2C62, 0x2C62, 1, -10743 },
+  { 0x2C63, 0x2C63, 1,  -3814 },
+  { 0x2C64, 0x2C64, 1, -10727 },
+  { 0x2C67, 0x2C6B, 2,      1 },
+  { 0x2C6D, 0x2C6D, 1, -10780 },
+  { 0x2C6E, 0x2C6E, 1, -10749 },
+  { 0x2C6F, 0x2C6F, 1, -10783 },
+  { 0x2C70, 0x2C70, 1, -10782 },
+  { 0x2C72, 0x2C72, 1,      1 },
+  { 0x2C75, 0x2C75, 1,      1 },
+  { 0x2C7E, 0x2C7F, 1, -10815 },
+  { 0x2C80, 0x2CE2, 2,      1 },
+  { 0x2CEB, 0x2CED, 2,      1 },
+  { 0x2CF2, 0x2CF2, 1,      1 },
+  { 0xA640, 0xA66C, 2,      1 },
+  { 0xA680, 0xA69A, 2,      1 },
+  { 0xA722, 0xA72E, 2,      1 },
+  { 0xA732, 0xA76E, 2,      1 },
+  { 0xA779, 0xA77B, 2,      1 },
+  { 0xA77D, 0xA77D, 1, -35332 },
+  { 0xA77E, 0xA786, 2,      1 },
+  { 0xA78B, 0xA78B, 1,      1 },
+  { 0xA78D, 0xA78D, 1, -42280 },
+  { 0xA790, 0xA792, 2,      1 },
+  { 0xA796, 0xA7A8, 2,      1 },
+  { 0xA7AA, 0xA7AA, 1, -42308 },
+  { 0xA7AB, 0xA7AB, 1, -42319 },
+  { 0xA7AC, 0xA7AC, 1, -42315 },
+  { 0xA7AD, 0xA7AD, 1, -42305 },
+  { 0xA7AE, 0xA7AE, 1, -42308 },
+  { 0xA7B0, 0xA7B0, 1, -42258 },
+  { 0xA7B1, 0xA7B1, 1, -42282 },
+  { 0xA7B2, 0xA7B2, 1, -42261 },
+  { 0xA7B3, 0xA7B3, 1,    928 },
+  { 0xA7B4, 0xA7C2, 2,      1 },
+  { 0xA7C4, 0xA7C4, 1,    -48 },
+  { 0xA7C5, 0xA7C5, 1, -42307 },
+  { 0xA7C6, 0xA7C6, 1, -35384 },
+  { 0xA7C7, 0xA7C9, 2,      1 },
+  { 0xA7D0, 0xA7D0, 1,      1 },
+  { 0xA7D6, 0xA7D8, 2,      1 },
+  { 0xA7F5, 0xA7F5, 1,      1 },
+  { 0xFF21, 0xFF3A, 1,     32 }
+};
+// mCaseMappingPages
+/// The case mapping page of each block of 256 characters
+STATIC UINT8  mCaseMappingPages[256];
+// mCaseUpperDeltas
+/// The delta to add to each character of a case mapping page to convert to upper case
+STATIC UINT16 mCaseUpperDeltas[CASE_MAPPING_PAGE_COUNT][256];
+// mCaseLowerDeltas
+/// The delta to add to each character of a case mapping page to convert to lower case
+STATIC UINT16 mCaseLowerDeltas[CASE_MAPPING_PAGE_COUNT][256];
+// mGlobCacheLock
+/// The lock of the compiled glob pattern cache
+STATIC EFI_LOCK  mGlobCacheLock = (EFI_LOCK)EFI_LOCK_RELEASED;
+// mGlobCache
+/// The compiled glob pattern cache ordered from most to least recently used
+STATIC EFI_GLOB *mGlobCache[GLOB_CACHE_SIZE] = { NULL };
+
+// CaseMappingBuild
+/// Fill the case mapping pages with the deltas of case mapping ranges
+/// @param Ranges    The case mapping ranges
+/// @param Count     The count of case mapping ranges
+/// @param Deltas    The case mapping pages of deltas to fill
+/// @param PageCount The count of case mapping pages already assigned to blocks of characters
+/// @return The count of case mapping pages assigned to blocks of characters
+STATIC
+UINTN
+EFIAPI
+CaseMappingBuild (
+  IN     CONST CASE_MAPPING_RANGE *Ranges,
+  IN     UINTN                     Count,
+  IN OUT UINT16                    Deltas[CASE_MAPPING_PAGE_COUNT][256],
+  IN     UINTN                     PageCount
+) {
+  UINTN Index;
+  UINTN Character;
+  UINTN Block;
+  for (Index = 0; Index < Count; ++Index) {
+    for (Character = Ranges[Index].Start; Character <= Ranges[Index].End; Character += Ranges[Index].Stride) {
+      // Assign a page to the block of characters on first use, the identity page is never written
+      Block = (Character >> 8);
+      if (mCaseMappingPages[Block] == 0) {
+        if (PageCount >= CASE_MAPPING_PAGE_COUNT) {
+          continue;
+        }
+        mCaseMappingPages[Block] = (UINT8)PageCount++;
+      }
+      Deltas[mCaseMappingPages[Block]][Character & 0xFF] = (UINT16)Ranges[Index].Delta;
+    }
+  }
+  return PageCount;
+}
 // StringLibInitialize
 /// String  library initialize use
 /// @return Whether the library initialized successfully or not
@@ -1003,6 +1541,9 @@ InternalStringInitialize (
       Index2 = mOtherChars[Index];
       mEngInfoMap[Index2] |= CHAR_FAT_VALID;
     }
+    // Build the case mapping pages of the basic multilingual plane
+    Index = CaseMappingBuild(mCaseUpperRanges, ARRAY_COUNT(mCaseUpperRanges), mCaseUpperDeltas, 1);
+    CaseMappingBuild(mCaseLowerRanges, ARRAY_COUNT(mCaseLowerRanges), mCaseLowerDeltas, Index);
     NotInitialized = FALSE;
   }
 }
@@ -1062,14 +1603,10 @@ EFIAPI
 StrLen (
   CONST CHAR16 *Str
 ) {
-  CONST CHAR16 *Ptr = Str;
   if (Str == NULL) {
     return NULL;
   }
-  while (*Ptr != 0) {
-    ++Ptr;
-  }
-  return Ptr - Str;
+  return EfiDispatch()->StrLen(Str);
 }
 // StrSize
 /// Get the size in bytes of a character string (including the null-terminator)
@@ -1080,12 +1617,10 @@ EFIAPI
 StrSize (
   CONST CHAR16 *Str
 ) {
-  CONST CHAR16 *Ptr = Str;
   if (Str == NULL) {
     return NULL;
   }
-  while (*Ptr++ != 0);
-  return sizeof(CHAR16) * (Ptr - Str);
+  return sizeof(CHAR16) * (EfiDispatch()->StrLen(Str) + 1);
 }
 
 // StrDup
@@ -1166,14 +1701,7 @@ StrCmp (
   } else if (Str2 == NULL) {
     return 1;
   }
-  while (*Str1 != 0) {
-    if (*Str1 != *Str2) {
-      break;
-    }
-    ++Str1;
-    ++Str2;
-  }
-  return *Str1 - *Str2;
+  return EfiDispatch()->StrCmp(Str1, Str2);
 }
 // StrnCmp
 /// Performs a comparison of two strings
@@ -1202,11 +1730,7 @@ StrnCmp (
   } else if (Str2 == NULL) {
     return 1;
   }
-  while ((*Str1 != 0) && (*Str1 == *Str2) && (Count-- > 1)) {
-    ++Str1;
-    ++Str2;
-  }
-  return *Str1 - *Str2;
+  return EfiDispatch()->StrnCmp(Str1, Str2, Count);
 }
 // StriCmp
 /// Performs a case-insensitive comparison of two strings
@@ -1222,6 +1746,7 @@ StriCmp (
   IN CONST CHAR16 *Str2
 ) {
   EFI_UNICODE_COLLATION_PROTOCOL *Protocol;
+  UINTN                           Index;
   if (Str1 == NULL) {
     if (Str2 == NULL) {
       return 0;
@@ -1235,16 +1760,19 @@ StriCmp (
   if ((Protocol != NULL) && (Protocol->StriColl != NULL)) {
     return Protocol->StriColl(Protocol, (CHAR16 *)Str1, (CHAR16 *)Str2);
   }
-  // Fallback to english collation
+  // Fallback to the basic multilingual plane case mapping after skipping the leading ASCII characters that match
   InternalStringInitialize();
+  Index = EfiDispatch()->StriPrefix(Str1, Str2);
+  Str1 += Index;
+  Str2 += Index;
   while (*Str1 != 0) {
-    if (TO_UPPER(*Str1) != TO_UPPER(*Str2)) {
+    if (CASE_TO_UPPER(*Str1) != CASE_TO_UPPER(*Str2)) {
       break;
     }
     ++Str1;
     ++Str2;
   }
-  return TO_UPPER(*Str1) - TO_UPPER(*Str2);
+  return CASE_TO_UPPER(*Str1) - CASE_TO_UPPER(*Str2);
 }
 // StrniCmp
 /// Performs a case-insensitive comparison of two strings
@@ -1298,12 +1826,13 @@ StrniCmp (
     EfiFreePool(StrCopy2);
     return Result;
   }
+  // Fallback to the basic multilingual plane case mapping
   InternalStringInitialize();
-  while ((*Str1 != 0) && (TO_UPPER(*Str1) == TO_UPPER(*Str2)) && (Count-- > 1)) {
+  while ((*Str1 != 0) && (CASE_TO_UPPER(*Str1) == CASE_TO_UPPER(*Str2)) && (Count-- > 1)) {
     ++Str1;
     ++Str2;
   }
-  return TO_UPPER(*Str1) - TO_UPPER(*Str2);
+  return CASE_TO_UPPER(*Str1) - CASE_TO_UPPER(*Str2);
 }
 
 // StriColl
@@ -1338,16 +1867,491 @@ StriColl (
     }
     return Result;
   }
-  // Fallback to english collation
-  InternalStringInitialize();
-  while (*Str1 != 0) {
-    if ((TO_UPPER(*Str1) != TO_UPPER(*Str2)) || (*Str1 != *Str2)) {
+  // Fallback to a case sensitive comparison since the first characters that differ exactly decide the order
+  return StrCmp(Str1, Str2);
+}
+// GlobFold
+/// Fold a character to the case used by compiled glob patterns
+/// @param Character The character to fold
+/// @param Ascii     Whether the character is from an ASCII string, where only ASCII letters are folded
+/// @return The folded character
+STATIC
+UINT32
+EFIAPI
+GlobFold (
+  IN UINT32  Character,
+  IN BOOLEAN Ascii
+) {
+  if (Ascii) {
+    return ((Character >= 'a') && (Character <= 'z')) ? (Character - 0x20) : Character;
+  }
+  return CASE_TO_UPPER(Character);
+}
+// GlobCharacter
+/// Get a character from a string
+/// @param String The string
+/// @param Ascii  Whether the string is an ASCII string or a Unicode string
+/// @param Index  The index of the character
+/// @return The character
+STATIC
+UINT32
+EFIAPI
+GlobCharacter (
+  IN CONST VOID *String,
+  IN BOOLEAN     Ascii,
+  IN UINTN       Index
+) {
+  return Ascii ? (UINT32)((CONST UINT8 *)String)[Index] : (UINT32)((CONST CHAR16 *)String)[Index];
+}
+// GlobParse
+/// Parse a glob pattern into elements and set ranges or count them
+/// @param Pattern    The glob pattern
+/// @param Ascii      Whether the pattern is an ASCII string or a Unicode string
+/// @param Elements   On output, the pattern elements or NULL to only count
+/// @param Ranges     On output, the set ranges or NULL to only count
+/// @param Count      On output, the count of pattern elements
+/// @param RangeCount On output, the count of set ranges
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_SUCCESS           If the pattern was parsed
+STATIC
+EFI_STATUS
+EFIAPI
+GlobParse (
+  IN  CONST VOID    *Pattern,
+  IN  BOOLEAN        Ascii,
+  OUT GLOB_ELEMENT  *Elements OPTIONAL,
+  OUT GLOB_RANGE    *Ranges OPTIONAL,
+  OUT UINTN         *Count,
+  OUT UINTN         *RangeCount
+) {
+  UINTN  Index = 0;
+  UINTN  ElementCount = 0;
+  UINTN  SetCount = 0;
+  UINT32 Character;
+  UINT32 Previous;
+  UINT32 Kind = GLOB_ELEMENT_LITERAL;
+  while ((Character = GlobCharacter(Pattern, Ascii, Index++)) != 0) {
+    switch (Character) {
+      case '*':
+        // Consecutive stars match the same as one star
+        if (Kind == GLOB_ELEMENT_STAR) {
+          continue;
+        }
+        Kind = GLOB_ELEMENT_STAR;
+        break;
+
+      case '?':
+        Kind = GLOB_ELEMENT_ANY;
+        break;
+
+      case '[':
+        // Each set item is a range, a single character is a range of itself and a range starts at the previous item
+        if (Elements != NULL) {
+          Elements[ElementCount].RangeStart = (UINT32)SetCount;
+        }
+        Previous = 0;
+        while ((Character = GlobCharacter(Pattern, Ascii, Index++)) != ']') {
+          if (Character == 0) {
+            return EFI_INVALID_PARAMETER;
+          }
+          if (Character == '-') {
+            Character = GlobCharacter(Pattern, Ascii, Index++);
+            if ((Character == 0) || (Character == ']')) {
+              return EFI_INVALID_PARAMETER;
+            }
+          } else {
+            Previous = Character;
+          }
+          if (Ranges != NULL) {
+            // The upper bound of a range always matches even when the range is empty
+            Ranges[SetCount].Low = GlobFold(Previous, Ascii);
+            Ranges[SetCount].High = GlobFold(Character, Ascii);
+            if (Ranges[SetCount].Low > Ranges[SetCount].High) {
+              Ranges[SetCount].Low = Ranges[SetCount].High;
+            }
+          }
+          ++SetCount;
+          Previous = Character;
+        }
+        if (Elements != NULL) {
+          Elements[ElementCount].RangeCount = (UINT32)SetCount - Elements[ElementCount].RangeStart;
+        }
+        Kind = GLOB_ELEMENT_SET;
+        break;
+
+      default:
+        Kind = GLOB_ELEMENT_LITERAL;
+        break;
+    }
+    if (Elements != NULL) {
+      Elements[ElementCount].Kind = Kind;
+      Elements[ElementCount].Character = (Kind == GLOB_ELEMENT_LITERAL) ? GlobFold(Character, Ascii) : 0;
+    }
+    ++ElementCount;
+  }
+  *Count = ElementCount;
+  *RangeCount = SetCount;
+  return EFI_SUCCESS;
+}
+// GlobElementMatches
+/// Check whether a pattern element that consumes a character matches a folded character
+/// @param Glob      The compiled glob pattern
+/// @param Element   The pattern element
+/// @param Character The folded character
+/// @return Whether the element matches the character or not
+STATIC
+BOOLEAN
+EFIAPI
+GlobElementMatches (
+  IN CONST EFI_GLOB     *Glob,
+  IN CONST GLOB_ELEMENT *Element,
+  IN UINT32              Character
+) {
+  UINTN Index;
+  switch (Element->Kind) {
+    case GLOB_ELEMENT_LITERAL:
+      return (Element->Character == Character);
+
+    case GLOB_ELEMENT_ANY:
+      return TRUE;
+
+    case GLOB_ELEMENT_SET:
+      for (Index = Element->RangeStart; Index < (Element->RangeStart + Element->RangeCount); ++Index) {
+        if ((Character >= Glob->Ranges[Index].Low) && (Character <= Glob->Ranges[Index].High)) {
+          return TRUE;
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+  return FALSE;
+}
+// GlobCompile
+/// Compile a glob pattern
+/// @param Pattern  The glob pattern
+/// @param Ascii    Whether the pattern is an ASCII string or a Unicode string
+/// @param Internal Whether the compiled pattern is allocated for the library cache
+/// @param Glob     On output, the compiled glob pattern
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the compiled pattern
+/// @retval EFI_SUCCESS           If the pattern was compiled
+STATIC
+EFI_STATUS
+EFIAPI
+GlobCompile (
+  IN  CONST VOID  *Pattern,
+  IN  BOOLEAN      Ascii,
+  IN  BOOLEAN      Internal,
+  OUT EFI_GLOB   **Glob
+) {
+  EFI_STATUS  Status;
+  EFI_GLOB   *Compiled;
+  UINTN       Count = 0;
+  UINTN       RangeCount = 0;
+  UINTN       Words;
+  UINTN       PatternSize;
+  UINTN       Size;
+  UINTN       Index;
+  UINTN       Character;
+  UINT8      *Buffer;
+  // Count the elements and ranges
+  Status = GlobParse(Pattern, Ascii, NULL, NULL, &Count, &RangeCount);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // One state for each count of matched elements
+  Words = (Count + 64) / 64;
+  PatternSize = Ascii ? AsciiStrSize((CONST CHAR8 *)Pattern) : StrSize((CONST CHAR16 *)Pattern);
+  Size = sizeof(EFI_GLOB) + (Words * (GLOB_ASCII_MASKS + 1) * sizeof(UINT64)) + (Count * sizeof(GLOB_ELEMENT)) + (RangeCount * sizeof(GLOB_RANGE)) + PatternSize;
+#if defined(EFI_MEMORY_VIRTUAL)
+  Buffer = (UINT8 *)(Internal ? EfiInternalAllocate(Size) : EfiAllocate(Size));
+#else
+  UNUSED_PARAMETER(Internal);
+  Buffer = (UINT8 *)EfiAllocate(Size);
+#endif
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  EfiZeroMem(Buffer, Size);
+  // Lay out the masks, elements, ranges and pattern copy after the compiled pattern
+  Compiled = (EFI_GLOB *)Buffer;
+  Buffer += sizeof(EFI_GLOB);
+  Compiled->StarMask = (UINT64 *)Buffer;
+  Buffer += Words * sizeof(UINT64);
+  Compiled->AsciiMasks = (UINT64 *)Buffer;
+  Buffer += Words * GLOB_ASCII_MASKS * sizeof(UINT64);
+  Compiled->Elements = (GLOB_ELEMENT *)Buffer;
+  Buffer += Count * sizeof(GLOB_ELEMENT);
+  Compiled->Ranges = (GLOB_RANGE *)Buffer;
+  Buffer += RangeCount * sizeof(GLOB_RANGE);
+  Compiled->Pattern = (VOID *)Buffer;
+  EfiCopyMem(Compiled->Pattern, (VOID *)Pattern, PatternSize);
+  Compiled->PatternSize = PatternSize;
+  Compiled->Ascii = Ascii;
+  Compiled->Count = Count;
+  Compiled->Words = Words;
+  GlobParse(Pattern, Ascii, Compiled->Elements, Compiled->Ranges, &Count, &RangeCount);
+  // Build the star mask and the masks of the elements that match each folded ASCII character
+  for (Index = 0; Index < Count; ++Index) {
+    if (Compiled->Elements[Index].Kind == GLOB_ELEMENT_STAR) {
+      Compiled->StarMask[Index / 64] |= EFI_BIT(Index % 64);
+      continue;
+    }
+    for (Character = 0; Character < GLOB_ASCII_MASKS; ++Character) {
+      if (GlobElementMatches(Compiled, Compiled->Elements + Index, (UINT32)Character)) {
+        Compiled->AsciiMasks[(Character * Words) + (Index / 64)] |= EFI_BIT(Index % 64);
+      }
+    }
+  }
+  *Glob = Compiled;
+  return EFI_SUCCESS;
+}
+// GlobRelease
+/// Free a compiled glob pattern
+/// @param Glob     The compiled glob pattern
+/// @param Internal Whether the compiled pattern was allocated for the library cache
+STATIC
+VOID
+EFIAPI
+GlobRelease (
+  IN EFI_GLOB *Glob,
+  IN BOOLEAN   Internal
+) {
+#if defined(EFI_MEMORY_VIRTUAL)
+  if (Internal) {
+    EfiInternalFreePool(Glob);
+    return;
+  }
+#else
+  UNUSED_PARAMETER(Internal);
+#endif
+  EfiFreePool(Glob);
+}
+// GlobStar
+/// Add the states that follow a star to a set of states, consecutive stars are compiled as one so one step is enough
+/// @param Glob   The compiled glob pattern
+/// @param States The set of states
+STATIC
+VOID
+EFIAPI
+GlobStar (
+  IN     CONST EFI_GLOB *Glob,
+  IN OUT UINT64         *States
+) {
+  UINTN  Index;
+  UINT64 Carry = 0;
+  UINT64 Stars;
+  for (Index = 0; Index < Glob->Words; ++Index) {
+    Stars = States[Index] & Glob->StarMask[Index];
+    States[Index] |= (Stars << 1) | Carry;
+    Carry = Stars >> 63;
+  }
+}
+// GlobMatch
+/// Match a string with a compiled glob pattern by simulating every pattern state at once, each character is read once
+/// @param Glob   The compiled glob pattern
+/// @param String The string to match
+/// @param Ascii  Whether the string is an ASCII string or a Unicode string
+/// @return Whether the string matches the pattern or not
+STATIC
+BOOLEAN
+EFIAPI
+GlobMatch (
+  IN CONST EFI_GLOB *Glob,
+  IN CONST VOID     *String,
+  IN BOOLEAN         Ascii
+) {
+  UINT64        Stack[GLOB_STACK_WORDS * 3];
+  UINT64       *States = Stack;
+  UINT64       *Masks;
+  UINT64       *Scratch;
+  CONST UINT64 *Mask;
+  UINT64        Carry;
+  UINT64        Next;
+  UINT64        Any;
+  UINTN         Offset;
+  UINTN         Index;
+  UINT32        Character;
+  BOOLEAN       Result;
+  // Long patterns need more states than fit on the stack
+  if (Glob->Words > GLOB_STACK_WORDS) {
+    States = EfiAllocateArray(UINT64, Glob->Words * 3);
+    if (States == NULL) {
+      return FALSE;
+    }
+  }
+  Masks = States + Glob->Words;
+  Scratch = Masks + Glob->Words;
+  // Start with no elements matched
+  EfiZeroArray(UINT64, States, Glob->Words);
+  States[0] = 1;
+  GlobStar(Glob, States);
+  for (Offset = 0; (Character = GlobCharacter(String, Ascii, Offset)) != 0; ++Offset) {
+    // Get the elements that match the folded character
+    Character = GlobFold(Character, Ascii);
+    if (Character < GLOB_ASCII_MASKS) {
+      Mask = Glob->AsciiMasks + (Character * Glob->Words);
+    } else {
+      EfiZeroArray(UINT64, Scratch, Glob->Words);
+      for (Index = 0; Index < Glob->Count; ++Index) {
+        if (GlobElementMatches(Glob, Glob->Elements + Index, Character)) {
+          Scratch[Index / 64] |= EFI_BIT(Index % 64);
+        }
+      }
+      Mask = Scratch;
+    }
+    // Advance past matching elements and stay on stars
+    Carry = 0;
+    Any = 0;
+    for (Index = 0; Index < Glob->Words; ++Index) {
+      Next = States[Index] & Mask[Index];
+      Masks[Index] = (Next << 1) | Carry | (States[Index] & Glob->StarMask[Index]);
+      Carry = Next >> 63;
+      Any |= Masks[Index];
+    }
+    if (Any == 0) {
       break;
     }
-    ++Str1;
-    ++Str2;
+    EfiCopyArray(UINT64, States, Masks, Glob->Words);
+    GlobStar(Glob, States);
   }
-  return *Str1 - *Str2;
+  // The string matches if every element was matched when the string ended
+  Result = (Character == 0) && EFI_BIT_IS_SET(States[Glob->Count / 64], Glob->Count % 64);
+  if (States != Stack) {
+    EfiFreePool(States);
+  }
+  return Result;
+}
+// GlobCachedMatch
+/// Match a string with a glob pattern that is compiled once and kept in a small cache of the most recently used patterns
+/// @param Pattern       The glob pattern
+/// @param PatternAscii  Whether the pattern is an ASCII string or a Unicode string
+/// @param String        The string to match
+/// @param StringAscii   Whether the string is an ASCII string or a Unicode string
+/// @return Whether the string matches the pattern or not
+STATIC
+BOOLEAN
+EFIAPI
+GlobCachedMatch (
+  IN CONST VOID *Pattern,
+  IN BOOLEAN     PatternAscii,
+  IN CONST VOID *String,
+  IN BOOLEAN     StringAscii
+) {
+  EFI_GLOB *Glob = NULL;
+  UINTN     Index;
+  BOOLEAN   Result;
+  // Compile the pattern without the cache when another processor is using it
+  if (!EfiTryLock(&mGlobCacheLock)) {
+    if (EFI_ERROR(GlobCompile(Pattern, PatternAscii, FALSE, &Glob))) {
+      return FALSE;
+    }
+    Result = GlobMatch(Glob, String, StringAscii);
+    GlobRelease(Glob, FALSE);
+    return Result;
+  }
+  // Find the pattern in the cache
+  for (Index = 0; Index < GLOB_CACHE_SIZE; ++Index) {
+    Glob = mGlobCache[Index];
+    if (Glob == NULL) {
+      break;
+    }
+    if ((Glob->Ascii == PatternAscii) &&
+        ((PatternAscii && (AsciiStrCmp((CONST CHAR8 *)Glob->Pattern, (CONST CHAR8 *)Pattern) == 0)) ||
+         (!PatternAscii && (StrCmp((CONST CHAR16 *)Glob->Pattern, (CONST CHAR16 *)Pattern) == 0)))) {
+      break;
+    }
+    Glob = NULL;
+  }
+  if (Glob == NULL) {
+    // Compile the pattern and evict the least recently used pattern if the cache is full
+    if (EFI_ERROR(GlobCompile(Pattern, PatternAscii, TRUE, &Glob))) {
+      EfiUnlock(&mGlobCacheLock);
+      return FALSE;
+    }
+    if (Index == GLOB_CACHE_SIZE) {
+      GlobRelease(mGlobCache[--Index], TRUE);
+    }
+  }
+  // Move the pattern to the front of the cache
+  while (Index > 0) {
+    mGlobCache[Index] = mGlobCache[Index - 1];
+    --Index;
+  }
+  mGlobCache[0] = Glob;
+  Result = GlobMatch(Glob, String, StringAscii);
+  EfiUnlock(&mGlobCacheLock);
+  return Result;
+}
+
+// StrGlobCompile
+/// Compile a case-insensitive glob pattern for repeated matching
+/// @param Pattern The glob pattern, which may contain * to match zero or more characters, ? to match any one character
+///                 and [...] to match one character from a set of characters and ranges of characters
+/// @param Glob    On output, the compiled glob pattern, which must be freed with EfiGlobFree
+/// @retval EFI_INVALID_PARAMETER If Pattern or Glob is NULL or *Glob is not NULL
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the compiled pattern
+/// @retval EFI_SUCCESS           If the pattern was compiled
+EFI_STATUS
+EFIAPI
+StrGlobCompile (
+  IN  CONST CHAR16  *Pattern,
+  OUT EFI_GLOB     **Glob
+) {
+  if ((Pattern == NULL) || (Glob == NULL) || (*Glob != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  InternalStringInitialize();
+  return GlobCompile(Pattern, FALSE, FALSE, Glob);
+}
+// StrGlobMatch
+/// Performs a case-insensitive comparison of a compiled glob pattern and a string
+/// @param Glob   The compiled glob pattern
+/// @param String The string to match
+/// @retval TRUE  String matches the pattern
+/// @retval FALSE String does not match the pattern or Glob or String is NULL
+BOOLEAN
+EFIAPI
+StrGlobMatch (
+  IN CONST EFI_GLOB *Glob,
+  IN CONST CHAR16   *String
+) {
+  if ((Glob == NULL) || (String == NULL)) {
+    return FALSE;
+  }
+  return GlobMatch(Glob, String, FALSE);
+}
+// EfiGlobFree
+/// Free a compiled glob pattern
+/// @param Glob The compiled glob pattern to free
+VOID
+EFIAPI
+EfiGlobFree (
+  IN EFI_GLOB *Glob
+) {
+  if (Glob != NULL) {
+    GlobRelease(Glob, FALSE);
+  }
+}
+// EfiGlobCacheFree
+/// Free the compiled glob patterns cached by MetaiMatch and AsciiMetaiMatch
+VOID
+EFIAPI
+EfiGlobCacheFree (
+  VOID
+) {
+  UINTN Index;
+  EfiLock(&mGlobCacheLock);
+  for (Index = 0; Index < GLOB_CACHE_SIZE; ++Index) {
+    if (mGlobCache[Index] != NULL) {
+      GlobRelease(mGlobCache[Index], TRUE);
+      mGlobCache[Index] = NULL;
+    }
+  }
+  EfiUnlock(&mGlobCacheLock);
 }
 // MetaiMatch
 /// Performs a case-insensitive comparison of a pattern string and a string
@@ -1362,9 +2366,6 @@ MetaiMatch (
   IN CONST CHAR16 *Pattern
 ) {
   EFI_UNICODE_COLLATION_PROTOCOL *Protocol;
-  CHAR16  CharC;
-  CHAR16  CharP;
-  CHAR16  Index3;
   // Check parameters
   if ((String == NULL) || (Pattern == NULL)) {
     return FALSE;
@@ -1374,83 +2375,9 @@ MetaiMatch (
   if ((Protocol != NULL) && (Protocol->MetaiMatch != NULL)) {
     return Protocol->MetaiMatch(Protocol, (CHAR16 *)String, (CHAR16 *)Pattern);
   }
-  // Fallback to english collation
+  // Fallback to the compiled pattern with the basic multilingual plane case mapping
   InternalStringInitialize();
-  while ((CharP = *Pattern++) != '\0') {
-
-    switch (CharP) {
-
-    case '*':
-      // Match zero or more chars
-      while (*String != 0) {
-        if (MetaiMatch(String, Pattern)) {
-          return TRUE;
-        }
-        ++String;
-      }
-
-      return MetaiMatch(String, Pattern);
-
-    case '?':
-      // Match any one char
-      if (*String == 0) {
-        return FALSE;
-      }
-      ++String;
-      break;
-
-    case '[':
-      // Match char set
-      CharC = *String;
-      if (CharC == 0) {
-        // syntax problem
-        return FALSE;
-      }
-
-      Index3 = 0;
-      CharP = *Pattern++;
-      while (CharP != 0) {
-        if (CharP == ']') {
-          return FALSE;
-        }
-        if (CharP == '-') {
-          // if range of chars, get high range
-          CharP = *Pattern;
-          if (CharP == 0 || CharP == ']') {
-            // syntax problem
-            return FALSE;
-          }
-          if ((TO_UPPER(CharC) >= TO_UPPER(Index3)) && (TO_UPPER(CharC) <= TO_UPPER(CharP))) {
-            // if in range, it's a match
-            break;
-          }
-        }
-        Index3 = CharP;
-        if (TO_UPPER(CharC) == TO_UPPER(CharP)) {
-          // if char matches
-          break;
-        }
-
-        CharP = *Pattern++;
-      }
-      // skip to end of match char set
-      while ((CharP != 0) && (CharP != ']')) {
-        CharP = *Pattern++;
-      }
-      ++String;
-      break;
-
-    default:
-      CharC = *String;
-      if (TO_UPPER(CharC) != TO_UPPER(CharP)) {
-        return FALSE;
-      }
-      ++String;
-      break;
-
-    }
-  }
-  return (*String == L'\0');
+  return GlobCachedMatch(Pattern, FALSE, String, FALSE);
 }
 
 // StrLwr
@@ -1470,10 +2397,10 @@ StrLwr (
   if ((Protocol != NULL) && (Protocol->StrLwr != NULL)) {
     Protocol->StrLwr(Protocol, Str);
   } else {
-    // Fallback to english collation
+    // Fallback to the basic multilingual plane case mapping
     InternalStringInitialize();
     while (*Str != 0) {
-      *Str = TO_LOWER(*Str);
+      *Str = CASE_TO_LOWER(*Str);
       ++Str;
     }
   }
@@ -1495,10 +2422,10 @@ StrUpr (
   if ((Protocol != NULL) && (Protocol->StrUpr != NULL)) {
     Protocol->StrUpr(Protocol, Str);
   } else {
-    // Fallback to english collation
+    // Fallback to the basic multilingual plane case mapping
     InternalStringInitialize();
     while (*Str != 0) {
-      *Str = TO_UPPER(*Str);
+      *Str = CASE_TO_UPPER(*Str);
       ++Str;
     }
   }
@@ -1534,7 +2461,163 @@ StrToUpper (
   }
   return Dup;
 }
+// CharToLower
+/// Converts a character to a lower case character with the basic multilingual plane case mapping, which does not depend on the language
+/// @param Character The character to convert
+/// @return The lower case character
+CHAR16
+EFIAPI
+CharToLower (
+  IN CHAR16 Character
+) {
+  InternalStringInitialize();
+  return CASE_TO_LOWER(Character);
+}
+// CharToUpper
+/// Converts a character to an upper case character with the basic multilingual plane case mapping, which does not depend on the language
+/// @param Character The character to convert
+/// @return The upper case character
+CHAR16
+EFIAPI
+CharToUpper (
+  IN CHAR16 Character
+) {
+  InternalStringInitialize();
+  return CASE_TO_UPPER(Character);
+}
 
+// StrSearchMaximalSuffix
+/// Find the start of the maximal suffix of a sub-string for the two-way search
+/// @param SearchString The sub-string
+/// @param SearchLen    The length of the sub-string, which must not be zero
+/// @param Reverse      Whether to order the characters in reverse
+/// @param Period       On output, the period of the maximal suffix
+/// @return The length of the sub-string before the maximal suffix
+STATIC
+UINTN
+EFIAPI
+StrSearchMaximalSuffix (
+  IN  CONST CHAR16 *SearchString,
+  IN  UINTN         SearchLen,
+  IN  BOOLEAN       Reverse,
+  OUT UINTN        *Period
+) {
+  CHAR16 Suffix;
+  CHAR16 Candidate;
+  UINTN  Start = 0;
+  UINTN  Next = 0;
+  UINTN  Index = 1;
+  *Period = 1;
+  // Compare the suffix with each candidate suffix, keeping the lexicographically greater one and its period
+  while ((Next + Index) < SearchLen) {
+    Suffix = SearchString[Start + Index - 1];
+    Candidate = SearchString[Next + Index];
+    if (Suffix == Candidate) {
+      if (Index == *Period) {
+        Next += *Period;
+        Index = 1;
+      } else {
+        ++Index;
+      }
+    } else if (Reverse ? (Suffix < Candidate) : (Suffix > Candidate)) {
+      Next += Index;
+      Index = 1;
+      *Period = Next + 1 - Start;
+    } else {
+      Start = ++Next;
+      Index = 1;
+      *Period = 1;
+    }
+  }
+  return Start;
+}
+// StrSearchTwoWay
+/// Returns the first occurrence of a long sub-string in a string with the two-way search, which takes linear time in the worst case and skips ahead with a table of the last character of each window
+/// @param String       The string to search
+/// @param SearchString The sub-string for which to search, which must not be empty
+/// @return A pointer to the matched sub-string in String
+/// @retval NULL If SearchString was not found in String
+STATIC
+CHAR16 *
+EFIAPI
+StrSearchTwoWay (
+  IN CHAR16 *String,
+  IN CHAR16 *SearchString
+) {
+  UINT32 Skip[256];
+  UINTN  StringLen = StrLen(String);
+  UINTN  SearchLen = StrLen(SearchString);
+  UINTN  Last;
+  UINTN  Left;
+  UINTN  Period;
+  UINTN  ReversePeriod;
+  UINTN  Memory;
+  UINTN  PeriodMemory;
+  UINTN  Shift;
+  UINTN  Index;
+  UINTN  Offset;
+  if (StringLen < SearchLen) {
+    return NULL;
+  }
+  // Build the skip table keyed by the low byte of each character, the last occurrence gives the smallest skip
+  Last = SearchLen - 1;
+  for (Index = 0; Index < ARRAY_COUNT(Skip); ++Index) {
+    Skip[Index] = (UINT32)SearchLen;
+  }
+  for (Index = 0; Index < SearchLen; ++Index) {
+    Skip[(UINT8)SearchString[Index]] = (UINT32)(Last - Index);
+  }
+  // Split the sub-string at the critical factorization given by the later of the two maximal suffixes
+  Left = StrSearchMaximalSuffix(SearchString, SearchLen, FALSE, &Period);
+  Index = StrSearchMaximalSuffix(SearchString, SearchLen, TRUE, &ReversePeriod);
+  if (Index > Left) {
+    Left = Index;
+    Period = ReversePeriod;
+  }
+  // Remember the matched prefix after a shift by the period only if the left part repeats with the period
+  for (Index = 0; Index < Left; ++Index) {
+    if (SearchString[Index] != SearchString[Index + Period]) {
+      break;
+    }
+  }
+  if (Index < Left) {
+    PeriodMemory = 0;
+    Period = ((SearchLen - Left) < Left) ? Left : (SearchLen - Left + 1);
+  } else {
+    PeriodMemory = SearchLen - Period;
+  }
+  // Compare each window right of the factorization then left of it, never comparing again the characters already known to match
+  Memory = 0;
+  Offset = 0;
+  while (Offset <= (StringLen - SearchLen)) {
+    Shift = Skip[(UINT8)String[Offset + Last]];
+    if (Shift != 0) {
+      Offset += (Shift < Memory) ? Memory : Shift;
+      Memory = 0;
+      continue;
+    }
+    Index = (Memory > Left) ? Memory : Left;
+    while ((Index < SearchLen) && (String[Offset + Index] == SearchString[Index])) {
+      ++Index;
+    }
+    if (Index < SearchLen) {
+      Offset += Index + 1 - Left;
+      Memory = 0;
+      continue;
+    }
+    Index = Left;
+    while ((Index > Memory) && (String[Offset + Index - 1] == SearchString[Index - 1])) {
+      --Index;
+    }
+    if (Index <= Memory) {
+      return String + Offset;
+    }
+    Offset += Period;
+    Memory = PeriodMemory;
+  }
+  // Not found
+  return NULL;
+}
 // StrStr
 /// Returns the first occurrence of a sub-string in a string
 /// @param String       A pointer to a string
@@ -1547,6 +2630,7 @@ StrStr (
   IN CHAR16 *String,
   IN CHAR16 *SearchString
 ) {
+  UINTN Length;
   // Check parameters
   if (String == NULL) {
     return NULL;
@@ -1554,30 +2638,15 @@ StrStr (
   if ((SearchString == NULL) || (*SearchString == L'\0')) {
     return String;
   }
-  // Iterate through string for matches
-  while (*String != L'\0') {
-    CHAR16 *SearchStringTmp = SearchString;
-    CHAR16 *FirstMatch = String;
-
-    // Check for match
-    while ((*String == *SearchStringTmp) && (*String != L'\0')) {
-      ++String;
-      ++SearchStringTmp;
-    }
-
-    if (*SearchStringTmp == L'\0') {
-      // Found
-      return FirstMatch;
-    }
-    if (*String == L'\0') {
-      // Not found
-      return NULL;
-    }
-
-    String = FirstMatch + 1;
+  // Use the two-way search for long sub-strings and the dispatched search otherwise
+  Length = 0;
+  while ((Length < STRING_SEARCH_LONG_LENGTH) && (SearchString[Length] != L'\0')) {
+    ++Length;
   }
-  // Not found
-  return NULL;
+  if (Length == STRING_SEARCH_LONG_LENGTH) {
+    return StrSearchTwoWay(String, SearchString);
+  }
+  return EfiDispatch()->StrStr(String, SearchString);
 }
 // StriStr
 /// Returns the first occurrence of a case-insensitive sub-string in a string
@@ -2003,14 +3072,10 @@ EFIAPI
 AsciiStrLen (
   CONST CHAR8 *Str
 ) {
-  CONST CHAR8 *Ptr = Str;
   if (Str == NULL) {
     return NULL;
   }
-  while (*Ptr != 0) {
-    ++Ptr;
-  }
-  return Ptr - Str;
+  return EfiDispatch()->AsciiStrLen(Str);
 }
 // AsciiStrSize
 /// Get the size in bytes of a character string (including the null-terminator)
@@ -2021,12 +3086,10 @@ EFIAPI
 AsciiStrSize (
   CONST CHAR8 *Str
 ) {
-  CONST CHAR8 *Ptr = Str;
   if (Str == NULL) {
     return NULL;
   }
-  while (*Ptr++ != 0);
-  return sizeof(CHAR8) * (Ptr - Str);
+  return sizeof(CHAR8) * (EfiDispatch()->AsciiStrLen(Str) + 1);
 }
 
 // AsciiStrDup
@@ -2107,14 +3170,7 @@ AsciiStrCmp (
   } else if (Str2 == NULL) {
     return 1;
   }
-  while (*Str1 != 0) {
-    if (*Str1 != *Str2) {
-      break;
-    }
-    ++Str1;
-    ++Str2;
-  }
-  return *Str1 - *Str2;
+  return EfiDispatch()->AsciiStrCmp(Str1, Str2);
 }
 // AsciiStrnCmp
 /// Performs a comparison of two strings
@@ -2143,11 +3199,7 @@ AsciiStrnCmp (
   } else if (Str2 == NULL) {
     return 1;
   }
-  while ((*Str1 != 0) && (*Str1 == *Str2) && (Count-- > 1)) {
-    ++Str1;
-    ++Str2;
-  }
-  return *Str1 - *Str2;
+  return EfiDispatch()->AsciiStrnCmp(Str1, Str2, Count);
 }
 // AsciiStriCmp
 /// Performs a case-insensitive comparison of two strings
@@ -2259,86 +3311,48 @@ AsciiMetaiMatch (
   IN CONST CHAR8 *String,
   IN CONST CHAR8 *Pattern
 ) {
-  CHAR8 CharC;
-  CHAR8 CharP;
-  CHAR8 Index3;
   // Check parameters
   if ((String == NULL) || (Pattern == NULL)) {
     return FALSE;
   }
-  InternalStringInitialize();
-  while ((CharP = *Pattern++) != '\0') {
-
-    switch (CharP) {
-
-    case '*':
-      // Match zero or more chars
-      while (*String != 0) {
-        if (AsciiMetaiMatch(String, Pattern)) {
-          return TRUE;
-        }
-        ++String;
-      }
-      return AsciiMetaiMatch(String, Pattern);
-
-    case '?':
-      // Match any one char
-      if (*String == 0) {
-        return FALSE;
-      }
-      ++String;
-      break;
-
-    case '[':
-      // Match char set
-      CharC = *String;
-      if (CharC == 0) {
-        // syntax problem
-        return FALSE;
-      }
-      Index3  = 0;
-      CharP   = *Pattern++;
-      while (CharP != 0) {
-        if (CharP == ']') {
-          return FALSE;
-        }
-        if (CharP == '-') {
-          // if range of chars, get high range
-          CharP = *Pattern;
-          if (CharP == 0 || CharP == ']') {
-            // syntax problem
-            return FALSE;
-          }
-          if ((TO_UPPER(CharC) >= TO_UPPER(Index3)) && (TO_UPPER(CharC) <= TO_UPPER(CharP))) {
-            // if in range, it's a match
-            break;
-          }
-        }
-        Index3 = CharP;
-        if (TO_UPPER(CharC) == TO_UPPER(CharP)) {
-          // if char matches
-          break;
-        }
-        CharP = *Pattern++;
-      }
-      // skip to end of match char set
-      while ((CharP != 0) && (CharP != ']')) {
-        CharP = *Pattern;
-        ++Pattern;
-      }
-      ++String;
-      break;
-
-    default:
-      CharC = *String;
-      if (TO_UPPER(CharC) != TO_UPPER(CharP)) {
-        return FALSE;
-      }
-      ++String;
-      break;
-    }
+  return GlobCachedMatch(Pattern, TRUE, String, TRUE);
+}
+// AsciiGlobCompile
+/// Compile a case-insensitive glob pattern for repeated matching
+/// @param Pattern The glob pattern, which may contain * to match zero or more characters, ? to match any one character
+///                 and [...] to match one character from a set of characters and ranges of characters
+/// @param Glob    On output, the compiled glob pattern, which must be freed with EfiGlobFree
+/// @retval EFI_INVALID_PARAMETER If Pattern or Glob is NULL or *Glob is not NULL
+/// @retval EFI_INVALID_PARAMETER If a set is not terminated or a set range has no upper bound
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the compiled pattern
+/// @retval EFI_SUCCESS           If the pattern was compiled
+EFI_STATUS
+EFIAPI
+AsciiGlobCompile (
+  IN  CONST CHAR8  *Pattern,
+  OUT EFI_GLOB    **Glob
+) {
+  if ((Pattern == NULL) || (Glob == NULL) || (*Glob != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  return GlobCompile(Pattern, TRUE, FALSE, Glob);
+}
+// AsciiGlobMatch
+/// Performs a case-insensitive comparison of a compiled glob pattern and a string
+/// @param Glob   The compiled glob pattern
+/// @param String The string to match
+/// @retval TRUE  String matches the pattern
+/// @retval FALSE String does not match the pattern or Glob or String is NULL
+BOOLEAN
+EFIAPI
+AsciiGlobMatch (
+  IN CONST EFI_GLOB *Glob,
+  IN CONST CHAR8    *String
+) {
+  if ((Glob == NULL) || (String == NULL)) {
+    return FALSE;
   }
-  return (*String == 0);
+  return GlobMatch(Glob, String, TRUE);
 }
 
 // AsciiLwr
@@ -2407,6 +3421,138 @@ AsciiToUpper (
   return Dup;
 }
 
+// AsciiStrSearchMaximalSuffix
+/// Find the start of the maximal suffix of a sub-string for the two-way search
+/// @param SearchString The sub-string
+/// @param SearchLen    The length of the sub-string, which must not be zero
+/// @param Reverse      Whether to order the characters in reverse
+/// @param Period       On output, the period of the maximal suffix
+/// @return The length of the sub-string before the maximal suffix
+STATIC
+UINTN
+EFIAPI
+AsciiStrSearchMaximalSuffix (
+  IN  CONST CHAR8 *SearchString,
+  IN  UINTN       SearchLen,
+  IN  BOOLEAN     Reverse,
+  OUT UINTN      *Period
+) {
+  CHAR8  Suffix;
+  CHAR8  Candidate;
+  UINTN  Start = 0;
+  UINTN  Next = 0;
+  UINTN  Index = 1;
+  *Period = 1;
+  // Compare the suffix with each candidate suffix, keeping the lexicographically greater one and its period
+  while ((Next + Index) < SearchLen) {
+    Suffix = SearchString[Start + Index - 1];
+    Candidate = SearchString[Next + Index];
+    if (Suffix == Candidate) {
+      if (Index == *Period) {
+        Next += *Period;
+        Index = 1;
+      } else {
+        ++Index;
+      }
+    } else if (Reverse ? (Suffix < Candidate) : (Suffix > Candidate)) {
+      Next += Index;
+      Index = 1;
+      *Period = Next + 1 - Start;
+    } else {
+      Start = ++Next;
+      Index = 1;
+      *Period = 1;
+    }
+  }
+  return Start;
+}
+// AsciiStrSearchTwoWay
+/// Returns the first occurrence of a long sub-string in a string with the two-way search, which takes linear time in the worst case and skips ahead with a table of the last character of each window
+/// @param String       The string to search
+/// @param SearchString The sub-string for which to search, which must not be empty
+/// @return A pointer to the matched sub-string in String
+/// @retval NULL If SearchString was not found in String
+STATIC
+CHAR8 *
+EFIAPI
+AsciiStrSearchTwoWay (
+  IN CHAR8 *String,
+  IN CHAR8 *SearchString
+) {
+  UINT32 Skip[256];
+  UINTN  StringLen = AsciiStrLen(String);
+  UINTN  SearchLen = AsciiStrLen(SearchString);
+  UINTN  Last;
+  UINTN  Left;
+  UINTN  Period;
+  UINTN  ReversePeriod;
+  UINTN  Memory;
+  UINTN  PeriodMemory;
+  UINTN  Shift;
+  UINTN  Index;
+  UINTN  Offset;
+  if (StringLen < SearchLen) {
+    return NULL;
+  }
+  // Build the skip table keyed by the low byte of each character, the last occurrence gives the smallest skip
+  Last = SearchLen - 1;
+  for (Index = 0; Index < ARRAY_COUNT(Skip); ++Index) {
+    Skip[Index] = (UINT32)SearchLen;
+  }
+  for (Index = 0; Index < SearchLen; ++Index) {
+    Skip[(UINT8)SearchString[Index]] = (UINT32)(Last - Index);
+  }
+  // Split the sub-string at the critical factorization given by the later of the two maximal suffixes
+  Left = AsciiStrSearchMaximalSuffix(SearchString, SearchLen, FALSE, &Period);
+  Index = AsciiStrSearchMaximalSuffix(SearchString, SearchLen, TRUE, &ReversePeriod);
+  if (Index > Left) {
+    Left = Index;
+    Period = ReversePeriod;
+  }
+  // Remember the matched prefix after a shift by the period only if the left part repeats with the period
+  for (Index = 0; Index < Left; ++Index) {
+    if (SearchString[Index] != SearchString[Index + Period]) {
+      break;
+    }
+  }
+  if (Index < Left) {
+    PeriodMemory = 0;
+    Period = ((SearchLen - Left) < Left) ? Left : (SearchLen - Left + 1);
+  } else {
+    PeriodMemory = SearchLen - Period;
+  }
+  // Compare each window right of the factorization then left of it, never comparing again the characters already known to match
+  Memory = 0;
+  Offset = 0;
+  while (Offset <= (StringLen - SearchLen)) {
+    Shift = Skip[(UINT8)String[Offset + Last]];
+    if (Shift != 0) {
+      Offset += (Shift < Memory) ? Memory : Shift;
+      Memory = 0;
+      continue;
+    }
+    Index = (Memory > Left) ? Memory : Left;
+    while ((Index < SearchLen) && (String[Offset + Index] == SearchString[Index])) {
+      ++Index;
+    }
+    if (Index < SearchLen) {
+      Offset += Index + 1 - Left;
+      Memory = 0;
+      continue;
+    }
+    Index = Left;
+    while ((Index > Memory) && (String[Offset + Index - 1] == SearchString[Index - 1])) {
+      --Index;
+    }
+    if (Index <= Memory) {
+      return String + Offset;
+    }
+    Offset += Period;
+    Memory = PeriodMemory;
+  }
+  // Not found
+  return NULL;
+}
 // AsciiStrStr
 /// Returns the first occurrence of a sub-string in a string
 /// @param String       A pointer to a string
@@ -2419,6 +3565,7 @@ AsciiStrStr (
   IN CHAR8 *String,
   IN CHAR8 *SearchString
 ) {
+  UINTN Length;
   // Check parameters
   if (String == NULL) {
     return NULL;
@@ -2426,30 +3573,15 @@ AsciiStrStr (
   if ((SearchString == NULL) || (*SearchString == '\0')) {
     return String;
   }
-  // Iterate through string for matches
-  while (*String != '\0') {
-    CHAR8 *SearchStringTmp = SearchString;
-    CHAR8 *FirstMatch = String;
-
-    // Check for match
-    while ((*String == *SearchStringTmp) && (*String != '\0')) {
-      ++String;
-      ++SearchStringTmp;
-    }
-
-    if (*SearchStringTmp == '\0') {
-      // Found
-      return FirstMatch;
-    }
-    if (*String == '\0') {
-      // Not found
-      return NULL;
-    }
-
-    String = FirstMatch + 1;
+  // Use the two-way search for long sub-strings and the dispatched search otherwise
+  Length = 0;
+  while ((Length < STRING_SEARCH_LONG_LENGTH) && (SearchString[Length] != '\0')) {
+    ++Length;
   }
-  // Not found
-  return NULL;
+  if (Length == STRING_SEARCH_LONG_LENGTH) {
+    return AsciiStrSearchTwoWay(String, SearchString);
+  }
+  return EfiDispatch()->AsciiStrStr(String, SearchString);
 }
 // AsciiStriStr
 /// Returns the first occurrence of a case-insensitive sub-string in a string
@@ -0,0 +1,585 @@
+///
+/// @file Library/Uefi/StringBuilder.c
+///
+/// UEFI growable encoded character string builder
+///
+
+#include <Uefi.h>
+
+// EFI_STRING_ARENA_ALIGNMENT
+/// The alignment in bytes of every buffer allocated from a string arena, must be a power of two
+#define EFI_STRING_ARENA_ALIGNMENT 8
+// EFI_STRING_ARENA_ALIGN
+/// Round a size up to the string arena alignment
+#define EFI_STRING_ARENA_ALIGN(Size) (((Size) + (EFI_STRING_ARENA_ALIGNMENT - 1)) & ~((UINTN)(EFI_STRING_ARENA_ALIGNMENT - 1)))
+
+// EFI_STRING_ARENA_CHUNK
+/// A string arena chunk header, the chunk data follows the aligned header
+typedef struct EFI_STRING_ARENA_CHUNK EFI_STRING_ARENA_CHUNK;
+struct EFI_STRING_ARENA_CHUNK {
+
+  // Next
+  /// The next older chunk
+  EFI_STRING_ARENA_CHUNK *Next;
+  // Size
+  /// The size in bytes of the chunk data
+  UINTN                   Size;
+  // Used
+  /// The size in bytes of the chunk data that has been allocated
+  UINTN                   Used;
+
+};
+
+// EFI_STRING_ARENA_CHUNK_HEADER_SIZE
+/// The size in bytes of a chunk header rounded up to the string arena alignment
+#define EFI_STRING_ARENA_CHUNK_HEADER_SIZE EFI_STRING_ARENA_ALIGN(sizeof(EFI_STRING_ARENA_CHUNK))
+// EFI_STRING_ARENA_CHUNK_DATA
+/// Get the data of a string arena chunk
+#define EFI_STRING_ARENA_CHUNK_DATA(Chunk) ADDRESS_OFFSET(UINT8, Chunk, EFI_STRING_ARENA_CHUNK_HEADER_SIZE)
+
+// EFI_STRING_ARENA
+/// A string arena that hands out buffers from large chunks and frees them all at once
+struct EFI_STRING_ARENA {
+
+  // Chunks
+  /// The chunks of the arena, the newest chunk is first and is the only one allocated from
+  EFI_STRING_ARENA_CHUNK *Chunks;
+  // ChunkSize
+  /// The size in bytes of the data of each chunk, larger allocations get a chunk of their own size
+  UINTN                   ChunkSize;
+
+};
+
+// StringArenaAddChunk
+/// Add a new chunk to a string arena
+/// @param Arena The string arena
+/// @param Size  The least size in bytes of the chunk data
+/// @return The new chunk or NULL if memory could not be allocated
+STATIC
+EFI_STRING_ARENA_CHUNK *
+EFIAPI
+StringArenaAddChunk (
+  IN EFI_STRING_ARENA *Arena,
+  IN UINTN             Size
+) {
+  EFI_STRING_ARENA_CHUNK *Chunk;
+  // Use the arena chunk size unless the allocation is larger
+  if (Size < Arena->ChunkSize) {
+    Size = Arena->ChunkSize;
+  }
+  if (Size > (MAX_UINTN - EFI_STRING_ARENA_CHUNK_HEADER_SIZE)) {
+    return NULL;
+  }
+  Chunk = (EFI_STRING_ARENA_CHUNK *)EfiAllocate(EFI_STRING_ARENA_CHUNK_HEADER_SIZE + Size);
+  if (Chunk == NULL) {
+    return NULL;
+  }
+  Chunk->Size = Size;
+  Chunk->Used = 0;
+  Chunk->Next = Arena->Chunks;
+  Arena->Chunks = Chunk;
+  return Chunk;
+}
+// StringArenaResize
+/// Resize the last buffer allocated from a string arena in place
+/// @param Arena   The string arena
+/// @param Buffer  The buffer to resize
+/// @param OldSize The aligned size in bytes of the buffer
+/// @param NewSize The aligned new size in bytes of the buffer
+/// @return Whether the buffer was resized in place or not
+STATIC
+BOOLEAN
+EFIAPI
+StringArenaResize (
+  IN EFI_STRING_ARENA *Arena,
+  IN VOID             *Buffer,
+  IN UINTN             OldSize,
+  IN UINTN             NewSize
+) {
+  EFI_STRING_ARENA_CHUNK *Chunk = Arena->Chunks;
+  UINT8                  *Data;
+  // Only the last buffer allocated from the newest chunk can be resized
+  if ((Chunk == NULL) || (Buffer == NULL) || (OldSize > Chunk->Used)) {
+    return FALSE;
+  }
+  Data = EFI_STRING_ARENA_CHUNK_DATA(Chunk);
+  if (ADDRESS_OFFSET(UINT8, Buffer, OldSize) != (Data + Chunk->Used)) {
+    return FALSE;
+  }
+  if (NewSize > (Chunk->Size - (Chunk->Used - OldSize))) {
+    return FALSE;
+  }
+  Chunk->Used = (Chunk->Used - OldSize) + NewSize;
+  return TRUE;
+}
+
+// EfiStringArenaCreate
+/// Create a string arena
+/// @param Arena     On output, the created string arena, which must be freed with EfiStringArenaFree
+/// @param ChunkSize The size in bytes of each chunk allocated by the arena or zero for the default size
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL or *Arena is not NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the arena
+/// @retval EFI_SUCCESS           If the arena was created successfully
+EFI_STATUS
+EFIAPI
+EfiStringArenaCreate (
+  OUT EFI_STRING_ARENA **Arena,
+  IN  UINTN              ChunkSize
+) {
+  EFI_STRING_ARENA *StringArena;
+  // Check parameters
+  if ((Arena == NULL) || (*Arena != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (ChunkSize == 0) {
+    ChunkSize = EFI_STRING_ARENA_DEFAULT_CHUNK_SIZE;
+  }
+  // Allocate the arena and its first chunk
+  StringArena = EfiAllocateByType(EFI_STRING_ARENA);
+  if (StringArena == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  StringArena->Chunks = NULL;
+  StringArena->ChunkSize = EFI_STRING_ARENA_ALIGN(ChunkSize);
+  if (StringArenaAddChunk(StringArena, 0) == NULL) {
+    EfiFreePool(StringArena);
+    return EFI_OUT_OF_RESOURCES;
+  }
+  *Arena = StringArena;
+  return EFI_SUCCESS;
+}
+// EfiStringArenaAllocate
+/// Allocate a buffer from a string arena
+/// @param Arena The string arena
+/// @param Size  The size in bytes to allocate
+/// @return The allocated buffer, which is freed with the arena, or NULL if memory could not be allocated
+VOID *
+EFIAPI
+EfiStringArenaAllocate (
+  IN EFI_STRING_ARENA *Arena,
+  IN UINTN             Size
+) {
+  EFI_STRING_ARENA_CHUNK *Chunk;
+  VOID                   *Buffer;
+  // Check parameters
+  if ((Arena == NULL) || (Size == 0) || (Size > (MAX_UINTN - EFI_STRING_ARENA_ALIGNMENT))) {
+    return NULL;
+  }
+  Size = EFI_STRING_ARENA_ALIGN(Size);
+  // Bump allocate from the newest chunk or start a new chunk when it is full
+  Chunk = Arena->Chunks;
+  if ((Chunk == NULL) || (Size > (Chunk->Size - Chunk->Used))) {
+    Chunk = StringArenaAddChunk(Arena, Size);
+    if (Chunk == NULL) {
+      return NULL;
+    }
+  }
+  Buffer = EFI_STRING_ARENA_CHUNK_DATA(Chunk) + Chunk->Used;
+  Chunk->Used += Size;
+  return Buffer;
+}
+// EfiStringArenaReset
+/// Release every buffer allocated from a string arena but keep the first chunk for reuse
+/// @param Arena The string arena
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL
+/// @retval EFI_SUCCESS           If the arena was reset
+EFI_STATUS
+EFIAPI
+EfiStringArenaReset (
+  IN EFI_STRING_ARENA *Arena
+) {
+  EFI_STRING_ARENA_CHUNK *Chunk;
+  // Check parameters
+  if (Arena == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Free every chunk but the oldest, which is the first chunk created with the arena
+  Chunk = Arena->Chunks;
+  while ((Chunk != NULL) && (Chunk->Next != NULL)) {
+    EFI_STRING_ARENA_CHUNK *Next = Chunk->Next;
+    EfiFreePool(Chunk);
+    Chunk = Next;
+  }
+  if (Chunk != NULL) {
+    Chunk->Used = 0;
+  }
+  Arena->Chunks = Chunk;
+  return EFI_SUCCESS;
+}
+// EfiStringArenaFree
+/// Free a string arena and every buffer allocated from it
+/// @param Arena The string arena
+/// @retval EFI_INVALID_PARAMETER If Arena is NULL
+/// @retval EFI_SUCCESS           If the arena was freed
+EFI_STATUS
+EFIAPI
+EfiStringArenaFree (
+  IN EFI_STRING_ARENA *Arena
+) {
+  EFI_STRING_ARENA_CHUNK *Chunk;
+  // Check parameters
+  if (Arena == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Free every chunk and then the arena
+  Chunk = Arena->Chunks;
+  while (Chunk != NULL) {
+    EFI_STRING_ARENA_CHUNK *Next = Chunk->Next;
+    EfiFreePool(Chunk);
+    Chunk = Next;
+  }
+  EfiFreePool(Arena);
+  return EFI_SUCCESS;
+}
+
+// StringBuilderTerminate
+/// Write the null terminator after the string of a string builder
+/// @param Builder The string builder
+STATIC
+VOID
+EFIAPI
+StringBuilderTerminate (
+  IN EFI_STRING_BUILDER *Builder
+) {
+  if (Builder->Buffer != NULL) {
+    EfiZeroMem(ADDRESS_OFFSET(VOID, Builder->Buffer, Builder->Size), Builder->Encoding->UnitSize);
+  }
+}
+
+// EfiStringBuilderInitialize
+/// Initialize a string builder
+/// @param Builder  The string builder to initialize
+/// @param Encoding The encoding of the string or NULL for UTF-16
+/// @param Arena    The arena from which to allocate the string buffer or NULL to allocate from pool
+/// @param Capacity The initial capacity in bytes of the string buffer or zero to allocate on first append
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the string builder was initialized
+EFI_STATUS
+EFIAPI
+EfiStringBuilderInitialize (
+  OUT EFI_STRING_BUILDER    *Builder,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_STRING_ARENA      *Arena OPTIONAL,
+  IN  UINTN                  Capacity
+) {
+  // Check parameters
+  if (Builder == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Encoding == NULL) {
+    Encoding = EfiUtf16Encoding();
+    if (Encoding == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+  if (Encoding->UnitSize == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Initialize the empty string builder
+  Builder->Encoding = Encoding;
+  Builder->Arena = Arena;
+  Builder->Buffer = NULL;
+  Builder->Size = 0;
+  Builder->Capacity = 0;
+  // Allocate the initial string buffer
+  if (Capacity > Encoding->UnitSize) {
+    return EfiStringBuilderReserve(Builder, Capacity - Encoding->UnitSize);
+  }
+  return EFI_SUCCESS;
+}
+// EfiStringBuilderReserve
+/// Make sure a string builder can append bytes without growing again
+/// @param Builder The string builder
+/// @param Size    The size in bytes that must be able to be appended, not including the null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the string buffer has room for the bytes
+EFI_STATUS
+EFIAPI
+EfiStringBuilderReserve (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     UINTN               Size
+) {
+  VOID  *Buffer;
+  UINTN  Needed;
+  UINTN  Capacity;
+  // Check parameters
+  if ((Builder == NULL) || (Builder->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the size needed for the string and the null terminator
+  Needed = Builder->Size + Builder->Encoding->UnitSize;
+  if (Size > (MAX_UINTN - EFI_STRING_ARENA_ALIGNMENT - Needed)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Needed += Size;
+  if ((Builder->Buffer != NULL) && (Needed <= Builder->Capacity)) {
+    return EFI_SUCCESS;
+  }
+  // Grow the capacity geometrically so appending is amortized constant time
+  Capacity = Builder->Capacity;
+  if (Capacity < EFI_STRING_BUILDER_DEFAULT_CAPACITY) {
+    Capacity = EFI_STRING_BUILDER_DEFAULT_CAPACITY;
+  }
+  while (Capacity < Needed) {
+    if (Capacity > (MAX_UINTN / 2)) {
+      Capacity = Needed;
+      break;
+    }
+    Capacity *= 2;
+  }
+  if (Builder->Arena != NULL) {
+    // Grow the buffer in place if it was the last arena allocation, otherwise move it to a new arena buffer
+    Capacity = EFI_STRING_ARENA_ALIGN(Capacity);
+    if (StringArenaResize(Builder->Arena, Builder->Buffer, Builder->Capacity, Capacity)) {
+      Builder->Capacity = Capacity;
+      return EFI_SUCCESS;
+    }
+    Buffer = EfiStringArenaAllocate(Builder->Arena, Capacity);
+    if (Buffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    if (Builder->Buffer != NULL) {
+      EfiCopyMem(Buffer, Builder->Buffer, Builder->Size + Builder->Encoding->UnitSize);
+    }
+  } else {
+    // Grow the pool buffer
+    Buffer = EfiReallocate(Capacity, Builder->Capacity, Builder->Buffer);
+    if (Buffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+  Builder->Buffer = Buffer;
+  Builder->Capacity = Capacity;
+  StringBuilderTerminate(Builder);
+  return EFI_SUCCESS;
+}
+// EfiStringBuilderAppendSpan
+/// Append already encoded characters to a string builder
+/// @param Builder The string builder
+/// @param Span    The encoded characters to append, which must be in the encoding of the string builder
+/// @param Size    The size in bytes of the encoded characters, not including any null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Span is NULL and Size is not zero
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the characters were appended
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendSpan (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     CONST VOID         *Span OPTIONAL,
+  IN     UINTN               Size
+) {
+  EFI_STATUS Status;
+  // Check parameters
+  if ((Builder == NULL) || ((Span == NULL) && (Size != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Make room for the characters and copy them
+  Status = EfiStringBuilderReserve(Builder, Size);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Size != 0) {
+    EfiCopyMem(ADDRESS_OFFSET(VOID, Builder->Buffer, Builder->Size), Span, Size);
+    Builder->Size += Size;
+    StringBuilderTerminate(Builder);
+  }
+  return EFI_SUCCESS;
+}
+// EfiStringBuilderAppendCharacter
+/// Append a character to a string builder
+/// @param Builder   The string builder
+/// @param Character The Unicode character to append
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the string builder
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the character was appended
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendCharacter (
+  IN OUT EFI_STRING_BUILDER *Builder,
+  IN     UINT32              Character
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize;
+  // Check parameters
+  if ((Builder == NULL) || (Builder->Encoding == NULL) || !IsUnicodeCharacter(Character)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Make room for the longest encoding of a character
+  Status = EfiStringBuilderReserve(Builder, Builder->Encoding->MaxUnits * Builder->Encoding->UnitSize);
+  if (EFI_ERROR(Status) || (Character == 0)) {
+    return Status;
+  }
+  // Encode the character after the string
+  ThisSize = Builder->Capacity - Builder->Size;
+  Status = EfiEncodeCharacter(Builder->Encoding, ADDRESS_OFFSET(VOID, Builder->Buffer, Builder->Size), &ThisSize, Character);
+  if (!EFI_ERROR(Status)) {
+    Builder->Size += ThisSize;
+  }
+  StringBuilderTerminate(Builder);
+  return Status;
+}
+// EfiStringBuilderAppendFormatted
+/// Append a formatted character string to a string builder
+/// @param Builder        The string builder
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param ...            The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the formatted character string was appended
+EFI_STATUS
+EFIAPI
+EfiStringBuilderAppendFormatted (
+  IN OUT EFI_STRING_BUILDER    *Builder,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Marker;
+  VA_START(Marker, FormatSize);
+  Status = EfiStringBuilderVAppendFormatted(Builder, Locale, FormatEncoding, Format, FormatSize, Marker);
+  VA_END(Marker);
+  return Status;
+}
+// EfiStringBuilderVAppendFormatted
+/// Append a formatted character string to a string builder
+/// @param Builder        The string builder
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param Marker         The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL or not initialized or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS           If the formatted character string was appended
+EFI_STATUS
+EFIAPI
+EfiStringBuilderVAppendFormatted (
+  IN OUT EFI_STRING_BUILDER    *Builder,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  IN     VA_LIST                Marker
+) {
+  EFI_STATUS Status;
+  UINTN      UnitSize;
+  UINTN      ThisSize;
+  VA_LIST    Arguments;
+  // Check parameters
+  if ((Builder == NULL) || (Builder->Encoding == NULL) || (FormatEncoding == NULL) || (Format == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  UnitSize = Builder->Encoding->UnitSize;
+  // Make sure there is a string buffer
+  Status = EfiStringBuilderReserve(Builder, 0);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Print into the remaining capacity, most strings fit so they are only formatted once
+  ThisSize = Builder->Capacity - Builder->Size;
+  VA_COPY(Arguments, Marker);
+  Status = EfiLocaleVSPrint(Locale, Builder->Encoding, ADDRESS_OFFSET(VOID, Builder->Buffer, Builder->Size), &ThisSize, FormatEncoding, Format, FormatSize, Arguments);
+  VA_END(Arguments);
+  if ((Status == EFI_BUFFER_TOO_SMALL) && (ThisSize > UnitSize)) {
+    // Grow to the size that is now known and print again
+    Status = EfiStringBuilderReserve(Builder, ThisSize - UnitSize);
+    if (!EFI_ERROR(Status)) {
+      ThisSize = Builder->Capacity - Builder->Size;
+      Status = EfiLocaleVSPrint(Locale, Builder->Encoding, ADDRESS_OFFSET(VOID, Builder->Buffer, Builder->Size), &ThisSize, FormatEncoding, Format, FormatSize, Marker);
+    }
+  }
+  // Add the printed characters without their null terminator
+  if (!EFI_ERROR(Status) && (ThisSize > UnitSize)) {
+    Builder->Size += ThisSize - UnitSize;
+  }
+  StringBuilderTerminate(Builder);
+  return Status;
+}
+// EfiStringBuilderSteal
+/// Take the string buffer from a string builder, shrinking it to fit the string, the string builder is left empty but still initialized
+/// @param Builder The string builder
+/// @param Buffer  On output, the null terminated string, which must be freed with EfiFreePool unless the string builder has an arena
+/// @param Size    On output, the size in bytes of the string, including the null terminator
+/// @retval EFI_INVALID_PARAMETER If Builder or Buffer is NULL or Builder is not initialized
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for an empty string
+/// @retval EFI_SUCCESS           If the string buffer was returned
+EFI_STATUS
+EFIAPI
+EfiStringBuilderSteal (
+  IN OUT EFI_STRING_BUILDER  *Builder,
+  OUT    VOID               **Buffer,
+  OUT    UINTN               *Size OPTIONAL
+) {
+  EFI_STATUS  Status;
+  VOID       *Shrunk;
+  UINTN       Needed;
+  // Check parameters
+  if ((Builder == NULL) || (Builder->Encoding == NULL) || (Buffer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Make sure there is a string buffer even if nothing was appended
+  Status = EfiStringBuilderReserve(Builder, 0);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Shrink the string buffer to fit so the string does not keep the growth capacity, keep it as is if it can not be shrunk
+  Needed = Builder->Size + Builder->Encoding->UnitSize;
+  if (Builder->Arena != NULL) {
+    Needed = EFI_STRING_ARENA_ALIGN(Needed);
+    if ((Needed < Builder->Capacity) && StringArenaResize(Builder->Arena, Builder->Buffer, Builder->Capacity, Needed)) {
+      Builder->Capacity = Needed;
+    }
+  } else if (Needed < Builder->Capacity) {
+    Shrunk = EfiReallocate(Needed, Builder->Capacity, Builder->Buffer);
+    if (Shrunk != NULL) {
+      Builder->Buffer = Shrunk;
+      Builder->Capacity = Needed;
+    }
+  }
+  // Hand over the string buffer and leave the builder empty
+  *Buffer = Builder->Buffer;
+  if (Size != NULL) {
+    *Size = Builder->Size + Builder->Encoding->UnitSize;
+  }
+  Builder->Buffer = NULL;
+  Builder->Size = 0;
+  Builder->Capacity = 0;
+  return EFI_SUCCESS;
+}
+// EfiStringBuilderFree
+/// Free the string buffer of a string builder, the string builder is left empty but still initialized
+/// @param Builder The string builder
+/// @retval EFI_INVALID_PARAMETER If Builder is NULL
+/// @retval EFI_SUCCESS           If the string buffer was freed
+EFI_STATUS
+EFIAPI
+EfiStringBuilderFree (
+  IN OUT EFI_STRING_BUILDER *Builder
+) {
+  // Check parameters
+  if (Builder == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Builder->Buffer != NULL) {
+    if (Builder->Arena != NULL) {
+      // Give the space back to the arena if the buffer was the last allocation
+      StringArenaResize(Builder->Arena, Builder->Buffer, Builder->Capacity, 0);
+    } else {
+      EfiFreePool(Builder->Buffer);
+    }
+  }
+  Builder->Buffer = NULL;
+  Builder->Size = 0;
+  Builder->Capacity = 0;
+  return EFI_SUCCESS;
+}
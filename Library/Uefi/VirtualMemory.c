@@ -1115,6 +1115,7 @@ VMemGetMemoryMap (
   UINTN                  AvailableMapSize;
   UINTN                  MapSize;
   UINTN                  DescSize;
+  BOOLEAN                Sorted;
   if ((This == NULL) || (This->GetMemoryMap == NULL)) {
     return EFI_UNSUPPORTED;
   }
@@ -1136,6 +1137,8 @@ VMemGetMemoryMap (
   // Get the memory and descriptor sizes
   MapSize = *MemoryMapSize;
   DescSize = *DescriptorSize;
+  // Sort the descriptors first so each descriptor only needs to be checked against the following overlapping or adjacent descriptors
+  Sorted = !EFI_ERROR(EfiSortMemoryMap(MemoryMap, MapSize, DescSize));
   // Sort and remove duplicate or invalid descriptors
   Descriptor1 = NULL;
   while (!EFI_ERROR(EfiGetNextMemoryDescriptor(MemoryMap, MapSize, DescSize, &Descriptor1))) {
@@ -1224,6 +1227,9 @@ VMemGetMemoryMap (
         } else if (Descriptor1->PhysicalStart > Descriptor2->PhysicalStart) {
           // Swap the descriptors
           EfiByteSwapMemoryDescriptor(MemoryMap, MapSize, DescSize, Descriptor1, Descriptor2);
+        } else if (Sorted) {
+          // No following descriptor can overlap or be adjacent to this region
+          break;
         } else {
           // This appears to be a skippable region for now
           continue;
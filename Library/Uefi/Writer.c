@@ -0,0 +1,662 @@
+///
+/// @file Library/Uefi/Writer.c
+///
+/// UEFI buffered encoded character stream writer
+///
+
+#include <Uefi.h>
+
+// EFI_WRITER_REPLACEMENT_CHARACTER
+/// The character written in place of an unpaired surrogate
+#define EFI_WRITER_REPLACEMENT_CHARACTER 0xFFFD
+
+// WriterBuilderOutput
+/// Output the buffered bytes of a writer to a string builder
+/// @param Context The string builder
+/// @param Buffer  The encoded bytes to output
+/// @param Size    The size in bytes of the encoded bytes
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated for the string buffer
+/// @retval EFI_SUCCESS          If the bytes were appended
+STATIC
+EFI_STATUS
+EFIAPI
+WriterBuilderOutput (
+  IN VOID       *Context,
+  IN CONST VOID *Buffer,
+  IN UINTN       Size
+) {
+  return EfiStringBuilderAppendSpan((EFI_STRING_BUILDER *)Context, Buffer, Size);
+}
+// WriterFileCreate
+/// Create the temporary file of a file writer next to the file
+/// @param Writer The file writer
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated for the temporary file path
+/// @retval EFI_NOT_FOUND        If the name of the file could not be found
+/// @retval EFI_SUCCESS          If the temporary file was created
+/// @return Any other status returned by opening the temporary file
+STATIC
+EFI_STATUS
+EFIAPI
+WriterFileCreate (
+  IN OUT EFI_WRITER *Writer
+) {
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL *File = NULL;
+  // Name the temporary file after the file, the root is the file when there is no path
+  if (Writer->Path != NULL) {
+    Writer->Temporary = EfiPoolPrint(L"%s.tmp", Writer->Path);
+  } else {
+    EFI_FILE_INFO *Info = EfiFileInfo(Writer->Root);
+    if (Info == NULL) {
+      return EFI_NOT_FOUND;
+    }
+    Writer->Temporary = EfiPoolPrint(L"..\\%s.tmp", Info->FileName);
+    EfiFreePool(Info);
+  }
+  if (Writer->Temporary == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Delete a temporary file left by a write that did not finish so nothing of it remains past the new output
+  if (!EFI_ERROR(EfiFileOpen(Writer->Root, &File, Writer->Temporary, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE, 0)) && (File != NULL)) {
+    EfiFileDelete(File);
+  }
+  File = NULL;
+  // Create the temporary file
+  Status = EfiFileOpen(Writer->Root, &File, Writer->Temporary, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (File == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  Writer->File = File;
+  return EFI_SUCCESS;
+}
+// WriterFileCopy
+/// Copy the temporary file of a file writer over the file when the root is the file, through the writer buffer
+/// @param Writer The file writer, all the buffered bytes must have been output
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated for the file information
+/// @retval EFI_VOLUME_FULL      If not all the bytes could be copied
+/// @retval EFI_SUCCESS          If the file was replaced
+/// @return Any other status returned by opening, reading or writing the files
+STATIC
+EFI_STATUS
+EFIAPI
+WriterFileCopy (
+  IN OUT EFI_WRITER *Writer
+) {
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL *Target = NULL;
+  EFI_FILE_INFO     *Info;
+  UINT64             Remaining;
+  UINTN              Size;
+  UINTN              ThisSize;
+  // Open the file again to write from the start without changing the position of the root
+  Status = EfiFileOpen(Writer->Root, &Target, NULL, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE, 0);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Target == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  // Copy the temporary file
+  Status = EfiFileSetPosition(Writer->File, 0);
+  for (Remaining = Writer->Total; !EFI_ERROR(Status) && (Remaining != 0); Remaining -= Size) {
+    Size = (Remaining > EFI_WRITER_BUFFER_SIZE) ? EFI_WRITER_BUFFER_SIZE : (UINTN)Remaining;
+    ThisSize = Size;
+    Status = EfiFileRead(Writer->File, &ThisSize, Writer->Buffer);
+    if (!EFI_ERROR(Status)) {
+      if (ThisSize != Size) {
+        Status = EFI_END_OF_FILE;
+      } else {
+        Status = EfiFileWrite(Target, &ThisSize, Writer->Buffer);
+        if (!EFI_ERROR(Status) && (ThisSize != Size)) {
+          Status = EFI_VOLUME_FULL;
+        }
+      }
+    }
+  }
+  // Truncate the rest of the file if it was longer
+  if (!EFI_ERROR(Status)) {
+    Info = EfiFileInfo(Target);
+    if (Info == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+    } else {
+      if (Info->FileSize != Writer->Total) {
+        Info->FileSize = Writer->Total;
+        Status = EfiSetFileInfo(Target, &gEfiFileInfoGuid, (UINTN)(Info->Size), Info);
+      }
+      EfiFreePool(Info);
+    }
+  }
+  EfiFileClose(Target);
+  return Status;
+}
+// WriterFileReplace
+/// Replace the file of a file writer with the temporary file and close the temporary file
+/// @param Writer The file writer, all the buffered bytes must have been output
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated for the file information
+/// @retval EFI_ACCESS_DENIED    If the file could not be deleted
+/// @retval EFI_SUCCESS          If the file was replaced
+/// @return Any other status returned by flushing, opening, copying or renaming the files, the temporary file is deleted if the file is unchanged, otherwise it is kept with the complete output
+STATIC
+EFI_STATUS
+EFIAPI
+WriterFileReplace (
+  IN OUT EFI_WRITER *Writer
+) {
+  EFI_STATUS         Status;
+  EFI_FILE_PROTOCOL *Target = NULL;
+  EFI_FILE_INFO     *Info;
+  CONST CHAR16      *Name;
+  CONST CHAR16      *Character;
+  // Make sure the temporary file is complete before it replaces the file
+  Status = EfiFileFlush(Writer->File);
+  if (EFI_ERROR(Status)) {
+    EfiFileDelete(Writer->File);
+    return Status;
+  }
+  // The root is the file and can not be deleted so copy the temporary file over it
+  if (Writer->Path == NULL) {
+    Status = WriterFileCopy(Writer);
+    if (EFI_ERROR(Status)) {
+      EfiFileClose(Writer->File);
+    } else {
+      EfiFileDelete(Writer->File);
+    }
+    return Status;
+  }
+  // Delete the file so the temporary file can be renamed to the file name
+  Status = EfiFileOpen(Writer->Root, &Target, Writer->Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE, 0);
+  if (!EFI_ERROR(Status) && (Target != NULL)) {
+    if (EfiFileDelete(Target) != EFI_SUCCESS) {
+      EfiFileDelete(Writer->File);
+      return EFI_ACCESS_DENIED;
+    }
+  } else if (Status != EFI_NOT_FOUND) {
+    EfiFileDelete(Writer->File);
+    return EFI_ERROR(Status) ? Status : EFI_NOT_FOUND;
+  }
+  // Rename the temporary file to the last component of the path, which is no longer than the temporary file name
+  Name = Writer->Path;
+  for (Character = Writer->Path; *Character != 0; ++Character) {
+    if ((*Character == L'\\') || (*Character == L'/')) {
+      Name = Character + 1;
+    }
+  }
+  Info = EfiFileInfo(Writer->File);
+  if (Info == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+  } else {
+    EfiCopyMem(Info->FileName, (VOID *)Name, StrSize(Name));
+    Info->Size = OFFSET_OF(EFI_FILE_INFO, FileName) + StrSize(Name);
+    Status = EfiSetFileInfo(Writer->File, &gEfiFileInfoGuid, (UINTN)(Info->Size), Info);
+    EfiFreePool(Info);
+  }
+  EfiFileClose(Writer->File);
+  return Status;
+}
+// WriterFileOutput
+/// Output the buffered bytes of a writer to the temporary file of a file writer, creating the temporary file the first time
+/// @param Context The file writer
+/// @param Buffer  The encoded bytes to output
+/// @param Size    The size in bytes of the encoded bytes
+/// @retval EFI_VOLUME_FULL If not all the bytes could be written
+/// @retval EFI_SUCCESS     If the bytes were written
+/// @return Any other status returned by creating or writing the temporary file
+STATIC
+EFI_STATUS
+EFIAPI
+WriterFileOutput (
+  IN VOID       *Context,
+  IN CONST VOID *Buffer,
+  IN UINTN       Size
+) {
+  EFI_STATUS  Status;
+  EFI_WRITER *Writer = (EFI_WRITER *)Context;
+  UINTN       Written = Size;
+  // Create the temporary file when there is first something to write
+  if (Writer->File == NULL) {
+    Status = WriterFileCreate(Writer);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  // Write the bytes to the temporary file
+  Status = EfiFileWrite(Writer->File, &Written, (VOID *)Buffer);
+  if (!EFI_ERROR(Status) && (Written != Size)) {
+    Status = EFI_VOLUME_FULL;
+  }
+  return Status;
+}
+
+// EfiWriterInitialize
+/// Initialize a writer with an output callback
+/// @param Writer   The writer to initialize
+/// @param Encoding The encoding of the output or NULL for UTF-16
+/// @param Output   The output callback
+/// @param Context  The context of the output callback
+/// @retval EFI_INVALID_PARAMETER If Writer or Output is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_SUCCESS           If the writer was initialized
+EFI_STATUS
+EFIAPI
+EfiWriterInitialize (
+  OUT EFI_WRITER            *Writer,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_WRITER_OUTPUT      Output,
+  IN  VOID                  *Context OPTIONAL
+) {
+  // Check parameters
+  if ((Writer == NULL) || (Output == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Encoding == NULL) {
+    Encoding = EfiUtf16Encoding();
+    if (Encoding == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+  if ((Encoding->UnitSize == 0) || ((Encoding->MaxUnits * Encoding->UnitSize) > EFI_WRITER_BUFFER_SIZE)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Initialize the empty writer
+  Writer->Encoding = Encoding;
+  Writer->Output = Output;
+  Writer->Context = Context;
+  Writer->Root = NULL;
+  Writer->Path = NULL;
+  Writer->File = NULL;
+  Writer->Temporary = NULL;
+  Writer->Total = 0;
+  Writer->Size = 0;
+  return EFI_SUCCESS;
+}
+// EfiWriterInitializeBuilder
+/// Initialize a writer that appends its output to a string builder
+/// @param Writer  The writer to initialize
+/// @param Builder The initialized string builder, the output is in the encoding of the string builder
+/// @retval EFI_INVALID_PARAMETER If Writer or Builder is NULL or Builder is not initialized
+/// @retval EFI_SUCCESS           If the writer was initialized
+EFI_STATUS
+EFIAPI
+EfiWriterInitializeBuilder (
+  OUT EFI_WRITER         *Writer,
+  IN  EFI_STRING_BUILDER *Builder
+) {
+  // Check parameters
+  if ((Builder == NULL) || (Builder->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  return EfiWriterInitialize(Writer, Builder->Encoding, WriterBuilderOutput, Builder);
+}
+// EfiWriterInitializeFile
+/// Initialize a writer that writes its output to a temporary file next to a file, which replaces the file only when the writer is closed without error so a failed write never changes the file
+/// @param Writer   The writer to initialize, which must be closed with EfiWriterClose
+/// @param Encoding The encoding of the output or NULL for UTF-16
+/// @param Root     The root file protocol interface
+/// @param Path     The path of the file relative to the root, which must remain valid until the writer is closed, or NULL if Root is already the file
+/// @retval EFI_INVALID_PARAMETER If Writer or Root is NULL
+/// @retval EFI_UNSUPPORTED       If Encoding is NULL and the UTF-16 encoding could not be found
+/// @retval EFI_SUCCESS           If the writer was initialized
+EFI_STATUS
+EFIAPI
+EfiWriterInitializeFile (
+  OUT EFI_WRITER            *Writer,
+  IN  EFI_ENCODING_PROTOCOL *Encoding OPTIONAL,
+  IN  EFI_FILE_PROTOCOL     *Root,
+  IN  CONST CHAR16          *Path OPTIONAL
+) {
+  EFI_STATUS Status;
+  // Check parameters
+  if (Root == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // The file writer is its own output context so the file can be opened lazily
+  Status = EfiWriterInitialize(Writer, Encoding, WriterFileOutput, Writer);
+  if (!EFI_ERROR(Status)) {
+    Writer->Root = Root;
+    Writer->Path = Path;
+  }
+  return Status;
+}
+
+// EfiWriterWriteSpan
+/// Write already encoded characters
+/// @param Writer The writer
+/// @param Span   The encoded characters to write, which must be in the encoding of the writer
+/// @param Size   The size in bytes of the encoded characters
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Span is NULL and Size is not zero
+/// @retval EFI_SUCCESS           If the characters were written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteSpan (
+  IN OUT EFI_WRITER *Writer,
+  IN     CONST VOID *Span OPTIONAL,
+  IN     UINTN       Size
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Output == NULL) || ((Span == NULL) && (Size != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Fill the buffer and output it each time it is full
+  while (Size != 0) {
+    if ((Writer->Size == 0) && (Size >= EFI_WRITER_BUFFER_SIZE)) {
+      // Output whole buffers of the span directly instead of copying them
+      ThisSize = Size - (Size % EFI_WRITER_BUFFER_SIZE);
+      Status = Writer->Output(Writer->Context, Span, ThisSize);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      Writer->Total += ThisSize;
+    } else {
+      ThisSize = EFI_WRITER_BUFFER_SIZE - Writer->Size;
+      if (ThisSize > Size) {
+        ThisSize = Size;
+      }
+      EfiCopyMem(Writer->Buffer + Writer->Size, Span, ThisSize);
+      Writer->Size += ThisSize;
+      if (Writer->Size == EFI_WRITER_BUFFER_SIZE) {
+        Status = EfiWriterFlush(Writer);
+        if (EFI_ERROR(Status)) {
+          return Status;
+        }
+      }
+    }
+    Span = ADDRESS_OFFSET(CONST VOID, Span, ThisSize);
+    Size -= ThisSize;
+  }
+  return EFI_SUCCESS;
+}
+// EfiWriterWriteCharacter
+/// Write a character
+/// @param Writer    The writer
+/// @param Character The Unicode character to write
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the writer, nothing was written
+/// @retval EFI_SUCCESS           If the character was written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteCharacter (
+  IN OUT EFI_WRITER *Writer,
+  IN     UINT32      Character
+) {
+  EFI_STATUS Status;
+  UINTN      ThisSize;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Encoding == NULL) || (Character == 0) || !IsUnicodeCharacter(Character)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Make room for the longest encoding of a character
+  if ((EFI_WRITER_BUFFER_SIZE - Writer->Size) < (Writer->Encoding->MaxUnits * Writer->Encoding->UnitSize)) {
+    Status = EfiWriterFlush(Writer);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  // Encode the character directly into the buffer
+  ThisSize = EFI_WRITER_BUFFER_SIZE - Writer->Size;
+  Status = EfiEncodeCharacter(Writer->Encoding, Writer->Buffer + Writer->Size, &ThisSize, Character);
+  if (!EFI_ERROR(Status)) {
+    Writer->Size += ThisSize;
+  }
+  return Status;
+}
+// EfiWriterWriteFill
+/// Write a character repeatedly
+/// @param Writer    The writer
+/// @param Character The Unicode character to write
+/// @param Count     The count of times to write the character
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or Character is invalid
+/// @retval EFI_NO_MAPPING        If the character can not be encoded with the encoding of the writer, nothing was written
+/// @retval EFI_SUCCESS           If the characters were written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteFill (
+  IN OUT EFI_WRITER *Writer,
+  IN     UINT32      Character,
+  IN     UINTN       Count
+) {
+  EFI_STATUS Status;
+  // Write the character the count of times
+  for (; Count != 0; --Count) {
+    Status = EfiWriterWriteCharacter(Writer, Character);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// EfiWriterWriteString
+/// Write a string transcoded to the encoding of the writer
+/// @param Writer The writer
+/// @param String The string to write, unpaired surrogates are written as the replacement character
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_NO_MAPPING        If a character can not be encoded with the encoding of the writer, the characters before it were written
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteString (
+  IN OUT EFI_WRITER   *Writer,
+  IN     CONST CHAR16 *String OPTIONAL
+) {
+  EFI_STATUS Status;
+  UINT32     Character;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (String == NULL) {
+    return EFI_SUCCESS;
+  }
+  // Decode each character, combining surrogate pairs, and encode it into the buffer
+  while (*String != 0) {
+    Character = *String++;
+    if ((Character >= 0xD800) && (Character <= 0xDBFF) && (*String >= 0xDC00) && (*String <= 0xDFFF)) {
+      Character = 0x10000 + ((Character - 0xD800) << 10) + (*String++ - 0xDC00);
+    } else if ((Character >= 0xD800) && (Character <= 0xDFFF)) {
+      Character = EFI_WRITER_REPLACEMENT_CHARACTER;
+    }
+    Status = EfiWriterWriteCharacter(Writer, Character);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// EfiWriterWriteAscii
+/// Write a string transcoded to the encoding of the writer
+/// @param Writer The writer
+/// @param String The string to write
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_NO_MAPPING        If a character can not be encoded with the encoding of the writer, the characters before it were written
+/// @retval EFI_SUCCESS           If the string was written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteAscii (
+  IN OUT EFI_WRITER  *Writer,
+  IN     CONST CHAR8 *String OPTIONAL
+) {
+  EFI_STATUS Status;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Encoding == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (String == NULL) {
+    return EFI_SUCCESS;
+  }
+  // Encode each character into the buffer
+  for (; *String != 0; ++String) {
+    Status = EfiWriterWriteCharacter(Writer, (UINT8)*String);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// EfiWriterWriteFormatted
+/// Write a formatted character string
+/// @param Writer         The writer
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param ...            The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or FormatEncoding or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the formatted string was larger than the buffer and memory could not be allocated for it
+/// @retval EFI_SUCCESS           If the formatted character string was written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterWriteFormatted (
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Marker;
+  VA_START(Marker, FormatSize);
+  Status = EfiWriterVWriteFormatted(Writer, Locale, FormatEncoding, Format, FormatSize, Marker);
+  VA_END(Marker);
+  return Status;
+}
+// EfiWriterVWriteFormatted
+/// Write a formatted character string
+/// @param Writer         The writer
+/// @param Locale         The locale to use in formatting or NULL for the current locale
+/// @param FormatEncoding The encoding of the format specifier string
+/// @param Format         The format specifier string
+/// @param FormatSize     The size in bytes of the format specifier string
+/// @param Marker         The arguments to format
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized or FormatEncoding or Format is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If the formatted string was larger than the buffer and memory could not be allocated for it
+/// @retval EFI_SUCCESS           If the formatted character string was written
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterVWriteFormatted (
+  IN OUT EFI_WRITER            *Writer,
+  IN     EFI_LOCALE_PROTOCOL   *Locale OPTIONAL,
+  IN     EFI_ENCODING_PROTOCOL *FormatEncoding,
+  IN     CONST VOID            *Format,
+  IN     UINTN                  FormatSize,
+  IN     VA_LIST                Marker
+) {
+  EFI_STATUS  Status;
+  VOID       *Formatted;
+  UINTN       UnitSize;
+  UINTN       ThisSize;
+  VA_LIST     Arguments;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Encoding == NULL) || (FormatEncoding == NULL) || (Format == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  UnitSize = Writer->Encoding->UnitSize;
+  // Print into the remaining buffer, most strings fit so they are only formatted once
+  ThisSize = EFI_WRITER_BUFFER_SIZE - Writer->Size;
+  VA_COPY(Arguments, Marker);
+  Status = EfiLocaleVSPrint(Locale, Writer->Encoding, Writer->Buffer + Writer->Size, &ThisSize, FormatEncoding, Format, FormatSize, Arguments);
+  VA_END(Arguments);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    if (ThisSize <= EFI_WRITER_BUFFER_SIZE) {
+      // Output the buffer to make room and print again
+      Status = EfiWriterFlush(Writer);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      ThisSize = EFI_WRITER_BUFFER_SIZE;
+      Status = EfiLocaleVSPrint(Locale, Writer->Encoding, Writer->Buffer, &ThisSize, FormatEncoding, Format, FormatSize, Marker);
+    } else {
+      // The formatted string is larger than the whole buffer so it has to be allocated
+      Formatted = EfiLocalePoolVPrint(Locale, Writer->Encoding, &ThisSize, FormatEncoding, Format, FormatSize, Marker);
+      if (Formatted == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      Status = EfiWriterWriteSpan(Writer, Formatted, (ThisSize > UnitSize) ? (ThisSize - UnitSize) : 0);
+      EfiFreePool(Formatted);
+      return Status;
+    }
+  }
+  // Add the printed characters without their null terminator
+  if (!EFI_ERROR(Status) && (ThisSize > UnitSize)) {
+    Writer->Size += ThisSize - UnitSize;
+  }
+  return Status;
+}
+
+// EfiWriterFlush
+/// Output the buffered bytes of a writer
+/// @param Writer The writer
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the buffered bytes were output
+/// @return Any other status returned by the output
+EFI_STATUS
+EFIAPI
+EfiWriterFlush (
+  IN OUT EFI_WRITER *Writer
+) {
+  EFI_STATUS Status;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Output == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Writer->Size == 0) {
+    return EFI_SUCCESS;
+  }
+  // Output the buffer
+  Status = Writer->Output(Writer->Context, Writer->Buffer, Writer->Size);
+  if (!EFI_ERROR(Status)) {
+    Writer->Total += Writer->Size;
+    Writer->Size = 0;
+  }
+  return Status;
+}
+// EfiWriterClose
+/// Output the buffered bytes of a writer and close the file of a file writer, the writer must be initialized again before reuse
+/// @param Writer  The writer
+/// @param Discard Whether to discard the output, such as after an error, the temporary file of a file writer is deleted and the file is left unchanged
+/// @retval EFI_INVALID_PARAMETER If Writer is NULL or not initialized
+/// @retval EFI_SUCCESS           If the buffered bytes were output and the writer was closed
+/// @return Any other status returned by the output, the writer is still closed
+EFI_STATUS
+EFIAPI
+EfiWriterClose (
+  IN OUT EFI_WRITER *Writer,
+  IN     BOOLEAN     Discard
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  // Check parameters
+  if ((Writer == NULL) || (Writer->Output == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Output what is left in the buffer
+  if (!Discard) {
+    Status = EfiWriterFlush(Writer);
+  }
+  // Replace the file of a file writer with the temporary file or delete the temporary file after an error
+  if (Writer->File != NULL) {
+    if (!Discard && !EFI_ERROR(Status)) {
+      Status = WriterFileReplace(Writer);
+    } else {
+      EfiFileDelete(Writer->File);
+    }
+    Writer->File = NULL;
+  }
+  if (Writer->Temporary != NULL) {
+    EfiFreePool(Writer->Temporary);
+    Writer->Temporary = NULL;
+  }
+  Writer->Output = NULL;
+  Writer->Size = 0;
+  return Status;
+}
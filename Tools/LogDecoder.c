@@ -0,0 +1,993 @@
+///
+/// @file Tools/LogDecoder.c
+///
+/// Host tool that decodes a binary log file into text
+///
+/// The binary log records are described in Include/Uefi/Protocol/Log.h, this tool only uses the C standard library
+///  so it builds on any host, which means the record layouts are repeated here and must be kept the same
+///
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// LOG_DECODER_SIGNATURE
+/// The binary log session signature, EFI_LOG_BINARY_SIGNATURE
+#define LOG_DECODER_SIGNATURE 0x474F4C4E49424C43ULL
+// LOG_DECODER_VERSION
+/// The binary log format version, EFI_LOG_BINARY_VERSION
+#define LOG_DECODER_VERSION 1
+// LOG_DECODER_TYPE_SESSION
+/// A session record, EFI_LOG_BINARY_TYPE_SESSION
+#define LOG_DECODER_TYPE_SESSION 1
+// LOG_DECODER_TYPE_FORMAT
+/// A format record, EFI_LOG_BINARY_TYPE_FORMAT
+#define LOG_DECODER_TYPE_FORMAT 2
+// LOG_DECODER_TYPE_MESSAGE
+/// A message record, EFI_LOG_BINARY_TYPE_MESSAGE
+#define LOG_DECODER_TYPE_MESSAGE 3
+
+// LOG_DECODER_HEADER_SIZE
+/// The size in bytes of a record header, EFI_LOG_BINARY_HEADER
+#define LOG_DECODER_HEADER_SIZE 8
+// LOG_DECODER_SESSION_SIZE
+/// The size in bytes of a session record, EFI_LOG_BINARY_SESSION
+#define LOG_DECODER_SESSION_SIZE 32
+// LOG_DECODER_FORMAT_SIZE
+/// The size in bytes of a format record before the format specifier string, EFI_LOG_BINARY_FORMAT
+#define LOG_DECODER_FORMAT_SIZE 16
+// LOG_DECODER_MESSAGE_SIZE
+/// The size in bytes of a message record before the arguments, EFI_LOG_BINARY_MESSAGE
+#define LOG_DECODER_MESSAGE_SIZE 32
+
+// LOG_DECODER_FIELD_SIZE
+/// The size in bytes of the buffer an argument is formatted into, copied strings are at most 256 characters
+#define LOG_DECODER_FIELD_SIZE 2048
+
+// LOG_DECODER_FLAG_LEFT_JUSTIFY
+/// Left justify instead of right justify
+#define LOG_DECODER_FLAG_LEFT_JUSTIFY 0x0001
+// LOG_DECODER_FLAG_PREFIX_SIGN
+/// Prefix the integer sign
+#define LOG_DECODER_FLAG_PREFIX_SIGN 0x0002
+// LOG_DECODER_FLAG_SEPARATOR
+/// Separate integer digits into groups of three
+#define LOG_DECODER_FLAG_SEPARATOR 0x0004
+// LOG_DECODER_FLAG_LONG
+/// Long integer argument
+#define LOG_DECODER_FLAG_LONG 0x0008
+// LOG_DECODER_FLAG_PAD_ZEROES
+/// Pad with zeroes instead of spaces
+#define LOG_DECODER_FLAG_PAD_ZEROES 0x0010
+// LOG_DECODER_FLAG_PRECISION
+/// Parsing the precision instead of the width
+#define LOG_DECODER_FLAG_PRECISION 0x0020
+// LOG_DECODER_FLAG_WIDTH_AS_ARG
+/// The width was an argument
+#define LOG_DECODER_FLAG_WIDTH_AS_ARG 0x0040
+// LOG_DECODER_FLAG_PRECISION_AS_ARG
+/// The precision was an argument
+#define LOG_DECODER_FLAG_PRECISION_AS_ARG 0x0080
+// LOG_DECODER_FLAG_UPPERCASE
+/// Uppercase digits
+#define LOG_DECODER_FLAG_UPPERCASE 0x0100
+// LOG_DECODER_FLAG_SIGNED
+/// Signed integer argument
+#define LOG_DECODER_FLAG_SIGNED 0x0200
+
+// LOG_DECODER_FORMAT
+/// A format specifier string defined in a session
+typedef struct LOG_DECODER_FORMAT LOG_DECODER_FORMAT;
+struct LOG_DECODER_FORMAT {
+
+  // Format
+  /// The null terminated UTF-16 format specifier string in the file contents or NULL if not defined
+  const uint8_t *Format;
+  // Length
+  /// The count of characters of the format specifier string including the null terminator
+  uint32_t       Length;
+
+};
+
+// LOG_DECODER
+/// The decoder state
+typedef struct LOG_DECODER LOG_DECODER;
+struct LOG_DECODER {
+
+  // Output
+  /// The text output
+  FILE               *Output;
+  // Raw
+  /// Whether to omit the time stamp and processor prefix of each line
+  int                 Raw;
+  // AtLineStart
+  /// Whether the next character starts a line
+  int                 AtLineStart;
+  // PointerSize
+  /// The size in bytes of pointer and native integer arguments in the session
+  uint32_t            PointerSize;
+  // Frequency
+  /// The count of time stamp ticks per second in the session or zero if unknown
+  uint64_t            Frequency;
+  // TimeStamp
+  /// The time stamp of the current message
+  uint64_t            TimeStamp;
+  // Processor
+  /// The processor number of the current message
+  uint32_t            Processor;
+  // Formats
+  /// The format specifier strings defined in the session, indexed by identifier
+  LOG_DECODER_FORMAT *Formats;
+  // FormatCount
+  /// The count of format specifier strings in the table
+  uint32_t            FormatCount;
+
+};
+
+// LOG_DECODER_STATUS
+/// A status code description
+typedef struct LOG_DECODER_STATUS LOG_DECODER_STATUS;
+struct LOG_DECODER_STATUS {
+
+  // Code
+  /// The status code without the error bit
+  uint32_t    Code;
+  // Error
+  /// Whether the status code is an error
+  int         Error;
+  // String
+  /// The status code description
+  const char *String;
+
+};
+
+// mStatusStrings
+/// Status code descriptions, the same as Library/Uefi/Status.c
+static const LOG_DECODER_STATUS mStatusStrings[] = {
+  { 0, 0, "Success" },
+  { 1, 0, "Warning Unknown Glyph" },
+  { 2, 0, "Warning Delete Failure" },
+  { 3, 0, "Warning Write Failure" },
+  { 4, 0, "Warning Buffer Too Small" },
+  { 5, 0, "Warning Stale Data" },
+  { 6, 0, "Warning Efi-Compliant File System" },
+  { 7, 0, "Warning Reset Required" },
+  { 1, 1, "Load Error" },
+  { 2, 1, "Invalid Parameter" },
+  { 3, 1, "Unsupported" },
+  { 4, 1, "Bad Buffer Size" },
+  { 5, 1, "Buffer Too Small" },
+  { 6, 1, "Not Ready" },
+  { 7, 1, "Device Error" },
+  { 8, 1, "Write Protected" },
+  { 9, 1, "Out of Resources" },
+  { 10, 1, "Volume Corrupt" },
+  { 11, 1, "Volume Full" },
+  { 12, 1, "No Media" },
+  { 13, 1, "Media changed" },
+  { 14, 1, "Not Found" },
+  { 15, 1, "Access Denied" },
+  { 16, 1, "No Response" },
+  { 17, 1, "No mapping" },
+  { 18, 1, "Time out" },
+  { 19, 1, "Not started" },
+  { 20, 1, "Already started" },
+  { 21, 1, "Aborted" },
+  { 22, 1, "ICMP Error" },
+  { 23, 1, "TFTP Error" },
+  { 24, 1, "Protocol Error" },
+  { 25, 1, "Incompatible Version" },
+  { 26, 1, "Security Violation" },
+  { 27, 1, "CRC Error" },
+  { 28, 1, "End of Media" },
+  { 31, 1, "End of File" },
+  { 32, 1, "Invalid Language" },
+  { 33, 1, "Compromised Data" },
+  { 34, 1, "IP Address Conflict" },
+  { 35, 1, "HTTP Network Error" },
+};
+
+// LogDecoderRead
+/// Read a little endian unsigned integer
+/// @param Data The data to read
+/// @param Size The size in bytes of the integer, at most eight
+/// @return The integer
+static
+uint64_t
+LogDecoderRead (
+  const uint8_t *Data,
+  size_t         Size
+) {
+  uint64_t Value = 0;
+  while (Size-- != 0) {
+    Value = (Value << 8) | Data[Size];
+  }
+  return Value;
+}
+
+// LogDecoderEncode
+/// Encode a character as UTF-8
+/// @param Buffer    The buffer to encode into, which must have room for four bytes
+/// @param Character The character to encode
+/// @return The count of bytes encoded
+static
+size_t
+LogDecoderEncode (
+  char     *Buffer,
+  uint32_t  Character
+) {
+  if (Character < 0x80) {
+    Buffer[0] = (char)Character;
+    return 1;
+  }
+  if (Character < 0x800) {
+    Buffer[0] = (char)(0xC0 | (Character >> 6));
+    Buffer[1] = (char)(0x80 | (Character & 0x3F));
+    return 2;
+  }
+  if ((Character < 0x10000) || (Character > 0x10FFFF)) {
+    if ((Character > 0x10FFFF) || ((Character >= 0xD800) && (Character < 0xE000))) {
+      // Replace invalid characters
+      Character = 0xFFFD;
+    }
+    Buffer[0] = (char)(0xE0 | (Character >> 12));
+    Buffer[1] = (char)(0x80 | ((Character >> 6) & 0x3F));
+    Buffer[2] = (char)(0x80 | (Character & 0x3F));
+    return 3;
+  }
+  Buffer[0] = (char)(0xF0 | (Character >> 18));
+  Buffer[1] = (char)(0x80 | ((Character >> 12) & 0x3F));
+  Buffer[2] = (char)(0x80 | ((Character >> 6) & 0x3F));
+  Buffer[3] = (char)(0x80 | (Character & 0x3F));
+  return 4;
+}
+// LogDecoderUtf16
+/// Decode the next character of a UTF-16 string
+/// @param String    The UTF-16 string
+/// @param Remaining The count of characters remaining in the string
+/// @param Character On output, the decoded character
+/// @return The count of UTF-16 characters decoded
+static
+size_t
+LogDecoderUtf16 (
+  const uint8_t *String,
+  size_t         Remaining,
+  uint32_t      *Character
+) {
+  uint32_t High = (uint32_t)LogDecoderRead(String, 2);
+  if ((High >= 0xD800) && (High < 0xDC00) && (Remaining > 1)) {
+    uint32_t Low = (uint32_t)LogDecoderRead(String + 2, 2);
+    if ((Low >= 0xDC00) && (Low < 0xE000)) {
+      *Character = 0x10000 + ((High - 0xD800) << 10) + (Low - 0xDC00);
+      return 2;
+    }
+  }
+  *Character = High;
+  return 1;
+}
+
+// LogDecoderEmit
+/// Write text to the output, prefixing each line with the time stamp and processor of the message that starts it
+/// @param Decoder The decoder state
+/// @param Text    The UTF-8 text to write
+/// @param Length  The size in bytes of the text
+static
+void
+LogDecoderEmit (
+  LOG_DECODER *Decoder,
+  const char  *Text,
+  size_t       Length
+) {
+  while (Length != 0) {
+    const char *Line = memchr(Text, '\n', Length);
+    size_t      Count = (Line == NULL) ? Length : (size_t)(Line - Text) + 1;
+    if (Decoder->AtLineStart && !Decoder->Raw) {
+      if (Decoder->Frequency != 0) {
+        fprintf(Decoder->Output, "[%12.6f] [%3u] ", (double)Decoder->TimeStamp / (double)Decoder->Frequency, (unsigned)Decoder->Processor);
+      } else {
+        fprintf(Decoder->Output, "[%20llu] [%3u] ", (unsigned long long)Decoder->TimeStamp, (unsigned)Decoder->Processor);
+      }
+    }
+    fwrite(Text, 1, Count, Decoder->Output);
+    Decoder->AtLineStart = (Line != NULL);
+    Text += Count;
+    Length -= Count;
+  }
+}
+// LogDecoderEmitField
+/// Write a formatted argument to the output padded to a width
+/// @param Decoder The decoder state
+/// @param Field   The UTF-8 formatted argument
+/// @param Length  The size in bytes of the formatted argument
+/// @param Width   The minimum count of characters to write
+/// @param Flags   The argument flags
+static
+void
+LogDecoderEmitField (
+  LOG_DECODER *Decoder,
+  const char  *Field,
+  size_t       Length,
+  size_t       Width,
+  uint32_t     Flags
+) {
+  size_t Characters = 0;
+  size_t Index;
+  // Count the characters, not the continuation bytes
+  for (Index = 0; Index < Length; ++Index) {
+    if ((Field[Index] & 0xC0) != 0x80) {
+      ++Characters;
+    }
+  }
+  if ((Flags & LOG_DECODER_FLAG_LEFT_JUSTIFY) == 0) {
+    for (; Characters < Width; ++Characters) {
+      LogDecoderEmit(Decoder, " ", 1);
+    }
+  }
+  LogDecoderEmit(Decoder, Field, Length);
+  for (; Characters < Width; ++Characters) {
+    LogDecoderEmit(Decoder, " ", 1);
+  }
+}
+
+// LogDecoderInteger
+/// Format an integer argument
+/// @param Field     The buffer to format into
+/// @param Value     The integer value
+/// @param Base      The base of the digits
+/// @param Prefix    The prefix of the digits or NULL
+/// @param Width     The minimum count of characters, used for zero padding
+/// @param Precision The minimum count of digits or zero
+/// @param Flags     The argument flags
+/// @return The size in bytes of the formatted integer
+static
+size_t
+LogDecoderInteger (
+  char        *Field,
+  uint64_t     Value,
+  unsigned     Base,
+  const char  *Prefix,
+  size_t       Width,
+  size_t       Precision,
+  uint32_t     Flags
+) {
+  const char *Digits = ((Flags & LOG_DECODER_FLAG_UPPERCASE) != 0) ? "0123456789ABCDEF" : "0123456789abcdef";
+  char        Reversed[96];
+  size_t      Count = 0;
+  size_t      Length = 0;
+  size_t      Group = 0;
+  char        Sign = 0;
+  // Get the sign
+  if ((Flags & LOG_DECODER_FLAG_SIGNED) != 0) {
+    if ((int64_t)Value < 0) {
+      Sign = '-';
+      Value = (uint64_t)(-(int64_t)Value);
+    } else if ((Flags & LOG_DECODER_FLAG_PREFIX_SIGN) != 0) {
+      Sign = '+';
+    }
+  }
+  // Get the digits in reverse
+  do {
+    if (((Flags & LOG_DECODER_FLAG_SEPARATOR) != 0) && (Base == 10) && (Group == 3)) {
+      Reversed[Count++] = ',';
+      Group = 0;
+    }
+    Reversed[Count++] = Digits[Value % Base];
+    Value /= Base;
+    ++Group;
+  } while (Value != 0);
+  while (Count < Precision) {
+    Reversed[Count++] = '0';
+  }
+  // Pad the digits with zeroes to the width after the sign
+  if (((Flags & (LOG_DECODER_FLAG_PAD_ZEROES | LOG_DECODER_FLAG_LEFT_JUSTIFY)) == LOG_DECODER_FLAG_PAD_ZEROES) && (Width < 64)) {
+    size_t Extra = ((Sign != 0) ? 1 : 0);
+    while ((Count + Extra) < Width) {
+      Reversed[Count++] = '0';
+    }
+  }
+  if (Sign != 0) {
+    Field[Length++] = Sign;
+  }
+  if (Prefix != NULL) {
+    memcpy(Field + Length, Prefix, strlen(Prefix));
+    Length += strlen(Prefix);
+  }
+  while (Count != 0) {
+    Field[Length++] = Reversed[--Count];
+  }
+  return Length;
+}
+// LogDecoderStatus
+/// Format a status code argument
+/// @param Decoder The decoder state
+/// @param Field   The buffer to format into
+/// @param Value   The status code
+/// @return The size in bytes of the formatted status code
+static
+size_t
+LogDecoderStatus (
+  LOG_DECODER *Decoder,
+  char        *Field,
+  uint64_t     Value
+) {
+  uint64_t ErrorBit = ((uint64_t)1) << ((Decoder->PointerSize * 8) - 1);
+  int      Error = ((Value & ErrorBit) != 0);
+  uint64_t Code = (Value & ~ErrorBit);
+  size_t   Index;
+  for (Index = 0; Index < (sizeof(mStatusStrings) / sizeof(mStatusStrings[0])); ++Index) {
+    if ((mStatusStrings[Index].Code == Code) && (mStatusStrings[Index].Error == Error)) {
+      return (size_t)sprintf(Field, "%s", mStatusStrings[Index].String);
+    }
+  }
+  return (size_t)sprintf(Field, "Unknown status");
+}
+// LogDecoderString
+/// Format a string argument copied into a message record
+/// @param Field     The buffer to format into
+/// @param String    The string
+/// @param Available The size in bytes of the record after the string
+/// @param Wide      Whether the string is UTF-16 instead of bytes
+/// @param Utf8      Whether a byte string is UTF-8 instead of Latin-1
+/// @param Precision The maximum count of characters or zero
+/// @return The size in bytes of the formatted string
+static
+size_t
+LogDecoderString (
+  char          *Field,
+  const uint8_t *String,
+  size_t         Available,
+  int            Wide,
+  int            Utf8,
+  size_t         Precision
+) {
+  size_t Length = 0;
+  size_t Count = 0;
+  if (Wide) {
+    size_t Remaining = Available / 2;
+    while ((Remaining != 0) && (Length < (LOG_DECODER_FIELD_SIZE - 4))) {
+      uint32_t Character;
+      size_t   Units = LogDecoderUtf16(String, Remaining, &Character);
+      if ((Character == 0) || ((Precision != 0) && (Count >= Precision))) {
+        break;
+      }
+      Length += LogDecoderEncode(Field + Length, Character);
+      String += Units * 2;
+      Remaining -= Units;
+      ++Count;
+    }
+    return Length;
+  }
+  while ((Available-- != 0) && (*String != 0) && (Length < (LOG_DECODER_FIELD_SIZE - 4))) {
+    if ((Precision != 0) && (Count >= Precision)) {
+      break;
+    }
+    if (Utf8) {
+      // UTF-8 is copied as is, so only count lead bytes as characters
+      if ((*String & 0xC0) != 0x80) {
+        ++Count;
+      }
+      Field[Length++] = (char)*String++;
+    } else {
+      Length += LogDecoderEncode(Field + Length, *String++);
+      ++Count;
+    }
+  }
+  return Length;
+}
+// LogDecoderTime
+/// Format a time argument copied into a message record
+/// @param Field The buffer to format into
+/// @param Time  The time, which has the same layout as EFI_TIME
+/// @param Date  Whether to format the date
+/// @param Clock Whether to format the time of day
+/// @return The size in bytes of the formatted time
+static
+size_t
+LogDecoderTime (
+  char          *Field,
+  const uint8_t *Time,
+  int            Date,
+  int            Clock
+) {
+  size_t Length = 0;
+  if (Date) {
+    Length += (size_t)sprintf(Field + Length, "%04u-%02u-%02u", (unsigned)LogDecoderRead(Time, 2), (unsigned)Time[2], (unsigned)Time[3]);
+  }
+  if (Clock) {
+    Length += (size_t)sprintf(Field + Length, "%s%02u:%02u:%02u", Date ? " " : "", (unsigned)Time[4], (unsigned)Time[5], (unsigned)Time[6]);
+  }
+  return Length;
+}
+
+// LogDecoderMessage
+/// Format a message record, this must match EfiLocaleVSPrint and the argument sizes of the logging protocol
+/// @param Decoder The decoder state
+/// @param Record  The message record
+/// @param Size    The size in bytes of the record
+/// @return Whether the message was formatted or the record is invalid
+static
+int
+LogDecoderMessage (
+  LOG_DECODER   *Decoder,
+  const uint8_t *Record,
+  size_t         Size
+) {
+  static char    Field[LOG_DECODER_FIELD_SIZE];
+  const uint8_t *Format;
+  const uint8_t *Arguments;
+  size_t         ArgumentSize;
+  size_t         Offset = 0;
+  size_t         Remaining;
+  uint32_t       Id;
+  uint32_t       Flags = 0;
+  size_t         Width = 0;
+  size_t         Precision = 0;
+  int            Argument = 0;
+  if (Size < LOG_DECODER_MESSAGE_SIZE) {
+    return 0;
+  }
+  Decoder->TimeStamp = LogDecoderRead(Record + 8, 8);
+  Decoder->Processor = (uint32_t)LogDecoderRead(Record + 16, 4);
+  Id = (uint32_t)LogDecoderRead(Record + 20, 4);
+  ArgumentSize = (size_t)LogDecoderRead(Record + 24, 4);
+  if ((Id >= Decoder->FormatCount) || (Decoder->Formats[Id].Format == NULL) || (ArgumentSize > (Size - LOG_DECODER_MESSAGE_SIZE))) {
+    return 0;
+  }
+  Format = Decoder->Formats[Id].Format;
+  Remaining = Decoder->Formats[Id].Length;
+  Arguments = Record + LOG_DECODER_MESSAGE_SIZE;
+  while (Remaining != 0) {
+    uint32_t    Character;
+    size_t      Units = LogDecoderUtf16(Format, Remaining, &Character);
+    size_t      Length = 0;
+    size_t      Slot;
+    uint64_t    Value = 0;
+    unsigned    Base = 10;
+    const char *Prefix = NULL;
+    if (Character == 0) {
+      break;
+    }
+    Format += Units * 2;
+    Remaining -= Units;
+    if (!Argument) {
+      if (Character == '%') {
+        Argument = 1;
+        Flags = 0;
+        Width = 0;
+        Precision = 0;
+      } else {
+        char Buffer[4];
+        LogDecoderEmit(Decoder, Buffer, LogDecoderEncode(Buffer, Character));
+      }
+      continue;
+    }
+    // The size of a native integer argument or a long integer argument
+    Slot = ((Flags & LOG_DECODER_FLAG_LONG) != 0) ? 8 : Decoder->PointerSize;
+    switch (Character) {
+
+      default:
+        // Unknown character for argument so skip
+        Argument = 0;
+        continue;
+
+      case '-':
+        Flags |= LOG_DECODER_FLAG_LEFT_JUSTIFY;
+        continue;
+
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        continue;
+
+      case '+':
+        Flags |= LOG_DECODER_FLAG_PREFIX_SIGN;
+        continue;
+
+      case ',':
+        Flags |= LOG_DECODER_FLAG_SEPARATOR;
+        continue;
+
+      case 'L':
+      case 'l':
+        Flags |= LOG_DECODER_FLAG_LONG;
+        continue;
+
+      case '0':
+        if ((Width == 0) && ((Flags & LOG_DECODER_FLAG_PRECISION) == 0)) {
+          Flags |= LOG_DECODER_FLAG_PAD_ZEROES;
+        } else if ((Flags & LOG_DECODER_FLAG_PRECISION) != 0) {
+          Precision *= 10;
+        } else {
+          Width *= 10;
+        }
+        continue;
+
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+      case '6':
+      case '7':
+      case '8':
+      case '9':
+        if ((Flags & LOG_DECODER_FLAG_PRECISION) != 0) {
+          Precision = (Precision * 10) + (Character - '0');
+        } else {
+          Width = (Width * 10) + (Character - '0');
+        }
+        continue;
+
+      case '*':
+        // The width and/or precision are native integer arguments before this argument
+        if ((Offset + Decoder->PointerSize) > ArgumentSize) {
+          return 0;
+        }
+        if ((Flags & LOG_DECODER_FLAG_PRECISION) != 0) {
+          if ((Flags & LOG_DECODER_FLAG_PRECISION_AS_ARG) == 0) {
+            Precision = (size_t)LogDecoderRead(Arguments + Offset, Decoder->PointerSize);
+            Offset += Decoder->PointerSize;
+            Flags |= LOG_DECODER_FLAG_PRECISION_AS_ARG;
+          }
+        } else if ((Flags & LOG_DECODER_FLAG_WIDTH_AS_ARG) == 0) {
+          Width = (size_t)LogDecoderRead(Arguments + Offset, Decoder->PointerSize);
+          Offset += Decoder->PointerSize;
+          Flags |= LOG_DECODER_FLAG_WIDTH_AS_ARG;
+        }
+        continue;
+
+      case '.':
+        Flags |= LOG_DECODER_FLAG_PRECISION;
+        continue;
+
+      case '%':
+        Length = LogDecoderEncode(Field, '%');
+        break;
+
+      case 'c':
+      case 'C':
+        // Characters are passed as native integers
+        if ((Offset + Decoder->PointerSize) > ArgumentSize) {
+          return 0;
+        }
+        Length = LogDecoderEncode(Field, (uint32_t)LogDecoderRead(Arguments + Offset, 4));
+        Offset += Decoder->PointerSize;
+        break;
+
+      case 'p':
+      case 'P':
+      case 'h':
+      case 'H':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'O':
+      case 'b':
+      case 'B':
+      case 'd':
+      case 'i':
+      case 'u':
+        // Integer arguments
+        if ((Offset + Slot) > ArgumentSize) {
+          return 0;
+        }
+        Value = LogDecoderRead(Arguments + Offset, Slot);
+        Offset += Slot;
+        switch (Character) {
+
+          case 'p':
+          case 'P':
+            Prefix = (Character == 'P') ? "0X" : "0x";
+            // Fall through to hexadecimal with default width
+
+          case 'h':
+          case 'H':
+            if (Width == 0) {
+              Width = Slot * 2;
+            }
+            Flags |= LOG_DECODER_FLAG_PAD_ZEROES;
+            // Fall through to hexadecimal
+
+          case 'x':
+          case 'X':
+            Base = 16;
+            if ((Character == 'P') || (Character == 'H') || (Character == 'X')) {
+              Flags |= LOG_DECODER_FLAG_UPPERCASE;
+            }
+            Flags &= ~LOG_DECODER_FLAG_PREFIX_SIGN;
+            break;
+
+          case 'O':
+            Prefix = "0";
+            // Fall through to octal
+
+          case 'o':
+            Base = 8;
+            break;
+
+          case 'B':
+            Prefix = "0b";
+            // Fall through to binary
+
+          case 'b':
+            Base = 2;
+            break;
+
+          case 'd':
+          case 'i':
+            // Sign extend native integers
+            if ((Slot < 8) && ((Value & (((uint64_t)1) << ((Slot * 8) - 1))) != 0)) {
+              Value |= ~((((uint64_t)1) << (Slot * 8)) - 1);
+            }
+            Flags |= LOG_DECODER_FLAG_SIGNED;
+            break;
+
+        }
+        Length = LogDecoderInteger(Field, Value, Base, Prefix, Width, Precision, Flags);
+        break;
+
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'm':
+        // Floating point arguments
+        if ((Offset + 8) > ArgumentSize) {
+          return 0;
+        }
+        {
+          double Float;
+          char   Specifier[32];
+          Value = LogDecoderRead(Arguments + Offset, 8);
+          memcpy(&Float, &Value, sizeof(Float));
+          if (Character == 'm') {
+            Length = (size_t)sprintf(Field, "%.2f", Float);
+          } else {
+            sprintf(Specifier, "%%%s%s.*%c", ((Flags & LOG_DECODER_FLAG_PREFIX_SIGN) != 0) ? "+" : "",
+                    ((Flags & LOG_DECODER_FLAG_PAD_ZEROES) != 0) ? "0" : "", (int)Character);
+            Length = (size_t)sprintf(Field, Specifier, (int)(((Flags & LOG_DECODER_FLAG_PRECISION) != 0) ? Precision : 6), Float);
+          }
+        }
+        Offset += 8;
+        break;
+
+      case 'r':
+        // Status code argument
+        if ((Offset + Decoder->PointerSize) > ArgumentSize) {
+          return 0;
+        }
+        Length = LogDecoderStatus(Decoder, Field, LogDecoderRead(Arguments + Offset, Decoder->PointerSize));
+        Offset += Decoder->PointerSize;
+        break;
+
+      case 'S':
+        // Encoding and encoded string arguments are not copied into the record
+        if ((Offset + (Decoder->PointerSize * 2)) > ArgumentSize) {
+          return 0;
+        }
+        Length = (size_t)sprintf(Field, "(encoded string)");
+        Offset += Decoder->PointerSize * 2;
+        break;
+
+      case 'a':
+      case 'A':
+      case 's':
+      case 'g':
+      case 'G':
+      case 't':
+      case 'D':
+      case 'T':
+        // Pointer arguments are offsets of the data copied into the record
+        if ((Offset + Decoder->PointerSize) > ArgumentSize) {
+          return 0;
+        }
+        Value = LogDecoderRead(Arguments + Offset, Decoder->PointerSize);
+        Offset += Decoder->PointerSize;
+        if (Value == 0) {
+          Length = (size_t)sprintf(Field, "(null)");
+          break;
+        }
+        if (Value >= Size) {
+          return 0;
+        }
+        switch (Character) {
+
+          case 'a':
+          case 'A':
+          case 's':
+            Length = LogDecoderString(Field, Record + Value, Size - (size_t)Value, (Character == 's'), (Character == 'A'),
+                                      ((Flags & LOG_DECODER_FLAG_PRECISION) != 0) ? Precision : 0);
+            break;
+
+          case 'g':
+          case 'G':
+            if ((Value + 16) > Size) {
+              return 0;
+            }
+            Length = (size_t)sprintf(Field, (Character == 'G') ? "%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X" : "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                                     (unsigned)LogDecoderRead(Record + Value, 4), (unsigned)LogDecoderRead(Record + Value + 4, 2),
+                                     (unsigned)LogDecoderRead(Record + Value + 6, 2), Record[Value + 8], Record[Value + 9], Record[Value + 10],
+                                     Record[Value + 11], Record[Value + 12], Record[Value + 13], Record[Value + 14], Record[Value + 15]);
+            break;
+
+          default:
+            if ((Value + 16) > Size) {
+              return 0;
+            }
+            Length = LogDecoderTime(Field, Record + Value, (Character != 't'), (Character != 'D'));
+            break;
+
+        }
+        break;
+
+    }
+    LogDecoderEmitField(Decoder, Field, Length, Width, Flags);
+    Argument = 0;
+  }
+  return 1;
+}
+
+// LogDecoderDecode
+/// Decode binary log records into text
+/// @param Decoder  The decoder state
+/// @param Contents The binary log file contents
+/// @param Size     The size in bytes of the file contents
+/// @return Zero if every record was decoded, otherwise non-zero
+static
+int
+LogDecoderDecode (
+  LOG_DECODER   *Decoder,
+  const uint8_t *Contents,
+  size_t         Size
+) {
+  size_t Offset = 0;
+  int    Session = 0;
+  while ((Size - Offset) >= LOG_DECODER_HEADER_SIZE) {
+    const uint8_t *Record = Contents + Offset;
+    size_t         RecordSize = (size_t)LogDecoderRead(Record, 4);
+    uint32_t       Type = (uint32_t)LogDecoderRead(Record + 4, 4);
+    if ((RecordSize < LOG_DECODER_HEADER_SIZE) || ((RecordSize & 7) != 0) || (RecordSize > (Size - Offset))) {
+      fprintf(stderr, "Invalid or truncated record at offset %llu\n", (unsigned long long)Offset);
+      return 1;
+    }
+    switch (Type) {
+
+      case LOG_DECODER_TYPE_SESSION:
+        // A session resets the format identifiers
+        if ((RecordSize < LOG_DECODER_SESSION_SIZE) || (LogDecoderRead(Record + 8, 8) != LOG_DECODER_SIGNATURE) ||
+            (LogDecoderRead(Record + 16, 4) != LOG_DECODER_VERSION)) {
+          fprintf(stderr, "Unsupported binary log session at offset %llu\n", (unsigned long long)Offset);
+          return 1;
+        }
+        Decoder->PointerSize = (uint32_t)LogDecoderRead(Record + 20, 4);
+        Decoder->Frequency = LogDecoderRead(Record + 24, 8);
+        if ((Decoder->PointerSize != 4) && (Decoder->PointerSize != 8)) {
+          fprintf(stderr, "Unsupported pointer size %u at offset %llu\n", (unsigned)Decoder->PointerSize, (unsigned long long)Offset);
+          return 1;
+        }
+        memset(Decoder->Formats, 0, Decoder->FormatCount * sizeof(LOG_DECODER_FORMAT));
+        if (!Decoder->AtLineStart) {
+          LogDecoderEmit(Decoder, "\n", 1);
+        }
+        Session = 1;
+        break;
+
+      case LOG_DECODER_TYPE_FORMAT:
+        // Remember where the format specifier string is
+        if (Session && (RecordSize >= LOG_DECODER_FORMAT_SIZE)) {
+          uint32_t Id = (uint32_t)LogDecoderRead(Record + 8, 4);
+          uint32_t Length = (uint32_t)LogDecoderRead(Record + 12, 4);
+          if ((Length == 0) || (Length > ((RecordSize - LOG_DECODER_FORMAT_SIZE) / 2))) {
+            fprintf(stderr, "Invalid format record at offset %llu\n", (unsigned long long)Offset);
+            return 1;
+          }
+          if (Id >= Decoder->FormatCount) {
+            uint32_t            Count = Id + 64;
+            LOG_DECODER_FORMAT *Formats = (LOG_DECODER_FORMAT *)realloc(Decoder->Formats, Count * sizeof(LOG_DECODER_FORMAT));
+            if (Formats == NULL) {
+              fprintf(stderr, "Out of memory\n");
+              return 1;
+            }
+            memset(Formats + Decoder->FormatCount, 0, (Count - Decoder->FormatCount) * sizeof(LOG_DECODER_FORMAT));
+            Decoder->Formats = Formats;
+            Decoder->FormatCount = Count;
+          }
+          Decoder->Formats[Id].Format = Record + LOG_DECODER_FORMAT_SIZE;
+          Decoder->Formats[Id].Length = Length;
+        }
+        break;
+
+      case LOG_DECODER_TYPE_MESSAGE:
+        if (!Session || !LogDecoderMessage(Decoder, Record, RecordSize)) {
+          fprintf(stderr, "Invalid message record at offset %llu\n", (unsigned long long)Offset);
+        }
+        break;
+
+      default:
+        // Skip unknown records so newer records do not stop decoding
+        break;
+
+    }
+    Offset += RecordSize;
+  }
+  if (!Session) {
+    fprintf(stderr, "Not a binary log file\n");
+    return 1;
+  }
+  return 0;
+}
+
+// main
+/// Decode a binary log file into text
+/// @param ArgC The count of argument strings
+/// @param ArgV The argument strings
+/// @return Zero on success, otherwise non-zero
+int
+main (
+  int    ArgC,
+  char **ArgV
+) {
+  LOG_DECODER  Decoder;
+  const char  *InputPath = NULL;
+  const char  *OutputPath = NULL;
+  FILE        *Input;
+  uint8_t     *Contents;
+  long         Size;
+  int          Index;
+  int          Result;
+  memset(&Decoder, 0, sizeof(Decoder));
+  Decoder.AtLineStart = 1;
+  // Parse the arguments
+  for (Index = 1; Index < ArgC; ++Index) {
+    if ((strcmp(ArgV[Index], "-r") == 0) || (strcmp(ArgV[Index], "--raw") == 0)) {
+      // Do not prefix lines with the time stamp and processor
+      Decoder.Raw = 1;
+    } else if (((strcmp(ArgV[Index], "-o") == 0) || (strcmp(ArgV[Index], "--output") == 0)) && ((Index + 1) < ArgC)) {
+      OutputPath = ArgV[++Index];
+    } else if (InputPath == NULL) {
+      InputPath = ArgV[Index];
+    } else {
+      InputPath = NULL;
+      break;
+    }
+  }
+  if (InputPath == NULL) {
+    fprintf(stderr, "Usage: %s [-r|--raw] [-o|--output <text file>] <binary log file>\n", (ArgC > 0) ? ArgV[0] : "LogDecoder");
+    return 2;
+  }
+  // Read the binary log file
+  Input = fopen(InputPath, "rb");
+  if (Input == NULL) {
+    fprintf(stderr, "Could not open %s\n", InputPath);
+    return 1;
+  }
+  if ((fseek(Input, 0, SEEK_END) != 0) || ((Size = ftell(Input)) < 0) || (fseek(Input, 0, SEEK_SET) != 0)) {
+    fprintf(stderr, "Could not read %s\n", InputPath);
+    fclose(Input);
+    return 1;
+  }
+  Contents = (uint8_t *)malloc((Size != 0) ? (size_t)Size : 1);
+  if ((Contents == NULL) || (fread(Contents, 1, (size_t)Size, Input) != (size_t)Size)) {
+    fprintf(stderr, "Could not read %s\n", InputPath);
+    free(Contents);
+    fclose(Input);
+    return 1;
+  }
+  fclose(Input);
+  // Decode to the output
+  Decoder.Output = stdout;
+  if ((OutputPath != NULL) && ((Decoder.Output = fopen(OutputPath, "w")) == NULL)) {
+    fprintf(stderr, "Could not create %s\n", OutputPath);
+    free(Contents);
+    return 1;
+  }
+  Result = LogDecoderDecode(&Decoder, Contents, (size_t)Size);
+  if (Decoder.Output != stdout) {
+    fclose(Decoder.Output);
+  }
+  free(Decoder.Formats);
+  free(Contents);
+  return Result;
+}